@@ -404,12 +404,20 @@ MACRO(setUafOutputDirectories)
         set_target_properties(uafclient  PROPERTIES ARCHIVE_OUTPUT_DIRECTORY_DEBUG          "${PROJECT_OUTPUT_DIR}")
         set_target_properties(uafclient  PROPERTIES ARCHIVE_OUTPUT_DIRECTORY_RELEASE        "${PROJECT_OUTPUT_DIR}")
         set_target_properties(uafclient  PROPERTIES ARCHIVE_OUTPUT_DIRECTORY_RELWITHDEBINFO "${PROJECT_OUTPUT_DIR}")
+        set_target_properties(uaf_benchmarks PROPERTIES RUNTIME_OUTPUT_DIRECTORY_DEBUG      "${PROJECT_OUTPUT_DIR}")
+        set_target_properties(uaf_benchmarks PROPERTIES RUNTIME_OUTPUT_DIRECTORY_RELEASE    "${PROJECT_OUTPUT_DIR}")
+        set_target_properties(uaf_benchmarks PROPERTIES RUNTIME_OUTPUT_DIRECTORY_RELWITHDEBINFO "${PROJECT_OUTPUT_DIR}")
+        set_target_properties(uaf_loadgen    PROPERTIES RUNTIME_OUTPUT_DIRECTORY_DEBUG      "${PROJECT_OUTPUT_DIR}")
+        set_target_properties(uaf_loadgen    PROPERTIES RUNTIME_OUTPUT_DIRECTORY_RELEASE    "${PROJECT_OUTPUT_DIR}")
+        set_target_properties(uaf_loadgen    PROPERTIES RUNTIME_OUTPUT_DIRECTORY_RELWITHDEBINFO "${PROJECT_OUTPUT_DIR}")
     endif(WIN32)
     
     set_target_properties(uafutil    PROPERTIES LIBRARY_OUTPUT_DIRECTORY "${PROJECT_OUTPUT_DIR}")
     set_target_properties(uafclient  PROPERTIES LIBRARY_OUTPUT_DIRECTORY "${PROJECT_OUTPUT_DIR}")
     set_target_properties(uafutil    PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${PROJECT_OUTPUT_DIR}")
     set_target_properties(uafclient  PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${PROJECT_OUTPUT_DIR}")
+    set_target_properties(uaf_benchmarks PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${PROJECT_OUTPUT_DIR}")
+    set_target_properties(uaf_loadgen    PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${PROJECT_OUTPUT_DIR}")
     
 ENDMACRO(setUafOutputDirectories)
 
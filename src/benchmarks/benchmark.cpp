@@ -0,0 +1,216 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarks/benchmark.h"
+#include "uaf/util/atomics.h"
+
+// STD
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <new>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // the sink of doNotOptimize()
+        static const void* volatile sink = 0;
+
+        // the number of heap allocations
+        static uaf::AtomicCount allocations = 0;
+
+
+        // Get a monotonic timestamp
+        // =========================================================================================
+        uint64_t nowNanoseconds()
+        {
+#if defined(_WIN32)
+            LARGE_INTEGER frequency, counter;
+            QueryPerformanceFrequency(&frequency);
+            QueryPerformanceCounter(&counter);
+            return uint64_t(double(counter.QuadPart) * 1e9 / double(frequency.QuadPart));
+#else
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+#endif
+        }
+
+
+        // Get the number of heap allocations
+        // =========================================================================================
+        uint64_t allocationCount()
+        {
+            return uint64_t(uaf::atomicGet(&allocations));
+        }
+
+
+        // Make sure the compiler cannot optimize away a value
+        // =========================================================================================
+        void doNotOptimize(const void* value)
+        {
+            sink = value;
+        }
+
+
+        // Run a benchmark
+        // =========================================================================================
+        BenchmarkResult runBenchmark(const Benchmark& benchmark, uint64_t minimumNanoseconds)
+        {
+            BenchmarkResult result;
+            result.group = benchmark.group;
+            result.name  = benchmark.name;
+
+            // warm up
+            benchmark.function(1);
+
+            uint64_t iterations = 1;
+            while (true)
+            {
+                uint64_t startAllocations = allocationCount();
+                uint64_t start = nowNanoseconds();
+                benchmark.function(iterations);
+                uint64_t elapsed = nowNanoseconds() - start;
+
+                if (elapsed >= minimumNanoseconds || iterations >= (1ULL << 40))
+                {
+                    result.iterations       = iterations;
+                    result.totalNanoseconds = elapsed;
+                    result.allocations      = allocationCount() - startAllocations;
+                    return result;
+                }
+
+                iterations *= 2;
+            }
+        }
+
+
+        // Escape a string for JSON
+        // =========================================================================================
+        static std::string jsonString(const std::string& s)
+        {
+            std::string ret("\"");
+            for (std::size_t i = 0; i < s.size(); i++)
+            {
+                unsigned char c = static_cast<unsigned char>(s[i]);
+                if (c == '"' || c == '\\')
+                {
+                    ret += '\\';
+                    ret += char(c);
+                }
+                else if (c < 0x20)
+                {
+                    char escaped[8];
+                    sprintf(escaped, "\\u%04x", unsigned(c));
+                    ret += escaped;
+                }
+                else
+                {
+                    ret += char(c);
+                }
+            }
+            ret += '"';
+            return ret;
+        }
+
+
+        // Write the results as JSON
+        // =========================================================================================
+        bool writeJson(
+                const std::string&                  fileName,
+                const std::string&                  label,
+                uint64_t                            minimumNanoseconds,
+                const std::vector<BenchmarkResult>& results)
+        {
+            std::ofstream file(fileName.c_str());
+            if (!file)
+                return false;
+
+            char timestamp[32];
+            time_t now = time(0);
+            strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+            char number[64];
+
+            file << "{\n";
+            file << "  \"label\": " << jsonString(label) << ",\n";
+            file << "  \"timestamp\": " << jsonString(timestamp) << ",\n";
+            file << "  \"minimumNanoseconds\": " << minimumNanoseconds << ",\n";
+            file << "  \"benchmarks\": [";
+
+            for (std::size_t i = 0; i < results.size(); i++)
+            {
+                file << (i == 0 ? "\n" : ",\n");
+                file << "    {\"group\": " << jsonString(results[i].group);
+                file << ", \"name\": " << jsonString(results[i].name);
+                file << ", \"iterations\": " << results[i].iterations;
+                file << ", \"totalNanoseconds\": " << results[i].totalNanoseconds;
+                sprintf(number, "%.3f", results[i].nanosecondsPerIteration());
+                file << ", \"nanosecondsPerIteration\": " << number;
+                sprintf(number, "%.3f", results[i].allocationsPerIteration());
+                file << ", \"allocationsPerIteration\": " << number << "}";
+            }
+
+            file << "\n  ]\n}\n";
+            file.close();
+            return !file.fail();
+        }
+
+    }
+
+}
+
+
+// Count the heap allocations of the benchmark executable (and, on platforms where the global
+// operator new of an executable replaces the one of the shared libraries, of the UAF libraries)
+// =================================================================================================
+void* operator new(std::size_t size)
+{
+    uaf::atomicIncrement(&uaf::benchmarks::allocations);
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) throw()
+{
+    free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+    free(p);
+}
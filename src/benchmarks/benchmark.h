@@ -0,0 +1,196 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_BENCHMARK_H_
+#define UAF_BENCHMARK_H_
+
+
+// STD
+#include <string>
+#include <vector>
+#include <stdint.h>
+// SDK
+// UAF
+
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        /**
+         * A benchmark function executes the benchmarked operation the given number of times.
+         */
+        typedef void (*BenchmarkFunction)(uint64_t iterations);
+
+
+        /**
+         * A single named benchmark.
+         */
+        struct Benchmark
+        {
+            Benchmark(const std::string& group, const std::string& name, BenchmarkFunction function)
+            : group(group), name(name), function(function)
+            {}
+
+            std::string         group;
+            std::string         name;
+            BenchmarkFunction   function;
+        };
+
+
+        /**
+         * The result of a single benchmark.
+         */
+        struct BenchmarkResult
+        {
+            BenchmarkResult()
+            : iterations(0), totalNanoseconds(0), allocations(0)
+            {}
+
+            std::string group;
+            std::string name;
+            uint64_t    iterations;
+            uint64_t    totalNanoseconds;
+            uint64_t    allocations;
+
+            double nanosecondsPerIteration() const
+            { return iterations == 0 ? 0.0 : double(totalNanoseconds) / double(iterations); }
+
+            double allocationsPerIteration() const
+            { return iterations == 0 ? 0.0 : double(allocations) / double(iterations); }
+        };
+
+
+        /**
+         * Get a monotonic timestamp, in nanoseconds.
+         */
+        uint64_t nowNanoseconds();
+
+
+        /**
+         * Get the number of heap allocations (operator new) done so far by the benchmark
+         * executable. Allocations done by the SDK/Stack with OpcUa_Alloc are not counted.
+         */
+        uint64_t allocationCount();
+
+
+        /**
+         * Make sure the compiler cannot optimize away the computation of a value.
+         */
+        void doNotOptimize(const void* value);
+
+
+        /**
+         * Run a benchmark: the number of iterations is doubled until the benchmark runs for at
+         * least the given minimum time, so that the timer resolution does not matter.
+         */
+        BenchmarkResult runBenchmark(const Benchmark& benchmark, uint64_t minimumNanoseconds);
+
+
+        /**
+         * Write the results as a JSON document, to track them across commits.
+         *
+         * @param fileName              The file to write (it's overwritten).
+         * @param label                 A label of the run (e.g. the git commit), may be empty.
+         * @param minimumNanoseconds    The minimum time per benchmark of the run.
+         * @param results               The results to write.
+         * @return                      False if the file could not be written.
+         */
+        bool writeJson(
+                const std::string&                  fileName,
+                const std::string&                  label,
+                uint64_t                            minimumNanoseconds,
+                const std::vector<BenchmarkResult>& results);
+
+
+        /**
+         * Add the benchmarks of the util types (NodeId, Address, DataValue, Mask, ...).
+         */
+        void addUtilBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Add the benchmarks of uaf::Variant.
+         */
+        void addVariantBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Add the benchmarks of the conversion of service results from the SDK to the UAF.
+         */
+        void addConversionBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Add the benchmarks of uaf::Status.
+         */
+        void addStatusBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Add the benchmarks of the processing of (large) requests.
+         */
+        void addRequestBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Add the benchmarks of the resolution of (large) requests with mixed addresses.
+         */
+        void addResolutionBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Add the benchmarks of the preparation of the PKI store of secured connections.
+         */
+        void addSecurityBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Add the benchmarks of requests processed by a client connected to a loopback server.
+         */
+        void addLoopbackBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Add the benchmarks of the dispatching of notifications to the ClientInterface.
+         */
+        void addNotificationBenchmarks(std::vector<Benchmark>& benchmarks);
+
+
+        /**
+         * Print the sizes of the types of which many instances are copied around.
+         */
+        void printTypeSizes();
+
+
+        /**
+         * Print the number of target copies made while processing a request.
+         */
+        void printRequestCopies();
+
+    }
+
+}
+
+
+#endif /* UAF_BENCHMARK_H_ */
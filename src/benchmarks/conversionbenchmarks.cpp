@@ -0,0 +1,233 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <vector>
+// SDK
+#include "uabase/uaarraytemplates.h"
+#include "uabase/uadatavalue.h"
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/namespacearray.h"
+#include "uaf/util/serverarray.h"
+#include "uaf/client/results/readresulttarget.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // The conversion benchmarks mimic ReadInvocation::fromSyncSdkToUaf() for a read of
+        // NUMBER_OF_TARGETS targets: the "copy" benchmarks convert the results like it used to
+        // be done (copy into a UaDataValue, copy into the target, resolve the namespaces of every
+        // value), the "detach" benchmarks like it's done now (take over the SDK data, and only
+        // resolve the namespaces of the values that need it). Since the detaching empties the SDK
+        // results, every iteration (also of the "copy" benchmarks) first copies the SDK results
+        // from a prototype: the "setup" benchmarks measure only this copy.
+        // =========================================================================================
+
+        static const uint32_t NUMBER_OF_TARGETS = 1000;
+
+
+        // a namespace array with a few namespace URIs
+        static const NamespaceArray& nameSpaceArray()
+        {
+            static NamespaceArray array;
+            static bool initialized = false;
+            if (!initialized)
+            {
+                UaStringArray uris;
+                uris.create(3);
+                UaString("http://opcfoundation.org/UA/").copyTo(&uris[0]);
+                UaString("urn:some:server:uri").copyTo(&uris[1]);
+                UaString("urn:some:namespace:uri").copyTo(&uris[2]);
+
+                OpcUa_DataValue opcUaDataValue;
+                OpcUa_DataValue_Initialize(&opcUaDataValue);
+                UaVariant uaVariant;
+                uaVariant.setStringArray(uris);
+                uaVariant.copyTo(&opcUaDataValue.Value);
+                array.fromSdk(opcUaDataValue);
+                OpcUa_DataValue_Clear(&opcUaDataValue);
+
+                initialized = true;
+            }
+            return array;
+        }
+
+
+        // an empty server array
+        static const ServerArray& serverArray()
+        {
+            static ServerArray array;
+            return array;
+        }
+
+
+        // SDK results holding doubles
+        static const UaDataValues& doubleResults()
+        {
+            static UaDataValues results;
+            if (results.length() == 0)
+            {
+                results.create(NUMBER_OF_TARGETS);
+                for (uint32_t i = 0; i < NUMBER_OF_TARGETS; i++)
+                {
+                    UaVariant uaVariant;
+                    uaVariant.setDouble(double(i));
+                    uaVariant.copyTo(&results[i].Value);
+                    results[i].StatusCode = OpcUa_Good;
+                }
+            }
+            return results;
+        }
+
+
+        // SDK results holding arrays of 100 doubles
+        static const UaDataValues& doubleArrayResults()
+        {
+            static UaDataValues results;
+            if (results.length() == 0)
+            {
+                UaDoubleArray arr;
+                arr.create(100);
+                for (uint32_t j = 0; j < 100; j++)
+                    arr[j] = double(j);
+
+                results.create(NUMBER_OF_TARGETS);
+                for (uint32_t i = 0; i < NUMBER_OF_TARGETS; i++)
+                {
+                    UaVariant uaVariant;
+                    uaVariant.setDoubleArray(arr);
+                    uaVariant.copyTo(&results[i].Value);
+                    results[i].StatusCode = OpcUa_Good;
+                }
+            }
+            return results;
+        }
+
+
+        // SDK results holding NodeIds (which need namespace resolution)
+        static const UaDataValues& nodeIdResults()
+        {
+            static UaDataValues results;
+            if (results.length() == 0)
+            {
+                results.create(NUMBER_OF_TARGETS);
+                for (uint32_t i = 0; i < NUMBER_OF_TARGETS; i++)
+                {
+                    UaVariant uaVariant;
+                    uaVariant.setNodeId(UaNodeId(i, 2));
+                    uaVariant.copyTo(&results[i].Value);
+                    results[i].StatusCode = OpcUa_Good;
+                }
+            }
+            return results;
+        }
+
+
+        // the old way of converting
+        static void convertByCopy(UaDataValues& results, std::vector<ReadResultTarget>& targets)
+        {
+            targets.resize(results.length());
+            for (uint32_t i = 0; i < results.length(); i++)
+            {
+                targets[i].fromSdk(UaDataValue(results[i]));
+                nameSpaceArray().fillVariant(targets[i].data);
+                serverArray().fillVariant(targets[i].data);
+            }
+        }
+
+
+        // the new way of converting
+        static void convertByDetach(UaDataValues& results, std::vector<ReadResultTarget>& targets)
+        {
+            targets.resize(results.length());
+            for (uint32_t i = 0; i < results.length(); i++)
+            {
+                targets[i].fromSdkWithDetach(results[i]);
+                if (opcuatypes::needsNamespaceResolution(targets[i].data.type()))
+                {
+                    nameSpaceArray().fillVariant(targets[i].data);
+                    serverArray().fillVariant(targets[i].data);
+                }
+            }
+        }
+
+
+#define IMPLEMENT_CONVERSION_BENCHMARKS(NAME)                                                      \
+        static void readResult_##NAME##_setup(uint64_t iterations)                                 \
+        {                                                                                          \
+            for (uint64_t i = 0; i < iterations; i++)                                              \
+            {                                                                                      \
+                UaDataValues results(NAME##Results());                                             \
+                doNotOptimize(&results);                                                           \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        static void readResult_##NAME##_copy(uint64_t iterations)                                  \
+        {                                                                                          \
+            for (uint64_t i = 0; i < iterations; i++)                                              \
+            {                                                                                      \
+                UaDataValues results(NAME##Results());                                             \
+                std::vector<ReadResultTarget> targets;                                             \
+                convertByCopy(results, targets);                                                   \
+                doNotOptimize(&targets);                                                           \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        static void readResult_##NAME##_detach(uint64_t iterations)                                \
+        {                                                                                          \
+            for (uint64_t i = 0; i < iterations; i++)                                              \
+            {                                                                                      \
+                UaDataValues results(NAME##Results());                                             \
+                std::vector<ReadResultTarget> targets;                                             \
+                convertByDetach(results, targets);                                                 \
+                doNotOptimize(&targets);                                                           \
+            }                                                                                      \
+        }
+
+        IMPLEMENT_CONVERSION_BENCHMARKS(double)
+        IMPLEMENT_CONVERSION_BENCHMARKS(doubleArray)
+        IMPLEMENT_CONVERSION_BENCHMARKS(nodeId)
+
+
+        // Add the conversion benchmarks
+        // =========================================================================================
+        void addConversionBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_CONVERSION_BENCHMARK(NAME) benchmarks.push_back(Benchmark("Conversion", #NAME, NAME));
+            ADD_CONVERSION_BENCHMARK(readResult_double_setup)
+            ADD_CONVERSION_BENCHMARK(readResult_double_copy)
+            ADD_CONVERSION_BENCHMARK(readResult_double_detach)
+            ADD_CONVERSION_BENCHMARK(readResult_doubleArray_setup)
+            ADD_CONVERSION_BENCHMARK(readResult_doubleArray_copy)
+            ADD_CONVERSION_BENCHMARK(readResult_doubleArray_detach)
+            ADD_CONVERSION_BENCHMARK(readResult_nodeId_setup)
+            ADD_CONVERSION_BENCHMARK(readResult_nodeId_copy)
+            ADD_CONVERSION_BENCHMARK(readResult_nodeId_detach)
+#undef ADD_CONVERSION_BENCHMARK
+        }
+
+    }
+
+}
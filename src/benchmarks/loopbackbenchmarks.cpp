@@ -0,0 +1,263 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <vector>
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/address.h"
+#include "uaf/util/variant.h"
+#include "uaf/util/constants.h"
+#include "uaf/client/client.h"
+#include "uaf/client/clientinterface.h"
+#include "uaf/client/database/database.h"
+#include "uaf/client/discovery/discoverer.h"
+#include "uaf/client/sessions/sessionfactory.h"
+#include "uaf/client/resolution/resolver.h"
+#include "uaf/client/transport/loopbackserver.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // The loopback benchmarks measure the overhead of the whole client stack (resolution,
+        // sessions, invocations, conversions, results) for requests to a uaf::LoopbackServer,
+        // i.e. without any network, encoding or security, and without any simulated latency. They
+        // show what the client itself costs per request and per node, so that a regression of
+        // the client can't hide behind the (much larger and noisier) latency of a real server.
+        // The client is created once, and connects during the warm-up of the first benchmark.
+        // The resolve benchmarks use a resolver of their own (with its own database), so that
+        // they can clear its address cache: the uncached resolution translates all browse paths
+        // at the server again, the cached resolution finds all of them in the cache.
+        // =========================================================================================
+
+        static const uint32_t NUMBER_OF_VARIABLES = 1000;
+
+
+        // the server and the client are never deleted, since the worker threads of the sessions
+        // may still be running when the benchmarks exit
+        static LoopbackServer& server()
+        {
+            static LoopbackServer* server = new LoopbackServer();
+            return *server;
+        }
+
+
+        static Client* createClient()
+        {
+            Client* client = new Client("benchmarks");
+            client->setSessionTransportFactory(&server());
+            return client;
+        }
+
+
+        static Client& client()
+        {
+            static Client* client = createClient();
+            return *client;
+        }
+
+
+        // a resolver with its own database, discoverer and sessions to the loopback server
+        struct ResolverStack
+        {
+            ResolverStack()
+            : loggerFactory("benchmarks"),
+              database(&loggerFactory),
+              discoverer(&loggerFactory, &database),
+              sessionFactory(&loggerFactory, &clientInterface, &discoverer, &database),
+              resolver(&loggerFactory, &sessionFactory, &database)
+            {
+                discoverer.setSessionTransportFactory(&server());
+                sessionFactory.setSessionTransportFactory(&server());
+            }
+
+            LoggerFactory   loggerFactory;
+            ClientInterface clientInterface;
+            Database        database;
+            Discoverer      discoverer;
+            SessionFactory  sessionFactory;
+            Resolver        resolver;
+        };
+
+
+        static ResolverStack& resolverStack()
+        {
+            static ResolverStack* stack = new ResolverStack();
+            return *stack;
+        }
+
+
+        // the addresses of the given number of variables, by NodeId
+        static std::vector<Address> variableAddresses(uint32_t noOfAddresses)
+        {
+            std::vector<Address> addresses;
+            for (uint32_t i = 0; i < noOfAddresses; i++)
+                addresses.push_back(Address(server().variableNodeId(i),
+                                            server().settings().serverUri));
+            return addresses;
+        }
+
+
+        // the addresses of the given number of variables, by their path from the Objects folder
+        static std::vector<Address> relativeVariableAddresses(uint32_t noOfAddresses)
+        {
+            Address objects(NodeId(OpcUaId_ObjectsFolder, 0), server().settings().serverUri);
+
+            std::vector<Address> addresses;
+            for (uint32_t i = 0; i < noOfAddresses; i++)
+                addresses.push_back(Address(&objects,
+                                            RelativePathElement(server().variableBrowseName(i))));
+            return addresses;
+        }
+
+
+        static void read(const std::vector<Address>& addresses, uint64_t iterations)
+        {
+            Client& theClient = client();
+
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                ReadResult result;
+                Status status = theClient.read(addresses,
+                                               attributeids::Value,
+                                               constants::CLIENTHANDLE_NOT_ASSIGNED,
+                                               NULL,
+                                               NULL,
+                                               NULL,
+                                               result);
+                doNotOptimize(&status);
+                doNotOptimize(&result);
+            }
+        }
+
+        static void loopback_read_1(uint64_t iterations)
+        {
+            read(variableAddresses(1), iterations);
+        }
+
+        static void loopback_read_1k(uint64_t iterations)
+        {
+            read(variableAddresses(NUMBER_OF_VARIABLES), iterations);
+        }
+
+        static void loopback_readRelative_1k(uint64_t iterations)
+        {
+            read(relativeVariableAddresses(NUMBER_OF_VARIABLES), iterations);
+        }
+
+        static void loopback_write_1k(uint64_t iterations)
+        {
+            Client& theClient = client();
+            std::vector<Address> addresses = variableAddresses(NUMBER_OF_VARIABLES);
+            std::vector<Variant> data(addresses.size());
+            for (std::size_t i = 0; i < data.size(); i++)
+                data[i].setDouble(double(i));
+
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                WriteResult result;
+                Status status = theClient.write(addresses,
+                                                data,
+                                                attributeids::Value,
+                                                constants::CLIENTHANDLE_NOT_ASSIGNED,
+                                                NULL,
+                                                NULL,
+                                                NULL,
+                                                result);
+                doNotOptimize(&status);
+                doNotOptimize(&result);
+            }
+        }
+
+        static void resolve(bool cached, uint64_t iterations)
+        {
+            ResolverStack& stack = resolverStack();
+            std::vector<Address> addresses = relativeVariableAddresses(NUMBER_OF_VARIABLES);
+
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                if (!cached)
+                    stack.database.addressCache.clear();
+
+                std::vector<ExpandedNodeId> expandedNodeIds;
+                std::vector<Status> statuses;
+                Status status = stack.resolver.resolve(addresses, expandedNodeIds, statuses);
+                doNotOptimize(&status);
+                doNotOptimize(&expandedNodeIds);
+            }
+        }
+
+        static void loopback_resolve_cached_1k(uint64_t iterations)
+        {
+            resolve(true, iterations);
+        }
+
+        static void loopback_resolve_uncached_1k(uint64_t iterations)
+        {
+            resolve(false, iterations);
+        }
+
+        // browse all references of the Objects folder (i.e. with 9 automatic BrowseNext calls,
+        // since the server returns at most 100 references per call)
+        static void loopback_browse_1k(uint64_t iterations)
+        {
+            Client& theClient = client();
+            std::vector<Address> addresses;
+            addresses.push_back(Address(NodeId(OpcUaId_ObjectsFolder, 0),
+                                        server().settings().serverUri));
+
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                BrowseResult result;
+                Status status = theClient.browse(addresses,
+                                                 NUMBER_OF_VARIABLES,
+                                                 constants::CLIENTHANDLE_NOT_ASSIGNED,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 result);
+                doNotOptimize(&status);
+                doNotOptimize(&result);
+            }
+        }
+
+
+        // Add the loopback benchmarks
+        // =========================================================================================
+        void addLoopbackBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_LOOPBACK_BENCHMARK(NAME) benchmarks.push_back(Benchmark("Loopback", #NAME, NAME));
+            ADD_LOOPBACK_BENCHMARK(loopback_read_1)
+            ADD_LOOPBACK_BENCHMARK(loopback_read_1k)
+            ADD_LOOPBACK_BENCHMARK(loopback_readRelative_1k)
+            ADD_LOOPBACK_BENCHMARK(loopback_write_1k)
+            ADD_LOOPBACK_BENCHMARK(loopback_resolve_cached_1k)
+            ADD_LOOPBACK_BENCHMARK(loopback_resolve_uncached_1k)
+            ADD_LOOPBACK_BENCHMARK(loopback_browse_1k)
+#undef ADD_LOOPBACK_BENCHMARK
+        }
+
+    }
+
+}
@@ -0,0 +1,172 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <vector>
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/constspan.h"
+#include "uaf/client/clientinterface.h"
+#include "uaf/client/subscriptions/clienthandletable.h"
+#include "uaf/client/subscriptions/notificationqueue.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // The notification benchmarks measure what it costs to dispatch the data change
+        // notifications of a publish response (NUMBER_OF_NOTIFICATIONS per iteration) to the
+        // ClientInterface: synchronously to a callback that handles the span without copying, or
+        // to the old callback that receives a copied vector, or through a queue with a delivery
+        // thread. The handle lookup is what the subscriptions do for every notification, to find
+        // out if it belongs to one of their monitored items.
+        // =========================================================================================
+
+        static const std::size_t NUMBER_OF_NOTIFICATIONS = 100;
+        static const std::size_t NUMBER_OF_HANDLES       = 10000;
+        static const uint32_t    QUEUE_CAPACITY          = 10000;
+
+
+        static LoggerFactory& loggerFactory()
+        {
+            static LoggerFactory factory("benchmarks");
+            return factory;
+        }
+
+
+        // a client interface that handles the notifications without copying them
+        class SpanCountingInterface : public ClientInterface
+        {
+        public:
+            SpanCountingInterface() : count(0) {}
+
+            virtual void dataChangesReceived(const ConstSpan<DataChangeNotification>& notifications)
+            { count += notifications.size(); }
+
+            std::size_t count;
+        };
+
+
+        // a client interface that only overrides the old callback, so it receives a copied vector
+        class VectorCountingInterface : public ClientInterface
+        {
+        public:
+            VectorCountingInterface() : count(0) {}
+
+            virtual void dataChangesReceived(std::vector<DataChangeNotification> notifications)
+            { count += notifications.size(); }
+
+            std::size_t count;
+        };
+
+
+        // the notifications of a typical publish response
+        static const std::vector<DataChangeNotification>& prototypeNotifications()
+        {
+            static std::vector<DataChangeNotification> notifications;
+            if (notifications.size() == 0)
+            {
+                notifications.resize(NUMBER_OF_NOTIFICATIONS);
+                for (std::size_t i = 0; i < NUMBER_OF_NOTIFICATIONS; i++)
+                {
+                    notifications[i].clientHandle = ClientHandle(i);
+                    notifications[i].status = statuscodes::Good;
+                    notifications[i].data.setDouble(double(i));
+                }
+            }
+            return notifications;
+        }
+
+
+        static void dispatch(
+                ClientInterface&    clientInterface,
+                uint32_t            capacity,
+                uint64_t            iterations)
+        {
+            ConstSpan<DataChangeNotification> notifications(prototypeNotifications());
+
+            // the queue is destructed after delivering all queued notifications
+            NotificationQueue queue(&loggerFactory(), &clientInterface);
+            queue.configure(capacity, overflowpolicies::Block, 1);
+
+            for (uint64_t i = 0; i < iterations; i++)
+                queue.push(notifications);
+        }
+
+        static void notification_dispatch_span(uint64_t iterations)
+        {
+            SpanCountingInterface clientInterface;
+            dispatch(clientInterface, 0, iterations);
+            doNotOptimize(&clientInterface.count);
+        }
+
+        static void notification_dispatch_vector(uint64_t iterations)
+        {
+            VectorCountingInterface clientInterface;
+            dispatch(clientInterface, 0, iterations);
+            doNotOptimize(&clientInterface.count);
+        }
+
+        static void notification_dispatch_queued(uint64_t iterations)
+        {
+            SpanCountingInterface clientInterface;
+            dispatch(clientInterface, QUEUE_CAPACITY, iterations);
+            doNotOptimize(&clientInterface.count);
+        }
+
+        static void notification_lookupHandle(uint64_t iterations)
+        {
+            std::vector<ClientHandle> handles;
+            for (std::size_t i = 0; i < NUMBER_OF_HANDLES; i++)
+                handles.push_back(ClientHandle(2 * i));
+
+            ClientHandleTable table;
+            table.assign(handles);
+
+            std::size_t found = 0;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                if (table.contains(ClientHandle(i % (2 * NUMBER_OF_HANDLES))))
+                    found++;
+            }
+            doNotOptimize(&found);
+        }
+
+
+        // Add the notification benchmarks
+        // =========================================================================================
+        void addNotificationBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_NOTIFICATION_BENCHMARK(NAME) \
+            benchmarks.push_back(Benchmark("Notification", #NAME, NAME));
+            ADD_NOTIFICATION_BENCHMARK(notification_dispatch_span)
+            ADD_NOTIFICATION_BENCHMARK(notification_dispatch_vector)
+            ADD_NOTIFICATION_BENCHMARK(notification_dispatch_queued)
+            ADD_NOTIFICATION_BENCHMARK(notification_lookupHandle)
+#undef ADD_NOTIFICATION_BENCHMARK
+        }
+
+    }
+
+}
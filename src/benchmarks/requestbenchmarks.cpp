@@ -0,0 +1,399 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <cstdio>
+#include <map>
+#include <vector>
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/sharedconst.h"
+#include "uaf/client/clientservices.h"
+#include "uaf/client/database/requeststore.h"
+#include "uaf/client/invocations/invocations.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // The request benchmarks measure what it costs to process a request of NUMBER_OF_TARGETS
+        // targets, apart from the communication itself. Client::processRequest() used to copy
+        // every request (so that it could be resolved in place), the invocations copied every
+        // target again (growing their vectors target by target), and the request store copied
+        // every persistent request once when storing it and once more every time it checked
+        // for bad items. Now the request is not copied by processRequest() and shared by the
+        // store, and each target is only copied once, into a reserved invocation.
+        // The allocations per iteration below are "per request"; printRequestCopies() prints
+        // the number of target copies per request. The invocation benchmarks show the
+        // allocations of building the invocation of a typical read request: a new invocation
+        // allocates itself and its vectors every time, a pooled invocation only the copies of the
+        // targets (their strings, etc.). The pooled invocations are also built for requests of 1
+        // to 100000 targets, to show that the cost per target doesn't grow with the request.
+        // =========================================================================================
+
+        static const std::size_t NUMBER_OF_TARGETS = 10000;
+
+
+        // a CreateMonitoredDataRequestTarget that counts how many times it is copied
+        struct CountingTarget : public CreateMonitoredDataRequestTarget
+        {
+            CountingTarget() {}
+
+            explicit CountingTarget(const Address& address)
+            : CreateMonitoredDataRequestTarget(address)
+            {}
+
+            CountingTarget(const CountingTarget& other)
+            : CreateMonitoredDataRequestTarget(other)
+            { copies++; }
+
+            CountingTarget& operator=(const CountingTarget& other)
+            {
+                CreateMonitoredDataRequestTarget::operator=(other);
+                copies++;
+                return *this;
+            }
+
+            static uint64_t copies;
+        };
+
+        uint64_t CountingTarget::copies = 0;
+
+
+        // a persistent service with counting targets
+        struct CountingService
+        {
+            typedef BaseSubscriptionRequest<CreateMonitoredDataSettings, CountingTarget, false> Request;
+            typedef CreateMonitoredDataResult Result;
+        };
+
+        typedef CountingService::Request            CountingRequest;
+        typedef RequestStore<CountingService>       CountingRequestStore;
+        typedef SharedConst<CountingRequest>        SharedCountingRequest;
+
+
+        static const CountingRequest& prototypeRequest()
+        {
+            static CountingRequest request;
+            if (request.targets.size() == 0)
+            {
+                request.targets.reserve(NUMBER_OF_TARGETS);
+                for (std::size_t i = 0; i < NUMBER_OF_TARGETS; i++)
+                    request.targets.push_back(CountingTarget(
+                            Address(NodeId(uint32_t(i), "urn:some:namespace:uri"), "urn:some:server:uri")));
+            }
+            return request;
+        }
+
+
+        static const CreateMonitoredDataResult& prototypeResult()
+        {
+            static CreateMonitoredDataResult result;
+            if (result.targets.size() == 0)
+            {
+                result.requestHandle = 1;
+                result.targets.resize(NUMBER_OF_TARGETS);
+                for (std::size_t i = 0; i < NUMBER_OF_TARGETS; i++)
+                    result.targets[i].status = statuscodes::Good;
+
+                // one bad target, so that the request needs to be re-processed
+                result.targets[0].status = UnexpectedError("Not created yet");
+            }
+            return result;
+        }
+
+
+        static CountingRequestStore& store()
+        {
+            static LoggerFactory loggerFactory("benchmarks");
+            static CountingRequestStore store(&loggerFactory, "Store");
+            return store;
+        }
+
+
+        // the targets of an invocation, added the old way
+        static void addTargetsGrowing(
+                const CountingRequest& request,
+                std::vector<CountingTarget>& invocationTargets)
+        {
+            for (std::size_t i = 0; i < request.targets.size(); i++)
+                invocationTargets.push_back(request.targets[i]);
+        }
+
+
+        // the targets of an invocation, added the new way
+        static void addTargetsReserved(
+                const CountingRequest& request,
+                std::vector<CountingTarget>& invocationTargets)
+        {
+            invocationTargets.reserve(request.targets.size());
+            for (std::size_t i = 0; i < request.targets.size(); i++)
+                invocationTargets.push_back(request.targets[i]);
+        }
+
+
+        // the old pipeline: copy the request, store another copy, invoke growing invocations
+        static void processOld(const CountingRequest& request)
+        {
+            CountingRequest copiedRequest(request);
+            SharedCountingRequest storedRequest(new CountingRequest(copiedRequest));
+            store().storeIfNeeded(storedRequest, prototypeResult(), prototypeResult().getBadTargetsMask());
+            std::vector<CountingTarget> invocationTargets;
+            addTargetsGrowing(copiedRequest, invocationTargets);
+            doNotOptimize(&invocationTargets);
+            store().remove(prototypeResult().requestHandle);
+        }
+
+
+        // the new pipeline: store a shared copy, invoke reserved invocations
+        static void processNew(const CountingRequest& request)
+        {
+            SharedCountingRequest storedRequest(new CountingRequest(request));
+            store().storeIfNeeded(storedRequest, prototypeResult(), prototypeResult().getBadTargetsMask());
+            std::vector<CountingTarget> invocationTargets;
+            addTargetsReserved(request, invocationTargets);
+            doNotOptimize(&invocationTargets);
+            store().remove(prototypeResult().requestHandle);
+        }
+
+
+        // the new pipeline, for a request that is moved into (or created by) the client
+        static void processNewOwned(const SharedCountingRequest& request)
+        {
+            store().storeIfNeeded(request, prototypeResult(), prototypeResult().getBadTargetsMask());
+            std::vector<CountingTarget> invocationTargets;
+            addTargetsReserved(*request, invocationTargets);
+            doNotOptimize(&invocationTargets);
+            store().remove(prototypeResult().requestHandle);
+        }
+
+
+        // a read request of the given number of targets (100 for a typical read request), of
+        // which the invocation is built for every request
+        static const ReadRequest& prototypeReadRequest(std::size_t noOfTargets = 100)
+        {
+            static std::map<std::size_t, ReadRequest> requests;
+            ReadRequest& request = requests[noOfTargets];
+            if (request.targets.size() != noOfTargets)
+            {
+                request.targets.reserve(noOfTargets);
+                for (std::size_t i = 0; i < noOfTargets; i++)
+                    request.targets.push_back(ReadRequestTarget(
+                            Address(NodeId(uint32_t(i), "urn:some:namespace:uri"), "urn:some:server:uri")));
+            }
+            return request;
+        }
+
+
+        // build the invocation of a read request
+        static void buildInvocation(
+                const ReadRequest&  request,
+                ReadResult&         result,
+                ReadInvocation&     invocation)
+        {
+            invocation.setRequestHandle(request.requestHandle());
+            invocation.setServiceSettings(request.serviceSettings);
+            invocation.reserveTargets(request.targets.size());
+            for (std::size_t i = 0; i < request.targets.size(); i++)
+                invocation.addTarget(i, request.targets[i], result.targets[i]);
+        }
+
+
+        static void request_copy(uint64_t iterations)
+        {
+            const CountingRequest& request = prototypeRequest();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                CountingRequest copy(request);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void request_share(uint64_t iterations)
+        {
+            SharedCountingRequest request(new CountingRequest(prototypeRequest()));
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                SharedCountingRequest copy(request);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void request_invocationTargets_growing(uint64_t iterations)
+        {
+            const CountingRequest& request = prototypeRequest();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::vector<CountingTarget> invocationTargets;
+                addTargetsGrowing(request, invocationTargets);
+                doNotOptimize(&invocationTargets);
+            }
+        }
+
+        static void request_invocationTargets_reserved(uint64_t iterations)
+        {
+            const CountingRequest& request = prototypeRequest();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::vector<CountingTarget> invocationTargets;
+                addTargetsReserved(request, invocationTargets);
+                doNotOptimize(&invocationTargets);
+            }
+        }
+
+        static void request_store_getBadItems(uint64_t iterations)
+        {
+            SharedCountingRequest request(new CountingRequest(prototypeRequest()));
+            store().storeIfNeeded(request, prototypeResult(), prototypeResult().getBadTargetsMask());
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::vector<CountingRequestStore::Item> items = store().getBadItems();
+                doNotOptimize(&items);
+            }
+            store().remove(prototypeResult().requestHandle);
+        }
+
+        static void request_pipeline_old(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+                processOld(prototypeRequest());
+        }
+
+        static void request_pipeline_new(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+                processNew(prototypeRequest());
+        }
+
+        static void request_pipeline_newOwned(uint64_t iterations)
+        {
+            SharedCountingRequest request(new CountingRequest(prototypeRequest()));
+            for (uint64_t i = 0; i < iterations; i++)
+                processNewOwned(request);
+        }
+
+        static void request_invocation_new(uint64_t iterations)
+        {
+            const ReadRequest& request = prototypeReadRequest();
+            ReadResult result;
+            result.targets.resize(request.targets.size());
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                ReadInvocation* invocation = new ReadInvocation;
+                buildInvocation(request, result, *invocation);
+                doNotOptimize(invocation);
+                delete invocation;
+            }
+        }
+
+        static void buildPooledInvocations(std::size_t noOfTargets, uint64_t iterations)
+        {
+            const ReadRequest& request = prototypeReadRequest(noOfTargets);
+            ReadResult result;
+            result.targets.resize(request.targets.size());
+            InvocationPool pool;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                ReadInvocation* invocation = pool.acquire<ReadInvocation>();
+                buildInvocation(request, result, *invocation);
+                doNotOptimize(invocation);
+                pool.release(invocation);
+            }
+        }
+
+        static void request_invocation_pooled(uint64_t iterations)
+        {
+            buildPooledInvocations(100, iterations);
+        }
+
+        static void request_invocation_pooled_1(uint64_t iterations)
+        {
+            buildPooledInvocations(1, iterations);
+        }
+
+        static void request_invocation_pooled_1k(uint64_t iterations)
+        {
+            buildPooledInvocations(1000, iterations);
+        }
+
+        static void request_invocation_pooled_10k(uint64_t iterations)
+        {
+            buildPooledInvocations(10000, iterations);
+        }
+
+        static void request_invocation_pooled_100k(uint64_t iterations)
+        {
+            buildPooledInvocations(100000, iterations);
+        }
+
+
+        // Add the request benchmarks
+        // =========================================================================================
+        void addRequestBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_REQUEST_BENCHMARK(NAME) benchmarks.push_back(Benchmark("Request", #NAME, NAME));
+            ADD_REQUEST_BENCHMARK(request_copy)
+            ADD_REQUEST_BENCHMARK(request_share)
+            ADD_REQUEST_BENCHMARK(request_invocationTargets_growing)
+            ADD_REQUEST_BENCHMARK(request_invocationTargets_reserved)
+            ADD_REQUEST_BENCHMARK(request_store_getBadItems)
+            ADD_REQUEST_BENCHMARK(request_pipeline_old)
+            ADD_REQUEST_BENCHMARK(request_pipeline_new)
+            ADD_REQUEST_BENCHMARK(request_pipeline_newOwned)
+            ADD_REQUEST_BENCHMARK(request_invocation_new)
+            ADD_REQUEST_BENCHMARK(request_invocation_pooled)
+            ADD_REQUEST_BENCHMARK(request_invocation_pooled_1)
+            ADD_REQUEST_BENCHMARK(request_invocation_pooled_1k)
+            ADD_REQUEST_BENCHMARK(request_invocation_pooled_10k)
+            ADD_REQUEST_BENCHMARK(request_invocation_pooled_100k)
+#undef ADD_REQUEST_BENCHMARK
+        }
+
+
+        // Print the number of target copies per request
+        // =========================================================================================
+        void printRequestCopies()
+        {
+            const CountingRequest& request = prototypeRequest();
+            SharedCountingRequest ownedRequest(new CountingRequest(request));
+
+            printf("%-40s %14s\n", "target copies per request", "copies");
+
+            CountingTarget::copies = 0;
+            processOld(request);
+            printf("%-40s %14llu\n", "pipeline (old)", (unsigned long long)CountingTarget::copies);
+
+            CountingTarget::copies = 0;
+            processNew(request);
+            printf("%-40s %14llu\n", "pipeline (new)", (unsigned long long)CountingTarget::copies);
+
+            CountingTarget::copies = 0;
+            processNewOwned(ownedRequest);
+            printf("%-40s %14llu\n", "pipeline (new, moved request)",
+                   (unsigned long long)CountingTarget::copies);
+        }
+
+    }
+
+}
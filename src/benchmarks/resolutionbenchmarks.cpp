@@ -0,0 +1,165 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <sstream>
+#include <vector>
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/mask.h"
+#include "uaf/util/address.h"
+#include "uaf/client/database/database.h"
+#include "uaf/client/resolution/resolver.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // The resolution benchmarks measure how long it takes to resolve a "mixed" request of
+        // which most targets are absolute (an ExpandedNodeId with a namespace URI and a server
+        // URI), and the other targets are relative paths that have been resolved (and cached)
+        // before. No server is needed, since all targets can be resolved without communication.
+        // The resolver used to look up every single address in the address cache (locking and
+        // unlocking the cache for each of them, even for the absolute ones that never need the
+        // cache), and logged every address. Now the absolute targets are detected without
+        // touching the cache, and the relative paths are looked up in one pass with a single
+        // lock. resolution_perAddress_10k shows the "before" situation.
+        // =========================================================================================
+
+        static const std::size_t RELATIVE_PATH_EVERY = 5; // 20% relative paths
+
+
+        static LoggerFactory& loggerFactory()
+        {
+            static LoggerFactory factory("benchmarks");
+            return factory;
+        }
+
+
+        // create a mixed request of the given number of addresses, and cache its relative paths
+        static void prepareMixedRequest(
+                std::size_t             noOfAddresses,
+                Database&               database,
+                std::vector<Address>&   addresses)
+        {
+            const std::string serverUri("urn:benchmarks:server");
+            const std::string namespaceUri("urn:benchmarks:namespace");
+
+            Address startingAddress(NodeId("Objects", namespaceUri), serverUri);
+
+            addresses.clear();
+            addresses.reserve(noOfAddresses);
+
+            for (std::size_t i = 0; i < noOfAddresses; i++)
+            {
+                if (i % RELATIVE_PATH_EVERY == 0)
+                {
+                    std::stringstream name;
+                    name << "Variable" << i;
+                    Address address(&startingAddress,
+                                    RelativePathElement(QualifiedName(name.str(), namespaceUri)));
+                    addresses.push_back(address);
+                    database.addressCache.add(address,
+                                              ExpandedNodeId(NodeId(uint32_t(i), namespaceUri),
+                                                             serverUri));
+                }
+                else
+                {
+                    addresses.push_back(Address(NodeId(uint32_t(i), namespaceUri), serverUri));
+                }
+            }
+        }
+
+
+        static void resolveMixed(std::size_t noOfAddresses, uint64_t iterations)
+        {
+            Database database(&loggerFactory());
+            Resolver resolver(&loggerFactory(), 0, &database);
+
+            std::vector<Address> addresses;
+            prepareMixedRequest(noOfAddresses, database, addresses);
+
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::vector<ExpandedNodeId> expandedNodeIds;
+                std::vector<Status> statuses;
+                Status status = resolver.resolve(addresses, expandedNodeIds, statuses);
+                doNotOptimize(&status);
+                doNotOptimize(&expandedNodeIds);
+            }
+        }
+
+        static void resolution_mixed_1k(uint64_t iterations)
+        {
+            resolveMixed(1000, iterations);
+        }
+
+        static void resolution_mixed_10k(uint64_t iterations)
+        {
+            resolveMixed(10000, iterations);
+        }
+
+        static void resolution_mixed_100k(uint64_t iterations)
+        {
+            resolveMixed(100000, iterations);
+        }
+
+        // the way the resolver used to access the cache: one lookup (and lock) per address
+        static void resolution_perAddress_10k(uint64_t iterations)
+        {
+            Database database(&loggerFactory());
+
+            std::vector<Address> addresses;
+            prepareMixedRequest(10000, database, addresses);
+
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::vector<ExpandedNodeId> expandedNodeIds(addresses.size());
+                std::size_t found = 0;
+                for (std::size_t j = 0; j < addresses.size(); j++)
+                {
+                    if (database.addressCache.find(addresses[j], expandedNodeIds[j]))
+                        found++;
+                }
+                doNotOptimize(&found);
+                doNotOptimize(&expandedNodeIds);
+            }
+        }
+
+
+        // Add the resolution benchmarks
+        // =========================================================================================
+        void addResolutionBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_RESOLUTION_BENCHMARK(NAME) benchmarks.push_back(Benchmark("Resolution", #NAME, NAME));
+            ADD_RESOLUTION_BENCHMARK(resolution_mixed_1k)
+            ADD_RESOLUTION_BENCHMARK(resolution_mixed_10k)
+            ADD_RESOLUTION_BENCHMARK(resolution_mixed_100k)
+            ADD_RESOLUTION_BENCHMARK(resolution_perAddress_10k)
+#undef ADD_RESOLUTION_BENCHMARK
+        }
+
+    }
+
+}
@@ -0,0 +1,170 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <sstream>
+#include <string>
+#include <vector>
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/sharedconst.h"
+#include "uaf/util/pkicertificate.h"
+#include "uaf/util/pkirsakeypair.h"
+#include "uaf/client/settings/clientsettings.h"
+#include "uaf/client/database/pkistorecache.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // The security benchmarks measure the preparation of the PKI store that precedes every
+        // Sign&Encrypt connection attempt (and thus every reconnection attempt). No server is
+        // needed, since the PKI store is prepared before the connection is made.
+        // Each connection attempt used to initialize the OpenSSL PKI provider (reading all
+        // certificates and revocation lists of the trust list and issuers directories), and to
+        // load and parse the client certificate and private key. Now the PKI store is loaded
+        // once, shared by all sessions, and only reloaded when its files change.
+        // pki_signAndEncrypt_reload shows the "before" situation.
+        // =========================================================================================
+
+        static const std::size_t NO_OF_TRUSTED_CERTIFICATES = 100;
+
+
+        static LoggerFactory& loggerFactory()
+        {
+            static LoggerFactory factory("benchmarks");
+            return factory;
+        }
+
+
+        // create a PKI folder structure with a client certificate and a filled trust list
+        static const ClientSettings& pkiSettings()
+        {
+            static ClientSettings settings;
+            static bool created = false;
+
+            if (!created)
+            {
+                const std::string folder("uaf_benchmarks_pki");
+                settings.applicationUri                    = "urn:benchmarks:client";
+                settings.clientCertificate                 = folder + "/client/certs/client.der";
+                settings.clientPrivateKey                  = folder + "/client/private/client.pem";
+                settings.certificateTrustListLocation      = folder + "/trusted/certs/";
+                settings.certificateRevocationListLocation = folder + "/trusted/crl/";
+                settings.issuersCertificatesLocation       = folder + "/issuers/certs/";
+                settings.issuersRevocationListLocation     = folder + "/issuers/crl/";
+                settings.createSecurityLocationsIfNeeded   = true;
+                settings.createSecurityLocations();
+
+                PkiIdentity identity;
+                identity.organization = "UAF";
+                identity.commonName   = "Benchmarks";
+
+                PkiCertificateInfo info;
+                info.uri       = settings.applicationUri;
+                info.validTime = 60 * 60 * 24;
+
+                PkiRsaKeyPair keyPair(1024);
+                PkiCertificate certificate(info, identity, keyPair.publicKey(),
+                                           identity, keyPair.privateKey());
+                certificate.toDERFile(settings.clientCertificate);
+                keyPair.toPEMFile(settings.clientPrivateKey);
+
+                // fill the trust list with other self-signed certificates
+                for (std::size_t i = 0; i < NO_OF_TRUSTED_CERTIFICATES; i++)
+                {
+                    std::stringstream name;
+                    name << "Server" << i;
+                    PkiIdentity serverIdentity;
+                    serverIdentity.organization = "UAF";
+                    serverIdentity.commonName   = name.str();
+
+                    PkiCertificateInfo serverInfo;
+                    serverInfo.uri       = "urn:benchmarks:" + name.str();
+                    serverInfo.validTime = 60 * 60 * 24;
+
+                    PkiRsaKeyPair serverKeyPair(1024);
+                    PkiCertificate serverCertificate(serverInfo,
+                                                     serverIdentity, serverKeyPair.publicKey(),
+                                                     serverIdentity, serverKeyPair.privateKey());
+                    serverCertificate.toDERFile(settings.certificateTrustListLocation
+                                                + name.str() + ".der");
+                }
+
+                created = true;
+            }
+
+            return settings;
+        }
+
+
+        // prepare the security info of a Sign&Encrypt connection, like a session does
+        static void prepareSignAndEncrypt(PkiStoreCache& cache, bool reload, uint64_t iterations)
+        {
+            const ClientSettings& settings = pkiSettings();
+
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                if (reload)
+                    cache.clear();
+
+                SharedConst<PkiStore> store;
+                Status status = cache.acquire(settings, true, store);
+                doNotOptimize(&status);
+
+                if (status.isGood())
+                {
+                    UaClientSdk::SessionSecurityInfo uaSecurity = store->uaSecurity;
+                    doNotOptimize(&uaSecurity);
+                }
+            }
+        }
+
+        static void pki_signAndEncrypt_cached(uint64_t iterations)
+        {
+            PkiStoreCache cache(&loggerFactory());
+            prepareSignAndEncrypt(cache, false, iterations);
+        }
+
+        // the way each connection attempt used to prepare its security: load everything again
+        static void pki_signAndEncrypt_reload(uint64_t iterations)
+        {
+            PkiStoreCache cache(&loggerFactory());
+            prepareSignAndEncrypt(cache, true, iterations);
+        }
+
+
+        // Add the security benchmarks
+        // =========================================================================================
+        void addSecurityBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_SECURITY_BENCHMARK(NAME) benchmarks.push_back(Benchmark("Security", #NAME, NAME));
+            ADD_SECURITY_BENCHMARK(pki_signAndEncrypt_cached)
+            ADD_SECURITY_BENCHMARK(pki_signAndEncrypt_reload)
+#undef ADD_SECURITY_BENCHMARK
+        }
+
+    }
+
+}
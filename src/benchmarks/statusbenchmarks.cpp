@@ -0,0 +1,157 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <cstdio>
+#include <vector>
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/status.h"
+#include "uaf/util/datavalue.h"
+#include "uaf/client/results/readresulttarget.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // Before a Status shared a single error payload, it embedded one member per error type:
+        // sizeof(uaf::Status) was 6424 bytes (64-bit Linux, GCC), and copying a vector of 100000
+        // Good statuses took more than 2 seconds. The status benchmarks below, together with
+        // printTypeSizes(), show the "after" figures.
+        // =========================================================================================
+
+        static const std::size_t NUMBER_OF_STATUSES = 1000;
+
+
+        static Status goodStatus()
+        {
+            return Status(statuscodes::Good);
+        }
+
+        static Status badStatus()
+        {
+            return Status(WrongTypeError("Expected a Double but got a String"));
+        }
+
+        static void status_copy_good(uint64_t iterations)
+        {
+            Status original = goodStatus();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Status copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void status_copy_bad(uint64_t iterations)
+        {
+            Status original = badStatus();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Status copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void status_construct_bad(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Status status = badStatus();
+                doNotOptimize(&status);
+            }
+        }
+
+        static void status_copyVector_good(uint64_t iterations)
+        {
+            std::vector<Status> original(NUMBER_OF_STATUSES, goodStatus());
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::vector<Status> copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void status_copyVector_bad(uint64_t iterations)
+        {
+            std::vector<Status> original(NUMBER_OF_STATUSES, badStatus());
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::vector<Status> copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void status_toString_bad(uint64_t iterations)
+        {
+            Status status = badStatus();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::string s = status.toString();
+                doNotOptimize(&s);
+            }
+        }
+
+        static void status_summarize(uint64_t iterations)
+        {
+            std::vector<Status> statuses(NUMBER_OF_STATUSES, goodStatus());
+            statuses.back() = badStatus();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Status summary;
+                summary.summarize(statuses);
+                doNotOptimize(&summary);
+            }
+        }
+
+
+        // Add the status benchmarks
+        // =========================================================================================
+        void addStatusBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_STATUS_BENCHMARK(NAME) benchmarks.push_back(Benchmark("Status", #NAME, NAME));
+            ADD_STATUS_BENCHMARK(status_copy_good)
+            ADD_STATUS_BENCHMARK(status_copy_bad)
+            ADD_STATUS_BENCHMARK(status_construct_bad)
+            ADD_STATUS_BENCHMARK(status_copyVector_good)
+            ADD_STATUS_BENCHMARK(status_copyVector_bad)
+            ADD_STATUS_BENCHMARK(status_toString_bad)
+            ADD_STATUS_BENCHMARK(status_summarize)
+#undef ADD_STATUS_BENCHMARK
+        }
+
+
+        // Print the sizes of the types of which many instances are copied around
+        // =========================================================================================
+        void printTypeSizes()
+        {
+            printf("%-40s %14s\n", "type", "bytes");
+            printf("%-40s %14u\n", "uaf::Status",           unsigned(sizeof(Status)));
+            printf("%-40s %14u\n", "uaf::Variant",          unsigned(sizeof(Variant)));
+            printf("%-40s %14u\n", "uaf::DataValue",        unsigned(sizeof(DataValue)));
+            printf("%-40s %14u\n", "uaf::ReadResultTarget", unsigned(sizeof(ReadResultTarget)));
+        }
+
+    }
+
+}
@@ -0,0 +1,115 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+// UAF
+#include "benchmarks/benchmark.h"
+
+
+using namespace uaf::benchmarks;
+
+
+/**
+ * Run the UAF benchmarks.
+ *
+ * Usage: uaf_benchmarks [--json file] [--label label] [filter] [minimum milliseconds per benchmark]
+ *
+ * Only the benchmarks of which "group/name" contains the filter are run. With --json, the results
+ * are also written to the given file, as a JSON document with the given label (e.g. the git
+ * commit), so that they can be compared across commits.
+ */
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    std::string jsonFileName;
+    std::string label;
+    uint64_t minimumNanoseconds = 200 * 1000000ULL;
+
+    std::vector<std::string> positionalArguments;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument(argv[i]);
+        if (argument == "--json" && i + 1 < argc)
+            jsonFileName = argv[++i];
+        else if (argument == "--label" && i + 1 < argc)
+            label = argv[++i];
+        else
+            positionalArguments.push_back(argument);
+    }
+
+    if (positionalArguments.size() > 0)
+        filter = positionalArguments[0];
+    if (positionalArguments.size() > 1)
+        minimumNanoseconds = uint64_t(atoi(positionalArguments[1].c_str())) * 1000000ULL;
+
+    std::vector<Benchmark> benchmarks;
+    addUtilBenchmarks(benchmarks);
+    addVariantBenchmarks(benchmarks);
+    addConversionBenchmarks(benchmarks);
+    addStatusBenchmarks(benchmarks);
+    addRequestBenchmarks(benchmarks);
+    addResolutionBenchmarks(benchmarks);
+    addNotificationBenchmarks(benchmarks);
+    addSecurityBenchmarks(benchmarks);
+    addLoopbackBenchmarks(benchmarks);
+
+    printTypeSizes();
+    printf("\n");
+    printRequestCopies();
+    printf("\n");
+
+    printf("%-12s %-40s %14s %14s %14s\n",
+           "group", "benchmark", "iterations", "ns/iteration", "allocs/iter.");
+
+    std::vector<BenchmarkResult> results;
+
+    for (std::size_t i = 0; i < benchmarks.size(); i++)
+    {
+        std::string fullName = benchmarks[i].group + "/" + benchmarks[i].name;
+        if (fullName.find(filter) == std::string::npos)
+            continue;
+
+        BenchmarkResult result = runBenchmark(benchmarks[i], minimumNanoseconds);
+        results.push_back(result);
+
+        printf("%-12s %-40s %14llu %14.1f %14.1f\n",
+               result.group.c_str(),
+               result.name.c_str(),
+               (unsigned long long)result.iterations,
+               result.nanosecondsPerIteration(),
+               result.allocationsPerIteration());
+    }
+
+    if (!jsonFileName.empty())
+    {
+        if (!writeJson(jsonFileName, label, minimumNanoseconds, results))
+        {
+            fprintf(stderr, "Could not write the results to %s\n", jsonFileName.c_str());
+            return 1;
+        }
+        printf("\nThe results have been written to %s\n", jsonFileName.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,461 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <vector>
+// SDK
+#include "uabase/uaarraytemplates.h"
+#include "uabase/uanodeid.h"
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/mask.h"
+#include "uaf/util/nodeid.h"
+#include "uaf/util/address.h"
+#include "uaf/util/datavalue.h"
+#include "uaf/util/namespacearray.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // The util benchmarks measure the small types that every request and every result is made
+        // of: they are constructed, copied and compared once per target (or more), so a few
+        // nanoseconds here add up to milliseconds for a request of 100000 targets. The mask
+        // benchmarks use masks of MASK_SIZE items (the size of a large request), the namespace
+        // array benchmarks convert the NodeIds and QualifiedNames like the invocations do.
+        // =========================================================================================
+
+        static const std::size_t MASK_SIZE = 100000;
+
+        static const std::string NAMESPACE_URI("urn:some:namespace:uri");
+        static const std::string SERVER_URI("urn:some:server:uri");
+
+
+        // a namespace array with a few namespace URIs
+        static void fillNamespaceArray(NamespaceArray& array)
+        {
+            UaStringArray uris;
+            uris.create(3);
+            UaString("http://opcfoundation.org/UA/").copyTo(&uris[0]);
+            UaString(SERVER_URI.c_str()).copyTo(&uris[1]);
+            UaString(NAMESPACE_URI.c_str()).copyTo(&uris[2]);
+
+            OpcUa_DataValue opcUaDataValue;
+            OpcUa_DataValue_Initialize(&opcUaDataValue);
+            UaVariant uaVariant;
+            uaVariant.setStringArray(uris);
+            uaVariant.copyTo(&opcUaDataValue.Value);
+            array.fromSdk(opcUaDataValue);
+            OpcUa_DataValue_Clear(&opcUaDataValue);
+        }
+
+
+        static const NamespaceArray& nameSpaceArray()
+        {
+            static NamespaceArray array;
+            static bool initialized = false;
+            if (!initialized)
+            {
+                fillNamespaceArray(array);
+                initialized = true;
+            }
+            return array;
+        }
+
+
+        static NodeId stringNodeId()
+        {
+            return NodeId("Demo.Static.Scalar.Double", NAMESPACE_URI);
+        }
+
+        static Address relativeAddress()
+        {
+            static Address startingAddress(NodeId("Demo", NAMESPACE_URI), SERVER_URI);
+            return Address(&startingAddress,
+                           RelativePathElement(QualifiedName("Double", NAMESPACE_URI)));
+        }
+
+        static DataValue doubleArrayDataValue()
+        {
+            std::vector<double> vec(1000);
+            for (std::size_t i = 0; i < vec.size(); i++)
+                vec[i] = double(i) / 3.0;
+            DataValue dataValue;
+            dataValue.data.setDoubleArray(vec);
+            dataValue.opcUaStatusCode = OpcUa_Good;
+            dataValue.sourceTimestamp = DateTime(1.0e9);
+            dataValue.serverTimestamp = DateTime(1.0e9);
+            return dataValue;
+        }
+
+        static DataValue doubleDataValue()
+        {
+            Variant data;
+            data.setDouble(3.14);
+            DataValue dataValue(data, OpcUa_Good);
+            dataValue.sourceTimestamp = DateTime(1.0e9);
+            dataValue.serverTimestamp = DateTime(1.0e9);
+            return dataValue;
+        }
+
+        // a mask of which every other item is set
+        static Mask alternatingMask()
+        {
+            Mask mask(MASK_SIZE, false);
+            for (std::size_t i = 0; i < MASK_SIZE; i += 2)
+                mask.set(i);
+            return mask;
+        }
+
+
+        // NodeId
+        // =========================================================================================
+
+        static void nodeId_construct_string(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                NodeId nodeId = stringNodeId();
+                doNotOptimize(&nodeId);
+            }
+        }
+
+        static void nodeId_construct_numeric(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                NodeId nodeId(uint32_t(i), NAMESPACE_URI);
+                doNotOptimize(&nodeId);
+            }
+        }
+
+        static void nodeId_copy_string(uint64_t iterations)
+        {
+            NodeId original = stringNodeId();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                NodeId copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void nodeId_compare_equal(uint64_t iterations)
+        {
+            NodeId nodeId1 = stringNodeId();
+            NodeId nodeId2 = stringNodeId();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (nodeId1 == nodeId2);
+            doNotOptimize(&result);
+        }
+
+        static void nodeId_compare_lessThan(uint64_t iterations)
+        {
+            NodeId nodeId1 = stringNodeId();
+            NodeId nodeId2 = stringNodeId();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (nodeId1 < nodeId2);
+            doNotOptimize(&result);
+        }
+
+
+        // Address
+        // =========================================================================================
+
+        static void address_construct_absolute(uint64_t iterations)
+        {
+            NodeId nodeId = stringNodeId();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Address address(nodeId, SERVER_URI);
+                doNotOptimize(&address);
+            }
+        }
+
+        static void address_construct_relative(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Address address = relativeAddress();
+                doNotOptimize(&address);
+            }
+        }
+
+        static void address_copy_absolute(uint64_t iterations)
+        {
+            Address original(stringNodeId(), SERVER_URI);
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Address copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void address_copy_relative(uint64_t iterations)
+        {
+            Address original = relativeAddress();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Address copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void address_compare_equal(uint64_t iterations)
+        {
+            Address address1 = relativeAddress();
+            Address address2 = relativeAddress();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (address1 == address2);
+            doNotOptimize(&result);
+        }
+
+        static void address_compare_lessThan(uint64_t iterations)
+        {
+            Address address1 = relativeAddress();
+            Address address2 = relativeAddress();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (address1 < address2);
+            doNotOptimize(&result);
+        }
+
+
+        // DataValue
+        // =========================================================================================
+
+        static void dataValue_construct_double(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                DataValue dataValue = doubleDataValue();
+                doNotOptimize(&dataValue);
+            }
+        }
+
+        static void dataValue_copy_double(uint64_t iterations)
+        {
+            DataValue original = doubleDataValue();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                DataValue copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void dataValue_copy_doubleArray(uint64_t iterations)
+        {
+            DataValue original = doubleArrayDataValue();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                DataValue copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void dataValue_compare_doubleArrayEqual(uint64_t iterations)
+        {
+            DataValue dataValue1 = doubleArrayDataValue();
+            DataValue dataValue2 = doubleArrayDataValue();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (dataValue1 == dataValue2);
+            doNotOptimize(&result);
+        }
+
+
+        // Mask
+        // =========================================================================================
+
+        static void mask_construct_100k(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Mask mask(MASK_SIZE, true);
+                doNotOptimize(&mask);
+            }
+        }
+
+        static void mask_setUnset_100k(uint64_t iterations)
+        {
+            Mask mask(MASK_SIZE, false);
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                for (std::size_t j = 0; j < MASK_SIZE; j++)
+                    mask.set(j);
+                for (std::size_t j = 0; j < MASK_SIZE; j++)
+                    mask.unset(j);
+                doNotOptimize(&mask);
+            }
+        }
+
+        static void mask_iterateSet_100k(uint64_t iterations)
+        {
+            Mask mask = alternatingMask();
+            std::size_t count = 0;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                for (std::size_t j = 0; j < mask.size(); j++)
+                {
+                    if (mask.isSet(j))
+                        count++;
+                }
+            }
+            doNotOptimize(&count);
+        }
+
+        static void mask_and_100k(uint64_t iterations)
+        {
+            Mask mask1 = alternatingMask();
+            Mask mask2(MASK_SIZE, true);
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Mask result = mask1 && mask2;
+                doNotOptimize(&result);
+            }
+        }
+
+        static void mask_copy_100k(uint64_t iterations)
+        {
+            Mask original = alternatingMask();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Mask copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+
+        // NamespaceArray
+        // =========================================================================================
+
+        static void namespaceArray_fromSdk(uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                NamespaceArray array;
+                fillNamespaceArray(array);
+                doNotOptimize(&array);
+            }
+        }
+
+        static void namespaceArray_fillOpcUaNodeId_string(uint64_t iterations)
+        {
+            const NamespaceArray& array = nameSpaceArray();
+            NodeId nodeId = stringNodeId();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                OpcUa_NodeId opcUaNodeId;
+                OpcUa_NodeId_Initialize(&opcUaNodeId);
+                Status status = array.fillOpcUaNodeId(nodeId, opcUaNodeId);
+                doNotOptimize(&status);
+                doNotOptimize(&opcUaNodeId);
+                OpcUa_NodeId_Clear(&opcUaNodeId);
+            }
+        }
+
+        static void namespaceArray_fillOpcUaNodeId_address(uint64_t iterations)
+        {
+            const NamespaceArray& array = nameSpaceArray();
+            Address address(stringNodeId(), SERVER_URI);
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                OpcUa_NodeId opcUaNodeId;
+                OpcUa_NodeId_Initialize(&opcUaNodeId);
+                Status status = array.fillOpcUaNodeId(address, opcUaNodeId);
+                doNotOptimize(&status);
+                doNotOptimize(&opcUaNodeId);
+                OpcUa_NodeId_Clear(&opcUaNodeId);
+            }
+        }
+
+        static void namespaceArray_fillOpcUaQualifiedName(uint64_t iterations)
+        {
+            const NamespaceArray& array = nameSpaceArray();
+            QualifiedName qualifiedName("Double", NAMESPACE_URI);
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                OpcUa_QualifiedName opcUaQualifiedName;
+                OpcUa_QualifiedName_Initialize(&opcUaQualifiedName);
+                Status status = array.fillOpcUaQualifiedName(qualifiedName, opcUaQualifiedName);
+                doNotOptimize(&status);
+                doNotOptimize(&opcUaQualifiedName);
+                OpcUa_QualifiedName_Clear(&opcUaQualifiedName);
+            }
+        }
+
+        static void namespaceArray_fillNodeId(uint64_t iterations)
+        {
+            const NamespaceArray& array = nameSpaceArray();
+            OpcUa_NodeId opcUaNodeId;
+            OpcUa_NodeId_Initialize(&opcUaNodeId);
+            UaNodeId(UaString("Demo.Static.Scalar.Double"), 2).copyTo(&opcUaNodeId);
+            NodeId nodeId;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                Status status = array.fillNodeId(opcUaNodeId, nodeId);
+                doNotOptimize(&status);
+                doNotOptimize(&nodeId);
+            }
+            OpcUa_NodeId_Clear(&opcUaNodeId);
+        }
+
+
+        // Add the benchmarks of the util types
+        // =========================================================================================
+        void addUtilBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_UTIL_BENCHMARK(NAME) benchmarks.push_back(Benchmark("Util", #NAME, NAME));
+            ADD_UTIL_BENCHMARK(nodeId_construct_string)
+            ADD_UTIL_BENCHMARK(nodeId_construct_numeric)
+            ADD_UTIL_BENCHMARK(nodeId_copy_string)
+            ADD_UTIL_BENCHMARK(nodeId_compare_equal)
+            ADD_UTIL_BENCHMARK(nodeId_compare_lessThan)
+            ADD_UTIL_BENCHMARK(address_construct_absolute)
+            ADD_UTIL_BENCHMARK(address_construct_relative)
+            ADD_UTIL_BENCHMARK(address_copy_absolute)
+            ADD_UTIL_BENCHMARK(address_copy_relative)
+            ADD_UTIL_BENCHMARK(address_compare_equal)
+            ADD_UTIL_BENCHMARK(address_compare_lessThan)
+            ADD_UTIL_BENCHMARK(dataValue_construct_double)
+            ADD_UTIL_BENCHMARK(dataValue_copy_double)
+            ADD_UTIL_BENCHMARK(dataValue_copy_doubleArray)
+            ADD_UTIL_BENCHMARK(dataValue_compare_doubleArrayEqual)
+            ADD_UTIL_BENCHMARK(mask_construct_100k)
+            ADD_UTIL_BENCHMARK(mask_setUnset_100k)
+            ADD_UTIL_BENCHMARK(mask_iterateSet_100k)
+            ADD_UTIL_BENCHMARK(mask_and_100k)
+            ADD_UTIL_BENCHMARK(mask_copy_100k)
+            ADD_UTIL_BENCHMARK(namespaceArray_fromSdk)
+            ADD_UTIL_BENCHMARK(namespaceArray_fillOpcUaNodeId_string)
+            ADD_UTIL_BENCHMARK(namespaceArray_fillOpcUaNodeId_address)
+            ADD_UTIL_BENCHMARK(namespaceArray_fillOpcUaQualifiedName)
+            ADD_UTIL_BENCHMARK(namespaceArray_fillNodeId)
+#undef ADD_UTIL_BENCHMARK
+        }
+
+    }
+
+}
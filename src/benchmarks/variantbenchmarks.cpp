@@ -0,0 +1,279 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <vector>
+// UAF
+#include "benchmarks/benchmark.h"
+#include "uaf/util/variant.h"
+
+
+namespace uaf
+{
+
+    namespace benchmarks
+    {
+
+        // some test values
+        // =========================================================================================
+
+        static const std::size_t ARRAY_SIZE = 1000;
+
+        static Variant doubleVariant()
+        {
+            Variant v;
+            v.setDouble(3.14);
+            return v;
+        }
+
+        static Variant stringVariant()
+        {
+            Variant v;
+            v.setString("Some string value of a realistic length");
+            return v;
+        }
+
+        static Variant doubleArrayVariant()
+        {
+            std::vector<double> vec(ARRAY_SIZE);
+            for (std::size_t i = 0; i < vec.size(); i++)
+                vec[i] = double(i) / 3.0;
+            Variant v;
+            v.setDoubleArray(vec);
+            return v;
+        }
+
+        static Variant nodeIdVariant()
+        {
+            Variant v;
+            v.setNodeId(NodeId("Demo.Static.Scalar.Double", "urn:some:namespace:uri"));
+            return v;
+        }
+
+        static Variant nodeIdArrayVariant()
+        {
+            std::vector<NodeId> vec;
+            for (uint32_t i = 0; i < 100; i++)
+                vec.push_back(NodeId(i, "urn:some:namespace:uri"));
+            Variant v;
+            v.setNodeIdArray(vec);
+            return v;
+        }
+
+
+        // copy
+        // =========================================================================================
+
+#define IMPLEMENT_VARIANT_COPY_BENCHMARK(NAME)                                                     \
+        static void copy_##NAME(uint64_t iterations)                                               \
+        {                                                                                          \
+            Variant original = NAME##Variant();                                                    \
+            for (uint64_t i = 0; i < iterations; i++)                                              \
+            {                                                                                      \
+                Variant copy(original);                                                            \
+                doNotOptimize(&copy);                                                              \
+            }                                                                                      \
+        }
+
+        IMPLEMENT_VARIANT_COPY_BENCHMARK(double)
+        IMPLEMENT_VARIANT_COPY_BENCHMARK(string)
+        IMPLEMENT_VARIANT_COPY_BENCHMARK(doubleArray)
+        IMPLEMENT_VARIANT_COPY_BENCHMARK(nodeId)
+        IMPLEMENT_VARIANT_COPY_BENCHMARK(nodeIdArray)
+
+        static void copy_vectorOfDoubleArrays(uint64_t iterations)
+        {
+            std::vector<Variant> original(100, doubleArrayVariant());
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                std::vector<Variant> copy(original);
+                doNotOptimize(&copy);
+            }
+        }
+
+        static void copy_swapDoubleArrays(uint64_t iterations)
+        {
+            Variant v1 = doubleArrayVariant();
+            Variant v2 = stringVariant();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                v1.swap(v2);
+                doNotOptimize(&v1);
+            }
+        }
+
+
+        // convert
+        // =========================================================================================
+
+        static void convert_setDoubleArray(uint64_t iterations)
+        {
+            std::vector<double> vec(ARRAY_SIZE, 1.0);
+            Variant v;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                v.setDoubleArray(vec);
+                doNotOptimize(&v);
+            }
+        }
+
+        static void convert_toDoubleArray(uint64_t iterations)
+        {
+            Variant v = doubleArrayVariant();
+            std::vector<double> vec;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                v.toDoubleArray(vec);
+                doNotOptimize(&vec[0]);
+            }
+        }
+
+        static void convert_viewDoubleArray(uint64_t iterations)
+        {
+            Variant v = doubleArrayVariant();
+            const double* data;
+            uint32_t length;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                v.viewDoubleArray(data, length);
+                doNotOptimize(data);
+            }
+        }
+
+        static void convert_toSdkDoubleArray(uint64_t iterations)
+        {
+            Variant v = doubleArrayVariant();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                OpcUa_Variant opcUaVariant;
+                OpcUa_Variant_Initialize(&opcUaVariant);
+                v.toSdk(&opcUaVariant);
+                doNotOptimize(&opcUaVariant);
+                OpcUa_Variant_Clear(&opcUaVariant);
+            }
+        }
+
+        static void convert_fromSdkDoubleArray(uint64_t iterations)
+        {
+            UaVariant uaVariant;
+            doubleArrayVariant().toSdk(uaVariant);
+            Variant v;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                v.fromSdk(uaVariant);
+                doNotOptimize(&v);
+            }
+        }
+
+        static void convert_toNodeId(uint64_t iterations)
+        {
+            Variant v = nodeIdVariant();
+            NodeId nodeId;
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                v.toNodeId(nodeId);
+                doNotOptimize(&nodeId);
+            }
+        }
+
+
+        // compare
+        // =========================================================================================
+
+        static void compare_double(uint64_t iterations)
+        {
+            Variant v1 = doubleVariant();
+            Variant v2 = doubleVariant();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (v1 == v2);
+            doNotOptimize(&result);
+        }
+
+        static void compare_doubleArrayCopies(uint64_t iterations)
+        {
+            Variant v1 = doubleArrayVariant();
+            Variant v2 = v1;
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (v1 == v2);
+            doNotOptimize(&result);
+        }
+
+        static void compare_doubleArrayEqual(uint64_t iterations)
+        {
+            Variant v1 = doubleArrayVariant();
+            Variant v2 = doubleArrayVariant();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (v1 == v2);
+            doNotOptimize(&result);
+        }
+
+        static void compare_nodeIdArrayEqual(uint64_t iterations)
+        {
+            Variant v1 = nodeIdArrayVariant();
+            Variant v2 = nodeIdArrayVariant();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (v1 == v2);
+            doNotOptimize(&result);
+        }
+
+        static void compare_lessThanNodeId(uint64_t iterations)
+        {
+            Variant v1 = nodeIdVariant();
+            Variant v2 = nodeIdVariant();
+            bool result = false;
+            for (uint64_t i = 0; i < iterations; i++)
+                result ^= (v1 < v2);
+            doNotOptimize(&result);
+        }
+
+
+        // Add the benchmarks of uaf::Variant
+        // =========================================================================================
+        void addVariantBenchmarks(std::vector<Benchmark>& benchmarks)
+        {
+#define ADD_VARIANT_BENCHMARK(NAME) benchmarks.push_back(Benchmark("Variant", #NAME, NAME));
+            ADD_VARIANT_BENCHMARK(copy_double)
+            ADD_VARIANT_BENCHMARK(copy_string)
+            ADD_VARIANT_BENCHMARK(copy_doubleArray)
+            ADD_VARIANT_BENCHMARK(copy_nodeId)
+            ADD_VARIANT_BENCHMARK(copy_nodeIdArray)
+            ADD_VARIANT_BENCHMARK(copy_vectorOfDoubleArrays)
+            ADD_VARIANT_BENCHMARK(copy_swapDoubleArrays)
+            ADD_VARIANT_BENCHMARK(convert_setDoubleArray)
+            ADD_VARIANT_BENCHMARK(convert_toDoubleArray)
+            ADD_VARIANT_BENCHMARK(convert_viewDoubleArray)
+            ADD_VARIANT_BENCHMARK(convert_toSdkDoubleArray)
+            ADD_VARIANT_BENCHMARK(convert_fromSdkDoubleArray)
+            ADD_VARIANT_BENCHMARK(convert_toNodeId)
+            ADD_VARIANT_BENCHMARK(compare_double)
+            ADD_VARIANT_BENCHMARK(compare_doubleArrayCopies)
+            ADD_VARIANT_BENCHMARK(compare_doubleArrayEqual)
+            ADD_VARIANT_BENCHMARK(compare_nodeIdArrayEqual)
+            ADD_VARIANT_BENCHMARK(compare_lessThanNodeId)
+#undef ADD_VARIANT_BENCHMARK
+        }
+
+    }
+
+}
@@ -54,6 +54,11 @@ class Client(ClientBase):
         self.__subscriptionCallbacks__ = []
         self.__notificationsMissingCallbacks__ = []
         self.__keepAliveCallbacks__ = []
+        self.__metricsCallbacks__ = []
+        
+        # define the callback (and the lock) of the ongoing crawl
+        self.__crawlCallback__ = None
+        self.__crawlLock__ = threading.Lock()
         
         # initialize the base class
         if settings is None:
@@ -620,6 +625,11 @@ class Client(ClientBase):
         """
         Override this method to handle missing notifications.
         
+        If :attr:`~pyuaf.client.settings.ClientSettings.republishMissingNotifications` is True
+        (the default), the client first tries to recover the missing notifications, and this 
+        method is only called for the notifications that could not be recovered (possibly more
+        than once per interruption, if only some of them could be recovered).
+        
         Alternatively, you can also register callback functions which you defined yourself, by
         registering them using :meth:`pyuaf.client.Client.registerNotificationsMissingCallback`.
         
@@ -668,6 +678,58 @@ class Client(ClientBase):
         self.__notificationsMissingCallbacks__.append(dic)
     
     
+    def __dispatch_metricsReceived__(self, metrics):
+        """
+        Hidden method to be called by the UAF when the metrics are exported periodically.
+        """
+        # create a copy using the C++ copy constructor, 
+        # so that the instance may be stored on the python level:
+        metrics = pyuaf.client.Metrics(metrics)
+        
+        for callback in self.__metricsCallbacks__:
+            t = threading.Thread(target=callback, args=[metrics])
+            t.start()
+        
+        # also call the Client.metricsReceived method, which may be overridden by the user:
+        try:
+            self.metricsReceived(metrics)
+        except:
+            pass # exception raised by the user, nothing we can do!
+    
+    
+    def metricsReceived(self, metrics):
+        """
+        Override this method to receive the metrics of the client periodically.
+        
+        This method is called every 
+        :attr:`~pyuaf.client.settings.ClientSettings.metricsIntervalSec` seconds, if this 
+        interval is larger than 0.0.
+        
+        Alternatively, you can also register callback functions which you defined yourself, by
+        registering them using :meth:`pyuaf.client.Client.registerMetricsCallback`.
+        
+        :param metrics: The metrics, as returned by :meth:`~pyuaf.client.Client.metrics`.
+        :type metrics: :class:`~pyuaf.client.Metrics`
+        """
+        pass
+    
+    
+    def registerMetricsCallback(self, callback):
+        """
+        Register a callback to receive the metrics of the client periodically.
+        
+        You can register multiple callbacks: all of them will be called.
+        The :meth:`pyuaf.client.Client.metricsReceived` method (which you may override) 
+        will also always be called, regardless of the callbacks you register.
+        
+        :param callback:    A callback function. This function should have one input argument,
+                            which will be a :class:`~pyuaf.client.Metrics` instance. Use its 
+                            :meth:`~pyuaf.client.Metrics.toPrometheus` method to forward the 
+                            metrics to a monitoring system.
+        """
+        self.__metricsCallbacks__.append(callback)
+    
+    
     def __dispatch_keepAliveReceived__(self, notification):
         """
         Hidden method to be called by the UAF when KeepAlive notifications are received.
@@ -731,6 +793,49 @@ class Client(ClientBase):
         pass
     
     
+    def __dispatch_referencesCrawled__(self, sourceAddress, depth, references):
+        """
+        Hidden method to be called by the UAF when references are found during a crawl.
+        """
+        # create copies using the C++ copy constructors, 
+        # so that the instances may be stored on the python level:
+        sourceAddress = pyuaf.util.Address(sourceAddress)
+        references    = pyuaf.util.ReferenceDescriptionVector(references)
+        
+        # the callback is called from the thread that called crawl(), so we don't start a new 
+        # thread here: the callback can be sure that the references of the previous node have
+        # been handled.
+        if self.__crawlCallback__ is not None:
+            try:
+                self.__crawlCallback__(sourceAddress, depth, references)
+            except:
+                pass # exception raised by the user, nothing we can do!
+        
+        # also call the Client.referencesCrawled method, which may be overridden by the user:
+        try:
+            self.referencesCrawled(sourceAddress, depth, references)
+        except:
+            pass # exception raised by the user, nothing we can do!
+    
+    
+    def referencesCrawled(self, sourceAddress, depth, references):
+        """
+        Override this method to handle the references that are found by 
+        :meth:`~pyuaf.client.Client.crawl`.
+        
+        Alternatively, you can also provide a callback function to the 
+        :meth:`~pyuaf.client.Client.crawl` method.
+        
+        :param sourceAddress: The address of the node that was browsed.
+        :type  sourceAddress: :class:`~pyuaf.util.Address`
+        :param depth:         The depth of the browsed node (0 for the start nodes).
+        :type  depth:         ``int``
+        :param references:    The references that were found.
+        :type  references:    :class:`~pyuaf.util.ReferenceDescriptionVector`
+        """
+        pass
+    
+    
     def unregisterLoggingCallback(self):
         """
         Unregister a callback function to stop receiving all log messages.
@@ -1257,6 +1362,134 @@ class Client(ClientBase):
         return info
     
     
+    def databaseFootprint(self):
+        """
+        Get the memory footprint of the client database, per store.
+        
+        The footprint shows the persistent requests (i.e. the monitored items that are 
+        re-created after failures), the caches, and the bookkeeping of the client handles and
+        client subscription handles. Handles of deleted monitored items and subscriptions are
+        reused (after a delay), so these numbers don't keep on growing for a long running client.
+        
+        :return: The number of entries and the (approximate) number of bytes per store.
+        :rtype:  :class:`~pyuaf.client.DatabaseFootprint`
+        """
+        return ClientBase.databaseFootprint(self)
+    
+    
+    def notificationQueueStatistics(self):
+        """
+        Get the statistics of the notification queue.
+        
+        The notification queue decouples the threads that receive the notifications from your
+        callbacks (such as :meth:`~pyuaf.client.Client.dataChangesReceived`), so that a slow 
+        callback does not stall the publishing of the subscriptions. The queue is configured by 
+        the :attr:`~pyuaf.client.settings.ClientSettings.notificationQueueCapacity`,
+        :attr:`~pyuaf.client.settings.ClientSettings.notificationQueueOverflowPolicy` and
+        :attr:`~pyuaf.client.settings.ClientSettings.notificationDeliveryThreads` of the client 
+        settings. As long as the capacity is 0 (the default), there is no queue.
+        
+        :return: The current and maximum depth of the queue, and the number of queued, delivered,
+                 dropped and coalesced notifications.
+        :rtype:  :class:`~pyuaf.client.NotificationQueueStatistics`
+        """
+        return ClientBase.notificationQueueStatistics(self)
+    
+    
+    def metrics(self):
+        """
+        Get the metrics of the client.
+        
+        The metrics are counted all the time, and merged at the time of this call: 
+        
+         - the latency histograms per server and service, and the number of invocations,
+           failures, targets and invocations in flight,
+         - the connection attempts, connection losses and reconnections per server,
+         - the notifications per subscription,
+         - the depth of the notification queue,
+         - the hit ratios of the address cache, the structure definition cache and the PKI store.
+        
+        Use :meth:`~pyuaf.client.Metrics.toPrometheus` to get them in the text format of
+        Prometheus, or configure :attr:`~pyuaf.client.settings.ClientSettings.metricsIntervalSec`
+        and :attr:`~pyuaf.client.settings.ClientSettings.metricsFileName` to export them 
+        periodically.
+        
+        :return: The metrics.
+        :rtype:  :class:`~pyuaf.client.Metrics`
+        """
+        return ClientBase.metrics(self)
+    
+    
+    def registerNodes(self, addresses, serviceSettings=None, sessionSettings=None):
+        """
+        Register a number of nodes, so that they can be read and written more efficiently.
+        
+        The addresses are resolved only once, and the RegisterNodes service is invoked so that
+        the server may assign an alias (typically a numeric NodeId) to each node. The returned 
+        handle can then be given to :meth:`~pyuaf.client.Client.read` and 
+        :meth:`~pyuaf.client.Client.write` instead of the addresses, and these methods will 
+        use the aliases.
+        
+        The nodes are registered again automatically when a session is reconnected, and they
+        are unregistered when the handle is released by :meth:`~pyuaf.client.Client.unregisterNodes`
+        or when the session is disconnected.
+        
+        Example:
+        
+        .. doctest::
+        
+            >>> handle = myClient.registerNodes([address0, address1])
+            >>> result = myClient.read(handle)
+            >>> result = myClient.write(handle, [UInt32(1), UInt32(2)])
+            >>> myClient.unregisterNodes(handle)
+        
+        :param addresses:        A single address or a list of addresses of the nodes to register.
+        :type  addresses:        :class:`~pyuaf.util.Address` or a ``list`` of :class:`~pyuaf.util.Address` 
+        :param serviceSettings:  The service settings to be used (leave None for the 
+                                 defaultRegisterNodesSettings of the client settings).
+        :type  serviceSettings:  :class:`pyuaf.client.settings.ServiceSettings`
+        :param sessionSettings:  The session settings to be used (leave None for the 
+                                 session settings of the client settings).
+        :type  sessionSettings:  :class:`pyuaf.client.settings.SessionSettings`
+        :return:                 The handle of the registered nodes.
+        :rtype:                  ``int``
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        if type(addresses) == pyuaf.util.Address:
+            addressVector = pyuaf.util.AddressVector([addresses])
+        else:
+            addressVector = pyuaf.util.AddressVector(addresses)
+        statuses = pyuaf.util.StatusVector()
+        status, handle = ClientBase.registerNodes(self, 
+                                                  addressVector, 
+                                                  serviceSettings, 
+                                                  sessionSettings, 
+                                                  statuses)
+        status.test()
+        return handle
+    
+    
+    def unregisterNodes(self, handle, serviceSettings=None):
+        """
+        Release the nodes that were registered by :meth:`~pyuaf.client.Client.registerNodes`.
+        
+        The UnregisterNodes service is invoked for the nodes that are not registered by another
+        handle.
+        
+        :param handle:           The handle of the registered nodes.
+        :type  handle:           ``int``
+        :param serviceSettings:  The service settings to be used (leave None for the 
+                                 defaultRegisterNodesSettings of the client settings).
+        :type  serviceSettings:  :class:`pyuaf.client.settings.ServiceSettings`
+        :raise pyuaf.util.errors.UnknownRegisteredNodesHandleError:
+             Will be raised if the handle is unknown.
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        ClientBase.unregisterNodes(self, handle, serviceSettings).test()
+    
+    
     def read(self, addresses, attributeId=pyuaf.util.attributeids.Value, **kwargs):
         """
         Read a number of node attributes synchronously.
@@ -1265,9 +1498,14 @@ class Client(ClientBase):
         a :class:`~pyuaf.client.requests.ReadRequest` as its first argument.
         For full flexibility, use that function.
         
+        Instead of addresses, you may also give the handle of nodes that were registered by
+        :meth:`~pyuaf.client.Client.registerNodes`. In this case only the serviceSettings
+        \*\*kwarg is used.
+        
         :param addresses: A single address or a list of addresses of nodes of which the specified 
-                          attribute should be read.
-        :type  addresses: :class:`~pyuaf.util.Address` or a ``list`` of :class:`~pyuaf.util.Address` 
+                          attribute should be read, or the handle of registered nodes.
+        :type  addresses: :class:`~pyuaf.util.Address` or a ``list`` of :class:`~pyuaf.util.Address`
+                          or ``int``
         :param attributeId: The id of the attribute to be read (e.g. :attr:`pyuaf.util.attributeids.Value`
                             or :attr:`pyuaf.util.attributeids.DisplayName`).
         :type attributeId: ``int``
@@ -1283,15 +1521,26 @@ class Client(ClientBase):
         :raise pyuaf.util.errors.UafError:
              Base exception, catch this to handle any UAF errors.
         """
-        if type(addresses) == pyuaf.util.Address:
-            addressVector = pyuaf.util.AddressVector([addresses])
-        else:
-            addressVector = pyuaf.util.AddressVector(addresses)
         result = pyuaf.client.results.ReadResult()
         
         # make sure the arguments are valid (to avoid the ugly SWIG error output)
         pyuaf.util.errors.evaluateArg(attributeId, "attributeId", 
                                       int, [pyuaf.util.attributeids.Value])
+        
+        # read registered nodes
+        if isinstance(addresses, (int, long)):
+            ClientBase.read(self, 
+                            addresses, 
+                            attributeId, 
+                            __getElementFromKwargs__(kwargs, "serviceSettings"      , None), 
+                            result).test()
+            return result
+        
+        if type(addresses) == pyuaf.util.Address:
+            addressVector = pyuaf.util.AddressVector([addresses])
+        else:
+            addressVector = pyuaf.util.AddressVector(addresses)
+        
         ClientBase.read(self, 
                         addressVector, 
                         attributeId, 
@@ -1400,9 +1649,14 @@ class Client(ClientBase):
         a :class:`~pyuaf.client.requests.WriteRequest` as its first argument.
         For full flexibility, use that function.
         
+        Instead of addresses, you may also give the handle of nodes that were registered by
+        :meth:`~pyuaf.client.Client.registerNodes` (with a list of values, one for each 
+        registered node). In this case only the serviceSettings \*\*kwarg is used.
+        
         :param addresses: A single address or a list of addresses of nodes of which the specified 
-                          attribute should be written.
+                          attribute should be written, or the handle of registered nodes.
         :type  addresses: :class:`~pyuaf.util.Address` or a ``list`` of :class:`~pyuaf.util.Address` 
+                          or ``int``
         :param data: A single value or a list of values to be written.
         :type  data: :class:`~pyuaf.util.primitives.UInt32` or ``list`` of :class:`~pyuaf.util.primitives.UInt32`
                      or any other data type of the supported dynamic data types (or a ``list`` of them).
@@ -1421,6 +1675,26 @@ class Client(ClientBase):
         :raise pyuaf.util.errors.UafError:
              Base exception, catch this to handle any UAF errors.
         """
+        # write registered nodes
+        if isinstance(addresses, (int, long)):
+            dataVector = pyuaf.util.VariantVector()
+            for item in data:
+                dataVector.append(item)
+            
+            result = pyuaf.client.results.WriteResult()
+            
+            # make sure the arguments are valid (to avoid the ugly SWIG error output)
+            pyuaf.util.errors.evaluateArg(attributeId, "attributeId", int, 
+                                          [pyuaf.util.attributeids.Value])
+            
+            ClientBase.write(self, 
+                             addresses, 
+                             dataVector, 
+                             attributeId, 
+                             __getElementFromKwargs__(kwargs, "serviceSettings"      , None), 
+                             result).test()
+            return result
+        
         if len(addresses) != len(data):
             raise TypeError("The 'addresses' and 'data' arguments must either be both a " 
                             "single object, or both a list of the same size") 
@@ -1832,6 +2106,73 @@ class Client(ClientBase):
         return result
     
     
+    def crawl(self, addresses, callback=None, settings=None):
+        """
+        Crawl the address space in a breadth-first way, starting from the given nodes.
+        
+        The nodes are browsed in batches, and multiple Browse requests are processed at the same
+        time (as configured by the settings). Each node is browsed only once, even if it's 
+        referenced by many other nodes. The references are not accumulated in memory, but they
+        are forwarded to the callback (and to :meth:`~pyuaf.client.Client.referencesCrawled`)
+        as soon as they are received.
+        
+        This method blocks until the crawl is finished. Only one crawl can be performed at the 
+        same time by the same client.
+        
+        Example:
+        
+        .. doctest::
+        
+            >>> import pyuaf
+            >>> from pyuaf.util import Address, ExpandedNodeId, opcuaidentifiers
+            >>> from pyuaf.client import Client
+            >>> from pyuaf.client.settings import CrawlSettings
+            >>> 
+            >>> myClient  = Client("myClient", ["opc.tcp://localhost:4841"])
+            >>> serverUri = "http://mycompany.com/servers/plc1"
+            >>> objects   = Address(ExpandedNodeId(opcuaidentifiers.OpcUaId_ObjectsFolder, 0, serverUri))
+            >>> 
+            >>> def printReferences(sourceAddress, depth, references):
+            ...     for ref in references:
+            ...         print("%s%s" %("  " * depth, ref.browseName))
+            >>> 
+            >>> settings = CrawlSettings()
+            >>> settings.maxDepth = 3
+            >>> statistics = myClient.crawl([objects], printReferences, settings)
+        
+        :param addresses: A single address or a list of addresses of nodes to start crawling from.
+        :type  addresses: :class:`~pyuaf.util.Address` or a ``list`` of 
+                          :class:`~pyuaf.util.Address` 
+        :param callback:  A callback function, with three arguments: the source address 
+                          (:class:`~pyuaf.util.Address`), the depth (``int``) and the references
+                          (:class:`~pyuaf.util.ReferenceDescriptionVector`).
+        :param settings:  The crawl settings (leave None for default settings).
+        :type  settings:  :class:`~pyuaf.client.settings.CrawlSettings`
+        :return:          Statistics about the crawl.
+        :rtype:           :class:`~pyuaf.client.CrawlStatistics`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        if type(addresses) == pyuaf.util.Address:
+            addressVector = pyuaf.util.AddressVector([addresses])
+        else:
+            addressVector = pyuaf.util.AddressVector(addresses)
+        
+        statistics = pyuaf.client.CrawlStatistics()
+        
+        self.__crawlLock__.acquire()
+        try:
+            self.__crawlCallback__ = callback
+            status = ClientBase.crawl(self, addressVector, settings, statistics)
+        finally:
+            self.__crawlCallback__ = None
+            self.__crawlLock__.release()
+        
+        status.test()
+        
+        return statistics
+    
+    
     def historyReadRaw(self, addresses, startTime, endTime, numValuesPerNode=0, maxAutoReadMore=0, 
                        continuationPoints=[], **kwargs):
         """
@@ -2473,6 +2814,91 @@ class Client(ClientBase):
         return results
         
             
+    def deleteMonitoredItems(self, clientHandles, serviceSettings=None):
+        """
+        Delete the specified monitored items.
+        
+        The monitored items are deleted on the server side, and they are removed from the 
+        persistent requests that created them, so the UAF will never re-create them anymore 
+        (not even after a reconnection). Their client handles are released.
+        
+        Monitored items of which the session is disconnected at the moment are only removed from
+        the persistent requests.
+        
+        Example:
+        
+        .. doctest::
+        
+            >>> statuses = myClient.deleteMonitoredItems(clientHandles)
+            >>> for i in xrange(len(statuses)):
+            ...     if not statuses[i].isGood():
+            ...         print("Could not delete monitored item %d: %s" %(clientHandles[i], statuses[i]))
+        
+        :param clientHandles:    List of client handles of the monitored items you want to delete.
+        :type  clientHandles:    ``list`` of ``int``
+        :param serviceSettings:  The service settings to be used (leave None for the 
+                                 defaultDeleteMonitoredItemsSettings of the client settings).
+        :type  serviceSettings:  :class:`pyuaf.client.settings.ServiceSettings`
+        :return:                 A list of statuses, one for each client handle.
+        :rtype:                  :class:`~pyuaf.util.StatusVector`.
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        results = pyuaf.util.StatusVector()
+        status = ClientBase.deleteMonitoredItems(self, 
+                                                 clientHandles, 
+                                                 serviceSettings, 
+                                                 results)
+        status.test()
+        return results
+        
+    
+    def modifyMonitoredItems(self, clientHandles, settings, serviceSettings=None):
+        """
+        Modify the specified monitored items, e.g. to change their sampling interval without
+        having to delete and re-create them.
+        
+        The monitored items are modified on the server side (with one service call per
+        subscription), and the persistent requests that created them are updated, so the UAF will
+        re-create them with the modified settings (e.g. after a reconnection).
+        
+        The settings must be of the same kind (data or event) as the monitored items, otherwise
+        the status of the monitored item will be a :class:`~pyuaf.util.errors.WrongTypeError`. 
+        If the filter of the settings is None, the current filter of the monitored items is kept.
+        
+        Example:
+        
+        .. doctest::
+        
+            >>> from pyuaf.client.settings import MonitoredItemSettings
+            >>>
+            >>> settings = MonitoredItemSettings()
+            >>> settings.samplingIntervalSec = 0.1
+            >>> settings.queueSize = 10
+            >>> statuses = myClient.modifyMonitoredItems(clientHandles, settings)
+        
+        :param clientHandles:    List of client handles of the monitored items you want to modify.
+        :type  clientHandles:    ``list`` of ``int``
+        :param settings:         The new settings of the monitored items.
+        :type  settings:         :class:`~pyuaf.client.settings.MonitoredItemSettings`
+        :param serviceSettings:  The service settings to be used (leave None for the 
+                                 defaultModifyMonitoredItemsSettings of the client settings).
+        :type  serviceSettings:  :class:`pyuaf.client.settings.ServiceSettings`
+        :return:                 A list of statuses, one for each client handle.
+        :rtype:                  :class:`~pyuaf.util.StatusVector`.
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        results = pyuaf.util.StatusVector()
+        status = ClientBase.modifyMonitoredItems(self, 
+                                                 clientHandles, 
+                                                 settings, 
+                                                 serviceSettings, 
+                                                 results)
+        status.test()
+        return results
+        
+            
     def structureDefinition(self, dataTypeId):
         """
         Get a structure definition for the given datatype NodeId.
@@ -2492,6 +2918,35 @@ class Client(ClientBase):
         return result
         
         
+    def structureCodec(self, dataTypeId, serverUri=""):
+        """
+        Get a compiled structure definition (a "codec") for the given datatype NodeId.
+        
+        The codec can decode many ExtensionObjects of this datatype into flat records 
+        (see :meth:`pyuaf.util.StructureCodec.decode`), and encode them again, without having to
+        resolve the fields by name for every value.
+        
+        The definitions are cached per server and datatype, so they are only fetched from the
+        server (and compiled) once.
+        
+        :param dataTypeId:    NodeId of the datatype.
+        :type  dataTypeId:    :class:`~pyuaf.util.NodeId`.
+        :param serverUri:     URI of the server that exposes the datatype, or an empty string
+                              (default) to accept the definition of any connected server.
+        :type  serverUri:     ``str``
+        :return:              The compiled definition of this datatype. 
+        :rtype:               :class:`~pyuaf.util.StructureCodec`.
+        :raise pyuaf.util.errors.DefinitionNotFoundError:
+             Will be raised if no definition could be found.
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        result = pyuaf.util.StructureCodec()
+        status = ClientBase.structureCodec(self, dataTypeId, serverUri, result)
+        status.test()
+        return result
+        
+        
         
     def processRequest(self, request, resultCallback=None, notificationCallbacks=[]):
         """
@@ -67,6 +67,14 @@
 #include "uaf/client/subscriptions/monitorediteminformation.h"
 #include "uaf/client/sessions/sessionstates.h"
 #include "uaf/client/sessions/sessioninformation.h"
+#include "uaf/client/crawling/crawlstatistics.h"
+#include "uaf/client/database/databasefootprint.h"
+#include "uaf/client/settings/overflowpolicies.h"
+#include "uaf/client/subscriptions/notificationqueuestatistics.h"
+#include "uaf/client/metrics/servicemetrics.h"
+#include "uaf/client/metrics/servermetrics.h"
+#include "uaf/client/metrics/subscriptionmetrics.h"
+#include "uaf/client/metrics/metrics.h"
 %}
 
 
@@ -127,6 +135,7 @@ import time
 %import "pyuaf/client/client_connectionsteps.i"
 %import "pyuaf/client/client_subscriptionstates.i" 
 %import "pyuaf/client/client_monitoreditemstates.i"
+%import "pyuaf/client/client_overflowpolicies.i"
 %import "pyuaf/client/client_settings.i"
 %import "pyuaf/client/client_requests.i"
 %import "pyuaf/client/client_results.i"
@@ -139,10 +148,12 @@ import time
 %rename(__dispatch_dataChangesReceived__)                   uaf::ClientInterface::dataChangesReceived;
 %rename(__dispatch_eventsReceived__)                        uaf::ClientInterface::eventsReceived;
 %rename(__dispatch_keepAliveReceived__)                     uaf::ClientInterface::keepAliveReceived;
+%rename(__dispatch_referencesCrawled__)                     uaf::ClientInterface::referencesCrawled;
 %rename(__dispatch_connectionStatusChanged__)               uaf::ClientInterface::connectionStatusChanged;
 %rename(__dispatch_subscriptionStatusChanged__)             uaf::ClientInterface::subscriptionStatusChanged;
 %rename(__dispatch_notificationsMissing__)                  uaf::ClientInterface::notificationsMissing;
 %rename(__dispatch_untrustedServerCertificateReceived__)    uaf::ClientInterface::untrustedServerCertificateReceived;
+%rename(__dispatch_metricsReceived__)                       uaf::ClientInterface::metricsReceived;
 
 
 // now include all classes in a generic way
@@ -153,6 +164,13 @@ UAF_WRAP_CLASS("uaf/client/subscriptions/datachangenotification.h"    , uaf , Da
 UAF_WRAP_CLASS("uaf/client/subscriptions/eventnotification.h"         , uaf , EventNotification         , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client, EventNotificationVector)
 UAF_WRAP_CLASS("uaf/client/subscriptions/keepalivenotification.h"     , uaf , KeepAliveNotification     , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/sessions/sessioninformation.h"             , uaf , SessionInformation        , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client, SessionInformationVector)
+UAF_WRAP_CLASS("uaf/client/crawling/crawlstatistics.h"                , uaf , CrawlStatistics           , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/database/databasefootprint.h"              , uaf , DatabaseFootprint         , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/subscriptions/notificationqueuestatistics.h", uaf , NotificationQueueStatistics, COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/metrics/servicemetrics.h"                  , uaf , ServiceMetrics            , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, ServiceMetricsVector)
+UAF_WRAP_CLASS("uaf/client/metrics/servermetrics.h"                   , uaf , ServerMetrics             , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, ServerMetricsVector)
+UAF_WRAP_CLASS("uaf/client/metrics/subscriptionmetrics.h"             , uaf , SubscriptionMetrics       , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, SubscriptionMetricsVector)
+UAF_WRAP_CLASS("uaf/client/metrics/metrics.h"                         , uaf , Metrics                   , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/clientinterface.h"                         , uaf , ClientInterface           , COPY_NO,  TOSTRING_NO,  COMP_NO,  pyuaf.client, VECTOR_NO)
 
 
@@ -162,9 +180,11 @@ UAF_WRAP_CLASS("uaf/client/clientinterface.h"                         , uaf , Cl
 // apply the OUTPUT and INOUT directives
 %apply uaf::ClientConnectionId & OUTPUT { uaf::ClientConnectionId & clientConnectionId };
 %apply uaf::ClientSubscriptionHandle & OUTPUT { uaf::ClientSubscriptionHandle & clientSubscriptionHandle };
+%apply uaf::RegisteredNodesHandle & OUTPUT { uaf::RegisteredNodesHandle & handle };
 %include "uaf/client/client.h"
 // clear the OUTPUT and INOUT directives
 %clear uaf::ClientConnectionId & clientConnectionId;
 %clear uaf::ClientConnectionId & clientSubscriptionHandle;
+%clear uaf::RegisteredNodesHandle & handle;
 // finally, include the client code:
 %include "pyuaf/client/client.py"
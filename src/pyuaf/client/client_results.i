@@ -35,6 +35,8 @@
 #include "uaf/client/results/translatebrowsepathstonodeidsresulttarget.h"
 #include "uaf/client/results/writeresulttarget.h"
 #include "uaf/client/results/historyreadrawmodifiedresulttarget.h"
+#include "uaf/client/results/tracespan.h"
+#include "uaf/client/results/requesttrace.h"
 #include "uaf/client/results/results.h"
 %}
 
@@ -93,6 +95,8 @@ UAF_WRAP_CLASS("uaf/client/results/readresulttarget.h"
 UAF_WRAP_CLASS("uaf/client/results/translatebrowsepathstonodeidsresulttarget.h" , uaf , TranslateBrowsePathsToNodeIdsResultTarget , COPY_NO , TOSTRING_YES, COMP_YES, pyuaf.client.results, TranslateBrowsePathsToNodeIdsResultTargetVector)
 UAF_WRAP_CLASS("uaf/client/results/writeresulttarget.h"                         , uaf , WriteResultTarget                         , COPY_NO , TOSTRING_YES, COMP_YES, pyuaf.client.results, WriteResultTargetVector)
 UAF_WRAP_CLASS("uaf/client/results/historyreadrawmodifiedresulttarget.h"        , uaf , HistoryReadRawModifiedResultTarget        , COPY_NO , TOSTRING_YES, COMP_YES, pyuaf.client.results, HistoryReadRawModifiedResultTargetVector)
+UAF_WRAP_CLASS("uaf/client/results/tracespan.h"                                 , uaf , TraceSpan                                 , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client.results, TraceSpanVector)
+UAF_WRAP_CLASS("uaf/client/results/requesttrace.h"                              , uaf , RequestTrace                              , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client.results, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/results/basesessionresult.h"                         , uaf , BaseSessionResult                         , COPY_YES, TOSTRING_NO,  COMP_NO,  pyuaf.client.results, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/results/basesubscriptionresult.h"                    , uaf , BaseSubscriptionResult                    , COPY_YES, TOSTRING_NO,  COMP_NO,  pyuaf.client.results, VECTOR_NO)
 
@@ -25,6 +25,7 @@
 #include "uaf/client/settings/servicesettings.h"
 #include "uaf/client/settings/browsesettings.h"
 #include "uaf/client/settings/browsenextsettings.h"
+#include "uaf/client/settings/crawlsettings.h"
 #include "uaf/client/settings/createmonitoreddatasettings.h"
 #include "uaf/client/settings/createmonitoredeventssettings.h"
 #include "uaf/client/settings/methodcallsettings.h"
@@ -67,6 +68,7 @@
 %import(module="pyuaf.util.opcuaidentifiers")       "pyuaf/util/util_opcuaidentifiers.i"
 %import(module="pyuaf.util.opcuaidentifiers")       "pyuaf/util/util_opcuastatuscodes.i"
 %import(module="pyuaf.util.primitives")             "pyuaf/util/util_primitives.i"
+%import(module="pyuaf.client.overflowpolicies")  "pyuaf/client/client_overflowpolicies.i"
 %import(module="pyuaf.util.securitypolicies")       "pyuaf/util/util_securitypolicies.i"
 %import(module="pyuaf.util.serverstates")           "pyuaf/util/util_serverstates.i"
 %import(module="pyuaf.util.monitoringmodes")        "pyuaf/util/util_monitoringmodes.i"
@@ -103,6 +105,7 @@ UAF_WRAP_CLASS("uaf/client/settings/methodcallsettings.h"                    , u
 UAF_WRAP_CLASS("uaf/client/settings/translatebrowsepathstonodeidssettings.h" , uaf , TranslateBrowsePathsToNodeIdsSettings , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/browsesettings.h"                        , uaf , BrowseSettings                        , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/browsenextsettings.h"                    , uaf , BrowseNextSettings                    , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/settings/crawlsettings.h"                         , uaf , CrawlSettings                         , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/createmonitoreddatasettings.h"           , uaf , CreateMonitoredDataSettings           , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/createmonitoredeventssettings.h"         , uaf , CreateMonitoredEventsSettings         , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 
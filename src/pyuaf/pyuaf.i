@@ -39,6 +39,7 @@
 %ignore fromSdkToUaf;
 %ignore fromUafToSdk;
 %ignore fromSdk;
+%ignore fromSdkWithDetach;
 %ignore toSdk;
 
 
@@ -51,6 +51,231 @@
 
 
 
+#ifndef SWIG
+
+// Get the OPC UA type of the elements of a buffer (numpy.ndarray, array.array, memoryview, ...),
+// or uaf::opcuatypes::Null if the buffer is not a one-dimensional array of numeric elements in
+// native byte order. Zero-dimensional buffers (e.g. numpy.float64(1.0)) are left to the scalar
+// conversions, and multi-dimensional ones are not supported since a Variant has no dimensions.
+static inline uaf::opcuatypes::OpcUaType pyuafBufferType(const Py_buffer& view)
+{
+    if (view.ndim != 1)
+        return uaf::opcuatypes::Null;
+
+    const char* format = (view.format == NULL) ? "B" : view.format;
+
+    static const uint16_t endiannessTest = 1;
+    bool littleEndian = (*((const uint8_t*)&endiannessTest) == 1);
+
+    if (    *format == '@'
+         || *format == '='
+         || (*format == '<' && littleEndian)
+         || ((*format == '>' || *format == '!') && !littleEndian))
+        format++;
+
+    if (format[0] == '\0' || format[1] != '\0')
+        return uaf::opcuatypes::Null;
+
+    switch (format[0])
+    {
+        case '?':
+            return (view.itemsize == 1) ? uaf::opcuatypes::Boolean : uaf::opcuatypes::Null;
+        case 'b': case 'h': case 'i': case 'l': case 'q':
+            switch (view.itemsize)
+            {
+                case 1:  return uaf::opcuatypes::SByte;
+                case 2:  return uaf::opcuatypes::Int16;
+                case 4:  return uaf::opcuatypes::Int32;
+                case 8:  return uaf::opcuatypes::Int64;
+                default: return uaf::opcuatypes::Null;
+            }
+        case 'B': case 'H': case 'I': case 'L': case 'Q':
+            switch (view.itemsize)
+            {
+                case 1:  return uaf::opcuatypes::Byte;
+                case 2:  return uaf::opcuatypes::UInt16;
+                case 4:  return uaf::opcuatypes::UInt32;
+                case 8:  return uaf::opcuatypes::UInt64;
+                default: return uaf::opcuatypes::Null;
+            }
+        case 'f':
+            return (view.itemsize == 4) ? uaf::opcuatypes::Float : uaf::opcuatypes::Null;
+        case 'd':
+            return (view.itemsize == 8) ? uaf::opcuatypes::Double : uaf::opcuatypes::Null;
+        default:
+            return uaf::opcuatypes::Null;
+    }
+}
+
+
+// Check if an object exposes a buffer of numeric elements.
+static inline bool pyuafIsNumericBuffer(PyObject* object)
+{
+    if (!PyObject_CheckBuffer(object))
+        return false;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(object, &view, PyBUF_FORMAT | PyBUF_ND) != 0)
+    {
+        PyErr_Clear();
+        return false;
+    }
+
+    bool ret = (pyuafBufferType(view) != uaf::opcuatypes::Null);
+    PyBuffer_Release(&view);
+    return ret;
+}
+
+
+// Convert a one-dimensional buffer of numeric elements into an array variant, by copying the
+// data in one go. Python strings are buffers too, but they are converted to String variants
+// before this function is tried.
+// Returns 1 if converted, 0 if the object is not a numeric buffer, or -1 if an error occurred
+// (in which case a Python exception has been set).
+static inline int pyuafBufferToVariant(PyObject* object, uaf::Variant& variant)
+{
+    if (!PyObject_CheckBuffer(object))
+        return 0;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(object, &view, PyBUF_FULL_RO) != 0)
+    {
+        PyErr_Clear();
+        return 0;
+    }
+
+    int ret = 0;
+    uaf::opcuatypes::OpcUaType type = pyuafBufferType(view);
+
+    if (type != uaf::opcuatypes::Null)
+    {
+        uint32_t length = static_cast<uint32_t>(view.len / view.itemsize);
+        uaf::Status status;
+
+        if (PyBuffer_IsContiguous(&view, 'C'))
+        {
+            status = variant.setNumericArray(type, view.buf, length);
+        }
+        else
+        {
+            // e.g. a strided slice of a numpy array: gather the elements first
+            std::vector<char> contiguous(view.len);
+            if (view.len > 0 && PyBuffer_ToContiguous(&contiguous[0], &view, view.len, 'C') != 0)
+            {
+                PyBuffer_Release(&view);
+                return -1;
+            }
+            status = variant.setNumericArray(type, contiguous.empty() ? 0 : &contiguous[0], length);
+        }
+
+        if (status.isGood())
+        {
+            ret = 1;
+        }
+        else
+        {
+            PyErr_SetString(PyExc_TypeError, status.toString().c_str());
+            ret = -1;
+        }
+    }
+
+    PyBuffer_Release(&view);
+    return ret;
+}
+
+
+// Convert a numeric array variant into a NumPy array, by copying the data only once.
+// Returns a new reference, or NULL (without an exception being set) if the variant is not a
+// numeric array, if pyuaf.util.NUMPY_ARRAYS is False, or if NumPy is not available.
+static inline PyObject* pyuafNumericArrayToNumpy(const uaf::Variant& variant)
+{
+    const char* dtype;
+    switch (variant.type())
+    {
+        case uaf::opcuatypes::Boolean:  dtype = "?";  break;
+        case uaf::opcuatypes::SByte:    dtype = "i1"; break;
+        case uaf::opcuatypes::Byte:     dtype = "u1"; break;
+        case uaf::opcuatypes::Int16:    dtype = "i2"; break;
+        case uaf::opcuatypes::UInt16:   dtype = "u2"; break;
+        case uaf::opcuatypes::Int32:    dtype = "i4"; break;
+        case uaf::opcuatypes::UInt32:   dtype = "u4"; break;
+        case uaf::opcuatypes::Int64:    dtype = "i8"; break;
+        case uaf::opcuatypes::UInt64:   dtype = "u8"; break;
+        case uaf::opcuatypes::Float:    dtype = "f4"; break;
+        case uaf::opcuatypes::Double:   dtype = "f8"; break;
+        default:                        return NULL;
+    }
+
+    // the modules are only looked up once, since this function is called for every numeric array
+    // (the references are kept for the lifetime of the process)
+    static PyObject* utilModule      = NULL;
+    static PyObject* numpyFrombuffer = NULL;
+    static bool      numpyImported   = false;
+
+    if (utilModule == NULL)
+    {
+        utilModule = PyImport_ImportModule("pyuaf.util");
+        if (utilModule == NULL)
+        {
+            PyErr_Clear();
+            return NULL;
+        }
+    }
+
+    // check the pyuaf.util.NUMPY_ARRAYS flag (every time, since the user may change it)
+    PyObject* flag = PyObject_GetAttrString(utilModule, "NUMPY_ARRAYS");
+    if (flag == NULL)
+    {
+        PyErr_Clear();
+        return NULL;
+    }
+    int enabled = PyObject_IsTrue(flag);
+    Py_DECREF(flag);
+    if (enabled != 1)
+    {
+        PyErr_Clear();
+        return NULL;
+    }
+
+    // if NumPy is not available, don't try to import it again
+    if (!numpyImported)
+    {
+        numpyImported = true;
+        PyObject* numpyModule = PyImport_ImportModule("numpy");
+        if (numpyModule != NULL)
+        {
+            numpyFrombuffer = PyObject_GetAttrString(numpyModule, "frombuffer");
+            Py_DECREF(numpyModule);
+        }
+        if (numpyFrombuffer == NULL)
+            PyErr_Clear();
+    }
+    if (numpyFrombuffer == NULL)
+        return NULL;
+
+    // copy the data once into a bytearray, which is then shared (not copied) by the NumPy array
+    const void* data = variant.numericArrayData();
+    Py_ssize_t size = (data == 0) ? 0 : static_cast<Py_ssize_t>(
+            variant.arraySize() * uaf::Variant::numericTypeSize(variant.type()));
+
+    PyObject* ret = NULL;
+    PyObject* bytes = PyByteArray_FromStringAndSize(static_cast<const char*>(data), size);
+    if (bytes != NULL)
+    {
+        ret = PyObject_CallFunction(numpyFrombuffer, (char*)"Os", bytes, dtype);
+        Py_DECREF(bytes);
+    }
+
+    if (ret == NULL)
+        PyErr_Clear();
+
+    return ret;
+}
+
+#endif /* SWIG */
+
+
+
 #define VARIANT_CHECK(INPUT, RESULT)                                                               \
         if (PyBool_Check(INPUT))                                                                   \
             RESULT = 1;                                                                            \
@@ -60,6 +285,8 @@
             RESULT = 1;                                                                            \
         else if (PyByteArray_Check(INPUT))                                                         \
             RESULT = 1;                                                                            \
+        else if (pyuafIsNumericBuffer(INPUT))                                                      \
+            RESULT = 1;                                                                            \
         else if (PySequence_Check(INPUT))                                                          \
         {                                                                                          \
             bool allGood = true;                                                                   \
@@ -286,6 +513,7 @@
 
 #define PYOBJECT_TO_UAF_VARIANT(PYOBJECT, VARIANT)                                                 \
             void *ptr;                                                                             \
+            int bufferConversion = 0;                                                              \
     if (PYOBJECT == Py_None)                                                                       \
     {    VARIANT.clear();    }                                                                     \
     else if (PyBool_Check(PYOBJECT))                                                               \
@@ -308,6 +536,11 @@
         Py_ssize_t length = PyByteArray_Size(PYOBJECT);                                            \
         VARIANT.setByteString((uint8_t*)data, length);                                             \
     }                                                                                              \
+    else if ((bufferConversion = pyuafBufferToVariant(PYOBJECT, VARIANT)) != 0)                    \
+    {                                                                                              \
+        if (bufferConversion < 0)                                                                  \
+            return NULL;                                                                           \
+    }                                                                                              \
     else if (PySequence_Check(PYOBJECT))                                                           \
     {                                                                                              \
         Py_ssize_t length = PySequence_Size(PYOBJECT);                                             \
@@ -379,6 +612,14 @@
     }
 
 
+#define CREATE_NUMERIC_ARRAY(TYPE, CTYPE, VARIANT, PYRESULT)                                    \
+    PYRESULT = pyuafNumericArrayToNumpy(VARIANT);                                               \
+    if (PYRESULT == NULL)                                                                       \
+    {                                                                                           \
+        CREATE_PRIMITIVE_ARRAY(TYPE, CTYPE, VARIANT, PYRESULT)                                  \
+    }
+
+
 #define CREATE_UAFTYPE_ARRAY(TYPE, VARIANT, PYRESULT)                                           \
     std::vector<uaf::TYPE> vec;                                                                 \
     uaf::Status conversionStatus = VARIANT.to##TYPE##Array(vec);                                \
@@ -399,17 +640,17 @@
 
 
 #define CREATE_ARRAYOBJECT(VARIANT, PYOBJECT)  \
-    if (VARIANT.type() == uaf::opcuatypes::Boolean)              { CREATE_PRIMITIVE_ARRAY(Boolean,    bool, VARIANT, PYOBJECT)     } \
-    else if (VARIANT.type() == uaf::opcuatypes::SByte)           { CREATE_PRIMITIVE_ARRAY(SByte,      int8_t, VARIANT, PYOBJECT)   } \
-    else if (VARIANT.type() == uaf::opcuatypes::Byte)            { CREATE_PRIMITIVE_ARRAY(Byte,       uint8_t, VARIANT, PYOBJECT)  } \
-    else if (VARIANT.type() == uaf::opcuatypes::Int16)           { CREATE_PRIMITIVE_ARRAY(Int16,      int16_t, VARIANT, PYOBJECT)  } \
-    else if (VARIANT.type() == uaf::opcuatypes::UInt16)          { CREATE_PRIMITIVE_ARRAY(UInt16,     uint16_t, VARIANT, PYOBJECT) } \
-    else if (VARIANT.type() == uaf::opcuatypes::Int32)           { CREATE_PRIMITIVE_ARRAY(Int32,      int32_t, VARIANT, PYOBJECT)  } \
-    else if (VARIANT.type() == uaf::opcuatypes::UInt32)          { CREATE_PRIMITIVE_ARRAY(UInt32,     uint32_t, VARIANT, PYOBJECT) } \
-    else if (VARIANT.type() == uaf::opcuatypes::Int64)           { CREATE_PRIMITIVE_ARRAY(Int64,      int64_t, VARIANT, PYOBJECT)  } \
-    else if (VARIANT.type() == uaf::opcuatypes::UInt64)          { CREATE_PRIMITIVE_ARRAY(UInt64,     uint64_t, VARIANT, PYOBJECT) } \
-    else if (VARIANT.type() == uaf::opcuatypes::Float)           { CREATE_PRIMITIVE_ARRAY(Float,      float, VARIANT, PYOBJECT)    } \
-    else if (VARIANT.type() == uaf::opcuatypes::Double)          { CREATE_PRIMITIVE_ARRAY(Double,     double, VARIANT, PYOBJECT)   } \
+    if (VARIANT.type() == uaf::opcuatypes::Boolean)              { CREATE_NUMERIC_ARRAY(Boolean,    bool, VARIANT, PYOBJECT)     } \
+    else if (VARIANT.type() == uaf::opcuatypes::SByte)           { CREATE_NUMERIC_ARRAY(SByte,      int8_t, VARIANT, PYOBJECT)   } \
+    else if (VARIANT.type() == uaf::opcuatypes::Byte)            { CREATE_NUMERIC_ARRAY(Byte,       uint8_t, VARIANT, PYOBJECT)  } \
+    else if (VARIANT.type() == uaf::opcuatypes::Int16)           { CREATE_NUMERIC_ARRAY(Int16,      int16_t, VARIANT, PYOBJECT)  } \
+    else if (VARIANT.type() == uaf::opcuatypes::UInt16)          { CREATE_NUMERIC_ARRAY(UInt16,     uint16_t, VARIANT, PYOBJECT) } \
+    else if (VARIANT.type() == uaf::opcuatypes::Int32)           { CREATE_NUMERIC_ARRAY(Int32,      int32_t, VARIANT, PYOBJECT)  } \
+    else if (VARIANT.type() == uaf::opcuatypes::UInt32)          { CREATE_NUMERIC_ARRAY(UInt32,     uint32_t, VARIANT, PYOBJECT) } \
+    else if (VARIANT.type() == uaf::opcuatypes::Int64)           { CREATE_NUMERIC_ARRAY(Int64,      int64_t, VARIANT, PYOBJECT)  } \
+    else if (VARIANT.type() == uaf::opcuatypes::UInt64)          { CREATE_NUMERIC_ARRAY(UInt64,     uint64_t, VARIANT, PYOBJECT) } \
+    else if (VARIANT.type() == uaf::opcuatypes::Float)           { CREATE_NUMERIC_ARRAY(Float,      float, VARIANT, PYOBJECT)    } \
+    else if (VARIANT.type() == uaf::opcuatypes::Double)          { CREATE_NUMERIC_ARRAY(Double,     double, VARIANT, PYOBJECT)   } \
     else if (VARIANT.type() == uaf::opcuatypes::String)          { CREATE_PRIMITIVE_ARRAY(String,     std::string, VARIANT, PYOBJECT)   } \
     else if (VARIANT.type() == uaf::opcuatypes::ByteString)      { CREATE_PRIMITIVE_ARRAY(ByteString, uaf::ByteString, VARIANT, PYOBJECT)   } \
     else if (VARIANT.type() == uaf::opcuatypes::NodeId)          { CREATE_UAFTYPE_ARRAY(NodeId, VARIANT, PYOBJECT)         } \
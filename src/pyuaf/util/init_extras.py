@@ -24,5 +24,11 @@ def convert_uint32_to_int32(uint32):
 def convert_int32_to_uint32(int32):
     return int(int32 & 0xffffffff)
 
+
+# Numeric arrays (of Boolean, SByte, Byte, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float or
+# Double values) are converted into lists of pyuaf.util.primitives by default. Set NUMPY_ARRAYS to
+# True to get NumPy arrays instead (if NumPy is installed), which is much faster for large arrays.
+NUMPY_ARRAYS = False
+
 ################################### END OF INCLUDED PYTHON FILE ####################################
 %}
@@ -1,5 +1,7 @@
 
+import os
 import sys
+import tempfile
 import threading
 
 try:
@@ -166,6 +168,52 @@ def testVector(testCase, vectorClass, testItems=[]):
 
 
 
+def tempFileName(name):
+    """
+    Get the full path of a file in the temporary directory, and remove the file if it exists.
+    """
+    fileName = os.path.join(tempfile.gettempdir(), name)
+    if os.path.exists(fileName):
+        os.remove(fileName)
+    return fileName
+
+
+
+
+def demoClientSettings(args):
+    """
+    Get ClientSettings that discover the demo server of the parsed arguments (see parseArgs()).
+    """
+    import pyuaf
+    
+    # create a new ClientSettings instance and add the demo server to the URLs to discover
+    settings = pyuaf.client.settings.ClientSettings()
+    settings.discoveryUrls.append(args.demo_url)
+    settings.applicationName = "client"
+    settings.logToStdOutLevel = args.loglevel
+    return settings
+
+
+
+
+def demoScalarAddresses(args, names=["Byte", "Int32", "Double"]):
+    """
+    Get the addresses of some Demo.Dynamic.Scalar variables of the demo server of the parsed
+    arguments (see parseArgs()).
+    """
+    from pyuaf.util import Address, ExpandedNodeId, RelativePathElement, QualifiedName
+    
+    demoNsUri = args.demo_ns_uri
+    
+    address_Demo   = Address(ExpandedNodeId("Demo", demoNsUri, args.demo_server_uri))
+    address_Scalar = Address(address_Demo, [RelativePathElement(QualifiedName("Dynamic", demoNsUri)),
+                                            RelativePathElement(QualifiedName("Scalar", demoNsUri))] )
+    return [ Address(address_Scalar, [RelativePathElement(QualifiedName(name, demoNsUri))] )
+             for name in names ]
+
+
+
+
 def parseArgs():
     
     parser = argparse.ArgumentParser(
@@ -64,6 +64,8 @@
 #include "uaf/util/structuredefinition.h"
 #include "uaf/util/genericstructurevalue.h"
 #include "uaf/util/genericunionvalue.h"
+#include "uaf/util/structurerecords.h"
+#include "uaf/util/structurecodec.h"
 %}
 
 
@@ -79,6 +81,8 @@
 // add some built-in type vectors to the pyuaf.util module
 %template(StringVector) std::vector<std::string>;
 %template(UInt32Vector) std::vector<uint32_t>;
+%template(UInt64Vector) std::vector<uint64_t>;
+%template(DoubleVector) std::vector<double>;
 
 
 // include the initializeUaf() function
@@ -137,6 +141,124 @@
   }
 }
 
+// A uaf::Status only stores the error that raised it, but the pyuaf API still exposes one
+// raisedBy_XXX attribute per error type (e.g. status.raisedBy_WrongTypeError), for instance
+// to let Status.test() raise the error that corresponds with the status code.
+%include <attribute.i>
+%attributeval(uaf::Status, uaf::FindServersError, raisedBy_FindServersError, get_raisedBy_FindServersError)
+%attributeval(uaf::Status, uaf::UnknownServerError, raisedBy_UnknownServerError, get_raisedBy_UnknownServerError)
+%attributeval(uaf::Status, uaf::EmptyUrlError, raisedBy_EmptyUrlError, get_raisedBy_EmptyUrlError)
+%attributeval(uaf::Status, uaf::NoParallelFindServersAllowedError, raisedBy_NoParallelFindServersAllowedError, get_raisedBy_NoParallelFindServersAllowedError)
+%attributeval(uaf::Status, uaf::NoDiscoveryUrlsFoundError, raisedBy_NoDiscoveryUrlsFoundError, get_raisedBy_NoDiscoveryUrlsFoundError)
+%attributeval(uaf::Status, uaf::ServerCertificateRejectedByUserError, raisedBy_ServerCertificateRejectedByUserError, get_raisedBy_ServerCertificateRejectedByUserError)
+%attributeval(uaf::Status, uaf::ServerCertificateSavingError, raisedBy_ServerCertificateSavingError, get_raisedBy_ServerCertificateSavingError)
+%attributeval(uaf::Status, uaf::OpenSSLStoreInitializationError, raisedBy_OpenSSLStoreInitializationError, get_raisedBy_OpenSSLStoreInitializationError)
+%attributeval(uaf::Status, uaf::ClientCertificateLoadingError, raisedBy_ClientCertificateLoadingError, get_raisedBy_ClientCertificateLoadingError)
+%attributeval(uaf::Status, uaf::ServerDidNotProvideCertificateError, raisedBy_ServerDidNotProvideCertificateError, get_raisedBy_ServerDidNotProvideCertificateError)
+%attributeval(uaf::Status, uaf::PathNotExistsError, raisedBy_PathNotExistsError, get_raisedBy_PathNotExistsError)
+%attributeval(uaf::Status, uaf::NoSecuritySettingsGivenError, raisedBy_NoSecuritySettingsGivenError, get_raisedBy_NoSecuritySettingsGivenError)
+%attributeval(uaf::Status, uaf::PathCreationError, raisedBy_PathCreationError, get_raisedBy_PathCreationError)
+%attributeval(uaf::Status, uaf::SecuritySettingsMatchError, raisedBy_SecuritySettingsMatchError, get_raisedBy_SecuritySettingsMatchError)
+%attributeval(uaf::Status, uaf::WrongTypeError, raisedBy_WrongTypeError, get_raisedBy_WrongTypeError)
+%attributeval(uaf::Status, uaf::UnexpectedError, raisedBy_UnexpectedError, get_raisedBy_UnexpectedError)
+%attributeval(uaf::Status, uaf::ServerArrayConversionError, raisedBy_ServerArrayConversionError, get_raisedBy_ServerArrayConversionError)
+%attributeval(uaf::Status, uaf::NamespaceArrayConversionError, raisedBy_NamespaceArrayConversionError, get_raisedBy_NamespaceArrayConversionError)
+%attributeval(uaf::Status, uaf::BadNamespaceArrayError, raisedBy_BadNamespaceArrayError, get_raisedBy_BadNamespaceArrayError)
+%attributeval(uaf::Status, uaf::BadServerArrayError, raisedBy_BadServerArrayError, get_raisedBy_BadServerArrayError)
+%attributeval(uaf::Status, uaf::UnknownServerIndexError, raisedBy_UnknownServerIndexError, get_raisedBy_UnknownServerIndexError)
+%attributeval(uaf::Status, uaf::InvalidAddressError, raisedBy_InvalidAddressError, get_raisedBy_InvalidAddressError)
+%attributeval(uaf::Status, uaf::UnknownNamespaceUriError, raisedBy_UnknownNamespaceUriError, get_raisedBy_UnknownNamespaceUriError)
+%attributeval(uaf::Status, uaf::NoNamespaceIndexOrUriGivenError, raisedBy_NoNamespaceIndexOrUriGivenError, get_raisedBy_NoNamespaceIndexOrUriGivenError)
+%attributeval(uaf::Status, uaf::UnknownNamespaceIndexError, raisedBy_UnknownNamespaceIndexError, get_raisedBy_UnknownNamespaceIndexError)
+%attributeval(uaf::Status, uaf::EmptyServerUriAndUnknownNamespaceIndexError, raisedBy_EmptyServerUriAndUnknownNamespaceIndexError, get_raisedBy_EmptyServerUriAndUnknownNamespaceIndexError)
+%attributeval(uaf::Status, uaf::ExpandedNodeIdAddressExpectedError, raisedBy_ExpandedNodeIdAddressExpectedError, get_raisedBy_ExpandedNodeIdAddressExpectedError)
+%attributeval(uaf::Status, uaf::EmptyServerUriError, raisedBy_EmptyServerUriError, get_raisedBy_EmptyServerUriError)
+%attributeval(uaf::Status, uaf::UnsupportedError, raisedBy_UnsupportedError, get_raisedBy_UnsupportedError)
+%attributeval(uaf::Status, uaf::UnsupportedNodeIdIdentifierTypeError, raisedBy_UnsupportedNodeIdIdentifierTypeError, get_raisedBy_UnsupportedNodeIdIdentifierTypeError)
+%attributeval(uaf::Status, uaf::SyncInvocationNotSupportedError, raisedBy_SyncInvocationNotSupportedError, get_raisedBy_SyncInvocationNotSupportedError)
+%attributeval(uaf::Status, uaf::AsyncInvocationNotSupportedError, raisedBy_AsyncInvocationNotSupportedError, get_raisedBy_AsyncInvocationNotSupportedError)
+%attributeval(uaf::Status, uaf::NoStatusesGivenError, raisedBy_NoStatusesGivenError, get_raisedBy_NoStatusesGivenError)
+%attributeval(uaf::Status, uaf::BadStatusesPresentError, raisedBy_BadStatusesPresentError, get_raisedBy_BadStatusesPresentError)
+%attributeval(uaf::Status, uaf::NotAllTargetsCouldBeResolvedError, raisedBy_NotAllTargetsCouldBeResolvedError, get_raisedBy_NotAllTargetsCouldBeResolvedError)
+%attributeval(uaf::Status, uaf::InvalidServerUriError, raisedBy_InvalidServerUriError, get_raisedBy_InvalidServerUriError)
+%attributeval(uaf::Status, uaf::SubscriptionNotCreatedError, raisedBy_SubscriptionNotCreatedError, get_raisedBy_SubscriptionNotCreatedError)
+%attributeval(uaf::Status, uaf::NoTargetsGivenError, raisedBy_NoTargetsGivenError, get_raisedBy_NoTargetsGivenError)
+%attributeval(uaf::Status, uaf::DataDontMatchAddressesError, raisedBy_DataDontMatchAddressesError, get_raisedBy_DataDontMatchAddressesError)
+%attributeval(uaf::Status, uaf::ItemNotFoundForTheGivenHandleError, raisedBy_ItemNotFoundForTheGivenHandleError, get_raisedBy_ItemNotFoundForTheGivenHandleError)
+%attributeval(uaf::Status, uaf::TargetRankOutOfBoundsError, raisedBy_TargetRankOutOfBoundsError, get_raisedBy_TargetRankOutOfBoundsError)
+%attributeval(uaf::Status, uaf::NoItemFoundForTheGivenRequestHandleError, raisedBy_NoItemFoundForTheGivenRequestHandleError, get_raisedBy_NoItemFoundForTheGivenRequestHandleError)
+%attributeval(uaf::Status, uaf::ContinuationPointsDontMatchAddressesError, raisedBy_ContinuationPointsDontMatchAddressesError, get_raisedBy_ContinuationPointsDontMatchAddressesError)
+%attributeval(uaf::Status, uaf::UnknownNamespaceIndexAndServerIndexError, raisedBy_UnknownNamespaceIndexAndServerIndexError, get_raisedBy_UnknownNamespaceIndexAndServerIndexError)
+%attributeval(uaf::Status, uaf::AsyncMultiMethodCallNotSupportedError, raisedBy_AsyncMultiMethodCallNotSupportedError, get_raisedBy_AsyncMultiMethodCallNotSupportedError)
+%attributeval(uaf::Status, uaf::EmptyAddressError, raisedBy_EmptyAddressError, get_raisedBy_EmptyAddressError)
+%attributeval(uaf::Status, uaf::MultipleTranslationResultsError, raisedBy_MultipleTranslationResultsError, get_raisedBy_MultipleTranslationResultsError)
+%attributeval(uaf::Status, uaf::UnknownClientSubscriptionHandleError, raisedBy_UnknownClientSubscriptionHandleError, get_raisedBy_UnknownClientSubscriptionHandleError)
+%attributeval(uaf::Status, uaf::UnknownClientHandleError, raisedBy_UnknownClientHandleError, get_raisedBy_UnknownClientHandleError)
+%attributeval(uaf::Status, uaf::UnknownClientConnectionIdError, raisedBy_UnknownClientConnectionIdError, get_raisedBy_UnknownClientConnectionIdError)
+%attributeval(uaf::Status, uaf::AsyncConnectionFailedError, raisedBy_AsyncConnectionFailedError, get_raisedBy_AsyncConnectionFailedError)
+%attributeval(uaf::Status, uaf::ConnectionFailedError, raisedBy_ConnectionFailedError, get_raisedBy_ConnectionFailedError)
+%attributeval(uaf::Status, uaf::EmptyUserCertificateError, raisedBy_EmptyUserCertificateError, get_raisedBy_EmptyUserCertificateError)
+%attributeval(uaf::Status, uaf::InvalidPrivateKeyError, raisedBy_InvalidPrivateKeyError, get_raisedBy_InvalidPrivateKeyError)
+%attributeval(uaf::Status, uaf::SessionSecuritySettingsDontMatchEndpointError, raisedBy_SessionSecuritySettingsDontMatchEndpointError, get_raisedBy_SessionSecuritySettingsDontMatchEndpointError)
+%attributeval(uaf::Status, uaf::CouldNotManuallyUnsubscribeError, raisedBy_CouldNotManuallyUnsubscribeError, get_raisedBy_CouldNotManuallyUnsubscribeError)
+%attributeval(uaf::Status, uaf::CouldNotManuallySubscribeError, raisedBy_CouldNotManuallySubscribeError, get_raisedBy_CouldNotManuallySubscribeError)
+%attributeval(uaf::Status, uaf::SessionNotConnectedError, raisedBy_SessionNotConnectedError, get_raisedBy_SessionNotConnectedError)
+%attributeval(uaf::Status, uaf::SubscriptionHasBeenDeletedError, raisedBy_SubscriptionHasBeenDeletedError, get_raisedBy_SubscriptionHasBeenDeletedError)
+%attributeval(uaf::Status, uaf::NoDiscoveryUrlsExposedByServerError, raisedBy_NoDiscoveryUrlsExposedByServerError, get_raisedBy_NoDiscoveryUrlsExposedByServerError)
+%attributeval(uaf::Status, uaf::GetEndpointsError, raisedBy_GetEndpointsError, get_raisedBy_GetEndpointsError)
+%attributeval(uaf::Status, uaf::NoEndpointsProvidedByServerError, raisedBy_NoEndpointsProvidedByServerError, get_raisedBy_NoEndpointsProvidedByServerError)
+%attributeval(uaf::Status, uaf::DisconnectionFailedError, raisedBy_DisconnectionFailedError, get_raisedBy_DisconnectionFailedError)
+%attributeval(uaf::Status, uaf::NoConnectedSessionToUpdateArraysError, raisedBy_NoConnectedSessionToUpdateArraysError, get_raisedBy_NoConnectedSessionToUpdateArraysError)
+%attributeval(uaf::Status, uaf::BadDataReceivedError, raisedBy_BadDataReceivedError, get_raisedBy_BadDataReceivedError)
+%attributeval(uaf::Status, uaf::CouldNotReadArraysError, raisedBy_CouldNotReadArraysError, get_raisedBy_CouldNotReadArraysError)
+%attributeval(uaf::Status, uaf::CreateMonitoredItemsError, raisedBy_CreateMonitoredItemsError, get_raisedBy_CreateMonitoredItemsError)
+%attributeval(uaf::Status, uaf::CreateMonitoredItemsInvocationError, raisedBy_CreateMonitoredItemsInvocationError, get_raisedBy_CreateMonitoredItemsInvocationError)
+%attributeval(uaf::Status, uaf::BeginCreateMonitoredItemsInvocationError, raisedBy_BeginCreateMonitoredItemsInvocationError, get_raisedBy_BeginCreateMonitoredItemsInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotCreateMonitoredItemsError, raisedBy_ServerCouldNotCreateMonitoredItemsError, get_raisedBy_ServerCouldNotCreateMonitoredItemsError)
+%attributeval(uaf::Status, uaf::ServerCouldNotBrowseNextError, raisedBy_ServerCouldNotBrowseNextError, get_raisedBy_ServerCouldNotBrowseNextError)
+%attributeval(uaf::Status, uaf::BrowseNextInvocationError, raisedBy_BrowseNextInvocationError, get_raisedBy_BrowseNextInvocationError)
+%attributeval(uaf::Status, uaf::ReadInvocationError, raisedBy_ReadInvocationError, get_raisedBy_ReadInvocationError)
+%attributeval(uaf::Status, uaf::BeginReadInvocationError, raisedBy_BeginReadInvocationError, get_raisedBy_BeginReadInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotReadError, raisedBy_ServerCouldNotReadError, get_raisedBy_ServerCouldNotReadError)
+%attributeval(uaf::Status, uaf::TranslateBrowsePathsToNodeIdsInvocationError, raisedBy_TranslateBrowsePathsToNodeIdsInvocationError, get_raisedBy_TranslateBrowsePathsToNodeIdsInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotTranslateBrowsePathsToNodeIdsError, raisedBy_ServerCouldNotTranslateBrowsePathsToNodeIdsError, get_raisedBy_ServerCouldNotTranslateBrowsePathsToNodeIdsError)
+%attributeval(uaf::Status, uaf::HistoryReadInvocationError, raisedBy_HistoryReadInvocationError, get_raisedBy_HistoryReadInvocationError)
+%attributeval(uaf::Status, uaf::HistoryReadRawModifiedInvocationError, raisedBy_HistoryReadRawModifiedInvocationError, get_raisedBy_HistoryReadRawModifiedInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotHistoryReadError, raisedBy_ServerCouldNotHistoryReadError, get_raisedBy_ServerCouldNotHistoryReadError)
+%attributeval(uaf::Status, uaf::MethodCallInvocationError, raisedBy_MethodCallInvocationError, get_raisedBy_MethodCallInvocationError)
+%attributeval(uaf::Status, uaf::AsyncMethodCallInvocationError, raisedBy_AsyncMethodCallInvocationError, get_raisedBy_AsyncMethodCallInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotCallMethodError, raisedBy_ServerCouldNotCallMethodError, get_raisedBy_ServerCouldNotCallMethodError)
+%attributeval(uaf::Status, uaf::ServerCouldNotBrowseError, raisedBy_ServerCouldNotBrowseError, get_raisedBy_ServerCouldNotBrowseError)
+%attributeval(uaf::Status, uaf::BrowseInvocationError, raisedBy_BrowseInvocationError, get_raisedBy_BrowseInvocationError)
+%attributeval(uaf::Status, uaf::WriteInvocationError, raisedBy_WriteInvocationError, get_raisedBy_WriteInvocationError)
+%attributeval(uaf::Status, uaf::AsyncWriteInvocationError, raisedBy_AsyncWriteInvocationError, get_raisedBy_AsyncWriteInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotWriteError, raisedBy_ServerCouldNotWriteError, get_raisedBy_ServerCouldNotWriteError)
+%attributeval(uaf::Status, uaf::CallCompleteError, raisedBy_CallCompleteError, get_raisedBy_CallCompleteError)
+%attributeval(uaf::Status, uaf::InputArgumentError, raisedBy_InputArgumentError, get_raisedBy_InputArgumentError)
+%attributeval(uaf::Status, uaf::ReadCompleteError, raisedBy_ReadCompleteError, get_raisedBy_ReadCompleteError)
+%attributeval(uaf::Status, uaf::WriteCompleteError, raisedBy_WriteCompleteError, get_raisedBy_WriteCompleteError)
+%attributeval(uaf::Status, uaf::SetPublishingModeInvocationError, raisedBy_SetPublishingModeInvocationError, get_raisedBy_SetPublishingModeInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotSetMonitoringModeError, raisedBy_ServerCouldNotSetMonitoringModeError, get_raisedBy_ServerCouldNotSetMonitoringModeError)
+%attributeval(uaf::Status, uaf::CreateSubscriptionError, raisedBy_CreateSubscriptionError, get_raisedBy_CreateSubscriptionError)
+%attributeval(uaf::Status, uaf::DeleteSubscriptionError, raisedBy_DeleteSubscriptionError, get_raisedBy_DeleteSubscriptionError)
+%attributeval(uaf::Status, uaf::SetMonitoringModeInvocationError, raisedBy_SetMonitoringModeInvocationError, get_raisedBy_SetMonitoringModeInvocationError)
+%attributeval(uaf::Status, uaf::DefinitionNotFoundError, raisedBy_DefinitionNotFoundError, get_raisedBy_DefinitionNotFoundError)
+%attributeval(uaf::Status, uaf::DeleteMonitoredItemsInvocationError, raisedBy_DeleteMonitoredItemsInvocationError, get_raisedBy_DeleteMonitoredItemsInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotDeleteMonitoredItemError, raisedBy_ServerCouldNotDeleteMonitoredItemError, get_raisedBy_ServerCouldNotDeleteMonitoredItemError)
+%attributeval(uaf::Status, uaf::ModifyMonitoredItemsInvocationError, raisedBy_ModifyMonitoredItemsInvocationError, get_raisedBy_ModifyMonitoredItemsInvocationError)
+%attributeval(uaf::Status, uaf::ServerCouldNotModifyMonitoredItemError, raisedBy_ServerCouldNotModifyMonitoredItemError, get_raisedBy_ServerCouldNotModifyMonitoredItemError)
+%attributeval(uaf::Status, uaf::RepublishInvocationError, raisedBy_RepublishInvocationError, get_raisedBy_RepublishInvocationError)
+%attributeval(uaf::Status, uaf::RegisterNodesInvocationError, raisedBy_RegisterNodesInvocationError, get_raisedBy_RegisterNodesInvocationError)
+%attributeval(uaf::Status, uaf::UnregisterNodesInvocationError, raisedBy_UnregisterNodesInvocationError, get_raisedBy_UnregisterNodesInvocationError)
+%attributeval(uaf::Status, uaf::UnknownRegisteredNodesHandleError, raisedBy_UnknownRegisteredNodesHandleError, get_raisedBy_UnknownRegisteredNodesHandleError)
+%attributeval(uaf::Status, uaf::ConfigurationError, raisedBy_ConfigurationError, get_raisedBy_ConfigurationError)
+%attributeval(uaf::Status, uaf::CouldNotCreateCertificateTrustListLocationError, raisedBy_CouldNotCreateCertificateTrustListLocationError, get_raisedBy_CouldNotCreateCertificateTrustListLocationError)
+%attributeval(uaf::Status, uaf::CouldNotCreateCertificateRevocationListLocationError, raisedBy_CouldNotCreateCertificateRevocationListLocationError, get_raisedBy_CouldNotCreateCertificateRevocationListLocationError)
+%attributeval(uaf::Status, uaf::CouldNotCreateIssuersCertificateLocationError, raisedBy_CouldNotCreateIssuersCertificateLocationError, get_raisedBy_CouldNotCreateIssuersCertificateLocationError)
+%attributeval(uaf::Status, uaf::CouldNotCreateIssuersRevocationListLocationError, raisedBy_CouldNotCreateIssuersRevocationListLocationError, get_raisedBy_CouldNotCreateIssuersRevocationListLocationError)
+%attributeval(uaf::Status, uaf::CouldNotCreateClientPrivateKeyLocationError, raisedBy_CouldNotCreateClientPrivateKeyLocationError, get_raisedBy_CouldNotCreateClientPrivateKeyLocationError)
+%attributeval(uaf::Status, uaf::CouldNotCreateClientCertificateLocationError, raisedBy_CouldNotCreateClientCertificateLocationError, get_raisedBy_CouldNotCreateClientCertificateLocationError)
+
 // now include all classes in a generic way
 UAF_WRAP_CLASS("uaf/util/localizedtext.h"          , uaf , LocalizedText           , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, LocalizedTextVector)
 UAF_WRAP_CLASS("uaf/util/applicationdescription.h" , uaf , ApplicationDescription  , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, ApplicationDescriptionVector)
@@ -227,4 +349,6 @@ class VectorIterator(object):
 UAF_WRAP_CLASS("uaf/util/datavalue.h"              , uaf , DataValue               , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, DataValueVector)
 UAF_WRAP_CLASS("uaf/util/genericstructurevalue.h"  , uaf , GenericStructureValue   , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, GenericStructureVector)
 UAF_WRAP_CLASS("uaf/util/genericunionvalue.h"  	   , uaf , GenericUnionValue   	   , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, GenericUnionVector)
+UAF_WRAP_CLASS("uaf/util/structurerecords.h"       , uaf , StructureRecords        , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/util/structurecodec.h"         , uaf , StructureCodec          , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, VECTOR_NO)
 
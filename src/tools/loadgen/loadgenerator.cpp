@@ -0,0 +1,417 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/loadgen/loadgenerator.h"
+
+// STD
+#include <cstdio>
+#include <cstdlib>
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+// UAF
+#include "uaf/util/constants.h"
+#include "uaf/util/datetime.h"
+
+
+namespace uaf
+{
+
+    namespace loadgen
+    {
+
+        // the time range of the history reads, ending now
+        static const double HISTORY_RANGE_SEC = 60.0;
+
+        // the max. number of values per node of the history reads
+        static const uint32_t HISTORY_VALUES_PER_NODE = 100;
+
+
+        // Get a monotonic time in seconds
+        // =========================================================================================
+        static double monotonicSec()
+        {
+#if defined(_WIN32)
+            LARGE_INTEGER frequency, counter;
+            QueryPerformanceFrequency(&frequency);
+            QueryPerformanceCounter(&counter);
+            return double(counter.QuadPart) / double(frequency.QuadPart);
+#else
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return double(ts.tv_sec) + double(ts.tv_nsec) * 1e-9;
+#endif
+        }
+
+
+        // Get the resident memory of the process
+        // =========================================================================================
+        static uint64_t residentBytes()
+        {
+#if defined(_WIN32)
+            PROCESS_MEMORY_COUNTERS counters;
+            if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+                return uint64_t(counters.WorkingSetSize);
+            return 0;
+#else
+            // the second field of /proc/self/statm is the number of resident pages
+            unsigned long size = 0, resident = 0;
+            FILE* file = fopen("/proc/self/statm", "r");
+            if (file == NULL)
+                return 0;
+            if (fscanf(file, "%lu %lu", &size, &resident) != 2)
+                resident = 0;
+            fclose(file);
+            return uint64_t(resident) * uint64_t(sysconf(_SC_PAGESIZE));
+#endif
+        }
+
+
+        // Get the NodeId of an identifier given on the command line
+        // =========================================================================================
+        static NodeId toNodeId(const std::string& id, const std::string& namespaceUri)
+        {
+            if (!id.empty() && id.find_first_not_of("0123456789") == std::string::npos)
+                return NodeId(uint32_t(strtoul(id.c_str(), NULL, 10)), namespaceUri);
+            else
+                return NodeId(id, namespaceUri);
+        }
+
+
+        // Constructor
+        // =========================================================================================
+        LoadGenerator::LoadGenerator(const LoadGenSettings& settings)
+        : settings_(settings),
+          server_(0),
+          client_(0),
+          stopped_(0)
+        {
+            ClientSettings clientSettings;
+            clientSettings.applicationName = "uaf_loadgen";
+            clientSettings.discoveryUrls   = settings_.discoveryUrls;
+
+            client_ = new Client(clientSettings);
+
+            if (settings_.discoveryUrls.empty())
+            {
+                LoopbackServerSettings serverSettings;
+                serverSettings.numberOfVariables = settings_.loopbackVariables;
+                serverSettings.latencySec        = settings_.loopbackLatencySec;
+                server_ = new LoopbackServer(serverSettings);
+                client_->setSessionTransportFactory(server_);
+
+                ServerTargets targets;
+                targets.serverUri = serverSettings.serverUri;
+                for (uint32_t i = 0; i < serverSettings.numberOfVariables; i++)
+                    targets.variables.push_back(Address(server_->variableNodeId(i),
+                                                        targets.serverUri));
+                targets.object     = Address(NodeId(OpcUaId_ObjectsFolder, 0), targets.serverUri);
+                targets.method     = Address(server_->echoMethodId(), targets.serverUri);
+                targets.browseNode = targets.object;
+                targets_.push_back(targets);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < settings_.serverUris.size(); i++)
+                {
+                    ServerTargets targets;
+                    targets.serverUri = settings_.serverUris[i];
+                    for (std::size_t j = 0; j < settings_.variableIds.size(); j++)
+                        targets.variables.push_back(Address(
+                                toNodeId(settings_.variableIds[j], settings_.namespaceUri),
+                                targets.serverUri));
+                    targets.object = Address(toNodeId(settings_.objectId, settings_.namespaceUri),
+                                             targets.serverUri);
+                    targets.method = Address(toNodeId(settings_.methodId, settings_.namespaceUri),
+                                             targets.serverUri);
+                    if (settings_.browseId.empty())
+                        targets.browseNode = Address(NodeId(OpcUaId_ObjectsFolder, 0),
+                                                     targets.serverUri);
+                    else
+                        targets.browseNode = Address(
+                                toNodeId(settings_.browseId, settings_.namespaceUri),
+                                targets.serverUri);
+                    targets_.push_back(targets);
+                }
+            }
+
+            // interleave the kinds of requests according to their weights ("smooth weighted
+            // round robin"), so that a mix of 70 reads and 10 writes doesn't send the 10 writes
+            // in a burst
+            uint32_t total = 0;
+            int64_t current[NO_OF_OPERATIONS];
+            for (std::size_t i = 0; i < NO_OF_OPERATIONS; i++)
+            {
+                total += settings_.weights[i];
+                current[i] = 0;
+            }
+
+            for (uint32_t n = 0; n < total; n++)
+            {
+                std::size_t selected = 0;
+                for (std::size_t i = 0; i < NO_OF_OPERATIONS; i++)
+                {
+                    current[i] += settings_.weights[i];
+                    if (current[i] > current[selected])
+                        selected = i;
+                }
+                current[selected] -= total;
+                schedule_.push_back(Operation(selected));
+            }
+        }
+
+
+        // Destructor
+        // =========================================================================================
+        LoadGenerator::~LoadGenerator()
+        {
+            stop();
+
+            // the client must be deleted before the server, since its sessions use the server
+            delete client_;
+            client_ = 0;
+            delete server_;
+            server_ = 0;
+        }
+
+
+        // Connect the sessions and create the monitored items
+        // =========================================================================================
+        Status LoadGenerator::setUp()
+        {
+            Status ret = statuscodes::Good;
+
+            // unique sessions, so that each of them is really created
+            SessionSettings sessionSettings;
+            sessionSettings.unique = true;
+
+            for (std::size_t i = 0; i < targets_.size() && ret.isGood(); i++)
+            {
+                for (uint32_t j = 0; j < settings_.sessionsPerServer && ret.isGood(); j++)
+                {
+                    Connection connection;
+                    connection.server = i;
+                    ret = client_->manuallyConnect(targets_[i].serverUri,
+                                                   &sessionSettings,
+                                                   connection.clientConnectionId);
+                    if (ret.isGood())
+                        connections_.push_back(connection);
+                }
+            }
+
+            if (ret.isGood() && settings_.monitoredItems > 0)
+                ret = createMonitoredItems();
+
+            return ret;
+        }
+
+
+        // Create the monitored items
+        // =========================================================================================
+        Status LoadGenerator::createMonitoredItems()
+        {
+            Status ret = statuscodes::Good;
+
+            SubscriptionSettings subscriptionSettings;
+            subscriptionSettings.publishingIntervalSec = settings_.publishingIntervalSec;
+
+            // the monitored items of a server are created on its first session
+            for (std::size_t i = 0; i < connections_.size() && ret.isGood(); i++)
+            {
+                if (i > 0 && connections_[i].server == connections_[i - 1].server)
+                    continue;
+
+                const ServerTargets& targets = targets_[connections_[i].server];
+
+                CreateMonitoredDataRequest request(settings_.monitoredItems,
+                                                   connections_[i].clientConnectionId,
+                                                   NULL,
+                                                   NULL,
+                                                   NULL,
+                                                   constants::CLIENTHANDLE_NOT_ASSIGNED,
+                                                   &subscriptionSettings);
+                for (uint32_t j = 0; j < settings_.monitoredItems; j++)
+                {
+                    request.targets[j].address = targets.variables[j % targets.variables.size()];
+                    request.targets[j].samplingIntervalSec = settings_.samplingIntervalSec;
+                }
+
+                CreateMonitoredDataResult result;
+                ret = client_->processRequest(request, result);
+            }
+
+            return ret;
+        }
+
+
+        // Start the workers
+        // =========================================================================================
+        void LoadGenerator::start(uint32_t noOfThreads)
+        {
+            stop();
+
+            // no worker is running, so the flag can be reset without synchronization
+            stopped_ = 0;
+
+            for (uint32_t i = 0; i < noOfThreads; i++)
+            {
+                Worker* worker = new Worker(this, i);
+                workers_.push_back(worker);
+                worker->startWorking();
+            }
+        }
+
+
+        // Stop the workers
+        // =========================================================================================
+        void LoadGenerator::stop()
+        {
+            atomicIncrement(&stopped_);
+
+            for (std::size_t i = 0; i < workers_.size(); i++)
+            {
+                workers_[i]->waitUntilFinished();
+                delete workers_[i];
+            }
+            workers_.clear();
+        }
+
+
+        // Take a sample
+        // =========================================================================================
+        LoadSample LoadGenerator::sample()
+        {
+            LoadSample ret;
+            ret.timeSec       = monotonicSec();
+            ret.metrics       = client_->metrics();
+            ret.residentBytes = residentBytes();
+            ret.databaseBytes = client_->databaseFootprint().totalBytes();
+            return ret;
+        }
+
+
+        // The loop of the workers
+        // =========================================================================================
+        void LoadGenerator::work(uint32_t workerIndex)
+        {
+            if (connections_.empty() || schedule_.empty())
+                return;
+
+            // the workers start at different positions, so that they don't send the same kind of
+            // request at the same time
+            for (uint64_t sequence = workerIndex; atomicGet(&stopped_) == 0; sequence++)
+            {
+                invoke(schedule_[sequence % schedule_.size()],
+                       connections_[sequence % connections_.size()],
+                       sequence);
+            }
+        }
+
+
+        // Get the variables of the next request
+        // =========================================================================================
+        void LoadGenerator::variablesOf(
+                const ServerTargets&    targets,
+                uint64_t                sequence,
+                std::vector<Address>&   addresses) const
+        {
+            addresses.clear();
+            if (targets.variables.empty())
+                return;
+
+            addresses.reserve(settings_.nodesPerRequest);
+            std::size_t first = std::size_t(sequence * settings_.nodesPerRequest);
+            for (uint32_t i = 0; i < settings_.nodesPerRequest; i++)
+                addresses.push_back(targets.variables[(first + i) % targets.variables.size()]);
+        }
+
+
+        // Send a single request
+        // =========================================================================================
+        void LoadGenerator::invoke(
+                Operation           operation,
+                const Connection&   connection,
+                uint64_t            sequence)
+        {
+            // the results are not checked here: the failures are counted by the metrics
+            const ServerTargets& targets = targets_[connection.server];
+            std::vector<Address> addresses;
+
+            switch (operation)
+            {
+                case Read:
+                {
+                    variablesOf(targets, sequence, addresses);
+                    ReadResult result;
+                    client_->read(addresses, attributeids::Value, connection.clientConnectionId,
+                                  NULL, NULL, NULL, result);
+                    break;
+                }
+                case Write:
+                {
+                    variablesOf(targets, sequence, addresses);
+                    std::vector<Variant> data(addresses.size());
+                    for (std::size_t i = 0; i < data.size(); i++)
+                        data[i].setDouble(double(sequence + i));
+                    WriteResult result;
+                    client_->write(addresses, data, attributeids::Value,
+                                   connection.clientConnectionId, NULL, NULL, NULL, result);
+                    break;
+                }
+                case Call:
+                {
+                    std::vector<Variant> inputArguments(1);
+                    inputArguments[0].setDouble(double(sequence));
+                    MethodCallResult result;
+                    client_->call(targets.object, targets.method, inputArguments,
+                                  connection.clientConnectionId, NULL, NULL, NULL, result);
+                    break;
+                }
+                case Browse:
+                {
+                    addresses.push_back(targets.browseNode);
+                    BrowseResult result;
+                    client_->browse(addresses, 0, connection.clientConnectionId,
+                                    NULL, NULL, NULL, result);
+                    break;
+                }
+                case History:
+                {
+                    variablesOf(targets, sequence, addresses);
+                    DateTime endTime = DateTime::now();
+                    DateTime startTime(endTime.ctime() - HISTORY_RANGE_SEC);
+                    HistoryReadRawModifiedResult result;
+                    client_->historyReadRaw(addresses, startTime, endTime,
+                                            HISTORY_VALUES_PER_NODE, 0,
+                                            std::vector<ByteString>(),
+                                            connection.clientConnectionId,
+                                            NULL, NULL, NULL, result);
+                    break;
+                }
+            }
+        }
+
+    }
+
+}
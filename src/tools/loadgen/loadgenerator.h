@@ -0,0 +1,243 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_LOADGENERATOR_H_
+#define UAF_LOADGENERATOR_H_
+
+
+// STD
+#include <string>
+#include <vector>
+#include <stdint.h>
+// SDK
+#include "uabase/uathread.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/status.h"
+#include "uaf/util/address.h"
+#include "uaf/util/atomics.h"
+#include "uaf/client/client.h"
+#include "uaf/client/metrics/metrics.h"
+#include "uaf/client/transport/loopbackserver.h"
+#include "tools/loadgen/loadgensettings.h"
+
+
+
+namespace uaf
+{
+
+    namespace loadgen
+    {
+
+        /**
+         * A sample of the instrumentation of the client, taken by LoadGenerator::sample().
+         */
+        struct LoadSample
+        {
+            LoadSample() : timeSec(0.0), residentBytes(0), databaseBytes(0) {}
+
+            /** The (monotonic) time of the sample. */
+            double timeSec;
+            /** The metrics of the client. */
+            uaf::Metrics metrics;
+            /** The resident memory of the process (0 if unknown on this platform). */
+            uint64_t residentBytes;
+            /** The approximate memory of the client database. */
+            uint64_t databaseBytes;
+        };
+
+
+        /**
+         * A LoadGenerator sends a mix of requests to one or more servers, from a configurable
+         * number of threads, through a single uaf::Client.
+         *
+         * The load generator doesn't measure anything itself: the latencies, the numbers of
+         * requests and the notification rates are taken from the metrics of the client.
+         */
+        class LoadGenerator
+        {
+        public:
+
+
+            /**
+             * Construct a load generator (and the loopback server, if no discovery URLs are
+             * given).
+             *
+             * @param settings  The settings of the run.
+             */
+            LoadGenerator(const uaf::loadgen::LoadGenSettings& settings);
+
+
+            /**
+             * Stop the threads, and destruct the client and the loopback server.
+             */
+            ~LoadGenerator();
+
+
+            /**
+             * Connect the sessions and create the monitored items.
+             *
+             * @return  Good if all sessions and monitored items were created.
+             */
+            uaf::Status setUp();
+
+
+            /**
+             * Start sending requests from the given number of threads.
+             *
+             * @param noOfThreads   The number of threads.
+             */
+            void start(uint32_t noOfThreads);
+
+
+            /**
+             * Stop sending requests, and wait until all threads have finished their request.
+             */
+            void stop();
+
+
+            /**
+             * Take a sample of the instrumentation of the client.
+             *
+             * @return  The sample.
+             */
+            uaf::loadgen::LoadSample sample();
+
+
+        private:
+
+
+            DISALLOW_COPY_AND_ASSIGN(LoadGenerator);
+
+
+            // the workers may call work()
+            class Worker;
+            friend class Worker;
+
+
+            /**
+             * The nodes of a server that are used by the requests.
+             */
+            struct ServerTargets
+            {
+                /** The URI of the server. */
+                std::string serverUri;
+                /** The variables to read, write, monitor and history read. */
+                std::vector<uaf::Address> variables;
+                /** The object of the method to call. */
+                uaf::Address object;
+                /** The method to call. */
+                uaf::Address method;
+                /** The node to browse. */
+                uaf::Address browseNode;
+            };
+
+
+            /**
+             * A session to one of the servers.
+             */
+            struct Connection
+            {
+                /** The index of the server in targets_. */
+                std::size_t server;
+                /** The id of the session. */
+                uaf::ClientConnectionId clientConnectionId;
+            };
+
+
+            /**
+             * A thread that sends requests until the load generator is stopped.
+             */
+            class Worker : private UaThread
+            {
+            public:
+                Worker(uaf::loadgen::LoadGenerator* generator, uint32_t index)
+                : generator_(generator), index_(index) {}
+                void startWorking() { start(); }
+                void waitUntilFinished() { wait(); }
+            private:
+                DISALLOW_COPY_AND_ASSIGN(Worker);
+                void run() { generator_->work(index_); }
+                uaf::loadgen::LoadGenerator* generator_;
+                uint32_t index_;
+            };
+
+
+            /**
+             * The loop of the worker threads.
+             *
+             * @param workerIndex   The index of the worker.
+             */
+            void work(uint32_t workerIndex);
+
+
+            /**
+             * Send a single request.
+             *
+             * @param operation     The kind of request.
+             * @param connection    The session to send it on.
+             * @param sequence      The sequence number of the request within the worker (to
+             *                      rotate over the variables).
+             */
+            void invoke(
+                    uaf::loadgen::Operation     operation,
+                    const Connection&           connection,
+                    uint64_t                    sequence);
+
+
+            /**
+             * Get the variables of the next request.
+             */
+            void variablesOf(
+                    const ServerTargets&        targets,
+                    uint64_t                    sequence,
+                    std::vector<uaf::Address>&  addresses) const;
+
+
+            /**
+             * Create the monitored items of all servers.
+             */
+            uaf::Status createMonitoredItems();
+
+
+            // the settings of the run
+            uaf::loadgen::LoadGenSettings settings_;
+            // the loopback server (or 0 if real servers are loaded)
+            uaf::LoopbackServer* server_;
+            // the client
+            uaf::Client* client_;
+            // the nodes of each server
+            std::vector<ServerTargets> targets_;
+            // the sessions, over which the requests are spread
+            std::vector<Connection> connections_;
+            // the order of the kinds of requests, interleaved according to their weights
+            std::vector<uaf::loadgen::Operation> schedule_;
+            // the running workers
+            std::vector<Worker*> workers_;
+            // non-zero when the workers must stop
+            uaf::AtomicCount stopped_;
+        };
+
+    }
+
+}
+
+
+#endif /* UAF_LOADGENERATOR_H_ */
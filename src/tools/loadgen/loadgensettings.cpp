@@ -0,0 +1,342 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/loadgen/loadgensettings.h"
+
+// STD
+#include <cstdlib>
+#include <sstream>
+
+
+namespace uaf
+{
+
+    namespace loadgen
+    {
+
+        // the names of the operations, indexed by Operation
+        static const char* OPERATION_NAMES[NO_OF_OPERATIONS] =
+        {
+            "read", "write", "call", "browse", "history"
+        };
+
+
+        // Split a comma-separated list
+        // =========================================================================================
+        static std::vector<std::string> splitList(const std::string& list)
+        {
+            std::vector<std::string> items;
+            std::stringstream ss(list);
+            std::string item;
+            while (std::getline(ss, item, ','))
+            {
+                if (!item.empty())
+                    items.push_back(item);
+            }
+            return items;
+        }
+
+
+        // Convert a string to an unsigned number
+        // =========================================================================================
+        static bool toUInt32(const std::string& s, uint32_t& value)
+        {
+            if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos)
+                return false;
+            value = uint32_t(strtoul(s.c_str(), NULL, 10));
+            return true;
+        }
+
+
+        // Convert a string to a non-negative floating point number
+        // =========================================================================================
+        static bool toDouble(const std::string& s, double& value)
+        {
+            char* end = NULL;
+            value = strtod(s.c_str(), &end);
+            return !s.empty() && *end == '\0' && value >= 0.0;
+        }
+
+
+        // Parse a mix like "read=70,write=10"
+        // =========================================================================================
+        static bool parseMix(
+                const std::string&  mix,
+                uint32_t            weights[NO_OF_OPERATIONS],
+                std::string&        error)
+        {
+            for (std::size_t i = 0; i < NO_OF_OPERATIONS; i++)
+                weights[i] = 0;
+
+            uint32_t total = 0;
+            std::vector<std::string> items = splitList(mix);
+            for (std::size_t i = 0; i < items.size(); i++)
+            {
+                std::size_t equals = items[i].find('=');
+                std::string name = items[i].substr(0, equals);
+                uint32_t weight = 0;
+
+                std::size_t operation = 0;
+                while (operation < NO_OF_OPERATIONS && name != OPERATION_NAMES[operation])
+                    operation++;
+
+                if (   equals == std::string::npos
+                    || operation == NO_OF_OPERATIONS
+                    || !toUInt32(items[i].substr(equals + 1), weight))
+                {
+                    error = "Invalid item '" + items[i] + "' of the mix (expected e.g. read=70)";
+                    return false;
+                }
+
+                weights[operation] = weight;
+                total += weight;
+            }
+
+            if (total == 0)
+            {
+                error = "The mix doesn't contain any request";
+                return false;
+            }
+            return true;
+        }
+
+
+        // Constructor
+        // =========================================================================================
+        LoadGenSettings::LoadGenSettings()
+        : help(false),
+          nodesPerRequest(10),
+          sessionsPerServer(1),
+          monitoredItems(0),
+          samplingIntervalSec(0.1),
+          publishingIntervalSec(0.1),
+          stepDurationSec(10.0),
+          soakDurationSec(0.0),
+          reportIntervalSec(60.0),
+          loopbackVariables(1000),
+          loopbackLatencySec(0.0)
+        {
+            weights[Read]    = 70;
+            weights[Write]   = 10;
+            weights[Call]    = 10;
+            weights[Browse]  = 10;
+            weights[History] = 0;
+
+            threads.push_back(1);
+            threads.push_back(2);
+            threads.push_back(4);
+            threads.push_back(8);
+        }
+
+
+        // Parse the command line
+        // =========================================================================================
+        bool LoadGenSettings::parse(int argc, char* argv[], std::string& error)
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                std::string option(argv[i]);
+
+                if (option == "--help" || option == "-h")
+                {
+                    help = true;
+                    continue;
+                }
+
+                if (i + 1 >= argc)
+                {
+                    error = "Missing value of option " + option;
+                    return false;
+                }
+                std::string value(argv[++i]);
+
+                bool valid = true;
+
+                if (option == "--discovery-url")
+                    discoveryUrls.push_back(value);
+                else if (option == "--server-uri")
+                    serverUris.push_back(value);
+                else if (option == "--namespace-uri")
+                    namespaceUri = value;
+                else if (option == "--variables")
+                    variableIds = splitList(value);
+                else if (option == "--object")
+                    objectId = value;
+                else if (option == "--method")
+                    methodId = value;
+                else if (option == "--browse")
+                    browseId = value;
+                else if (option == "--mix")
+                {
+                    if (!parseMix(value, weights, error))
+                        return false;
+                }
+                else if (option == "--nodes-per-request")
+                    valid = toUInt32(value, nodesPerRequest) && nodesPerRequest > 0;
+                else if (option == "--sessions-per-server")
+                    valid = toUInt32(value, sessionsPerServer) && sessionsPerServer > 0;
+                else if (option == "--monitored-items")
+                    valid = toUInt32(value, monitoredItems);
+                else if (option == "--sampling-interval")
+                    valid = toDouble(value, samplingIntervalSec);
+                else if (option == "--publishing-interval")
+                    valid = toDouble(value, publishingIntervalSec);
+                else if (option == "--threads")
+                {
+                    std::vector<std::string> items = splitList(value);
+                    threads.assign(items.size(), 0);
+                    for (std::size_t j = 0; j < items.size() && valid; j++)
+                        valid = toUInt32(items[j], threads[j]) && threads[j] > 0;
+                    valid = valid && !threads.empty();
+                }
+                else if (option == "--step-duration")
+                    valid = toDouble(value, stepDurationSec) && stepDurationSec > 0.0;
+                else if (option == "--soak-duration")
+                    valid = toDouble(value, soakDurationSec);
+                else if (option == "--report-interval")
+                    valid = toDouble(value, reportIntervalSec) && reportIntervalSec > 0.0;
+                else if (option == "--loopback-variables")
+                    valid = toUInt32(value, loopbackVariables) && loopbackVariables > 0;
+                else if (option == "--loopback-latency")
+                    valid = toDouble(value, loopbackLatencySec);
+                else
+                {
+                    error = "Unknown option " + option;
+                    return false;
+                }
+
+                if (!valid)
+                {
+                    error = "Invalid value '" + value + "' of option " + option;
+                    return false;
+                }
+            }
+
+            if (!discoveryUrls.empty())
+            {
+                if (serverUris.empty())
+                    error = "Specify the --server-uri of the servers to load";
+                else if (variableIds.empty() && monitoredItems > 0)
+                    error = "Specify the --variables to monitor";
+                else if (variableIds.empty() && (   weights[Read]  > 0
+                                                 || weights[Write] > 0
+                                                 || weights[History] > 0))
+                    error = "Specify the --variables to read, write or history read";
+                else if ((objectId.empty() || methodId.empty()) && weights[Call] > 0)
+                    error = "Specify the --object and --method to call";
+            }
+
+            return error.empty();
+        }
+
+
+        // Get the usage
+        // =========================================================================================
+        std::string LoadGenSettings::usage()
+        {
+            std::stringstream ss;
+            ss << "Usage: uaf_loadgen [options]\n"
+               << "\n"
+               << "Without --discovery-url, the load is generated on an in-process loopback "
+                  "server.\n"
+               << "\n"
+               << "Servers:\n"
+               << "  --discovery-url URL         discovery URL (repeat for several URLs)\n"
+               << "  --server-uri URI            server to load (repeat for several servers)\n"
+               << "  --namespace-uri URI         namespace of the identifiers below\n"
+               << "  --variables ID,ID,...       variables to read/write/monitor/history read\n"
+               << "  --object ID --method ID     method to call (with one Double argument)\n"
+               << "  --browse ID                 node to browse (default: the Objects folder)\n"
+               << "\n"
+               << "Load:\n"
+               << "  --mix read=70,write=10,...  requests per kind (read, write, call, browse, "
+                  "history)\n"
+               << "  --nodes-per-request N       nodes per read/write/history read (default 10)\n"
+               << "  --sessions-per-server N     sessions per server (default 1)\n"
+               << "  --monitored-items N         monitored items per server (default 0)\n"
+               << "  --sampling-interval SEC     sampling interval (default 0.1)\n"
+               << "  --publishing-interval SEC   publishing interval (default 0.1)\n"
+               << "\n"
+               << "Ramp and soak:\n"
+               << "  --threads N,N,...           threads per step of the ramp (default 1,2,4,8)\n"
+               << "  --step-duration SEC         duration of each step (default 10)\n"
+               << "  --soak-duration SEC         soak run at the last number of threads "
+                  "(default 0)\n"
+               << "  --report-interval SEC       interval of the soak reports (default 60)\n"
+               << "\n"
+               << "Loopback server:\n"
+               << "  --loopback-variables N      number of variables (default 1000)\n"
+               << "  --loopback-latency SEC      simulated latency per request (default 0)\n";
+            return ss.str();
+        }
+
+
+        // Get a string representation
+        // =========================================================================================
+        std::string LoadGenSettings::toString() const
+        {
+            std::stringstream ss;
+
+            if (discoveryUrls.empty())
+            {
+                ss << "servers             : loopback (" << loopbackVariables << " variables, "
+                   << loopbackLatencySec << " s latency)\n";
+            }
+            else
+            {
+                ss << "servers             :";
+                for (std::size_t i = 0; i < serverUris.size(); i++)
+                    ss << " " << serverUris[i];
+                ss << "\n";
+            }
+
+            ss << "mix                 :";
+            for (std::size_t i = 0; i < NO_OF_OPERATIONS; i++)
+            {
+                if (weights[i] > 0)
+                    ss << " " << OPERATION_NAMES[i] << "=" << weights[i];
+            }
+            ss << "\n";
+
+            ss << "nodes per request   : " << nodesPerRequest << "\n";
+            ss << "sessions per server : " << sessionsPerServer << "\n";
+            ss << "monitored items     : " << monitoredItems;
+            if (monitoredItems > 0)
+                ss << " (sampling " << samplingIntervalSec << " s, publishing "
+                   << publishingIntervalSec << " s)";
+            ss << "\n";
+
+            ss << "threads             :";
+            for (std::size_t i = 0; i < threads.size(); i++)
+                ss << " " << threads[i];
+            ss << " (" << stepDurationSec << " s per step)\n";
+
+            ss << "soak                : ";
+            if (soakDurationSec > 0.0)
+                ss << soakDurationSec << " s (reports every " << reportIntervalSec << " s)\n";
+            else
+                ss << "none\n";
+
+            return ss.str();
+        }
+
+    }
+
+}
@@ -0,0 +1,145 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_LOADGENSETTINGS_H_
+#define UAF_LOADGENSETTINGS_H_
+
+
+// STD
+#include <string>
+#include <vector>
+#include <stdint.h>
+// SDK
+// UAF
+
+
+
+namespace uaf
+{
+
+    namespace loadgen
+    {
+
+        /**
+         * The kinds of requests that the load generator sends.
+         */
+        enum Operation
+        {
+            Read    = 0,
+            Write   = 1,
+            Call    = 2,
+            Browse  = 3,
+            History = 4
+        };
+
+        /** The number of kinds of requests. */
+        const std::size_t NO_OF_OPERATIONS = 5;
+
+
+        /**
+         * The settings of a load generation run, as given on the command line.
+         */
+        struct LoadGenSettings
+        {
+            /**
+             * Construct the default settings: a load of reads, writes, calls and browses on a
+             * loopback server, ramped from 1 to 8 threads.
+             */
+            LoadGenSettings();
+
+            /**
+             * Parse the command line arguments.
+             *
+             * @param argc  The number of arguments (including the program name).
+             * @param argv  The arguments.
+             * @param error Output parameter: the reason why the arguments are invalid.
+             * @return      True if the arguments are valid.
+             */
+            bool parse(int argc, char* argv[], std::string& error);
+
+            /**
+             * Get the usage of the command line.
+             *
+             * @return  The usage, one option per line.
+             */
+            static std::string usage();
+
+            /**
+             * Get a string representation of the settings.
+             *
+             * @return  The settings, one per line.
+             */
+            std::string toString() const;
+
+            /** True to print the usage and exit. */
+            bool help;
+
+            /** The discovery URLs of the servers (none to use a loopback server). */
+            std::vector<std::string> discoveryUrls;
+            /** The URIs of the servers to load (ignored for a loopback server). */
+            std::vector<std::string> serverUris;
+            /** The namespace URI of the identifiers below. */
+            std::string namespaceUri;
+            /** The identifiers of the variables to read, write, monitor and history read
+             *  (numeric if they consist of digits only). */
+            std::vector<std::string> variableIds;
+            /** The identifier of the object of the method to call. */
+            std::string objectId;
+            /** The identifier of the method to call (with one Double argument). */
+            std::string methodId;
+            /** The identifier of the node to browse (empty for the Objects folder). */
+            std::string browseId;
+
+            /** The relative number of requests per kind of request. */
+            uint32_t weights[NO_OF_OPERATIONS];
+            /** The number of nodes per read, write and history read request. */
+            uint32_t nodesPerRequest;
+            /** The number of sessions per server, over which the requests are spread. */
+            uint32_t sessionsPerServer;
+
+            /** The number of monitored items per server (0 = no subscriptions). */
+            uint32_t monitoredItems;
+            /** The sampling interval of the monitored items. */
+            double samplingIntervalSec;
+            /** The publishing interval of the subscriptions. */
+            double publishingIntervalSec;
+
+            /** The numbers of threads that send requests, one step of the ramp per number. */
+            std::vector<uint32_t> threads;
+            /** The duration of each step of the ramp. */
+            double stepDurationSec;
+            /** The duration of the soak run after the ramp, at the highest number of threads
+             *  (0 = no soak run). */
+            double soakDurationSec;
+            /** The interval between the reports of the soak run. */
+            double reportIntervalSec;
+
+            /** The number of variables of the loopback server. */
+            uint32_t loopbackVariables;
+            /** The simulated latency of every request to the loopback server. */
+            double loopbackLatencySec;
+        };
+
+    }
+
+}
+
+
+#endif /* UAF_LOADGENSETTINGS_H_ */
@@ -0,0 +1,149 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/loadgen/loadreport.h"
+
+// STD
+#include <cstdio>
+#include <vector>
+
+
+namespace uaf
+{
+
+    namespace loadgen
+    {
+
+        // Get the metrics of a service between two samples
+        // =========================================================================================
+        static ServiceMetrics difference(
+                const ServiceMetrics&               after,
+                const std::vector<ServiceMetrics>&  before)
+        {
+            ServiceMetrics ret(after);
+
+            for (std::size_t i = 0; i < before.size(); i++)
+            {
+                if (before[i].serverUri == after.serverUri && before[i].service == after.service)
+                {
+                    ret.invocations   -= before[i].invocations;
+                    ret.failures      -= before[i].failures;
+                    ret.targets       -= before[i].targets;
+                    ret.latencySumSec -= before[i].latencySumSec;
+                    for (std::size_t j = 0; j < ret.latencyBucketCounts.size()
+                                         && j < before[i].latencyBucketCounts.size(); j++)
+                        ret.latencyBucketCounts[j] -= before[i].latencyBucketCounts[j];
+                    break;
+                }
+            }
+
+            return ret;
+        }
+
+
+        // Get the number of notifications received so far
+        // =========================================================================================
+        static uint64_t notificationCount(const Metrics& metrics)
+        {
+            uint64_t ret = 0;
+            for (std::size_t i = 0; i < metrics.subscriptions.size(); i++)
+                ret += metrics.subscriptions[i].dataChangeNotifications
+                     + metrics.subscriptions[i].eventNotifications;
+            return ret;
+        }
+
+
+        // Convert a number of bytes to megabytes
+        // =========================================================================================
+        static double toMegabytes(double bytes)
+        {
+            return bytes / (1024.0 * 1024.0);
+        }
+
+
+        // Print a report
+        // =========================================================================================
+        void printReport(
+                const std::string&  title,
+                const LoadSample&   before,
+                const LoadSample&   after)
+        {
+            double intervalSec = after.timeSec - before.timeSec;
+            if (intervalSec <= 0.0)
+                intervalSec = 1.0;
+
+            printf("\n== %s (%.1f s)\n", title.c_str(), intervalSec);
+            printf("%-32s %-24s %12s %12s %9s %9s %9s %9s\n",
+                   "service", "server", "requests/s", "nodes/s", "failed",
+                   "p50 ms", "p90 ms", "p99 ms");
+
+            const std::vector<ServiceMetrics>& services = after.metrics.services;
+            for (std::size_t i = 0; i < services.size(); i++)
+            {
+                ServiceMetrics delta = difference(services[i], before.metrics.services);
+                if (delta.invocations == 0)
+                    continue;
+
+                printf("%-32s %-24s %12.1f %12.1f %9llu %9.3f %9.3f %9.3f\n",
+                       delta.service.c_str(),
+                       delta.serverUri.c_str(),
+                       double(delta.invocations) / intervalSec,
+                       double(delta.targets) / intervalSec,
+                       (unsigned long long)delta.failures,
+                       delta.latencyPercentileSec(0.50) * 1000.0,
+                       delta.latencyPercentileSec(0.90) * 1000.0,
+                       delta.latencyPercentileSec(0.99) * 1000.0);
+            }
+
+            uint64_t notifications = notificationCount(after.metrics)
+                                   - notificationCount(before.metrics);
+            uint64_t dropped = after.metrics.notificationQueue.dropped
+                             - before.metrics.notificationQueue.dropped;
+
+            printf("notifications/s : %.1f (%llu dropped by the notification queue)\n",
+                   double(notifications) / intervalSec,
+                   (unsigned long long)dropped);
+            printf("memory          : %.1f MB resident, %.3f MB client database\n",
+                   toMegabytes(double(after.residentBytes)),
+                   toMegabytes(double(after.databaseBytes)));
+            fflush(stdout);
+        }
+
+
+        // Print the memory growth
+        // =========================================================================================
+        void printMemoryGrowth(const LoadSample& first, const LoadSample& last)
+        {
+            double hours = (last.timeSec - first.timeSec) / 3600.0;
+            double residentGrowth = double(last.residentBytes) - double(first.residentBytes);
+            double databaseGrowth = double(last.databaseBytes) - double(first.databaseBytes);
+
+            printf("memory growth   : %+.1f MB resident, %+.3f MB client database",
+                   toMegabytes(residentGrowth),
+                   toMegabytes(databaseGrowth));
+            if (hours > 0.0)
+                printf(" (%+.1f MB/hour resident)", toMegabytes(residentGrowth) / hours);
+            printf("\n");
+            fflush(stdout);
+        }
+
+    }
+
+}
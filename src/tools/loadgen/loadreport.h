@@ -0,0 +1,68 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_LOADREPORT_H_
+#define UAF_LOADREPORT_H_
+
+
+// STD
+#include <string>
+// SDK
+// UAF
+#include "tools/loadgen/loadgenerator.h"
+
+
+
+namespace uaf
+{
+
+    namespace loadgen
+    {
+
+        /**
+         * Print what happened between two samples: the throughput, the failures and the latency
+         * percentiles per server and service, the notification rate, and the memory.
+         *
+         * @param title     The title of the report (e.g. "ramp: 4 threads").
+         * @param before    The sample at the start of the interval.
+         * @param after     The sample at the end of the interval.
+         */
+        void printReport(
+                const std::string&                  title,
+                const uaf::loadgen::LoadSample&     before,
+                const uaf::loadgen::LoadSample&     after);
+
+
+        /**
+         * Print the memory growth between two samples, in total and per hour.
+         *
+         * @param first     The sample at the start of the soak run.
+         * @param last      The latest sample of the soak run.
+         */
+        void printMemoryGrowth(
+                const uaf::loadgen::LoadSample&     first,
+                const uaf::loadgen::LoadSample&     last);
+
+    }
+
+}
+
+
+#endif /* UAF_LOADREPORT_H_ */
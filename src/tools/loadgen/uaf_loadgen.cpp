@@ -0,0 +1,130 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STD
+#include <cstdio>
+#include <sstream>
+#include <string>
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/datetime.h"
+#include "tools/loadgen/loadgensettings.h"
+#include "tools/loadgen/loadgenerator.h"
+#include "tools/loadgen/loadreport.h"
+
+
+using namespace uaf::loadgen;
+
+
+/**
+ * Sleep for the given number of seconds.
+ */
+static void sleepSec(double sec)
+{
+    if (sec > 0.0)
+        uaf::DateTime::msleep(uint32_t(sec * 1000.0));
+}
+
+
+/**
+ * Generate load on one or more servers (or on a loopback server), and report what one Client
+ * sustains.
+ *
+ * Usage: see LoadGenSettings::usage() (or run uaf_loadgen --help).
+ *
+ * The load is ramped up over the given numbers of threads, one step per number, and the
+ * throughput, the latency percentiles and the notification rate of each step are reported.
+ * Then, optionally, the load is kept at the highest number of threads for a soak run, which
+ * reports the same figures periodically, together with the growth of the memory.
+ */
+int main(int argc, char* argv[])
+{
+    LoadGenSettings settings;
+    std::string error;
+    if (!settings.parse(argc, argv, error))
+    {
+        fprintf(stderr, "%s\n\n%s", error.c_str(), LoadGenSettings::usage().c_str());
+        return 2;
+    }
+    if (settings.help)
+    {
+        printf("%s", LoadGenSettings::usage().c_str());
+        return 0;
+    }
+
+    uaf::initializeUaf();
+
+    printf("%s", settings.toString().c_str());
+
+    LoadGenerator generator(settings);
+
+    uaf::Status status = generator.setUp();
+    if (status.isNotGood())
+    {
+        fprintf(stderr, "Could not set up the load: %s\n", status.toString().c_str());
+        return 1;
+    }
+
+    // the ramp
+    LoadSample before = generator.sample();
+    for (std::size_t i = 0; i < settings.threads.size(); i++)
+    {
+        generator.start(settings.threads[i]);
+        sleepSec(settings.stepDurationSec);
+        generator.stop();
+
+        LoadSample after = generator.sample();
+        std::stringstream title;
+        title << "ramp: " << settings.threads[i] << " thread(s)";
+        printReport(title.str(), before, after);
+        before = after;
+    }
+
+    // the soak run
+    if (settings.soakDurationSec > 0.0)
+    {
+        uint32_t noOfThreads = settings.threads.back();
+        generator.start(noOfThreads);
+
+        LoadSample first = generator.sample();
+        LoadSample previous = first;
+        double elapsedSec = 0.0;
+
+        while (elapsedSec < settings.soakDurationSec)
+        {
+            double remainingSec = settings.soakDurationSec - elapsedSec;
+            sleepSec(remainingSec < settings.reportIntervalSec ? remainingSec
+                                                               : settings.reportIntervalSec);
+
+            LoadSample latest = generator.sample();
+            elapsedSec = latest.timeSec - first.timeSec;
+
+            std::stringstream title;
+            title << "soak: " << noOfThreads << " thread(s), " << int(elapsedSec) << " s elapsed";
+            printReport(title.str(), previous, latest);
+            printMemoryGrowth(first, latest);
+            previous = latest;
+        }
+
+        generator.stop();
+    }
+
+    return 0;
+}
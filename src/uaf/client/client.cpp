@@ -19,6 +19,9 @@
  */
 
 #include "uaf/client/client.h"
+#include "uaf/client/crawling/crawler.h"
+#include "uaf/client/database/snapshot.h"
+#include "uaf/client/metrics/tracetimer.h"
 
 
 namespace uaf
@@ -29,6 +32,7 @@ namespace uaf
     using std::vector;
     using std::size_t;
     using std::pair;
+    using std::set;
 
 
     // Constructor
@@ -74,18 +78,57 @@ namespace uaf
     }
 
 
+    // Get the registered nodes of a handle and their aliases
+    // =============================================================================================
+    Status Client::registeredNodeIds(
+            RegisteredNodesHandle   handle,
+            RegisteredNodes&        registeredNodes,
+            vector<ExpandedNodeId>& aliases)
+    {
+        Status ret;
+
+        registeredNodesMutex_.lock();
+        RegisteredNodesMap::const_iterator iter = registeredNodes_.find(handle);
+        if (iter == registeredNodes_.end())
+        {
+            ret = UnknownRegisteredNodesHandleError(handle);
+            logger_->error(ret);
+        }
+        else
+        {
+            registeredNodes = iter->second;
+            ret = statuscodes::Good;
+        }
+        registeredNodesMutex_.unlock();
+
+        if (ret.isGood())
+            sessionFactory_->registeredNodeIds(registeredNodes.expandedNodeIds,
+                                               registeredNodes.clientConnectionIds,
+                                               aliases);
+
+        return ret;
+    }
+
+
     // Common constructor code
     // =============================================================================================
     void Client::construct()
     {
         currentRequestHandle_ = 0;
+        currentRegisteredNodesHandle_ = 0;
         doFinishThread_ = false;
+        traceSink_ = NULL;
+        traceWriter_ = NULL;
 
         database_       = new Database(logger_->loggerFactory());
         discoverer_     = new Discoverer(logger_->loggerFactory(), database_);
         sessionFactory_ = new SessionFactory(logger_->loggerFactory(), this, discoverer_, database_);
         resolver_       = new Resolver(logger_->loggerFactory(), sessionFactory_, database_);
 
+        // the notifications of the sessions are passed through this queue (the delivery threads
+        // are only started once the ClientSettings ask for a queue)
+        notificationQueue_ = new NotificationQueue(logger_->loggerFactory(), this);
+
         logger_->debug("Now starting the thread to periodically check the requests");
 
         // start the thread
@@ -108,6 +151,8 @@ namespace uaf
 
         wait();
 
+        // write the snapshot before the sessions are deleted (since that clears their caches)
+        writeSnapshot();
 
         delete resolver_;
         resolver_ = 0;
@@ -115,12 +160,19 @@ namespace uaf
         delete sessionFactory_;
         sessionFactory_ = 0;
 
+        // no more notifications can arrive now, so the queued ones can be delivered
+        delete notificationQueue_;
+        notificationQueue_ = 0;
+
         delete discoverer_;
         discoverer_ = 0;
 
         delete database_;
         database_ = 0;
 
+        delete traceWriter_;
+        traceWriter_ = 0;
+
         delete logger_;
         logger_ = 0;
 
@@ -146,8 +198,43 @@ namespace uaf
         logger_->loggerFactory()->setCallbackLevel(settings.logToCallbackLevel);
 
         bool doFindServers = (settings.discoveryUrls != database_->clientSettings.discoveryUrls);
+        bool doLoadSnapshot = (
+                !settings.snapshotFileName.empty()
+                && settings.snapshotFileName != database_->clientSettings.snapshotFileName);
+        bool doOpenTraceFile = (
+                settings.traceFileName != database_->clientSettings.traceFileName
+                || (!settings.traceFileName.empty() && traceWriter_ == NULL));
         database_->clientSettings = settings;
 
+        // (re)open the trace file if it was changed
+        if (doOpenTraceFile)
+        {
+            UaMutexLocker locker(&traceSinkMutex_); // unlocks when locker goes out of scope
+
+            delete traceWriter_;
+            traceWriter_ = NULL;
+
+            if (!settings.traceFileName.empty())
+            {
+                traceWriter_ = new ChromeTraceWriter(settings.traceFileName);
+                if (!traceWriter_->isOpen())
+                    logger_->warning("The trace file %s could not be opened",
+                                     settings.traceFileName.c_str());
+            }
+        }
+
+        // a snapshot of the same discovery URLs makes the discovery unnecessary for now, since the
+        // servers will be rediscovered by the thread after discoveryIntervalSec anyway
+        if (doLoadSnapshot && loadSnapshot() && doFindServers)
+        {
+            logger_->debug("The servers of the snapshot are used until the system is rediscovered");
+            doFindServers = false;
+        }
+
+        notificationQueue_->configure(settings.notificationQueueCapacity,
+                                      settings.notificationQueueOverflowPolicy,
+                                      settings.notificationDeliveryThreads);
+
         if (doFindServers)
         {
             logger_->debug("The discoveryUrls were changed, so we rediscover the system");
@@ -158,6 +245,116 @@ namespace uaf
 
 
 
+    // Load the warm-start snapshot
+    // =============================================================================================
+    bool Client::loadSnapshot()
+    {
+        string fileName = database_->clientSettings.snapshotFileName;
+
+        Snapshot snapshot;
+        if (!snapshot.readFromFile(fileName))
+        {
+            logger_->warning("The snapshot %s could not be read, so the client starts cold",
+                             fileName.c_str());
+            return false;
+        }
+
+        logger_->info("Loading snapshot %s (%d servers, %d addresses, %d structure definitions)",
+                      fileName.c_str(),
+                      snapshot.serverDescriptions.size(),
+                      snapshot.addresses.size(),
+                      snapshot.definitions.size());
+
+        // the snapshot may be older than what the sessions have seen already: the entries of the
+        // servers with a different NamespaceArray are skipped
+        set<string> skippedServerUris;
+        map<string, NameSpaceMap> knownNamespaceArrays = database_->namespaceArrays();
+
+        for (map<string, NameSpaceMap>::const_iterator it = snapshot.namespaceArrays.begin();
+             it != snapshot.namespaceArrays.end();
+             ++it)
+        {
+            map<string, NameSpaceMap>::const_iterator known = knownNamespaceArrays.find(it->first);
+
+            if (known == knownNamespaceArrays.end())
+                database_->updateNamespaceArray(it->first, it->second);
+            else if (known->second != it->second)
+                skippedServerUris.insert(it->first);
+        }
+
+        // the other entries are preloaded, and will be validated when the sessions connect
+        Mask mask(snapshot.addresses.size());
+        for (size_t i = 0; i < snapshot.addresses.size(); i++)
+        {
+            if (skippedServerUris.count(snapshot.expandedNodeIds[i].serverUri()) == 0)
+                mask.set(i);
+        }
+        database_->addressCache.add(snapshot.addresses, snapshot.expandedNodeIds, mask);
+
+        for (size_t i = 0; i < snapshot.definitions.size(); i++)
+        {
+            if (skippedServerUris.count(snapshot.definitionServerUris[i]) == 0)
+                database_->structureDefinitionCache.add(
+                        snapshot.definitionServerUris[i],
+                        snapshot.definitionDataTypeIds[i],
+                        StructureCodec(snapshot.definitions[i]));
+        }
+
+        // the discovered servers are only useful for the same discovery URLs, but the endpoints
+        // are stored per discovery URL so they can always be used
+        bool sameDiscoveryUrls = (snapshot.discoveryUrls == database_->clientSettings.discoveryUrls);
+
+        if (sameDiscoveryUrls)
+            discoverer_->preload(snapshot.serverDescriptions, snapshot.endpointDescriptions);
+        else
+            discoverer_->preload(vector<ApplicationDescription>(), snapshot.endpointDescriptions);
+
+        return sameDiscoveryUrls && !snapshot.serverDescriptions.empty();
+    }
+
+
+    // Write the warm-start snapshot
+    // =============================================================================================
+    void Client::writeSnapshot()
+    {
+        string fileName = database_->clientSettings.snapshotFileName;
+
+        if (fileName.empty())
+            return;
+
+        Snapshot snapshot;
+        snapshot.discoveryUrls          = database_->clientSettings.discoveryUrls;
+        snapshot.serverDescriptions     = discoverer_->serversFound();
+        snapshot.endpointDescriptions   = discoverer_->knownEndpoints();
+        snapshot.namespaceArrays        = database_->namespaceArrays();
+        database_->addressCache.entries(snapshot.addresses, snapshot.expandedNodeIds);
+        database_->structureDefinitionCache.entries(
+                snapshot.definitionServerUris,
+                snapshot.definitionDataTypeIds,
+                snapshot.definitions);
+
+        if (snapshot.writeToFile(fileName))
+            logger_->debug("The snapshot has been written to %s", fileName.c_str());
+        else
+            logger_->warning("The snapshot could not be written to %s", fileName.c_str());
+    }
+
+
+    // Export the metrics
+    // =============================================================================================
+    void Client::exportMetrics()
+    {
+        Metrics currentMetrics = metrics();
+
+        string fileName = database_->clientSettings.metricsFileName;
+
+        if (!fileName.empty() && !currentMetrics.writeToFile(fileName))
+            logger_->warning("The metrics could not be written to %s", fileName.c_str());
+
+        metricsReceived(currentMetrics);
+    }
+
+
     // Find the servers now
     // =============================================================================================
     Status Client::findServersNow()
@@ -304,6 +501,169 @@ namespace uaf
     }
 
 
+    // Register a number of nodes
+    //==============================================================================================
+    Status Client::registerNodes(
+            const vector<Address>&      addresses,
+            const ServiceSettings*      serviceSettings,
+            const SessionSettings*      sessionSettings,
+            RegisteredNodesHandle&      handle,
+            vector<Status>&             statuses)
+    {
+        logger_->debug("Registering %d nodes", addresses.size());
+
+        RegisteredNodes registeredNodes;
+        registeredNodes.sessionSettingsGiven = (sessionSettings != NULL);
+        if (sessionSettings != NULL)
+            registeredNodes.sessionSettings = *sessionSettings;
+
+        // resolve the addresses once, so the nodes can be accessed directly from now on
+        Status ret = resolver_->resolve(addresses, registeredNodes.expandedNodeIds, statuses);
+
+        if (ret.isGood())
+        {
+            ret = sessionFactory_->registerNodes(registeredNodes.expandedNodeIds,
+                                                 sessionSettings,
+                                                 serviceSettings,
+                                                 registeredNodes.clientConnectionIds,
+                                                 statuses);
+
+            if (ret.isGood())
+            {
+                UaMutexLocker locker(&registeredNodesMutex_); // unlocks when out of scope
+                handle = ++currentRegisteredNodesHandle_;
+                registeredNodes_[handle] = registeredNodes;
+
+                logger_->debug("The nodes were registered with handle %d", handle);
+            }
+            else
+            {
+                // don't keep the nodes of the other servers registered, since no handle is
+                // assigned to release them
+                sessionFactory_->unregisterNodes(registeredNodes.expandedNodeIds,
+                                                 registeredNodes.clientConnectionIds,
+                                                 serviceSettings);
+            }
+        }
+
+        return ret;
+    }
+
+
+    // Unregister a number of nodes
+    //==============================================================================================
+    Status Client::unregisterNodes(
+            RegisteredNodesHandle       handle,
+            const ServiceSettings*      serviceSettings)
+    {
+        logger_->debug("Unregistering the nodes of handle %d", handle);
+
+        Status ret;
+        RegisteredNodes registeredNodes;
+
+        registeredNodesMutex_.lock();
+        RegisteredNodesMap::iterator iter = registeredNodes_.find(handle);
+        if (iter == registeredNodes_.end())
+        {
+            ret = UnknownRegisteredNodesHandleError(handle);
+        }
+        else
+        {
+            registeredNodes = iter->second;
+            registeredNodes_.erase(iter);
+            ret = statuscodes::Good;
+        }
+        registeredNodesMutex_.unlock();
+
+        if (ret.isGood())
+            ret = sessionFactory_->unregisterNodes(registeredNodes.expandedNodeIds,
+                                                   registeredNodes.clientConnectionIds,
+                                                   serviceSettings);
+
+        return ret;
+    }
+
+
+    // Read an attribute of registered nodes
+    //==============================================================================================
+    Status Client::read(
+            RegisteredNodesHandle       handle,
+            attributeids::AttributeId   attributeId,
+            const ReadSettings*         serviceSettings,
+            ReadResult&                 result)
+    {
+        logger_->debug("Reading the registered nodes of handle %d", handle);
+
+        RegisteredNodes registeredNodes;
+        vector<ExpandedNodeId> aliases;
+
+        Status ret = registeredNodeIds(handle, registeredNodes, aliases);
+
+        if (ret.isGood())
+        {
+            ReadRequest request(
+                    0,
+                    constants::CLIENTHANDLE_NOT_ASSIGNED,
+                    serviceSettings,
+                    NULL,
+                    registeredNodes.sessionSettingsGiven ? &registeredNodes.sessionSettings : NULL);
+
+            request.targets.reserve(aliases.size());
+
+            for (vector<ExpandedNodeId>::const_iterator it = aliases.begin(); it != aliases.end(); ++it)
+                request.targets.push_back(ReadRequestTarget(Address(*it), attributeId));
+
+            ret = processRequestPerSession<ReadService>(
+                    request, registeredNodes.clientConnectionIds, result);
+        }
+
+        return ret;
+    }
+
+
+    // Write an attribute of registered nodes
+    //==============================================================================================
+    Status Client::write(
+            RegisteredNodesHandle       handle,
+            const vector<Variant>&      data,
+            attributeids::AttributeId   attributeId,
+            const WriteSettings*        serviceSettings,
+            WriteResult&                result)
+    {
+        logger_->debug("Writing the registered nodes of handle %d", handle);
+
+        RegisteredNodes registeredNodes;
+        vector<ExpandedNodeId> aliases;
+
+        Status ret = registeredNodeIds(handle, registeredNodes, aliases);
+
+        // check if the registered nodes and the data match
+        if (ret.isGood() && aliases.size() != data.size())
+            ret = DataDontMatchAddressesError();
+
+        if (ret.isGood())
+        {
+            WriteRequest request(
+                    0,
+                    constants::CLIENTHANDLE_NOT_ASSIGNED,
+                    serviceSettings,
+                    NULL,
+                    registeredNodes.sessionSettingsGiven ? &registeredNodes.sessionSettings : NULL);
+
+            request.targets.reserve(aliases.size());
+
+            for (size_t i = 0; i < aliases.size(); i++)
+                request.targets.push_back(
+                        WriteRequestTarget(Address(aliases[i]), data[i], attributeId));
+
+            ret = processRequestPerSession<WriteService>(
+                    request, registeredNodes.clientConnectionIds, result);
+        }
+
+        return ret;
+    }
+
+
     // Call a method synchronously
     //==============================================================================================
     Status Client::call(
@@ -552,6 +912,25 @@ namespace uaf
     }
 
 
+    // Crawl the address space
+    //==============================================================================================
+    uaf::Status Client::crawl(
+            const std::vector<uaf::Address>&    startAddresses,
+            const uaf::CrawlSettings*           settings,
+            uaf::CrawlStatistics&               statistics)
+    {
+        logger_->debug("Crawling from %d start nodes", startAddresses.size());
+
+        CrawlSettings defaultSettings;
+
+        Crawler crawler(logger_->loggerFactory(), this, this);
+
+        return crawler.crawl(startAddresses,
+                             settings == NULL ? defaultSettings : *settings,
+                             statistics);
+    }
+
+
 
 
     // Start monitoring data items
@@ -566,20 +945,23 @@ namespace uaf
             const uaf::SubscriptionSettings*                    subscriptionSettings,
             uaf::CreateMonitoredDataResult&                     result)
     {
-        CreateMonitoredDataRequest request(0,
-                                           clientConnectionId,
-                                           serviceSettings,
-                                           translateSettings,
-                                           sessionSettings,
-                                           clientSubscriptionHandle,
-                                           subscriptionSettings);
-
+        // the request is created on the heap, so that the client can keep it without copying it
+        CreateMonitoredDataRequest* request = new CreateMonitoredDataRequest(
+                0,
+                clientConnectionId,
+                serviceSettings,
+                translateSettings,
+                sessionSettings,
+                clientSubscriptionHandle,
+                subscriptionSettings);
+
+        request->targets.reserve(addresses.size());
         for (vector<Address>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
         {
-            request.targets.push_back(CreateMonitoredDataRequestTarget(*it));
+            request->targets.push_back(CreateMonitoredDataRequestTarget(*it));
         }
 
-        return processRequest(request, result);
+        return processOwnedRequest<CreateMonitoredDataService>(request, result);
     }
 
 
@@ -598,18 +980,21 @@ namespace uaf
             const uaf::SubscriptionSettings*                    subscriptionSettings,
             uaf::CreateMonitoredEventsResult&                   result)
     {
-        CreateMonitoredEventsRequest request(0,
-                                             clientConnectionId,
-                                             serviceSettings,
-                                             translateSettings,
-                                             sessionSettings,
-                                             clientSubscriptionHandle,
-                                             subscriptionSettings);
-
+        // the request is created on the heap, so that the client can keep it without copying it
+        CreateMonitoredEventsRequest* request = new CreateMonitoredEventsRequest(
+                0,
+                clientConnectionId,
+                serviceSettings,
+                translateSettings,
+                sessionSettings,
+                clientSubscriptionHandle,
+                subscriptionSettings);
+
+        request->targets.reserve(addresses.size());
         for (size_t i=0; i<addresses.size(); i++)
-            request.targets.push_back(CreateMonitoredEventsRequestTarget(addresses[i], eventFilter));
+            request->targets.push_back(CreateMonitoredEventsRequestTarget(addresses[i], eventFilter));
 
-        return processRequest(request, result);
+        return processOwnedRequest<CreateMonitoredEventsService>(request, result);
     }
 
 
@@ -722,13 +1107,11 @@ namespace uaf
         // first try to find the client handle in the session factory
         ret = sessionFactory_->monitoredItemInformation(clientHandle, monitoredItemInformation);
 
-        // if the client handle was not found, we can check if it was assigned once
+        // if the client handle was not found, we can check if it is assigned to a monitored item
+        // that still needs to be (re-)created
         if (ret.isNotGood())
         {
-            bool isFound = std::find(database_->allClientHandles.begin(),
-                                     database_->allClientHandles.end(),
-                                     clientHandle) != database_->allClientHandles.end();
-            if (isFound)
+            if (database_->isClientHandleAssigned(clientHandle))
             {
                 monitoredItemInformation.monitoredItemState = monitoreditemstates::NotCreated;
                 ret = statuscodes::Good;
@@ -739,6 +1122,80 @@ namespace uaf
     }
 
 
+    // Get the memory footprint of the database
+    // =============================================================================================
+    DatabaseFootprint Client::databaseFootprint()
+    {
+        return database_->footprint();
+    }
+
+
+    // Get the statistics of the notification queue
+    // =============================================================================================
+    NotificationQueueStatistics Client::notificationQueueStatistics()
+    {
+        return notificationQueue_->statistics();
+    }
+
+
+    // Set the sink of the traces
+    // =============================================================================================
+    void Client::setTraceSink(TraceSink* sink)
+    {
+        UaMutexLocker locker(&traceSinkMutex_); // unlocks when locker goes out of scope
+        traceSink_ = sink;
+    }
+
+
+    // Set the factory of the session transports
+    // =============================================================================================
+    void Client::setSessionTransportFactory(SessionTransportFactory* transportFactory)
+    {
+        discoverer_->setSessionTransportFactory(transportFactory);
+        sessionFactory_->setSessionTransportFactory(transportFactory);
+    }
+
+
+    // Pass a trace to the sinks
+    // =============================================================================================
+    void Client::traceFinished(const RequestTrace& trace)
+    {
+        UaMutexLocker locker(&traceSinkMutex_); // unlocks when locker goes out of scope
+
+        if (traceWriter_ != NULL)
+            traceWriter_->traceFinished(trace);
+
+        if (traceSink_ != NULL)
+            traceSink_->traceFinished(trace);
+    }
+
+
+    // Get the metrics
+    // =============================================================================================
+    Metrics Client::metrics()
+    {
+        Metrics ret = database_->collectMetrics();
+        ret.notificationQueue = notificationQueue_->statistics();
+        return ret;
+    }
+
+
+    // Data change notifications were received
+    // =============================================================================================
+    void Client::dataChangesReceived(const ConstSpan<DataChangeNotification>& notifications)
+    {
+        notificationQueue_->push(notifications);
+    }
+
+
+    // Event notifications were received
+    // =============================================================================================
+    void Client::eventsReceived(const ConstSpan<EventNotification>& notifications)
+    {
+        notificationQueue_->push(notifications);
+    }
+
+
     // Set the publishing mode.
     // =============================================================================================
     Status Client::setPublishingMode(
@@ -767,6 +1224,34 @@ namespace uaf
     }
 
 
+    // Delete the monitored items
+    // =============================================================================================
+    Status Client::deleteMonitoredItems(
+            const vector<ClientHandle>& clientHandles,
+            const ServiceSettings*      serviceSettings,
+            vector<Status>&             results)
+    {
+        return sessionFactory_->deleteMonitoredItems(clientHandles,
+                                                     serviceSettings,
+                                                     results);
+    }
+
+
+    // Modify the monitored items
+    // =============================================================================================
+    Status Client::modifyMonitoredItems(
+            const vector<ClientHandle>&     clientHandles,
+            const MonitoredItemSettings&    settings,
+            const ServiceSettings*          serviceSettings,
+            vector<Status>&                 results)
+    {
+        return sessionFactory_->modifyMonitoredItems(clientHandles,
+                                                     settings,
+                                                     serviceSettings,
+                                                     results);
+    }
+
+
     // Run the thread
     // =============================================================================================
     void Client::run()
@@ -777,12 +1262,20 @@ namespace uaf
         time_t currentTime;
         time_t lastTime;
 
+        // declare the time of the last snapshot and of the last export of the metrics
+        time_t lastSnapshotTime;
+        time_t lastMetricsTime;
+
         // initialize the time values
         time(&currentTime);
         time(&lastTime);
+        time(&lastSnapshotTime);
+        time(&lastMetricsTime);
 
 
         double updateInterval;
+        double snapshotInterval;
+        double metricsInterval;
 
         while (!doFinishThread_)
         {
@@ -811,6 +1304,24 @@ namespace uaf
                 if (!doFinishThread_)
                     processPersistedRequests(database_->createMonitoredEventsRequestStore);
             }
+
+            snapshotInterval = database_->clientSettings.snapshotIntervalSec;
+
+            if (!doFinishThread_ && difftime(currentTime, lastSnapshotTime) > snapshotInterval)
+            {
+                time(&lastSnapshotTime);
+                writeSnapshot();
+            }
+
+            metricsInterval = database_->clientSettings.metricsIntervalSec;
+
+            if (!doFinishThread_
+                    && metricsInterval > 0.0
+                    && difftime(currentTime, lastMetricsTime) >= metricsInterval)
+            {
+                time(&lastMetricsTime);
+                exportMetrics();
+            }
         }
     }
 
@@ -913,6 +1424,34 @@ namespace uaf
     }
 
 
+#if __cplusplus >= 201103L
+
+    // Process a CreateMonitoredDataRequest that is moved into the client
+    // =============================================================================================
+    Status Client::processRequest(
+            uaf::CreateMonitoredDataRequest&&       request,
+            uaf::CreateMonitoredDataResult&         result)
+    {
+        return processOwnedRequest<uaf::CreateMonitoredDataService>(
+                new CreateMonitoredDataRequest(std::move(request)),
+                result);
+    }
+
+
+    // Process a CreateMonitoredEventsRequest that is moved into the client
+    // =============================================================================================
+    Status Client::processRequest(
+            uaf::CreateMonitoredEventsRequest&&     request,
+            uaf::CreateMonitoredEventsResult&       result)
+    {
+        return processOwnedRequest<uaf::CreateMonitoredEventsService>(
+                new CreateMonitoredEventsRequest(std::move(request)),
+                result);
+    }
+
+#endif
+
+
     // Process a HistoryReadRawModifiedRequest
     // =============================================================================================
     Status Client::processRequest(
@@ -931,11 +1470,22 @@ namespace uaf
     }
 
 
+    // Get a compiled structure definition
+    // =============================================================================================
+    Status Client::structureCodec(
+            const uaf::NodeId&      dataTypeId,
+            const string&           serverUri,
+            uaf::StructureCodec&    codec)
+    {
+        return sessionFactory_->structureCodec(dataTypeId, serverUri, codec);
+    }
+
+
     // Private template function implementation: assign a UAF handle
     // =============================================================================================
     template <typename _Service>
     Status Client::assignRequestHandle(
-            typename _Service::Request& request,
+            uaf::RequestHandle&         requestHandle,
             typename _Service::Result&  result)
     {
         Status ret;
@@ -948,8 +1498,8 @@ namespace uaf
         {
             // increment the handle, assign it to the request and result, and update the status
             currentRequestHandle_++;
-            request.requestHandle_ = currentRequestHandle_;
-            result.requestHandle   = currentRequestHandle_;
+            requestHandle        = currentRequestHandle_;
+            result.requestHandle = currentRequestHandle_;
             ret = statuscodes::Good;
         }
         else
@@ -986,8 +1536,10 @@ namespace uaf
         // (We don't have to care about the Status result of the processRequest function,
         // since processPersistentRequests() is called automatically by a thread, and this
         // thread doesn't perform any actions in case of failures.)
+        // The stored requests are shared by the items, so they are not copied.
         for (typename Items::iterator it = items.begin(); it != items.end(); ++it)
             processRequest<typename _Store::ServiceType>(
+                    *it->request,
                     it->request,
                     it->badTargetsMask,
                     it->result);
@@ -1001,62 +1553,207 @@ namespace uaf
             const typename _Service::Request&   request,
             typename _Service::Result&          result)
     {
-        return processRequest<_Service>(request, uaf::Mask(request.targets.size(), true), result);
+        return processRequest<_Service>(
+                request,
+                uaf::SharedConst<typename _Service::Request>(),
+                uaf::Mask(request.targets.size(), true),
+                result);
     }
 
 
-    // Private template function implementation: process a masked request
+    // Private template function implementation: process a request per session
     // =============================================================================================
     template<typename _Service>
-    uaf::Status Client::processRequest(
+    uaf::Status Client::processRequestPerSession(
             const typename _Service::Request&   request,
-            const uaf::Mask&                    mask,
+            const vector<ClientConnectionId>&   clientConnectionIds,
+            typename _Service::Result&          result)
+    {
+        uaf::Status ret;
+
+        // group the targets per session
+        map<ClientConnectionId, vector<size_t> > ranksPerSession;
+        for (size_t i = 0; i < request.targets.size(); i++)
+            ranksPerSession[clientConnectionIds[i]].push_back(i);
+
+        result.targets.resize(request.targets.size());
+
+        ret = statuscodes::Good;
+
+        for (map<ClientConnectionId, vector<size_t> >::const_iterator it = ranksPerSession.begin();
+             it != ranksPerSession.end();
+             ++it)
+        {
+            const vector<size_t>& ranks = it->second;
+
+            typename _Service::Request sessionRequest(
+                    0,
+                    it->first,
+                    request.serviceSettingsGiven   ? &request.serviceSettings   : NULL,
+                    request.translateSettingsGiven ? &request.translateSettings : NULL,
+                    request.sessionSettingsGiven   ? &request.sessionSettings   : NULL);
+
+            sessionRequest.targets.reserve(ranks.size());
+            for (size_t j = 0; j < ranks.size(); j++)
+                sessionRequest.targets.push_back(request.targets[ranks[j]]);
+
+            typename _Service::Result sessionResult;
+            uaf::Status sessionStatus = processRequest<_Service>(sessionRequest, sessionResult);
+
+            // merge the results in the order of the original request
+            for (size_t j = 0; j < ranks.size(); j++)
+            {
+                if (sessionStatus.isNotBad() && j < sessionResult.targets.size())
+                    result.targets[ranks[j]] = sessionResult.targets[j];
+                else
+                    result.targets[ranks[j]].status = sessionStatus;
+            }
+
+            result.requestHandle = sessionResult.requestHandle;
+
+            // the traces of the sessions are combined into the trace of the whole request
+            if (sessionResult.trace.isEnabled())
+            {
+                if (!result.trace.isEnabled())
+                    result.trace.enable(sessionResult.trace.service,
+                                        sessionResult.trace.requestHandle,
+                                        sessionResult.trace.threadId);
+                result.trace.spans.insert(result.trace.spans.end(),
+                                          sessionResult.trace.spans.begin(),
+                                          sessionResult.trace.spans.end());
+            }
+
+            if (sessionStatus.isBad())
+                ret = sessionStatus;
+        }
+
+        if (ret.isBad())
+            result.overallStatus = ret;
+        else
+            result.updateOverallStatus();
+
+        return ret;
+    }
+
+
+    // Private template function implementation: process a request owned by the client
+    // =============================================================================================
+    template<typename _Service>
+    uaf::Status Client::processOwnedRequest(
+            typename _Service::Request*         request,
             typename _Service::Result&          result)
     {
+        uaf::Status ret;
+
+        // assign the handle before sharing the request, since it is immutable afterwards
+        uaf::RequestHandle requestHandle = uaf::constants::REQUESTHANDLE_NOT_ASSIGNED;
+        ret = assignRequestHandle<_Service>(requestHandle, result);
+        request->requestHandle_ = requestHandle;
+
+        uaf::SharedConst<typename _Service::Request> sharedRequest(request);
+
+        if (ret.isGood())
+            ret = processRequest<_Service>(
+                    *sharedRequest,
+                    sharedRequest,
+                    uaf::Mask(sharedRequest->targets.size(), true),
+                    result);
+
+        return ret;
+    }
+
+
+    // Private template function implementation: process a masked request
+    // =============================================================================================
+    template<typename _Service>
+    uaf::Status Client::processRequest(
+            const typename _Service::Request&                       request,
+            const uaf::SharedConst<typename _Service::Request>&     sharedRequest,
+            const uaf::Mask&                                        mask,
+            typename _Service::Result&                              result)
+    {
+        typedef typename _Service::Request Request;
+
         // declare the return Status
         uaf::Status ret;
 
         logger_->debug("Processing the following %sRequest:", _Service::name().c_str());
-        logger_->debug(request.toString());
+        if (logger_->isDebugEnabled())
+            logger_->debug(request.toString());
 
         // resize the result
         result.targets.resize(request.targets.size());
 
-        // create a copy of the request (so we can assign a handle, resolve the targets, ...)
-        typename _Service::Request copiedRequest(request);
-
-        // get a new unique request handle if necessary,
-        // and update the copied request and result with it
-        if (request.requestHandle() == uaf::constants::REQUESTHANDLE_NOT_ASSIGNED)
-            ret = assignRequestHandle<_Service>(copiedRequest, result);
+        // get a new unique request handle if necessary, and update the result with it
+        // (the request itself is never modified, so the handle is kept beside it)
+        uaf::RequestHandle requestHandle = request.requestHandle();
+        if (requestHandle == uaf::constants::REQUESTHANDLE_NOT_ASSIGNED)
+        {
+            ret = assignRequestHandle<_Service>(requestHandle, result);
+        }
         else
+        {
+            result.requestHandle = requestHandle;
             ret = uaf::statuscodes::Good;
+        }
+
+        // trace the request if needed (if not, the timers below don't even read the clock)
+        // (a result that is reused must not keep the spans of an earlier request)
+        if (result.trace.isEnabled())
+            result.trace = uaf::RequestTrace();
+        if (database_->clientSettings.traceRequests)
+            result.trace.enable(
+                    _Service::name(), requestHandle, uaf::MetricsRegistry::currentThreadId());
+        uaf::RequestTrace* trace = result.trace.isEnabled() ? &result.trace : NULL;
+        uaf::TraceTimer processTimer(trace, "processRequest");
 
         // assign client handles if necessary
         // (this is only needed for CreateMonitoredDataRequests and CreateMonitoredEventsRequests)
         std::vector<uaf::ClientHandle> clientHandles;
-        bool assigned;
+        bool assigned = false;
         if (ret.isGood())
             ret = uaf::assignClientHandlesIfNeeded<_Service>(result, mask, database_, assigned, clientHandles);
 
-        // if no error occurred, store the copied request if needed
+        // if no error occurred, store the request if needed
         // (this is only needed for 'persistent' requests such as CreateMonitoredDataRequests)
-        if (ret.isGood())
+        // The store shares the request, so it is only copied if it wasn't shared already.
+        if (ret.isGood() && uaf::isPersistent<_Service>())
+        {
+            uaf::SharedConst<Request> storedRequest(sharedRequest);
+            if (storedRequest.isNull())
+            {
+                Request* copiedRequest = new Request(request);
+                copiedRequest->requestHandle_ = requestHandle;
+                storedRequest = uaf::SharedConst<Request>(copiedRequest);
+            }
+
             ret = uaf::storeIfNeeded<_Service>(
-                    copiedRequest,
+                    storedRequest,
                     result,
                     result.getBadTargetsMask(),
                     database_);
+        }
 
-        // if no error occurred, resolve the unmasked targets of the copied request
+        // if no error occurred, resolve the unmasked targets of the request
+        // (the resolved addresses are kept beside the request)
+        uaf::ResolvedItems resolvedItems;
         if (ret.isGood())
-            ret = resolver_->resolve<_Service>(copiedRequest, mask, result);
+        {
+            uaf::TraceTimer resolveTimer(trace, "resolve");
+            ret = resolver_->resolve<_Service>(request, mask, result, resolvedItems);
+        }
 
         // if no error occurred, mask out the unresolved addresses and invoke the service request
         if (ret.isGood())
         {
+            uaf::TraceTimer invokeTimer(trace, "invokeRequest");
             uaf::Mask resolvedMask = mask && result.getGoodTargetsMask();
-            ret = sessionFactory_->invokeRequest<_Service>(copiedRequest, resolvedMask, result);
+            ret = sessionFactory_->invokeRequest<_Service>(
+                    request,
+                    requestHandle,
+                    resolvedItems,
+                    resolvedMask,
+                    result);
         }
 
         // finally, update the overall status
@@ -1067,11 +1764,19 @@ namespace uaf
         if (ret.isGood())
             ret = updateResultIfNeeded<_Service>(result, mask, database_);
 
+        // pass the trace to the sinks (before the result is logged, so that it includes the trace)
+        if (trace != NULL)
+        {
+            processTimer.stop();
+            traceFinished(*trace);
+        }
+
         // log the result, if good
         if (ret.isGood())
         {
             logger_->debug("%sResult %d:", _Service::name().c_str(), result.requestHandle);
-            logger_->debug(result.toString());
+            if (logger_->isDebugEnabled())
+                logger_->debug(result.toString());
         }
 
         // if client handles were assigned, copy them to the diagnostics of the Status object
@@ -26,6 +26,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 // SDK
 #include "uabase/uathread.h"
 #include "uabase/uamutex.h"
@@ -33,6 +34,7 @@
 // UAF
 #include "uaf/util/logger.h"
 #include "uaf/util/mask.h"
+#include "uaf/util/sharedconst.h"
 #include "uaf/util/logginginterface.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/settings/clientsettings.h"
@@ -40,6 +42,13 @@
 #include "uaf/client/resolution/resolver.h"
 #include "uaf/client/sessions/sessionfactory.h"
 #include "uaf/client/clientservices.h"
+#include "uaf/client/settings/crawlsettings.h"
+#include "uaf/client/crawling/crawlstatistics.h"
+#include "uaf/client/subscriptions/notificationqueue.h"
+#include "uaf/client/subscriptions/notificationqueuestatistics.h"
+#include "uaf/client/metrics/tracesink.h"
+#include "uaf/client/metrics/chrometracewriter.h"
+#include "uaf/client/transport/sessiontransportfactory.h"
 
 
 
@@ -252,6 +261,86 @@ namespace uaf
                 uaf::AsyncWriteResult&                              result);
 
 
+        /**
+         * Register a number of nodes (by invoking the RegisterNodes service), so that they can
+         * be read and written more efficiently.
+         *
+         * The addresses are resolved once, and the servers may assign an alias (typically a
+         * numeric NodeId) to each of the nodes. The read() and write() methods that accept the
+         * returned handle will then use these aliases. The nodes are registered again
+         * automatically when a session is reconnected, and they are unregistered when the
+         * handle is released by unregisterNodes() or when the session is disconnected.
+         *
+         * @param addresses         Addresses of the nodes to register.
+         * @param serviceSettings   The service settings to be used.
+         *                          Assign to NULL to use the defaultRegisterNodesSettings
+         *                          as configurable by the ClientSettings.
+         * @param sessionSettings   Session settings, or NULL to use the ClientSettings.
+         * @param handle            Output parameter: the handle of the registered nodes.
+         * @param statuses          Output parameter: the status of each address.
+         * @return                  Good if all nodes could be registered (only then the handle
+         *                          is assigned), bad if not.
+         */
+        uaf::Status registerNodes(
+                const std::vector<uaf::Address>&    addresses,
+                const uaf::ServiceSettings*         serviceSettings,
+                const uaf::SessionSettings*         sessionSettings,
+                uaf::RegisteredNodesHandle&         handle,
+                std::vector<uaf::Status>&           statuses);
+
+
+        /**
+         * Release the nodes that were registered by registerNodes() (by invoking the
+         * UnregisterNodes service for the nodes that are not registered by another handle).
+         *
+         * @param handle            The handle of the registered nodes.
+         * @param serviceSettings   The service settings to be used.
+         *                          Assign to NULL to use the defaultRegisterNodesSettings
+         *                          as configurable by the ClientSettings.
+         * @return                  Good if the nodes could be unregistered,
+         *                          UnknownRegisteredNodesHandleError if the handle is unknown.
+         */
+        uaf::Status unregisterNodes(
+                uaf::RegisteredNodesHandle          handle,
+                const uaf::ServiceSettings*         serviceSettings);
+
+
+        /**
+         * Read an attribute of registered nodes synchronously.
+         *
+         * @param handle            The handle of the registered nodes, as returned by
+         *                          registerNodes().
+         * @param attributeId       The attribute to be read (e.g. Value or DisplayName).
+         * @param serviceSettings   Read settings, or NULL to use the ClientSettings.
+         * @param result            Result of the request (one target per registered node).
+         * @return                  Client-side status.
+         */
+        uaf::Status read(
+                uaf::RegisteredNodesHandle                          handle,
+                uaf::attributeids::AttributeId                      attributeId,
+                const uaf::ReadSettings*                            serviceSettings,
+                uaf::ReadResult&                                    result);
+
+
+        /**
+         * Write an attribute of registered nodes synchronously.
+         *
+         * @param handle            The handle of the registered nodes, as returned by
+         *                          registerNodes().
+         * @param data              Data values that should be written (one per registered node).
+         * @param attributeId       Attribute id that should be written for all nodes.
+         * @param serviceSettings   Write settings, or NULL to use the ClientSettings.
+         * @param result            Result of the request (one target per registered node).
+         * @return                  Client-side status.
+         */
+        uaf::Status write(
+                uaf::RegisteredNodesHandle                          handle,
+                const std::vector<uaf::Variant>&                    data,
+                uaf::attributeids::AttributeId                      attributeId,
+                const uaf::WriteSettings*                           serviceSettings,
+                uaf::WriteResult&                                   result);
+
+
         /**
          * Call a single method synchronously.
          *
@@ -492,6 +581,31 @@ namespace uaf
                 uaf::BrowseNextResult&                              result);
 
 
+        /**
+         * Crawl the address space in a breadth-first way, starting from the given nodes.
+         *
+         * The nodes are browsed in batches (of settings.maxTargetsPerRequest nodes per Browse
+         * request), and multiple Browse requests (settings.maxRequestsInFlight) are processed
+         * at the same time. Each node is browsed only once, even if it's referenced by many
+         * other nodes. The references are not accumulated in memory, but they are streamed to
+         * the referencesCrawled() callback (see uaf::ClientInterface) as soon as they arrive.
+         *
+         * This method blocks until the whole (reachable part of the) address space has been
+         * crawled, or until one of the limits of the settings has been reached.
+         *
+         * @param startAddresses    The addresses of the nodes to start crawling from.
+         * @param settings          The crawl settings.
+         *                          Assign to NULL to use the default CrawlSettings.
+         * @param statistics        Output parameter: some statistics about the crawl.
+         * @return                  Good if the address space could be crawled (individual nodes
+         *                          may still have failed, see statistics.nodesFailed), bad if not.
+         */
+        uaf::Status crawl(
+                const std::vector<uaf::Address>&                    startAddresses,
+                const uaf::CrawlSettings*                           settings,
+                uaf::CrawlStatistics&                               statistics);
+
+
         /**
          * Start to monitor data.
          *
@@ -708,6 +822,38 @@ namespace uaf
                 const uaf::CreateMonitoredEventsRequest&   request,
                 uaf::CreateMonitoredEventsResult&          result);
 
+#if !defined(SWIG) && __cplusplus >= 201103L
+
+        /**
+         * Process a synchronous "create monitored data" request that is moved into the client.
+         *
+         * Since the UAF keeps these requests (to re-create the monitored items after failures),
+         * moving them avoids one copy of the request.
+         *
+         * @param request   The request (moved into the client).
+         * @param result    The result.
+         * @return          The client-side status.
+         */
+        uaf::Status processRequest(
+                uaf::CreateMonitoredDataRequest&&      request,
+                uaf::CreateMonitoredDataResult&        result);
+
+        /**
+         * Process a synchronous "create monitored events" request that is moved into the client.
+         *
+         * Since the UAF keeps these requests (to re-create the monitored items after failures),
+         * moving them avoids one copy of the request.
+         *
+         * @param request   The request (moved into the client).
+         * @param result    The result.
+         * @return          The client-side status.
+         */
+        uaf::Status processRequest(
+                uaf::CreateMonitoredEventsRequest&&        request,
+                uaf::CreateMonitoredEventsResult&          result);
+
+#endif
+
         /**
          * Process a synchronous HistoryReadRawModified request.
          *
@@ -743,6 +889,26 @@ namespace uaf
         		uaf::StructureDefinition& definition);
 
 
+        /**
+         * Get the compiled definition of a structured datatype, which can be used to decode
+         * (many) ExtensionObjects of this datatype into flat records, and vice versa.
+         *
+         * The definitions are cached per server and datatype, so they are only fetched from
+         * the server (and compiled) once.
+         *
+         * @param dataTypeId    The NodeId of the structured datatype.
+         * @param serverUri     The URI of the server that exposes the datatype, or an empty
+         *                      string to accept the definition of any connected server.
+         * @param codec         Output parameter, the compiled definition (if found).
+         * @return              DefinitionNotFoundError if no definition was found,
+         *                      Good otherwise.
+         */
+        uaf::Status structureCodec(
+                const uaf::NodeId&      dataTypeId,
+                const std::string&      serverUri,
+                uaf::StructureCodec&    codec);
+
+
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
          *  @name ManualConnection
@@ -986,6 +1152,144 @@ namespace uaf
                  uaf::MonitoredItemInformation&    monitoredItemInformation);
 
 
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name DatabaseFootprint
+         *  Get information about the memory used by the client.
+         */
+        ///@{
+
+
+        /**
+         * Get the memory footprint of the client database, per store: the persistent requests,
+         * the caches and the bookkeeping of the handles.
+         *
+         * @return  The number of entries and the (approximate) number of bytes per store.
+         */
+        uaf::DatabaseFootprint databaseFootprint();
+
+
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name NotificationQueue
+         *  Decouple the notification callbacks from the threads that receive the notifications.
+         */
+        ///@{
+
+
+        /**
+         * Get the statistics of the notification queue.
+         *
+         * The queue is configured by the notificationQueueCapacity,
+         * notificationQueueOverflowPolicy and notificationDeliveryThreads of the ClientSettings.
+         * As long as the capacity is 0 (the default), there is no queue and all counters stay 0.
+         *
+         * @return  The current and maximum depth of the queue, and the number of queued,
+         *          delivered, dropped and coalesced notifications.
+         */
+        uaf::NotificationQueueStatistics notificationQueueStatistics();
+
+
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name Metrics
+         *  Measure the latency and the throughput of the client.
+         */
+        ///@{
+
+
+        /**
+         * Get the metrics of the client.
+         *
+         * The metrics are counted all the time, and merged at the time of this call: the latency
+         * histograms per server and service, the number of invocations in flight, the connection
+         * losses and reconnections per server, the notifications per subscription, the depth of
+         * the notification queue and the hit ratios of the caches.
+         *
+         * See also ClientSettings::metricsIntervalSec and ClientSettings::metricsFileName to
+         * export the metrics periodically.
+         *
+         * @return  The metrics.
+         */
+        uaf::Metrics metrics();
+
+
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name Tracing
+         *  Trace the time spent in the stages of the processing of the requests.
+         */
+        ///@{
+
+
+#ifndef SWIG
+        /**
+         * Set a sink that receives the traces of the requests.
+         *
+         * The requests are only traced if ClientSettings::traceRequests is true. The traces are
+         * passed to this sink, and to the trace file (see ClientSettings::traceFileName) if any.
+         * Each processed request also holds its own trace (see the "trace" of the results).
+         *
+         * @param sink  The sink (owned by the caller, who must keep it alive until another sink
+         *              is set, or until the client is destroyed), or NULL to remove the sink.
+         */
+        void setTraceSink(uaf::TraceSink* sink);
+#endif
+
+
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name Transport
+         *  Invoke the services of an in-process server instead of real servers.
+         */
+        ///@{
+
+
+#ifndef SWIG
+        /**
+         * Set the factory of the transports of the sessions that are created from now on.
+         *
+         * By default (or when NULL is set), the services are invoked on real servers through the
+         * SDK. When a uaf::LoopbackServer is set, the server URI and discovery URL of the server
+         * are known without discovery, and all new sessions to it invoke the services in memory,
+         * so that the whole client can be tested and benchmarked without any network. Sessions
+         * that were created before keep their transport.
+         *
+         * @param transportFactory  The factory (owned by the caller, who must keep it alive until
+         *                          the client is destroyed), or NULL.
+         */
+        void setSessionTransportFactory(uaf::SessionTransportFactory* transportFactory);
+#endif
+
+
+#ifndef SWIG
+        // make the std::vector overloads of the callbacks visible next to the overrides below
+        using uaf::ClientInterface::dataChangesReceived;
+        using uaf::ClientInterface::eventsReceived;
+
+
+        /**
+         * Pass the received data change notifications to the notification queue, which delivers
+         * them (immediately, or later by a delivery thread) to
+         * dataChangesReceived(std::vector<uaf::DataChangeNotification>).
+         *
+         * @param notifications Received data change notifications.
+         */
+        virtual void dataChangesReceived(
+                const uaf::ConstSpan<uaf::DataChangeNotification>& notifications);
+
+
+        /**
+         * Pass the received event notifications to the notification queue, which delivers
+         * them (immediately, or later by a delivery thread) to
+         * eventsReceived(std::vector<uaf::EventNotification>).
+         *
+         * @param notifications Received event notifications.
+         */
+        virtual void eventsReceived(const uaf::ConstSpan<uaf::EventNotification>& notifications);
+#endif
+
+
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
          *  @name ChangeSubscriptions
@@ -1036,6 +1340,55 @@ namespace uaf
                 std::vector<uaf::Status>&               results);
 
 
+        /**
+         * Delete the specified monitored items.
+         *
+         * The monitored items are deleted on the server side, and they are removed from the
+         * persistent requests that created them (so they won't be re-created anymore, not even
+         * after a reconnection). Their ClientHandles are released.
+         *
+         * Monitored items of which the session is disconnected at the moment are only removed
+         * from the persistent requests.
+         *
+         * @param clientHandles     The ClientHandles of the monitored items to be deleted.
+         * @param serviceSettings   The service settings to be used.
+         *                          Assign to NULL to use the defaultDeleteMonitoredItemsSettings
+         *                          as configurable by the ClientSettings.
+         * @param results           A vector of statuses (one result for each ClientHandle).
+         * @return                  The immediate result of the service call.
+         */
+        uaf::Status deleteMonitoredItems(
+                const std::vector<uaf::ClientHandle>&   clientHandles,
+                const uaf::ServiceSettings*             serviceSettings,
+                std::vector<uaf::Status>&               results);
+
+
+        /**
+         * Modify the specified monitored items (e.g. to change their sampling interval), without
+         * having to delete and re-create them.
+         *
+         * The monitored items are modified on the server side (with one service call per
+         * subscription), and the persistent requests that created them are updated, so they will
+         * be re-created with the modified settings (e.g. after a reconnection).
+         *
+         * The settings must be of the same kind (data or event) as the monitored items. If their
+         * filter is NULL, the current filter of the monitored items is kept.
+         *
+         * @param clientHandles     The ClientHandles of the monitored items to be modified.
+         * @param settings          The new settings of the monitored items.
+         * @param serviceSettings   The service settings to be used.
+         *                          Assign to NULL to use the defaultModifyMonitoredItemsSettings
+         *                          as configurable by the ClientSettings.
+         * @param results           A vector of statuses (one result for each ClientHandle).
+         * @return                  The immediate result of the service call.
+         */
+        uaf::Status modifyMonitoredItems(
+                const std::vector<uaf::ClientHandle>&   clientHandles,
+                const uaf::MonitoredItemSettings&       settings,
+                const uaf::ServiceSettings*             serviceSettings,
+                std::vector<uaf::Status>&               results);
+
+
     private:
 
         DISALLOW_COPY_AND_ASSIGN(Client);
@@ -1055,6 +1408,9 @@ namespace uaf
         /** The shared database of the client. */
         uaf::Database* database_;
 
+        /** The queue that delivers the notifications to the callbacks. */
+        uaf::NotificationQueue* notificationQueue_;
+
         /** The flag to finish the run() method of the thread during destruction of the client. */
         bool doFinishThread_;
 
@@ -1064,6 +1420,34 @@ namespace uaf
         /** The mutex to lock when the currentRequestHandle_ is read or manipulated. */
         UaMutex requestHandleMutex_;
 
+        /** The resolved nodes of a handle, and the sessions that registered them. */
+        struct RegisteredNodes
+        {
+            std::vector<uaf::ExpandedNodeId>        expandedNodeIds;
+            std::vector<uaf::ClientConnectionId>    clientConnectionIds;
+            bool                                    sessionSettingsGiven;
+            uaf::SessionSettings                    sessionSettings;
+        };
+        typedef std::map<uaf::RegisteredNodesHandle, RegisteredNodes> RegisteredNodesMap;
+
+        /** The registered nodes (only to be used when registeredNodesMutex_ is locked). */
+        RegisteredNodesMap registeredNodes_;
+
+        /** The last assigned RegisteredNodesHandle. */
+        uaf::RegisteredNodesHandle currentRegisteredNodesHandle_;
+
+        /** The mutex to lock when the registered nodes are read or manipulated. */
+        UaMutex registeredNodesMutex_;
+
+        /** The sink of the traces, as set by the user (not owned by the client). */
+        uaf::TraceSink* traceSink_;
+
+        /** The writer of the trace file, if a trace file is configured. */
+        uaf::ChromeTraceWriter* traceWriter_;
+
+        /** The mutex to lock when the trace sinks are used or changed. */
+        UaMutex traceSinkMutex_;
+
         /**
          * Run method of the thread.
          */
@@ -1076,6 +1460,51 @@ namespace uaf
         void construct();
 
 
+        /**
+         * Load the warm-start snapshot (see uaf::ClientSettings::snapshotFileName) into the
+         * caches and the discoverer.
+         *
+         * @return  True if the snapshot holds the discovery results of the current discovery
+         *          URLs (so that the servers don't need to be discovered right away).
+         */
+        bool loadSnapshot();
+
+
+        /**
+         * Write the warm-start snapshot, if a snapshot file is configured.
+         */
+        void writeSnapshot();
+
+
+        /**
+         * Export the metrics to the metrics file (if any) and to the metricsReceived() callback.
+         */
+        void exportMetrics();
+
+
+        /**
+         * Pass the trace of a request to the trace file (if any) and to the trace sink (if any).
+         *
+         * @param trace The trace of the request.
+         */
+        void traceFinished(const uaf::RequestTrace& trace);
+
+
+        /**
+         * Get the registered nodes of a handle, and the aliases that the servers assigned to them.
+         *
+         * @param handle            The handle of the registered nodes.
+         * @param registeredNodes   Output parameter: the registered nodes.
+         * @param aliases           Output parameter: the aliases (one for each node).
+         * @return                  Good if the handle is known,
+         *                          UnknownRegisteredNodesHandleError if not.
+         */
+        uaf::Status registeredNodeIds(
+                uaf::RegisteredNodesHandle          handle,
+                RegisteredNodes&                    registeredNodes,
+                std::vector<uaf::ExpandedNodeId>&   aliases);
+
+
 
 #ifndef SWIG /* The private template functions below do not need to be seen by SWIG. */
 
@@ -1097,14 +1526,14 @@ namespace uaf
          * unlimited (even at 1 million requests per second, the client will be able to assign
          * unique handles for more than 500000 years...).
          *
-         * @tparam _Service The Service type, as defined in uaf/client/services/services.h.
-         * @param request   The request to get a new UAF handle.
-         * @param result    The result to get a new UAF handle.
-         * @return          Good if a new handle was assigned, UnexpectedError if not.
+         * @tparam _Service         The Service type, as defined in uaf/client/services/services.h.
+         * @param requestHandle     Output parameter: the new UAF handle of the request.
+         * @param result            The result to get the new UAF handle.
+         * @return                  Good if a new handle was assigned, UnexpectedError if not.
          */
         template <typename _Service>
         uaf::Status assignRequestHandle(
-                typename _Service::Request& request,
+                uaf::RequestHandle&         requestHandle,
                 typename _Service::Result&  result);
         // Private template functions can be implemented in the CPP file (keeps the header clean!)
 
@@ -1149,19 +1578,64 @@ namespace uaf
          *
          * Masked-out targets (i.e. targets with mask.isUnset(rank)==True) will not be processed!
          *
+         * The request is never modified nor copied: the handle and the resolved addresses are
+         * kept beside it. Only persistent requests are copied (once), if they were not shared
+         * already, so that the request store can keep them.
+         *
+         * @tparam _Service         The Service type, as defined in uaf/client/services/services.h.
+         * @param request           The request to be processed.
+         * @param sharedRequest     The same request, if it is already shared (e.g. because it
+         *                          was stored before), or a null SharedConst if not.
+         * @param mask              The mask, specifying the targets that need to be processed.
+         * @param result            The result to be updated.
+         * @return                  The client-side status.
+         */
+        template<typename _Service>
+        uaf::Status processRequest(
+                const typename _Service::Request&                       request,
+                const uaf::SharedConst<typename _Service::Request>&     sharedRequest,
+                const uaf::Mask&                                        mask,
+                typename _Service::Result&                              result);
+        // Private template functions can be implemented in the CPP file (keeps the header clean!)
+
+
+        /**
+         * Private templated member function to process a request that is moved into the client.
+         *
          * @tparam _Service The Service type, as defined in uaf/client/services/services.h.
-         * @param request   The request to be processed.
-         * @param mask      The mask, specifying the targets that need to be processed.
+         * @param request   The request to be processed (the client takes ownership of it).
          * @param result    The result to be updated.
          * @return          The client-side status.
          */
         template<typename _Service>
-        uaf::Status processRequest(
-                const typename _Service::Request&   request,
-                const uaf::Mask&                    mask,
+        uaf::Status processOwnedRequest(
+                typename _Service::Request*         request,
                 typename _Service::Result&          result);
         // Private template functions can be implemented in the CPP file (keeps the header clean!)
 
+
+        /**
+         * Private templated member function to process a request of which the targets must be
+         * invoked by specific sessions (e.g. because these sessions registered the nodes).
+         *
+         * The targets are split into one request per session, and the results are merged again.
+         *
+         * @tparam _Service             The Service type, as defined in
+         *                              uaf/client/services/services.h.
+         * @param request               The request to be processed (its ClientConnectionId is
+         *                              ignored).
+         * @param clientConnectionIds   The ClientConnectionId for each target, or
+         *                              CLIENTHANDLE_NOT_ASSIGNED if any session may be used.
+         * @param result                The result to be updated.
+         * @return                      The client-side status.
+         */
+        template<typename _Service>
+        uaf::Status processRequestPerSession(
+                const typename _Service::Request&           request,
+                const std::vector<uaf::ClientConnectionId>& clientConnectionIds,
+                typename _Service::Result&                  result);
+        // Private template functions can be implemented in the CPP file (keeps the header clean!)
+
 #endif  /* SWIG (the section above is not visible by the SWIG preprocessor) */
 
         ///@}
@@ -8,6 +8,11 @@
  * @ingroup Client
  * The client/configs group bundles all code related to configs on the client side.
  *
+ * @defgroup ClientCrawling client/crawling
+ * @ingroup Client
+ * The client/crawling group bundles all code related to crawling the address space by the client
+ * side.
+ *
  * @defgroup ClientDatabase client/database
  * @ingroup Client
  * The client/database group bundles all code related to the shared internal database of the
@@ -25,6 +30,11 @@
  * @ingroup Client
  * The client/invocations group bundles all code related to service invocations by the client side.
  *
+ * @defgroup ClientMetrics client/metrics
+ * @ingroup Client
+ * The client/metrics group bundles all code related to the metrics and the tracing of the client
+ * side.
+ *
  * @defgroup ClientRequests client/requests
  * @ingroup Client
  * The client/invocations group bundles all code related to service requests by the client side.
@@ -49,5 +59,10 @@
  * @ingroup Client
  * The client/subscriptions group bundles all code related to subscription management at the client side.
  *
+ * @defgroup ClientTransport client/transport
+ * @ingroup Client
+ * The client/transport group bundles all code related to the transport of the services of the
+ * client side (the SDK sessions, or an in-process loopback server).
+ *
  */
 
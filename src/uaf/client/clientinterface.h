@@ -26,9 +26,13 @@
 #include <vector>
 // SDK
 // UAF
+#include "uaf/util/constspan.h"
 #include "uaf/util/pkicertificate.h"
 #include "uaf/util/sdkstatus.h"
+#include "uaf/util/address.h"
+#include "uaf/util/referencedescription.h"
 #include "uaf/client/results/results.h"
+#include "uaf/client/metrics/metrics.h"
 #include "uaf/client/sessions/sessioninformation.h"
 #include "uaf/client/subscriptions/datachangenotification.h"
 #include "uaf/client/subscriptions/eventnotification.h"
@@ -75,6 +79,10 @@ namespace uaf
         /**
          * Override this method to handle missing notifications.
          *
+         * If ClientSettings::republishMissingNotifications is true (the default), the client first
+         * tries to recover the missing notifications, and this method is only called for the
+         * notifications that could not be recovered.
+         *
          * @param info                      Information about the subscription that has missing
          *                                  notifications.
          * @param previousSequenceNumber    The sequence number before the notifications were lost.
@@ -102,6 +110,17 @@ namespace uaf
         virtual void writeComplete(const uaf::WriteResult& result) {}
 
 
+        /**
+         * Override this method to receive the metrics of the client periodically.
+         *
+         * This method is called by the internal thread of the client, every
+         * ClientSettings::metricsIntervalSec seconds (if this interval is larger than 0.0).
+         *
+         * @param metrics   The metrics, as returned by Client::metrics().
+         */
+        virtual void metricsReceived(const uaf::Metrics& metrics) {}
+
+
         /**
          * Override this method to handle the results of asynchronous method call requests.
          *
@@ -117,6 +136,21 @@ namespace uaf
          */
         virtual void eventsReceived(std::vector<uaf::EventNotification> notifications) {}
 
+#ifndef SWIG
+
+        /**
+         * Override this method to handle events without copying them.
+         *
+         * The notifications are only valid during the call. By default, they are copied into a
+         * vector and forwarded to eventsReceived(std::vector<uaf::EventNotification>).
+         *
+         * @param notifications Received event notifications.
+         */
+        virtual void eventsReceived(const uaf::ConstSpan<uaf::EventNotification>& notifications)
+        { eventsReceived(notifications.toVector()); }
+
+#endif
+
 
         /**
          * Override this method to handle data changes.
@@ -125,6 +159,22 @@ namespace uaf
          */
         virtual void dataChangesReceived(std::vector<uaf::DataChangeNotification> notifications) {}
 
+#ifndef SWIG
+
+        /**
+         * Override this method to handle data changes without copying them.
+         *
+         * The notifications are only valid during the call. By default, they are copied into a
+         * vector and forwarded to dataChangesReceived(std::vector<uaf::DataChangeNotification>).
+         *
+         * @param notifications Received data change notifications.
+         */
+        virtual void dataChangesReceived(
+                const uaf::ConstSpan<uaf::DataChangeNotification>& notifications)
+        { dataChangesReceived(notifications.toVector()); }
+
+#endif
+
 
         /**
          * Override this method to handle keep alive notifications.
@@ -134,6 +184,23 @@ namespace uaf
         virtual void keepAliveReceived(uaf::KeepAliveNotification notification) {}
 
 
+        /**
+         * Override this method to handle the references that are found while crawling the
+         * address space (see uaf::Client::crawl).
+         *
+         * This method is called once for each node that was browsed successfully, always from
+         * the thread that called uaf::Client::crawl.
+         *
+         * @param sourceAddress The address of the node that was browsed.
+         * @param depth         The depth of the browsed node (0 for the start nodes).
+         * @param references    The references that were found.
+         */
+        virtual void referencesCrawled(
+                const uaf::Address&                             sourceAddress,
+                uint32_t                                        depth,
+                const std::vector<uaf::ReferenceDescription>&   references) {}
+
+
         /**
          * Override this method to trust or reject or the server certificate during connection.
          *
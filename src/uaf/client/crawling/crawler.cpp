@@ -0,0 +1,332 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/crawling/crawler.h"
+#include "uaf/client/client.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::deque;
+    using std::map;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    Crawler::Crawler(
+            LoggerFactory*      loggerFactory,
+            Client*             client,
+            ClientInterface*    clientInterface)
+    : client_(client),
+      clientInterface_(clientInterface),
+      scheduled_(0),
+      doStop_(false)
+    {
+        logger_ = new Logger(loggerFactory, "Crawler");
+        logger_->debug("The crawler has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    Crawler::~Crawler()
+    {
+        logger_->debug("Destructing the crawler");
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Crawl the address space
+    // =============================================================================================
+    Status Crawler::crawl(
+            const vector<Address>&  startAddresses,
+            const CrawlSettings&    settings,
+            CrawlStatistics&        statistics)
+    {
+        Status ret;
+
+        statistics = CrawlStatistics();
+
+        if (settings.maxTargetsPerRequest == 0)
+            ret = InvalidRequestError("maxTargetsPerRequest must be at least 1");
+        else if (settings.maxRequestsInFlight == 0)
+            ret = InvalidRequestError("maxRequestsInFlight must be at least 1");
+        else
+            ret = statuscodes::Good;
+
+        if (ret.isBad())
+        {
+            logger_->error(ret);
+            return ret;
+        }
+
+        logger_->info("Crawling from %d start nodes (%d browse requests in flight, %d targets each)",
+                      startAddresses.size(),
+                      settings.maxRequestsInFlight,
+                      settings.maxTargetsPerRequest);
+
+        // fill the frontier with the start nodes
+        for (vector<Address>::const_iterator it = startAddresses.begin();
+             it != startAddresses.end();
+             ++it)
+        {
+            if (settings.maxNodes != 0 && scheduled_ >= settings.maxNodes)
+            {
+                statistics.truncated = true;
+                break;
+            }
+
+            // relative paths can only be recognized after they have been resolved, so they
+            // are not registered as "visited" here
+            if (it->isExpandedNodeId() && !visited_.insert(it->getExpandedNodeId()))
+            {
+                statistics.duplicatesSkipped++;
+                continue;
+            }
+
+            frontier_.push_back(FrontierEntry(*it, 0));
+            scheduled_++;
+        }
+
+        // start the workers
+        vector<Worker*> workers;
+        workers.reserve(settings.maxRequestsInFlight);
+        for (uint32_t i = 0; i < settings.maxRequestsInFlight; i++)
+        {
+            workers.push_back(new Worker(this));
+            workers.back()->startWorking();
+        }
+
+        // keep the workers busy until the frontier is exhausted
+        uint32_t inFlight = 0;
+
+        while (true)
+        {
+            while (inFlight < settings.maxRequestsInFlight && !frontier_.empty())
+            {
+                Batch* batch = createBatch(settings);
+                {
+                    UaMutexLocker locker(&queueMutex_);
+                    pending_.push_back(batch);
+                }
+                pendingSemaphore_.post(1);
+                inFlight++;
+                statistics.browseRequests++;
+            }
+
+            if (inFlight == 0)
+                break;
+
+            completedSemaphore_.wait();
+
+            Batch* batch = 0;
+            {
+                UaMutexLocker locker(&queueMutex_);
+                batch = completed_.front();
+                completed_.pop_front();
+            }
+            inFlight--;
+
+            processBatch(batch, settings, statistics);
+            delete batch;
+        }
+
+        // stop the workers
+        {
+            UaMutexLocker locker(&queueMutex_);
+            doStop_ = true;
+        }
+        pendingSemaphore_.post(settings.maxRequestsInFlight);
+
+        for (vector<Worker*>::iterator it = workers.begin(); it != workers.end(); ++it)
+        {
+            (*it)->waitUntilFinished();
+            delete *it;
+        }
+
+        logger_->info("Crawling finished: %d nodes browsed (%d failed), %d references received, "
+                      "%d duplicates skipped, %d browse requests",
+                      statistics.nodesBrowsed,
+                      statistics.nodesFailed,
+                      statistics.referencesReceived,
+                      statistics.duplicatesSkipped,
+                      statistics.browseRequests);
+
+        return ret;
+    }
+
+
+    // Process batches (executed by the worker threads)
+    // =============================================================================================
+    void Crawler::work()
+    {
+        while (true)
+        {
+            pendingSemaphore_.wait();
+
+            Batch* batch = 0;
+            {
+                UaMutexLocker locker(&queueMutex_);
+                if (doStop_)
+                    return;
+                batch = pending_.front();
+                pending_.pop_front();
+            }
+
+            // this call blocks until the server has answered (or until the call timed out)
+            batch->status = client_->processRequest(batch->request, batch->result);
+
+            {
+                UaMutexLocker locker(&queueMutex_);
+                completed_.push_back(batch);
+            }
+            completedSemaphore_.post(1);
+        }
+    }
+
+
+    // Create a new batch
+    // =============================================================================================
+    Crawler::Batch* Crawler::createBatch(const CrawlSettings& settings)
+    {
+        Batch* batch = new Batch;
+
+        batch->request.serviceSettingsGiven = true;
+        batch->request.serviceSettings      = settings.browseSettings;
+
+        size_t noOfTargets = std::min(size_t(settings.maxTargetsPerRequest), frontier_.size());
+
+        batch->request.targets.reserve(noOfTargets);
+        batch->depths.reserve(noOfTargets);
+
+        for (size_t i = 0; i < noOfTargets; i++)
+        {
+            BrowseRequestTarget target(frontier_.front().address);
+            target.browseDirection  = settings.browseDirection;
+            target.referenceTypeId  = settings.referenceTypeId;
+            target.includeSubtypes  = settings.includeSubtypes;
+            target.nodeClassMask    = settings.nodeClassMask;
+
+            batch->request.targets.push_back(target);
+            batch->depths.push_back(frontier_.front().depth);
+
+            frontier_.pop_front();
+        }
+
+        return batch;
+    }
+
+
+    // Process a batch
+    // =============================================================================================
+    void Crawler::processBatch(
+            Batch*                  batch,
+            const CrawlSettings&    settings,
+            CrawlStatistics&        statistics)
+    {
+        vector<BrowseRequestTarget>& requestTargets = batch->request.targets;
+        vector<BrowseResultTarget>&  resultTargets  = batch->result.targets;
+
+        if (batch->status.isBad())
+            logger_->warning("Browse request failed: %s", batch->status.toString().c_str());
+
+        for (size_t i = 0; i < requestTargets.size(); i++)
+        {
+            uint32_t depth = batch->depths[i];
+
+            if (i >= resultTargets.size() || resultTargets[i].status.isBad())
+            {
+                statistics.nodesFailed++;
+                continue;
+            }
+
+            BrowseResultTarget& resultTarget = resultTargets[i];
+
+            statistics.nodesBrowsed++;
+            statistics.referencesReceived += uint32_t(resultTarget.references.size());
+            if (depth > statistics.maxDepthReached)
+                statistics.maxDepthReached = depth;
+
+            // stream the references
+            if (clientInterface_ != 0)
+                clientInterface_->referencesCrawled(
+                        requestTargets[i].address,
+                        depth,
+                        resultTarget.references);
+
+            // don't extend the frontier beyond the maximum depth
+            if (settings.maxDepth != 0 && depth >= settings.maxDepth)
+                continue;
+
+            for (vector<ReferenceDescription>::const_iterator it = resultTarget.references.begin();
+                 it != resultTarget.references.end();
+                 ++it)
+            {
+                ExpandedNodeId child = it->nodeId;
+
+                // references to local nodes may come without server URI
+                if (!child.hasServerUri())
+                    child.setServerUri(serverUriOf(resultTarget.clientConnectionId));
+
+                if (!visited_.insert(child))
+                {
+                    statistics.duplicatesSkipped++;
+                    continue;
+                }
+
+                if (settings.maxNodes != 0 && scheduled_ >= settings.maxNodes)
+                {
+                    statistics.truncated = true;
+                    continue;
+                }
+
+                frontier_.push_back(FrontierEntry(Address(child), depth + 1));
+                scheduled_++;
+            }
+        }
+    }
+
+
+    // Get the server URI of a session
+    // =============================================================================================
+    string Crawler::serverUriOf(ClientConnectionId clientConnectionId)
+    {
+        map<ClientConnectionId, string>::const_iterator it = serverUris_.find(clientConnectionId);
+
+        if (it != serverUris_.end())
+            return it->second;
+
+        string serverUri;
+        SessionInformation info;
+        if (client_->sessionInformation(clientConnectionId, info).isGood())
+            serverUri = info.serverUri;
+
+        serverUris_[clientConnectionId] = serverUri;
+        return serverUri;
+    }
+
+}
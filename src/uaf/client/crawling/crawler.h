@@ -0,0 +1,228 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CRAWLER_H_
+#define UAF_CRAWLER_H_
+
+
+
+// STD
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <map>
+#include <string>
+// SDK
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/logger.h"
+#include "uaf/util/status.h"
+#include "uaf/util/address.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/clientinterface.h"
+#include "uaf/client/requests/requests.h"
+#include "uaf/client/results/results.h"
+#include "uaf/client/settings/crawlsettings.h"
+#include "uaf/client/crawling/crawlstatistics.h"
+#include "uaf/client/crawling/visitednodeset.h"
+
+
+
+namespace uaf
+{
+
+    // forward declaration (the crawler uses the client to process its Browse requests)
+    class Client;
+
+
+    /*******************************************************************************************//**
+    * A uaf::Crawler browses the address space of one or more servers in a breadth-first way.
+    *
+    * The nodes that still need to be browsed (the "frontier") are grouped into batches, and each
+    * batch is processed as a single Browse request (i.e. a single browseList call on the SDK
+    * level) by a pool of worker threads, so that multiple Browse requests are "in flight" at the
+    * same time. The results are processed by the thread that called crawl(): it forwards the
+    * references to the uaf::ClientInterface::referencesCrawled callback, and it adds the
+    * referenced nodes that were not visited before to the frontier.
+    *
+    * A crawler is constructed for a single crawl, by uaf::Client::crawl.
+    *
+    * @ingroup ClientCrawling
+    ***********************************************************************************************/
+    class UAF_EXPORT Crawler
+    {
+    public:
+
+
+        /**
+         * Construct a crawler.
+         *
+         * @param loggerFactory     Logger factory to log all messages to.
+         * @param client            Client to process the Browse requests.
+         * @param clientInterface   Interface to stream the references to.
+         */
+        Crawler(
+                uaf::LoggerFactory*     loggerFactory,
+                uaf::Client*            client,
+                uaf::ClientInterface*   clientInterface);
+
+
+        /**
+         * Destruct the crawler.
+         */
+        virtual ~Crawler();
+
+
+        /**
+         * Crawl the address space, starting from the given nodes.
+         *
+         * This method blocks until the crawl is finished.
+         *
+         * @param startAddresses    The addresses of the nodes to start from.
+         * @param settings          The settings of the crawl.
+         * @param statistics        Output parameter: statistics about the crawl.
+         * @return                  Good if the crawl could be performed (even if some nodes could
+         *                          not be browsed, see statistics.nodesFailed), bad if not.
+         */
+        uaf::Status crawl(
+                const std::vector<uaf::Address>&    startAddresses,
+                const uaf::CrawlSettings&           settings,
+                uaf::CrawlStatistics&               statistics);
+
+
+    private:
+
+        // no copying or assigning allowed
+        DISALLOW_COPY_AND_ASSIGN(Crawler);
+
+        // the workers may call work()
+        class Worker;
+        friend class Worker;
+
+
+        /**
+         * A batch of nodes that is browsed by a single Browse request.
+         */
+        struct Batch
+        {
+            /** The request to process. */
+            uaf::BrowseRequest request;
+            /** The depth of the nodes of the request (one for each target). */
+            std::vector<uint32_t> depths;
+            /** The result of the request. */
+            uaf::BrowseResult result;
+            /** The status returned by the client. */
+            uaf::Status status;
+        };
+
+
+        /**
+         * A worker thread, processing batches until it is told to stop.
+         */
+        class Worker : private UaThread
+        {
+        public:
+            Worker(uaf::Crawler* crawler) : crawler_(crawler) {}
+            void startWorking() { start(); }
+            void waitUntilFinished() { wait(); }
+        private:
+            DISALLOW_COPY_AND_ASSIGN(Worker);
+            void run() { crawler_->work(); }
+            uaf::Crawler* crawler_;
+        };
+
+
+        /**
+         * A node to be browsed.
+         */
+        struct FrontierEntry
+        {
+            FrontierEntry(const uaf::Address& address, uint32_t depth)
+            : address(address), depth(depth) {}
+            uaf::Address address;
+            uint32_t depth;
+        };
+
+
+        /**
+         * The loop of the worker threads.
+         */
+        void work();
+
+
+        /**
+         * Create a new batch from the frontier.
+         */
+        Batch* createBatch(const uaf::CrawlSettings& settings);
+
+
+        /**
+         * Process a batch that was finished by a worker thread.
+         */
+        void processBatch(
+                Batch*                      batch,
+                const uaf::CrawlSettings&   settings,
+                uaf::CrawlStatistics&       statistics);
+
+
+        /**
+         * Get the server URI of the given session (cached, since it's needed for every
+         * reference that doesn't specify a server URI).
+         */
+        std::string serverUriOf(uaf::ClientConnectionId clientConnectionId);
+
+
+        // the logger
+        uaf::Logger* logger_;
+        // the client to process the requests
+        uaf::Client* client_;
+        // the interface to stream the references to
+        uaf::ClientInterface* clientInterface_;
+
+        // the nodes that still need to be browsed (only used by the crawling thread)
+        std::deque<FrontierEntry> frontier_;
+        // the nodes that were visited already (only used by the crawling thread)
+        uaf::VisitedNodeSet visited_;
+        // the number of nodes that were added to the frontier (only used by the crawling thread)
+        uint32_t scheduled_;
+        // the server URIs per session (only used by the crawling thread)
+        std::map<uaf::ClientConnectionId, std::string> serverUris_;
+
+        // the batches that should be processed by the workers (protected by queueMutex_)
+        std::deque<Batch*> pending_;
+        // the batches that have been processed by the workers (protected by queueMutex_)
+        std::deque<Batch*> completed_;
+        // true if the workers should stop (protected by queueMutex_)
+        bool doStop_;
+        // the mutex to protect the queues
+        UaMutex queueMutex_;
+        // posted whenever a batch is added to pending_ (or when the workers should stop)
+        UaSemaphore pendingSemaphore_;
+        // posted whenever a batch is added to completed_
+        UaSemaphore completedSemaphore_;
+    };
+
+}
+
+
+
+#endif /* UAF_CRAWLER_H_ */
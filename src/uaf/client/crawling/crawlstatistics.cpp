@@ -0,0 +1,82 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/crawling/crawlstatistics.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+
+
+    // Constructor
+    // =============================================================================================
+    CrawlStatistics::CrawlStatistics()
+    : nodesBrowsed(0),
+      nodesFailed(0),
+      referencesReceived(0),
+      duplicatesSkipped(0),
+      browseRequests(0),
+      maxDepthReached(0),
+      truncated(false)
+    {}
+
+
+    // Get a string representation
+    // =============================================================================================
+    string CrawlStatistics::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - nodesBrowsed";
+        ss << fillToPos(ss, colon);
+        ss << ": " << nodesBrowsed << "\n";
+
+        ss << indent << " - nodesFailed";
+        ss << fillToPos(ss, colon);
+        ss << ": " << nodesFailed << "\n";
+
+        ss << indent << " - referencesReceived";
+        ss << fillToPos(ss, colon);
+        ss << ": " << referencesReceived << "\n";
+
+        ss << indent << " - duplicatesSkipped";
+        ss << fillToPos(ss, colon);
+        ss << ": " << duplicatesSkipped << "\n";
+
+        ss << indent << " - browseRequests";
+        ss << fillToPos(ss, colon);
+        ss << ": " << browseRequests << "\n";
+
+        ss << indent << " - maxDepthReached";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxDepthReached << "\n";
+
+        ss << indent << " - truncated";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (truncated ? "true" : "false");
+
+        return ss.str();
+    }
+
+}
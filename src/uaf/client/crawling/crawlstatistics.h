@@ -0,0 +1,95 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CRAWLSTATISTICS_H_
+#define UAF_CRAWLSTATISTICS_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::CrawlStatistics object summarizes a crawl that was performed by uaf::Client::crawl.
+    *
+    * @ingroup ClientCrawling
+    ***********************************************************************************************/
+    class UAF_EXPORT CrawlStatistics
+    {
+    public:
+
+
+        /**
+         * Create empty statistics.
+         */
+        CrawlStatistics();
+
+
+        /** The number of nodes that were browsed. */
+        uint32_t nodesBrowsed;
+
+        /** The number of nodes that could not be browsed (e.g. because the browse target had a
+         *  bad status). */
+        uint32_t nodesFailed;
+
+        /** The total number of references that were received (and forwarded to the callback). */
+        uint32_t referencesReceived;
+
+        /** The number of references that were skipped because they pointed to a node that was
+         *  already visited before. */
+        uint32_t duplicatesSkipped;
+
+        /** The number of Browse requests that were processed. */
+        uint32_t browseRequests;
+
+        /** The depth of the deepest node that was browsed (the start nodes have depth 0). */
+        uint32_t maxDepthReached;
+
+        /** True if the crawl was stopped early because the maxNodes limit of the
+         *  uaf::CrawlSettings was reached. */
+        bool truncated;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=22) const;
+
+    };
+
+}
+
+
+
+#endif /* UAF_CRAWLSTATISTICS_H_ */
@@ -0,0 +1,213 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/crawling/visitednodeset.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::size_t;
+
+
+    namespace
+    {
+        // 64-bit FNV-1a parameters
+        const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+        const uint64_t FNV_PRIME        = 0x100000001b3ULL;
+
+        // initial number of slots (must be a power of two)
+        const size_t INITIAL_SLOTS = 1024;
+
+
+        // Hash a number of bytes
+        // =========================================================================================
+        inline void hashBytes(uint64_t& hash, const void* data, size_t length)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < length; i++)
+            {
+                hash ^= bytes[i];
+                hash *= FNV_PRIME;
+            }
+        }
+
+
+        // Hash a string (including a terminator, so that "ab"+"c" differs from "a"+"bc")
+        // =========================================================================================
+        inline void hashString(uint64_t& hash, const string& s)
+        {
+            hashBytes(hash, s.data(), s.size());
+            hash ^= 0xff;
+            hash *= FNV_PRIME;
+        }
+
+
+        // Hash a 32-bit number
+        // =========================================================================================
+        inline void hashNumber(uint64_t& hash, uint32_t number)
+        {
+            unsigned char bytes[4];
+            bytes[0] = static_cast<unsigned char>(number);
+            bytes[1] = static_cast<unsigned char>(number >> 8);
+            bytes[2] = static_cast<unsigned char>(number >> 16);
+            bytes[3] = static_cast<unsigned char>(number >> 24);
+            hashBytes(hash, bytes, 4);
+        }
+
+
+        // Mix the bits of the hash, so that the low bits (used for the slot index) are well spread
+        // =========================================================================================
+        inline uint64_t mix(uint64_t h)
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            return h;
+        }
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    VisitedNodeSet::VisitedNodeSet()
+    : size_(0)
+    {}
+
+
+    // Compute the fingerprint of an ExpandedNodeId
+    // =============================================================================================
+    uint64_t VisitedNodeSet::fingerprint(const ExpandedNodeId& expandedNodeId)
+    {
+        uint64_t hash = FNV_OFFSET_BASIS;
+
+        if (expandedNodeId.hasServerUri())
+            hashString(hash, expandedNodeId.serverUri());
+        else
+            hashNumber(hash, expandedNodeId.serverIndex());
+
+        // avoid copying the NodeId twice
+        const NodeId nodeId = expandedNodeId.nodeId();
+
+        if (nodeId.hasNameSpaceUri())
+            hashString(hash, NamespaceUris::uri(nodeId.nameSpaceUriAtom()));
+        else
+            hashNumber(hash, nodeId.nameSpaceIndex());
+
+        const NodeIdIdentifier identifier = nodeId.identifier();
+
+        hashNumber(hash, uint32_t(identifier.type));
+
+        if (identifier.type == nodeididentifiertypes::Identifier_Numeric)
+            hashNumber(hash, identifier.idNumeric);
+        else if (identifier.type == nodeididentifiertypes::Identifier_String)
+            hashString(hash, identifier.idString);
+        else
+            hashString(hash, identifier.toString());
+
+        hash = mix(hash);
+
+        // 0 is reserved for empty slots
+        return hash == 0 ? 1 : hash;
+    }
+
+
+    // Insert a node
+    // =============================================================================================
+    bool VisitedNodeSet::insert(const ExpandedNodeId& expandedNodeId)
+    {
+        // keep the load factor below 0.5, so that the probe sequences remain short
+        if ((size_ + 1) * 2 > slots_.size())
+            grow();
+
+        return insertFingerprint(fingerprint(expandedNodeId));
+    }
+
+
+    // Check if a node is present
+    // =============================================================================================
+    bool VisitedNodeSet::contains(const ExpandedNodeId& expandedNodeId) const
+    {
+        if (slots_.empty())
+            return false;
+
+        uint64_t fp   = fingerprint(expandedNodeId);
+        size_t   mask = slots_.size() - 1;
+
+        for (size_t i = size_t(fp) & mask; slots_[i] != 0; i = (i + 1) & mask)
+        {
+            if (slots_[i] == fp)
+                return true;
+        }
+
+        return false;
+    }
+
+
+    // Clear the set
+    // =============================================================================================
+    void VisitedNodeSet::clear()
+    {
+        vector<uint64_t>().swap(slots_);
+        size_ = 0;
+    }
+
+
+    // Insert a fingerprint
+    // =============================================================================================
+    bool VisitedNodeSet::insertFingerprint(uint64_t fp)
+    {
+        size_t mask = slots_.size() - 1;
+        size_t i    = size_t(fp) & mask;
+
+        while (slots_[i] != 0)
+        {
+            if (slots_[i] == fp)
+                return false;
+            i = (i + 1) & mask;
+        }
+
+        slots_[i] = fp;
+        size_++;
+        return true;
+    }
+
+
+    // Grow the table
+    // =============================================================================================
+    void VisitedNodeSet::grow()
+    {
+        vector<uint64_t> oldSlots;
+        oldSlots.swap(slots_);
+
+        slots_.resize(oldSlots.empty() ? INITIAL_SLOTS : oldSlots.size() * 2, 0);
+        size_ = 0;
+
+        for (vector<uint64_t>::const_iterator it = oldSlots.begin(); it != oldSlots.end(); ++it)
+        {
+            if (*it != 0)
+                insertFingerprint(*it);
+        }
+    }
+
+}
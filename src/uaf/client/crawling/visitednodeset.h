@@ -0,0 +1,130 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_VISITEDNODESET_H_
+#define UAF_VISITEDNODESET_H_
+
+
+
+// STD
+#include <vector>
+#include <string>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/expandednodeid.h"
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::VisitedNodeSet is a compact hash set to remember which nodes have already been
+    * visited by the uaf::Crawler.
+    *
+    * Instead of storing full ExpandedNodeIds (which hold several strings), only a 64-bit
+    * fingerprint of each ExpandedNodeId is stored, in an open addressing table (linear probing)
+    * that is kept at most half full. This keeps the memory footprint at roughly 16 bytes per
+    * visited node, even for address spaces with millions of nodes. The price to pay is a
+    * (negligible) probability that two different nodes have the same fingerprint, in which case
+    * the second node will be considered as already visited.
+    *
+    * The set is not thread-safe: it is only meant to be used by a single (crawling) thread.
+    *
+    * @ingroup ClientCrawling
+    ***********************************************************************************************/
+    class UAF_EXPORT VisitedNodeSet
+    {
+    public:
+
+
+        /**
+         * Create an empty set.
+         */
+        VisitedNodeSet();
+
+
+        /**
+         * Insert a node into the set.
+         *
+         * @param expandedNodeId    The node to insert.
+         * @return                  True if the node was inserted, false if the node was already
+         *                          part of the set.
+         */
+        bool insert(const uaf::ExpandedNodeId& expandedNodeId);
+
+
+        /**
+         * Check if a node is part of the set.
+         *
+         * @param expandedNodeId    The node to check.
+         * @return                  True if the node was already inserted.
+         */
+        bool contains(const uaf::ExpandedNodeId& expandedNodeId) const;
+
+
+        /**
+         * Get the number of nodes in the set.
+         */
+        std::size_t size() const { return size_; }
+
+
+        /**
+         * Remove all nodes from the set (and release the memory).
+         */
+        void clear();
+
+
+        /**
+         * Compute the 64-bit fingerprint of an ExpandedNodeId.
+         *
+         * The server URI, the namespace (URI if known, index otherwise) and the identifier are
+         * all taken into account.
+         *
+         * @param expandedNodeId    The node to hash.
+         * @return                  The fingerprint (never 0, since 0 marks an empty slot).
+         */
+        static uint64_t fingerprint(const uaf::ExpandedNodeId& expandedNodeId);
+
+
+    private:
+
+        // insert a fingerprint without checking the load factor
+        bool insertFingerprint(uint64_t fingerprint);
+
+        // double the size of the table
+        void grow();
+
+        // the slots of the open addressing table (0 = empty)
+        std::vector<uint64_t> slots_;
+
+        // the number of occupied slots
+        std::size_t size_;
+    };
+
+}
+
+
+
+#endif /* UAF_VISITEDNODESET_H_ */
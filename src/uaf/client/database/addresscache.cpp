@@ -35,6 +35,8 @@ namespace uaf
     // Constructor
     // =============================================================================================
     AddressCache::AddressCache(LoggerFactory* loggerFactory)
+    : hits_(0),
+      misses_(0)
     {
         logger_ = new Logger(loggerFactory, "AddressCache");
         logger_->debug("The address cache has been constructed");
@@ -63,6 +65,7 @@ namespace uaf
         UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
 
         cache_.clear();
+        failures_.clear();
     }
 
 
@@ -89,6 +92,15 @@ namespace uaf
             }
         }
 
+        Failures::iterator failure = failures_.begin();
+        while(failure != failures_.end())
+        {
+            if (failure->second.serverUri == serverUri)
+                failures_.erase(failure++);
+            else
+                ++failure;
+        }
+
         logger_->debug("All cached addresses for ServerUri '%s' have been cleared",
                        serverUri.c_str());
 
@@ -134,8 +146,38 @@ namespace uaf
             logger_->debug("Caching %d addresses (existing items will NOT be replaced)",
                            addresses.size());
 
+        add(addresses, expandedNodeIds, Mask(addresses.size(), true), replaceIfExists);
+    }
+
+
+    // Add some addresses and their resolved ExpandedNodeIds to the cache
+    // =============================================================================================
+    void AddressCache::add(
+            const vector<Address>&          addresses,
+            const vector<ExpandedNodeId>&   expandedNodeIds,
+            const Mask&                     mask,
+            bool                            replaceIfExists)
+    {
+        size_t noOfAdded = 0;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
         for (size_t i = 0; i < addresses.size(); i++)
-            add(addresses[i], expandedNodeIds[i], replaceIfExists);
+        {
+            if (mask.isSet(i))
+            {
+                // insert() doesn't replace an existing entry, but tells us that it exists
+                std::pair<Cache::iterator, bool> inserted = cache_.insert(
+                        Cache::value_type(addresses[i], expandedNodeIds[i]));
+
+                if (inserted.second)
+                    noOfAdded++;
+                else if (replaceIfExists)
+                    inserted.first->second = expandedNodeIds[i];
+            }
+        }
+
+        logger_->debug("%d of the %d addresses were new to the cache", noOfAdded, mask.setCount());
     }
 
 
@@ -143,9 +185,6 @@ namespace uaf
     // =============================================================================================
     bool AddressCache::find(const Address& address, uaf::ExpandedNodeId& expandedNodeId)
     {
-        logger_->debug("Trying to find the following address in the cache (size=%d)", cache_.size());
-        logger_->debug(address.toString());
-
         UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
 
         Cache::const_iterator iter = cache_.find(address);
@@ -155,18 +194,195 @@ namespace uaf
         if (found)
         {
             expandedNodeId = iter->second;
-            logger_->info("The address was found in the cache");
-            logger_->info("It corresponds to %s", expandedNodeId.toString().c_str());
+            hits_++;
         }
         else
         {
-            logger_->info("The address was not found in the cache");
+            misses_++;
+        }
+
+        // log the lookup (only if needed, since this may be done for many addresses)
+        if (logger_->isDebugEnabled())
+        {
+            logger_->debug("Trying to find the following address in the cache (size=%d)",
+                           cache_.size());
+            logger_->debug(address.toString());
+            if (found)
+                logger_->debug("It was found, and corresponds to %s",
+                               expandedNodeId.toString().c_str());
+            else
+                logger_->debug("It was not found");
         }
 
         return found;
     }
 
 
+    // Find the resolved ExpandedNodeIds of some addresses
+    // =============================================================================================
+    size_t AddressCache::find(
+            const vector<Address>&  addresses,
+            const Mask&             mask,
+            vector<ExpandedNodeId>& expandedNodeIds,
+            Mask&                   foundMask)
+    {
+        size_t ret = 0;
+
+        foundMask = Mask(addresses.size());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        for (size_t i = 0; i < addresses.size(); i++)
+        {
+            if (mask.isSet(i))
+            {
+                Cache::const_iterator iter = cache_.find(addresses[i]);
+
+                if (iter != cache_.end())
+                {
+                    expandedNodeIds[i] = iter->second;
+                    foundMask.set(i);
+                    ret++;
+                }
+            }
+        }
+
+        hits_   += ret;
+        misses_ += mask.setCount() - ret;
+
+        logger_->debug("%d of the %d addresses were found in the cache (size=%d)",
+                       ret, mask.setCount(), cache_.size());
+
+        return ret;
+    }
+
+
+    // Remember the addresses that could not be resolved
+    // =============================================================================================
+    void AddressCache::addFailures(
+            const vector<Address>&      addresses,
+            const vector<Status>&       statuses,
+            const vector<BrowsePath>&   browsePaths,
+            const Mask&                 mask,
+            double                      timeToLiveSec)
+    {
+        time_t now = time(NULL);
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        for (size_t i = 0; i < addresses.size(); i++)
+        {
+            if (mask.isSet(i))
+            {
+                Failure& failure = failures_[addresses[i]];
+                failure.status          = statuses[i];
+                failure.serverUri       = browsePaths[i].startingExpandedNodeId.serverUri();
+                failure.time            = now;
+                failure.timeToLiveSec   = timeToLiveSec;
+            }
+        }
+
+        logger_->debug("%d failed addresses are remembered for %.1f seconds",
+                       mask.setCount(), timeToLiveSec);
+    }
+
+
+    // Find the addresses that could not be resolved recently
+    // =============================================================================================
+    size_t AddressCache::findFailures(
+            const vector<Address>&  addresses,
+            const Mask&             mask,
+            vector<Status>&         statuses,
+            Mask&                   foundMask)
+    {
+        size_t ret = 0;
+
+        foundMask = Mask(addresses.size());
+
+        time_t now = time(NULL);
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        for (size_t i = 0; i < addresses.size() && !failures_.empty(); i++)
+        {
+            if (mask.isSet(i))
+            {
+                Failures::iterator iter = failures_.find(addresses[i]);
+
+                if (iter != failures_.end())
+                {
+                    if (difftime(now, iter->second.time) >= iter->second.timeToLiveSec)
+                    {
+                        // expired, so the address may be resolved again
+                        failures_.erase(iter);
+                    }
+                    else
+                    {
+                        statuses[i] = iter->second.status;
+                        foundMask.set(i);
+                        ret++;
+                    }
+                }
+            }
+        }
+
+        logger_->debug("%d of the %d addresses failed to resolve recently", ret, mask.setCount());
+
+        return ret;
+    }
+
+
+    // Get a copy of all cached entries
+    // =============================================================================================
+    void AddressCache::entries(vector<Address>& addresses, vector<ExpandedNodeId>& expandedNodeIds)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        addresses.clear();
+        expandedNodeIds.clear();
+        addresses.reserve(cache_.size());
+        expandedNodeIds.reserve(cache_.size());
+
+        for (Cache::const_iterator it = cache_.begin(); it != cache_.end(); ++it)
+        {
+            addresses.push_back(it->first);
+            expandedNodeIds.push_back(it->second);
+        }
+    }
+
+
+    // Get the number of cached entries
+    // =============================================================================================
+    std::size_t AddressCache::size()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return cache_.size();
+    }
+
+
+    // Get the number of lookups
+    // =============================================================================================
+    void AddressCache::lookupCounts(uint64_t& hits, uint64_t& misses)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        hits   = hits_;
+        misses = misses_;
+    }
+
+
+    // Get the approximate number of bytes used by the cache
+    // =============================================================================================
+    std::size_t AddressCache::memoryFootprint()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        // each map node holds the value, plus the pointers and color of the tree node
+        return sizeof(*this)
+             + cache_.size()    * (sizeof(Cache::value_type)    + 4 * sizeof(void*))
+             + failures_.size() * (sizeof(Failures::value_type) + 4 * sizeof(void*));
+    }
+
+
 
 
 }
@@ -26,6 +26,8 @@
 #include <sstream>
 #include <vector>
 #include <map>
+#include <ctime>
+#include <stdint.h>
 // SDK
 #include "uabase/uamutex.h"
 // UAF
@@ -33,6 +35,8 @@
 #include "uaf/util/status.h"
 #include "uaf/util/logger.h"
 #include "uaf/util/address.h"
+#include "uaf/util/browsepath.h"
+#include "uaf/util/mask.h"
 #include "uaf/client/clientexport.h"
 
 
@@ -66,13 +70,13 @@ namespace uaf
 
 
         /**
-         * Clear the cache.
+         * Clear the cache (including the remembered failures).
          */
         void clear();
 
 
         /**
-         * Remove all cached addresses that belong to the given server URI.
+         * Remove all cached addresses (and failures) that belong to the given server URI.
          */
         void clear(const std::string& serverUri);
 
@@ -103,6 +107,22 @@ namespace uaf
                 bool                                    replaceIfExists = false);
 
 
+        /**
+         * Add some of the given addresses (and their resolved ExpandedNodeIds) to the cache,
+         * while locking the cache only once.
+         *
+         * @param addresses         The addresses to cache.
+         * @param expandedNodeIds   The expanded node ids of the first argument.
+         * @param mask              Only the addresses of which the mask is set are cached.
+         * @param replaceIfExists   True to replace the cached values if they exist already.
+         */
+        void add(
+                const std::vector<uaf::Address>&        addresses,
+                const std::vector<uaf::ExpandedNodeId>& expandedNodeIds,
+                const uaf::Mask&                        mask,
+                bool                                    replaceIfExists = false);
+
+
         /**
          * Find a the resolved expanded node id of the specified address in the cache.
          *
@@ -113,6 +133,103 @@ namespace uaf
         bool find(const uaf::Address& address, uaf::ExpandedNodeId& expandedNodeId);
 
 
+        /**
+         * Find the resolved expanded node ids of some of the given addresses in the cache, while
+         * locking the cache only once.
+         *
+         * @param addresses         The addresses to look up.
+         * @param mask              Only the addresses of which the mask is set are looked up.
+         * @param expandedNodeIds   In-out parameter: the found expandedNodeIds are copied to the
+         *                          same index as their address (the others are left untouched).
+         * @param foundMask         Output parameter: the mask of the addresses that were found.
+         * @return                  The number of addresses that were found.
+         */
+        std::size_t find(
+                const std::vector<uaf::Address>&    addresses,
+                const uaf::Mask&                    mask,
+                std::vector<uaf::ExpandedNodeId>&   expandedNodeIds,
+                uaf::Mask&                          foundMask);
+
+
+        /**
+         * Remember that some addresses could not be resolved, so that they are not resolved again
+         * (and not sent to the server again) during the given time.
+         *
+         * @param addresses         The addresses that could not be resolved.
+         * @param statuses          Their (bad) resolution statuses.
+         * @param browsePaths       The browse paths that were rejected by the server (their
+         *                          starting node tells which server rejected them).
+         * @param mask              Only the addresses of which the mask is set are remembered.
+         * @param timeToLiveSec     The time during which the failures are remembered.
+         */
+        void addFailures(
+                const std::vector<uaf::Address>&        addresses,
+                const std::vector<uaf::Status>&         statuses,
+                const std::vector<uaf::BrowsePath>&     browsePaths,
+                const uaf::Mask&                        mask,
+                double                                  timeToLiveSec);
+
+
+        /**
+         * Find the addresses that could not be resolved recently, while locking the cache only
+         * once. Expired failures are removed.
+         *
+         * @param addresses         The addresses to look up.
+         * @param mask              Only the addresses of which the mask is set are looked up.
+         * @param statuses          In-out parameter: the remembered resolution statuses are copied
+         *                          to the same index as their address (the others are left
+         *                          untouched).
+         * @param foundMask         Output parameter: the mask of the addresses that were found.
+         * @return                  The number of addresses that were found.
+         */
+        std::size_t findFailures(
+                const std::vector<uaf::Address>&    addresses,
+                const uaf::Mask&                    mask,
+                std::vector<uaf::Status>&           statuses,
+                uaf::Mask&                          foundMask);
+
+
+        /**
+         * Get a copy of all cached addresses and their resolved ExpandedNodeIds (e.g. to write
+         * them to a snapshot).
+         *
+         * @param addresses         Output parameter: the cached addresses.
+         * @param expandedNodeIds   Output parameter: their resolved ExpandedNodeIds.
+         */
+        void entries(
+                std::vector<uaf::Address>&          addresses,
+                std::vector<uaf::ExpandedNodeId>&   expandedNodeIds);
+
+
+        /**
+         * Get the number of cached addresses.
+         *
+         * @return  The number of cached addresses.
+         */
+        std::size_t size();
+
+
+        /**
+         * Get the number of addresses that were looked up in the cache (by find()) since the
+         * cache was created.
+         *
+         * @param hits      Output parameter: the number of addresses that were found.
+         * @param misses    Output parameter: the number of addresses that were not found.
+         */
+        void lookupCounts(uint64_t& hits, uint64_t& misses);
+
+
+        /**
+         * Get the (approximate) number of bytes that are used by the cache.
+         *
+         * Only the memory of the cached entries themselves is counted, not the memory that is
+         * owned by them (e.g. the memory of their strings).
+         *
+         * @return  The approximate number of bytes.
+         */
+        std::size_t memoryFootprint();
+
+
 
     private:
 
@@ -127,6 +244,18 @@ namespace uaf
         /** A cache stores the addresses and their corresponding ExpandedNodeIds. */
         typedef std::map<uaf::Address, uaf::ExpandedNodeId> Cache;
 
+        /** A failure is an address that could not be resolved (by a particular server). */
+        struct Failure
+        {
+            uaf::Status status;
+            std::string serverUri;
+            time_t      time;
+            double      timeToLiveSec;
+        };
+
+        /** The failures are stored by address. */
+        typedef std::map<uaf::Address, Failure> Failures;
+
 
         // private members
 
@@ -137,6 +266,15 @@ namespace uaf
         /** The map containing the cached addresses. */
         Cache cache_;
 
+        /** The map containing the addresses that could not be resolved recently. */
+        Failures failures_;
+
+        /** The number of addresses that were found by find(). */
+        uint64_t hits_;
+
+        /** The number of addresses that were not found by find(). */
+        uint64_t misses_;
+
         /** The mutex to safely manipulate the map. */
         UaMutex mutex_;
 
@@ -26,15 +26,29 @@ namespace uaf
     using namespace uaf;
 
 
+    // The minimum time between the deletion of a monitored item or subscription and the reuse of
+    // its handle, so that late notifications for the deleted one are never mistaken for
+    // notifications of a new one.
+    static const double HANDLE_REUSE_DELAY_SEC = 60.0;
+
+
+    // ClientSubscriptionHandles are never reused, since the user keeps them (e.g. to create
+    // monitored items in a specific subscription): a stale handle must result in an
+    // UnknownClientSubscriptionHandleError, instead of silently addressing a new subscription.
+    static const bool REUSE_CLIENT_SUBSCRIPTION_HANDLES = false;
+
+
     // Constructor
     // =============================================================================================
     Database::Database(LoggerFactory* loggerFactory)
     : createMonitoredDataRequestStore   (loggerFactory, "MonDataReqStore"),
       createMonitoredEventsRequestStore (loggerFactory, "MonEvtsReqStore"),
       addressCache                      (loggerFactory),
+      structureDefinitionCache          (loggerFactory),
+      pkiStoreCache                     (loggerFactory),
       clientConnectionId_(0),
-      clientSubscriptionHandle_(0),
-      clientHandle_(0)
+      clientSubscriptionHandles_(HANDLE_REUSE_DELAY_SEC, REUSE_CLIENT_SUBSCRIPTION_HANDLES),
+      clientHandles_(HANDLE_REUSE_DELAY_SEC)
     {}
 
 
@@ -51,8 +65,16 @@ namespace uaf
     //==============================================================================================
     uaf::ClientSubscriptionHandle Database::createUniqueClientSubscriptionHandle()
     {
-        UaMutexLocker locker(&clientSubscriptionHandleMutex_); //auto-unlocks when out of scope
-        return clientSubscriptionHandle_++;
+        return clientSubscriptionHandles_.assign();
+    }
+
+
+    // Release a ClientSubscriptionHandle
+    //==============================================================================================
+    void Database::releaseClientSubscriptionHandle(ClientSubscriptionHandle clientSubscriptionHandle)
+    {
+        clientSubscriptionHandles_.release(clientSubscriptionHandle);
+        metrics.forgetSubscription(clientSubscriptionHandle);
     }
 
 
@@ -60,10 +82,101 @@ namespace uaf
     // =============================================================================================
     ClientHandle Database::createUniqueClientHandle()
     {
-        UaMutexLocker locker(&clientHandleMutex_);
-        ClientHandle newHandle = clientHandle_++;
-        allClientHandles.push_back(newHandle);
-        return newHandle;
+        return clientHandles_.assign();
+    }
+
+
+    // Release a client monitored item handle
+    // =============================================================================================
+    void Database::releaseClientHandle(ClientHandle clientHandle)
+    {
+        clientHandles_.release(clientHandle);
+    }
+
+
+    // Check if a client monitored item handle is assigned
+    // =============================================================================================
+    bool Database::isClientHandleAssigned(ClientHandle clientHandle) const
+    {
+        return clientHandles_.isAssigned(clientHandle);
+    }
+
+
+    // Remember the NamespaceArray of a server
+    // =============================================================================================
+    bool Database::updateNamespaceArray(
+            const std::string&  serverUri,
+            const NameSpaceMap& nameSpaceMap)
+    {
+        UaMutexLocker locker(&namespaceArraysMutex_); // unlocks when locker goes out of scope
+
+        std::map<std::string, NameSpaceMap>::iterator it = namespaceArrays_.find(serverUri);
+
+        if (it == namespaceArrays_.end())
+        {
+            namespaceArrays_[serverUri] = nameSpaceMap;
+            return true;
+        }
+        else if (it->second == nameSpaceMap)
+        {
+            return true;
+        }
+        else
+        {
+            it->second = nameSpaceMap;
+            return false;
+        }
+    }
+
+
+    // Get the remembered NamespaceArrays
+    // =============================================================================================
+    std::map<std::string, NameSpaceMap> Database::namespaceArrays()
+    {
+        UaMutexLocker locker(&namespaceArraysMutex_); // unlocks when locker goes out of scope
+        return namespaceArrays_;
+    }
+
+
+    // Get the memory footprint
+    // =============================================================================================
+    DatabaseFootprint Database::footprint()
+    {
+        DatabaseFootprint ret;
+
+        ret.monitoredDataRequests               = createMonitoredDataRequestStore.size();
+        ret.monitoredDataRequestBytes           = createMonitoredDataRequestStore.memoryFootprint();
+        ret.monitoredEventsRequests             = createMonitoredEventsRequestStore.size();
+        ret.monitoredEventsRequestBytes         = createMonitoredEventsRequestStore.memoryFootprint();
+        ret.cachedAddresses                     = addressCache.size();
+        ret.cachedAddressBytes                  = addressCache.memoryFootprint();
+        ret.cachedStructureDefinitions          = structureDefinitionCache.size();
+        ret.cachedStructureDefinitionBytes      = structureDefinitionCache.memoryFootprint();
+        ret.clientHandles                       = clientHandles_.assignedCount();
+        ret.releasedClientHandles               = clientHandles_.releasedCount();
+        ret.clientHandleBytes                   = clientHandles_.memoryFootprint();
+        ret.clientSubscriptionHandles           = clientSubscriptionHandles_.assignedCount();
+        ret.releasedClientSubscriptionHandles   = clientSubscriptionHandles_.releasedCount();
+        ret.clientSubscriptionHandleBytes       = clientSubscriptionHandles_.memoryFootprint();
+
+        return ret;
+    }
+
+
+    // Get the metrics
+    // =============================================================================================
+    Metrics Database::collectMetrics()
+    {
+        Metrics ret;
+
+        metrics.merge(ret);
+        addressCache.lookupCounts(ret.addressCacheHits, ret.addressCacheMisses);
+        structureDefinitionCache.lookupCounts(ret.structureDefinitionCacheHits,
+                                              ret.structureDefinitionCacheMisses);
+        ret.pkiStoreCacheHits  = pkiStoreCache.hitCount();
+        ret.pkiStoreCacheLoads = pkiStoreCache.loadCount();
+
+        return ret;
     }
 
 }
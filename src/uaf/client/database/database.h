@@ -23,13 +23,21 @@
 
 
 // STD
+#include <string>
+#include <map>
 // SDK
 // UAF
 #include "uaf/util/constants.h"
+#include "uaf/util/namespacearray.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/clientservices.h"
 #include "uaf/client/database/requeststore.h"
 #include "uaf/client/database/addresscache.h"
+#include "uaf/client/database/structuredefinitioncache.h"
+#include "uaf/client/database/pkistorecache.h"
+#include "uaf/client/database/handleregistry.h"
+#include "uaf/client/database/databasefootprint.h"
+#include "uaf/client/metrics/metricsregistry.h"
 #include "uaf/client/settings/clientsettings.h"
 
 
@@ -69,8 +77,14 @@ namespace uaf
         /** The cache used by the resolver. */
         uaf::AddressCache addressCache;
 
-        /** A vector storing all the client handles that were ever assigned. */
-        std::vector<uaf::ClientHandle> allClientHandles;
+        /** The cache of the (compiled) structure definitions of the servers. */
+        uaf::StructureDefinitionCache structureDefinitionCache;
+
+        /** The cache of the PKI store, which is shared by all sessions. */
+        uaf::PkiStoreCache pkiStoreCache;
+
+        /** The registry that counts the metrics of the sessions and subscriptions. */
+        uaf::MetricsRegistry metrics;
 
 
         /**
@@ -89,6 +103,15 @@ namespace uaf
         uaf::ClientSubscriptionHandle createUniqueClientSubscriptionHandle();
 
 
+        /**
+         * Release a ClientSubscriptionHandle of a subscription that has been deleted. The handle
+         * is never reused, so any later use of it is reported as an unknown handle.
+         *
+         * @param clientSubscriptionHandle  The handle to release.
+         */
+        void releaseClientSubscriptionHandle(uaf::ClientSubscriptionHandle clientSubscriptionHandle);
+
+
         /**
          * Get a unique ClientHandle.
          *
@@ -97,19 +120,80 @@ namespace uaf
         uaf::ClientHandle createUniqueClientHandle();
 
 
+        /**
+         * Release the ClientHandle of a monitored item that has been deleted (and that will not
+         * be re-created anymore), so that it can be reused later.
+         *
+         * @param clientHandle  The handle to release.
+         */
+        void releaseClientHandle(uaf::ClientHandle clientHandle);
+
+
+        /**
+         * Check if a ClientHandle is currently assigned to a monitored item (which may or may not
+         * be created on the server at this moment).
+         *
+         * @param clientHandle  The handle to check.
+         * @return              True if the handle was assigned and not released.
+         */
+        bool isClientHandleAssigned(uaf::ClientHandle clientHandle) const;
+
+
+        /**
+         * Remember the NamespaceArray of a server, and check if it's the same as the one that was
+         * remembered before (e.g. the one of a warm-start snapshot).
+         *
+         * @param serverUri     The URI of the server.
+         * @param nameSpaceMap  The NamespaceArray of the server.
+         * @return              False if a different NamespaceArray was remembered before (in
+         *                      which case the new one replaces it), true otherwise.
+         */
+        bool updateNamespaceArray(
+                const std::string&      serverUri,
+                const uaf::NameSpaceMap& nameSpaceMap);
+
+
+        /**
+         * Get a copy of the remembered NamespaceArrays.
+         *
+         * @return  The NamespaceArrays, per server URI.
+         */
+        std::map<std::string, uaf::NameSpaceMap> namespaceArrays();
+
+
+        /**
+         * Get the memory footprint of the stores of the database.
+         *
+         * @return  The number of entries and the (approximate) number of bytes per store.
+         */
+        uaf::DatabaseFootprint footprint();
+
+
+        /**
+         * Get the metrics counted by the registry, together with the hits and misses of the
+         * caches.
+         *
+         * @return  The metrics (without the statistics of the notification queue, which is not
+         *          part of the database).
+         */
+        uaf::Metrics collectMetrics();
+
+
     private:
 
         // The current client connection ID.
         uaf::ClientConnectionId         clientConnectionId_;
         UaMutex                         clientConnectionIdMutex_;
 
-        // The current client subscription handle.
-        uaf::ClientSubscriptionHandle   clientSubscriptionHandle_;
-        UaMutex                         clientSubscriptionHandleMutex_;
+        // The assigned client subscription handles.
+        uaf::HandleRegistry<uaf::ClientSubscriptionHandle> clientSubscriptionHandles_;
 
-        // The current client handle of the monitored items.
-        uaf::ClientHandle               clientHandle_;
-        UaMutex                         clientHandleMutex_;
+        // The assigned client handles of the monitored items.
+        uaf::HandleRegistry<uaf::ClientHandle>             clientHandles_;
+
+        // The NamespaceArrays of the servers, as they were last read (or loaded from a snapshot).
+        std::map<std::string, uaf::NameSpaceMap>           namespaceArrays_;
+        UaMutex                                            namespaceArraysMutex_;
 
         // no copying or assigning allowed
         DISALLOW_COPY_AND_ASSIGN(Database);
@@ -117,13 +201,49 @@ namespace uaf
     };
 
 
+    /**
+     * Template function to check if the requests of a service are 'persistent', i.e. if they
+     * need to be stored (by storeIfNeeded()) so that they can be re-processed after failures.
+     *
+     * Requests of services that *are* persistent, will have a specialized isPersistent()
+     * function.
+     *
+     * @return  Always false, since the non-specialized version is called.
+     */
+    template <typename _Service>
+    bool UAF_EXPORT isPersistent()
+    {
+        return false;
+    }
+
+
+    /**
+     * CreateMonitoredDataRequests are persistent.
+     */
+    template <>
+    inline bool UAF_EXPORT isPersistent<uaf::CreateMonitoredDataService>()
+    {
+        return true;
+    }
+
+
+    /**
+     * CreateMonitoredEventsRequests are persistent.
+     */
+    template <>
+    inline bool UAF_EXPORT isPersistent<uaf::CreateMonitoredEventsService>()
+    {
+        return true;
+    }
+
+
     /**
      * Template function to "catch" all requests that don't need to be stored.
      *
      * Request/Results that *do* need to be stored, will have a specialized storeIfNeeded()
      * function.
      *
-     * @param request   The request.
+     * @param request   The request (shared, so the store doesn't need to copy it).
      * @param result    The result.
      * @param mask      Only store the targets indicated by the mask.
      * @param database  The database to add the request to.
@@ -132,10 +252,10 @@ namespace uaf
      */
     template <typename _Service>
     uaf::Status UAF_EXPORT storeIfNeeded(
-            const typename _Service::Request& request,
-            const typename _Service::Result&  result,
-            const uaf::Mask&                  mask,
-            uaf::Database*                   database)
+            const uaf::SharedConst<typename _Service::Request>& request,
+            const typename _Service::Result&                    result,
+            const uaf::Mask&                                    mask,
+            uaf::Database*                                     database)
     {
         return uaf::Status(uaf::statuscodes::Good);
     }
@@ -144,7 +264,7 @@ namespace uaf
     /**
      * Store a uaf::CreateMonitoredDataRequest and corresponding result, if needed.
      *
-     * @param request   The request to be stored.
+     * @param request   The request to be stored (it is shared, not copied).
      * @param result    The result corresponding with the request.
      * @param mask      Only store the targets indicated by the mask.
      * @param database  The database to add the request to.
@@ -152,10 +272,10 @@ namespace uaf
      */
     template <>
     inline uaf::Status UAF_EXPORT storeIfNeeded<uaf::CreateMonitoredDataService>(
-            const uaf::CreateMonitoredDataRequest& request,
-            const uaf::CreateMonitoredDataResult&  result,
-            const uaf::Mask&                        mask,
-            uaf::Database*                         database)
+            const uaf::SharedConst<uaf::CreateMonitoredDataRequest>&   request,
+            const uaf::CreateMonitoredDataResult&                       result,
+            const uaf::Mask&                                            mask,
+            uaf::Database*                                             database)
     {
         return database->createMonitoredDataRequestStore.storeIfNeeded(request, result, mask);
     }
@@ -164,7 +284,7 @@ namespace uaf
     /**
      * Store a uaf::CreateMonitoredEventsRequest and corresponding result, if needed.
      *
-     * @param request   The request to be stored.
+     * @param request   The request to be stored (it is shared, not copied).
      * @param result    The result corresponding with the request.
      * @param mask      Only store the targets indicated by the mask.
      * @param database  The database to add the request to.
@@ -172,10 +292,10 @@ namespace uaf
      */
     template <>
     inline uaf::Status UAF_EXPORT storeIfNeeded<uaf::CreateMonitoredEventsService>(
-            const uaf::CreateMonitoredEventsRequest&   request,
-            const uaf::CreateMonitoredEventsResult&    result,
-            const uaf::Mask&                            mask,
-            uaf::Database*                             database)
+            const uaf::SharedConst<uaf::CreateMonitoredEventsRequest>& request,
+            const uaf::CreateMonitoredEventsResult&                     result,
+            const uaf::Mask&                                            mask,
+            uaf::Database*                                             database)
     {
         return database->createMonitoredEventsRequestStore.storeIfNeeded(request, result, mask);
     }
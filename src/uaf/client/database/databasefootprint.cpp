@@ -0,0 +1,134 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/database/databasefootprint.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+
+
+    // Constructor
+    // =============================================================================================
+    DatabaseFootprint::DatabaseFootprint()
+    : monitoredDataRequests(0),
+      monitoredDataRequestBytes(0),
+      monitoredEventsRequests(0),
+      monitoredEventsRequestBytes(0),
+      cachedAddresses(0),
+      cachedAddressBytes(0),
+      cachedStructureDefinitions(0),
+      cachedStructureDefinitionBytes(0),
+      clientHandles(0),
+      releasedClientHandles(0),
+      clientHandleBytes(0),
+      clientSubscriptionHandles(0),
+      releasedClientSubscriptionHandles(0),
+      clientSubscriptionHandleBytes(0)
+    {}
+
+
+    // Get the total number of bytes
+    // =============================================================================================
+    uint64_t DatabaseFootprint::totalBytes() const
+    {
+        return monitoredDataRequestBytes
+             + monitoredEventsRequestBytes
+             + cachedAddressBytes
+             + cachedStructureDefinitionBytes
+             + clientHandleBytes
+             + clientSubscriptionHandleBytes;
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string DatabaseFootprint::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - monitoredDataRequests";
+        ss << fillToPos(ss, colon);
+        ss << ": " << monitoredDataRequests << "\n";
+
+        ss << indent << " - monitoredDataRequestBytes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << monitoredDataRequestBytes << "\n";
+
+        ss << indent << " - monitoredEventsRequests";
+        ss << fillToPos(ss, colon);
+        ss << ": " << monitoredEventsRequests << "\n";
+
+        ss << indent << " - monitoredEventsRequestBytes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << monitoredEventsRequestBytes << "\n";
+
+        ss << indent << " - cachedAddresses";
+        ss << fillToPos(ss, colon);
+        ss << ": " << cachedAddresses << "\n";
+
+        ss << indent << " - cachedAddressBytes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << cachedAddressBytes << "\n";
+
+        ss << indent << " - cachedStructureDefinitions";
+        ss << fillToPos(ss, colon);
+        ss << ": " << cachedStructureDefinitions << "\n";
+
+        ss << indent << " - cachedStructureDefinitionBytes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << cachedStructureDefinitionBytes << "\n";
+
+        ss << indent << " - clientHandles";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientHandles << "\n";
+
+        ss << indent << " - releasedClientHandles";
+        ss << fillToPos(ss, colon);
+        ss << ": " << releasedClientHandles << "\n";
+
+        ss << indent << " - clientHandleBytes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientHandleBytes << "\n";
+
+        ss << indent << " - clientSubscriptionHandles";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientSubscriptionHandles << "\n";
+
+        ss << indent << " - releasedClientSubscriptionHandles";
+        ss << fillToPos(ss, colon);
+        ss << ": " << releasedClientSubscriptionHandles << "\n";
+
+        ss << indent << " - clientSubscriptionHandleBytes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientSubscriptionHandleBytes << "\n";
+
+        ss << indent << " - totalBytes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << totalBytes();
+
+        return ss.str();
+    }
+
+}
@@ -0,0 +1,128 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_DATABASEFOOTPRINT_H_
+#define UAF_DATABASEFOOTPRINT_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::DatabaseFootprint object reports the memory used by the stores of the client database
+    * (see uaf::Client::databaseFootprint).
+    *
+    * The numbers of bytes are approximate: they include the memory of the stored entries
+    * themselves, but not the memory that is owned by them (e.g. the memory of their strings).
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    class UAF_EXPORT DatabaseFootprint
+    {
+    public:
+
+
+        /**
+         * Create an empty footprint.
+         */
+        DatabaseFootprint();
+
+
+        /** The number of persistent CreateMonitoredData requests that are stored. */
+        uint32_t monitoredDataRequests;
+
+        /** The approximate number of bytes used by the persistent CreateMonitoredData requests. */
+        uint64_t monitoredDataRequestBytes;
+
+        /** The number of persistent CreateMonitoredEvents requests that are stored. */
+        uint32_t monitoredEventsRequests;
+
+        /** The approximate number of bytes used by the persistent CreateMonitoredEvents
+         *  requests. */
+        uint64_t monitoredEventsRequestBytes;
+
+        /** The number of addresses that are cached by the resolver. */
+        uint32_t cachedAddresses;
+
+        /** The approximate number of bytes used by the cached addresses. */
+        uint64_t cachedAddressBytes;
+
+        /** The number of structure definitions that are cached. */
+        uint32_t cachedStructureDefinitions;
+
+        /** The approximate number of bytes used by the cached structure definitions. */
+        uint64_t cachedStructureDefinitionBytes;
+
+        /** The number of client handles of monitored items that are currently assigned. */
+        uint32_t clientHandles;
+
+        /** The number of client handles that were released, and are waiting to be reused. */
+        uint32_t releasedClientHandles;
+
+        /** The approximate number of bytes used to keep track of the client handles. */
+        uint64_t clientHandleBytes;
+
+        /** The number of client subscription handles that are currently assigned. */
+        uint32_t clientSubscriptionHandles;
+
+        /** The number of client subscription handles that are waiting to be reused (always 0,
+         *  since client subscription handles are never reused). */
+        uint32_t releasedClientSubscriptionHandles;
+
+        /** The approximate number of bytes used to keep track of the client subscription
+         *  handles. */
+        uint64_t clientSubscriptionHandleBytes;
+
+
+        /**
+         * Get the approximate total number of bytes used by all stores.
+         *
+         * @return  The sum of all the numbers of bytes.
+         */
+        uint64_t totalBytes() const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=37) const;
+
+    };
+
+}
+
+
+
+#endif /* UAF_DATABASEFOOTPRINT_H_ */
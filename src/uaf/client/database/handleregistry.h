@@ -0,0 +1,212 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_HANDLEREGISTRY_H_
+#define UAF_HANDLEREGISTRY_H_
+
+
+
+// STD
+#include <deque>
+#include <vector>
+#include <ctime>
+#include <cstddef>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+    /*******************************************************************************************//**
+    * A handle registry assigns unique handles (such as client handles of monitored items), and
+    * keeps track of the handles that are currently in use.
+    *
+    * Released handles are reused, so the handles (and the memory of the registry) don't keep on
+    * growing when items are created and deleted over and over again. A released handle is
+    * however only reused after a delay, so that late notifications for the deleted item (e.g.
+    * notifications that were already on their way when the item was deleted) can never be
+    * mistaken for notifications of a new item.
+    *
+    * Handles that are kept by the user (and that may therefore be used long after their item was
+    * deleted) should never be reused: such a registry only marks the released handles as
+    * unassigned, so that a stale handle is still recognized as unknown.
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    template <typename _Handle>
+    class UAF_EXPORT HandleRegistry
+    {
+    public:
+
+
+        /**
+         * Construct a new handle registry.
+         *
+         * @param reuseDelaySec     The minimum time (in seconds) between the release of a handle
+         *                          and its reuse.
+         * @param reuse             False if released handles may never be reused.
+         */
+        HandleRegistry(double reuseDelaySec, bool reuse = true)
+        : reuseDelaySec_(reuseDelaySec),
+          reuse_(reuse),
+          nextHandle_(0),
+          noOfAssigned_(0)
+        {}
+
+
+        /**
+         * Assign a handle: a released handle if one can be reused already, a new one otherwise.
+         *
+         * @return  The assigned handle.
+         */
+        _Handle assign()
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            _Handle handle;
+
+            if (!released_.empty() && difftime(time(NULL), released_.front().time) >= reuseDelaySec_)
+            {
+                handle = released_.front().handle;
+                released_.pop_front();
+            }
+            else
+            {
+                handle = nextHandle_++;
+                assigned_.push_back(false);
+            }
+
+            assigned_[handle] = true;
+            noOfAssigned_++;
+
+            return handle;
+        }
+
+
+        /**
+         * Release a handle that was assigned before, so that it may be reused later (unless the
+         * registry never reuses its handles).
+         *
+         * @param handle    The handle to release.
+         * @return          True if the handle was released, false if it wasn't assigned.
+         */
+        bool release(_Handle handle)
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (!isAssignedNoLock(handle))
+                return false;
+
+            assigned_[handle] = false;
+            noOfAssigned_--;
+
+            if (reuse_)
+                released_.push_back(ReleasedHandle(handle, time(NULL)));
+
+            return true;
+        }
+
+
+        /**
+         * Check if a handle is currently assigned (i.e. assigned and not released).
+         *
+         * @param handle    The handle to check.
+         * @return          True if the handle is currently assigned.
+         */
+        bool isAssigned(_Handle handle) const
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            return isAssignedNoLock(handle);
+        }
+
+
+        /** Get the number of handles that are currently assigned. */
+        std::size_t assignedCount() const
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            return noOfAssigned_;
+        }
+
+
+        /** Get the number of handles that were released, and are waiting to be reused. */
+        std::size_t releasedCount() const
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            return released_.size();
+        }
+
+
+        /** Get the (approximate) number of bytes that are used to keep track of the handles. */
+        std::size_t memoryFootprint() const
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            return sizeof(*this)
+                 + assigned_.capacity() / 8
+                 + released_.size() * sizeof(ReleasedHandle);
+        }
+
+
+    private:
+
+
+        // no copying or assigning allowed
+        DISALLOW_COPY_AND_ASSIGN(HandleRegistry);
+
+
+        // a released handle, and the time when it was released
+        struct ReleasedHandle
+        {
+            ReleasedHandle(_Handle handle, time_t time) : handle(handle), time(time) {}
+            _Handle handle;
+            time_t  time;
+        };
+
+
+        // check if the handle is assigned (not locked!)
+        bool isAssignedNoLock(_Handle handle) const
+        {
+            return handle < assigned_.size() && assigned_[handle];
+        }
+
+
+        // the minimum time between the release and the reuse of a handle
+        double                      reuseDelaySec_;
+        // false if the released handles are never reused
+        bool                        reuse_;
+        // the next new handle
+        _Handle                     nextHandle_;
+        // for each handle up to the next new handle: is it assigned?
+        std::vector<bool>           assigned_;
+        // the number of assigned handles
+        std::size_t                 noOfAssigned_;
+        // the released handles, in the order in which they were released
+        std::deque<ReleasedHandle>  released_;
+        // the mutex to access the members safely
+        mutable UaMutex             mutex_;
+    };
+
+
+}
+
+#endif /* UAF_HANDLEREGISTRY_H_ */
@@ -0,0 +1,401 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/database/pkistorecache.h"
+
+// STD
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::size_t;
+
+
+    // Mix the modification time and size of a file or directory into a fingerprint (FNV-1a)
+    // =============================================================================================
+    static void addToFingerprint(uint64_t& fingerprint, const string& path)
+    {
+        uint64_t values[4] = { 0, 0, 0, 0 };
+
+#ifdef _WIN32
+        // _stat64 doesn't accept a trailing separator for a directory
+        string trimmedPath(path);
+        while (trimmedPath.size() > 1
+               && (trimmedPath[trimmedPath.size() - 1] == '/'
+                   || trimmedPath[trimmedPath.size() - 1] == '\\'))
+            trimmedPath.erase(trimmedPath.size() - 1);
+
+        struct __stat64 st;
+        if (::_stat64(trimmedPath.c_str(), &st) == 0)
+        {
+            values[0] = 1;
+            values[1] = uint64_t(st.st_mtime);
+            values[3] = uint64_t(st.st_size);
+        }
+#else
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0)
+        {
+            values[0] = 1;
+            values[1] = uint64_t(st.st_mtime);
+#ifdef __linux__
+            values[2] = uint64_t(st.st_mtim.tv_nsec);
+#endif
+            values[3] = uint64_t(st.st_size);
+        }
+#endif
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            for (size_t j = 0; j < 8; j++)
+            {
+                fingerprint ^= (values[i] >> (8 * j)) & 0xFF;
+                fingerprint *= 1099511628211ULL;
+            }
+        }
+    }
+
+
+    // Mix a directory and the modification time and size of all its entries into a fingerprint
+    // =============================================================================================
+    static void addDirectoryToFingerprint(uint64_t& fingerprint, const string& path)
+    {
+        addToFingerprint(fingerprint, path);
+
+        // the path of an entry is the directory path, a separator and the name of the entry
+        string prefix(path);
+        if (!prefix.empty()
+                && prefix[prefix.size() - 1] != '/'
+                && prefix[prefix.size() - 1] != '\\')
+            prefix += '/';
+
+        std::vector<string> names;
+
+#ifdef _WIN32
+        string pattern = prefix + "*";
+
+        WIN32_FIND_DATAA findData;
+        HANDLE findHandle = ::FindFirstFileA(pattern.c_str(), &findData);
+        if (findHandle != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                names.push_back(findData.cFileName);
+            }
+            while (::FindNextFileA(findHandle, &findData));
+            ::FindClose(findHandle);
+        }
+#else
+        DIR* dir = ::opendir(path.c_str());
+        if (dir != 0)
+        {
+            for (struct dirent* entry = ::readdir(dir); entry != 0; entry = ::readdir(dir))
+                names.push_back(entry->d_name);
+            ::closedir(dir);
+        }
+#endif
+
+        // the order in which the entries are listed is not defined, so we sort them
+        std::sort(names.begin(), names.end());
+
+        for (std::vector<string>::const_iterator it = names.begin(); it != names.end(); ++it)
+        {
+            if (*it == "." || *it == "..")
+                continue;
+
+            for (size_t i = 0; i < it->size(); i++)
+            {
+                fingerprint ^= uint64_t((unsigned char)(*it)[i]);
+                fingerprint *= 1099511628211ULL;
+            }
+
+            addToFingerprint(fingerprint, prefix + *it);
+        }
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    PkiStoreCache::PkiStoreCache(LoggerFactory* loggerFactory)
+    : loadCount_(0),
+      hitCount_(0)
+    {
+        logger_ = new Logger(loggerFactory, "PkiStoreCache");
+        logger_->debug("The PKI store cache has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    PkiStoreCache::~PkiStoreCache()
+    {
+        logger_->debug("Destructing the PKI store cache");
+
+        clear();
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Get a (cached) PKI store
+    // =============================================================================================
+    Status PkiStoreCache::acquire(
+            const ClientSettings&   settings,
+            bool                    withClientCertificate,
+            SharedConst<PkiStore>&  store)
+    {
+        Status ret;
+
+        bool checkOnly = !settings.createSecurityLocationsIfNeeded;
+
+        string key = settings.certificateRevocationListLocation + "\n"
+                   + settings.certificateTrustListLocation + "\n"
+                   + settings.issuersRevocationListLocation + "\n"
+                   + settings.issuersCertificatesLocation + "\n"
+                   + (withClientCertificate
+                           ? settings.clientCertificate + "\n" + settings.clientPrivateKey
+                           : string());
+
+        // the store is loaded while the mutex is locked, so that the other sessions wait for it
+        // instead of loading the same files in parallel
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        // the locations are checked (and created) before the fingerprint is taken
+        ret = checkOrCreatePath(
+                checkOnly,
+                settings.certificateRevocationListLocation,
+                "certificate revocation list location");
+
+        if (ret.isGood())
+            ret = checkOrCreatePath(
+                    checkOnly,
+                    settings.certificateTrustListLocation,
+                    "certificate trust list location");
+
+        if (ret.isGood())
+            ret = checkOrCreatePath(
+                    checkOnly,
+                    settings.issuersRevocationListLocation,
+                    "issuers revocation trust list location");
+
+        if (ret.isGood())
+            ret = checkOrCreatePath(
+                    checkOnly,
+                    settings.issuersCertificatesLocation,
+                    "issuers certificates location");
+
+        if (ret.isGood() && withClientCertificate)
+            ret = checkOrCreatePath(true, settings.clientCertificate, "client certificate");
+
+        if (ret.isGood() && withClientCertificate)
+            ret = checkOrCreatePath(true, settings.clientPrivateKey, "client private key");
+
+        if (ret.isNotGood())
+            return ret;
+
+        // the files inside the directories are fingerprinted too, since a file that is overwritten
+        // in place (e.g. a refreshed revocation list) doesn't change the directory itself
+        uint64_t fingerprint = 14695981039346656037ULL;
+        addDirectoryToFingerprint(fingerprint, settings.certificateRevocationListLocation);
+        addDirectoryToFingerprint(fingerprint, settings.certificateTrustListLocation);
+        addDirectoryToFingerprint(fingerprint, settings.issuersRevocationListLocation);
+        addDirectoryToFingerprint(fingerprint, settings.issuersCertificatesLocation);
+        if (withClientCertificate)
+        {
+            addToFingerprint(fingerprint, settings.clientCertificate);
+            addToFingerprint(fingerprint, settings.clientPrivateKey);
+        }
+
+        Entries::iterator it = entries_.find(key);
+
+        if (it != entries_.end() && it->second.fingerprint == fingerprint)
+        {
+            logger_->debug("The cached PKI store is still up to date");
+            store = it->second.store;
+            hitCount_++;
+            return ret;
+        }
+
+        if (it == entries_.end())
+            logger_->debug("No PKI store was loaded yet for these settings");
+        else
+            logger_->debug("The PKI files have changed, so the PKI store is reloaded");
+
+        PkiStore* newStore = new PkiStore;
+
+        ret = load(settings, withClientCertificate, newStore->uaSecurity);
+
+        if (ret.isGood())
+        {
+            Entry& entry = entries_[key];
+            entry.store         = SharedConst<PkiStore>(newStore);
+            entry.fingerprint   = fingerprint;
+            store = entry.store;
+            loadCount_++;
+        }
+        else
+        {
+            delete newStore;
+        }
+
+        return ret;
+    }
+
+
+    // Load a new PKI store
+    // =============================================================================================
+    Status PkiStoreCache::load(
+            const ClientSettings&               settings,
+            bool                                withClientCertificate,
+            UaClientSdk::SessionSecurityInfo&   uaSecurity)
+    {
+        Status ret;
+
+        logger_->debug("Now initializing the OpenSSL PKI store via the SDK");
+        SdkStatus sdkStatus = uaSecurity.initializePkiProviderOpenSSL(
+                UaString(settings.certificateRevocationListLocation.c_str()),
+                UaString(settings.certificateTrustListLocation.c_str()),
+                UaString(settings.issuersRevocationListLocation.c_str()),
+                UaString(settings.issuersCertificatesLocation.c_str()));
+
+        if (sdkStatus.isGood())
+        {
+            logger_->debug("The OpenSSL PKI store was initialized successfully");
+            ret = statuscodes::Good;
+        }
+        else
+        {
+            ret = OpenSSLStoreInitializationError(sdkStatus);
+        }
+
+        if (ret.isGood() && withClientCertificate)
+        {
+            logger_->debug("Now loading the client certificate via the SDK");
+            sdkStatus = uaSecurity.loadClientCertificateOpenSSL(
+                    UaString(settings.clientCertificate.c_str()),
+                    UaString(settings.clientPrivateKey.c_str()));
+
+            if (sdkStatus.isGood())
+                logger_->debug("The client certificate was loaded successfully (%s)",
+                               sdkStatus.toString().c_str());
+            else
+                ret = ClientCertificateLoadingError(sdkStatus);
+        }
+
+        if (ret.isGood())
+            logger_->debug("The PKI store has been loaded");
+        else
+            logger_->error(ret.toString());
+
+        return ret;
+    }
+
+
+    // Check if a path exists, or create it
+    // =============================================================================================
+    Status PkiStoreCache::checkOrCreatePath(
+            bool checkOnly, const string& path, const string& description) const
+    {
+        Status ret;
+
+        logger_->debug("Checking %s: %s", description.c_str(), path.c_str());
+        UaDir helperDir(UaUniString(""));
+        if (helperDir.exists(UaUniString(path.c_str())))
+        {
+            ret = statuscodes::Good;
+            logger_->debug("OK, the %s exists", description.c_str());
+        }
+        else
+        {
+            if (checkOnly)
+            {
+                ret = PathNotExistsError(path, description);
+                logger_->error(ret.toString());
+            }
+            else
+            {
+                logger_->debug("The path does not exist so we try to create it");
+                if (helperDir.mkpath(UaUniString(path.c_str())))
+                {
+                    ret = statuscodes::Good;
+                    logger_->debug("The %s has been created", path.c_str());
+                }
+                else
+                {
+                    ret = PathCreationError(path, description);
+                    logger_->error(ret.toString());
+                }
+            }
+        }
+
+        return ret;
+    }
+
+
+    // Clear the cache
+    // =============================================================================================
+    void PkiStoreCache::clear()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        entries_.clear();
+    }
+
+
+    // Get the number of cached PKI stores
+    // =============================================================================================
+    size_t PkiStoreCache::size()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return entries_.size();
+    }
+
+
+    // Get the number of loads
+    // =============================================================================================
+    uint64_t PkiStoreCache::loadCount()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return loadCount_;
+    }
+
+
+    // Get the number of hits
+    // =============================================================================================
+    uint64_t PkiStoreCache::hitCount()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return hitCount_;
+    }
+
+
+}
@@ -0,0 +1,197 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_PKISTORECACHE_H_
+#define UAF_PKISTORECACHE_H_
+
+
+// STD
+#include <string>
+#include <map>
+#include <stdint.h>
+// SDK
+#include "uabase/uamutex.h"
+#include "uabase/uadir.h"
+#include "uaclient/uaclientsdk.h"
+// UAF
+#include "uaf/util/status.h"
+#include "uaf/util/sdkstatus.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/sharedconst.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/settings/clientsettings.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::PkiStore holds an SDK SessionSecurityInfo of which the OpenSSL PKI provider has been
+    * initialized with the trust lists and revocation lists of the ClientSettings (and of which
+    * the client certificate and private key have been loaded, if needed).
+    *
+    * A PkiStore is never modified after it has been loaded, so it can be shared by all sessions:
+    * each connection attempt starts from a copy of its SessionSecurityInfo.
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    struct UAF_EXPORT PkiStore
+    {
+        /** The initialized security info. */
+        UaClientSdk::SessionSecurityInfo uaSecurity;
+    };
+
+
+    /*******************************************************************************************//**
+    * A uaf::PkiStoreCache loads the PKI store (see uaf::PkiStore) only once for all sessions,
+    * instead of once per connection attempt.
+    *
+    * A cached PKI store is reloaded as soon as one of its directories or files was modified,
+    * which is detected by comparing their modification times and sizes. The files inside the
+    * directories are compared as well, so adding, removing or renaming a certificate or
+    * revocation list is detected, and so is overwriting an existing one (e.g. a refreshed CRL).
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    class UAF_EXPORT PkiStoreCache
+    {
+    public:
+
+
+        /**
+         * Create a PKI store cache which logs to the specified logger factory.
+         *
+         * @param loggerFactory The logger factory to log to.
+         */
+        PkiStoreCache(uaf::LoggerFactory* loggerFactory);
+
+
+        /**
+         * Destruct the cache.
+         */
+        virtual ~PkiStoreCache();
+
+
+        /**
+         * Get the PKI store for the given settings, loading it only if it isn't cached yet or
+         * if its files have changed.
+         *
+         * The loading is done while the cache is locked, so when many sessions connect at the
+         * same time, only the first one loads the files and the others share the result.
+         *
+         * @param settings              The settings that define the PKI locations and the
+         *                              client certificate and private key.
+         * @param withClientCertificate True to load the client certificate and private key
+         *                              (only needed to sign or encrypt the messages).
+         * @param store                 Output parameter: the shared PKI store.
+         * @return                      Good if the store could be loaded (or was cached).
+         */
+        uaf::Status acquire(
+                const uaf::ClientSettings&      settings,
+                bool                            withClientCertificate,
+                uaf::SharedConst<uaf::PkiStore>& store);
+
+
+        /**
+         * Clear the cache, so that the PKI stores are loaded again when they are acquired (e.g.
+         * because a certificate was added to the trust list).
+         *
+         * The stores that are still being used by the sessions are not affected.
+         */
+        void clear();
+
+
+        /**
+         * Get the number of cached PKI stores.
+         *
+         * @return  The number of cached PKI stores.
+         */
+        std::size_t size();
+
+
+        /**
+         * Get the number of times that a PKI store was loaded from disk.
+         *
+         * @return  The number of loads.
+         */
+        uint64_t loadCount();
+
+
+        /**
+         * Get the number of times that a cached PKI store could be used without loading it.
+         *
+         * @return  The number of hits.
+         */
+        uint64_t hitCount();
+
+
+    private:
+        // no copying or assigning allowed
+        DISALLOW_COPY_AND_ASSIGN(PkiStoreCache);
+
+
+        // check if a path exists, or create the path if needed
+        uaf::Status checkOrCreatePath(
+                bool                checkOnly,
+                const std::string&  path,
+                const std::string&  description) const;
+
+
+        // load a new PKI store
+        uaf::Status load(
+                const uaf::ClientSettings&          settings,
+                bool                                withClientCertificate,
+                UaClientSdk::SessionSecurityInfo&   uaSecurity);
+
+
+        /** A cached PKI store, and the fingerprint of its files when it was loaded. */
+        struct Entry
+        {
+            Entry() : fingerprint(0) {}
+            uaf::SharedConst<uaf::PkiStore> store;
+            uint64_t                        fingerprint;
+        };
+
+        /** The entries are stored by the concatenation of their paths. */
+        typedef std::map<std::string, Entry> Entries;
+
+
+        /** The logger of the PKI store cache. */
+        uaf::Logger* logger_;
+
+        /** The cached PKI stores. */
+        Entries entries_;
+
+        /** The number of loads. */
+        uint64_t loadCount_;
+
+        /** The number of hits. */
+        uint64_t hitCount_;
+
+        /** The mutex to safely manipulate (and load) the entries. */
+        UaMutex mutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_PKISTORECACHE_H_ */
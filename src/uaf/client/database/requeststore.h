@@ -32,6 +32,7 @@
 #include "uaf/util/logger.h"
 #include "uaf/util/status.h"
 #include "uaf/util/mask.h"
+#include "uaf/util/sharedconst.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/clientservices.h"
 
@@ -54,10 +55,13 @@ namespace uaf
         typedef _Service                   ServiceType;
         typedef typename _Service::Request RequestType;
         typedef typename _Service::Result  ResultType;
+        typedef uaf::SharedConst<RequestType> SharedRequestType;
 
 
         /***************************************************************************************//**
          * A request store item holds the request, the result and a mask of the targets.
+         *
+         * The request is immutable, so it is shared (not copied) by all copies of the item.
         *******************************************************************************************/
         struct Item
         {
@@ -65,20 +69,28 @@ namespace uaf
              * Construct an Item from a given request, result and the mask specifying the
              * targets that need to be re-processed.
              */
-            Item(const RequestType& request,
-                 const ResultType&  result,
-                 const uaf::Mask&   badTargetsMask)
-            : request(request), result(result), badTargetsMask(badTargetsMask) {}
+            Item(const SharedRequestType&   request,
+                 const ResultType&          result,
+                 const uaf::Mask&           badTargetsMask)
+            : request(request),
+              result(result),
+              badTargetsMask(badTargetsMask),
+              removedTargetsMask(result.targets.size())
+            {}
 
 
             /** The original persistent request. */
-            RequestType request;
+            SharedRequestType request;
 
             /** The result in it's current state. */
             ResultType  result;
 
             /** The mask specifying the bad targets (= the targets to be re-processed). */
             uaf::Mask   badTargetsMask;
+
+            /** The mask specifying the targets that have been removed (= the targets that must
+             *  never be re-processed anymore). */
+            uaf::Mask   removedTargetsMask;
         };
 
 
@@ -119,6 +131,58 @@ namespace uaf
         uaf::Status remove(uaf::RequestHandle handle);
 
 
+        /**
+         * Remove a single target of an item (e.g. because the monitored item it created has
+         * been deleted), so that it won't be re-processed anymore.
+         *
+         * When all targets of an item have been removed, the whole item is removed.
+         *
+         * @param handle        Handle of the item.
+         * @param targetRank    Rank of the target to be removed.
+         * @return              Good if the target could be removed,
+         *                      NoItemFoundForTheGivenRequestHandleError or
+         *                      TargetRankOutOfBoundsError if not.
+         */
+        uaf::Status removeTarget(uaf::RequestHandle handle, std::size_t targetRank);
+
+
+        /**
+         * Find the target that has the given client handle in its result (i.e. the target that
+         * created the monitored item with this client handle). Removed targets are never found.
+         *
+         * @param clientHandle  The client handle to search for.
+         * @param handle        Output parameter: the handle of the item that holds the target.
+         * @param targetRank    Output parameter: the rank of the target.
+         * @return              True if the target was found, false if not.
+         */
+        bool findTarget(
+                uaf::ClientHandle   clientHandle,
+                uaf::RequestHandle& handle,
+                std::size_t&        targetRank);
+
+
+        /**
+         * Modify some targets of an item (e.g. because the monitored items they created have
+         * been modified), so that they will be re-processed with the modified targets.
+         *
+         * The stored request is immutable (and may be shared), so it is copied once for all
+         * targets to be modified, and the modified copy replaces the stored request.
+         *
+         * @param handle        Handle of the item.
+         * @param targetRanks   Ranks of the targets to be modified.
+         * @param modifier      Functor that will be called with a (non-const) reference to each
+         *                      target to be modified.
+         * @return              Good if the targets could be modified,
+         *                      NoItemFoundForTheGivenRequestHandleError or
+         *                      TargetRankOutOfBoundsError if not.
+         */
+        template <typename _Modifier>
+        uaf::Status modifyTargets(
+                uaf::RequestHandle              handle,
+                const std::vector<std::size_t>& targetRanks,
+                const _Modifier&                modifier);
+
+
         /**
          * Get the item for a given handle.
          *
@@ -158,14 +222,33 @@ namespace uaf
          * Store a request and corresponding result, if a request with the same UAF handle doesn't
          * exist already.
          *
-         * @param request           Request to be stored.
+         * @param request           Request to be stored (it is shared, not copied).
          * @param result            Corresponding result to be stored.
          * @param badTargetsMask    Mask specifying which targets are 'Bad'.
          */
         uaf::Status storeIfNeeded(
-                const RequestType& request,
-                const ResultType&  result,
-                const uaf::Mask&   badTargetsMask);
+                const SharedRequestType&    request,
+                const ResultType&           result,
+                const uaf::Mask&            badTargetsMask);
+
+
+        /**
+         * Get the number of stored items.
+         *
+         * @return  The number of stored items.
+         */
+        std::size_t size();
+
+
+        /**
+         * Get the (approximate) number of bytes that are used by the stored items.
+         *
+         * Only the memory of the items themselves and of their vectors of targets is counted, not
+         * the memory that is owned by the targets (e.g. the memory of their strings).
+         *
+         * @return  The approximate number of bytes.
+         */
+        std::size_t memoryFootprint();
 
 
     private:
@@ -226,6 +309,10 @@ namespace uaf
     template <typename _Service>
     void RequestStore<_Service>::logCurrentState()
     {
+        // don't build the string representations of all requests for nothing
+        if (!logger_->isDebugEnabled())
+            return;
+
         logger_->debug("Current state:");
         UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
 
@@ -235,7 +322,7 @@ namespace uaf
             logger_->debug("Item %d:", it->first);
             logger_->debug(" - badTargetsMask: %s", it->second.badTargetsMask.toString().c_str());
             logger_->debug(" - request:");
-            logger_->debug(it->second.request.toString("   ", 39));
+            logger_->debug(it->second.request->toString("   ", 39));
             logger_->debug(" - result:");
             logger_->debug(it->second.result.toString("   ", 39));
         }
@@ -269,6 +356,126 @@ namespace uaf
     }
 
 
+    // Remove a target
+    // =============================================================================================
+    template <typename _Service>
+    uaf::Status RequestStore<_Service>::removeTarget(uaf::RequestHandle handle, std::size_t targetRank)
+    {
+        logger_->debug("Now removing target %d of handle %d", targetRank, handle);
+
+        uaf::Status ret;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        typename ItemsMap::iterator iter = itemsMap_.find(handle);
+
+        if (iter == itemsMap_.end())
+        {
+            ret = NoItemFoundForTheGivenRequestHandleError(handle);
+        }
+        else if (targetRank >= iter->second.removedTargetsMask.size())
+        {
+            ret = uaf::TargetRankOutOfBoundsError(targetRank, iter->second.removedTargetsMask.size());
+        }
+        else
+        {
+            iter->second.removedTargetsMask.set(targetRank);
+            iter->second.badTargetsMask.unset(targetRank);
+
+            // compact the store: an item without targets has no use anymore
+            if (iter->second.removedTargetsMask.unsetCount() == 0)
+            {
+                logger_->debug("All targets of handle %d have been removed, so the item is "
+                               "removed", handle);
+                itemsMap_.erase(iter);
+            }
+
+            ret = uaf::statuscodes::Good;
+        }
+
+        return ret;
+    }
+
+
+    // Find a target by its client handle
+    // =============================================================================================
+    template <typename _Service>
+    bool RequestStore<_Service>::findTarget(
+            uaf::ClientHandle   clientHandle,
+            uaf::RequestHandle& handle,
+            std::size_t&        targetRank)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        typedef typename ItemsMap::const_iterator Iter;
+        for (Iter it = itemsMap_.begin(); it != itemsMap_.end(); ++it)
+        {
+            for (std::size_t i = 0; i < it->second.result.targets.size(); i++)
+            {
+                if (it->second.result.targets[i].clientHandle == clientHandle
+                        && !it->second.removedTargetsMask.isSet(i))
+                {
+                    handle     = it->first;
+                    targetRank = i;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+
+    // Modify some targets
+    // =============================================================================================
+    template <typename _Service>
+    template <typename _Modifier>
+    uaf::Status RequestStore<_Service>::modifyTargets(
+            uaf::RequestHandle              handle,
+            const std::vector<std::size_t>& targetRanks,
+            const _Modifier&                modifier)
+    {
+        logger_->debug("Now modifying %d target(s) of handle %d", targetRanks.size(), handle);
+
+        uaf::Status ret;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        typename ItemsMap::iterator iter = itemsMap_.find(handle);
+
+        if (iter != itemsMap_.end())
+        {
+            ret = uaf::statuscodes::Good;
+
+            std::size_t noOfTargets = iter->second.request->targets.size();
+
+            for (std::size_t i = 0; i < targetRanks.size() && ret.isGood(); i++)
+            {
+                if (targetRanks[i] >= noOfTargets)
+                    ret = uaf::TargetRankOutOfBoundsError(targetRanks[i], noOfTargets);
+            }
+
+            if (ret.isGood())
+            {
+                // copy the request once, modify the copy and let it replace the stored request
+                // (other owners of the original request won't notice anything)
+                RequestType* modifiedRequest = new RequestType(*iter->second.request);
+
+                for (std::size_t i = 0; i < targetRanks.size(); i++)
+                    modifier(modifiedRequest->targets[targetRanks[i]]);
+
+                iter->second.request = SharedRequestType(modifiedRequest);
+            }
+        }
+        else
+        {
+            ret = NoItemFoundForTheGivenRequestHandleError(handle);
+        }
+
+        return ret;
+    }
+
+
     // Update the status of a target
     // =============================================================================================
     template <typename _Service>
@@ -288,7 +495,16 @@ namespace uaf
 
         if (iter != itemsMap_.end())
         {
-            if (targetRank < iter->second.result.targets.size())
+            if (targetRank >= iter->second.result.targets.size())
+            {
+                ret = uaf::TargetRankOutOfBoundsError(targetRank, iter->second.result.targets.size());
+            }
+            else if (iter->second.removedTargetsMask.isSet(targetRank))
+            {
+                // the target was removed, so it must not become 'bad' (and re-processed) again
+                ret = uaf::statuscodes::Good;
+            }
+            else
             {
                 iter->second.result.targets[targetRank].status = status;
                 if (status.isGood())
@@ -299,10 +515,6 @@ namespace uaf
                 // updated successfully:
                 ret = uaf::statuscodes::Good;
             }
-            else
-            {
-                ret = uaf::TargetRankOutOfBoundsError(targetRank, iter->second.result.targets.size());
-            }
         }
         else
         {
@@ -396,7 +608,10 @@ namespace uaf
                     it->second.result.targets[i] = result.targets[i];
 
                 // update the badTargetsMask, since we're iterating over the targets anyway
-                if (it->second.result.targets[i].status.isNotGood())
+                // (removed targets are never bad, since they must not be re-processed)
+                if (it->second.removedTargetsMask.isSet(i))
+                    it->second.badTargetsMask.unset(i);
+                else if (it->second.result.targets[i].status.isNotGood())
                     it->second.badTargetsMask.set(i);
                 else
                     it->second.badTargetsMask.unset(i);
@@ -417,9 +632,9 @@ namespace uaf
     // =============================================================================================
     template <typename _Service>
     uaf::Status RequestStore<_Service>::storeIfNeeded(
-            const RequestType& request,
-            const ResultType&  result,
-            const uaf::Mask&   badTargetsMask)
+            const SharedRequestType&    request,
+            const ResultType&           result,
+            const uaf::Mask&            badTargetsMask)
     {
         logger_->debug("Storing the request and result if needed");
 
@@ -452,6 +667,49 @@ namespace uaf
 
 
 
+    // Get the number of stored items
+    // =============================================================================================
+    template <typename _Service>
+    std::size_t RequestStore<_Service>::size()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return itemsMap_.size();
+    }
+
+
+    // Get the approximate number of bytes used by the stored items
+    // =============================================================================================
+    template <typename _Service>
+    std::size_t RequestStore<_Service>::memoryFootprint()
+    {
+        typedef typename RequestType::TargetType RequestTargetType;
+        typedef typename ResultType::TargetType  ResultTargetType;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        std::size_t ret = sizeof(*this);
+
+        typedef typename ItemsMap::const_iterator Iter;
+        for (Iter it = itemsMap_.begin(); it != itemsMap_.end(); ++it)
+        {
+            // the map node (value + the pointers and color of the tree node)
+            ret += sizeof(typename ItemsMap::value_type) + 4 * sizeof(void*);
+
+            // the request (which is shared, but the store is usually its only owner)
+            if (!it->second.request.isNull())
+                ret += sizeof(RequestType)
+                     + it->second.request->targets.capacity() * sizeof(RequestTargetType);
+
+            // the result and the masks
+            ret += it->second.result.targets.capacity() * sizeof(ResultTargetType)
+                 + (it->second.badTargetsMask.size() + it->second.removedTargetsMask.size()) / 8;
+        }
+
+        return ret;
+    }
+
+
+
     /*******************************************************************************************//**
     * A CreateMonitoredDataRequestStore is used to re-create monitored data items after failures.
     *
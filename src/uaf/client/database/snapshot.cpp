@@ -0,0 +1,834 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/database/snapshot.h"
+
+// STD
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+// platform
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::map;
+    using std::size_t;
+
+
+    // The magic string at the start of each snapshot file (8 bytes, including the terminating 0).
+    static const char SNAPSHOT_MAGIC[8] = "UAFSNAP";
+
+    // The version of the file format that is written by this class.
+    static const uint32_t SNAPSHOT_VERSION = 1;
+
+
+    // =============================================================================================
+    // Encoding
+    // =============================================================================================
+
+
+    // Encode an unsigned integer of the given number of bytes (little endian)
+    // =============================================================================================
+    static void encodeUInt(string& buffer, uint64_t value, size_t noOfBytes)
+    {
+        for (size_t i = 0; i < noOfBytes; i++)
+            buffer.push_back(char((value >> (8 * i)) & 0xFF));
+    }
+
+
+    // Encode a boolean
+    // =============================================================================================
+    static void encodeBool(string& buffer, bool value)
+    {
+        encodeUInt(buffer, value ? 1 : 0, 1);
+    }
+
+
+    // Encode a number of elements
+    // =============================================================================================
+    static void encodeCount(string& buffer, size_t count)
+    {
+        encodeUInt(buffer, count, 4);
+    }
+
+
+    // Encode a string (length + bytes)
+    // =============================================================================================
+    static void encodeString(string& buffer, const string& value)
+    {
+        encodeCount(buffer, value.size());
+        buffer.append(value);
+    }
+
+
+    // Encode a vector of strings
+    // =============================================================================================
+    static void encodeStrings(string& buffer, const vector<string>& values)
+    {
+        encodeCount(buffer, values.size());
+        for (size_t i = 0; i < values.size(); i++)
+            encodeString(buffer, values[i]);
+    }
+
+
+    // Encode a ByteString
+    // =============================================================================================
+    static void encodeByteString(string& buffer, const ByteString& value)
+    {
+        encodeCount(buffer, size_t(value.length()));
+        if (value.length() > 0)
+            buffer.append(reinterpret_cast<const char*>(value.data()), size_t(value.length()));
+    }
+
+
+    // Encode a LocalizedText
+    // =============================================================================================
+    static void encodeLocalizedText(string& buffer, const LocalizedText& value)
+    {
+        encodeString(buffer, value.locale());
+        encodeString(buffer, value.text());
+    }
+
+
+    // Encode a NodeId
+    // =============================================================================================
+    static void encodeNodeId(string& buffer, const NodeId& value)
+    {
+        NodeIdIdentifier identifier = value.identifier();
+
+        encodeUInt(buffer, uint64_t(identifier.type), 1);
+        switch (identifier.type)
+        {
+            case nodeididentifiertypes::Identifier_Numeric:
+                encodeUInt(buffer, identifier.idNumeric, 4);
+                break;
+            case nodeididentifiertypes::Identifier_String:
+                encodeString(buffer, identifier.idString);
+                break;
+            case nodeididentifiertypes::Identifier_Guid:
+                encodeString(buffer, identifier.idGuid.toString());
+                break;
+            case nodeididentifiertypes::Identifier_Opaque:
+                encodeByteString(buffer, identifier.idOpaque);
+                break;
+        }
+
+        encodeBool(buffer, value.hasNameSpaceIndex());
+        encodeUInt(buffer, value.nameSpaceIndex(), 2);
+        encodeBool(buffer, value.hasNameSpaceUri());
+        if (value.hasNameSpaceUri())
+            encodeString(buffer, value.nameSpaceUri());
+    }
+
+
+    // Encode an ExpandedNodeId
+    // =============================================================================================
+    static void encodeExpandedNodeId(string& buffer, const ExpandedNodeId& value)
+    {
+        encodeNodeId(buffer, value.nodeId());
+        encodeBool(buffer, value.hasServerIndex());
+        encodeUInt(buffer, value.serverIndex(), 4);
+        encodeBool(buffer, value.hasServerUri());
+        if (value.hasServerUri())
+            encodeString(buffer, value.serverUri());
+    }
+
+
+    // Encode a QualifiedName
+    // =============================================================================================
+    static void encodeQualifiedName(string& buffer, const QualifiedName& value)
+    {
+        encodeString(buffer, value.name());
+        encodeBool(buffer, value.hasNameSpaceIndex());
+        encodeUInt(buffer, value.nameSpaceIndex(), 2);
+        encodeBool(buffer, value.hasNameSpaceUri());
+        if (value.hasNameSpaceUri())
+            encodeString(buffer, value.nameSpaceUri());
+    }
+
+
+    // Encode an Address (recursively, if it's a relative path)
+    // =============================================================================================
+    static void encodeAddress(string& buffer, const Address& value)
+    {
+        encodeBool(buffer, value.isRelativePath());
+
+        if (value.isRelativePath())
+        {
+            encodeAddress(buffer, *value.getStartingAddress());
+
+            vector<RelativePathElement> relativePath = value.getRelativePath();
+            encodeCount(buffer, relativePath.size());
+            for (size_t i = 0; i < relativePath.size(); i++)
+            {
+                encodeQualifiedName(buffer, relativePath[i].targetName);
+                encodeNodeId(buffer, relativePath[i].referenceType);
+                encodeBool(buffer, relativePath[i].isInverse);
+                encodeBool(buffer, relativePath[i].includeSubtypes);
+            }
+        }
+        else
+        {
+            encodeExpandedNodeId(buffer, value.getExpandedNodeId());
+        }
+    }
+
+
+    // Encode an ApplicationDescription
+    // =============================================================================================
+    static void encodeApplicationDescription(string& buffer, const ApplicationDescription& value)
+    {
+        encodeString(buffer, value.applicationUri);
+        encodeString(buffer, value.productUri);
+        encodeLocalizedText(buffer, value.applicationName);
+        encodeUInt(buffer, uint64_t(value.applicationType), 1);
+        encodeString(buffer, value.gatewayServerUri);
+        encodeString(buffer, value.discoveryProfileUri);
+        encodeStrings(buffer, value.discoveryUrls);
+    }
+
+
+    // Encode an EndpointDescription
+    // =============================================================================================
+    static void encodeEndpointDescription(string& buffer, const EndpointDescription& value)
+    {
+        encodeString(buffer, value.endpointUrl);
+        encodeApplicationDescription(buffer, value.server);
+        encodeByteString(buffer, value.serverCertificate);
+        encodeUInt(buffer, uint64_t(value.securityMode), 1);
+        encodeString(buffer, value.securityPolicyUri);
+        encodeCount(buffer, value.userIdentityTokens.size());
+        for (size_t i = 0; i < value.userIdentityTokens.size(); i++)
+        {
+            const UserTokenPolicy& policy = value.userIdentityTokens[i];
+            encodeString(buffer, policy.policyId);
+            encodeUInt(buffer, uint64_t(policy.tokenType), 1);
+            encodeString(buffer, policy.issuedTokenType);
+            encodeString(buffer, policy.issuerEndpointUrl);
+            encodeString(buffer, policy.securityPolicyUri);
+        }
+        encodeString(buffer, value.transportProfileUri);
+        encodeUInt(buffer, value.securityLevel, 1);
+    }
+
+
+    // Encode a StructureDefinition (the fields of the base types are included)
+    // =============================================================================================
+    static void encodeStructureDefinition(string& buffer, const StructureDefinition& value)
+    {
+        encodeNodeId(buffer, value.dataTypeId());
+        encodeString(buffer, value.name());
+        encodeLocalizedText(buffer, value.documentation());
+        encodeString(buffer, value.getNamespace());
+        encodeNodeId(buffer, value.baseTypeId());
+        encodeNodeId(buffer, value.binaryEncodingId());
+        encodeNodeId(buffer, value.xmlEncodingId());
+
+        encodeCount(buffer, size_t(value.childrenCount()));
+        for (int i = 0; i < value.childrenCount(); i++)
+        {
+            StructureField field = value.child(i);
+            encodeString(buffer, field.name());
+            encodeLocalizedText(buffer, field.documentation());
+            encodeNodeId(buffer, field.typeId());
+            encodeUInt(buffer, uint64_t(field.valueType()), 2);
+            encodeUInt(buffer, uint64_t(field.arrayType()), 1);
+        }
+    }
+
+
+    // =============================================================================================
+    // Decoding
+    // =============================================================================================
+
+
+    /**
+     * A SnapshotDecoder reads the encoded values from a buffer. As soon as a value can not be
+     * decoded (because the buffer is too short), the decoder is marked as failed and all
+     * subsequent values are decoded as zeros/empty values.
+     */
+    struct SnapshotDecoder
+    {
+        SnapshotDecoder(const char* data, size_t length)
+        : position(data), end(data + length), failed(false)
+        {}
+
+        const char* position;
+        const char* end;
+        bool        failed;
+
+        // Check if the given number of bytes is available
+        bool available(uint64_t noOfBytes)
+        {
+            if (!failed && noOfBytes > uint64_t(end - position))
+                failed = true;
+            return !failed;
+        }
+    };
+
+
+    // Decode an unsigned integer of the given number of bytes (little endian)
+    // =============================================================================================
+    static uint64_t decodeUInt(SnapshotDecoder& decoder, size_t noOfBytes)
+    {
+        uint64_t ret = 0;
+        if (decoder.available(noOfBytes))
+        {
+            for (size_t i = 0; i < noOfBytes; i++)
+                ret |= uint64_t(uint8_t(decoder.position[i])) << (8 * i);
+            decoder.position += noOfBytes;
+        }
+        return ret;
+    }
+
+
+    // Decode a boolean
+    // =============================================================================================
+    static bool decodeBool(SnapshotDecoder& decoder)
+    {
+        return decodeUInt(decoder, 1) != 0;
+    }
+
+
+    // Decode a number of elements (which can never exceed the number of remaining bytes, so a
+    // corrupt count doesn't make us allocate huge vectors)
+    // =============================================================================================
+    static size_t decodeCount(SnapshotDecoder& decoder)
+    {
+        uint64_t count = decodeUInt(decoder, 4);
+        if (!decoder.available(count))
+            return 0;
+        return size_t(count);
+    }
+
+
+    // Decode a string
+    // =============================================================================================
+    static string decodeString(SnapshotDecoder& decoder)
+    {
+        string ret;
+        size_t length = decodeCount(decoder);
+        if (length > 0)
+        {
+            ret.assign(decoder.position, length);
+            decoder.position += length;
+        }
+        return ret;
+    }
+
+
+    // Decode a vector of strings
+    // =============================================================================================
+    static vector<string> decodeStrings(SnapshotDecoder& decoder)
+    {
+        vector<string> ret;
+        size_t count = decodeCount(decoder);
+        ret.reserve(count);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+            ret.push_back(decodeString(decoder));
+        return ret;
+    }
+
+
+    // Decode a ByteString
+    // =============================================================================================
+    static ByteString decodeByteString(SnapshotDecoder& decoder)
+    {
+        size_t length = decodeCount(decoder);
+        if (length == 0)
+            return ByteString();
+
+        vector<uint8_t> bytes(decoder.position, decoder.position + length);
+        decoder.position += length;
+        return ByteString(int32_t(length), &bytes[0]);
+    }
+
+
+    // Decode a LocalizedText
+    // =============================================================================================
+    static LocalizedText decodeLocalizedText(SnapshotDecoder& decoder)
+    {
+        string locale = decodeString(decoder);
+        string text   = decodeString(decoder);
+        if (locale.empty() && text.empty())
+            return LocalizedText();
+        return LocalizedText(locale, text);
+    }
+
+
+    // Decode a NodeId
+    // =============================================================================================
+    static NodeId decodeNodeId(SnapshotDecoder& decoder)
+    {
+        NodeIdIdentifier identifier;
+
+        switch (decodeUInt(decoder, 1))
+        {
+            case nodeididentifiertypes::Identifier_Numeric:
+                identifier = NodeIdIdentifier(uint32_t(decodeUInt(decoder, 4)));
+                break;
+            case nodeididentifiertypes::Identifier_String:
+                identifier = NodeIdIdentifier(decodeString(decoder));
+                break;
+            case nodeididentifiertypes::Identifier_Guid:
+                identifier = NodeIdIdentifier(Guid(decodeString(decoder)));
+                break;
+            case nodeididentifiertypes::Identifier_Opaque:
+                identifier = NodeIdIdentifier(decodeByteString(decoder));
+                break;
+            default:
+                decoder.failed = true;
+        }
+
+        bool            hasIndex = decodeBool(decoder);
+        NameSpaceIndex  index    = NameSpaceIndex(decodeUInt(decoder, 2));
+        bool            hasUri   = decodeBool(decoder);
+        string          uri      = hasUri ? decodeString(decoder) : string();
+
+        if (hasIndex && hasUri)
+            return NodeId(identifier, uri, index);
+        else if (hasUri)
+            return NodeId(identifier, uri);
+        else if (hasIndex || !identifier.isNull())
+            return NodeId(identifier, index);
+        else
+            return NodeId();
+    }
+
+
+    // Decode an ExpandedNodeId
+    // =============================================================================================
+    static ExpandedNodeId decodeExpandedNodeId(SnapshotDecoder& decoder)
+    {
+        NodeId      nodeId   = decodeNodeId(decoder);
+        bool        hasIndex = decodeBool(decoder);
+        ServerIndex index    = ServerIndex(decodeUInt(decoder, 4));
+        bool        hasUri   = decodeBool(decoder);
+
+        ExpandedNodeId ret;
+        if (hasIndex)
+            ret = ExpandedNodeId(nodeId, index);
+        else
+            ret.setNodeId(nodeId);
+        if (hasUri)
+            ret.setServerUri(decodeString(decoder));
+        return ret;
+    }
+
+
+    // Decode a QualifiedName
+    // =============================================================================================
+    static QualifiedName decodeQualifiedName(SnapshotDecoder& decoder)
+    {
+        QualifiedName ret(decodeString(decoder));
+        bool     hasIndex = decodeBool(decoder);
+        uint16_t index    = uint16_t(decodeUInt(decoder, 2));
+        if (hasIndex)
+            ret.setNameSpaceIndex(index);
+        if (decodeBool(decoder))
+            ret.setNameSpaceUri(decodeString(decoder));
+        return ret;
+    }
+
+
+    // Decode an Address
+    // =============================================================================================
+    static Address decodeAddress(SnapshotDecoder& decoder, size_t depth = 0)
+    {
+        if (!decodeBool(decoder))
+            return Address(decodeExpandedNodeId(decoder));
+
+        // a relative path can never be nested that deeply, so the file must be corrupt
+        if (depth > 1000)
+        {
+            decoder.failed = true;
+            return Address();
+        }
+
+        Address startingAddress = decodeAddress(decoder, depth + 1);
+
+        vector<RelativePathElement> relativePath;
+        size_t count = decodeCount(decoder);
+        relativePath.reserve(count);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+        {
+            QualifiedName   targetName      = decodeQualifiedName(decoder);
+            NodeId          referenceType   = decodeNodeId(decoder);
+            bool            isInverse       = decodeBool(decoder);
+            bool            includeSubtypes = decodeBool(decoder);
+            relativePath.push_back(
+                    RelativePathElement(targetName, referenceType, isInverse, includeSubtypes));
+        }
+
+        return Address(&startingAddress, relativePath);
+    }
+
+
+    // Decode an ApplicationDescription
+    // =============================================================================================
+    static ApplicationDescription decodeApplicationDescription(SnapshotDecoder& decoder)
+    {
+        ApplicationDescription ret;
+        ret.applicationUri      = decodeString(decoder);
+        ret.productUri          = decodeString(decoder);
+        ret.applicationName     = decodeLocalizedText(decoder);
+        ret.applicationType     = applicationtypes::ApplicationType(decodeUInt(decoder, 1));
+        ret.gatewayServerUri    = decodeString(decoder);
+        ret.discoveryProfileUri = decodeString(decoder);
+        ret.discoveryUrls       = decodeStrings(decoder);
+        return ret;
+    }
+
+
+    // Decode an EndpointDescription
+    // =============================================================================================
+    static EndpointDescription decodeEndpointDescription(SnapshotDecoder& decoder)
+    {
+        EndpointDescription ret;
+        ret.endpointUrl         = decodeString(decoder);
+        ret.server              = decodeApplicationDescription(decoder);
+        ret.serverCertificate   = decodeByteString(decoder);
+        ret.securityMode        = messagesecuritymodes::MessageSecurityMode(decodeUInt(decoder, 1));
+        ret.securityPolicyUri   = decodeString(decoder);
+
+        size_t count = decodeCount(decoder);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+        {
+            UserTokenPolicy policy;
+            policy.policyId             = decodeString(decoder);
+            policy.tokenType            = usertokentypes::UserTokenType(decodeUInt(decoder, 1));
+            policy.issuedTokenType      = decodeString(decoder);
+            policy.issuerEndpointUrl    = decodeString(decoder);
+            policy.securityPolicyUri    = decodeString(decoder);
+            ret.userIdentityTokens.push_back(policy);
+        }
+
+        ret.transportProfileUri = decodeString(decoder);
+        ret.securityLevel       = uint8_t(decodeUInt(decoder, 1));
+        return ret;
+    }
+
+
+    // Decode a StructureDefinition
+    // =============================================================================================
+    static StructureDefinition decodeStructureDefinition(SnapshotDecoder& decoder)
+    {
+        StructureDefinition ret;
+        ret.setDataTypeId(decodeNodeId(decoder));
+        ret.setName(decodeString(decoder));
+        ret.setDocumentation(decodeLocalizedText(decoder));
+        ret.setNamespace(decodeString(decoder));
+
+        // the fields of the base type were encoded as fields of the definition itself, so the
+        // base type only needs to tell its NodeId
+        NodeId baseTypeId = decodeNodeId(decoder);
+        if (!baseTypeId.isNull())
+        {
+            StructureDefinition baseType;
+            baseType.setDataTypeId(baseTypeId);
+            ret.setBaseType(baseType);
+        }
+
+        ret.setBinaryEncodingId(decodeNodeId(decoder));
+        ret.setXmlEncodingId(decodeNodeId(decoder));
+
+        size_t count = decodeCount(decoder);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+        {
+            StructureField field;
+            field.setName(decodeString(decoder));
+            field.setDocumentation(decodeLocalizedText(decoder));
+            field.setDataTypeId(decodeNodeId(decoder));
+            field.setValueType(opcuatypes::OpcUaType(decodeUInt(decoder, 2)));
+            field.setArrayType(StructureField::ArrayType(decodeUInt(decoder, 1)));
+            ret.addChild(field);
+        }
+
+        return ret;
+    }
+
+
+    // =============================================================================================
+    // Snapshot
+    // =============================================================================================
+
+
+    // Constructor
+    // =============================================================================================
+    Snapshot::Snapshot()
+    {}
+
+
+    // Clear the snapshot
+    // =============================================================================================
+    void Snapshot::clear()
+    {
+        discoveryUrls.clear();
+        serverDescriptions.clear();
+        endpointDescriptions.clear();
+        namespaceArrays.clear();
+        addresses.clear();
+        expandedNodeIds.clear();
+        definitionServerUris.clear();
+        definitionDataTypeIds.clear();
+        definitions.clear();
+    }
+
+
+    // Encode the snapshot
+    // =============================================================================================
+    void Snapshot::encode(string& buffer) const
+    {
+        buffer.clear();
+        buffer.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        encodeUInt(buffer, SNAPSHOT_VERSION, 4);
+
+        // section 1: discovery
+        encodeStrings(buffer, discoveryUrls);
+        encodeCount(buffer, serverDescriptions.size());
+        for (size_t i = 0; i < serverDescriptions.size(); i++)
+            encodeApplicationDescription(buffer, serverDescriptions[i]);
+
+        // section 2: endpoints
+        encodeCount(buffer, endpointDescriptions.size());
+        for (map<string, vector<EndpointDescription> >::const_iterator it
+                = endpointDescriptions.begin(); it != endpointDescriptions.end(); ++it)
+        {
+            encodeString(buffer, it->first);
+            encodeCount(buffer, it->second.size());
+            for (size_t i = 0; i < it->second.size(); i++)
+                encodeEndpointDescription(buffer, it->second[i]);
+        }
+
+        // section 3: namespace arrays
+        encodeCount(buffer, namespaceArrays.size());
+        for (map<string, NameSpaceMap>::const_iterator it = namespaceArrays.begin();
+             it != namespaceArrays.end();
+             ++it)
+        {
+            encodeString(buffer, it->first);
+            encodeCount(buffer, it->second.size());
+            for (NameSpaceMap::const_iterator uri = it->second.begin();
+                 uri != it->second.end();
+                 ++uri)
+            {
+                encodeUInt(buffer, uri->first, 2);
+                encodeString(buffer, uri->second);
+            }
+        }
+
+        // section 4: addresses
+        encodeCount(buffer, addresses.size());
+        for (size_t i = 0; i < addresses.size(); i++)
+        {
+            encodeAddress(buffer, addresses[i]);
+            encodeExpandedNodeId(buffer, expandedNodeIds[i]);
+        }
+
+        // section 5: structure definitions (unions are skipped, because a StructureDefinition
+        // can't be turned into a union again when it's decoded)
+        size_t noOfStructures = 0;
+        for (size_t i = 0; i < definitions.size(); i++)
+            if (!definitions[i].isUnion())
+                noOfStructures++;
+
+        encodeCount(buffer, noOfStructures);
+        for (size_t i = 0; i < definitions.size(); i++)
+        {
+            if (definitions[i].isUnion())
+                continue;
+
+            encodeString(buffer, definitionServerUris[i]);
+            encodeNodeId(buffer, definitionDataTypeIds[i]);
+            encodeStructureDefinition(buffer, definitions[i]);
+        }
+    }
+
+
+    // Decode the snapshot
+    // =============================================================================================
+    bool Snapshot::decode(const char* data, size_t length)
+    {
+        clear();
+
+        SnapshotDecoder decoder(data, length);
+
+        if (   !decoder.available(sizeof(SNAPSHOT_MAGIC))
+            || std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+            return false;
+        decoder.position += sizeof(SNAPSHOT_MAGIC);
+
+        // we only read the version that we write (a different version is simply ignored, the
+        // client will then rediscover the system as if there was no snapshot)
+        if (decodeUInt(decoder, 4) != SNAPSHOT_VERSION)
+            return false;
+
+        // section 1: discovery
+        discoveryUrls = decodeStrings(decoder);
+        size_t count = decodeCount(decoder);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+            serverDescriptions.push_back(decodeApplicationDescription(decoder));
+
+        // section 2: endpoints
+        count = decodeCount(decoder);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+        {
+            vector<EndpointDescription>& endpoints = endpointDescriptions[decodeString(decoder)];
+            size_t noOfEndpoints = decodeCount(decoder);
+            for (size_t j = 0; j < noOfEndpoints && !decoder.failed; j++)
+                endpoints.push_back(decodeEndpointDescription(decoder));
+        }
+
+        // section 3: namespace arrays
+        count = decodeCount(decoder);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+        {
+            NameSpaceMap& nameSpaceMap = namespaceArrays[decodeString(decoder)];
+            size_t noOfUris = decodeCount(decoder);
+            for (size_t j = 0; j < noOfUris && !decoder.failed; j++)
+            {
+                NameSpaceIndex index = NameSpaceIndex(decodeUInt(decoder, 2));
+                nameSpaceMap[index] = decodeString(decoder);
+            }
+        }
+
+        // section 4: addresses
+        count = decodeCount(decoder);
+        addresses.reserve(count);
+        expandedNodeIds.reserve(count);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+        {
+            addresses.push_back(decodeAddress(decoder));
+            expandedNodeIds.push_back(decodeExpandedNodeId(decoder));
+        }
+
+        // section 5: structure definitions
+        count = decodeCount(decoder);
+        for (size_t i = 0; i < count && !decoder.failed; i++)
+        {
+            definitionServerUris.push_back(decodeString(decoder));
+            definitionDataTypeIds.push_back(decodeNodeId(decoder));
+            definitions.push_back(decodeStructureDefinition(decoder));
+        }
+
+        if (decoder.failed)
+            clear();
+
+        return !decoder.failed;
+    }
+
+
+    // Write the snapshot to a file
+    // =============================================================================================
+    bool Snapshot::writeToFile(const string& fileName) const
+    {
+        string buffer;
+        encode(buffer);
+
+        string tmpFileName = fileName + ".tmp";
+
+        std::ofstream file(tmpFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        file.write(buffer.data(), std::streamsize(buffer.size()));
+        file.close();
+
+        if (!file)
+        {
+            std::remove(tmpFileName.c_str());
+            return false;
+        }
+
+#ifdef _WIN32
+        // on Windows, rename() fails if the destination exists
+        return ::MoveFileExA(tmpFileName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return std::rename(tmpFileName.c_str(), fileName.c_str()) == 0;
+#endif
+    }
+
+
+    // Read the snapshot from a file
+    // =============================================================================================
+    bool Snapshot::readFromFile(const string& fileName)
+    {
+        bool ret = false;
+
+        clear();
+
+#ifdef _WIN32
+        HANDLE file = ::CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (::GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        {
+            HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping != NULL)
+            {
+                const void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (data != NULL)
+                {
+                    ret = decode(static_cast<const char*>(data), size_t(size.QuadPart));
+                    ::UnmapViewOfFile(data);
+                }
+                ::CloseHandle(mapping);
+            }
+        }
+        ::CloseHandle(file);
+#else
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* data = ::mmap(NULL, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                ret = decode(static_cast<const char*>(data), size_t(st.st_size));
+                ::munmap(data, size_t(st.st_size));
+            }
+        }
+        ::close(fd);
+#endif
+
+        return ret;
+    }
+
+
+}
@@ -0,0 +1,151 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SNAPSHOT_H_
+#define UAF_SNAPSHOT_H_
+
+
+// STD
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/address.h"
+#include "uaf/util/expandednodeid.h"
+#include "uaf/util/nodeid.h"
+#include "uaf/util/namespacearray.h"
+#include "uaf/util/structuredefinition.h"
+#include "uaf/util/applicationdescription.h"
+#include "uaf/util/endpointdescription.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::Snapshot holds the information that a client gathered about the system (the
+    * discovered servers and their endpoints, the namespace arrays, the cached addresses and the
+    * cached structure definitions), so that it can be written to a file and be loaded by a new
+    * client ("warm start").
+    *
+    * The file has a compact binary format: a magic string and a version number, followed by
+    * one section per kind of information. All integers are stored in little endian byte order,
+    * so the file can be exchanged between platforms. The file is read through a read-only
+    * memory mapping, so only the pages that are actually decoded need to be loaded.
+    *
+    * A snapshot does not validate its contents: that's done by the client, when the sessions
+    * connect (see uaf::ClientSettings::snapshotFileName).
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    class UAF_EXPORT Snapshot
+    {
+    public:
+
+
+        /**
+         * Create an empty snapshot.
+         */
+        Snapshot();
+
+
+        /**
+         * Clear the snapshot.
+         */
+        void clear();
+
+
+        /**
+         * Write the snapshot to a file.
+         *
+         * The file is first written under a temporary name, and then renamed, so that a
+         * client that is killed while writing never leaves a truncated snapshot behind.
+         *
+         * @param fileName  The name of the file.
+         * @return          True if the file was written.
+         */
+        bool writeToFile(const std::string& fileName) const;
+
+
+        /**
+         * Read the snapshot from a file.
+         *
+         * @param fileName  The name of the file.
+         * @return          True if the file could be read. False if the file doesn't exist,
+         *                  has another version or is corrupt (the snapshot is then empty).
+         */
+        bool readFromFile(const std::string& fileName);
+
+
+        /**
+         * Encode the snapshot into a buffer (in the format of the file).
+         *
+         * @param buffer    The buffer to write the encoded snapshot to.
+         */
+        void encode(std::string& buffer) const;
+
+
+        /**
+         * Decode the snapshot from a buffer (in the format of the file).
+         *
+         * @param data      Pointer to the first byte of the encoded snapshot.
+         * @param length    The number of bytes that are available.
+         * @return          True if the buffer could be decoded. If not, the snapshot is empty.
+         */
+        bool decode(const char* data, std::size_t length);
+
+
+        /** The discovery URLs that were used to find the servers. */
+        std::vector<std::string> discoveryUrls;
+
+        /** The application descriptions of the servers that were found. */
+        std::vector<uaf::ApplicationDescription> serverDescriptions;
+
+        /** The endpoint descriptions, per discovery URL. */
+        std::map<std::string, std::vector<uaf::EndpointDescription> > endpointDescriptions;
+
+        /** The namespace arrays, per server URI. */
+        std::map<std::string, uaf::NameSpaceMap> namespaceArrays;
+
+        /** The cached addresses. */
+        std::vector<uaf::Address> addresses;
+
+        /** The resolved ExpandedNodeIds of the cached addresses (same size as addresses). */
+        std::vector<uaf::ExpandedNodeId> expandedNodeIds;
+
+        /** The server URIs of the cached structure definitions. */
+        std::vector<std::string> definitionServerUris;
+
+        /** The datatype NodeIds of the cached structure definitions (as they were looked up). */
+        std::vector<uaf::NodeId> definitionDataTypeIds;
+
+        /** The cached structure definitions (same size as definitionServerUris). */
+        std::vector<uaf::StructureDefinition> definitions;
+    };
+
+
+}
+
+
+#endif /* UAF_SNAPSHOT_H_ */
@@ -0,0 +1,206 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/database/structuredefinitioncache.h"
+
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::map;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    StructureDefinitionCache::StructureDefinitionCache(LoggerFactory* loggerFactory)
+    : hits_(0),
+      misses_(0)
+    {
+        logger_ = new Logger(loggerFactory, "StructDefCache");
+        logger_->debug("The structure definition cache has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    StructureDefinitionCache::~StructureDefinitionCache()
+    {
+        logger_->debug("Destructing the structure definition cache");
+
+        clear();
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Remove all items from the cache
+    // =============================================================================================
+    void StructureDefinitionCache::clear()
+    {
+        logger_->info("Clearing the structure definition cache");
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        cache_.clear();
+    }
+
+
+    // Remove all items from the cache with the given server URI
+    // =============================================================================================
+    void StructureDefinitionCache::clear(const string& serverUri)
+    {
+        logger_->info("Clearing the cached structure definitions for ServerUri '%s'",
+                      serverUri.c_str());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        Cache::iterator it = cache_.begin();
+        while(it != cache_.end())
+        {
+            if (it->first.first == serverUri)
+                cache_.erase(it++);
+            else
+                ++it;
+        }
+    }
+
+
+    // Add a compiled structure definition to the cache
+    // =============================================================================================
+    void StructureDefinitionCache::add(
+            const string&           serverUri,
+            const NodeId&           dataTypeId,
+            const StructureCodec&   codec)
+    {
+        logger_->debug("Caching the structure definition of %s (ServerUri '%s')",
+                       dataTypeId.toString().c_str(), serverUri.c_str());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        cache_[Key(serverUri, dataTypeId)] = codec;
+    }
+
+
+    // Find a compiled structure definition of a particular server
+    // =============================================================================================
+    bool StructureDefinitionCache::find(
+            const string&   serverUri,
+            const NodeId&   dataTypeId,
+            StructureCodec& codec)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        Cache::const_iterator iter = cache_.find(Key(serverUri, dataTypeId));
+
+        bool found = (iter != cache_.end());
+
+        if (found)
+        {
+            codec = iter->second;
+            hits_++;
+        }
+        else
+        {
+            misses_++;
+        }
+
+        return found;
+    }
+
+
+    // Find a compiled structure definition of any server
+    // =============================================================================================
+    bool StructureDefinitionCache::find(const NodeId& dataTypeId, StructureCodec& codec)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        for (Cache::const_iterator iter = cache_.begin(); iter != cache_.end(); ++iter)
+        {
+            if (iter->first.second == dataTypeId)
+            {
+                codec = iter->second;
+                hits_++;
+                return true;
+            }
+        }
+
+        misses_++;
+        return false;
+    }
+
+
+    // Get a copy of all cached entries
+    // =============================================================================================
+    void StructureDefinitionCache::entries(
+            vector<string>&                 serverUris,
+            vector<NodeId>&                 dataTypeIds,
+            vector<StructureDefinition>&    definitions)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        serverUris.clear();
+        dataTypeIds.clear();
+        definitions.clear();
+
+        for (Cache::const_iterator it = cache_.begin(); it != cache_.end(); ++it)
+        {
+            serverUris.push_back(it->first.first);
+            dataTypeIds.push_back(it->first.second);
+            definitions.push_back(it->second.definition());
+        }
+    }
+
+
+    // Get the number of cached entries
+    // =============================================================================================
+    std::size_t StructureDefinitionCache::size()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return cache_.size();
+    }
+
+
+    // Get the number of lookups
+    // =============================================================================================
+    void StructureDefinitionCache::lookupCounts(uint64_t& hits, uint64_t& misses)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        hits   = hits_;
+        misses = misses_;
+    }
+
+
+    // Get the approximate number of bytes used by the cache
+    // =============================================================================================
+    std::size_t StructureDefinitionCache::memoryFootprint()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        // each map node holds the value, plus the pointers and color of the tree node
+        return sizeof(*this) + cache_.size() * (sizeof(Cache::value_type) + 4 * sizeof(void*));
+    }
+
+}
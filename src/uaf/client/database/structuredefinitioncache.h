@@ -0,0 +1,202 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_STRUCTUREDEFINITIONCACHE_H_
+#define UAF_STRUCTUREDEFINITIONCACHE_H_
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <utility>
+#include <stdint.h>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/nodeid.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/structurecodec.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::StructureDefinitionCache stores the structure definitions of the servers, so that
+    * they only have to be fetched (and compiled into a uaf::StructureCodec) once per server
+    * and datatype.
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    class UAF_EXPORT StructureDefinitionCache
+    {
+    public:
+
+
+        /**
+         * Create a structure definition cache which logs to the specified logger factory.
+         *
+         * @param loggerFactory The logger factory to log to.
+         */
+        StructureDefinitionCache(uaf::LoggerFactory* loggerFactory);
+
+
+        /**
+         * Destruct the cache.
+         */
+        virtual ~StructureDefinitionCache();
+
+
+        /**
+         * Clear the cache.
+         */
+        void clear();
+
+
+        /**
+         * Remove all cached definitions that belong to the given server URI.
+         */
+        void clear(const std::string& serverUri);
+
+
+        /**
+         * Add a compiled structure definition to the cache.
+         *
+         * @param serverUri     The URI of the server that exposes the datatype.
+         * @param dataTypeId    The NodeId of the datatype.
+         * @param codec         The codec, compiled for the definition of the datatype.
+         */
+        void add(
+                const std::string&          serverUri,
+                const uaf::NodeId&          dataTypeId,
+                const uaf::StructureCodec&  codec);
+
+
+        /**
+         * Find the compiled structure definition of a datatype of a particular server.
+         *
+         * @param serverUri     The URI of the server that exposes the datatype.
+         * @param dataTypeId    The NodeId of the datatype.
+         * @param codec         The found codec (if the definition was cached of course).
+         * @return              True if the definition was found, false if not.
+         */
+        bool find(
+                const std::string&  serverUri,
+                const uaf::NodeId&  dataTypeId,
+                uaf::StructureCodec& codec);
+
+
+        /**
+         * Find the compiled structure definition of a datatype of any server.
+         *
+         * @param dataTypeId    The NodeId of the datatype.
+         * @param codec         The found codec (if the definition was cached of course).
+         * @return              True if the definition was found, false if not.
+         */
+        bool find(const uaf::NodeId& dataTypeId, uaf::StructureCodec& codec);
+
+
+        /**
+         * Get a copy of all cached structure definitions (e.g. to write them to a snapshot).
+         *
+         * @param serverUris    Output parameter: the URIs of the servers that expose the datatypes.
+         * @param dataTypeIds   Output parameter: the NodeIds of the datatypes.
+         * @param definitions   Output parameter: the definitions of the datatypes.
+         */
+        void entries(
+                std::vector<std::string>&               serverUris,
+                std::vector<uaf::NodeId>&               dataTypeIds,
+                std::vector<uaf::StructureDefinition>&  definitions);
+
+
+        /**
+         * Get the number of cached structure definitions.
+         *
+         * @return  The number of cached structure definitions.
+         */
+        std::size_t size();
+
+
+        /**
+         * Get the number of structure definitions that were looked up in the cache (by find())
+         * since the cache was created.
+         *
+         * @param hits      Output parameter: the number of definitions that were found.
+         * @param misses    Output parameter: the number of definitions that were not found.
+         */
+        void lookupCounts(uint64_t& hits, uint64_t& misses);
+
+
+        /**
+         * Get the (approximate) number of bytes that are used by the cache.
+         *
+         * Only the memory of the cached entries themselves is counted, not the memory that is
+         * owned by them (e.g. the memory of their strings).
+         *
+         * @return  The approximate number of bytes.
+         */
+        std::size_t memoryFootprint();
+
+
+
+    private:
+
+
+        // no copying or assigning allowed
+        DISALLOW_COPY_AND_ASSIGN(StructureDefinitionCache);
+
+
+        // private typedefs
+
+
+        /** A key consists of the server URI and the datatype NodeId. */
+        typedef std::pair<std::string, uaf::NodeId> Key;
+
+        /** A cache stores the compiled definitions for each key. */
+        typedef std::map<Key, uaf::StructureCodec> Cache;
+
+
+        // private members
+
+
+        /** The logger of the structure definition cache. */
+        uaf::Logger* logger_;
+
+        /** The map containing the cached definitions. */
+        Cache cache_;
+
+        /** The number of definitions that were found by find(). */
+        uint64_t hits_;
+
+        /** The number of definitions that were not found by find(). */
+        uint64_t misses_;
+
+        /** The mutex to safely manipulate the map. */
+        UaMutex mutex_;
+
+    };
+
+}
+
+
+#endif /* UAF_STRUCTUREDEFINITIONCACHE_H_ */
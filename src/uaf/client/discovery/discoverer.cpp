@@ -34,7 +34,8 @@ namespace uaf
     // =============================================================================================
     Discoverer::Discoverer(LoggerFactory* loggerFactory, Database* database)
     : database_(database),
-      findServersBusy_(false)
+      findServersBusy_(false),
+      transportFactory_(0)
     {
         logger_ = new Logger(loggerFactory, "Discoverer");
         logger_->info("The discoverer has been constructed");
@@ -186,6 +187,15 @@ namespace uaf
     {
         Status ret;
 
+        // a server of the session transport factory doesn't need to be discovered
+        endpointsMutex_.lock();
+        bool isKnownByTransport = transportFactory_ != 0
+                               && transportFactory_->discoveryUrls(serverUri, discoveryUrls);
+        endpointsMutex_.unlock();
+
+        if (isKnownByTransport)
+            return statuscodes::Good;
+
         std::vector<std::string> knownServerUris;
 
         std::vector<uaf::ApplicationDescription>::const_iterator it;
@@ -220,6 +230,78 @@ namespace uaf
     }
 
 
+    // Preload the results of an earlier discovery
+    // =============================================================================================
+    void Discoverer::preload(
+            const vector<ApplicationDescription>&               serverDescriptions,
+            const map<string, vector<EndpointDescription> >&    endpointDescriptions)
+    {
+        logger_->debug("Preloading %d server description(s) and the endpoints of %d URL(s)",
+                       serverDescriptions.size(), endpointDescriptions.size());
+
+        findServersBusyMutex_.lock();
+        if (!findServersBusy_ && serverDescriptions_.empty())
+            serverDescriptions_ = serverDescriptions;
+        findServersBusyMutex_.unlock();
+
+        UaMutexLocker locker(&endpointsMutex_); // unlocks when locker goes out of scope
+        preloadedEndpoints_ = endpointDescriptions;
+        knownEndpoints_.insert(endpointDescriptions.begin(), endpointDescriptions.end());
+    }
+
+
+    // Use the preloaded endpoint descriptions (only once)
+    // =============================================================================================
+    bool Discoverer::usePreloadedEndpoints(
+            const string&                   discoveryUrl,
+            vector<EndpointDescription>&    endpointDescriptions)
+    {
+        UaMutexLocker locker(&endpointsMutex_); // unlocks when locker goes out of scope
+
+        map<string, vector<EndpointDescription> >::iterator it
+                = preloadedEndpoints_.find(discoveryUrl);
+
+        if (it == preloadedEndpoints_.end() || it->second.empty())
+            return false;
+
+        endpointDescriptions.insert(endpointDescriptions.end(),
+                                    it->second.begin(),
+                                    it->second.end());
+        preloadedEndpoints_.erase(it);
+        return true;
+    }
+
+
+    // Take the endpoint descriptions of the session transport factory
+    // =============================================================================================
+    bool Discoverer::useTransportEndpoints(
+            const string&                   discoveryUrl,
+            vector<EndpointDescription>&    endpointDescriptions)
+    {
+        UaMutexLocker locker(&endpointsMutex_); // unlocks when locker goes out of scope
+        return transportFactory_ != 0
+            && transportFactory_->endpoints(discoveryUrl, endpointDescriptions);
+    }
+
+
+    // Set the factory of the session transports
+    // =============================================================================================
+    void Discoverer::setSessionTransportFactory(SessionTransportFactory* transportFactory)
+    {
+        UaMutexLocker locker(&endpointsMutex_); // unlocks when locker goes out of scope
+        transportFactory_ = transportFactory;
+    }
+
+
+    // Get the latest endpoint descriptions
+    // =============================================================================================
+    map<string, vector<EndpointDescription> > Discoverer::knownEndpoints()
+    {
+        UaMutexLocker locker(&endpointsMutex_); // unlocks when locker goes out of scope
+        return knownEndpoints_;
+    }
+
+
     // Update the endpoint descriptions
     // =============================================================================================
     Status Discoverer::getEndpoints(
@@ -237,6 +319,18 @@ namespace uaf
             ret = EmptyUrlError();
             logger_->error(ret.toString());
         }
+        else if (usePreloadedEndpoints(discoveryUrl, endpointDescriptions))
+        {
+            logger_->debug("Using the %d preloaded endpoint(s) instead of invoking the service",
+                           endpointDescriptions.size());
+            ret = statuscodes::Good;
+        }
+        else if (useTransportEndpoints(discoveryUrl, endpointDescriptions))
+        {
+            logger_->debug("Using the %d endpoint(s) of the session transport factory instead "
+                           "of invoking the service", endpointDescriptions.size());
+            ret = statuscodes::Good;
+        }
         else
         {
             // create the SDK variables
@@ -279,6 +373,10 @@ namespace uaf
                         logger_->debug(" - endpoint[%d]", i);
                         logger_->debug(string("   ") + endpointDescriptions[i].toString("   "));
                     }
+
+                    // remember them, so they can be written to a snapshot
+                    UaMutexLocker locker(&endpointsMutex_); // unlocks when out of scope
+                    knownEndpoints_[discoveryUrl] = endpointDescriptions;
                 }
                 else
                 {
@@ -25,6 +25,7 @@
 // STD
 #include <vector>
 #include <string>
+#include <map>
 #include <ctime>
 // SDK
 #include "uaclient/uaclientsdk.h"
@@ -37,6 +38,7 @@
 #include "uaf/util/endpointdescription.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/database/database.h"
+#include "uaf/client/transport/sessiontransportfactory.h"
 
 
 namespace uaf
@@ -100,6 +102,32 @@ namespace uaf
                 std::vector<uaf::EndpointDescription>&  endpointDescriptions);
 
 
+        /**
+         * Preload the results of an earlier discovery (e.g. from a warm-start snapshot), so that
+         * sessions can be connected before the FindServers and GetEndpoints services were invoked.
+         *
+         * The preloaded server descriptions are only used if no servers were found yet, and they
+         * are replaced by the results of the next findServers(). The preloaded endpoint
+         * descriptions of a discovery URL are used only once: the next getEndpoints() for the
+         * same URL invokes the GetEndpoints service again.
+         *
+         * @param serverDescriptions    The application descriptions of the servers.
+         * @param endpointDescriptions  The endpoint descriptions, per discovery URL.
+         */
+        void preload(
+                const std::vector<uaf::ApplicationDescription>& serverDescriptions,
+                const std::map<std::string, std::vector<uaf::EndpointDescription> >&
+                    endpointDescriptions);
+
+
+        /**
+         * Get the endpoint descriptions that were gotten (or preloaded) most recently.
+         *
+         * @return  The endpoint descriptions, per discovery URL.
+         */
+        std::map<std::string, std::vector<uaf::EndpointDescription> > knownEndpoints();
+
+
         /**
          * Get a const reference to the servers that were found.
          *
@@ -108,11 +136,31 @@ namespace uaf
         const std::vector<uaf::ApplicationDescription>& serversFound() const;
 
 
+        /**
+         * Set the factory of the session transports. The discovery URLs and endpoints that this
+         * factory knows (e.g. those of an in-process server) are used without invoking any
+         * service.
+         *
+         * @param transportFactory  The factory (not owned by the discoverer), or NULL.
+         */
+        void setSessionTransportFactory(uaf::SessionTransportFactory* transportFactory);
+
+
     private:
 
         // no copying or assigning allowed
         DISALLOW_COPY_AND_ASSIGN(Discoverer);
 
+        // take the preloaded endpoint descriptions of the given URL, if there are any
+        bool usePreloadedEndpoints(
+                const std::string&                      discoveryUrl,
+                std::vector<uaf::EndpointDescription>&  endpointDescriptions);
+
+        // take the endpoint descriptions of the session transport factory, if it knows the URL
+        bool useTransportEndpoints(
+                const std::string&                      discoveryUrl,
+                std::vector<uaf::EndpointDescription>&  endpointDescriptions);
+
 
         // the logger of the discoverer
         uaf::Logger* logger_;
@@ -124,6 +172,16 @@ namespace uaf
         UaMutex findServersBusyMutex_;
         // the latest application descriptions
         std::vector<uaf::ApplicationDescription> serverDescriptions_;
+
+        // the endpoint descriptions per discovery URL that may be used (once) instead of
+        // invoking the GetEndpoints service
+        std::map<std::string, std::vector<uaf::EndpointDescription> > preloadedEndpoints_;
+        // the latest endpoint descriptions per discovery URL
+        std::map<std::string, std::vector<uaf::EndpointDescription> > knownEndpoints_;
+        // the factory of the session transports, or NULL
+        uaf::SessionTransportFactory* transportFactory_;
+        // mutex to access the endpoint descriptions and the session transport factory
+        UaMutex endpointsMutex_;
         // UaDiscovery instance
         UaClientSdk::UaDiscovery uaDiscovery_;
     };
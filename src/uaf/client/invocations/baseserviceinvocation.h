@@ -39,6 +39,8 @@
 #include "uaf/client/requests/requests.h"
 #include "uaf/client/results/results.h"
 #include "uaf/client/settings/allsettings.h"
+#include "uaf/client/metrics/tracetimer.h"
+#include "uaf/client/transport/sessiontransport.h"
 
 
 
@@ -90,7 +92,8 @@ namespace uaf
         : asynchronous_(async),
           transactionId_(0),
           requestHandle_(requestHandle),
-          invocationLevel_(uaf::SessionLevel)
+          invocationLevel_(uaf::SessionLevel),
+          trace_(NULL)
         {}
 
 
@@ -127,7 +130,7 @@ namespace uaf
         std::vector<_ResultTarget>&         resultTargets()               { return resultTargets_; }
 
         /** Get the rank for each target. */
-        const std::vector<std::size_t>      ranks()                 const { return ranks_; }
+        const std::vector<std::size_t>&     ranks()                 const { return ranks_; }
 
         /** Is the request asynchronous? */
         bool                                asynchronous()          const { return asynchronous_; }
@@ -135,6 +138,9 @@ namespace uaf
         /** Get the level at which the service should be invoked. */
         uaf::InvocationLevel               invocationLevel()       const { return invocationLevel_; }
 
+        /** Get the trace of the request, or NULL if the request is not traced. */
+        uaf::RequestTrace*                  trace()                 const { return trace_; }
+
 
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
@@ -144,6 +150,60 @@ namespace uaf
         ///@{
 
 
+        /** Reserve room for the given number of targets, so they can be added without
+         *  reallocating (and therefore copying) the targets that were already added. */
+        void reserveTargets(std::size_t noOfTargets)
+        {
+            ranks_.reserve(noOfTargets);
+            requestTargets_.reserve(noOfTargets);
+            if (asynchronous_)
+                asyncResultTargets_.reserve(noOfTargets);
+            else
+                resultTargets_.reserve(noOfTargets);
+        }
+
+
+        /**
+         * Clear the invocation, so that it can be reused for another request (see
+         * uaf::InvocationPool).
+         *
+         * The vectors of targets keep their capacity, so a reused invocation does not need to
+         * allocate them again, unless they were grown beyond the given maximum number of
+         * targets (in which case their memory is released, so that a single huge request does
+         * not keep a huge invocation alive).
+         *
+         * @param maxRetainedTargets    The maximum number of targets to keep room for.
+         */
+        void clear(std::size_t maxRetainedTargets)
+        {
+            asynchronous_   = false;
+            transactionId_  = 0;
+            requestHandle_  = uaf::constants::REQUESTHANDLE_NOT_ASSIGNED;
+            trace_          = NULL;
+
+            if (ranks_.capacity() > maxRetainedTargets)
+            {
+                std::vector<std::size_t>().swap(ranks_);
+                std::vector<_RequestTarget>().swap(requestTargets_);
+                std::vector<_ResultTarget>().swap(resultTargets_);
+                std::vector<uaf::AsyncResultTarget>().swap(asyncResultTargets_);
+            }
+            else
+            {
+                ranks_.clear();
+                requestTargets_.clear();
+                resultTargets_.clear();
+                asyncResultTargets_.clear();
+            }
+
+            serviceSettings_         = _ServiceSettings();
+            sessionInformation_      = uaf::SessionInformation();
+            subscriptionInformation_ = uaf::SubscriptionInformation();
+
+            clearSdkData();
+        }
+
+
         /** Add the targets with the given rank to the service invocation. */
         void addTarget(
                 std::size_t             rank,
@@ -180,6 +240,10 @@ namespace uaf
         void setTransactionId(uaf::TransactionId transactionId)
         { transactionId_ = transactionId; }
 
+        /** Set the trace to which the stages of the invocation are added (or NULL). */
+        void setTrace(uaf::RequestTrace* trace)
+        { trace_ = trace; }
+
 
         /** Provide the information about the session. */
         void setSessionInformation(const uaf::SessionInformation& sessionInformation)
@@ -214,14 +278,14 @@ namespace uaf
         /**
          * Invoke the service at the session level.
          *
-         * @param uaSession         Pointer to the SDK session object.
+         * @param uaSession         Pointer to the session transport.
          * @param nameSpaceArray    The namespace array of the session.
          * @param serverArray       The server array of the session.
          * @param logger            Pointer to a logger.
          * @return                  Bad if the session could not be invoked.
          */
         uaf::Status invoke(
-                UaClientSdk::UaSession*     uaSession,
+                uaf::SessionTransport*      uaSession,
                 const uaf::NamespaceArray&  nameSpaceArray,
                 const uaf::ServerArray&     serverArray,
                 uaf::Logger*                logger)
@@ -230,39 +294,48 @@ namespace uaf
 
             logger->debug("Invoking the service at the session level");
 
+            const std::string* serverUri = &sessionInformation_.serverUri;
+
             if (asynchronous_)
             {
                 logger->debug("Copying the data from the asynchronous UAF request to the SDK level");
+                uaf::TraceTimer toSdkTimer(trace_, "toSdk", serverUri);
                 ret = fromAsyncUafToSdk(
                         requestTargets_,
                         serviceSettings_,
                         nameSpaceArray,
                         serverArray);
+                toSdkTimer.stop();
 
                 if (ret.isGood())
                 {
                     logger->debug("Invoking the asynchronous request at the SDK level");
+                    uaf::TraceTimer sdkCallTimer(trace_, "sdkCall", serverUri);
                     ret = invokeAsyncSdkService(uaSession, transactionId_);
                 }
             }
             else
             {
                 logger->debug("Copying the data from the synchronous UAF request to the SDK level");
+                uaf::TraceTimer toSdkTimer(trace_, "toSdk", serverUri);
                 ret = fromSyncUafToSdk(
                         requestTargets_,
                         serviceSettings_,
                         nameSpaceArray,
                         serverArray);
+                toSdkTimer.stop();
 
                 if (ret.isGood())
                 {
                     logger->debug("Invoking the synchronous request at the SDK level");
+                    uaf::TraceTimer sdkCallTimer(trace_, "sdkCall", serverUri);
                     ret = invokeSyncSdkService(uaSession);
                 }
 
                 if (ret.isGood())
                 {
                     logger->debug("Copying the data from SDK level to the UAF result");
+                    uaf::TraceTimer fromSdkTimer(trace_, "fromSdk", serverUri);
                     ret = fromSyncSdkToUaf(nameSpaceArray, serverArray, resultTargets_);
                 }
             }
@@ -282,14 +355,14 @@ namespace uaf
         /**
          * Invoke the service at the subscription level.
          *
-         * @param uaSubscription    Pointer to the SDK subscription object.
+         * @param uaSubscription    Pointer to the subscription transport.
          * @param nameSpaceArray    The namespace array of the session.
          * @param serverArray       The server array of the session.
          * @param logger            Pointer to a logger.
          * @return                  Bad if the session could not be invoked.
          */
         uaf::Status invoke(
-                UaClientSdk::UaSubscription* uaSubscription,
+                uaf::SubscriptionTransport*  uaSubscription,
                 const uaf::NamespaceArray&   nameSpaceArray,
                 const uaf::ServerArray&      serverArray,
                 uaf::Logger*                 logger)
@@ -298,39 +371,48 @@ namespace uaf
 
             logger->debug("Invoking the service at the subscription level");
 
+            const std::string* serverUri = &sessionInformation_.serverUri;
+
             if (this->asynchronous())
             {
                 logger->debug("Copying the data from the asynchronous UAF request to the SDK level");
+                uaf::TraceTimer toSdkTimer(trace_, "toSdk", serverUri);
                 ret = this->fromAsyncUafToSdk(
                         this->requestTargets(),
                         this->serviceSettings(),
                         nameSpaceArray,
                         serverArray);
+                toSdkTimer.stop();
 
                 if (ret.isGood())
                 {
                     logger->debug("Invoking the asynchronous request at the SDK level");
+                    uaf::TraceTimer sdkCallTimer(trace_, "sdkCall", serverUri);
                     ret = this->invokeAsyncSdkService(uaSubscription, this->transactionId());
                 }
             }
             else
             {
                 logger->debug("Copying the data from the synchronous UAF request to the SDK level");
+                uaf::TraceTimer toSdkTimer(trace_, "toSdk", serverUri);
                 ret = this->fromSyncUafToSdk(
                         this->requestTargets(),
                         this->serviceSettings(),
                         nameSpaceArray,
                         serverArray);
+                toSdkTimer.stop();
 
                 if (ret.isGood())
                 {
                     logger->debug("Invoking the synchronous request at the SDK level");
+                    uaf::TraceTimer sdkCallTimer(trace_, "sdkCall", serverUri);
                     ret = this->invokeSyncSdkService(uaSubscription);
                 }
 
                 if (ret.isGood())
                 {
                     logger->debug("Copying the data from SDK level to the UAF result");
+                    uaf::TraceTimer fromSdkTimer(trace_, "fromSdk", serverUri);
                     ret = this->fromSyncSdkToUaf(nameSpaceArray, serverArray, this->resultTargets());
                 }
             }
@@ -415,8 +497,12 @@ namespace uaf
                     result.targets[rank] = resultTargets_[i];
                     result.targets[rank].clientConnectionId
                         = sessionInformation_.clientConnectionId;
-                    result.targets[rank].clientSubscriptionHandle
-                        = subscriptionInformation_.clientSubscriptionHandle;
+                    // if the targets were spread over several subscriptions, each result target
+                    // already holds the handle of its own subscription
+                    if (subscriptionInformation_.clientSubscriptionHandle
+                            != uaf::constants::CLIENTSUBSCRIPTIONHANDLE_NOT_ASSIGNED)
+                        result.targets[rank].clientSubscriptionHandle
+                            = subscriptionInformation_.clientSubscriptionHandle;
                 }
                 else
                 {
@@ -527,6 +613,16 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(BaseServiceInvocation);
 
 
+        /**
+         * Clear the SDK data members of the invocation, when it is cleared to be reused.
+         *
+         * These are virtual functions, meant to be overwritten by the concrete services that
+         * have SDK data members: any data that is not set again by the next invocation must be
+         * reset here.
+         */
+        virtual void clearSdkData() {}
+
+
 
         /**
          * Copy the synchronous request data from the UAF objects to the SDK objects.
@@ -588,12 +684,12 @@ namespace uaf
          * These are virtual functions, meant to be overwritten by the concrete services that
          * implement them.
          *
-         * @param uaSession     Pointer to the SDK session object that will be used for the
+         * @param uaSession     Pointer to the session transport that will be used for the
          *                      invocation.
          * @return              Good if the service could be invoked, bad if not.
          */
         virtual uaf::Status invokeSyncSdkService(
-                UaClientSdk::UaSession*     uaSession)
+                uaf::SessionTransport*      uaSession)
         {
             if (asynchronous_ || (invocationLevel_ != SessionLevel))
                 return uaf::Status(uaf::UnexpectedError("Method is not supposed to be called!"));
@@ -608,13 +704,13 @@ namespace uaf
          * These are virtual functions, meant to be overwritten by the concrete services that
          * implement them.
          *
-         * @param uaSession     Pointer to the SDK session object that will be used for the
+         * @param uaSession     Pointer to the session transport that will be used for the
          *                      invocation.
          * @param transactionId Transaction id of the asynchronous call.
          * @return              Good if the service could be invoked, bad if not.
          */
         virtual uaf::Status invokeAsyncSdkService(
-                UaClientSdk::UaSession*     uaSession,
+                uaf::SessionTransport*      uaSession,
                 uaf::TransactionId          transactionId)
         {
             if (!asynchronous_ || (invocationLevel_ != SessionLevel))
@@ -630,12 +726,12 @@ namespace uaf
          * These are virtual functions, meant to be overwritten by the concrete services that
          * implement them.
          *
-         * @param uaSubscription    Pointer to the SDK subscription object that will be used for the
+         * @param uaSubscription    Pointer to the subscription transport that will be used for the
          *                          invocation.
          * @return                  Good if the service could be invoked, bad if not.
          */
         virtual uaf::Status invokeSyncSdkService(
-                UaClientSdk::UaSubscription*    uaSubscription)
+                uaf::SubscriptionTransport*     uaSubscription)
         {
             if (asynchronous_ || (invocationLevel_ != SubscriptionLevel))
                 return uaf::Status(uaf::UnexpectedError("Method is not supposed to be called!"));
@@ -650,13 +746,13 @@ namespace uaf
          * These are virtual functions, meant to be overwritten by the concrete services that
          * implement them.
          *
-         * @param uaSubscription    Pointer to the SDK subscription object that will be used for the
+         * @param uaSubscription    Pointer to the subscription transport that will be used for the
          *                          invocation.
          * @param transactionId     Transaction id of the asynchronous call.
          * @return                  Good if the service could be invoked, bad if not.
          */
         virtual uaf::Status invokeAsyncSdkService(
-                UaClientSdk::UaSubscription*    uaSubscription,
+                uaf::SubscriptionTransport*     uaSubscription,
                 uaf::TransactionId              transactionId)
         {
             if (!asynchronous_ || (invocationLevel_ != SubscriptionLevel))
@@ -713,6 +809,8 @@ namespace uaf
         uaf::SubscriptionInformation subscriptionInformation_;
         // the level at which the service should be invoked
         uaf::InvocationLevel       invocationLevel_;
+        // the trace of the request, or NULL if the request is not traced
+        uaf::RequestTrace*         trace_;
 
     };
 
@@ -130,7 +130,7 @@ namespace uaf
 
     // Invoke the service synchronously
     // =============================================================================================
-    Status BrowseInvocation::invokeSyncSdkService(UaClientSdk::UaSession* uaSession)
+    Status BrowseInvocation::invokeSyncSdkService(uaf::SessionTransport* uaSession)
     {
         Status ret;
 
@@ -220,9 +220,11 @@ namespace uaf
 
                     if (OpcUa_IsGood(uaBrowseResults_[rank].StatusCode))
                     {
-                        // update the continuation point
-                        UaByteString(uaNextResults[iNext].ContinuationPoint).copyTo(
-                                &uaBrowseResults_[rank].ContinuationPoint);
+                        // move the continuation point (the next results are left empty)
+                        OpcUa_ByteString_Clear(&uaBrowseResults_[rank].ContinuationPoint);
+                        uaBrowseResults_[rank].ContinuationPoint
+                                = uaNextResults[iNext].ContinuationPoint;
+                        OpcUa_ByteString_Initialize(&uaNextResults[iNext].ContinuationPoint);
 
                         // now we want to append the BrowseNext results to the existing Browse
                         // results. This requires some memory copying
@@ -245,16 +247,13 @@ namespace uaf
                         // create a shortcut to the ReferenceDescriptions
                         OpcUa_ReferenceDescription* ref = uaNextResults[iNext].References;
 
-                        // now copy the data from the BrowseNext call to the new data array:
+                        // now move the data from the BrowseNext call to the new data array
+                        // (the moved ReferenceDescriptions are left empty, so that they are not
+                        // cleared twice)
                         for (uint32_t i=0, j=oldDataLength; i<nextDataLength; i++, j++)
                         {
-                            newData[j].IsForward = ref[i].IsForward;
-                            newData[j].NodeClass = ref[i].NodeClass;
-                            UaQualifiedName(ref[i].BrowseName).copyTo(&newData[j].BrowseName);
-                            UaLocalizedText(ref[i].DisplayName).copyTo(&newData[j].DisplayName);
-                            UaExpandedNodeId(ref[i].NodeId).copyTo(&newData[j].NodeId);
-                            UaNodeId(ref[i].ReferenceTypeId).copyTo(&newData[j].ReferenceTypeId);
-                            UaExpandedNodeId(ref[i].TypeDefinition).copyTo(&newData[j].TypeDefinition);
+                            newData[j] = ref[i];
+                            OpcUa_ReferenceDescription_Initialize(&ref[i]);
                         }
 
                         // update the member variable that holds the browse data
@@ -280,7 +279,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status BrowseInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSession* uaSession,
+            uaf::SessionTransport*  uaSession,
             TransactionId           transactionId)
     {
         return AsyncInvocationNotSupportedError();
@@ -321,10 +320,9 @@ namespace uaf
                 // update the autoBrowsedNext counter
                 targets[i].autoBrowsedNext = autoBrowsedNextPerTarget_[i];
 
-                // update the continuation point
-                targets[i].continuationPoint = ByteString(
-                        uaBrowseResults_[i].ContinuationPoint.Length,
-                        uaBrowseResults_[i].ContinuationPoint.Data);
+                // take over the continuation point from the SDK, without copying it
+                targets[i].continuationPoint.fromSdkWithDetach(
+                        uaBrowseResults_[i].ContinuationPoint);
 
                 // update the references
                 targets[i].references.resize(uaBrowseResults_[i].NoOfReferences);
@@ -339,18 +337,22 @@ namespace uaf
                     targets[i].references[j].nodeClass = nodeclasses::fromSdkToUaf(
                             uaBrowseResults_[i].References[j].NodeClass);
 
-                    targets[i].references[j].browseName.fromSdk(
-                            UaQualifiedName(uaBrowseResults_[i].References[j].BrowseName));
-
-                    targets[i].references[j].displayName.fromSdk(
-                            UaLocalizedText(uaBrowseResults_[i].References[j].DisplayName));
+                    // take over the display name from the SDK, without copying it
+                    targets[i].references[j].displayName.fromSdkWithDetach(
+                            uaBrowseResults_[i].References[j].DisplayName);
 
                     Status resolutionStatus;
 
+                    // the browse name is filled out completely by the namespace array, so it
+                    // only needs to be converted separately if its namespace index is unknown
                     resolutionStatus = nameSpaceArray.fillQualifiedName(
                             uaBrowseResults_[i].References[j].BrowseName,
                             targets[i].references[j].browseName);
 
+                    if (resolutionStatus.isNotGood())
+                        targets[i].references[j].browseName.fromSdk(
+                                UaQualifiedName(uaBrowseResults_[i].References[j].BrowseName));
+
                     if (targets[i].status.isGood() && resolutionStatus.isNotGood())
                         targets[i].status = resolutionStatus;
 
@@ -404,6 +406,20 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void BrowseInvocation::clearSdkData()
+    {
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaMaxReferencesToReturn_ = 0;
+        OpcUa_ViewDescription_Clear(&uaViewDescription_);
+        OpcUa_ViewDescription_Initialize(&uaViewDescription_);
+        uaBrowseDescriptions_.clear();
+        uaBrowseResults_.clear();
+        uaDiagnosticInfos_.clear();
+        autoBrowsedNextPerTarget_.clear();
+    }
+
 
 
 }
@@ -88,14 +88,14 @@ namespace uaf
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
-        uaf::Status invokeSyncSdkService(UaClientSdk::UaSession* uaSession);
+        uaf::Status invokeSyncSdkService(uaf::SessionTransport* uaSession);
 
 
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
         uaf::Status invokeAsyncSdkService(
-                UaClientSdk::UaSession*     uaSession,
+                uaf::SessionTransport*      uaSession,
                 uaf::TransactionId          transactionId);
 
 
@@ -108,6 +108,12 @@ namespace uaf
                 std::vector<uaf::BrowseResultTarget>& targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        void clearSdkData();
+
+
         // private data members used during the invocation
         uint32_t                        uaMaxReferencesToReturn_;
         OpcUa_ViewDescription           uaViewDescription_;
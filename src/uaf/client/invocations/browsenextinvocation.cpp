@@ -75,7 +75,7 @@ namespace uaf
 
     // Invoke the service synchronously
     // =============================================================================================
-    Status BrowseNextInvocation::invokeSyncSdkService(UaClientSdk::UaSession* uaSession)
+    Status BrowseNextInvocation::invokeSyncSdkService(uaf::SessionTransport* uaSession)
     {
         Status ret;
 
@@ -98,7 +98,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status BrowseNextInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSession* uaSession,
+            uaf::SessionTransport*  uaSession,
             TransactionId           transactionId)
     {
         return AsyncInvocationNotSupportedError();
@@ -135,10 +135,9 @@ namespace uaf
                 // update the status code
                 targets[i].opcUaStatusCode = uaBrowseResults_[i].StatusCode;
 
-                // update the continuation point
-                targets[i].continuationPoint = ByteString(
-                        uaBrowseResults_[i].ContinuationPoint.Length,
-                        uaBrowseResults_[i].ContinuationPoint.Data);
+                // take over the continuation point from the SDK, without copying it
+                targets[i].continuationPoint.fromSdkWithDetach(
+                        uaBrowseResults_[i].ContinuationPoint);
 
                 // update the references
                 targets[i].references.resize(uaBrowseResults_[i].NoOfReferences);
@@ -153,18 +152,22 @@ namespace uaf
                     targets[i].references[j].nodeClass = nodeclasses::fromSdkToUaf(
                             uaBrowseResults_[i].References[j].NodeClass);
 
-                    targets[i].references[j].browseName.fromSdk(
-                            UaQualifiedName(uaBrowseResults_[i].References[j].BrowseName));
-
-                    targets[i].references[j].displayName.fromSdk(
-                            UaLocalizedText(uaBrowseResults_[i].References[j].DisplayName));
+                    // take over the display name from the SDK, without copying it
+                    targets[i].references[j].displayName.fromSdkWithDetach(
+                            uaBrowseResults_[i].References[j].DisplayName);
 
                     Status resolutionStatus;
 
+                    // the browse name is filled out completely by the namespace array, so it
+                    // only needs to be converted separately if its namespace index is unknown
                     resolutionStatus = nameSpaceArray.fillQualifiedName(
                             uaBrowseResults_[i].References[j].BrowseName,
                             targets[i].references[j].browseName);
 
+                    if (resolutionStatus.isNotGood())
+                        targets[i].references[j].browseName.fromSdk(
+                                UaQualifiedName(uaBrowseResults_[i].References[j].BrowseName));
+
                     if (targets[i].status.isGood() && resolutionStatus.isNotGood())
                         targets[i].status = resolutionStatus;
 
@@ -218,6 +221,17 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void BrowseNextInvocation::clearSdkData()
+    {
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaReleaseContinuationPoint_ = OpcUa_False;
+        uaContinuationPoints_.clear();
+        uaBrowseResults_.clear();
+        uaDiagnosticInfos_.clear();
+    }
+
 
 
 }
@@ -75,14 +75,14 @@ namespace uaf
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
-        uaf::Status invokeSyncSdkService(UaClientSdk::UaSession* uaSession);
+        uaf::Status invokeSyncSdkService(uaf::SessionTransport* uaSession);
 
 
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
         uaf::Status invokeAsyncSdkService(
-                UaClientSdk::UaSession*     uaSession,
+                uaf::SessionTransport*      uaSession,
                 uaf::TransactionId          transactionId);
 
 
@@ -95,6 +95,12 @@ namespace uaf
                 std::vector<uaf::BrowseNextResultTarget>&  targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        void clearSdkData();
+
+
         // private data members used during the invocation
         UaClientSdk::ServiceSettings    uaServiceSettings_;
         OpcUa_Boolean                   uaReleaseContinuationPoint_;
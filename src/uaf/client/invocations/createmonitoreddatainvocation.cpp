@@ -124,7 +124,7 @@ namespace uaf
     // Invoke the service synchronously
     // =============================================================================================
     Status CreateMonitoredDataInvocation::invokeSyncSdkService(
-            UaClientSdk::UaSubscription* uaSubscription)
+            uaf::SubscriptionTransport*  uaSubscription)
 
     {
         Status ret;
@@ -147,7 +147,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status CreateMonitoredDataInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSubscription* uaSubscription,
+            uaf::SubscriptionTransport*  uaSubscription,
             TransactionId                transactionId)
     {
         Status ret;
@@ -212,4 +212,16 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void CreateMonitoredDataInvocation::clearSdkData()
+    {
+        clientHandles_.clear();
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaCreateRequests_.clear();
+        uaCreateResults_.clear();
+    }
+
+
+
 }
@@ -97,14 +97,14 @@ namespace uaf
          * Overridden function from uaf::BaseServiceInvocation.
          */
         uaf::Status invokeSyncSdkService(
-                UaClientSdk::UaSubscription* uaSubscription);
+                uaf::SubscriptionTransport*  uaSubscription);
 
 
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
         uaf::Status invokeAsyncSdkService(
-                UaClientSdk::UaSubscription* uaSubscription,
+                uaf::SubscriptionTransport*  uaSubscription,
                 uaf::TransactionId           transactionId);
 
 
@@ -117,6 +117,12 @@ namespace uaf
                 std::vector<uaf::CreateMonitoredDataResultTarget>& targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        void clearSdkData();
+
+
         // private data members used during the invocation
         OpcUa_TimestampsToReturn        uaTimeStamps_;
         ClientHandles                   clientHandles_;
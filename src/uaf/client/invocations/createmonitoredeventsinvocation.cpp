@@ -80,50 +80,10 @@ namespace uaf
                 uaCreateRequests_[i].RequestedParameters.DiscardOldest = discardOldest;
                 uaCreateRequests_[i].RequestedParameters.QueueSize = targets[i].queueSize;
 
-                UaEventFilter eventFilter;
-
-                size_t noOfSelectClauses = targets[i].eventFilter.selectClauses.size();
-
-                for (size_t clauseIndex = 0;
-                     clauseIndex < noOfSelectClauses && ret.isGood();
-                     clauseIndex++)
-                {
-                    // create an operand
-                    UaSimpleAttributeOperand operand;
-
-                    SimpleAttributeOperand selectClause;
-                    selectClause = targets[i].eventFilter.selectClauses[clauseIndex];
-
-                    // set the attribute ID
-                    operand.setAttributeId(selectClause.attributeId);
-
-                    // set the type definition ID
-                    OpcUa_NodeId typeId;
-                    ret = nameSpaceArray.fillOpcUaNodeId(selectClause.typeId, typeId);
-                    if (ret.isGood())
-                        operand.setTypeId(typeId);
-
-                    // set the browse path
-                    size_t noOfBrowseNames = selectClause.browsePath.size();
-                    for (size_t nameIndex = 0;
-                         nameIndex < noOfBrowseNames && ret.isGood();
-                         nameIndex++)
-                    {
-                        OpcUa_QualifiedName qualifiedName;
-                        ret = nameSpaceArray.fillOpcUaQualifiedName(
-                                selectClause.browsePath[nameIndex],
-                                qualifiedName);
-
-                        if (ret.isGood())
-                            operand.setBrowsePathElement(nameIndex, qualifiedName, noOfBrowseNames);
-                    }
-
-                    if (ret.isGood())
-                        eventFilter.setSelectClauseElement(clauseIndex, operand, noOfSelectClauses);
-                }
-
-                if (ret.isGood())
-                    eventFilter.detachFilter(uaCreateRequests_[i].RequestedParameters.Filter);
+                // set the event filter
+                ret = nameSpaceArray.fillOpcUaEventFilter(
+                        targets[i].eventFilter,
+                        uaCreateRequests_[i].RequestedParameters.Filter);
             }
         }
 
@@ -148,7 +108,7 @@ namespace uaf
     // Invoke the service synchronously
     // =============================================================================================
     Status CreateMonitoredEventsInvocation::invokeSyncSdkService(
-            UaClientSdk::UaSubscription* uaSubscription)
+            uaf::SubscriptionTransport*  uaSubscription)
 
     {
         uaf::Status ret;
@@ -172,7 +132,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status CreateMonitoredEventsInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSubscription* uaSubscription,
+            uaf::SubscriptionTransport*  uaSubscription,
             TransactionId                transactionId)
     {
         uaf::Status ret;
@@ -237,6 +197,16 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void CreateMonitoredEventsInvocation::clearSdkData()
+    {
+        clientHandles_.clear();
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaCreateRequests_.clear();
+        uaCreateResults_.clear();
+    }
+
 
 
 }
@@ -96,14 +96,14 @@ namespace uaf
          * Overridden function from uaf::BaseServiceInvocation.
          */
         uaf::Status invokeSyncSdkService(
-                UaClientSdk::UaSubscription* uaSubscription);
+                uaf::SubscriptionTransport*  uaSubscription);
 
 
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
         uaf::Status invokeAsyncSdkService(
-                UaClientSdk::UaSubscription* uaSubscription,
+                uaf::SubscriptionTransport*  uaSubscription,
                 uaf::TransactionId           transactionId);
 
 
@@ -116,6 +116,12 @@ namespace uaf
                 std::vector<uaf::CreateMonitoredEventsResultTarget>& targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        void clearSdkData();
+
+
         // private data members used during the invocation
         OpcUa_TimestampsToReturn        uaTimeStamps_;
         ClientHandles                   clientHandles_;
@@ -115,7 +115,7 @@ namespace uaf
 
     // Invoke the service synchronously
     // =============================================================================================
-    Status HistoryReadRawModifiedInvocation::invokeSyncSdkService(UaClientSdk::UaSession* uaSession)
+    Status HistoryReadRawModifiedInvocation::invokeSyncSdkService(uaf::SessionTransport* uaSession)
     {
         Status ret;
 
@@ -225,11 +225,14 @@ namespace uaf
                         // resize the original results, so that it can hold the new results
                         uaResults_[rank].m_dataValues.resize(oldDataLength + nextDataLength);
 
-                        // now copy the data from the new results to the original results:
+                        // now move the data from the new results to the original results
+                        // (the stack variants are moved as a whole, so their contents are not
+                        // copied, and the new results are left with empty variants):
                         for (uint32_t i=0, j=oldDataLength; i<nextDataLength; i++, j++)
                         {
-                            UaVariant(uaNextResults[iNext].m_dataValues[i].Value).copyTo(
-                                    &uaResults_[rank].m_dataValues[j].Value);
+                            uaResults_[rank].m_dataValues[j].Value \
+                                = uaNextResults[iNext].m_dataValues[i].Value;
+                            OpcUa_Variant_Initialize(&uaNextResults[iNext].m_dataValues[i].Value);
 
                             uaResults_[rank].m_dataValues[j].SourceTimestamp \
                                 = uaNextResults[iNext].m_dataValues[i].SourceTimestamp;
@@ -285,7 +288,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status HistoryReadRawModifiedInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSession* uaSession,
+            uaf::SessionTransport*  uaSession,
             TransactionId           transactionId)
     {
         return AsyncInvocationNotSupportedError();
@@ -333,9 +336,15 @@ namespace uaf
                 targets[i].dataValues.resize(noOfDataValues);
                 for (uint32_t j = 0; j < noOfDataValues; j++)
                 {
-                    targets[i].dataValues[j].fromSdk(UaDataValue(uaResults_[i].m_dataValues[j]));
-                    nameSpaceArray.fillVariant(targets[i].dataValues[j].data);
-                    serverArray.fillVariant(targets[i].dataValues[j].data);
+                    // take over the data from the SDK, without copying it
+                    targets[i].dataValues[j].fromSdkWithDetach(uaResults_[i].m_dataValues[j]);
+
+                    // only NodeIds etc. need to have their namespace and server indexes resolved
+                    if (opcuatypes::needsNamespaceResolution(targets[i].dataValues[j].data.type()))
+                    {
+                        nameSpaceArray.fillVariant(targets[i].dataValues[j].data);
+                        serverArray.fillVariant(targets[i].dataValues[j].data);
+                    }
                 }
 
                 // update the modification information
@@ -357,6 +366,18 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void HistoryReadRawModifiedInvocation::clearSdkData()
+    {
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaContext_ = UaClientSdk::HistoryReadRawModifiedContext();
+        uaNodesToRead_.clear();
+        uaResults_.clear();
+        autoReadMorePerTarget_.clear();
+        uaDiagnosticInfos_.clear();
+    }
+
 
 
 }
@@ -0,0 +1,67 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/invocations/invocationpool.h"
+
+namespace uaf
+{
+    using namespace uaf;
+
+
+    // Constructor
+    // =============================================================================================
+    InvocationPool::InvocationPool(std::size_t maxIdleInvocations, std::size_t maxRetainedTargets)
+    : maxIdleInvocations_(maxIdleInvocations),
+      maxRetainedTargets_(maxRetainedTargets),
+      createdInvocations_(0),
+      reusedInvocations_(0)
+    {}
+
+
+    // Destructor
+    // =============================================================================================
+    InvocationPool::~InvocationPool()
+    {
+        UaMutexLocker locker(&mutex_);
+        for (IdleListMap::iterator it = idleLists_.begin(); it != idleLists_.end(); ++it)
+            delete it->second;
+        idleLists_.clear();
+    }
+
+
+    // Get the number of created invocations
+    // =============================================================================================
+    uint64_t InvocationPool::createdInvocations() const
+    {
+        UaMutexLocker locker(&mutex_);
+        return createdInvocations_;
+    }
+
+
+    // Get the number of reused invocations
+    // =============================================================================================
+    uint64_t InvocationPool::reusedInvocations() const
+    {
+        UaMutexLocker locker(&mutex_);
+        return reusedInvocations_;
+    }
+
+
+}
@@ -0,0 +1,199 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_INVOCATIONPOOL_H_
+#define UAF_INVOCATIONPOOL_H_
+
+
+// STD
+#include <map>
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::InvocationPool keeps the invocations of a session that are not in use, so that they
+    * can be reused by later requests.
+    *
+    * Building an invocation involves allocating the invocation itself, and growing its vectors
+    * of ranks, request targets and result targets. A released invocation is cleared (see
+    * uaf::BaseServiceInvocation::clear()) but keeps the capacity of these vectors, so a
+    * session that keeps on invoking similar requests doesn't need to allocate them again.
+    *
+    * The pool is thread-safe: the same session may be used by several requests concurrently.
+    *
+    * @ingroup ClientInvocations
+    ***********************************************************************************************/
+    class UAF_EXPORT InvocationPool
+    {
+    public:
+
+
+        /**
+         * Create an invocation pool.
+         *
+         * @param maxIdleInvocations    The maximum number of idle invocations to keep, per
+         *                              type of invocation. More invocations are only needed
+         *                              when the same session is used by concurrent requests.
+         * @param maxRetainedTargets    The maximum number of targets that an idle invocation
+         *                              keeps room for (see uaf::BaseServiceInvocation::clear()).
+         */
+        InvocationPool(
+                std::size_t maxIdleInvocations = 4,
+                std::size_t maxRetainedTargets = 10000);
+
+
+        /**
+         * Destruct the pool, and delete all idle invocations.
+         */
+        ~InvocationPool();
+
+
+        /**
+         * Acquire an invocation: either an idle one (if there is one), or a new one.
+         *
+         * The invocation must be given back to the pool by calling release().
+         *
+         * @tparam _Invocation  The type of invocation, e.g. uaf::ReadInvocation.
+         * @return              A cleared invocation, owned by the caller until it's released.
+         */
+        template<typename _Invocation>
+        _Invocation* acquire()
+        {
+            {
+                UaMutexLocker locker(&mutex_);
+                std::vector<_Invocation*>& idle = idleInvocations<_Invocation>();
+                if (!idle.empty())
+                {
+                    _Invocation* invocation = idle.back();
+                    idle.pop_back();
+                    reusedInvocations_++;
+                    return invocation;
+                }
+                createdInvocations_++;
+            }
+            return new _Invocation;
+        }
+
+
+        /**
+         * Release an invocation that was acquired before: it is cleared and kept for later
+         * reuse, or deleted if the pool already holds enough idle invocations of the same type.
+         *
+         * @tparam _Invocation  The type of invocation, e.g. uaf::ReadInvocation.
+         * @param invocation    The invocation to release (may be NULL).
+         */
+        template<typename _Invocation>
+        void release(_Invocation* invocation)
+        {
+            if (invocation == NULL)
+                return;
+
+            invocation->clear(maxRetainedTargets_);
+
+            {
+                UaMutexLocker locker(&mutex_);
+                std::vector<_Invocation*>& idle = idleInvocations<_Invocation>();
+                if (idle.size() < maxIdleInvocations_)
+                {
+                    idle.push_back(invocation);
+                    return;
+                }
+            }
+            delete invocation;
+        }
+
+
+        /** Get the number of invocations that were created (i.e. allocated) by the pool. */
+        uint64_t createdInvocations() const;
+
+        /** Get the number of invocations that were reused (i.e. not allocated) by the pool. */
+        uint64_t reusedInvocations() const;
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(InvocationPool);
+
+
+        // the idle invocations of a single type, which can be deleted without knowing the type
+        class IdleList
+        {
+        public:
+            virtual ~IdleList() {}
+        };
+
+        template<typename _Invocation>
+        class TypedIdleList : public IdleList
+        {
+        public:
+            ~TypedIdleList()
+            {
+                for (std::size_t i = 0; i < invocations.size(); i++)
+                    delete invocations[i];
+            }
+
+            std::vector<_Invocation*> invocations;
+        };
+
+        // a unique key per type of invocation
+        template<typename _Invocation>
+        static const void* idleListKey()
+        {
+            static const char key = 0;
+            return &key;
+        }
+
+        // get the idle invocations of the given type (not locked!)
+        template<typename _Invocation>
+        std::vector<_Invocation*>& idleInvocations()
+        {
+            IdleList*& idleList = idleLists_[idleListKey<_Invocation>()];
+            if (idleList == NULL)
+                idleList = new TypedIdleList<_Invocation>;
+            return static_cast<TypedIdleList<_Invocation>*>(idleList)->invocations;
+        }
+
+
+        typedef std::map<const void*, IdleList*> IdleListMap;
+        IdleListMap         idleLists_;
+        std::size_t         maxIdleInvocations_;
+        std::size_t         maxRetainedTargets_;
+        uint64_t            createdInvocations_;
+        uint64_t            reusedInvocations_;
+        mutable UaMutex     mutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_INVOCATIONPOOL_H_ */
@@ -34,6 +34,7 @@
 #include "uaf/client/invocations/browseinvocation.h"
 #include "uaf/client/invocations/browsenextinvocation.h"
 #include "uaf/client/invocations/historyreadrawmodifiedinvocation.h"
+#include "uaf/client/invocations/invocationpool.h"
 
 
 // no declarations, just an #include for each invocation
@@ -73,12 +73,21 @@ namespace uaf
                 uaCallMethodRequests_[i].InputArguments = new OpcUa_Variant[noOfInputArguments];
                 for (size_t j = 0; j < noOfInputArguments; j++)
                 {
-                    // create a copy of the input argument, fill it, and copy the contents to
-                    // the SDK object.
-                    Variant v(targets[i].inputArguments[j]);
-                    nameSpaceArray.fillVariant(v);
-                    serverArray.fillVariant(v);
-                    v.toSdk(&uaCallMethodRequests_[i].InputArguments[j]);
+                    // only NodeIds etc. need to have their namespace and server indexes
+                    // resolved (in a copy of the input argument), the others can be copied to
+                    // the SDK object as they are.
+                    if (opcuatypes::needsNamespaceResolution(targets[i].inputArguments[j].type()))
+                    {
+                        Variant v(targets[i].inputArguments[j]);
+                        nameSpaceArray.fillVariant(v);
+                        serverArray.fillVariant(v);
+                        v.toSdk(&uaCallMethodRequests_[i].InputArguments[j]);
+                    }
+                    else
+                    {
+                        targets[i].inputArguments[j].toSdk(
+                                &uaCallMethodRequests_[i].InputArguments[j]);
+                    }
                 }
             }
         }
@@ -134,12 +143,20 @@ namespace uaf
                 uaCallIn_.inputArguments.create(noOfInputArguments);
                 for (size_t j = 0; j < noOfInputArguments; j++)
                 {
-                    // create a copy of the input argument, fill it, and copy the contents to
-                    // the SDK object.
-                    Variant v(targets[i].inputArguments[j]);
-                    nameSpaceArray.fillVariant(v);
-                    serverArray.fillVariant(v);
-                    v.toSdk(&uaCallIn_.inputArguments[j]);
+                    // only NodeIds etc. need to have their namespace and server indexes
+                    // resolved (in a copy of the input argument), the others can be copied to
+                    // the SDK object as they are.
+                    if (opcuatypes::needsNamespaceResolution(targets[i].inputArguments[j].type()))
+                    {
+                        Variant v(targets[i].inputArguments[j]);
+                        nameSpaceArray.fillVariant(v);
+                        serverArray.fillVariant(v);
+                        v.toSdk(&uaCallIn_.inputArguments[j]);
+                    }
+                    else
+                    {
+                        targets[i].inputArguments[j].toSdk(&uaCallIn_.inputArguments[j]);
+                    }
                 }
             }
         }
@@ -151,7 +168,7 @@ namespace uaf
 
     // Invoke the service synchronously
     // =============================================================================================
-    Status MethodCallInvocation::invokeSyncSdkService(UaClientSdk::UaSession* uaSession)
+    Status MethodCallInvocation::invokeSyncSdkService(uaf::SessionTransport* uaSession)
     {
         Status ret;
 
@@ -174,7 +191,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status MethodCallInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSession* uaSession,
+            uaf::SessionTransport*  uaSession,
             TransactionId           transactionId)
     {
         Status ret;
@@ -226,11 +243,21 @@ namespace uaf
                 int32_t noOfOutputArguments = uaCallMethodResults_[i].NoOfOutputArguments;
 
                 // fill the outputArguments
+                if (noOfOutputArguments > 0)
+                    targets[i].outputArguments.resize(noOfOutputArguments);
+
                 for (int32_t j = 0; j < noOfOutputArguments; j++)
                 {
-                    targets[i].outputArguments.push_back(uaCallMethodResults_[i].OutputArguments[j]);
-                    nameSpaceArray.fillVariant(targets[i].outputArguments[j]);
-                    serverArray.fillVariant(targets[i].outputArguments[j]);
+                    // take over the output argument from the SDK, without copying it
+                    targets[i].outputArguments[j].fromSdkWithDetach(
+                            uaCallMethodResults_[i].OutputArguments[j]);
+
+                    // only NodeIds etc. need to have their namespace and server indexes resolved
+                    if (opcuatypes::needsNamespaceResolution(targets[i].outputArguments[j].type()))
+                    {
+                        nameSpaceArray.fillVariant(targets[i].outputArguments[j]);
+                        serverArray.fillVariant(targets[i].outputArguments[j]);
+                    }
                 }
 
                 // get the number of input arguments.
@@ -267,6 +294,17 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void MethodCallInvocation::clearSdkData()
+    {
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaCallIn_ = UaClientSdk::CallIn();
+        uaCallMethodRequests_.clear();
+        uaCallMethodResults_.clear();
+        uaDiagnosticInfos_.clear();
+    }
+
 
 
 }
@@ -76,14 +76,14 @@ namespace uaf
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
-        uaf::Status invokeSyncSdkService(UaClientSdk::UaSession* uaSession);
+        uaf::Status invokeSyncSdkService(uaf::SessionTransport* uaSession);
 
 
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
         uaf::Status invokeAsyncSdkService(
-                UaClientSdk::UaSession*     uaSession,
+                uaf::SessionTransport*      uaSession,
                 uaf::TransactionId          transactionId);
 
 
@@ -96,6 +96,12 @@ namespace uaf
                 std::vector<uaf::MethodCallResultTarget>&  targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        void clearSdkData();
+
+
         // private data members used during the invocation
         UaClientSdk::ServiceSettings    uaServiceSettings_;
         UaClientSdk::CallIn             uaCallIn_;
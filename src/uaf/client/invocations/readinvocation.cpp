@@ -97,7 +97,7 @@ namespace uaf
 
     // Invoke the service synchronously
     // =============================================================================================
-    Status ReadInvocation::invokeSyncSdkService(UaClientSdk::UaSession* uaSession)
+    Status ReadInvocation::invokeSyncSdkService(uaf::SessionTransport* uaSession)
     {
         Status ret;
 
@@ -121,7 +121,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status ReadInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSession* uaSession,
+            uaf::SessionTransport*  uaSession,
             TransactionId           transactionId)
     {
         Status ret;
@@ -161,9 +161,15 @@ namespace uaf
         {
             for (uint32_t i=0; i<noOfTargets ; i++)
             {
-                targets[i].fromSdk(UaDataValue(uaDataValues_[i]));
-                nameSpaceArray.fillVariant(targets[i].data);
-                serverArray.fillVariant(targets[i].data);
+                // take over the data from the SDK, without copying it
+                targets[i].fromSdkWithDetach(uaDataValues_[i]);
+
+                // only NodeIds etc. need to have their namespace and server indexes resolved
+                if (opcuatypes::needsNamespaceResolution(targets[i].data.type()))
+                {
+                    nameSpaceArray.fillVariant(targets[i].data);
+                    serverArray.fillVariant(targets[i].data);
+                }
 
                 // update the status
                 if (OpcUa_IsGood(uaDataValues_[i].StatusCode))
@@ -183,6 +189,16 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void ReadInvocation::clearSdkData()
+    {
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaReadValueIds_.clear();
+        uaDataValues_.clear();
+        uaDiagnosticInfos_.clear();
+    }
+
 
 
 }
@@ -74,14 +74,14 @@ namespace uaf
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
-        uaf::Status invokeSyncSdkService(UaClientSdk::UaSession* uaSession);
+        uaf::Status invokeSyncSdkService(uaf::SessionTransport* uaSession);
 
 
         /**
          * Overridden function from uaf::BaseServiceInvocation.
          */
         uaf::Status invokeAsyncSdkService(
-                UaClientSdk::UaSession*     uaSession,
+                uaf::SessionTransport*      uaSession,
                 uaf::TransactionId          transactionId);
 
 
@@ -94,6 +94,12 @@ namespace uaf
                 std::vector<uaf::ReadResultTarget>& targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        void clearSdkData();
+
+
         // private data members used during the invocation
         OpcUa_Double                    uaMaxAge_;
         OpcUa_TimestampsToReturn        uaTimestampsToReturn_;
@@ -116,7 +116,7 @@ namespace uaf
     // Invoke the service synchronously
     // =============================================================================================
     Status TranslateBrowsePathsToNodeIdsInvocation::invokeSyncSdkService(
-            UaClientSdk::UaSession* uaSession)
+            uaf::SessionTransport*  uaSession)
     {
         Status ret;
 
@@ -138,7 +138,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status TranslateBrowsePathsToNodeIdsInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSession* uaSession,
+            uaf::SessionTransport*  uaSession,
             TransactionId           transactionId)
     {
         return AsyncInvocationNotSupportedError();
@@ -246,4 +246,16 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void TranslateBrowsePathsToNodeIdsInvocation::clearSdkData()
+    {
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaBrowsePaths_.clear();
+        uaBrowsePathResults_.clear();
+        uaDiagnosticInfos_.clear();
+    }
+
+
+
 }
@@ -66,11 +66,19 @@ namespace uaf
                 if (!targets[i].indexRange.empty())
                     UaString(targets[i].indexRange.c_str()).copyTo(&uaWriteValues_[i].IndexRange);
 
-                DataValue dv(targets[i]);
-                nameSpaceArray.fillVariant(dv.data);
-                serverArray.fillVariant(dv.data);
-                // copy the data value
-                dv.toSdk(&uaWriteValues_[i].Value);
+                // only NodeIds etc. need to have their namespace and server indexes resolved
+                // (in a copy of the data value), the others can be copied as they are
+                if (opcuatypes::needsNamespaceResolution(targets[i].data.type()))
+                {
+                    DataValue dv(targets[i]);
+                    nameSpaceArray.fillVariant(dv.data);
+                    serverArray.fillVariant(dv.data);
+                    dv.toSdk(&uaWriteValues_[i].Value);
+                }
+                else
+                {
+                    static_cast<const DataValue&>(targets[i]).toSdk(&uaWriteValues_[i].Value);
+                }
             }
         }
 
@@ -94,7 +102,7 @@ namespace uaf
 
     // Invoke the service synchronously
     // =============================================================================================
-    Status WriteInvocation::invokeSyncSdkService(UaClientSdk::UaSession* uaSession)
+    Status WriteInvocation::invokeSyncSdkService(uaf::SessionTransport* uaSession)
     {
         Status ret;
 
@@ -116,7 +124,7 @@ namespace uaf
     // Invoke the service asynchronously
     // =============================================================================================
     Status WriteInvocation::invokeAsyncSdkService(
-            UaClientSdk::UaSession* uaSession,
+            uaf::SessionTransport*  uaSession,
             TransactionId           transactionId)
     {
         Status ret;
@@ -178,6 +186,16 @@ namespace uaf
     }
 
 
+    // Clear the SDK members
+    // =============================================================================================
+    void WriteInvocation::clearSdkData()
+    {
+        uaServiceSettings_ = UaClientSdk::ServiceSettings();
+        uaWriteValues_.clear();
+        uaStatusCodes_.clear();
+        uaDiagnosticInfos_.clear();
+    }
+
 
 
 }
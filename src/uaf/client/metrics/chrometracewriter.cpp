@@ -0,0 +1,136 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/metrics/chrometracewriter.h"
+
+// STD
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+
+
+    // Escape a string for JSON
+    // =============================================================================================
+    static string escapeJson(const string& value)
+    {
+        string ret;
+        ret.reserve(value.size());
+        for (size_t i = 0; i < value.size(); i++)
+        {
+            char c = value[i];
+            if (c == '"' || c == '\\')
+            {
+                ret += '\\';
+                ret += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buffer[8];
+                sprintf(buffer, "\\u%04x", static_cast<unsigned int>(c));
+                ret += buffer;
+            }
+            else
+                ret += c;
+        }
+        return ret;
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    ChromeTraceWriter::ChromeTraceWriter(const string& fileName)
+    : file_(fileName.c_str(), std::ios::out | std::ios::trunc),
+      first_(true)
+    {
+        if (file_.is_open())
+            file_ << "[";
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    ChromeTraceWriter::~ChromeTraceWriter()
+    {
+        if (file_.is_open())
+        {
+            file_ << "\n]\n";
+            file_.close();
+        }
+    }
+
+
+    // Write the spans of a trace
+    // =============================================================================================
+    void ChromeTraceWriter::traceFinished(const RequestTrace& trace)
+    {
+        // format the events before taking the lock
+        stringstream ss;
+        ss << std::fixed << std::setprecision(3);
+
+        string service = escapeJson(trace.service);
+
+        for (vector<TraceSpan>::const_iterator it = trace.spans.begin();
+             it != trace.spans.end();
+             ++it)
+        {
+            // the timestamps of the Trace Event format are in microseconds
+            ss << ",\n{\"name\":\"" << escapeJson(it->stage) << "\""
+               << ",\"cat\":\"uaf\",\"ph\":\"X\""
+               << ",\"ts\":" << double(it->startTimeNs) / 1e3
+               << ",\"dur\":" << double(it->durationNs) / 1e3
+               << ",\"pid\":1,\"tid\":" << trace.threadId
+               << ",\"args\":{\"service\":\"" << service << "\""
+               << ",\"requestHandle\":" << trace.requestHandle;
+            if (!it->serverUri.empty())
+                ss << ",\"serverUri\":\"" << escapeJson(it->serverUri) << "\"";
+            ss << "}}";
+        }
+
+        string events = ss.str();
+        if (events.empty())
+            return;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        if (!file_.is_open())
+            return;
+
+        // the first event must not be preceded by a comma
+        if (first_)
+        {
+            file_ << events.substr(1);
+            first_ = false;
+        }
+        else
+            file_ << events;
+
+        file_.flush();
+    }
+
+}
@@ -0,0 +1,103 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CHROMETRACEWRITER_H_
+#define UAF_CHROMETRACEWRITER_H_
+
+
+
+// STD
+#include <string>
+#include <fstream>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/metrics/tracesink.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::ChromeTraceWriter is a uaf::TraceSink that writes the spans of the traces to a file,
+    * as "complete" events in the Trace Event format of Chrome (the JSON array format).
+    *
+    * The file can be opened by chrome://tracing or by Perfetto, even while it is still being
+    * written (the closing bracket of the array is only written when the writer is destroyed,
+    * but it is optional).
+    *
+    * @ingroup ClientMetrics
+    ***********************************************************************************************/
+    class UAF_EXPORT ChromeTraceWriter : public uaf::TraceSink
+    {
+    public:
+
+
+        /**
+         * Create a writer, and open (i.e. truncate) the file.
+         *
+         * @param fileName  The name of the file.
+         */
+        ChromeTraceWriter(const std::string& fileName);
+
+
+        /**
+         * Destruct the writer, and close the file.
+         */
+        virtual ~ChromeTraceWriter();
+
+
+        /**
+         * Is the file open?
+         *
+         * @return  False if the file could not be opened.
+         */
+        bool isOpen() const { return file_.is_open(); }
+
+
+        /**
+         * Write the spans of a trace to the file.
+         *
+         * @param trace The trace of a request.
+         */
+        virtual void traceFinished(const uaf::RequestTrace& trace);
+
+
+    private:
+
+        DISALLOW_COPY_AND_ASSIGN(ChromeTraceWriter);
+
+        // the file (written under the mutex)
+        std::ofstream   file_;
+        // true if no event has been written yet
+        bool            first_;
+        UaMutex         mutex_;
+
+    };
+
+}
+
+
+
+#endif /* UAF_CHROMETRACEWRITER_H_ */
@@ -0,0 +1,343 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/metrics/metrics.h"
+
+// STD
+#include <cstdio>
+#include <fstream>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+
+
+    // Get the ratio of hits and lookups
+    // =============================================================================================
+    static double hitRatio(uint64_t hits, uint64_t lookups)
+    {
+        return lookups == 0 ? 0.0 : double(hits) / double(lookups);
+    }
+
+
+    // Escape a Prometheus label value
+    // =============================================================================================
+    static string escapeLabelValue(const string& value)
+    {
+        string ret;
+        ret.reserve(value.size());
+
+        for (string::const_iterator it = value.begin(); it != value.end(); ++it)
+        {
+            if (*it == '\\')
+                ret += "\\\\";
+            else if (*it == '"')
+                ret += "\\\"";
+            else if (*it == '\n')
+                ret += "\\n";
+            else
+                ret += *it;
+        }
+
+        return ret;
+    }
+
+
+    // Write the HELP and TYPE lines of a Prometheus metric
+    // =============================================================================================
+    static void writeHeader(
+            stringstream& ss,
+            const char*   name,
+            const char*   type,
+            const char*   help)
+    {
+        ss << "# HELP " << name << " " << help << "\n";
+        ss << "# TYPE " << name << " " << type << "\n";
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    Metrics::Metrics()
+    : addressCacheHits(0),
+      addressCacheMisses(0),
+      structureDefinitionCacheHits(0),
+      structureDefinitionCacheMisses(0),
+      pkiStoreCacheHits(0),
+      pkiStoreCacheLoads(0)
+    {}
+
+
+    // Get the hit ratio of the address cache
+    // =============================================================================================
+    double Metrics::addressCacheHitRatio() const
+    {
+        return hitRatio(addressCacheHits, addressCacheHits + addressCacheMisses);
+    }
+
+
+    // Get the hit ratio of the structure definition cache
+    // =============================================================================================
+    double Metrics::structureDefinitionCacheHitRatio() const
+    {
+        return hitRatio(structureDefinitionCacheHits,
+                        structureDefinitionCacheHits + structureDefinitionCacheMisses);
+    }
+
+
+    // Get the hit ratio of the PKI store cache
+    // =============================================================================================
+    double Metrics::pkiStoreCacheHitRatio() const
+    {
+        return hitRatio(pkiStoreCacheHits, pkiStoreCacheHits + pkiStoreCacheLoads);
+    }
+
+
+    // Get the metrics in the Prometheus text format
+    // =============================================================================================
+    string Metrics::toPrometheus() const
+    {
+        stringstream ss;
+        ss.precision(9);
+
+        vector<double> bounds = ServiceMetrics::latencyBucketBoundsSec();
+
+        // the labels of each service
+        vector<string> serviceLabels(services.size());
+        for (std::size_t i = 0; i < services.size(); i++)
+            serviceLabels[i] = "server_uri=\"" + escapeLabelValue(services[i].serverUri)
+                             + "\",service=\"" + escapeLabelValue(services[i].service) + "\"";
+
+        writeHeader(ss, "uaf_service_latency_seconds", "histogram",
+                    "Latency of the service invocations.");
+        for (std::size_t i = 0; i < services.size(); i++)
+        {
+            const ServiceMetrics& service = services[i];
+            uint64_t cumulative = 0;
+            for (std::size_t j = 0; j < service.latencyBucketCounts.size(); j++)
+            {
+                cumulative += service.latencyBucketCounts[j];
+                ss << "uaf_service_latency_seconds_bucket{" << serviceLabels[i] << ",le=\"";
+                if (j < bounds.size())
+                    ss << bounds[j];
+                else
+                    ss << "+Inf";
+                ss << "\"} " << cumulative << "\n";
+            }
+            ss << "uaf_service_latency_seconds_sum{" << serviceLabels[i] << "} "
+               << service.latencySumSec << "\n";
+            ss << "uaf_service_latency_seconds_count{" << serviceLabels[i] << "} "
+               << service.invocations << "\n";
+        }
+
+        writeHeader(ss, "uaf_service_failures_total", "counter",
+                    "Number of service invocations that failed.");
+        for (std::size_t i = 0; i < services.size(); i++)
+            ss << "uaf_service_failures_total{" << serviceLabels[i] << "} "
+               << services[i].failures << "\n";
+
+        writeHeader(ss, "uaf_service_targets_total", "counter",
+                    "Number of targets of the service invocations.");
+        for (std::size_t i = 0; i < services.size(); i++)
+            ss << "uaf_service_targets_total{" << serviceLabels[i] << "} "
+               << services[i].targets << "\n";
+
+        writeHeader(ss, "uaf_service_in_flight", "gauge",
+                    "Number of service invocations that are in progress.");
+        for (std::size_t i = 0; i < services.size(); i++)
+            ss << "uaf_service_in_flight{" << serviceLabels[i] << "} "
+               << services[i].inFlight << "\n";
+
+        writeHeader(ss, "uaf_server_connection_attempts_total", "counter",
+                    "Number of attempts to connect a session to the server.");
+        for (std::size_t i = 0; i < servers.size(); i++)
+            ss << "uaf_server_connection_attempts_total{server_uri=\""
+               << escapeLabelValue(servers[i].serverUri) << "\"} "
+               << servers[i].connectionAttempts << "\n";
+
+        writeHeader(ss, "uaf_server_failed_connection_attempts_total", "counter",
+                    "Number of failed attempts to connect a session to the server.");
+        for (std::size_t i = 0; i < servers.size(); i++)
+            ss << "uaf_server_failed_connection_attempts_total{server_uri=\""
+               << escapeLabelValue(servers[i].serverUri) << "\"} "
+               << servers[i].failedConnectionAttempts << "\n";
+
+        writeHeader(ss, "uaf_server_connection_losses_total", "counter",
+                    "Number of times a connected session lost its connection to the server.");
+        for (std::size_t i = 0; i < servers.size(); i++)
+            ss << "uaf_server_connection_losses_total{server_uri=\""
+               << escapeLabelValue(servers[i].serverUri) << "\"} "
+               << servers[i].connectionLosses << "\n";
+
+        writeHeader(ss, "uaf_server_reconnections_total", "counter",
+                    "Number of times a session was reconnected to the server.");
+        for (std::size_t i = 0; i < servers.size(); i++)
+            ss << "uaf_server_reconnections_total{server_uri=\""
+               << escapeLabelValue(servers[i].serverUri) << "\"} "
+               << servers[i].reconnections << "\n";
+
+        writeHeader(ss, "uaf_subscription_notifications_total", "counter",
+                    "Number of notifications received by the subscription.");
+        for (std::size_t i = 0; i < subscriptions.size(); i++)
+        {
+            ss << "uaf_subscription_notifications_total{client_subscription_handle=\""
+               << subscriptions[i].clientSubscriptionHandle << "\",kind=\"data_change\"} "
+               << subscriptions[i].dataChangeNotifications << "\n";
+            ss << "uaf_subscription_notifications_total{client_subscription_handle=\""
+               << subscriptions[i].clientSubscriptionHandle << "\",kind=\"event\"} "
+               << subscriptions[i].eventNotifications << "\n";
+        }
+
+        writeHeader(ss, "uaf_subscription_publish_responses_total", "counter",
+                    "Number of publish responses with notifications received by the subscription.");
+        for (std::size_t i = 0; i < subscriptions.size(); i++)
+            ss << "uaf_subscription_publish_responses_total{client_subscription_handle=\""
+               << subscriptions[i].clientSubscriptionHandle << "\"} "
+               << subscriptions[i].publishResponses << "\n";
+
+        writeHeader(ss, "uaf_notification_queue_depth", "gauge",
+                    "Number of notifications in the notification queue.");
+        ss << "uaf_notification_queue_depth " << notificationQueue.queueDepth << "\n";
+
+        writeHeader(ss, "uaf_notification_queue_max_depth", "gauge",
+                    "Highest number of notifications in the notification queue.");
+        ss << "uaf_notification_queue_max_depth " << notificationQueue.maxQueueDepth << "\n";
+
+        writeHeader(ss, "uaf_notification_queue_dropped_total", "counter",
+                    "Number of notifications dropped by the notification queue.");
+        ss << "uaf_notification_queue_dropped_total " << notificationQueue.dropped << "\n";
+
+        writeHeader(ss, "uaf_cache_hits_total", "counter",
+                    "Number of cache lookups that were hits.");
+        ss << "uaf_cache_hits_total{cache=\"address\"} " << addressCacheHits << "\n";
+        ss << "uaf_cache_hits_total{cache=\"structure_definition\"} "
+           << structureDefinitionCacheHits << "\n";
+        ss << "uaf_cache_hits_total{cache=\"pki_store\"} " << pkiStoreCacheHits << "\n";
+
+        writeHeader(ss, "uaf_cache_misses_total", "counter",
+                    "Number of cache lookups that were misses.");
+        ss << "uaf_cache_misses_total{cache=\"address\"} " << addressCacheMisses << "\n";
+        ss << "uaf_cache_misses_total{cache=\"structure_definition\"} "
+           << structureDefinitionCacheMisses << "\n";
+        ss << "uaf_cache_misses_total{cache=\"pki_store\"} " << pkiStoreCacheLoads << "\n";
+
+        return ss.str();
+    }
+
+
+    // Write the metrics to a file
+    // =============================================================================================
+    bool Metrics::writeToFile(const string& fileName) const
+    {
+        string buffer = toPrometheus();
+
+        string tmpFileName = fileName + ".tmp";
+
+        std::ofstream file(tmpFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        file.write(buffer.data(), std::streamsize(buffer.size()));
+        file.close();
+
+        if (!file)
+        {
+            std::remove(tmpFileName.c_str());
+            return false;
+        }
+
+#ifdef _WIN32
+        // on Windows, rename() fails if the destination exists
+        return ::MoveFileExA(tmpFileName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return std::rename(tmpFileName.c_str(), fileName.c_str()) == 0;
+#endif
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string Metrics::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - services[]";
+        for (std::size_t i = 0; i < services.size(); i++)
+        {
+            ss << "\n" << indent << "    - services[" << i << "]\n";
+            ss << services[i].toString(indent + "      ", colon);
+        }
+        ss << "\n";
+
+        ss << indent << " - servers[]";
+        for (std::size_t i = 0; i < servers.size(); i++)
+        {
+            ss << "\n" << indent << "    - servers[" << i << "]\n";
+            ss << servers[i].toString(indent + "      ", colon);
+        }
+        ss << "\n";
+
+        ss << indent << " - subscriptions[]";
+        for (std::size_t i = 0; i < subscriptions.size(); i++)
+        {
+            ss << "\n" << indent << "    - subscriptions[" << i << "]\n";
+            ss << subscriptions[i].toString(indent + "      ", colon);
+        }
+        ss << "\n";
+
+        ss << indent << " - notificationQueue\n";
+        ss << notificationQueue.toString(indent + "   ", colon) << "\n";
+
+        ss << indent << " - addressCacheHits";
+        ss << fillToPos(ss, colon);
+        ss << ": " << addressCacheHits << "\n";
+
+        ss << indent << " - addressCacheMisses";
+        ss << fillToPos(ss, colon);
+        ss << ": " << addressCacheMisses << "\n";
+
+        ss << indent << " - structureDefinitionCacheHits";
+        ss << fillToPos(ss, colon);
+        ss << ": " << structureDefinitionCacheHits << "\n";
+
+        ss << indent << " - structureDefinitionCacheMisses";
+        ss << fillToPos(ss, colon);
+        ss << ": " << structureDefinitionCacheMisses << "\n";
+
+        ss << indent << " - pkiStoreCacheHits";
+        ss << fillToPos(ss, colon);
+        ss << ": " << pkiStoreCacheHits << "\n";
+
+        ss << indent << " - pkiStoreCacheLoads";
+        ss << fillToPos(ss, colon);
+        ss << ": " << pkiStoreCacheLoads;
+
+        return ss.str();
+    }
+
+}
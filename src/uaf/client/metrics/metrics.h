@@ -0,0 +1,156 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_METRICS_H_
+#define UAF_METRICS_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/metrics/servicemetrics.h"
+#include "uaf/client/metrics/servermetrics.h"
+#include "uaf/client/metrics/subscriptionmetrics.h"
+#include "uaf/client/subscriptions/notificationqueuestatistics.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::Metrics object holds the metrics of a client, as returned by uaf::Client::metrics().
+    *
+    * All counters are counted since the client was created.
+    *
+    * @ingroup ClientMetrics
+    ***********************************************************************************************/
+    class UAF_EXPORT Metrics
+    {
+    public:
+
+
+        /**
+         * Create empty metrics.
+         */
+        Metrics();
+
+
+        /** The metrics per server and per service. */
+        std::vector<uaf::ServiceMetrics> services;
+
+        /** The connection metrics per server. */
+        std::vector<uaf::ServerMetrics> servers;
+
+        /** The notification metrics per subscription. */
+        std::vector<uaf::SubscriptionMetrics> subscriptions;
+
+        /** The statistics of the notification queue (see Client::notificationQueueStatistics). */
+        uaf::NotificationQueueStatistics notificationQueue;
+
+        /** The number of addresses that were found in the address cache of the resolver. */
+        uint64_t addressCacheHits;
+
+        /** The number of addresses that were looked up in vain in the address cache. */
+        uint64_t addressCacheMisses;
+
+        /** The number of structure definitions that were found in the structure definition
+         *  cache. */
+        uint64_t structureDefinitionCacheHits;
+
+        /** The number of structure definitions that were looked up in vain in the cache. */
+        uint64_t structureDefinitionCacheMisses;
+
+        /** The number of times the cached PKI store could be used to connect a session. */
+        uint64_t pkiStoreCacheHits;
+
+        /** The number of times the PKI store had to be loaded from disk. */
+        uint64_t pkiStoreCacheLoads;
+
+
+        /**
+         * Get the fraction of the address cache lookups that were hits.
+         *
+         * @return  The hit ratio, between 0.0 and 1.0 (0.0 if there were no lookups).
+         */
+        double addressCacheHitRatio() const;
+
+
+        /**
+         * Get the fraction of the structure definition cache lookups that were hits.
+         *
+         * @return  The hit ratio, between 0.0 and 1.0 (0.0 if there were no lookups).
+         */
+        double structureDefinitionCacheHitRatio() const;
+
+
+        /**
+         * Get the fraction of the PKI store acquisitions that didn't need to load the store.
+         *
+         * @return  The hit ratio, between 0.0 and 1.0 (0.0 if there were no acquisitions).
+         */
+        double pkiStoreCacheHitRatio() const;
+
+
+        /**
+         * Get the metrics in the text-based exposition format of Prometheus.
+         *
+         * All metric names start with "uaf_". The servers, services and subscriptions are
+         * identified by the labels "server_uri", "service" and "client_subscription_handle".
+         *
+         * @return  The metrics, one sample per line.
+         */
+        std::string toPrometheus() const;
+
+
+        /**
+         * Write the metrics to a file, in the text-based exposition format of Prometheus.
+         *
+         * The metrics are first written to a temporary file, which then replaces the given file,
+         * so that a reader never sees a partially written file.
+         *
+         * @param fileName  The name of the file.
+         * @return          True if the file was written.
+         */
+        bool writeToFile(const std::string& fileName) const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=34) const;
+
+    };
+
+}
+
+
+
+#endif /* UAF_METRICS_H_ */
@@ -0,0 +1,426 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/metrics/metricsregistry.h"
+
+// platform
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::map;
+    using std::size_t;
+
+
+    // The maximum number of asynchronous invocations that are tracked at the same time (the
+    // results of invocations on a session that is deleted are never received, so the pending
+    // invocations must not grow forever).
+    static const size_t MAX_PENDING_INVOCATIONS = 100000;
+
+
+    // Get a hash of the id of the calling thread
+    // =============================================================================================
+    static size_t currentThreadHash()
+    {
+#ifdef _WIN32
+        size_t hash = size_t(GetCurrentThreadId());
+#else
+        // pthread_t is an opaque type, so we hash its bytes
+        pthread_t self = pthread_self();
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&self);
+        size_t hash = 0;
+        for (size_t i = 0; i < sizeof(self); i++)
+            hash = hash * 31 + bytes[i];
+#endif
+        return hash ^ (hash >> 7) ^ (hash >> 13);
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    MetricsRegistry::MetricsRegistry()
+    {
+        vector<double> boundsSec = ServiceMetrics::latencyBucketBoundsSec();
+        for (size_t i = 0; i < boundsSec.size(); i++)
+            latencyBucketBoundsNs_.push_back(uint64_t(boundsSec[i] * 1e9));
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    MetricsRegistry::~MetricsRegistry()
+    {}
+
+
+    // Get the current time of a monotonic clock
+    // =============================================================================================
+    uint64_t MetricsRegistry::now()
+    {
+#ifdef _WIN32
+        LARGE_INTEGER frequency, counter;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&counter);
+        return uint64_t(double(counter.QuadPart) * 1e9 / double(frequency.QuadPart));
+#else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+#endif
+    }
+
+
+    // Get an id of the calling thread
+    // =============================================================================================
+    uint64_t MetricsRegistry::currentThreadId()
+    {
+#ifdef _WIN32
+        return uint64_t(GetCurrentThreadId());
+#else
+        return uint64_t(currentThreadHash() & 0xFFFFFFFFu);
+#endif
+    }
+
+
+    // Get the shard of the calling thread
+    // =============================================================================================
+    MetricsRegistry::Shard& MetricsRegistry::currentShard()
+    {
+        return shards_[currentThreadHash() % NO_OF_SHARDS];
+    }
+
+
+    // Get the counters of a service
+    // =============================================================================================
+    ServiceMetrics& MetricsRegistry::serviceCounters(Shard& shard, const ServiceKey& key)
+    {
+        ServiceCounters::iterator it = shard.services.find(key);
+
+        if (it == shard.services.end())
+        {
+            it = shard.services.insert(ServiceCounters::value_type(key, ServiceMetrics())).first;
+            it->second.serverUri = key.first;
+            it->second.service   = key.second;
+        }
+
+        return it->second;
+    }
+
+
+    // Get the counters of a server
+    // =============================================================================================
+    ServerMetrics& MetricsRegistry::serverCounters(Shard& shard, const string& serverUri)
+    {
+        ServerCounters::iterator it = shard.servers.find(serverUri);
+
+        if (it == shard.servers.end())
+        {
+            it = shard.servers.insert(ServerCounters::value_type(serverUri, ServerMetrics())).first;
+            it->second.serverUri = serverUri;
+        }
+
+        return it->second;
+    }
+
+
+    // Count the start of a service invocation
+    // =============================================================================================
+    uint64_t MetricsRegistry::serviceStarted(const string& serverUri, const string& service)
+    {
+        Shard& shard = currentShard();
+        UaMutexLocker locker(&shard.mutex); // unlocks when locker goes out of scope
+
+        serviceCounters(shard, ServiceKey(serverUri, service)).inFlight++;
+
+        return now();
+    }
+
+
+    // Count the end of a service invocation
+    // =============================================================================================
+    void MetricsRegistry::serviceFinished(
+            const string&   serverUri,
+            const string&   service,
+            uint64_t        startTime,
+            size_t          noOfTargets,
+            bool            good)
+    {
+        countFinished(ServiceKey(serverUri, service), startTime, noOfTargets, good);
+    }
+
+
+    // Count a finished invocation
+    // =============================================================================================
+    void MetricsRegistry::countFinished(
+            const ServiceKey&   key,
+            uint64_t            startTime,
+            size_t              noOfTargets,
+            bool                good)
+    {
+        uint64_t latency = now() - startTime;
+
+        // find the latency bucket before locking
+        size_t bucket = 0;
+        while (bucket < latencyBucketBoundsNs_.size() && latency > latencyBucketBoundsNs_[bucket])
+            bucket++;
+
+        Shard& shard = currentShard();
+        UaMutexLocker locker(&shard.mutex); // unlocks when locker goes out of scope
+
+        ServiceMetrics& counters = serviceCounters(shard, key);
+        counters.inFlight--;
+        counters.invocations++;
+        if (!good)
+            counters.failures++;
+        counters.targets += noOfTargets;
+        counters.latencySumSec += double(latency) * 1e-9;
+        counters.latencyBucketCounts[bucket]++;
+    }
+
+
+    // Count the start of an asynchronous service invocation
+    // =============================================================================================
+    void MetricsRegistry::asyncServiceStarted(
+            TransactionId   transactionId,
+            const string&   serverUri,
+            const string&   service,
+            size_t          noOfTargets)
+    {
+        PendingInvocation pending;
+        pending.key         = ServiceKey(serverUri, service);
+        pending.noOfTargets = noOfTargets;
+
+        {
+            UaMutexLocker locker(&pendingInvocationsMutex_); // unlocks when out of scope
+
+            if (pendingInvocations_.size() >= MAX_PENDING_INVOCATIONS)
+                return;
+
+            pending.startTime = serviceStarted(serverUri, service);
+            pendingInvocations_[transactionId] = pending;
+        }
+    }
+
+
+    // Count the end of an asynchronous service invocation
+    // =============================================================================================
+    void MetricsRegistry::asyncServiceFinished(TransactionId transactionId, bool good)
+    {
+        PendingInvocation pending;
+
+        {
+            UaMutexLocker locker(&pendingInvocationsMutex_); // unlocks when out of scope
+
+            PendingInvocations::iterator it = pendingInvocations_.find(transactionId);
+            if (it == pendingInvocations_.end())
+                return;
+
+            pending = it->second;
+            pendingInvocations_.erase(it);
+        }
+
+        countFinished(pending.key, pending.startTime, pending.noOfTargets, good);
+    }
+
+
+    // Count an attempt to connect a session
+    // =============================================================================================
+    void MetricsRegistry::connectionAttempted(const string& serverUri, bool good)
+    {
+        Shard& shard = currentShard();
+        UaMutexLocker locker(&shard.mutex); // unlocks when locker goes out of scope
+
+        ServerMetrics& counters = serverCounters(shard, serverUri);
+        counters.connectionAttempts++;
+        if (!good)
+            counters.failedConnectionAttempts++;
+    }
+
+
+    // Count a session that lost its connection
+    // =============================================================================================
+    void MetricsRegistry::connectionLost(const string& serverUri)
+    {
+        Shard& shard = currentShard();
+        UaMutexLocker locker(&shard.mutex); // unlocks when locker goes out of scope
+
+        serverCounters(shard, serverUri).connectionLosses++;
+    }
+
+
+    // Count a session that was reconnected
+    // =============================================================================================
+    void MetricsRegistry::reconnected(const string& serverUri)
+    {
+        Shard& shard = currentShard();
+        UaMutexLocker locker(&shard.mutex); // unlocks when locker goes out of scope
+
+        serverCounters(shard, serverUri).reconnections++;
+    }
+
+
+    // Count a publish response of a subscription
+    // =============================================================================================
+    void MetricsRegistry::notificationsReceived(
+            ClientSubscriptionHandle    clientSubscriptionHandle,
+            size_t                      noOfDataChanges,
+            size_t                      noOfEvents)
+    {
+        uint64_t time = now();
+
+        Shard& shard = currentShard();
+        UaMutexLocker locker(&shard.mutex); // unlocks when locker goes out of scope
+
+        SubscriptionCounters& counters = shard.subscriptions[clientSubscriptionHandle];
+        counters.metrics.clientSubscriptionHandle = clientSubscriptionHandle;
+        counters.metrics.dataChangeNotifications += noOfDataChanges;
+        counters.metrics.eventNotifications += noOfEvents;
+        counters.metrics.publishResponses++;
+        if (counters.firstTime == 0)
+            counters.firstTime = time;
+        counters.lastTime = time;
+    }
+
+
+    // Forget the metrics of a deleted subscription
+    // =============================================================================================
+    void MetricsRegistry::forgetSubscription(ClientSubscriptionHandle clientSubscriptionHandle)
+    {
+        for (size_t i = 0; i < NO_OF_SHARDS; i++)
+        {
+            UaMutexLocker locker(&shards_[i].mutex); // unlocks when locker goes out of scope
+            shards_[i].subscriptions.erase(clientSubscriptionHandle);
+        }
+    }
+
+
+    // Merge the shards
+    // =============================================================================================
+    void MetricsRegistry::merge(Metrics& metrics)
+    {
+        ServiceCounters         services;
+        ServerCounters          servers;
+        SubscriptionCountersMap subscriptions;
+
+        // lock the shards one by one, so the threads that update the other shards can go on
+        for (size_t i = 0; i < NO_OF_SHARDS; i++)
+        {
+            Shard& shard = shards_[i];
+            UaMutexLocker locker(&shard.mutex); // unlocks when locker goes out of scope
+
+            for (ServiceCounters::const_iterator it = shard.services.begin();
+                 it != shard.services.end();
+                 ++it)
+            {
+                ServiceCounters::iterator found = services.find(it->first);
+
+                if (found == services.end())
+                {
+                    services.insert(*it);
+                }
+                else
+                {
+                    found->second.invocations   += it->second.invocations;
+                    found->second.failures      += it->second.failures;
+                    found->second.inFlight      += it->second.inFlight;
+                    found->second.targets       += it->second.targets;
+                    found->second.latencySumSec += it->second.latencySumSec;
+                    for (size_t j = 0; j < found->second.latencyBucketCounts.size(); j++)
+                        found->second.latencyBucketCounts[j] += it->second.latencyBucketCounts[j];
+                }
+            }
+
+            for (ServerCounters::const_iterator it = shard.servers.begin();
+                 it != shard.servers.end();
+                 ++it)
+            {
+                ServerCounters::iterator found = servers.find(it->first);
+
+                if (found == servers.end())
+                {
+                    servers.insert(*it);
+                }
+                else
+                {
+                    found->second.connectionAttempts       += it->second.connectionAttempts;
+                    found->second.failedConnectionAttempts += it->second.failedConnectionAttempts;
+                    found->second.connectionLosses         += it->second.connectionLosses;
+                    found->second.reconnections            += it->second.reconnections;
+                }
+            }
+
+            for (SubscriptionCountersMap::const_iterator it = shard.subscriptions.begin();
+                 it != shard.subscriptions.end();
+                 ++it)
+            {
+                SubscriptionCountersMap::iterator found = subscriptions.find(it->first);
+
+                if (found == subscriptions.end())
+                {
+                    subscriptions.insert(*it);
+                }
+                else
+                {
+                    SubscriptionCounters&       counters = found->second;
+                    const SubscriptionCounters& other    = it->second;
+                    SubscriptionMetrics&        merged   = counters.metrics;
+                    merged.dataChangeNotifications += other.metrics.dataChangeNotifications;
+                    merged.eventNotifications      += other.metrics.eventNotifications;
+                    merged.publishResponses        += other.metrics.publishResponses;
+                    if (other.firstTime < counters.firstTime)
+                        counters.firstTime = other.firstTime;
+                    if (other.lastTime > counters.lastTime)
+                        counters.lastTime = other.lastTime;
+                }
+            }
+        }
+
+        metrics.services.clear();
+        metrics.services.reserve(services.size());
+        for (ServiceCounters::const_iterator it = services.begin(); it != services.end(); ++it)
+            metrics.services.push_back(it->second);
+
+        metrics.servers.clear();
+        metrics.servers.reserve(servers.size());
+        for (ServerCounters::const_iterator it = servers.begin(); it != servers.end(); ++it)
+            metrics.servers.push_back(it->second);
+
+        metrics.subscriptions.clear();
+        metrics.subscriptions.reserve(subscriptions.size());
+        for (SubscriptionCountersMap::const_iterator it = subscriptions.begin();
+             it != subscriptions.end();
+             ++it)
+        {
+            metrics.subscriptions.push_back(it->second.metrics);
+            metrics.subscriptions.back().activeSec =
+                    double(it->second.lastTime - it->second.firstTime) * 1e-9;
+        }
+    }
+
+}
@@ -0,0 +1,281 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_METRICSREGISTRY_H_
+#define UAF_METRICSREGISTRY_H_
+
+
+
+// STD
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <stdint.h>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/handles.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/metrics/metrics.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::MetricsRegistry counts the metrics of a client (see uaf::Metrics) while the client is
+    * running.
+    *
+    * The counters are updated by many threads at the same time (the threads of the user that
+    * invoke services, and the threads of the SDK that receive asynchronous results and
+    * notifications). To avoid that all these threads compete for a single lock, the counters are
+    * spread over a number of shards, and each thread updates the shard that is selected by its
+    * thread id. The shards are only merged when the metrics are read.
+    *
+    * @ingroup ClientMetrics
+    ***********************************************************************************************/
+    class UAF_EXPORT MetricsRegistry
+    {
+    public:
+
+
+        /**
+         * Create an empty registry.
+         */
+        MetricsRegistry();
+
+
+        /**
+         * Destruct the registry.
+         */
+        virtual ~MetricsRegistry();
+
+
+        /**
+         * Get the current time of a monotonic clock, to measure latencies.
+         *
+         * @return  The current time in nanoseconds (since an unspecified moment).
+         */
+        static uint64_t now();
+
+
+        /**
+         * Get an id of the calling thread, to tell the threads apart in a trace.
+         *
+         * @return  The id of the thread on Windows, a (32-bit) hash of it on other platforms.
+         */
+        static uint64_t currentThreadId();
+
+
+        /**
+         * Count the start of a (synchronous) service invocation.
+         *
+         * @param serverUri     The URI of the server on which the service is invoked.
+         * @param service       The name of the service.
+         * @return              The time when the invocation started, to be passed to
+         *                      serviceFinished().
+         */
+        uint64_t serviceStarted(const std::string& serverUri, const std::string& service);
+
+
+        /**
+         * Count the end of a (synchronous) service invocation.
+         *
+         * @param serverUri     The URI of the server on which the service was invoked.
+         * @param service       The name of the service.
+         * @param startTime     The time that was returned by serviceStarted().
+         * @param noOfTargets   The number of targets of the invocation.
+         * @param good          True if the invocation was successful.
+         */
+        void serviceFinished(
+                const std::string&  serverUri,
+                const std::string&  service,
+                uint64_t            startTime,
+                std::size_t         noOfTargets,
+                bool                good);
+
+
+        /**
+         * Count the start of an asynchronous service invocation, of which the result will be
+         * received later by another thread.
+         *
+         * @param transactionId The transaction id of the invocation.
+         * @param serverUri     The URI of the server on which the service is invoked.
+         * @param service       The name of the service.
+         * @param noOfTargets   The number of targets of the invocation.
+         */
+        void asyncServiceStarted(
+                uaf::TransactionId  transactionId,
+                const std::string&  serverUri,
+                const std::string&  service,
+                std::size_t         noOfTargets);
+
+
+        /**
+         * Count the end of an asynchronous service invocation (i.e. the result has been received,
+         * or the invocation could not be sent).
+         *
+         * Unknown transaction ids are ignored.
+         *
+         * @param transactionId The transaction id of the invocation.
+         * @param good          True if the invocation was successful.
+         */
+        void asyncServiceFinished(uaf::TransactionId transactionId, bool good);
+
+
+        /**
+         * Count an attempt to connect a session.
+         *
+         * @param serverUri     The URI of the server.
+         * @param good          True if the session could be connected.
+         */
+        void connectionAttempted(const std::string& serverUri, bool good);
+
+
+        /**
+         * Count a connected session that lost its connection.
+         *
+         * @param serverUri     The URI of the server.
+         */
+        void connectionLost(const std::string& serverUri);
+
+
+        /**
+         * Count a session that was reconnected after it had lost its connection.
+         *
+         * @param serverUri     The URI of the server.
+         */
+        void reconnected(const std::string& serverUri);
+
+
+        /**
+         * Count a publish response that was received by a subscription.
+         *
+         * @param clientSubscriptionHandle  The handle of the subscription.
+         * @param noOfDataChanges           The number of data change notifications.
+         * @param noOfEvents                The number of event notifications.
+         */
+        void notificationsReceived(
+                uaf::ClientSubscriptionHandle   clientSubscriptionHandle,
+                std::size_t                     noOfDataChanges,
+                std::size_t                     noOfEvents);
+
+
+        /**
+         * Forget the metrics of a subscription that has been deleted (so that they are not
+         * mixed up with the metrics of a new subscription that reuses its handle).
+         *
+         * @param clientSubscriptionHandle  The handle of the deleted subscription.
+         */
+        void forgetSubscription(uaf::ClientSubscriptionHandle clientSubscriptionHandle);
+
+
+        /**
+         * Merge the shards into the services, servers and subscriptions of the given metrics.
+         *
+         * @param metrics   Output parameter: the metrics to fill.
+         */
+        void merge(uaf::Metrics& metrics);
+
+
+    private:
+        // no copying or assigning allowed
+        DISALLOW_COPY_AND_ASSIGN(MetricsRegistry);
+
+
+        /** The number of shards. */
+        enum { NO_OF_SHARDS = 16 };
+
+        /** The services are counted per server URI and service name. */
+        typedef std::pair<std::string, std::string> ServiceKey;
+
+        /** The counters of a subscription, and the time of its first and last response. */
+        struct SubscriptionCounters
+        {
+            SubscriptionCounters() : firstTime(0), lastTime(0) {}
+            uaf::SubscriptionMetrics    metrics;
+            uint64_t                    firstTime;
+            uint64_t                    lastTime;
+        };
+
+        typedef std::map<ServiceKey, uaf::ServiceMetrics> ServiceCounters;
+        typedef std::map<std::string, uaf::ServerMetrics> ServerCounters;
+        typedef std::map<uaf::ClientSubscriptionHandle, SubscriptionCounters>
+                SubscriptionCountersMap;
+
+        /** A shard holds a part of the counters, and the mutex to update them. */
+        struct Shard
+        {
+            UaMutex                 mutex;
+            ServiceCounters         services;
+            ServerCounters          servers;
+            SubscriptionCountersMap subscriptions;
+        };
+
+        /** An asynchronous invocation of which the result has not been received yet. */
+        struct PendingInvocation
+        {
+            ServiceKey  key;
+            uint64_t    startTime;
+            std::size_t noOfTargets;
+        };
+
+        typedef std::map<uaf::TransactionId, PendingInvocation> PendingInvocations;
+
+
+        // get the shard of the calling thread
+        Shard& currentShard();
+
+        // get the counters of a service within a (locked) shard
+        uaf::ServiceMetrics& serviceCounters(Shard& shard, const ServiceKey& key);
+
+        // get the counters of a server within a (locked) shard
+        uaf::ServerMetrics& serverCounters(Shard& shard, const std::string& serverUri);
+
+        // count a finished invocation
+        void countFinished(
+                const ServiceKey&   key,
+                uint64_t            startTime,
+                std::size_t         noOfTargets,
+                bool                good);
+
+
+        /** The shards. */
+        Shard shards_[NO_OF_SHARDS];
+
+        /** The upper bounds of the latency buckets, in nanoseconds. */
+        std::vector<uint64_t> latencyBucketBoundsNs_;
+
+        /** The asynchronous invocations that are in progress. */
+        PendingInvocations pendingInvocations_;
+
+        /** The mutex to safely manipulate the pending invocations. */
+        UaMutex pendingInvocationsMutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_METRICSREGISTRY_H_ */
@@ -0,0 +1,71 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/metrics/servermetrics.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+
+
+    // Constructor
+    // =============================================================================================
+    ServerMetrics::ServerMetrics()
+    : connectionAttempts(0),
+      failedConnectionAttempts(0),
+      connectionLosses(0),
+      reconnections(0)
+    {}
+
+
+    // Get a string representation
+    // =============================================================================================
+    string ServerMetrics::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - serverUri";
+        ss << fillToPos(ss, colon);
+        ss << ": " << serverUri << "\n";
+
+        ss << indent << " - connectionAttempts";
+        ss << fillToPos(ss, colon);
+        ss << ": " << connectionAttempts << "\n";
+
+        ss << indent << " - failedConnectionAttempts";
+        ss << fillToPos(ss, colon);
+        ss << ": " << failedConnectionAttempts << "\n";
+
+        ss << indent << " - connectionLosses";
+        ss << fillToPos(ss, colon);
+        ss << ": " << connectionLosses << "\n";
+
+        ss << indent << " - reconnections";
+        ss << fillToPos(ss, colon);
+        ss << ": " << reconnections;
+
+        return ss.str();
+    }
+
+}
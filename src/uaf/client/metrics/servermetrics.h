@@ -0,0 +1,88 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SERVERMETRICS_H_
+#define UAF_SERVERMETRICS_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::ServerMetrics object holds the connection metrics of the sessions to a particular
+    * server.
+    *
+    * @ingroup ClientMetrics
+    ***********************************************************************************************/
+    class UAF_EXPORT ServerMetrics
+    {
+    public:
+
+
+        /**
+         * Create empty server metrics.
+         */
+        ServerMetrics();
+
+
+        /** The URI of the server. */
+        std::string serverUri;
+
+        /** The number of times a session tried to connect to the server. */
+        uint64_t connectionAttempts;
+
+        /** The number of connection attempts that failed. */
+        uint64_t failedConnectionAttempts;
+
+        /** The number of times a connected session lost its connection to the server. */
+        uint64_t connectionLosses;
+
+        /** The number of times a session that had lost its connection was reconnected (by the
+         *  SDK) to the server. */
+        uint64_t reconnections;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=26) const;
+
+    };
+
+}
+
+
+
+#endif /* UAF_SERVERMETRICS_H_ */
@@ -0,0 +1,172 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/metrics/servicemetrics.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+
+
+    // The upper bounds of the latency buckets, in seconds
+    static const double LATENCY_BUCKET_BOUNDS_SEC[] = {
+            0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+            0.1,    0.25,  0.5,    1.0,   2.5,  5.0,   10.0 };
+
+    static const std::size_t NO_OF_LATENCY_BUCKET_BOUNDS =
+            sizeof(LATENCY_BUCKET_BOUNDS_SEC) / sizeof(LATENCY_BUCKET_BOUNDS_SEC[0]);
+
+
+    // Constructor
+    // =============================================================================================
+    ServiceMetrics::ServiceMetrics()
+    : invocations(0),
+      failures(0),
+      inFlight(0),
+      targets(0),
+      latencySumSec(0.0),
+      latencyBucketCounts(NO_OF_LATENCY_BUCKET_BOUNDS + 1, 0)
+    {}
+
+
+    // Get the upper bounds of the latency buckets
+    // =============================================================================================
+    vector<double> ServiceMetrics::latencyBucketBoundsSec()
+    {
+        return vector<double>(LATENCY_BUCKET_BOUNDS_SEC,
+                              LATENCY_BUCKET_BOUNDS_SEC + NO_OF_LATENCY_BUCKET_BOUNDS);
+    }
+
+
+    // Get the mean latency
+    // =============================================================================================
+    double ServiceMetrics::meanLatencySec() const
+    {
+        return invocations == 0 ? 0.0 : latencySumSec / double(invocations);
+    }
+
+
+    // Estimate a percentile of the latency
+    // =============================================================================================
+    double ServiceMetrics::latencyPercentileSec(double percentile) const
+    {
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < latencyBucketCounts.size(); i++)
+            total += latencyBucketCounts[i];
+
+        if (total == 0)
+            return 0.0;
+
+        double rank = percentile * double(total);
+        double lowerBound = 0.0;
+        uint64_t counted = 0;
+
+        for (std::size_t i = 0; i < latencyBucketCounts.size(); i++)
+        {
+            if (i >= NO_OF_LATENCY_BUCKET_BOUNDS)
+                break;
+
+            uint64_t count = latencyBucketCounts[i];
+            double upperBound = LATENCY_BUCKET_BOUNDS_SEC[i];
+
+            if (count > 0 && double(counted + count) >= rank)
+            {
+                double fraction = (rank - double(counted)) / double(count);
+                if (fraction < 0.0)
+                    fraction = 0.0;
+                return lowerBound + fraction * (upperBound - lowerBound);
+            }
+
+            counted += count;
+            lowerBound = upperBound;
+        }
+
+        return LATENCY_BUCKET_BOUNDS_SEC[NO_OF_LATENCY_BUCKET_BOUNDS - 1];
+    }
+
+
+    // Get the mean number of targets
+    // =============================================================================================
+    double ServiceMetrics::meanTargets() const
+    {
+        return invocations == 0 ? 0.0 : double(targets) / double(invocations);
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string ServiceMetrics::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - serverUri";
+        ss << fillToPos(ss, colon);
+        ss << ": " << serverUri << "\n";
+
+        ss << indent << " - service";
+        ss << fillToPos(ss, colon);
+        ss << ": " << service << "\n";
+
+        ss << indent << " - invocations";
+        ss << fillToPos(ss, colon);
+        ss << ": " << invocations << "\n";
+
+        ss << indent << " - failures";
+        ss << fillToPos(ss, colon);
+        ss << ": " << failures << "\n";
+
+        ss << indent << " - inFlight";
+        ss << fillToPos(ss, colon);
+        ss << ": " << inFlight << "\n";
+
+        ss << indent << " - targets";
+        ss << fillToPos(ss, colon);
+        ss << ": " << targets << "\n";
+
+        ss << indent << " - latencySumSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << latencySumSec << "\n";
+
+        ss << indent << " - meanLatencySec()";
+        ss << fillToPos(ss, colon);
+        ss << ": " << meanLatencySec() << "\n";
+
+        ss << indent << " - latencyBucketCounts[]";
+        for (std::size_t i = 0; i < latencyBucketCounts.size(); i++)
+        {
+            ss << "\n";
+            ss << indent << "    - latencyBucketCounts[" << i << "]";
+            ss << fillToPos(ss, colon);
+            ss << ": " << latencyBucketCounts[i];
+            if (i < NO_OF_LATENCY_BUCKET_BOUNDS)
+                ss << " (<= " << LATENCY_BUCKET_BOUNDS_SEC[i] << "s)";
+            else
+                ss << " (> " << LATENCY_BUCKET_BOUNDS_SEC[NO_OF_LATENCY_BUCKET_BOUNDS - 1] << "s)";
+        }
+
+        return ss.str();
+    }
+
+}
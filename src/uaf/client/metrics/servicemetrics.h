@@ -0,0 +1,144 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SERVICEMETRICS_H_
+#define UAF_SERVICEMETRICS_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::ServiceMetrics object holds the metrics of a particular service (e.g. "Read" or
+    * "AsyncWrite") that was invoked on a particular server.
+    *
+    * The latencies are counted in a histogram: latencyBucketCounts[i] is the number of
+    * invocations that took longer than latencyBucketBoundsSec()[i-1] seconds, but not longer than
+    * latencyBucketBoundsSec()[i] seconds. The last bucket counts the invocations that took longer
+    * than the highest bound.
+    *
+    * The latency of a synchronous service is the time needed to invoke it (including the
+    * conversions between the UAF and the SDK). The latency of an asynchronous service is the time
+    * between the moment it was sent and the moment its result was received.
+    *
+    * @ingroup ClientMetrics
+    ***********************************************************************************************/
+    class UAF_EXPORT ServiceMetrics
+    {
+    public:
+
+
+        /**
+         * Create empty service metrics.
+         */
+        ServiceMetrics();
+
+
+        /** The URI of the server on which the service was invoked. */
+        std::string serverUri;
+
+        /** The name of the service (e.g. "Read", "AsyncRead", "CreateMonitoredData", ...). */
+        std::string service;
+
+        /** The number of invocations that were finished. */
+        uint64_t invocations;
+
+        /** The number of finished invocations that failed (i.e. their status was not good). */
+        uint64_t failures;
+
+        /** The number of invocations that were started but not finished yet. */
+        int64_t inFlight;
+
+        /** The total number of targets of the finished invocations. */
+        uint64_t targets;
+
+        /** The sum of the latencies of the finished invocations, in seconds. */
+        double latencySumSec;
+
+        /** The number of invocations per latency bucket (see latencyBucketBoundsSec()). */
+        std::vector<uint64_t> latencyBucketCounts;
+
+
+        /**
+         * Get the upper bounds of the latency buckets, in seconds.
+         *
+         * There is one more bucket than there are bounds: the last bucket has no upper bound.
+         *
+         * @return  The upper bounds (in increasing order).
+         */
+        static std::vector<double> latencyBucketBoundsSec();
+
+
+        /**
+         * Get the mean latency of the finished invocations.
+         *
+         * @return  The mean latency in seconds (0.0 if no invocations were finished).
+         */
+        double meanLatencySec() const;
+
+
+        /**
+         * Estimate a percentile of the latency (e.g. 0.99 for the 99th percentile), by
+         * interpolating within the bucket of the histogram that holds the percentile.
+         *
+         * @param percentile    The percentile, between 0.0 and 1.0.
+         * @return              The estimated latency in seconds (0.0 if no invocations were
+         *                      finished). If the percentile falls in the last bucket, the highest
+         *                      bound is returned.
+         */
+        double latencyPercentileSec(double percentile) const;
+
+
+        /**
+         * Get the mean number of targets per finished invocation.
+         *
+         * @return  The mean number of targets (0.0 if no invocations were finished).
+         */
+        double meanTargets() const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=24) const;
+
+    };
+
+}
+
+
+
+#endif /* UAF_SERVICEMETRICS_H_ */
@@ -0,0 +1,87 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/metrics/subscriptionmetrics.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+
+
+    // Constructor
+    // =============================================================================================
+    SubscriptionMetrics::SubscriptionMetrics()
+    : clientSubscriptionHandle(0),
+      dataChangeNotifications(0),
+      eventNotifications(0),
+      publishResponses(0),
+      activeSec(0.0)
+    {}
+
+
+    // Get the mean notification rate
+    // =============================================================================================
+    double SubscriptionMetrics::notificationsPerSec() const
+    {
+        if (activeSec <= 0.0)
+            return 0.0;
+        else
+            return double(dataChangeNotifications + eventNotifications) / activeSec;
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string SubscriptionMetrics::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - clientSubscriptionHandle";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientSubscriptionHandle << "\n";
+
+        ss << indent << " - dataChangeNotifications";
+        ss << fillToPos(ss, colon);
+        ss << ": " << dataChangeNotifications << "\n";
+
+        ss << indent << " - eventNotifications";
+        ss << fillToPos(ss, colon);
+        ss << ": " << eventNotifications << "\n";
+
+        ss << indent << " - publishResponses";
+        ss << fillToPos(ss, colon);
+        ss << ": " << publishResponses << "\n";
+
+        ss << indent << " - activeSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << activeSec << "\n";
+
+        ss << indent << " - notificationsPerSec()";
+        ss << fillToPos(ss, colon);
+        ss << ": " << notificationsPerSec();
+
+        return ss.str();
+    }
+
+}
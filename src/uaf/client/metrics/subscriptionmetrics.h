@@ -0,0 +1,97 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SUBSCRIPTIONMETRICS_H_
+#define UAF_SUBSCRIPTIONMETRICS_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/handles.h"
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::SubscriptionMetrics object holds the notification metrics of a particular
+    * subscription.
+    *
+    * @ingroup ClientMetrics
+    ***********************************************************************************************/
+    class UAF_EXPORT SubscriptionMetrics
+    {
+    public:
+
+
+        /**
+         * Create empty subscription metrics.
+         */
+        SubscriptionMetrics();
+
+
+        /** The handle of the subscription, as assigned by the client. */
+        uaf::ClientSubscriptionHandle clientSubscriptionHandle;
+
+        /** The number of data change notifications that were received. */
+        uint64_t dataChangeNotifications;
+
+        /** The number of event notifications that were received. */
+        uint64_t eventNotifications;
+
+        /** The number of publish responses (containing notifications) that were received. */
+        uint64_t publishResponses;
+
+        /** The time between the first and the last publish response, in seconds. */
+        double activeSec;
+
+
+        /**
+         * Get the mean rate of the (data change and event) notifications, between the first and
+         * the last publish response.
+         *
+         * @return  The number of notifications per second (0.0 if the rate is not known yet).
+         */
+        double notificationsPerSec() const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=26) const;
+
+    };
+
+}
+
+
+
+#endif /* UAF_SUBSCRIPTIONMETRICS_H_ */
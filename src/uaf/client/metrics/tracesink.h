@@ -0,0 +1,69 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_TRACESINK_H_
+#define UAF_TRACESINK_H_
+
+
+
+// STD
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/results/requesttrace.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::TraceSink receives the traces of the requests that were traced by a client (see
+    * uaf::ClientSettings::traceRequests and uaf::Client::setTraceSink()).
+    *
+    * The traces are passed by the threads that processed the requests, so an implementation
+    * must be thread-safe, and should return quickly.
+    *
+    * @ingroup ClientMetrics
+    ***********************************************************************************************/
+    class UAF_EXPORT TraceSink
+    {
+    public:
+        /**
+         * Virtual destructor.
+         */
+        virtual ~TraceSink() {}
+
+
+        /**
+         * Override this method to handle the trace of a request, once the request has been
+         * processed.
+         *
+         * @param trace The trace of the request.
+         */
+        virtual void traceFinished(const uaf::RequestTrace& trace) = 0;
+
+    };
+}
+
+
+#endif /* UAF_TRACESINK_H_ */
@@ -0,0 +1,112 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_TRACETIMER_H_
+#define UAF_TRACETIMER_H_
+
+
+
+// STD
+#include <string>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/results/requesttrace.h"
+#include "uaf/client/metrics/metricsregistry.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::TraceTimer adds a span to a trace for the scope in which it lives (or until stop()
+    * is called).
+    *
+    * If the trace is NULL (i.e. if the request is not traced), the timer does nothing at all, not
+    * even reading the clock.
+    *
+    * @ingroup ClientMetrics
+    ***********************************************************************************************/
+    class UAF_EXPORT TraceTimer
+    {
+    public:
+
+
+        /**
+         * Start the timer.
+         *
+         * @param trace     The trace to add the span to, or NULL if the request is not traced.
+         * @param stage     The name of the stage (a string literal).
+         * @param serverUri The URI of the server involved in the stage, or NULL. The string must
+         *                  outlive the timer.
+         */
+        TraceTimer(
+                uaf::RequestTrace*  trace,
+                const char*         stage,
+                const std::string*  serverUri = NULL)
+        : trace_(trace),
+          stage_(stage),
+          serverUri_(serverUri),
+          startTime_(trace != NULL ? uaf::MetricsRegistry::now() : 0)
+        {}
+
+
+        /**
+         * Stop the timer, if it wasn't stopped already.
+         */
+        ~TraceTimer() { stop(); }
+
+
+        /**
+         * Stop the timer, and add the span to the trace.
+         */
+        void stop()
+        {
+            if (trace_ != NULL)
+            {
+                trace_->addSpan(stage_,
+                                serverUri_ != NULL ? *serverUri_ : std::string(),
+                                startTime_,
+                                uaf::MetricsRegistry::now());
+                trace_ = NULL;
+            }
+        }
+
+
+    private:
+
+        DISALLOW_COPY_AND_ASSIGN(TraceTimer);
+
+        uaf::RequestTrace*  trace_;
+        const char*         stage_;
+        const std::string*  serverUri_;
+        uint64_t            startTime_;
+
+    };
+
+}
+
+
+
+#endif /* UAF_TRACETIMER_H_ */
@@ -106,8 +106,9 @@ namespace uaf
 
     private:
 
-        // the Resolver can see all private members
+        // the Resolver (and the ResolvedItems it produces) can see all private members
         friend class Resolver;
+        friend class ResolvedItems;
 
 
         /**
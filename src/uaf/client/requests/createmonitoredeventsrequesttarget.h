@@ -140,8 +140,9 @@ namespace uaf
                 const CreateMonitoredEventsRequestTarget& object2);
     private:
 
-        // the Resolver can see all private members
+        // the Resolver (and the ResolvedItems it produces) can see all private members
         friend class Resolver;
+        friend class ResolvedItems;
 
         /**
          * Get the resolvable items from the target as a "flat" list of Addresses.
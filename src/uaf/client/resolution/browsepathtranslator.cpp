@@ -0,0 +1,233 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/resolution/browsepathtranslator.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::size_t;
+
+
+    // Constructor
+    //==============================================================================================
+    BrowsePathTranslator::BrowsePathTranslator(
+            LoggerFactory*  loggerFactory,
+            SessionFactory* sessionFactory)
+    : sessionFactory_(sessionFactory)
+    {
+        logger_ = new Logger(loggerFactory, "Translator");
+        logger_->debug("The browse path translator has been constructed");
+    }
+
+
+    // Destructor
+    //==============================================================================================
+    BrowsePathTranslator::~BrowsePathTranslator()
+    {
+        logger_->debug("Destructing the browse path translator");
+
+        for (Servers::iterator iter = servers_.begin(); iter != servers_.end(); ++iter)
+            delete iter->second;
+        servers_.clear();
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Translate some browse paths
+    //==============================================================================================
+    Status BrowsePathTranslator::translate(
+            const vector<BrowsePath>&                           browsePaths,
+            const Mask&                                         mask,
+            vector<TranslateBrowsePathsToNodeIdsResultTarget>&  results)
+    {
+        Status ret(statuscodes::Good);
+
+        size_t noOfBrowsePaths = browsePaths.size();
+
+        results.resize(noOfBrowsePaths);
+
+        // the translations of the indicated browse paths (null for the others)
+        vector<Translation*> translations(noOfBrowsePaths, static_cast<Translation*>(0));
+
+        // the number of browse paths that didn't need a translation of their own
+        size_t noOfShared = 0;
+
+        mutex_.lock();
+
+        // join the translations of identical browse paths, or add a pending translation
+        for (size_t i = 0; i < noOfBrowsePaths; i++)
+        {
+            if (mask.isSet(i))
+            {
+                // get the server that hosts the starting node (browse paths without server URI
+                // are grouped under the empty URI, the session factory will report the error)
+                const ExpandedNodeId& start = browsePaths[i].startingExpandedNodeId;
+                Server*& server = servers_[start.hasServerUri() ? start.serverUri() : string()];
+                if (server == 0)
+                    server = new Server();
+
+                Translations::iterator iter = server->inFlight.find(browsePaths[i]);
+
+                if (iter == server->inFlight.end())
+                {
+                    std::pair<Translations::iterator, bool> inserted = server->pending.insert(
+                            Translations::value_type(browsePaths[i], 0));
+
+                    if (inserted.second)
+                    {
+                        inserted.first->second = new Translation();
+                        inserted.first->second->server = server;
+                    }
+                    else
+                    {
+                        noOfShared++;
+                    }
+
+                    iter = inserted.first;
+                }
+                else
+                {
+                    noOfShared++;
+                }
+
+                iter->second->references++;
+                translations[i] = iter->second;
+            }
+        }
+
+        logger_->debug("Translating %d browse paths (%d of them are shared with others)",
+                       mask.setCount(), noOfShared);
+
+        // wait until all our translations are done, or become the leader and do them ourselves
+        for (size_t i = 0; i < noOfBrowsePaths; i++)
+        {
+            while (translations[i] != 0 && !translations[i]->done)
+            {
+                Server& server = *translations[i]->server;
+
+                if (server.busy)
+                {
+                    server.waiters++;
+                    mutex_.unlock();
+                    server.finishedSemaphore.wait();
+                    mutex_.lock();
+                }
+                else
+                {
+                    translatePending(server);
+                }
+            }
+        }
+
+        // copy the results, and release the translations
+        for (size_t i = 0; i < noOfBrowsePaths; i++)
+        {
+            if (translations[i] != 0)
+            {
+                if (ret.isGood() && translations[i]->status.isNotGood())
+                    ret = translations[i]->status;
+
+                results[i] = translations[i]->result;
+
+                translations[i]->references--;
+                if (translations[i]->references == 0)
+                    delete translations[i];
+            }
+        }
+
+        mutex_.unlock();
+
+        return ret;
+    }
+
+
+    // Send the pending translations of a server
+    //==============================================================================================
+    void BrowsePathTranslator::translatePending(Server& server)
+    {
+        server.busy = true;
+
+        // all pending translations are now in flight
+        server.inFlight.swap(server.pending);
+
+        TranslateBrowsePathsToNodeIdsRequest request;
+        request.targets.reserve(server.inFlight.size());
+        for (Translations::const_iterator iter = server.inFlight.begin();
+             iter != server.inFlight.end();
+             ++iter)
+            request.targets.push_back(TranslateBrowsePathsToNodeIdsRequestTarget(iter->first));
+
+        // the other threads only look up the inFlight translations while we're invoking the
+        // request, so we can safely unlock the mutex
+        mutex_.unlock();
+
+        logger_->debug("Sending %d browse paths in a single request", request.targets.size());
+
+        TranslateBrowsePathsToNodeIdsResult result;
+        Status status = sessionFactory_->invokeRequest<TranslateBrowsePathsToNodeIdsService>(
+                request,
+                Mask(request.targets.size(), true),
+                result);
+
+        mutex_.lock();
+
+        // the targets of the request and the result are in the same order as the inFlight map
+        size_t rank = 0;
+        for (Translations::iterator iter = server.inFlight.begin();
+             iter != server.inFlight.end();
+             ++iter)
+        {
+            if (rank < result.targets.size())
+                iter->second->result = result.targets[rank];
+
+            // if the invocation failed, the targets that weren't translated still have an
+            // uncertain status (the others keep the result that the server gave them)
+            if (status.isNotGood() && iter->second->result.status.isUncertain())
+            {
+                iter->second->status        = status;
+                iter->second->result.status = status;
+            }
+            else
+            {
+                iter->second->status = statuscodes::Good;
+            }
+
+            iter->second->done = true;
+            rank++;
+        }
+
+        server.inFlight.clear();
+        server.busy = false;
+
+        // wake up the waiting threads: their translations are done now, or one of them becomes
+        // the next leader
+        if (server.waiters > 0)
+        {
+            server.finishedSemaphore.post(server.waiters);
+            server.waiters = 0;
+        }
+    }
+
+}
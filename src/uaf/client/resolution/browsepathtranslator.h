@@ -0,0 +1,180 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_BROWSEPATHTRANSLATOR_H_
+#define UAF_BROWSEPATHTRANSLATOR_H_
+
+
+// STD
+#include <string>
+#include <vector>
+#include <map>
+// SDK
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/status.h"
+#include "uaf/util/browsepath.h"
+#include "uaf/util/mask.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/sessions/sessionfactory.h"
+#include "uaf/client/requests/requests.h"
+#include "uaf/client/results/results.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::BrowsePathTranslator translates browse paths into ExpandedNodeIds, by invoking the
+    * TranslateBrowsePathsToNodeIds service.
+    *
+    * Identical browse paths are only translated once: within a single call of translate(), but
+    * also across the threads that call translate() at the same time. Per server, at most one
+    * TranslateBrowsePathsToNodeIds request is in flight: while one thread (the "leader") is
+    * waiting for its result, the browse paths of the other threads for the same server are
+    * collected, and they are all sent together by the next leader as soon as the first request
+    * has finished. Threads that need a browse path that is already being translated simply wait
+    * for its result. The servers don't wait for each other, so a slow or unreachable server
+    * doesn't delay the translations of the other servers.
+    *
+    * @ingroup ClientResolution
+    ***********************************************************************************************/
+    class UAF_EXPORT BrowsePathTranslator
+    {
+    public:
+
+
+        /**
+         * Construct a translator.
+         *
+         * @param loggerFactory     Logger factory to log all messages to.
+         * @param sessionFactory    Session factory to invoke the service requests.
+         */
+        BrowsePathTranslator(
+                uaf::LoggerFactory*     loggerFactory,
+                uaf::SessionFactory*    sessionFactory);
+
+
+        /**
+         * Destruct the translator.
+         */
+        virtual ~BrowsePathTranslator();
+
+
+        /**
+         * Translate some browse paths.
+         *
+         * @param browsePaths   The browse paths of which those indicated by the mask will be
+         *                      translated.
+         * @param mask          The mask indicating the browse paths to translate.
+         * @param results       Output parameter: the translation results (this vector will be
+         *                      resized to the size of the browsePaths parameter, and only the
+         *                      targets indicated by the mask will be updated).
+         * @return              Good if the TranslateBrowsePathsToNodeIds service could be invoked
+         *                      for all indicated browse paths, bad if not.
+         */
+        uaf::Status translate(
+                const std::vector<uaf::BrowsePath>&                         browsePaths,
+                const uaf::Mask&                                            mask,
+                std::vector<uaf::TranslateBrowsePathsToNodeIdsResultTarget>& results);
+
+
+
+    private:
+
+
+        // no copying or assigning allowed
+        DISALLOW_COPY_AND_ASSIGN(BrowsePathTranslator);
+
+
+        // the translations of a single server
+        struct Server;
+
+
+        // a browse path that is being translated, possibly on behalf of several threads
+        struct Translation
+        {
+            Translation() : server(0), done(false), references(0) {}
+
+            // the server that hosts the starting node of the browse path
+            Server*                                         server;
+            // the result of the service invocation for the server of the browse path, and the
+            // result target of the browse path
+            uaf::Status                                     status;
+            uaf::TranslateBrowsePathsToNodeIdsResultTarget  result;
+            // true as soon as the status and result are valid
+            bool                                            done;
+            // the number of calls of translate() that are interested in the result
+            uint32_t                                        references;
+        };
+
+        typedef std::map<uaf::BrowsePath, Translation*> Translations;
+
+
+        // the translations of a single server
+        struct Server
+        {
+            Server() : busy(false), waiters(0) {}
+
+            // the browse paths that wait to be sent by the next leader
+            Translations            pending;
+            // the browse paths that are being translated by the current leader
+            Translations            inFlight;
+            // true while a leader is translating the inFlight browse paths
+            bool                    busy;
+            // the number of threads that wait for the current leader to finish
+            uint32_t                waiters;
+            // the semaphore that is posted (once per waiter) when the current leader has finished
+            UaSemaphore             finishedSemaphore;
+        };
+
+        // the servers, by server URI (they're only deleted when the translator is destructed)
+        typedef std::map<std::string, Server*> Servers;
+
+
+        /**
+         * Send all pending translations of a server in a single request, and store the results.
+         *
+         * Must be called while holding the mutex (which is unlocked during the invocation).
+         */
+        void translatePending(Server& server);
+
+
+        // the logger
+        uaf::Logger*            logger_;
+        // the session factory to invoke the requests
+        uaf::SessionFactory*    sessionFactory_;
+
+        // the translations of all servers
+        Servers                 servers_;
+
+        // the mutex that protects all of the above
+        UaMutex                 mutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_BROWSEPATHTRANSLATOR_H_ */
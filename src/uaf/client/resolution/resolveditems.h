@@ -0,0 +1,164 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_RESOLVEDITEMS_H_
+#define UAF_RESOLVEDITEMS_H_
+
+
+// STD
+#include <vector>
+#include <cstddef>
+// SDK
+// UAF
+#include "uaf/util/status.h"
+#include "uaf/util/expandednodeid.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * The uaf::ResolvedItems hold the results of the resolution of a request, beside the request.
+    *
+    * A request is never modified by the resolution: instead, the resolved ExpandedNodeIds are
+    * stored here (as one flat list, with for each resolved target the range of its items), and
+    * they are only applied to the copies of the targets that are made for the service invocations.
+    * This way, a request can be processed (and stored, in case of a persistent request) without
+    * copying it first.
+    *
+    * @ingroup ClientResolution
+    ***********************************************************************************************/
+    class UAF_EXPORT ResolvedItems
+    {
+    public:
+
+
+        /**
+         * Construct an empty ResolvedItems instance (i.e. no target is resolved).
+         */
+        ResolvedItems() {}
+
+
+        /**
+         * Forget all resolved items, and prepare for a request with the given number of targets.
+         *
+         * @param noOfTargets   The number of targets of the request.
+         */
+        void reset(std::size_t noOfTargets)
+        {
+            expandedNodeIds_.clear();
+            statuses_.clear();
+            ranges_.assign(noOfTargets, Range());
+        }
+
+
+        /**
+         * Take over the flat list of resolved items, without copying them.
+         *
+         * @param expandedNodeIds   The resolved ExpandedNodeIds (will be empty afterwards).
+         * @param statuses          The resolution statuses (will be empty afterwards).
+         */
+        void takeOver(
+                std::vector<uaf::ExpandedNodeId>&   expandedNodeIds,
+                std::vector<uaf::Status>&           statuses)
+        {
+            expandedNodeIds_.clear();
+            statuses_.clear();
+            expandedNodeIds_.swap(expandedNodeIds);
+            statuses_.swap(statuses);
+        }
+
+
+        /**
+         * Mark a target as resolved.
+         *
+         * @param rank  The rank of the target within the request.
+         * @param begin Index of the first item of the target, within the flat list.
+         * @param end   Index beyond the last item of the target, within the flat list.
+         */
+        void setResolved(std::size_t rank, std::size_t begin, std::size_t end)
+        {
+            ranges_[rank].begin = begin;
+            ranges_[rank].end   = end;
+        }
+
+
+        /**
+         * Check if a target has resolved items.
+         *
+         * @param rank  The rank of the target within the request.
+         * @return      True if resolved items must be applied to the target.
+         */
+        bool isResolved(std::size_t rank) const
+        {
+            return rank < ranges_.size() && ranges_[rank].end > ranges_[rank].begin;
+        }
+
+
+        /**
+         * Apply the resolved items to (a copy of) a target.
+         *
+         * @param rank      The rank of the target within the request.
+         * @param target    The target to update (e.g. the copy owned by an invocation).
+         * @return          Good if the items could be applied, Bad if not.
+         */
+        template<typename _RequestTarget>
+        uaf::Status applyTo(std::size_t rank, _RequestTarget& target) const
+        {
+            const Range& range = ranges_[rank];
+
+            std::vector<uaf::ExpandedNodeId> targetExpandedNodeIds(
+                    expandedNodeIds_.begin() + range.begin,
+                    expandedNodeIds_.begin() + range.end);
+            std::vector<uaf::Status> targetStatuses(
+                    statuses_.begin() + range.begin,
+                    statuses_.begin() + range.end);
+
+            return target.setResolvedItems(targetExpandedNodeIds, targetStatuses);
+        }
+
+
+    private:
+
+
+        // the range of the items of one target, within the flat lists
+        struct Range
+        {
+            Range() : begin(0), end(0) {}
+            std::size_t begin;
+            std::size_t end;
+        };
+
+
+        // the resolved ExpandedNodeIds of all resolved targets
+        std::vector<uaf::ExpandedNodeId> expandedNodeIds_;
+        // the resolution statuses of all resolved targets
+        std::vector<uaf::Status> statuses_;
+        // for each target of the request, the range of its items
+        std::vector<Range> ranges_;
+    };
+
+
+}
+
+
+#endif /* UAF_RESOLVEDITEMS_H_ */
@@ -36,7 +36,8 @@ namespace uaf
             SessionFactory* sessionFactory,
             Database*       database)
     : sessionFactory_(sessionFactory),
-      database_(database)
+      database_(database),
+      translator_(loggerFactory, sessionFactory)
     {
         logger_ = new Logger(loggerFactory, "Resolver");
         logger_->debug("The resolver has been constructed");
@@ -54,6 +55,8 @@ namespace uaf
 
 
 
+    // Sort the addresses, and resolve the cached relative paths
+    //==============================================================================================
     Status Resolver::resolveCached(
             const vector<Address>&  addresses,
             vector<ExpandedNodeId>& expandedNodeIds,
@@ -73,37 +76,72 @@ namespace uaf
         expandedNodeIdMask.resize(noOfAddresses);
         relativePathMask.resize(noOfAddresses);
 
-        // loop through the addresses
+        // sort the addresses (fully qualified ExpandedNodeIds don't need the cache at all)
         for (size_t i=0; i<noOfAddresses; i++)
         {
-            logger_->debug("Trying to find address %d in the cache", i);
-
-            if (database_->addressCache.find(addresses[i], expandedNodeIds[i]))
+            if (addresses[i].isExpandedNodeId())
+            {
+                expandedNodeIdMask.set(i);
+            }
+            else if (addresses[i].isRelativePath())
             {
-                statuses[i] = statuscodes::Good;
-                logger_->debug("Address %d was already cached", i);
+                relativePathMask.set(i);
             }
             else
             {
-                if (addresses[i].isExpandedNodeId())
-                {
-                    expandedNodeIdMask.set(i);
-                    logger_->debug("Address %d is an ExpandedNodeId not found in the cache", i);
-                }
-                else if (addresses[i].isRelativePath())
+                ret = EmptyAddressError();
+                logger_->error("Address %d cannot be resolved since it's an empty address", i);
+                break;
+            }
+        }
+
+        // look up all relative paths in the cache at once
+        if (ret.isGood() && relativePathMask.setCount() > 0)
+        {
+            Mask cachedMask;
+            size_t noOfCached = database_->addressCache.find(addresses,
+                                                             relativePathMask,
+                                                             expandedNodeIds,
+                                                             cachedMask);
+
+            logger_->debug("%d of the %d relative paths were cached",
+                           noOfCached, relativePathMask.setCount());
+
+            for (size_t i=0; i<noOfAddresses && noOfCached > 0; i++)
+            {
+                if (cachedMask.isSet(i))
                 {
-                    relativePathMask.set(i);
-                    logger_->debug("Address %d is a RelativePath not found in the cache", i);
+                    statuses[i] = statuscodes::Good;
+                    relativePathMask.unset(i);
+                    noOfCached--;
                 }
-                else
+            }
+        }
+
+        // skip the relative paths that could not be resolved recently (if failures are cached)
+        if (   ret.isGood()
+            && relativePathMask.setCount() > 0
+            && database_->clientSettings.failedResolutionCacheTimeSec > 0.0)
+        {
+            Mask failedMask;
+            size_t noOfFailed = database_->addressCache.findFailures(addresses,
+                                                                     relativePathMask,
+                                                                     statuses,
+                                                                     failedMask);
+
+            for (size_t i=0; i<noOfAddresses && noOfFailed > 0; i++)
+            {
+                if (failedMask.isSet(i))
                 {
-                    ret = EmptyAddressError();
-                    logger_->error("Address %d cannot be resolved since it's an empty address", i);
-                    break;
+                    relativePathMask.unset(i);
+                    noOfFailed--;
                 }
             }
         }
 
+        logger_->debug("%d ExpandedNodeIds and %d uncached relative paths remain to be resolved",
+                       expandedNodeIdMask.setCount(), relativePathMask.setCount());
+
         return ret;
     }
 
@@ -124,12 +162,15 @@ namespace uaf
         // declare the number of addresses
         size_t noOfAddresses = addresses.size();
 
-        // log a nice message
-        logger_->debug("Resolving the following addresses:");
-        for (size_t i=0; i<noOfAddresses; i++)
+        // log a nice message (only if needed, since the requests may be huge)
+        if (logger_->isDebugEnabled())
         {
-            logger_->debug(" - Address %d", i);
-            logger_->debug(addresses[i].toString("   ", 28));
+            logger_->debug("Resolving the following addresses:");
+            for (size_t i=0; i<noOfAddresses; i++)
+            {
+                logger_->debug(" - Address %d", i);
+                logger_->debug(addresses[i].toString("   ", 28));
+            }
         }
 
         // prepare the output parameters by resizing them
@@ -171,13 +212,15 @@ namespace uaf
 
 
 
+    // Verify the ExpandedNodeIds
+    //==============================================================================================
     Status Resolver::verifyExpandedNodeIds(
             const vector<Address>&  addresses,
             const Mask&             mask,
             vector<ExpandedNodeId>& results,
             vector<Status>&         resultStatuses)
     {
-        logger_->debug("Now verifying %d ExpandedNodeIds", addresses.size());
+        logger_->debug("Now verifying %d ExpandedNodeIds", mask.setCount());
 
         Status ret(statuscodes::Good);
 
@@ -195,7 +238,6 @@ namespace uaf
                     if (   results[i].nodeId().hasNameSpaceIndex() \
                         || results[i].nodeId().hasNameSpaceUri())
                     {
-                        database_->addressCache.add(addresses[i], results[i]);
                         resultStatuses[i] = statuscodes::Good;
                     }
                     else
@@ -231,6 +273,9 @@ namespace uaf
         // declare a mask that will indicate which browse paths still need to be translated
         Mask remainingMask = mask;
 
+        // declare a mask that will indicate which browse paths were rejected by the server
+        Mask rejectedMask(addresses.size());
+
         // first try to resolve the starting addresses (all at once!)
         // the 'remainingMask', 'browsePaths' and 'statuses' will be updated!
         ret = resolveRelativePathsStartingAddresses(
@@ -242,15 +287,25 @@ namespace uaf
         // now try to resolve the relative paths (essentially browse paths since their starting
         // addresses have been resolved)
         if (ret.isGood())
-            ret = resolveBrowsePaths(browsePaths, remainingMask, results, statuses);
+            ret = resolveBrowsePaths(browsePaths, remainingMask, rejectedMask, results, statuses);
 
-        // add the resolved addresses to the cache
-        for (size_t i = 0; i < addresses.size() && ret.isGood(); i++)
+        // add the resolved addresses to the cache (all at once)
+        if (ret.isGood())
         {
-            if (mask.isSet(i) && statuses[i].isGood())
+            Mask resolvedMask(addresses.size());
+            for (size_t i = 0; i < addresses.size(); i++)
             {
-                database_->addressCache.add(addresses[i], results[i], true);
+                if (mask.isSet(i) && statuses[i].isGood())
+                    resolvedMask.set(i);
             }
+
+            database_->addressCache.add(addresses, results, resolvedMask, true);
+
+            // remember the rejected ones, so that they are not sent to the server on every request
+            double timeToLiveSec = database_->clientSettings.failedResolutionCacheTimeSec;
+            if (timeToLiveSec > 0.0 && rejectedMask.setCount() > 0)
+                database_->addressCache.addFailures(
+                        addresses, statuses, browsePaths, rejectedMask, timeToLiveSec);
         }
 
         return ret;
@@ -275,24 +330,44 @@ namespace uaf
         results.resize(noOfRelativePaths);
         statuses.resize(noOfRelativePaths);
 
-        // fill a vector containing all starting addresses
+        // fill a vector containing all unique starting addresses (many relative paths typically
+        // share the same starting address, which only needs to be resolved once), and remember
+        // the index of the starting address of each relative path
         vector<Address> startingAddresses;
-        for (size_t i = 0; i < noOfRelativePaths && ret.isGood(); i++)
+        vector<size_t>  startingAddressIndexes(noOfRelativePaths, 0);
+        map<Address, size_t> uniqueStartingAddresses;
+        for (size_t i = 0; i < noOfRelativePaths; i++)
         {
             if (mask.isSet(i))
-                startingAddresses.push_back(*(relativePathAddresses[i].getStartingAddress()));
+            {
+                const Address& startingAddress = *(relativePathAddresses[i].getStartingAddress());
+
+                std::pair<map<Address, size_t>::iterator, bool> inserted =
+                        uniqueStartingAddresses.insert(
+                                map<Address, size_t>::value_type(startingAddress,
+                                                                 startingAddresses.size()));
+                if (inserted.second)
+                    startingAddresses.push_back(startingAddress);
+
+                startingAddressIndexes[i] = inserted.first->second;
+            }
         }
 
+        logger_->debug("The %d relative paths have %d unique starting addresses",
+                       mask.setCount(), startingAddresses.size());
+
         // resolve them (recursively!)
         vector<ExpandedNodeId>  startingAddressesResults;
         vector<Status>          startingAddressesStatuses;
         ret = resolve(startingAddresses, startingAddressesResults, startingAddressesStatuses);
 
         // update the results
-        for (size_t i = 0, j = 0; i < noOfRelativePaths && ret.isGood(); i++)
+        for (size_t i = 0; i < noOfRelativePaths && ret.isGood(); i++)
         {
             if (mask.isSet(i))
             {
+                size_t j = startingAddressIndexes[i];
+
                 // update the results
                 results[i].startingExpandedNodeId = startingAddressesResults[j];
                 results[i].relativePath           = relativePathAddresses[i].getRelativePath();
@@ -303,9 +378,6 @@ namespace uaf
                 // update the mask (only resolved starting addresses should be processed further!)
                 if (statuses[i].isNotGood())
                     mask.unset(i);
-
-                // increment the index of the startingAddressesResults
-                j++;
             }
         }
 
@@ -319,6 +391,7 @@ namespace uaf
     Status Resolver::resolveBrowsePaths(
             vector<BrowsePath>&       browsePaths,
             Mask&                     mask,
+            Mask&                     rejectedMask,
             vector<ExpandedNodeId>&   results,
             vector<Status>&           statuses)
     {
@@ -345,40 +418,25 @@ namespace uaf
         }
         else
         {
-            // create a request and a result
-            TranslateBrowsePathsToNodeIdsRequest request;
-            TranslateBrowsePathsToNodeIdsResult  result;
-
-            for (size_t i = 0; i < noOfBrowsePaths; i++)
-            {
-                if (mask.isSet(i))
-                    request.targets.push_back(
-                            TranslateBrowsePathsToNodeIdsRequestTarget(browsePaths[i]));
-            }
-
-            ret = sessionFactory_->invokeRequest<TranslateBrowsePathsToNodeIdsService>(
-                    request,
-                    Mask(request.targets.size(), true),
-                    result);
+            // translate the browse paths (identical ones are only sent once, also if they are
+            // being resolved by other threads at the same time)
+            vector<TranslateBrowsePathsToNodeIdsResultTarget> resultTargets;
+            ret = translator_.translate(browsePaths, mask, resultTargets);
 
             if (ret.isGood())
             {
                 // fill the remainingBrowsePaths and remainingMask
-                for (size_t i = 0, j = 0; i < noOfBrowsePaths; i++)
+                for (size_t i = 0; i < noOfBrowsePaths; i++)
                 {
                     if (mask.isSet(i))
-                    {
                         processBrowsePathsResolutionResultTarget(
-                                result.targets[j], i, browsePaths, mask, results, statuses);
-
-                        // increment the counter for the 'set' results
-                        j++;
-                    }
+                                resultTargets[i], i, browsePaths, mask, rejectedMask, results,
+                                statuses);
                 }
 
                 // check if we need to perform another (recursive!) translation
                 if (mask.setCount() > 0)
-                    ret = resolveBrowsePaths(browsePaths, mask, results, statuses);
+                    ret = resolveBrowsePaths(browsePaths, mask, rejectedMask, results, statuses);
             }
         }
 
@@ -392,6 +450,7 @@ namespace uaf
             size_t                                              rank,
             vector<BrowsePath>&                                 browsePaths,
             Mask&                                               mask,
+            Mask&                                               rejectedMask,
             vector<ExpandedNodeId>&                             results,
             vector<Status>&                                     statuses)
     {
@@ -404,6 +463,9 @@ namespace uaf
             // we're finished with this target (unfortunately, because it failed),
             // so unset the mask item
             mask.unset(rank);
+            // if the server itself rejected the browse path, it will probably reject it again
+            if (OpcUa_IsBad(target.opcUaStatusCode))
+                rejectedMask.set(rank);
         }
         else
         {
@@ -38,6 +38,8 @@
 #include "uaf/client/sessions/sessionfactory.h"
 #include "uaf/client/database/database.h"
 #include "uaf/client/requests/requests.h"
+#include "uaf/client/resolution/resolveditems.h"
+#include "uaf/client/resolution/browsepathtranslator.h"
 
 
 namespace uaf
@@ -50,6 +52,10 @@ namespace uaf
     * The uaf::Resolver uses the TranslateBrowsePathsToNodeIds service to resolve the relative
     * addresses, and uses the uaf::AddressCache to cache the resolution results.
     *
+    * Identical starting addresses and browse paths are only resolved once (see
+    * uaf::BrowsePathTranslator), and the addresses that were rejected by the server are
+    * remembered during ClientSettings::failedResolutionCacheTimeSec.
+    *
     * @ingroup ClientResolution
     ***********************************************************************************************/
     class UAF_EXPORT Resolver
@@ -94,20 +100,23 @@ namespace uaf
          * Resolve the masked targets of the given request.
          *
          * This function is a template member function, so all types of requests can be resolved
-         * in the same generic way.
+         * in the same generic way. The request itself is not modified: the resolved items are
+         * stored in the given uaf::ResolvedItems instead.
          *
-         * @param request   Request of which the masked targets should be resolved.
-         * @param mask      The mask indicating (by mask[targetNumber] == true) which targets
-         *                  should be resolved.
-         * @param result    Result of which the masked targets will be updated.
-         * @return          Status, indicating errors on the client side (e.g. invalid formed
-         *                  addresses).
+         * @param request       Request of which the masked targets should be resolved.
+         * @param mask          The mask indicating (by mask[targetNumber] == true) which targets
+         *                      should be resolved.
+         * @param result        Result of which the masked targets will be updated.
+         * @param resolvedItems Output parameter: the resolved items of the masked targets.
+         * @return              Status, indicating errors on the client side (e.g. invalid formed
+         *                      addresses).
          */
         template<typename _Service>
         uaf::Status resolve(
-                typename _Service::Request& request,
-                const uaf::Mask&            mask,
-                typename _Service::Result&  result)
+                const typename _Service::Request&   request,
+                const uaf::Mask&                    mask,
+                typename _Service::Result&          result,
+                uaf::ResolvedItems&                 resolvedItems)
         {
             logger_->info("Resolving the request (%d targets, of which %d are masked)",
                           request.targets.size(), mask.setCount());
@@ -150,7 +159,8 @@ namespace uaf
                         itemStatuses,
                         request,
                         mask,
-                        result);
+                        result,
+                        resolvedItems);
             }
 
             // log the result
@@ -176,11 +186,19 @@ namespace uaf
 
 
         /**
-         * Resolve an address by only checking the cache.
+         * Sort the addresses, and resolve the relative paths that are cached.
+         *
+         * Addresses that are ExpandedNodeIds are fully qualified already, so they are only marked
+         * by the expandedNodeIdMask (without touching the cache). The relative paths are looked up
+         * in the cache all at once, and the ones that were not cached are marked by the
+         * relativePathMask.
          *
-         * @param address                   Address to resolve.
-         * @param resolvedExpandedNodeId    Result of the resolution.
-         * @return                          Good if the resolution went find, bad otherwise.
+         * @param addresses             Addresses to resolve.
+         * @param expandedNodeIds       Output parameter: the resolved (cached) relative paths.
+         * @param statuses              Output parameter: Good for the cached relative paths.
+         * @param expandedNodeIdMask    Output parameter: the addresses that are ExpandedNodeIds.
+         * @param relativePathMask      Output parameter: the relative paths that were not cached.
+         * @return                      Good if the addresses are not empty, bad otherwise.
          */
         uaf::Status resolveCached(
                 const std::vector<uaf::Address>&    addresses,
@@ -193,7 +211,8 @@ namespace uaf
         /**
          * Verify if the ExpandedNodeIds in a vector of Addresses can be resolved.
          *
-         * In order to be resolvable, these ExpandedNodeIds must have a server URI.
+         * In order to be resolvable, these ExpandedNodeIds must have a server URI and a namespace
+         * index or URI. They are not cached, since they don't need to be looked up.
          *
          * @param addresses         The addresses, which must be checked if indicated by the mask.
          * @param mask              The mask indicating the addresses that must be checked.
@@ -260,6 +279,8 @@ namespace uaf
          * @param browsePaths   The browse paths of which those indicated by the mask, will
          *                      be resolved.
          * @param mask          The mask that indicates the browse paths that will be resolved.
+         * @param rejectedMask  In-out parameter: the browse paths that were rejected by the
+         *                      server will be 'set' in this mask.
          * @param results       The resulting ExpandedNodeIds.
          * @param statuses      The resulting resolution statuses.
          * @return              Good if there were no errors on the client side (e.g. malformed
@@ -268,6 +289,7 @@ namespace uaf
         uaf::Status resolveBrowsePaths(
                 std::vector<uaf::BrowsePath>&       browsePaths,
                 uaf::Mask&                          mask,
+                uaf::Mask&                          rejectedMask,
                 std::vector<uaf::ExpandedNodeId>&   results,
                 std::vector<uaf::Status>&           statuses);
 
@@ -282,6 +304,8 @@ namespace uaf
          * @param mask          The mask indicating the browsepaths that still need to be resolved.
          *                      This mask will be updated: if browse paths are fully resolved,
          *                      the corresponding mask item will be 'unset' (False).
+         * @param rejectedMask  If the server rejected the browse path, the corresponding mask
+         *                      item will be 'set' (True).
          * @param results       The resulting ExpandedNodeIds.
          * @param statuses      The resulting resolution statuses.
          * @return              Good if there were no errors on the client side (e.g. malformed
@@ -292,6 +316,7 @@ namespace uaf
                 std::size_t                                            rank,
                 std::vector<uaf::BrowsePath>&                          browsePaths,
                 uaf::Mask&                                             mask,
+                uaf::Mask&                                             rejectedMask,
                 std::vector<uaf::ExpandedNodeId>&                      results,
                 std::vector<uaf::Status>&                              statuses);
 
@@ -326,25 +351,29 @@ namespace uaf
 
 
         /**
-         * Copy the resolved addresses to the request, and the resolution statuses to the
+         * Store the resolved addresses beside the request, and copy the resolution statuses to the
          * corresponding result.
          *
-         * @param expandedNodeIds   The ExpandedNodeIds that resulted from the resolution.
-         * @param statuses          The statuses that resulted from the resolution.
-         * @param request           The request of which the targets should be updated with the
-         *                          resolved addresses (i.e. the given ExpandedNodeIds).
+         * @param expandedNodeIds   The ExpandedNodeIds that resulted from the resolution (they
+         *                          are taken over by the resolvedItems, so this vector will be
+         *                          empty afterwards).
+         * @param statuses          The statuses that resulted from the resolution (same remark).
+         * @param request           The request of which the targets have been resolved.
          * @param mask              The mask indicating the targets of the request and result that
          *                          we have been resolving.
          * @param result            The result of which the targets should be updated with the
          *                          resolution statuses.
+         * @param resolvedItems     The resolved items, to be applied later on to the copies of
+         *                          the targets.
          */
         template<typename _Service>
         uaf::Status setResolvedItems(
-                const std::vector<uaf::ExpandedNodeId>& expandedNodeIds,
-                const std::vector<uaf::Status>&         statuses,
-                typename _Service::Request&             request,
-                const uaf::Mask&                        mask,
-                typename _Service::Result&              result)
+                std::vector<uaf::ExpandedNodeId>&   expandedNodeIds,
+                std::vector<uaf::Status>&           statuses,
+                const typename _Service::Request&   request,
+                const uaf::Mask&                    mask,
+                typename _Service::Result&          result,
+                uaf::ResolvedItems&                 resolvedItems)
         {
             uaf::Status ret;
 
@@ -358,7 +387,9 @@ namespace uaf
 
             if (ret.isGood())
             {
-                for (std::size_t i = 0, j = 0; i < request.targets.size() && ret.isGood(); i++)
+                resolvedItems.reset(request.targets.size());
+
+                for (std::size_t i = 0, j = 0; i < request.targets.size(); i++)
                 {
                     if (mask.isSet(i))
                     {
@@ -367,33 +398,23 @@ namespace uaf
 
                         if (noOfItems > 0)
                         {
-                            // create ExpandedNodeId and Status vectors for the current target
-                            std::vector<uaf::ExpandedNodeId> targetExpandedNodeIds(
-                                    expandedNodeIds.begin() + j     * noOfItems,
-                                    expandedNodeIds.begin() + (j+1) * noOfItems);
-                            std::vector<uaf::Status> targetStatuses(
-                                    statuses.begin() + j     * noOfItems,
-                                    statuses.begin() + (j+1) * noOfItems);
-
-                            // set the newly created vectors
-                            ret = request.targets[i].setResolvedItems(
-                                    targetExpandedNodeIds,
-                                    targetStatuses);
+                            // the items of this target are [j, j + noOfItems[
+                            resolvedItems.setResolved(i, j, j + noOfItems);
 
                             // in case of just one item per target, set the status of the first
                             // item as "resolution status"
                             if (noOfItems == 1)
                             {
-                                result.targets[i].status = targetStatuses[0];
+                                result.targets[i].status = statuses[j];
                             }
                             // in case of multiple items per target, make a summary
                             else
                             {
                                 std::vector<uint32_t> unresolvedTargetNumbers;
                                 std::stringstream unresolvedStringStream;
-                                for (uint32_t k = 0; k < targetStatuses.size(); k++)
+                                for (uint32_t k = 0; k < noOfItems; k++)
                                 {
-                                    if (targetStatuses[k].isNotGood())
+                                    if (statuses[j + k].isNotGood())
                                         unresolvedTargetNumbers.push_back(k);
                                 }
 
@@ -403,14 +424,15 @@ namespace uaf
                                     result.targets[i].status = \
                                         uaf::NotAllTargetsCouldBeResolvedError(unresolvedTargetNumbers);
                             }
-                        }
 
-                        // go to the next 'set' item
-                        j++;
+                            // go to the items of the next 'set' target
+                            j += noOfItems;
+                        }
                     }
                 }
 
-                ret = uaf::statuscodes::Good;
+                // store the items beside the request (without copying them)
+                resolvedItems.takeOver(expandedNodeIds, statuses);
             }
 
             return ret;
@@ -423,6 +445,8 @@ namespace uaf
         uaf::SessionFactory* sessionFactory_; // not owned!
         // pointer to the shared database
         uaf::Database* database_; // not owned!
+        // the translator of the browse paths (shared by all threads that resolve addresses)
+        uaf::BrowsePathTranslator translator_;
 
     };
 
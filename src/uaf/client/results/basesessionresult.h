@@ -34,6 +34,7 @@
 #include "uaf/client/clientexport.h"
 #include "uaf/util/handles.h"
 #include "uaf/client/results/basesessionresulttarget.h"
+#include "uaf/client/results/requesttrace.h"
 
 namespace uaf
 {
@@ -94,6 +95,10 @@ namespace uaf
         /** The targets. */
         typename std::vector<_Target> targets;
 
+        /** The time spent in each stage of the processing of the request, if the request was
+         *  traced (see uaf::ClientSettings::traceRequests). */
+        uaf::RequestTrace trace;
+
 
         /**
          * Get a string representation of the target.
@@ -247,6 +252,13 @@ namespace uaf
             }
         }
 
+        if (!trace.spans.empty())
+        {
+            ss << "\n" << indent << " - trace";
+            ss << uaf::fillToPos(ss, colon);
+            ss << ": " << trace.toCompactString();
+        }
+
         return ss.str();
     }
 
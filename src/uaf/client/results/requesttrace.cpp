@@ -0,0 +1,148 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/results/requesttrace.h"
+
+// STD
+#include <iomanip>
+#include <utility>
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::pair;
+
+
+    // Constructor
+    // =============================================================================================
+    RequestTrace::RequestTrace()
+    : requestHandle(uaf::constants::REQUESTHANDLE_NOT_ASSIGNED),
+      threadId(0),
+      enabled_(false)
+    {}
+
+
+    // Enable the trace
+    // =============================================================================================
+    void RequestTrace::enable(
+            const string&   service,
+            RequestHandle   requestHandle,
+            uint64_t        threadId)
+    {
+        this->service       = service;
+        this->requestHandle = requestHandle;
+        this->threadId      = threadId;
+        enabled_            = true;
+    }
+
+
+    // Add a span
+    // =============================================================================================
+    void RequestTrace::addSpan(
+            const char*     stage,
+            const string&   serverUri,
+            uint64_t        startTimeNs,
+            uint64_t        endTimeNs)
+    {
+        uint64_t durationNs = endTimeNs > startTimeNs ? endTimeNs - startTimeNs : 0;
+        spans.push_back(TraceSpan(stage, serverUri, startTimeNs, durationNs));
+    }
+
+
+    // Get the total time spent in a stage
+    // =============================================================================================
+    double RequestTrace::durationSec(const string& stage) const
+    {
+        uint64_t durationNs = 0;
+        for (vector<TraceSpan>::const_iterator it = spans.begin(); it != spans.end(); ++it)
+        {
+            if (it->stage == stage)
+                durationNs += it->durationNs;
+        }
+        return double(durationNs) / 1e9;
+    }
+
+
+    // Get a compact timing breakdown
+    // =============================================================================================
+    string RequestTrace::toCompactString() const
+    {
+        // sum the durations per stage, in the order in which the stages first ended
+        // (there are only a handful of stages, so a linear search is fine)
+        vector< pair<string, uint64_t> > totals;
+        for (vector<TraceSpan>::const_iterator it = spans.begin(); it != spans.end(); ++it)
+        {
+            size_t i = 0;
+            while (i < totals.size() && totals[i].first != it->stage)
+                i++;
+
+            if (i == totals.size())
+                totals.push_back(pair<string, uint64_t>(it->stage, 0));
+
+            totals[i].second += it->durationNs;
+        }
+
+        stringstream ss;
+        ss << std::fixed << std::setprecision(3);
+        for (size_t i = 0; i < totals.size(); i++)
+        {
+            if (i > 0)
+                ss << " ";
+            ss << totals[i].first << "=" << double(totals[i].second) / 1e6 << "ms";
+        }
+        return ss.str();
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string RequestTrace::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - service";
+        ss << fillToPos(ss, colon);
+        ss << ": " << service << "\n";
+
+        ss << indent << " - requestHandle";
+        ss << fillToPos(ss, colon);
+        ss << ": " << requestHandle << "\n";
+
+        ss << indent << " - threadId";
+        ss << fillToPos(ss, colon);
+        ss << ": " << threadId << "\n";
+
+        ss << indent << " - spans[]";
+        for (std::size_t i = 0; i < spans.size(); i++)
+        {
+            ss << "\n";
+            ss << indent << "    - spans[" << i << "]\n";
+            ss << spans[i].toString(indent + "      ", colon);
+        }
+
+        return ss.str();
+    }
+
+}
@@ -0,0 +1,165 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_REQUESTTRACE_H_
+#define UAF_REQUESTTRACE_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/handles.h"
+#include "uaf/util/constants.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/results/tracespan.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::RequestTrace holds the time spent in each stage of the processing of a request, if
+    * the request was traced (see uaf::ClientSettings::traceRequests).
+    *
+    * The stages are:
+    *  - "processRequest": the whole processing of the request by the client
+    *  - "resolve": the resolution of the addresses of the targets
+    *  - "invokeRequest": the building and invocation of the invocations (one per session)
+    *  - "acquireSession": the acquisition of a session (including "sessionLock" and "connect")
+    *  - "sessionLock": the time waiting for the lock of the sessions
+    *  - "connect": the connection of a new session
+    *  - "invokeService": the invocation of the service by a session (including "toSdk",
+    *    "sdkCall" and "fromSdk")
+    *  - "toSdk": the conversion of the request targets to the SDK
+    *  - "sdkCall": the call of the SDK (for a synchronous service: the round trip to the server)
+    *  - "fromSdk": the conversion of the SDK results to the result targets
+    *  - "copyToResult": the copying of the result targets of an invocation to the result
+    *
+    * Stages that are repeated (e.g. one "invokeService" per session) have a span for each
+    * repetition.
+    *
+    * @ingroup ClientResults
+    ***********************************************************************************************/
+    class UAF_EXPORT RequestTrace
+    {
+    public:
+
+
+        /**
+         * Create an empty (and disabled) trace.
+         */
+        RequestTrace();
+
+
+        /** The name of the service (e.g. "Read"). */
+        std::string service;
+
+        /** The handle of the traced request. */
+        uaf::RequestHandle requestHandle;
+
+        /** The id of the thread that processed the request. */
+        uint64_t threadId;
+
+        /** The spans, in the order in which they ended. */
+        std::vector<uaf::TraceSpan> spans;
+
+
+        /**
+         * Enable the trace, so that the stages of the request are added to it.
+         *
+         * @param service       The name of the service.
+         * @param requestHandle The handle of the request.
+         * @param threadId      The id of the thread that processes the request.
+         */
+        void enable(
+                const std::string&  service,
+                uaf::RequestHandle  requestHandle,
+                uint64_t            threadId);
+
+
+        /**
+         * Is the trace enabled?
+         *
+         * @return  True if the stages of the request are added to the trace.
+         */
+        bool isEnabled() const { return enabled_; }
+
+
+        /**
+         * Add a span to the trace.
+         *
+         * @param stage         The name of the stage.
+         * @param serverUri     The URI of the server that is involved in the stage (if any).
+         * @param startTimeNs   The start time (see uaf::MetricsRegistry::now()).
+         * @param endTimeNs     The end time.
+         */
+        void addSpan(
+                const char*         stage,
+                const std::string&  serverUri,
+                uint64_t            startTimeNs,
+                uint64_t            endTimeNs);
+
+
+        /**
+         * Get the total time spent in a stage (summed over all its spans).
+         *
+         * @param stage The name of the stage.
+         * @return      The time in seconds.
+         */
+        double durationSec(const std::string& stage) const;
+
+
+        /**
+         * Get a compact timing breakdown on a single line, with the total time (in milliseconds)
+         * per stage, e.g. "resolve=0.210ms sdkCall=800.312ms ... processRequest=801.004ms".
+         *
+         * @return  The breakdown, or an empty string if there are no spans.
+         */
+        std::string toCompactString() const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=26) const;
+
+
+    private:
+
+        // true if the stages must be added
+        bool enabled_;
+
+    };
+
+}
+
+
+
+#endif /* UAF_REQUESTTRACE_H_ */
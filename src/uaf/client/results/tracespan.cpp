@@ -0,0 +1,79 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/results/tracespan.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+
+
+    // Constructor
+    // =============================================================================================
+    TraceSpan::TraceSpan()
+    : startTimeNs(0),
+      durationNs(0)
+    {}
+
+
+    // Constructor
+    // =============================================================================================
+    TraceSpan::TraceSpan(
+            const string&   stage,
+            const string&   serverUri,
+            uint64_t        startTimeNs,
+            uint64_t        durationNs)
+    : stage(stage),
+      serverUri(serverUri),
+      startTimeNs(startTimeNs),
+      durationNs(durationNs)
+    {}
+
+
+    // Get a string representation
+    // =============================================================================================
+    string TraceSpan::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - stage";
+        ss << fillToPos(ss, colon);
+        ss << ": " << stage << "\n";
+
+        ss << indent << " - serverUri";
+        ss << fillToPos(ss, colon);
+        ss << ": " << serverUri << "\n";
+
+        ss << indent << " - startTimeNs";
+        ss << fillToPos(ss, colon);
+        ss << ": " << startTimeNs << "\n";
+
+        ss << indent << " - durationNs";
+        ss << fillToPos(ss, colon);
+        ss << ": " << durationNs;
+
+        return ss.str();
+    }
+
+}
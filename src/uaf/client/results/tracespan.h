@@ -0,0 +1,109 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_TRACESPAN_H_
+#define UAF_TRACESPAN_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::TraceSpan is the time spent in one stage of the processing of a request (such as
+    * "resolve", "acquireSession" or "sdkCall"), as part of a uaf::RequestTrace.
+    *
+    * @ingroup ClientResults
+    ***********************************************************************************************/
+    class UAF_EXPORT TraceSpan
+    {
+    public:
+
+
+        /**
+         * Create an empty span.
+         */
+        TraceSpan();
+
+
+        /**
+         * Create a span.
+         *
+         * @param stage         The name of the stage.
+         * @param serverUri     The URI of the server that is involved in the stage (if any).
+         * @param startTimeNs   The start time (see uaf::MetricsRegistry::now()).
+         * @param durationNs    The duration.
+         */
+        TraceSpan(
+                const std::string&  stage,
+                const std::string&  serverUri,
+                uint64_t            startTimeNs,
+                uint64_t            durationNs);
+
+
+        /** The name of the stage. */
+        std::string stage;
+
+        /** The URI of the server that is involved in the stage, or an empty string if the stage
+         *  does not involve a particular server (e.g. "resolve"). */
+        std::string serverUri;
+
+        /** The time at which the stage started, in nanoseconds of a monotonic clock (so only the
+         *  differences between the start times of spans are meaningful). */
+        uint64_t startTimeNs;
+
+        /** The duration of the stage, in nanoseconds. */
+        uint64_t durationNs;
+
+
+        /**
+         * Get the duration of the stage in seconds.
+         *
+         * @return  The duration in seconds.
+         */
+        double durationSec() const { return double(durationNs) / 1e9; }
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=20) const;
+
+    };
+
+}
+
+
+
+#endif /* UAF_TRACESPAN_H_ */
@@ -40,7 +40,8 @@ namespace uaf
             UaClientSdk::UaSessionCallback* uaSessionCallback,
             ClientInterface*                clientInterface,
             Discoverer*                     discoverer,
-            Database*                       database)
+            Database*                       database,
+            SessionTransportFactory*        transportFactory)
     : uaSessionCallback_(uaSessionCallback),
       sessionState_(uaf::sessionstates::Disconnected),
       lastConnectionAttemptStep_(connectionsteps::NoAttemptYet),
@@ -56,8 +57,11 @@ namespace uaf
         loggerName << "Session-" << clientConnectionId;
         logger_ = new Logger(loggerFactory, loggerName.str());
 
-        // create a UaSession
-        uaSession_ = new UaClientSdk::UaSession();
+        // create the session transport (an SDK session, unless another transport is used)
+        if (transportFactory != 0)
+            uaSession_ = transportFactory->createSessionTransport();
+        else
+            uaSession_ = new SdkSessionTransport();
 
         // create a subscription factory
         subscriptionFactory_ = new SubscriptionFactory(
@@ -88,7 +92,7 @@ namespace uaf
         delete subscriptionFactory_;
         subscriptionFactory_ = 0;
 
-        // delete the UaSession
+        // delete the session transport
         delete uaSession_;
         uaSession_ = 0;
 
@@ -126,105 +130,45 @@ namespace uaf
     }
 
 
-    // Initialize the PKI store
+    // Does the session need a client certificate?
     // =============================================================================================
-    Status Session::initializePkiStore(UaClientSdk::SessionSecurityInfo& uaSecurity)
+    bool Session::needsClientCertificate() const
     {
-        Status ret;
-        logger_->debug("Initializing the PKI store");
-
-        string certificateRevocationListLocation = \
-                database_->clientSettings.certificateRevocationListLocation;
-        string certificateTrustListLocation = \
-                database_->clientSettings.certificateTrustListLocation;
-        string issuersRevocationListLocation = \
-                database_->clientSettings.issuersRevocationListLocation;
-        string issuersCertificatesLocation = \
-                database_->clientSettings.issuersCertificatesLocation;
-
-        bool checkOnly = !(database_->clientSettings.createSecurityLocationsIfNeeded);
-
-        ret = checkOrCreatePath(
-                checkOnly,
-                certificateRevocationListLocation,
-                "certificate revocation list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    certificateTrustListLocation,
-                    "certificate trust list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    issuersRevocationListLocation,
-                    "issuers revocation trust list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    issuersCertificatesLocation,
-                    "issuers certificates location");
-
-        if (ret.isGood())
-        {
-            logger_->debug("Now initializing the OpenSSL PKI store via the SDK");
-            SdkStatus sdkStatus = uaSecurity.initializePkiProviderOpenSSL(
-                    UaString(certificateRevocationListLocation.c_str()),
-                    UaString(certificateTrustListLocation.c_str()),
-                    UaString(issuersRevocationListLocation.c_str()),
-                    UaString(issuersCertificatesLocation.c_str()));
-
-            if (sdkStatus.isGood())
-                logger_->debug("The OpenSSL PKI store was initialized successfully");
-            else
-                ret = OpenSSLStoreInitializationError(sdkStatus);
-        }
-
-        if (ret.isGood())
-            logger_->debug("The PKI store has been initialized");
-        else
-            logger_->error(ret.toString());
+        messagesecuritymodes::MessageSecurityMode mode
+                = sessionSettings_.securitySettings.messageSecurityMode;
 
-        return ret;
+        return (   mode == messagesecuritymodes::Mode_Sign
+                || mode == messagesecuritymodes::Mode_SignAndEncrypt);
     }
 
 
-    // Load the client certificate from a file
+    // Initialize the PKI store
     // =============================================================================================
-    Status Session::loadClientCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity)
+    Status Session::initializePkiStore(
+            UaClientSdk::SessionSecurityInfo&   uaSecurity,
+            bool                                withClientCertificate)
     {
-        logger_->debug("Loading the client certificate and private key");
-
-        string clientCertificate = database_->clientSettings.clientCertificate;
-        string clientPrivateKey = database_->clientSettings.clientPrivateKey;
-
-        const bool checkOnly = true;
+        logger_->debug("Initializing the PKI store");
 
-        Status ret = checkOrCreatePath(checkOnly, clientCertificate, "client certificate");
+        if (!withClientCertificate)
+            logger_->debug("Security is not needed so we don't need to load the client certificate");
 
-        if (ret.isGood())
-            ret = checkOrCreatePath(checkOnly, clientPrivateKey, "client private key");
+        // the PKI store is shared by all sessions, and only loaded again if its files have changed
+        SharedConst<PkiStore> store;
+        Status ret = database_->pkiStoreCache.acquire(
+                database_->clientSettings,
+                withClientCertificate,
+                store);
 
         if (ret.isGood())
         {
-            logger_->debug("Now loading the client certificate via the SDK");
-            SdkStatus sdkStatus = uaSecurity.loadClientCertificateOpenSSL(
-                    UaString(clientCertificate.c_str()),
-                    UaString(clientPrivateKey.c_str()));
-
-            if (sdkStatus.isGood())
-                logger_->debug("The client certificate was loaded successfully (%s)",
-                               sdkStatus.toString().c_str());
-            else
-                ret = ClientCertificateLoadingError(sdkStatus);
+            uaSecurity = store->uaSecurity;
+            logger_->debug("The PKI store has been initialized");
         }
-
-        if (ret.isGood())
-            logger_->debug("The client certificate and private key are loaded");
         else
+        {
             logger_->error(ret.toString());
+        }
 
         return ret;
     }
@@ -401,6 +345,9 @@ namespace uaf
                 {
                     logger_->debug("Certificate %s was stored", uaThumbprint.toUtf8());
                     ret = statuscodes::Good;
+
+                    // the shared PKI store must be reloaded to trust the new certificate
+                    database_->pkiStoreCache.clear();
                 }
                 else
                 {
@@ -469,28 +416,22 @@ namespace uaf
             logger_->debug(suitableEndpoint.toString());
         }
 
-        // initialize the PKI store so that we can verify the server certificate
-        if (ret.isGood())
-            ret = initializePkiStore(uaSecurity);
+        // a server in the same process has no certificate to verify
+        bool isInProcess = uaSession_->isInProcess();
+
+        // initialize the PKI store so that we can verify the server certificate (the client
+        // certificate is only loaded if we need to sign or encrypt the data!)
+        if (ret.isGood() && !isInProcess)
+            ret = initializePkiStore(uaSecurity, needsClientCertificate());
 
         // load the server certificate from the endpoint description
-        if (ret.isGood())
+        if (ret.isGood() && !isInProcess)
             ret = loadServerCertificateFromEndpoint(uaSecurity, suitableEndpoint);
 
-        // always verify the server certificate
-        if (ret.isGood())
+        // always verify the server certificate (of a server in another process)
+        if (ret.isGood() && !isInProcess)
             ret = verifyServerCertificate(uaSecurity);
 
-        // only load the client certificate if we need to sign or encrypt the data!
-        if (ret.isGood())
-        {
-            if (   sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_Sign
-                || sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_SignAndEncrypt)
-                ret = loadClientCertificate(uaSecurity);
-            else
-                logger_->debug("Security is not needed so we don't need to initialize the PKI store");
-        }
-
         // try to set the user identity, security policy and message security mode
         if (ret.isGood())
         {
@@ -523,6 +464,9 @@ namespace uaf
             }
         }
 
+        // count the connection attempt in the metrics
+        database_->metrics.connectionAttempted(serverUri_, ret.isGood());
+
         // log the result
         if (ret.isGood())
             logger_->debug("The connection was finished (%s)", ret.toString().c_str());
@@ -565,28 +509,22 @@ namespace uaf
 
         // ============
 
-        // initialize the PKI store so that we can verify the server certificate
-        if (ret.isGood())
-            ret = initializePkiStore(uaSecurity);
+        // a server in the same process has no certificate to verify
+        bool isInProcess = uaSession_->isInProcess();
+
+        // initialize the PKI store so that we can verify the server certificate (the client
+        // certificate is only loaded if we need to sign or encrypt the data!)
+        if (ret.isGood() && !isInProcess)
+            ret = initializePkiStore(uaSecurity, needsClientCertificate());
 
         // load the server certificate
-        if (ret.isGood())
+        if (ret.isGood() && !isInProcess)
             serverCertificate.toDER().toSdk(uaSecurity.serverCertificate);
 
-        // always verify the server certificate
-        if (ret.isGood())
+        // always verify the server certificate (of a server in another process)
+        if (ret.isGood() && !isInProcess)
             ret = verifyServerCertificate(uaSecurity);
 
-        // only load the client certificate if we need to sign or encrypt the data!
-        if (ret.isGood())
-        {
-            if (   sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_Sign
-                || sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_SignAndEncrypt)
-                ret = loadClientCertificate(uaSecurity);
-            else
-                logger_->debug("Security is not needed so we don't need to initialize the PKI store");
-        }
-
         // try to set the user identity, security policy and message security mode
         if (ret.isGood())
         {
@@ -621,6 +559,9 @@ namespace uaf
             }
         }
 
+        // count the connection attempt in the metrics
+        database_->metrics.connectionAttempted(serverUri_, ret.isGood());
+
         ret = connectionAttemptStatus;
 
         // log the result
@@ -648,6 +589,22 @@ namespace uaf
             logger_->debug("Now disconnecting %s and thereby deleting all subscriptions",
                            toString().c_str());
 
+            // release the registered nodes at the server side (they will be registered again
+            // if the session is reconnected)
+            registeredNodesMutex_.lock();
+            if (!registeredNodes_.empty())
+            {
+                vector<NodeId> aliases;
+                for (RegisteredNodeMap::const_iterator it = registeredNodes_.begin();
+                     it != registeredNodes_.end();
+                     ++it)
+                    aliases.push_back(it->second.alias);
+
+                invokeUnregisterNodes(aliases, registerNodesSettings_);
+                resetRegisteredNodeIds();
+            }
+            registeredNodesMutex_.unlock();
+
             // try to disconnect (and delete subscriptions)
             UaClientSdk::ServiceSettings serviceSettings;
             UaStatus uaStatus = uaSession_->disconnect(serviceSettings, OpcUa_True);
@@ -910,19 +867,54 @@ namespace uaf
                 uaf::sessionstates::toString(sessionState_).c_str(),
                 uaf::sessionstates::toString(sessionState).c_str());
 
+        // count the lost and restored connections in the metrics
+        bool wasConnected =
+                   sessionState_ == uaf::sessionstates::Connected
+                || sessionState_ == uaf::sessionstates::ConnectionWarningWatchdogTimeout;
+        bool wasReconnecting =
+                   sessionState_ == uaf::sessionstates::ConnectionErrorApiReconnect
+                || sessionState_ == uaf::sessionstates::ServerShutdown
+                || sessionState_ == uaf::sessionstates::NewSessionCreated;
+
+        if (   wasConnected
+            && (   sessionState == uaf::sessionstates::ConnectionErrorApiReconnect
+                || sessionState == uaf::sessionstates::ServerShutdown))
+            database_->metrics.connectionLost(serverUri_);
+        else if (wasReconnecting && sessionState == uaf::sessionstates::Connected)
+            database_->metrics.reconnected(serverUri_);
+
         // update the session state member
         sessionState_ = sessionState;
 
-        // if the session became connected, update the arrays
+        // if the session became connected, update the arrays and renew the registered nodes
         if (sessionState == uaf::sessionstates::Connected)
-            updateArrays();
+        {
+            // if the NamespaceArray differs from the one that was seen before (e.g. the one of
+            // a warm-start snapshot), the cached addresses and definitions can't be trusted
+            if (   updateArrays().isGood()
+                && !database_->updateNamespaceArray(serverUri_, namespaceArray_.nameSpaceMap()))
+            {
+                logger_->warning("The NamespaceArray of %s has changed, so its cached addresses "
+                                 "and structure definitions are discarded", serverUri_.c_str());
+                database_->addressCache.clear(serverUri_);
+                database_->structureDefinitionCache.clear(serverUri_);
+            }
+            reregisterNodes();
+        }
         // if the session has difficulties, we remove all references to this serverUri from
         // the address resolution cache (because maybe the node resolution is not valid anymore)
+        // and from the structure definition cache (because the server may have been updated)
         else if (   (sessionState == uaf::sessionstates::ConnectionErrorApiReconnect)
                  || (sessionState == uaf::sessionstates::ConnectionWarningWatchdogTimeout)
                  || (sessionState == uaf::sessionstates::Disconnected)
                  || (sessionState == uaf::sessionstates::ServerShutdown))
+        {
             database_->addressCache.clear(serverUri_);
+            database_->structureDefinitionCache.clear(serverUri_);
+
+            UaMutexLocker registeredNodesLocker(&registeredNodesMutex_);
+            resetRegisteredNodeIds();
+        }
 
         // call the callback interface
         clientInterface_->connectionStatusChanged(sessionInformation());
@@ -971,6 +963,35 @@ namespace uaf
     }
 
 
+    // Delete the monitored items.
+    // =============================================================================================
+    Status Session::deleteMonitoredItemsIfNeeded(
+            const vector<ClientHandle>& clientHandles,
+            const ServiceSettings*      serviceSettings,
+            vector<Status>&             results)
+    {
+        return subscriptionFactory_->deleteMonitoredItemsIfNeeded(clientHandles,
+                                                                  serviceSettings,
+                                                                  results);
+    }
+
+
+    // Modify the monitored items.
+    // =============================================================================================
+    Status Session::modifyMonitoredItemsIfNeeded(
+            const vector<ClientHandle>&     clientHandles,
+            const MonitoredItemSettings&    settings,
+            const ServiceSettings*          serviceSettings,
+            vector<Status>&                 results)
+    {
+        return subscriptionFactory_->modifyMonitoredItemsIfNeeded(clientHandles,
+                                                                  settings,
+                                                                  serviceSettings,
+                                                                  namespaceArray_,
+                                                                  results);
+    }
+
+
     // Get a structure definition
     // =============================================================================================
     Status Session::structureDefinition(
@@ -997,43 +1018,229 @@ namespace uaf
     }
 
 
-    // Set the publishing mode.
+    // Register nodes
     // =============================================================================================
-    Status Session::checkOrCreatePath(
-            bool checkOnly, const string& path, const string& description) const
+    Status Session::registerNodes(
+            const vector<NodeId>&   nodeIds,
+            const ServiceSettings&  serviceSettings)
     {
         Status ret;
 
-        logger_->debug("Checking %s: %s", description.c_str(), path.c_str());
-        UaDir helperDir(UaUniString(""));
-        if (helperDir.exists(UaUniString(path.c_str())))
+        UaMutexLocker locker(&registeredNodesMutex_); // unlocks when locker goes out of scope
+
+        registerNodesSettings_ = serviceSettings;
+
+        // only the nodes that are not registered yet must be registered at the server
+        vector<NodeId> newNodeIds;
+        for (vector<NodeId>::const_iterator it = nodeIds.begin(); it != nodeIds.end(); ++it)
         {
+            RegisteredNode& registeredNode = registeredNodes_[*it];
+            if (registeredNode.registrations == 0)
+            {
+                registeredNode.alias = *it;
+                newNodeIds.push_back(*it);
+            }
+            registeredNode.registrations++;
+        }
+
+        logger_->debug("Registering %d nodes, of which %d are new",
+                       nodeIds.size(), newNodeIds.size());
+
+        // if the session is not connected, the nodes will be registered as soon as it is
+        if (newNodeIds.empty() || !isConnected())
             ret = statuscodes::Good;
-            logger_->debug("OK, the %s exists", description.c_str());
+        else
+            ret = invokeRegisterNodes(newNodeIds, serviceSettings);
+
+        // undo the registrations if they failed
+        if (ret.isBad())
+        {
+            for (vector<NodeId>::const_iterator it = nodeIds.begin(); it != nodeIds.end(); ++it)
+            {
+                RegisteredNodeMap::iterator iter = registeredNodes_.find(*it);
+                if (iter != registeredNodes_.end() && --iter->second.registrations == 0)
+                    registeredNodes_.erase(iter);
+            }
         }
+
+        return ret;
+    }
+
+
+    // Unregister nodes
+    // =============================================================================================
+    Status Session::unregisterNodes(
+            const vector<NodeId>&   nodeIds,
+            const ServiceSettings&  serviceSettings)
+    {
+        Status ret;
+
+        UaMutexLocker locker(&registeredNodesMutex_); // unlocks when locker goes out of scope
+
+        // only the nodes that are not registered anymore must be unregistered at the server
+        vector<NodeId> obsoleteAliases;
+        for (vector<NodeId>::const_iterator it = nodeIds.begin(); it != nodeIds.end(); ++it)
+        {
+            RegisteredNodeMap::iterator iter = registeredNodes_.find(*it);
+            if (iter != registeredNodes_.end() && --iter->second.registrations == 0)
+            {
+                obsoleteAliases.push_back(iter->second.alias);
+                registeredNodes_.erase(iter);
+            }
+        }
+
+        logger_->debug("Unregistering %d nodes, of which %d are not registered anymore",
+                       nodeIds.size(), obsoleteAliases.size());
+
+        // if the session is not connected, the server has already forgotten the nodes
+        if (obsoleteAliases.empty() || !isConnected())
+            ret = statuscodes::Good;
         else
+            ret = invokeUnregisterNodes(obsoleteAliases, serviceSettings);
+
+        return ret;
+    }
+
+
+    // Get the aliases of registered nodes
+    // =============================================================================================
+    void Session::registeredNodeIds(
+            const vector<NodeId>&   nodeIds,
+            vector<NodeId>&         aliases)
+    {
+        UaMutexLocker locker(&registeredNodesMutex_); // unlocks when locker goes out of scope
+
+        aliases.resize(nodeIds.size());
+
+        for (size_t i = 0; i < nodeIds.size(); i++)
+        {
+            RegisteredNodeMap::const_iterator iter = registeredNodes_.find(nodeIds[i]);
+            if (iter != registeredNodes_.end())
+                aliases[i] = iter->second.alias;
+            else
+                aliases[i] = nodeIds[i];
+        }
+    }
+
+
+    // Invoke the RegisterNodes service
+    // =============================================================================================
+    Status Session::invokeRegisterNodes(
+            const vector<NodeId>&   nodeIds,
+            const ServiceSettings&  serviceSettings)
+    {
+        Status ret;
+
+        UaClientSdk::ServiceSettings    uaServiceSettings;
+        UaNodeIdArray                   uaNodesToRegister;
+        UaNodeIdArray                   uaRegisteredNodeIds;
+
+        serviceSettings.toSdk(uaServiceSettings);
+
+        uaNodesToRegister.create(nodeIds.size());
+
+        ret = statuscodes::Good;
+        for (size_t i = 0; i < nodeIds.size() && ret.isGood(); i++)
+            ret = namespaceArray_.fillOpcUaNodeId(nodeIds[i], uaNodesToRegister[i]);
+
+        if (ret.isGood())
         {
-            if (checkOnly)
+            SdkStatus sdkStatus = uaSession_->registerNodes(uaServiceSettings,
+                                                            uaNodesToRegister,
+                                                            uaRegisteredNodeIds);
+
+            if (sdkStatus.isBad())
             {
-                ret = PathNotExistsError(path, description);
-                logger_->error(ret.toString());
+                ret = RegisterNodesInvocationError(sdkStatus);
+            }
+            else if (uaRegisteredNodeIds.length() != nodeIds.size())
+            {
+                ret = UnexpectedError("The server returned a wrong number of registered NodeIds");
             }
             else
             {
-                logger_->debug("The path does not exist so we try to create it");
-                if (helperDir.mkpath(UaUniString(path.c_str())))
-                {
-                    ret = statuscodes::Good;
-                    logger_->debug("The %s has been created", path.c_str());
-                }
-                else
+                for (size_t i = 0; i < nodeIds.size(); i++)
                 {
-                    ret = PathCreationError(path, description);
-                    logger_->error(ret.toString());
+                    // if the alias cannot be interpreted, the original NodeId remains in use
+                    NodeId alias;
+                    if (namespaceArray_.fillNodeId(uaRegisteredNodeIds[i], alias).isGood())
+                        registeredNodes_[nodeIds[i]].alias = alias;
                 }
             }
         }
 
+        if (ret.isBad())
+            logger_->error(ret);
+
+        return ret;
+    }
+
+
+    // Invoke the UnregisterNodes service
+    // =============================================================================================
+    Status Session::invokeUnregisterNodes(
+            const vector<NodeId>&   nodeIds,
+            const ServiceSettings&  serviceSettings)
+    {
+        Status ret;
+
+        UaClientSdk::ServiceSettings    uaServiceSettings;
+        UaNodeIdArray                   uaNodesToUnregister;
+
+        serviceSettings.toSdk(uaServiceSettings);
+
+        uaNodesToUnregister.create(nodeIds.size());
+
+        ret = statuscodes::Good;
+        for (size_t i = 0; i < nodeIds.size() && ret.isGood(); i++)
+            ret = namespaceArray_.fillOpcUaNodeId(nodeIds[i], uaNodesToUnregister[i]);
+
+        if (ret.isGood())
+        {
+            SdkStatus sdkStatus = uaSession_->unregisterNodes(uaServiceSettings,
+                                                              uaNodesToUnregister);
+
+            if (sdkStatus.isBad())
+                ret = UnregisterNodesInvocationError(sdkStatus);
+        }
+
+        if (ret.isBad())
+            logger_->error(ret);
+
         return ret;
     }
+
+
+    // Register all registered nodes again
+    // =============================================================================================
+    void Session::reregisterNodes()
+    {
+        UaMutexLocker locker(&registeredNodesMutex_); // unlocks when locker goes out of scope
+
+        if (!registeredNodes_.empty())
+        {
+            vector<NodeId> nodeIds;
+            for (RegisteredNodeMap::const_iterator it = registeredNodes_.begin();
+                 it != registeredNodes_.end();
+                 ++it)
+                nodeIds.push_back(it->first);
+
+            logger_->debug("Registering %d nodes again", nodeIds.size());
+
+            // if this fails, the original NodeIds will simply be used instead of the aliases
+            if (invokeRegisterNodes(nodeIds, registerNodesSettings_).isBad())
+                resetRegisteredNodeIds();
+        }
+    }
+
+
+    // Reset the aliases of the registered nodes
+    // =============================================================================================
+    void Session::resetRegisteredNodeIds()
+    {
+        for (RegisteredNodeMap::iterator it = registeredNodes_.begin();
+             it != registeredNodes_.end();
+             ++it)
+            it->second.alias = it->first;
+    }
 }
@@ -25,6 +25,8 @@
 // STD
 #include <string>
 #include <sstream>
+#include <map>
+#include <vector>
 // SDK
 #include "uaclient/uaclientsdk.h"
 #include "uaclient/uasession.h"
@@ -48,6 +50,9 @@
 #include "uaf/client/subscriptions/subscriptionfactory.h"
 #include "uaf/client/discovery/discoverer.h"
 #include "uaf/client/clientservices.h"
+#include "uaf/client/invocations/invocationpool.h"
+#include "uaf/client/transport/sessiontransportfactory.h"
+#include "uaf/client/transport/sdksessiontransport.h"
 
 
 
@@ -79,6 +84,8 @@ namespace uaf
          *                           communication is received.
          * @param discoverer         The discoverer of the client.
          * @param database           Pointer to the client database.
+         * @param transportFactory   The factory of the session transport, or NULL to invoke
+         *                           the services of a real server through the SDK.
          */
         Session(
                 uaf::LoggerFactory*             loggerFactory,
@@ -88,7 +95,8 @@ namespace uaf
                 UaClientSdk::UaSessionCallback* uaSessionCallback,
                 uaf::ClientInterface*          clientInterface,
                 uaf::Discoverer*               discoverer,
-                uaf::Database*                 database);
+                uaf::Database*                 database,
+                uaf::SessionTransportFactory*  transportFactory = 0);
 
 
         /**
@@ -159,7 +167,7 @@ namespace uaf
         /**
          * Get the server URI of the session.
          */
-        std::string serverUri()                             const { return serverUri_; };
+        const std::string& serverUri()                      const { return serverUri_; };
 
         /**
          * Get the settings of the session.
@@ -270,6 +278,36 @@ namespace uaf
                const uaf::ServiceSettings*            serviceSettings,
                std::vector<uaf::Status>&               results);
 
+
+        /**
+        * Delete the specified monitored items.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be deleted.
+        * @param serviceSettings   The service settings to be used.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status deleteMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&   clientHandles,
+               const uaf::ServiceSettings*             serviceSettings,
+               std::vector<uaf::Status>&               results);
+
+
+        /**
+        * Modify the specified monitored items.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be modified.
+        * @param settings          The new settings of the monitored items.
+        * @param serviceSettings   The service settings to be used.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status modifyMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&   clientHandles,
+               const uaf::MonitoredItemSettings&       settings,
+               const uaf::ServiceSettings*             serviceSettings,
+               std::vector<uaf::Status>&               results);
+
         /**
          * Get the definition of a structured datatype.
          *
@@ -284,6 +322,57 @@ namespace uaf
 
 
 
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name RegisteredNodes
+         *  Register nodes, and get the aliases that the server assigned to them.
+         */
+        ///@{
+
+
+        /**
+         * Register nodes by invoking the RegisterNodes service.
+         *
+         * The server may assign an alias to each of the nodes, which it can access more efficiently
+         * than the original NodeId. Nodes that are already registered by this session are not
+         * registered again, but are reference-counted instead. The registrations are renewed
+         * automatically whenever the session is (re)connected.
+         *
+         * @param nodeIds           The (fully resolved) NodeIds of the nodes to register.
+         * @param serviceSettings   The service settings to be used.
+         * @return                  Good if the nodes could be registered, bad if not.
+         */
+        uaf::Status registerNodes(
+                const std::vector<uaf::NodeId>& nodeIds,
+                const uaf::ServiceSettings&     serviceSettings);
+
+
+        /**
+         * Release a registration of nodes, and invoke the UnregisterNodes service for those nodes
+         * that are not registered anymore.
+         *
+         * @param nodeIds           The NodeIds that were registered before.
+         * @param serviceSettings   The service settings to be used.
+         * @return                  Good if the nodes could be unregistered, bad if not.
+         */
+        uaf::Status unregisterNodes(
+                const std::vector<uaf::NodeId>& nodeIds,
+                const uaf::ServiceSettings&     serviceSettings);
+
+
+        /**
+         * Get the aliases that the server assigned to the given nodes.
+         *
+         * Nodes that are not registered (successfully) are their own alias.
+         *
+         * @param nodeIds   The NodeIds that were registered before.
+         * @param aliases   Output parameter: the aliases (one for each NodeId).
+         */
+        void registeredNodeIds(
+                const std::vector<uaf::NodeId>& nodeIds,
+                std::vector<uaf::NodeId>&       aliases);
+
+
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
          *  @name ServiceInvocations
@@ -291,6 +380,16 @@ namespace uaf
          */
         ///@{
 
+
+        /**
+         * Get the pool of invocations of this session.
+         *
+         * Invocations that are acquired from the pool must be released to the same pool before
+         * the session is released.
+         */
+        uaf::InvocationPool& invocationPool() { return invocationPool_; }
+
+
         /**
          * Invoke the Session service at this level (the Session level).
          *
@@ -381,6 +480,39 @@ namespace uaf
         uaf::Status updateArrays();
 
 
+        /**
+         * Invoke the RegisterNodes service and store the aliases (not locked!).
+         *
+         * @return  Good if the nodes could be registered, bad if not.
+         */
+        uaf::Status invokeRegisterNodes(
+                const std::vector<uaf::NodeId>& nodeIds,
+                const uaf::ServiceSettings&     serviceSettings);
+
+
+        /**
+         * Invoke the UnregisterNodes service (not locked!).
+         *
+         * @return  Good if the nodes could be unregistered, bad if not.
+         */
+        uaf::Status invokeUnregisterNodes(
+                const std::vector<uaf::NodeId>& nodeIds,
+                const uaf::ServiceSettings&     serviceSettings);
+
+
+        /**
+         * Register all registered nodes again, after the session was (re)connected.
+         */
+        void reregisterNodes();
+
+
+        /**
+         * Forget the aliases of all registered nodes, since they are only valid within the
+         * server session that assigned them.
+         */
+        void resetRegisteredNodeIds();
+
+
         /**
          * Update the connection info.
          */
@@ -391,15 +523,18 @@ namespace uaf
 
 
         /**
-         * Initialize the PKI store
+         * Does the session need a client certificate (i.e. does it sign or encrypt the data)?
          */
-        uaf::Status initializePkiStore(UaClientSdk::SessionSecurityInfo& uaSecurity);
+        bool needsClientCertificate() const;
 
 
         /**
-         * Load the client certificate from the file specified in the ClientSettings.
+         * Initialize the PKI store (and load the client certificate, if needed) by copying the
+         * shared PKI store of the database.
          */
-        uaf::Status loadClientCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity);
+        uaf::Status initializePkiStore(
+                UaClientSdk::SessionSecurityInfo&   uaSecurity,
+                bool                                withClientCertificate);
 
 
         /**
@@ -424,17 +559,9 @@ namespace uaf
                 UaClientSdk::SessionSecurityInfo& uaSecurity,
                 const uaf::SessionSecuritySettings& securitySettings);
 
-        /**
-         * Helper function to check if a path exists, or create the path if needed.
-         */
-        uaf::Status checkOrCreatePath(
-                bool checkOnly,
-                const std::string& path,
-                const std::string& description) const;
-
 
-        // Wrapped SDK session instance and callback instance
-        UaClientSdk::UaSession*             uaSession_;
+        // Session transport and callback instance
+        uaf::SessionTransport*              uaSession_;
         UaClientSdk::UaSessionCallback*     uaSessionCallback_;
 
         // server and namespace arrays
@@ -464,11 +591,27 @@ namespace uaf
         UaClientSdk::SessionConnectInfo     uaSessionConnectInfoNoInitialRetry_;
         // mutex for critical sections
         UaMutex                             sessionMutex_;
+        // the idle invocations of this session, to be reused by later requests
+        uaf::InvocationPool                 invocationPool_;
         // the RequesterInterface to call when asynchronous messages are received
         uaf::ClientInterface*              clientInterface_;
         // the Discoverer to use
         uaf::Discoverer*                   discoverer_;
 
+        // a registered node: the alias assigned by the server and the number of registrations
+        struct RegisteredNode
+        {
+            RegisteredNode() : registrations(0) {}
+            uaf::NodeId alias;
+            uint32_t    registrations;
+        };
+        typedef std::map<uaf::NodeId, RegisteredNode> RegisteredNodeMap;
+        RegisteredNodeMap                   registeredNodes_;
+        // the service settings that were used to register the nodes most recently
+        uaf::ServiceSettings                registerNodesSettings_;
+        // mutex for the registered nodes
+        UaMutex                             registeredNodesMutex_;
+
 
     };
 
@@ -26,6 +26,7 @@ namespace uaf
     using std::string;
     using std::vector;
     using std::map;
+    using std::size_t;
 
 
     // Constructor
@@ -37,7 +38,8 @@ namespace uaf
             Database* database)
     : clientInterface_(clientInterface),
       discoverer_(discoverer),
-      database_(database)
+      database_(database),
+      transportFactory_(0)
     {
         logger_ = new Logger(loggerFactory, "SessionFactory");
 
@@ -93,6 +95,15 @@ namespace uaf
     }
 
 
+    // Set the factory of the session transports
+    // =============================================================================================
+    void SessionFactory::setSessionTransportFactory(SessionTransportFactory* transportFactory)
+    {
+        UaMutexLocker locker(&sessionMapMutex_); // unlocks when locker goes out of scope
+        transportFactory_ = transportFactory;
+    }
+
+
 
 
 
@@ -189,7 +200,8 @@ namespace uaf
                 this,
                 clientInterface_,
                 discoverer_,
-                database_);
+                database_,
+                transportFactory_);
 
         // store the new session instance in the sessionMap
         sessionMap_[clientConnectionId] = session;
@@ -521,23 +533,371 @@ namespace uaf
     }
 
 
+    // Delete the monitored items with the given ClientHandles.
+    // =============================================================================================
+    Status SessionFactory::deleteMonitoredItems(
+            const vector<ClientHandle>& clientHandles,
+            const ServiceSettings*      serviceSettings,
+            vector<Status>&             results)
+    {
+        Status ret;
+
+        // set the correct size for the results output parameter
+        results.resize(clientHandles.size());
+
+        // fill all statuses with an "UnknownClientHandleError" status.
+        // The statuses for which a handle will be found, will be updated further on.
+        for (std::size_t i = 0; i < clientHandles.size(); i++)
+            results[i] = UnknownClientHandleError(clientHandles[i]);
+
+        // lock the mutex to make sure the sessionMap_ is not being manipulated
+        UaMutexLocker locker(&sessionMapMutex_);
+
+        // loop trough the sessions and let DeleteMonitoredItems be called (if needed!) on each
+        for (SessionMap::const_iterator it = sessionMap_.begin();
+                it != sessionMap_.end() && ret.isNotBad();
+                ++it)
+        {
+            ret = it->second->deleteMonitoredItemsIfNeeded(clientHandles, serviceSettings, results);
+        }
+
+        // the monitored items that are still unknown may only exist as persistent request targets
+        // (which are waiting to be re-created), so remove them from there. Don't do this if a
+        // service call failed, because then not all subscriptions have been checked.
+        for (std::size_t i = 0; i < clientHandles.size() && ret.isNotBad(); i++)
+        {
+            if (results[i].statusCode != statuscodes::UnknownClientHandleError)
+                continue;
+
+            RequestHandle requestHandle;
+            std::size_t targetRank;
+
+            if (database_->createMonitoredDataRequestStore.findTarget(
+                    clientHandles[i], requestHandle, targetRank))
+                results[i] = database_->createMonitoredDataRequestStore.removeTarget(
+                        requestHandle, targetRank);
+            else if (database_->createMonitoredEventsRequestStore.findTarget(
+                    clientHandles[i], requestHandle, targetRank))
+                results[i] = database_->createMonitoredEventsRequestStore.removeTarget(
+                        requestHandle, targetRank);
+            else
+                continue;
+
+            if (results[i].isGood())
+            {
+                database_->releaseClientHandle(clientHandles[i]);
+                if (ret.isUncertain())
+                    ret = statuscodes::Good;
+            }
+        }
+
+        return ret;
+    }
+
+
+    // Modify the monitored items with the given ClientHandles.
+    // =============================================================================================
+    Status SessionFactory::modifyMonitoredItems(
+            const vector<ClientHandle>&     clientHandles,
+            const MonitoredItemSettings&    settings,
+            const ServiceSettings*          serviceSettings,
+            vector<Status>&                 results)
+    {
+        Status ret;
+
+        // set the correct size for the results output parameter
+        results.resize(clientHandles.size());
+
+        // fill all statuses with an "UnknownClientHandleError" status.
+        // The statuses for which a handle will be found, will be updated further on.
+        for (std::size_t i = 0; i < clientHandles.size(); i++)
+            results[i] = UnknownClientHandleError(clientHandles[i]);
+
+        // lock the mutex to make sure the sessionMap_ is not being manipulated
+        UaMutexLocker locker(&sessionMapMutex_);
+
+        // loop trough the sessions and let ModifyMonitoredItems be called (if needed!) on each
+        for (SessionMap::const_iterator it = sessionMap_.begin();
+                it != sessionMap_.end() && ret.isNotBad();
+                ++it)
+        {
+            ret = it->second->modifyMonitoredItemsIfNeeded(
+                    clientHandles, settings, serviceSettings, results);
+        }
+
+        // the monitored items that are still unknown may only exist as persistent request targets
+        // (which are waiting to be re-created), so modify them there. Don't do this if a
+        // service call failed, because then not all subscriptions have been checked.
+        MonitoredItemSettingsApplier applier(settings);
+
+        for (std::size_t i = 0; i < clientHandles.size() && ret.isNotBad(); i++)
+        {
+            if (results[i].statusCode != statuscodes::UnknownClientHandleError)
+                continue;
+
+            RequestHandle requestHandle;
+            std::size_t targetRank;
+            MonitoredItemSettings::MonitoredItemKind kind;
+
+            if (database_->createMonitoredDataRequestStore.findTarget(
+                    clientHandles[i], requestHandle, targetRank))
+                kind = MonitoredItemSettings::Data;
+            else if (database_->createMonitoredEventsRequestStore.findTarget(
+                    clientHandles[i], requestHandle, targetRank))
+                kind = MonitoredItemSettings::Event;
+            else
+                continue;
+
+            if (kind != settings.kind())
+                results[i] = WrongTypeError(format(
+                        "Monitored item %d cannot be modified by settings of another kind "
+                        "(data versus event)", clientHandles[i]));
+            else if (kind == MonitoredItemSettings::Data)
+                results[i] = database_->createMonitoredDataRequestStore.modifyTargets(
+                        requestHandle, vector<std::size_t>(1, targetRank), applier);
+            else
+                results[i] = database_->createMonitoredEventsRequestStore.modifyTargets(
+                        requestHandle, vector<std::size_t>(1, targetRank), applier);
+
+            if (results[i].isGood() && ret.isUncertain())
+                ret = statuscodes::Good;
+        }
+
+        return ret;
+    }
+
+
+    // Register nodes
+    // =============================================================================================
+    Status SessionFactory::registerNodes(
+            const vector<ExpandedNodeId>&   expandedNodeIds,
+            const SessionSettings*          sessionSettingsPtr,
+            const ServiceSettings*          serviceSettingsPtr,
+            vector<ClientConnectionId>&     clientConnectionIds,
+            vector<Status>&                 statuses)
+    {
+        Status ret;
+
+        ServiceSettings serviceSettings;
+        if (serviceSettingsPtr == NULL)
+            serviceSettings = database_->clientSettings.defaultRegisterNodesSettings;
+        else
+            serviceSettings = *serviceSettingsPtr;
+
+        clientConnectionIds.assign(expandedNodeIds.size(), constants::CLIENTHANDLE_NOT_ASSIGNED);
+        statuses.resize(expandedNodeIds.size());
+
+        // group the nodes per server
+        map<string, vector<size_t> > ranksPerServer;
+        for (size_t i = 0; i < expandedNodeIds.size(); i++)
+            ranksPerServer[expandedNodeIds[i].serverUri()].push_back(i);
+
+        ret = statuscodes::Good;
+
+        for (map<string, vector<size_t> >::const_iterator it = ranksPerServer.begin();
+             it != ranksPerServer.end();
+             ++it)
+        {
+            const string&           serverUri = it->first;
+            const vector<size_t>&   ranks     = it->second;
+
+            SessionSettings sessionSettings;
+            if (sessionSettingsPtr == NULL)
+            {
+                map<string, SessionSettings>::const_iterator iter;
+                iter = database_->clientSettings.specificSessionSettings.find(serverUri);
+
+                if (iter != database_->clientSettings.specificSessionSettings.end())
+                    sessionSettings = iter->second;
+                else
+                    sessionSettings = database_->clientSettings.defaultSessionSettings;
+            }
+            else
+            {
+                sessionSettings = *sessionSettingsPtr;
+            }
+
+            Session* session = 0;
+            Status serverStatus = acquireSession(serverUri, sessionSettings, session);
+
+            if (serverStatus.isGood())
+            {
+                vector<NodeId> nodeIds;
+                nodeIds.reserve(ranks.size());
+                for (size_t j = 0; j < ranks.size(); j++)
+                    nodeIds.push_back(expandedNodeIds[ranks[j]].nodeId());
+
+                serverStatus = session->registerNodes(nodeIds, serviceSettings);
+
+                if (serverStatus.isGood())
+                {
+                    for (size_t j = 0; j < ranks.size(); j++)
+                        clientConnectionIds[ranks[j]] = session->clientConnectionId();
+                }
+
+                releaseSession(session);
+            }
+
+            for (size_t j = 0; j < ranks.size(); j++)
+                statuses[ranks[j]] = serverStatus;
+
+            if (serverStatus.isBad())
+                ret = serverStatus;
+        }
+
+        return ret;
+    }
+
+
+    // Unregister nodes
+    // =============================================================================================
+    Status SessionFactory::unregisterNodes(
+            const vector<ExpandedNodeId>&       expandedNodeIds,
+            const vector<ClientConnectionId>&   clientConnectionIds,
+            const ServiceSettings*              serviceSettingsPtr)
+    {
+        Status ret;
+
+        ServiceSettings serviceSettings;
+        if (serviceSettingsPtr == NULL)
+            serviceSettings = database_->clientSettings.defaultRegisterNodesSettings;
+        else
+            serviceSettings = *serviceSettingsPtr;
+
+        // group the nodes per session
+        map<ClientConnectionId, vector<NodeId> > nodeIdsPerSession;
+        for (size_t i = 0; i < expandedNodeIds.size(); i++)
+        {
+            if (clientConnectionIds[i] != constants::CLIENTHANDLE_NOT_ASSIGNED)
+                nodeIdsPerSession[clientConnectionIds[i]].push_back(expandedNodeIds[i].nodeId());
+        }
+
+        ret = statuscodes::Good;
+
+        for (map<ClientConnectionId, vector<NodeId> >::const_iterator it = nodeIdsPerSession.begin();
+             it != nodeIdsPerSession.end();
+             ++it)
+        {
+            // if the session doesn't exist anymore, the server has forgotten the nodes already
+            Session* session = 0;
+            if (acquireExistingSession(it->first, session).isGood())
+            {
+                Status sessionStatus = session->unregisterNodes(it->second, serviceSettings);
+                releaseSession(session);
+
+                if (sessionStatus.isBad())
+                    ret = sessionStatus;
+            }
+        }
+
+        return ret;
+    }
+
+
+    // Get the aliases of registered nodes
+    // =============================================================================================
+    void SessionFactory::registeredNodeIds(
+            const vector<ExpandedNodeId>&   expandedNodeIds,
+            vector<ClientConnectionId>&     clientConnectionIds,
+            vector<ExpandedNodeId>&         aliases)
+    {
+        aliases = expandedNodeIds;
+
+        // group the nodes per session
+        map<ClientConnectionId, vector<size_t> > ranksPerSession;
+        for (size_t i = 0; i < expandedNodeIds.size(); i++)
+        {
+            if (clientConnectionIds[i] != constants::CLIENTHANDLE_NOT_ASSIGNED)
+                ranksPerSession[clientConnectionIds[i]].push_back(i);
+        }
+
+        for (map<ClientConnectionId, vector<size_t> >::const_iterator it = ranksPerSession.begin();
+             it != ranksPerSession.end();
+             ++it)
+        {
+            const vector<size_t>& ranks = it->second;
+
+            Session* session = 0;
+            if (acquireExistingSession(it->first, session).isGood())
+            {
+                vector<NodeId> nodeIds;
+                vector<NodeId> nodeAliases;
+                nodeIds.reserve(ranks.size());
+                for (size_t j = 0; j < ranks.size(); j++)
+                    nodeIds.push_back(expandedNodeIds[ranks[j]].nodeId());
+
+                session->registeredNodeIds(nodeIds, nodeAliases);
+                releaseSession(session);
+
+                for (size_t j = 0; j < ranks.size(); j++)
+                    aliases[ranks[j]].setNodeId(nodeAliases[j]);
+            }
+            else
+            {
+                // the session was garbage collected, so any session may access the nodes now
+                for (size_t j = 0; j < ranks.size(); j++)
+                    clientConnectionIds[ranks[j]] = constants::CLIENTHANDLE_NOT_ASSIGNED;
+            }
+        }
+    }
+
+
     // Get a structure definition
     // =============================================================================================
     Status SessionFactory::structureDefinition(
     		const NodeId& 			dataTypeId,
 			StructureDefinition& 	definition)
     {
-        Status ret;
+        StructureCodec codec;
+
+        Status ret = structureCodec(dataTypeId, string(), codec);
+
+        if (ret.isGood())
+            definition = codec.definition();
+
+        return ret;
+    }
+
+
+    // Get a compiled structure definition
+    // =============================================================================================
+    Status SessionFactory::structureCodec(
+            const NodeId&   dataTypeId,
+            const string&   serverUri,
+            StructureCodec& codec)
+    {
+        // first try the cache, so we don't need to bother the sessions
+        bool cached;
+        if (serverUri.empty())
+            cached = database_->structureDefinitionCache.find(dataTypeId, codec);
+        else
+            cached = database_->structureDefinitionCache.find(serverUri, dataTypeId, codec);
+
+        if (cached)
+            return Status(statuscodes::Good);
+
+        Status ret = DefinitionNotFoundError();
+        StructureDefinition definition;
 
         // lock the mutex to make sure the sessionMap_ is not being manipulated
         UaMutexLocker locker(&sessionMapMutex_);
 
-        // loop trough the sessions and let structureDefinition be called (if needed!) on each of them
+        // loop trough the sessions (of the given server, if any) until one knows the definition
         for (SessionMap::const_iterator it = sessionMap_.begin();
                 it != sessionMap_.end() && ret.isNotGood();
                 ++it)
         {
-            ret = it->second->structureDefinition(dataTypeId, definition);
+            if (serverUri.empty() || it->second->serverUri() == serverUri)
+            {
+                ret = it->second->structureDefinition(dataTypeId, definition);
+
+                if (ret.isGood())
+                {
+                    codec.compile(definition);
+                    database_->structureDefinitionCache.add(
+                            it->second->serverUri(), dataTypeId, codec);
+                }
+            }
         }
 
         return ret;
@@ -550,17 +910,22 @@ namespace uaf
     Status SessionFactory::acquireSession(
             const string&           serverUri,
             const SessionSettings&  sessionSettings,
-            Session*&               session)
+            Session*&               session,
+            RequestTrace*           trace)
     {
         logger_->debug("Acquiring Session to %s with the following settings:", serverUri.c_str());
         logger_->debug(sessionSettings.toString());
 
+        TraceTimer acquireTimer(trace, "acquireSession", &serverUri);
+
         Status ret;
 
         session = 0;
 
         // lock the mutex to make sure the sessionMap_ is not being manipulated
+        TraceTimer lockTimer(trace, "sessionLock", &serverUri);
         UaMutexLocker locker(&sessionMapMutex_);
+        lockTimer.stop();
 
         // first check if we need to create a new session in any case:
         if (sessionSettings.unique)
@@ -614,7 +979,8 @@ namespace uaf
                     this,
                     clientInterface_,
                     discoverer_,
-                    database_);
+                    database_,
+                    transportFactory_);
 
             // store the new session instance in the sessionMap
             sessionMap_[clientConnectionId] = session;
@@ -625,7 +991,9 @@ namespace uaf
             activityMapMutex_.unlock();
 
             // connect to the session
+            TraceTimer connectTimer(trace, "connect", &serverUri);
             session->connect();
+            connectTimer.stop();
 
             // regardless of whether the connection succeeded or failed, set the return status
             // to 'good'
@@ -924,6 +1292,9 @@ namespace uaf
             logger_->error("Unknown transaction id received, so we cannot cache the result");
         }
 
+        // count the finished invocation in the metrics
+        database_->metrics.asyncServiceFinished(transactionId, uaStatus.isGood());
+
         // call the callback interface
         clientInterface_->callComplete(result);
     }
@@ -1005,6 +1376,9 @@ namespace uaf
 //            logger_->error("Unknown transaction id received, so we cannot cache the result");
 //        }
 
+        // count the finished invocation in the metrics
+        database_->metrics.asyncServiceFinished(transactionId, uaStatus.isGood());
+
         // call the callback interface
         clientInterface_->readComplete(result);
     }
@@ -1081,6 +1455,9 @@ namespace uaf
 //            logger_->error("Unknown transaction id received, so we cannot cache the result");
 //        }
 
+        // count the finished invocation in the metrics
+        database_->metrics.asyncServiceFinished(transactionId, uaStatus.isGood());
+
         // call the callback interface
         clientInterface_->writeComplete(result);
     }
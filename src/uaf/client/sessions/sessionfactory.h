@@ -37,7 +37,9 @@
 #include "uaf/client/clientinterface.h"
 #include "uaf/client/requests/requests.h"
 #include "uaf/client/results/results.h"
+#include "uaf/client/resolution/resolveditems.h"
 #include "uaf/client/settings/allsettings.h"
+#include "uaf/client/metrics/tracetimer.h"
 
 
 namespace uaf
@@ -84,6 +86,17 @@ namespace uaf
         void deleteAllSessions();
 
 
+        /**
+         * Set the factory of the session transports of the sessions that are created from now on.
+         *
+         * See uaf::Client::setSessionTransportFactory for more info.
+         *
+         * @param transportFactory  The factory (not owned by the session factory), or NULL to
+         *                          invoke the services of real servers through the SDK.
+         */
+        void setSessionTransportFactory(uaf::SessionTransportFactory* transportFactory);
+
+
         /**
          * Manually connect to a specific server.
          *
@@ -262,6 +275,105 @@ namespace uaf
                std::vector<uaf::Status>&               results);
 
 
+        /**
+        * Delete the specified monitored items.
+        *
+        * Monitored items that are not owned by a subscription at the moment (e.g. because their
+        * session is disconnected) are deleted from the persistent requests, so they won't be
+        * re-created anymore.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be deleted.
+        * @param serviceSettings   The service settings to be used.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status deleteMonitoredItems(
+               const std::vector<uaf::ClientHandle>&   clientHandles,
+               const uaf::ServiceSettings*             serviceSettings,
+               std::vector<uaf::Status>&               results);
+
+
+        /**
+        * Modify the specified monitored items.
+        *
+        * Monitored items that are not owned by a subscription at the moment (e.g. because their
+        * session is disconnected) are modified in the persistent requests, so they will be
+        * re-created with the modified settings.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be modified.
+        * @param settings          The new settings of the monitored items.
+        * @param serviceSettings   The service settings to be used.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status modifyMonitoredItems(
+               const std::vector<uaf::ClientHandle>&   clientHandles,
+               const uaf::MonitoredItemSettings&       settings,
+               const uaf::ServiceSettings*             serviceSettings,
+               std::vector<uaf::Status>&               results);
+
+
+        /**
+         * Register nodes at the sessions that host them (by invoking the RegisterNodes service).
+         *
+         * The nodes are grouped per server, and each group is registered by the session that
+         * would also be used to read or write them (i.e. the session that is acquired for the
+         * server URI and the session settings).
+         *
+         * @param expandedNodeIds       The resolved ExpandedNodeIds of the nodes to register.
+         * @param sessionSettings       The session settings to be used, or NULL to use the
+         *                              ClientSettings.
+         * @param serviceSettings       The service settings to be used, or NULL to use the
+         *                              defaultRegisterNodesSettings of the ClientSettings.
+         * @param clientConnectionIds   Output parameter: the ClientConnectionId of the session
+         *                              that registered each node.
+         * @param statuses              Output parameter: the status of each node.
+         * @return                      Good if all nodes could be registered, bad if not.
+         */
+        uaf::Status registerNodes(
+                const std::vector<uaf::ExpandedNodeId>& expandedNodeIds,
+                const uaf::SessionSettings*             sessionSettings,
+                const uaf::ServiceSettings*             serviceSettings,
+                std::vector<uaf::ClientConnectionId>&   clientConnectionIds,
+                std::vector<uaf::Status>&               statuses);
+
+
+        /**
+         * Unregister nodes that were registered by registerNodes().
+         *
+         * Nodes of which the session does not exist anymore are ignored.
+         *
+         * @param expandedNodeIds       The ExpandedNodeIds of the registered nodes.
+         * @param clientConnectionIds   The ClientConnectionIds of the sessions that registered
+         *                              the nodes.
+         * @param serviceSettings       The service settings to be used, or NULL to use the
+         *                              defaultRegisterNodesSettings of the ClientSettings.
+         * @return                      Good if the nodes could be unregistered, bad if not.
+         */
+        uaf::Status unregisterNodes(
+                const std::vector<uaf::ExpandedNodeId>&     expandedNodeIds,
+                const std::vector<uaf::ClientConnectionId>& clientConnectionIds,
+                const uaf::ServiceSettings*                 serviceSettings);
+
+
+        /**
+         * Get the aliases that the servers assigned to registered nodes.
+         *
+         * Nodes of which the session does not exist anymore are their own alias, and their
+         * ClientConnectionId is changed into CLIENTHANDLE_NOT_ASSIGNED, so that they can be
+         * accessed by any suitable session.
+         *
+         * @param expandedNodeIds       The ExpandedNodeIds of the registered nodes.
+         * @param clientConnectionIds   In/output parameter: the ClientConnectionIds of the
+         *                              sessions that registered the nodes.
+         * @param aliases               Output parameter: the aliases (one for each node).
+         */
+        void registeredNodeIds(
+                const std::vector<uaf::ExpandedNodeId>& expandedNodeIds,
+                std::vector<uaf::ClientConnectionId>&   clientConnectionIds,
+                std::vector<uaf::ExpandedNodeId>&       aliases);
+
+
         /**
          * Get the definition of a structured datatype.
          *
@@ -275,6 +387,25 @@ namespace uaf
 				 uaf::StructureDefinition& 	definition);
 
 
+        /**
+         * Get the compiled definition of a structured datatype.
+         *
+         * The definitions are cached per server URI and datatype, so they are only fetched
+         * from the server (and compiled) once.
+         *
+         * @param dataTypeId    The NodeId of the structured datatype.
+         * @param serverUri     The URI of the server that exposes the datatype, or an empty
+         *                      string to accept the definition of any connected server.
+         * @param codec         Output parameter, the compiled definition (if found).
+         * @return              DefinitionNotFoundError if no definition was found,
+         *                      Good otherwise.
+         */
+         uaf::Status structureCodec(
+                 const uaf::NodeId&         dataTypeId,
+                 const std::string&         serverUri,
+                 uaf::StructureCodec&       codec);
+
+
         template<typename _Service>
         typename _Service::Settings getServiceSettings(const typename _Service::Request&  request)
         {
@@ -331,17 +462,49 @@ namespace uaf
                 const uaf::Mask&                   mask,
                 typename _Service::Result&         result)
         {
-            logger_->debug("Invoking %sRequest %d", _Service::name().c_str(), request.requestHandle());
+            return invokeRequest<_Service>(
+                    request, request.requestHandle(), uaf::ResolvedItems(), mask, result);
+        }
+
+
+        /**
+         * Invoke a request of which (some of) the targets have been resolved.
+         *
+         * The request itself is not modified: only the copies of the targets that are made for
+         * the invocations are updated with the resolved items.
+         *
+         * @tparam _Service         The service to be requested (such as uaf::ReadService,
+         *                          uaf::AsyncMethodCallService, etc.).
+         * @param request           The request to invoke.
+         * @param requestHandle     The handle that was assigned to the request.
+         * @param resolvedItems     The resolved items of the targets.
+         * @param mask              The mask identifying the targets of the request that need to
+         *                          be included in the invocation.
+         * @param result            Output parameter: the result of the invocation.
+         * @return                  Good if the invocation went fine, bad if not.
+         */
+        template<typename _Service>
+        uaf::Status invokeRequest(
+                const typename _Service::Request&  request,
+                uaf::RequestHandle                 requestHandle,
+                const uaf::ResolvedItems&          resolvedItems,
+                const uaf::Mask&                   mask,
+                typename _Service::Result&         result)
+        {
+            logger_->debug("Invoking %sRequest %d", _Service::name().c_str(), requestHandle);
             logger_->debug("Mask is %s", mask.toString().c_str());
 
             // Invocation details
-            typedef typename _Service::Invocation Invocation;
+            typedef typename _Service::Invocation    Invocation;
+            typedef typename _Service::RequestTarget RequestTarget;
             bool async = _Service::asynchronous;
-            uaf::RequestHandle requestHandle = request.requestHandle();
 
             // declare the return Status
             uaf::Status ret;
 
+            // the trace of the request, or NULL if the request is not traced
+            uaf::RequestTrace* trace = result.trace.isEnabled() ? &result.trace : NULL;
+
             // check the input parameters
             if (request.targets.size() == mask.size())
                 ret = uaf::statuscodes::Good;
@@ -356,18 +519,41 @@ namespace uaf
 
             // store the UAF handle and map it to a transaction id, if request is asynchronous
             uaf::TransactionId transactionId;
-            bool handleStored = storeRequestHandleIfNeeded<_Service>(request, transactionId);
+            bool handleStored = storeRequestHandleIfNeeded<_Service>(
+                    request, requestHandle, transactionId);
 
             // create a map to store the invocations that we'll create
             typedef std::map<uaf::Session*, Invocation*> InvocationMap;
             InvocationMap invocations;
 
+            // most requests are sent to a single server, so we remember the last server URI and
+            // its session, to avoid looking them up again for every target
+            std::string lastServerUri;
+            Session*    lastSession = NULL;
+
+            // a copy of a target with its resolved items applied
+            RequestTarget resolvedTarget;
+
             logger_->debug("Building the invocations");
             for (std::size_t i = 0; i < request.targets.size() && ret.isGood(); i++)
             {
                 if (mask.isSet(i))
                 {
-                    if (request.clientConnectionIdGiven)
+                    // the target to invoke: the target of the request itself, or (if it has been
+                    // resolved) a copy of it with the resolved items applied
+                    const RequestTarget* target = &request.targets[i];
+                    if (resolvedItems.isResolved(i))
+                    {
+                        resolvedTarget = request.targets[i];
+                        ret = resolvedItems.applyTo(i, resolvedTarget);
+                        target = &resolvedTarget;
+                    }
+
+                    if (ret.isNotGood())
+                    {
+                        logger_->error("Could not apply the resolved items to target %d", i);
+                    }
+                    else if (request.clientConnectionIdGiven)
                     {
                         logger_->debug("ClientConnectionId %d is given", request.clientConnectionId);
 
@@ -378,10 +564,12 @@ namespace uaf
                             ret = acquireExistingSession(request.clientConnectionId, session);
                             if (ret.isGood())
                             {
-                                invocations[session] = new Invocation;
+                                invocations[session] = session->invocationPool().acquire<Invocation>();
                                 invocations[session]->setAsynchronous(async);
                                 invocations[session]->setRequestHandle(requestHandle);
+                                invocations[session]->setTrace(trace);
                                 invocations[session]->setServiceSettings(getServiceSettings<_Service>(request));
+                                invocations[session]->reserveTargets(mask.setCount());
                             }
                         }
 
@@ -394,7 +582,7 @@ namespace uaf
                             for (typename InvocationMap::const_iterator it = invocations.begin(); it != invocations.end(); ++it)
                             {
                                 logger_->debug("Adding target %d", i);
-                                it->second->addTarget(i, request.targets[i], result.targets[i]);
+                                it->second->addTarget(i, *target, result.targets[i]);
                             }
                         }
 
@@ -405,48 +593,72 @@ namespace uaf
 
                         // we first need to determine the server which hosts the target
                         std::string serverUri;
-                        if (getServerUriFromTarget(request.targets[i], serverUri).isGood())
+                        if (getServerUriFromTarget(*target, serverUri).isGood())
                         {
                             logger_->debug("ServerUri was found: %s", serverUri.c_str());
 
                             Session* session = NULL;
-                            uaf::SessionSettings sessionSettings = getSessionSettings<_Service>(request, serverUri);
 
-                            logger_->debug("Trying to find a scheduled session");
-
-                            // check if the session we need is already scheduled for an invocation
-                            for (typename InvocationMap::const_iterator it = invocations.begin();
-                                    it != invocations.end(); ++it)
+                            // the session settings only depend on the server URI, so if the
+                            // previous target was hosted by the same server, we can take the
+                            // same session
+                            if (lastSession != NULL && serverUri == lastServerUri)
                             {
-                                if (   it->first->serverUri() == serverUri
-                                    && it->first->sessionSettings() == sessionSettings)
-                                {
-                                    logger_->debug("Found a scheduled session");
-                                    session = it->first;
-                                }
+                                session = lastSession;
                             }
-
-                            // if the session is not already scheduled, we acquire it first
-                            if (session == NULL)
+                            else
                             {
-                                logger_->debug("No session was scheduled, so we acquire one");
+                                uaf::SessionSettings sessionSettings = getSessionSettings<_Service>(request, serverUri);
 
-                                ret = acquireSession(serverUri, sessionSettings, session);
+                                logger_->debug("Trying to find a scheduled session");
+
+                                // check if the session we need is already scheduled for an invocation
+                                for (typename InvocationMap::const_iterator it = invocations.begin();
+                                        it != invocations.end(); ++it)
+                                {
+                                    if (   it->first->serverUri() == serverUri
+                                        && it->first->sessionSettings() == sessionSettings)
+                                    {
+                                        logger_->debug("Found a scheduled session");
+                                        session = it->first;
+                                    }
+                                }
+
+                                // if the session is not already scheduled, we acquire it first
+                                if (session == NULL)
+                                {
+                                    logger_->debug("No session was scheduled, so we acquire one");
+
+                                    ret = acquireSession(
+                                            serverUri, sessionSettings, session, trace);
+
+                                    if (ret.isGood())
+                                    {
+                                        logger_->debug("Scheduling an invocation for this session");
+                                        invocations[session] = session->invocationPool().acquire<Invocation>();
+                                        invocations[session]->setAsynchronous(async);
+                                        invocations[session]->setRequestHandle(requestHandle);
+                                        invocations[session]->setTrace(trace);
+                                        invocations[session]->setServiceSettings(getServiceSettings<_Service>(request));
+
+                                        // most requests are sent to a single server, so reserve
+                                        // room for all targets in the first invocation
+                                        if (invocations.size() == 1)
+                                            invocations[session]->reserveTargets(mask.setCount());
+                                    }
+                                }
 
                                 if (ret.isGood())
                                 {
-                                    logger_->debug("Scheduling an invocation for this session");
-                                    invocations[session] = new Invocation;
-                                    invocations[session]->setAsynchronous(async);
-                                    invocations[session]->setRequestHandle(requestHandle);
-                                    invocations[session]->setServiceSettings(getServiceSettings<_Service>(request));
+                                    lastServerUri = serverUri;
+                                    lastSession   = session;
                                 }
                             }
 
                             if (ret.isGood())
                             {
                                 logger_->debug("Adding the target");
-                                invocations[session]->addTarget(i, request.targets[i], result.targets[i]);
+                                invocations[session]->addTarget(i, *target, result.targets[i]);
                             }
                         }
                         else
@@ -473,9 +685,8 @@ namespace uaf
 
             // loop through the invocations (while the return Status is good)
             int invocationIndex = 0; // index to keep track of the number of processed invocations
-            for (typename InvocationMap::iterator it = invocations.begin();
-                 it != invocations.end() && ret.isGood();
-                 ++it)
+            typename InvocationMap::iterator it = invocations.begin();
+            for (; it != invocations.end() && ret.isGood(); ++it)
             {
                 logger_->debug("Processing invocation %d", invocationIndex);
 
@@ -494,12 +705,38 @@ namespace uaf
                 logger_->debug("Copying the session information to the invocation");
                 invocation->setSessionInformation(session->sessionInformation());
 
-                // if the session is connected, invoke the service
+                // if the session is connected, invoke the service (and count it in the metrics:
+                // the latency of an asynchronous invocation is counted when its result arrives)
                 if (session->isConnected())
                 {
                     logger_->debug("Forwarding the invocation to session %d",
                                    session->clientConnectionId());
-                    ret = session->invokeService<_Service>(request, *invocation);
+
+                    std::size_t noOfTargets = invocation->requestTargets().size();
+
+                    uaf::TraceTimer invokeTimer(trace, "invokeService", &session->serverUri());
+
+                    if (handleStored)
+                    {
+                        database_->metrics.asyncServiceStarted(
+                                transactionId, session->serverUri(), _Service::name(), noOfTargets);
+
+                        ret = session->invokeService<_Service>(request, *invocation);
+
+                        if (ret.isNotGood())
+                            database_->metrics.asyncServiceFinished(transactionId, false);
+                    }
+                    else
+                    {
+                        uint64_t startTime = database_->metrics.serviceStarted(
+                                session->serverUri(), _Service::name());
+
+                        ret = session->invokeService<_Service>(request, *invocation);
+
+                        database_->metrics.serviceFinished(
+                                session->serverUri(), _Service::name(), startTime, noOfTargets,
+                                ret.isGood());
+                    }
                 }
                 else
                     ret = session->sessionInformation().lastConnectionAttemptStatus;
@@ -508,18 +745,29 @@ namespace uaf
                 if (ret.isGood())
                 {
                     logger_->debug("Copying the invocation data to the result");
+                    uaf::TraceTimer copyTimer(trace, "copyToResult", &session->serverUri());
                     ret = invocation->copyToResult(result);
                 }
 
-                releaseSession(session);
-
-                // don't forget to delete the invocation!!!
+                // don't forget to release the invocation!!! (before the session is released,
+                // since the session owns the pool)
                 // (see bugfix https://github.com/uaf/uaf/issues/86)
-                delete invocation;
+                session->invocationPool().release(invocation);
+
+                releaseSession(session);
 
                 invocationIndex++;
             }
 
+            // if the processing was stopped because of an error, the remaining invocations were
+            // not processed, but they (and their sessions) must be released as well
+            for (; it != invocations.end(); ++it)
+            {
+                uaf::Session* session = it->first;
+                session->invocationPool().release(it->second);
+                releaseSession(session);
+            }
+
             // clear the InvocationMap
             invocations.clear();
 
@@ -564,13 +812,15 @@ namespace uaf
          * @param serverUri         Server URI to create the session to.
          * @param sessionSettings   Settings of the session to be acquired.
          * @param session           Pointer to the requested session.
+         * @param trace             The trace to add the stages of the acquisition to, or NULL.
          * @return                  Status object, will be erroneous in case no connected session
          *                          could be provided via the 'session' argument.
          */
         uaf::Status acquireSession(
                 const std::string&              serverUri,
                 const uaf::SessionSettings&    sessionSettings,
-                uaf::Session*&                 session);
+                uaf::Session*&                 session,
+                uaf::RequestTrace*             trace = NULL);
 
 
         /**
@@ -684,6 +934,7 @@ namespace uaf
          * subscription requests.
          *
          * @param request       The request for which we will store the request handle, if needed.
+         * @param requestHandle The handle that was assigned to the request.
          * @param transactionId Output parameter: the newly generated transaction id, if the return
          *                      value is true.
          * @return              True if a request handle was stored, false if not.
@@ -693,6 +944,7 @@ namespace uaf
                 const uaf::BaseSessionRequest<typename _Service::Settings,
                                                typename _Service::RequestTarget,
                                                _Service::asynchronous>& request,
+                uaf::RequestHandle  requestHandle,
                 uaf::TransactionId& transactionId)
         {
             bool stored;
@@ -701,11 +953,11 @@ namespace uaf
             {
                 transactionMapMutex_.lock();
                 transactionId = getNewTransactionId();
-                transactionMap_[transactionId] = request.requestHandle();
+                transactionMap_[transactionId] = requestHandle;
                 transactionMapMutex_.unlock();
                 stored = true;
                 logger_->debug("A new transaction id %d was stored for request %d",
-                               transactionId, request.requestHandle());
+                               transactionId, requestHandle);
             }
             else
             {
@@ -726,6 +978,7 @@ namespace uaf
                 const uaf::BaseSubscriptionRequest<typename _Service::Settings,
                                                     typename _Service::RequestTarget,
                                                     _Service::asynchronous>& request,
+                uaf::RequestHandle  requestHandle,
                 uaf::TransactionId& transactionId)
         {
             // nothing to do
@@ -744,6 +997,9 @@ namespace uaf
         uaf::Discoverer* discoverer_;
         // pointer to the client database
         uaf::Database* database_;
+        // the factory of the session transports (NULL for SDK sessions), protected by the
+        // sessionMapMutex_
+        uaf::SessionTransportFactory* transportFactory_;
 
         // the current transaction id, and a mutex to safely increment it
         uaf::TransactionId  transactionId_;
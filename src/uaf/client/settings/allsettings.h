@@ -30,6 +30,7 @@
 #include "uaf/client/settings/translatebrowsepathstonodeidssettings.h"
 #include "uaf/client/settings/browsesettings.h"
 #include "uaf/client/settings/browsenextsettings.h"
+#include "uaf/client/settings/crawlsettings.h"
 #include "uaf/client/settings/historyreadrawmodifiedsettings.h"
 #include "uaf/client/settings/sessionsettings.h"
 #include "uaf/client/settings/subscriptionsettings.h"
@@ -55,7 +55,19 @@ namespace uaf
       issuersRevocationListLocation("PKI/issuers/crl/"),
       createSecurityLocationsIfNeeded(true),
       clientPrivateKey("PKI/client/private/client.pem"),
-      clientCertificate("PKI/client/certs/client.der")
+      clientCertificate("PKI/client/certs/client.der"),
+      shardSubscriptions(false),
+      shardBySamplingInterval(true),
+      maxMonitoredItemsPerSubscription(1000),
+      notificationQueueCapacity(0),
+      notificationQueueOverflowPolicy(uaf::overflowpolicies::Block),
+      notificationDeliveryThreads(1),
+      republishMissingNotifications(true),
+      maxRepublishedMessages(100),
+      failedResolutionCacheTimeSec(10.0),
+      snapshotIntervalSec(60.0),
+      metricsIntervalSec(0.0),
+      traceRequests(false)
 
     {}
 
@@ -74,7 +86,19 @@ namespace uaf
       issuersRevocationListLocation("PKI/issuers/crl/"),
       createSecurityLocationsIfNeeded(true),
       clientPrivateKey("PKI/client/private/client.pem"),
-      clientCertificate("PKI/client/certs/client.der")
+      clientCertificate("PKI/client/certs/client.der"),
+      shardSubscriptions(false),
+      shardBySamplingInterval(true),
+      maxMonitoredItemsPerSubscription(1000),
+      notificationQueueCapacity(0),
+      notificationQueueOverflowPolicy(uaf::overflowpolicies::Block),
+      notificationDeliveryThreads(1),
+      republishMissingNotifications(true),
+      maxRepublishedMessages(100),
+      failedResolutionCacheTimeSec(10.0),
+      snapshotIntervalSec(60.0),
+      metricsIntervalSec(0.0),
+      traceRequests(false)
     {}
 
     // Constructor
@@ -95,7 +119,19 @@ namespace uaf
       issuersRevocationListLocation("PKI/issuers/crl/"),
       createSecurityLocationsIfNeeded(true),
       clientPrivateKey("PKI/client/private/client.pem"),
-      clientCertificate("PKI/client/certs/client.der")
+      clientCertificate("PKI/client/certs/client.der"),
+      shardSubscriptions(false),
+      shardBySamplingInterval(true),
+      maxMonitoredItemsPerSubscription(1000),
+      notificationQueueCapacity(0),
+      notificationQueueOverflowPolicy(uaf::overflowpolicies::Block),
+      notificationDeliveryThreads(1),
+      republishMissingNotifications(true),
+      maxRepublishedMessages(100),
+      failedResolutionCacheTimeSec(10.0),
+      snapshotIntervalSec(60.0),
+      metricsIntervalSec(0.0),
+      traceRequests(false)
     {}
 
 
@@ -297,6 +333,67 @@ namespace uaf
         ss << indent << " - defaultSubscriptionSettings\n";
         ss << defaultSubscriptionSettings.toString(indent + "   ", colon) << "\n";
 
+        ss << indent << " - shardSubscriptions";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (shardSubscriptions ? "true" : "false") << "\n";
+
+        ss << indent << " - shardBySamplingInterval";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (shardBySamplingInterval ? "true" : "false") << "\n";
+
+        ss << indent << " - maxMonitoredItemsPerSubscription";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxMonitoredItemsPerSubscription << "\n";
+
+        ss << indent << " - notificationQueueCapacity";
+        ss << fillToPos(ss, colon);
+        ss << ": " << notificationQueueCapacity << "\n";
+
+        ss << indent << " - notificationQueueOverflowPolicy";
+        ss << fillToPos(ss, colon);
+        ss << ": " << notificationQueueOverflowPolicy
+           << " (" << uaf::overflowpolicies::toString(notificationQueueOverflowPolicy) << ")\n";
+
+        ss << indent << " - notificationDeliveryThreads";
+        ss << fillToPos(ss, colon);
+        ss << ": " << notificationDeliveryThreads << "\n";
+
+        ss << indent << " - republishMissingNotifications";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (republishMissingNotifications ? "true" : "false") << "\n";
+
+        ss << indent << " - maxRepublishedMessages";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxRepublishedMessages << "\n";
+
+        ss << indent << " - failedResolutionCacheTimeSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << failedResolutionCacheTimeSec << "\n";
+
+        ss << indent << " - snapshotFileName";
+        ss << fillToPos(ss, colon);
+        ss << ": " << snapshotFileName << "\n";
+
+        ss << indent << " - snapshotIntervalSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << snapshotIntervalSec << "\n";
+
+        ss << indent << " - metricsIntervalSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << metricsIntervalSec << "\n";
+
+        ss << indent << " - metricsFileName";
+        ss << fillToPos(ss, colon);
+        ss << ": " << metricsFileName << "\n";
+
+        ss << indent << " - traceRequests";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (traceRequests ? "true" : "false") << "\n";
+
+        ss << indent << " - traceFileName";
+        ss << fillToPos(ss, colon);
+        ss << ": " << traceFileName << "\n";
+
         ss << indent << " - defaultBrowseNextSettings\n";
         ss << defaultBrowseNextSettings.toString(indent + "   ", colon) << "\n";
 
@@ -330,6 +427,18 @@ namespace uaf
         ss << indent << " - defaultSetMonitoringModeSettings\n";
         ss << defaultSetMonitoringModeSettings.toString(indent + "   ", colon) << "\n";
 
+        ss << indent << " - defaultDeleteMonitoredItemsSettings\n";
+        ss << defaultDeleteMonitoredItemsSettings.toString(indent + "   ", colon) << "\n";
+
+        ss << indent << " - defaultModifyMonitoredItemsSettings\n";
+        ss << defaultModifyMonitoredItemsSettings.toString(indent + "   ", colon) << "\n";
+
+        ss << indent << " - defaultRepublishSettings\n";
+        ss << defaultRepublishSettings.toString(indent + "   ", colon) << "\n";
+
+        ss << indent << " - defaultRegisterNodesSettings\n";
+        ss << defaultRegisterNodesSettings.toString(indent + "   ", colon) << "\n";
+
 
 
 
@@ -44,6 +44,7 @@
 #include "uaf/client/settings/historyreadrawmodifiedsettings.h"
 #include "uaf/client/settings/sessionsettings.h"
 #include "uaf/client/settings/subscriptionsettings.h"
+#include "uaf/client/settings/overflowpolicies.h"
 
 
 namespace uaf
@@ -79,6 +80,21 @@ namespace uaf
          *  - createSecurityLocationsIfNeeded : true
          *  - clientPrivateKey : "PKI/client/private/client.pem"
          *  - clientCertificate : "PKI/client/certs/client.der"
+         *  - shardSubscriptions : false
+         *  - shardBySamplingInterval : true
+         *  - maxMonitoredItemsPerSubscription : 1000
+         *  - notificationQueueCapacity : 0 (no queue)
+         *  - notificationQueueOverflowPolicy : uaf::overflowpolicies::Block
+         *  - notificationDeliveryThreads : 1
+         *  - republishMissingNotifications : true
+         *  - maxRepublishedMessages : 100
+         *  - failedResolutionCacheTimeSec : 10.0
+         *  - snapshotFileName : "" (no snapshot)
+         *  - snapshotIntervalSec : 60.0
+         *  - metricsIntervalSec : 0.0 (no periodic export)
+         *  - metricsFileName : "" (no file)
+         *  - traceRequests : false
+         *  - traceFileName : "" (no file)
          */
         ClientSettings();
 
@@ -219,6 +235,10 @@ namespace uaf
         uaf::WriteSettings                          defaultWriteSettings;
         uaf::ServiceSettings                        defaultSetPublishingModeSettings;
         uaf::ServiceSettings                        defaultSetMonitoringModeSettings;
+        uaf::ServiceSettings                        defaultDeleteMonitoredItemsSettings;
+        uaf::ServiceSettings                        defaultModifyMonitoredItemsSettings;
+        uaf::ServiceSettings                        defaultRepublishSettings;
+        uaf::ServiceSettings                        defaultRegisterNodesSettings;
 
         /**
          * The default session settings.
@@ -242,6 +262,171 @@ namespace uaf
          */
         uaf::SubscriptionSettings defaultSubscriptionSettings;
 
+
+        /////// Subscription sharding ///////
+
+
+        /** Spread the monitored items over multiple subscriptions ("shards") instead of putting
+         *  them all in one subscription.
+         *
+         *  Sharding only applies to synchronous CreateMonitoredData and CreateMonitoredEvents
+         *  requests that don't specify a clientSubscriptionHandle, and whose subscription settings
+         *  are not 'unique'. New monitored items are added to the least loaded shard that still
+         *  has room, and a new shard is created when all shards are full. Monitored items are
+         *  never moved to another shard afterwards, so their ClientHandles stay the same.
+         *
+         *  Default: false */
+        bool shardSubscriptions;
+
+        /** When sharding, group the monitored items by their sampling interval.
+         *
+         *  Monitored items with a sampling interval that is slower than the publishing interval
+         *  of the subscription settings, are put in shards that publish at that sampling interval
+         *  (so slow items don't cause needless Publish traffic).
+         *
+         *  Default: true */
+        bool shardBySamplingInterval;
+
+        /** When sharding, the maximum number of monitored items per subscription
+         *  (0 means unlimited).
+         *
+         *  Set this to a value below the limits of the servers you connect to.
+         *
+         *  Default: 1000 */
+        uint32_t maxMonitoredItemsPerSubscription;
+
+
+        /////// Notification queue ///////
+
+
+        /** The capacity of the queue between the SDK and the notification callbacks
+         *  (dataChangesReceived and eventsReceived), in number of notifications.
+         *
+         *  By default (0), the callbacks are called synchronously by the thread of the SDK that
+         *  processes the publish responses, so a slow callback delays the processing of the
+         *  publish responses. If the capacity is not 0, the notifications are queued instead, and
+         *  delivered to the callbacks by separate threads (see notificationDeliveryThreads).
+         *
+         *  Default: 0 */
+        uint32_t notificationQueueCapacity;
+
+        /** What to do with a new notification when the notification queue is full.
+         *
+         *  Default: uaf::overflowpolicies::Block */
+        uaf::overflowpolicies::OverflowPolicy notificationQueueOverflowPolicy;
+
+        /** The number of threads that deliver the queued notifications to the callbacks.
+         *
+         *  Only with a single thread, the notifications are guaranteed to be delivered in the
+         *  order in which they were received.
+         *
+         *  Default: 1 */
+        uint32_t notificationDeliveryThreads;
+
+
+        /////// Notification recovery ///////
+
+
+        /** Try to recover missing notifications (i.e. notifications of which the sequence numbers
+         *  were skipped, e.g. due to a network interruption) by calling the Republish service.
+         *
+         *  The notifications that the server still holds in its retransmission queue are
+         *  delivered in the order of their sequence numbers, before the notifications that came
+         *  after the gap. The notificationsMissing callback is only called for the sequence
+         *  numbers that could not be recovered. The Republish service is called by a separate
+         *  thread of the session, so the notifications after the gap are held back meanwhile.
+         *
+         *  Default: true */
+        bool republishMissingNotifications;
+
+        /** The maximum number of messages to republish per gap.
+         *
+         *  If more messages are missing, only the most recent ones are republished (the older ones
+         *  are unlikely to be still in the retransmission queue of the server).
+         *
+         *  Default: 100 */
+        uint32_t maxRepublishedMessages;
+
+
+        /////// Address resolution ///////
+
+
+        /** The time (in seconds) during which the addresses that were rejected by the server
+         *  (e.g. because a browse path has no match) are remembered.
+         *
+         *  During this time, the same addresses are not sent to the server again, but their
+         *  resolution immediately fails with the status that the server reported before.
+         *  The remembered failures of a server are forgotten as soon as its session has
+         *  connection problems. A value of 0.0 disables this "negative" cache.
+         *
+         *  Default: 10.0 */
+        double failedResolutionCacheTimeSec;
+
+
+        /////// Warm-start snapshot ///////
+
+
+        /** The name of the file to which the discovery results, the namespace arrays, the cached
+         *  addresses and the cached structure definitions are written, so that a new client can
+         *  start from them instead of rediscovering the system and re-resolving the addresses.
+         *
+         *  The file is loaded when the settings are applied, written periodically and written
+         *  again when the client is destroyed. The loaded entries are used right away, but
+         *  those of a server are discarded as soon as its session connects and reads a
+         *  NamespaceArray that differs from the one in the snapshot.
+         *  An empty string disables the snapshot.
+         *
+         *  Default: "" */
+        std::string snapshotFileName;
+
+        /** The time (in seconds) between two periodic writes of the snapshot file.
+         *
+         *  Default: 60.0 */
+        double snapshotIntervalSec;
+
+
+        /////// Metrics ///////
+
+
+        /** The time (in seconds) between two periodic exports of the metrics (see
+         *  Client::metrics()). The metrics are written to the metricsFileName (if any), and
+         *  passed to the Client::metricsReceived() callback.
+         *  A value of 0.0 disables the periodic export. The metrics are counted anyway, so they
+         *  can always be read by Client::metrics().
+         *
+         *  Default: 0.0 */
+        double metricsIntervalSec;
+
+        /** The name of the file to which the metrics are exported periodically, in the text
+         *  format of Prometheus (e.g. a file that is read by the textfile collector of the
+         *  Prometheus node exporter). The file is replaced at once, so readers never see a
+         *  partially written file.
+         *  An empty string means that the metrics are only passed to the callback.
+         *
+         *  Default: "" */
+        std::string metricsFileName;
+
+
+        /////// Tracing ///////
+
+
+        /** True to trace the requests: the time spent in each stage of the processing of a
+         *  request (resolving the addresses, acquiring and connecting a session, converting the
+         *  targets, calling the SDK, ...) is added to the "trace" of its result, and passed to
+         *  the trace file (see traceFileName) and to the sink of Client::setTraceSink().
+         *  As long as this is false, the stages are not even timed.
+         *
+         *  Default: false */
+        bool traceRequests;
+
+        /** The name of the file to which the traces are written, in the Trace Event format of
+         *  Chrome (which can be opened by chrome://tracing or by Perfetto). The file is
+         *  truncated when the setting is applied.
+         *  An empty string means that the traces are not written to a file.
+         *
+         *  Default: "" */
+        std::string traceFileName;
+
         /**
          * Create the security locations (directories).
          *
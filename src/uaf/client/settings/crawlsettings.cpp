@@ -0,0 +1,156 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/settings/crawlsettings.h"
+
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+
+
+
+    // Constructor
+    // =============================================================================================
+    CrawlSettings::CrawlSettings()
+    : browseDirection(uaf::browsedirections::Forward),
+      referenceTypeId(OpcUaId_HierarchicalReferences, 0),
+      includeSubtypes(true),
+      nodeClassMask(0),
+      maxTargetsPerRequest(100),
+      maxRequestsInFlight(4),
+      maxDepth(0),
+      maxNodes(0)
+    {
+        // the crawler should not have to deal with continuation points itself
+        browseSettings.maxAutoBrowseNext = 100;
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string CrawlSettings::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - browseDirection";
+        ss << fillToPos(ss, colon);
+        ss << ": " << browseDirection << " (" << browsedirections::toString(browseDirection) << ")\n";
+
+        ss << indent << " - referenceTypeId";
+        ss << fillToPos(ss, colon);
+        ss << ": " << referenceTypeId.toString() << "\n";
+
+        ss << indent << " - includeSubtypes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (includeSubtypes ? "true" : "false") << "\n";
+
+        ss << indent << " - nodeClassMask";
+        ss << fillToPos(ss, colon);
+        ss << ": " << nodeClassMask << "\n";
+
+        ss << indent << " - maxTargetsPerRequest";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxTargetsPerRequest << "\n";
+
+        ss << indent << " - maxRequestsInFlight";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxRequestsInFlight << "\n";
+
+        ss << indent << " - maxDepth";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxDepth << "\n";
+
+        ss << indent << " - maxNodes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxNodes << "\n";
+
+        ss << indent << " - browseSettings\n";
+        ss << browseSettings.toString(indent + "   ", colon);
+
+        return ss.str();
+    }
+
+
+    // operator==
+    // =============================================================================================
+    bool operator==(const CrawlSettings& object1, const CrawlSettings& object2)
+    {
+        return    object1.browseDirection == object2.browseDirection
+               && object1.referenceTypeId == object2.referenceTypeId
+               && object1.includeSubtypes == object2.includeSubtypes
+               && object1.nodeClassMask == object2.nodeClassMask
+               && object1.maxTargetsPerRequest == object2.maxTargetsPerRequest
+               && object1.maxRequestsInFlight == object2.maxRequestsInFlight
+               && object1.maxDepth == object2.maxDepth
+               && object1.maxNodes == object2.maxNodes
+               && object1.browseSettings == object2.browseSettings
+               && object1.browseSettings.maxAutoBrowseNext
+                       == object2.browseSettings.maxAutoBrowseNext
+               && object1.browseSettings.maxReferencesToReturn
+                       == object2.browseSettings.maxReferencesToReturn;
+    }
+
+
+    // operator!=
+    // =============================================================================================
+    bool operator!=(const CrawlSettings& object1, const CrawlSettings& object2)
+    {
+        return !(object1 == object2);
+    }
+
+
+    // operator<
+    // =============================================================================================
+    bool operator<(const CrawlSettings& object1, const CrawlSettings& object2)
+    {
+        if (object1.browseDirection != object2.browseDirection)
+            return object1.browseDirection < object2.browseDirection;
+        else if (object1.referenceTypeId != object2.referenceTypeId)
+            return object1.referenceTypeId < object2.referenceTypeId;
+        else if (object1.includeSubtypes != object2.includeSubtypes)
+            return object1.includeSubtypes < object2.includeSubtypes;
+        else if (object1.nodeClassMask != object2.nodeClassMask)
+            return object1.nodeClassMask < object2.nodeClassMask;
+        else if (object1.maxTargetsPerRequest != object2.maxTargetsPerRequest)
+            return object1.maxTargetsPerRequest < object2.maxTargetsPerRequest;
+        else if (object1.maxRequestsInFlight != object2.maxRequestsInFlight)
+            return object1.maxRequestsInFlight < object2.maxRequestsInFlight;
+        else if (object1.maxDepth != object2.maxDepth)
+            return object1.maxDepth < object2.maxDepth;
+        else if (object1.maxNodes != object2.maxNodes)
+            return object1.maxNodes < object2.maxNodes;
+        else if (object1.browseSettings.maxAutoBrowseNext
+                    != object2.browseSettings.maxAutoBrowseNext)
+            return object1.browseSettings.maxAutoBrowseNext
+                    < object2.browseSettings.maxAutoBrowseNext;
+        else if (object1.browseSettings.maxReferencesToReturn
+                    != object2.browseSettings.maxReferencesToReturn)
+            return object1.browseSettings.maxReferencesToReturn
+                    < object2.browseSettings.maxReferencesToReturn;
+        else
+            return object1.browseSettings < object2.browseSettings;
+    }
+
+}
@@ -0,0 +1,143 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CRAWLSETTINGS_H_
+#define UAF_CRAWLSETTINGS_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/nodeid.h"
+#include "uaf/util/browsedirections.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/settings/browsesettings.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::CrawlSettings object holds the settings of a breadth-first crawl through the address
+    * space of one or more servers (see uaf::Client::crawl).
+    *
+    * The crawler browses the nodes "level by level", starting from the given start nodes.
+    * The frontier of each level is split into batches of (at most) maxTargetsPerRequest nodes,
+    * and each batch is browsed by a single Browse request. Up to maxRequestsInFlight of these
+    * requests are processed at the same time.
+    *
+    * @ingroup ClientSettings
+    ***********************************************************************************************/
+    class UAF_EXPORT CrawlSettings
+    {
+    public:
+
+        /**
+         * Create default Crawl settings.
+         *
+         * Defaults are:
+         *  - browseDirection      : Forward
+         *  - referenceTypeId      : HierarchicalReferences (ns=0;i=33)
+         *  - includeSubtypes      : true
+         *  - nodeClassMask        : 0 (all node classes)
+         *  - maxTargetsPerRequest : 100
+         *  - maxRequestsInFlight  : 4
+         *  - maxDepth             : 0 (no limit)
+         *  - maxNodes             : 0 (no limit)
+         *  - browseSettings       : default BrowseSettings, but with maxAutoBrowseNext = 100
+         */
+        CrawlSettings();
+
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~CrawlSettings() {}
+
+
+        /** Direction of the references to follow (Forward by default). */
+        uaf::browsedirections::BrowseDirection browseDirection;
+
+        /** NodeId of the type of references to follow (or its subtypes if includeSubtypes is
+         *  true). By default, the HierarchicalReferences are followed. */
+        uaf::NodeId referenceTypeId;
+
+        /** Flag indicating that also the subtypes of the referenceTypeId should be followed. */
+        bool includeSubtypes;
+
+        /** A mask specifying the node classes that should be returned (and therefore crawled),
+         *  see uaf::BrowseRequestTarget::nodeClassMask. Leave 0 (=default) to crawl all node
+         *  classes. */
+        uint32_t nodeClassMask;
+
+        /** The maximum number of nodes that will be browsed by a single Browse request.
+         *  Should be at least 1. */
+        uint32_t maxTargetsPerRequest;
+
+        /** The maximum number of Browse requests that the crawler will process simultaneously.
+         *  Should be at least 1. */
+        uint32_t maxRequestsInFlight;
+
+        /** The maximum depth (i.e. number of references away from the start nodes) of the nodes
+         *  that will be browsed. The start nodes have depth 0. Default = 0, which means that
+         *  there is no limit. */
+        uint32_t maxDepth;
+
+        /** The maximum number of nodes that will be browsed. Default = 0, which means that there
+         *  is no limit. */
+        uint32_t maxNodes;
+
+        /** The settings of the Browse requests that are sent by the crawler. */
+        uaf::BrowseSettings browseSettings;
+
+
+        /**
+         * Get a string representation of the settings.
+         *
+         * @return  String representation
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=26) const;
+
+
+        // comparison operators
+        friend bool UAF_EXPORT operator==(
+                const CrawlSettings& object1,
+                const CrawlSettings& object2);
+        friend bool UAF_EXPORT operator!=(
+                const CrawlSettings& object1,
+                const CrawlSettings& object2);
+        friend bool UAF_EXPORT operator<(
+                const CrawlSettings& object1,
+                const CrawlSettings& object2);
+
+    };
+
+}
+
+
+
+#endif /* UAF_CRAWLSETTINGS_H_ */
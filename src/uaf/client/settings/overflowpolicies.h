@@ -0,0 +1,68 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_OVERFLOWPOLICIES_H_
+#define UAF_OVERFLOWPOLICIES_H_
+
+// STD
+#include <string>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+
+namespace uaf
+{
+
+
+    namespace overflowpolicies
+    {
+
+        /**
+         * What to do with a new notification when the notification queue of the client is full.
+         *
+         * @ingroup ClientSettings
+         */
+        enum OverflowPolicy
+        {
+            Block       = 0, /**< Wait until there's room in the queue (this blocks the thread of
+                                  the SDK that processes the publish responses). */
+            DropOldest  = 1, /**< Drop the oldest notification of the queue. */
+            Coalesce    = 2  /**< Replace the queued data change notification of the same
+                                  ClientHandle by the new one (so only the latest value is
+                                  kept), or drop the oldest notification if there is none. */
+        };
+
+
+        /**
+         * Get a string representation of the overflow policy.
+         *
+         * @param policy    The overflow policy (as an enum).
+         * @return          The corresponding name of the overflow policy.
+         *
+         * @ingroup ClientSettings
+         */
+        std::string UAF_EXPORT toString(uaf::overflowpolicies::OverflowPolicy policy);
+    }
+
+}
+
+
+#endif /* UAF_OVERFLOWPOLICIES_H_ */
@@ -0,0 +1,153 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/subscriptions/clienthandletable.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::vector;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    ClientHandleTable::ClientHandleTable()
+    : current_(0),
+      readers_(0)
+    {
+        assign(vector<ClientHandle>());
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    ClientHandleTable::~ClientHandleTable()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        delete static_cast<Snapshot*>(current_);
+        current_ = 0;
+
+        // nobody can be reading anymore
+        for (size_t i = 0; i < retired_.size(); i++)
+            delete retired_[i];
+        retired_.clear();
+    }
+
+
+    // Check if the table contains a handle
+    // =============================================================================================
+    bool ClientHandleTable::contains(ClientHandle clientHandle) const
+    {
+        bool ret = false;
+
+        // register as a reader before getting the snapshot, so it won't be deleted meanwhile
+        atomicIncrement(&readers_);
+
+        const Snapshot* snapshot = static_cast<const Snapshot*>(atomicGetPointer(&current_));
+
+        // linear probing: there's always an empty slot, so the loop ends
+        for (uint32_t i = clientHandle & snapshot->mask; ; i = (i + 1) & snapshot->mask)
+        {
+            if (snapshot->slots[i] == clientHandle)
+            {
+                ret = true;
+                break;
+            }
+            else if (snapshot->slots[i] == constants::CLIENTHANDLE_NOT_ASSIGNED)
+            {
+                break;
+            }
+        }
+
+        atomicDecrement(&readers_);
+
+        return ret;
+    }
+
+
+    // Get the number of handles
+    // =============================================================================================
+    size_t ClientHandleTable::size() const
+    {
+        atomicIncrement(&readers_);
+
+        size_t ret = static_cast<const Snapshot*>(atomicGetPointer(&current_))->size;
+
+        atomicDecrement(&readers_);
+
+        return ret;
+    }
+
+
+    // Replace the contents of the table
+    // =============================================================================================
+    void ClientHandleTable::assign(const vector<ClientHandle>& clientHandles)
+    {
+        // build the new snapshot
+        uint32_t noOfSlots = 8;
+        while (noOfSlots < 2 * clientHandles.size())
+            noOfSlots *= 2;
+
+        Snapshot* snapshot = new Snapshot;
+        snapshot->mask = noOfSlots - 1;
+        snapshot->slots.resize(noOfSlots, constants::CLIENTHANDLE_NOT_ASSIGNED);
+        snapshot->size = 0;
+
+        for (size_t i = 0; i < clientHandles.size(); i++)
+        {
+            uint32_t slot = clientHandles[i] & snapshot->mask;
+            while (   snapshot->slots[slot] != constants::CLIENTHANDLE_NOT_ASSIGNED
+                   && snapshot->slots[slot] != clientHandles[i])
+                slot = (slot + 1) & snapshot->mask;
+            if (snapshot->slots[slot] == constants::CLIENTHANDLE_NOT_ASSIGNED)
+                snapshot->size++;
+            snapshot->slots[slot] = clientHandles[i];
+        }
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        // publish the new snapshot
+        Snapshot* old = static_cast<Snapshot*>(atomicExchangePointer(&current_, snapshot));
+
+        if (old != 0)
+            retired_.push_back(old);
+
+        reclaim();
+    }
+
+
+    // Delete the retired snapshots
+    // =============================================================================================
+    void ClientHandleTable::reclaim()
+    {
+        // readers that register from now on will get the new snapshot, so if there are no readers
+        // right now, nobody can be reading a retired snapshot anymore.
+        // If there are readers, the retired snapshots are deleted at the next assign() instead.
+        if (atomicGet(&readers_) == 0)
+        {
+            for (size_t i = 0; i < retired_.size(); i++)
+                delete retired_[i];
+            retired_.clear();
+        }
+    }
+
+}
@@ -0,0 +1,137 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CLIENTHANDLETABLE_H_
+#define UAF_CLIENTHANDLETABLE_H_
+
+
+// STD
+#include <vector>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/handles.h"
+#include "uaf/util/atomics.h"
+#include "uaf/util/constants.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::ClientHandleTable holds the ClientHandles of the monitored items of a subscription,
+    * so that incoming notifications can be checked without locking.
+    *
+    * The table is read-mostly: contains() is called for every notification (by the thread of the
+    * SDK that delivers the notifications), while assign() is only called when monitored items are
+    * created or deleted. Therefore the handles are stored in an immutable snapshot (a small
+    * open-addressing array, indexed by the handle itself since ClientHandles are dense), and
+    * assign() publishes a new snapshot by swapping a pointer. Old snapshots are only deleted once
+    * no reader is active anymore.
+    *
+    * @ingroup ClientSubscriptions
+    ***********************************************************************************************/
+    class UAF_EXPORT ClientHandleTable
+    {
+    public:
+
+
+        /**
+         * Construct an empty table.
+         */
+        ClientHandleTable();
+
+
+        /**
+         * Destruct the table.
+         */
+        ~ClientHandleTable();
+
+
+        /**
+         * Check if the table contains the given ClientHandle.
+         *
+         * This function doesn't lock, and can safely be called while assign() is being called by
+         * another thread.
+         *
+         * @param clientHandle  The handle to look up.
+         * @return              True if the handle is in the table.
+         */
+        bool contains(uaf::ClientHandle clientHandle) const;
+
+
+        /**
+         * Get the number of handles in the table.
+         *
+         * This function doesn't lock either.
+         *
+         * @return  The number of handles.
+         */
+        std::size_t size() const;
+
+
+        /**
+         * Replace the contents of the table.
+         *
+         * @param clientHandles The new handles of the table.
+         */
+        void assign(const std::vector<uaf::ClientHandle>& clientHandles);
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(ClientHandleTable);
+
+
+        // an immutable version of the table
+        struct Snapshot
+        {
+            // the handles (or CLIENTHANDLE_NOT_ASSIGNED for an empty slot), the number of slots
+            // is a power of two and at least twice the number of handles
+            std::vector<uaf::ClientHandle> slots;
+            // the number of slots - 1
+            uint32_t mask;
+            // the number of handles
+            std::size_t size;
+        };
+
+
+        // delete the retired snapshots (the mutex_ must be locked)
+        void reclaim();
+
+
+        // the current snapshot
+        mutable void* volatile          current_;
+        // the number of threads that are currently reading a snapshot
+        mutable uaf::AtomicCount        readers_;
+        // the snapshots that were replaced but may still be read
+        std::vector<Snapshot*>          retired_;
+        // the mutex to serialize the writers
+        UaMutex                         mutex_;
+    };
+
+}
+
+
+#endif /* UAF_CLIENTHANDLETABLE_H_ */
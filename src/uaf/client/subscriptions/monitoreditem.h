@@ -73,6 +73,61 @@ namespace uaf
         /** The revised queue size on the server side. */
         uint32_t revisedQueueSize;
     };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::MonitoredItemSettingsApplier applies (modified) monitored item settings to the
+    * targets of the persistent request that created the monitored items.
+    *
+    * It's meant to be passed as the modifier of uaf::RequestStore::modifyTargets(). If the filter
+    * of the settings is NULL, the filter of the targets is kept.
+    *
+    * @ingroup ClientSubscriptions
+    ***********************************************************************************************/
+    class UAF_EXPORT MonitoredItemSettingsApplier
+    {
+    public:
+
+        /**
+         * Construct an applier of the given settings (which are not copied!).
+         *
+         * @param settings  The settings to apply.
+         */
+        MonitoredItemSettingsApplier(const uaf::MonitoredItemSettings& settings)
+        : settings_(settings)
+        {}
+
+
+        /**
+         * Apply the settings to a target of a CreateMonitoredData request.
+         */
+        void operator()(uaf::CreateMonitoredDataRequestTarget& target) const
+        {
+            target.samplingIntervalSec  = settings_.samplingIntervalSec;
+            target.queueSize            = settings_.queueSize;
+            target.discardOldest        = settings_.discardOldest;
+            if (settings_.dataChangeFilter != NULL)
+                target.dataChangeFilter = *settings_.dataChangeFilter;
+        }
+
+
+        /**
+         * Apply the settings to a target of a CreateMonitoredEvents request.
+         */
+        void operator()(uaf::CreateMonitoredEventsRequestTarget& target) const
+        {
+            target.samplingIntervalSec  = settings_.samplingIntervalSec;
+            target.queueSize            = settings_.queueSize;
+            target.discardOldest        = settings_.discardOldest;
+            if (settings_.eventFilter != NULL)
+                target.eventFilter = *settings_.eventFilter;
+        }
+
+    private:
+        // the settings to apply
+        const uaf::MonitoredItemSettings& settings_;
+    };
 }
 
 
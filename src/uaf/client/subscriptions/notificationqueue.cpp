@@ -0,0 +1,412 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/subscriptions/notificationqueue.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::vector;
+    using std::map;
+    using std::size_t;
+
+
+    namespace
+    {
+        // the maximum number of notifications that are delivered by a single callback
+        const size_t MAX_BATCH_SIZE = 1024;
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    NotificationQueue::NotificationQueue(
+            LoggerFactory*      loggerFactory,
+            ClientInterface*    clientInterface)
+    : clientInterface_(clientInterface),
+      head_(0),
+      tail_(0),
+      policy_(overflowpolicies::Block),
+      noOfThreads_(0),
+      running_(false),
+      waitingProducers_(0)
+    {
+        logger_ = new Logger(loggerFactory, "NotificationQueue");
+        logger_->debug("The notification queue has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    NotificationQueue::~NotificationQueue()
+    {
+        logger_->debug("Destructing the notification queue");
+
+        {
+            UaMutexLocker locker(&configMutex_); // unlocks when locker goes out of scope
+            stop();
+        }
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Change the configuration
+    // =============================================================================================
+    void NotificationQueue::configure(
+            uint32_t                            capacity,
+            overflowpolicies::OverflowPolicy    policy,
+            uint32_t                            noOfThreads)
+    {
+        UaMutexLocker locker(&configMutex_); // unlocks when locker goes out of scope
+
+        mutex_.lock();
+        bool changed =     capacity     != ring_.size()
+                       ||  policy       != policy_
+                       ||  noOfThreads  != noOfThreads_;
+        mutex_.unlock();
+
+        if (changed)
+        {
+            logger_->debug("Configuring the notification queue (capacity %d, policy %s, %d threads)",
+                           capacity, overflowpolicies::toString(policy).c_str(), noOfThreads);
+
+            // deliver the queued notifications first
+            stop();
+
+            mutex_.lock();
+            vector<Entry>(capacity).swap(ring_);
+            head_ = 0;
+            tail_ = 0;
+            lastDataChange_.clear();
+            policy_ = policy;
+            noOfThreads_ = noOfThreads;
+            running_ = (capacity > 0);
+            statistics_.capacity = capacity;
+            mutex_.unlock();
+
+            if (capacity > 0)
+            {
+                for (uint32_t i = 0; i < noOfThreads || i == 0; i++)
+                {
+                    Worker* worker = new Worker(this);
+                    workers_.push_back(worker);
+                    worker->startWorking();
+                }
+            }
+        }
+    }
+
+
+    // Stop the delivery threads
+    // =============================================================================================
+    void NotificationQueue::stop()
+    {
+        mutex_.lock();
+        running_ = false;
+        if (waitingProducers_ > 0)
+        {
+            roomSemaphore_.post(waitingProducers_);
+            waitingProducers_ = 0;
+        }
+        mutex_.unlock();
+
+        if (!workers_.empty())
+            availableSemaphore_.post(workers_.size());
+
+        for (vector<Worker*>::iterator it = workers_.begin(); it != workers_.end(); ++it)
+        {
+            (*it)->waitUntilFinished();
+            delete *it;
+        }
+        workers_.clear();
+    }
+
+
+    // Queue data change notifications
+    // =============================================================================================
+    void NotificationQueue::push(const ConstSpan<DataChangeNotification>& notifications)
+    {
+        size_t queued = 0;
+
+        // true if notifications were queued that the delivery threads weren't told about yet
+        bool unsignalled = false;
+
+        mutex_.lock();
+
+        bool queueing = running_;
+
+        while (queueing && queued < notifications.size())
+        {
+            const DataChangeNotification& notification = notifications[queued];
+            bool stored = false;
+
+            if (tail_ - head_ == ring_.size())
+            {
+                if (policy_ == overflowpolicies::Coalesce)
+                    stored = coalesce(notification);
+
+                if (!stored)
+                    queueing = makeRoom(unsignalled);
+            }
+
+            if (queueing && !stored)
+            {
+                Entry& entry = append();
+                entry.isEvent    = false;
+                entry.dataChange = notification;
+                unsignalled = true;
+
+                if (policy_ == overflowpolicies::Coalesce)
+                    lastDataChange_[notification.clientHandle] = tail_ - 1;
+            }
+
+            if (queueing)
+                queued++;
+        }
+
+        mutex_.unlock();
+
+        if (unsignalled)
+            availableSemaphore_.post(1);
+
+        // deliver the notifications that were not queued (because there is no queue, or because
+        // the queue was stopped meanwhile)
+        if (queued < notifications.size())
+            clientInterface_->dataChangesReceived(
+                    vector<DataChangeNotification>(notifications.begin() + queued,
+                                                   notifications.end()));
+    }
+
+
+    // Queue event notifications
+    // =============================================================================================
+    void NotificationQueue::push(const ConstSpan<EventNotification>& notifications)
+    {
+        size_t queued = 0;
+
+        // true if notifications were queued that the delivery threads weren't told about yet
+        bool unsignalled = false;
+
+        mutex_.lock();
+
+        bool queueing = running_;
+
+        while (queueing && queued < notifications.size())
+        {
+            // events are never coalesced, since each event is relevant
+            if (tail_ - head_ == ring_.size())
+                queueing = makeRoom(unsignalled);
+
+            if (queueing)
+            {
+                Entry& entry = append();
+                entry.isEvent = true;
+                entry.event   = notifications[queued];
+                unsignalled = true;
+                queued++;
+            }
+        }
+
+        mutex_.unlock();
+
+        if (unsignalled)
+            availableSemaphore_.post(1);
+
+        // deliver the notifications that were not queued (because there is no queue, or because
+        // the queue was stopped meanwhile)
+        if (queued < notifications.size())
+            clientInterface_->eventsReceived(
+                    vector<EventNotification>(notifications.begin() + queued,
+                                              notifications.end()));
+    }
+
+
+    // Make room for a new notification
+    // =============================================================================================
+    bool NotificationQueue::makeRoom(bool& unsignalled)
+    {
+        bool ret = true;
+
+        if (policy_ == overflowpolicies::Block)
+        {
+            statistics_.blocked++;
+
+            // wake up a delivery thread before blocking, otherwise the notifications that this
+            // producer has just queued (and that fill the queue) would never be delivered
+            if (unsignalled)
+            {
+                availableSemaphore_.post(1);
+                unsignalled = false;
+            }
+
+            while (running_ && tail_ - head_ == ring_.size())
+            {
+                waitingProducers_++;
+                mutex_.unlock();
+                roomSemaphore_.wait();
+                mutex_.lock();
+            }
+
+            ret = running_;
+        }
+        else
+        {
+            Entry& dropped = removeOldest();
+            dropped.event.fields.clear();
+            statistics_.dropped++;
+        }
+
+        return ret;
+    }
+
+
+    // Replace the queued data change notification with the same ClientHandle
+    // =============================================================================================
+    bool NotificationQueue::coalesce(const DataChangeNotification& notification)
+    {
+        bool ret = false;
+
+        map<ClientHandle, uint64_t>::const_iterator it
+            = lastDataChange_.find(notification.clientHandle);
+
+        if (it != lastDataChange_.end() && it->second >= head_)
+        {
+            ring_[it->second % ring_.size()].dataChange = notification;
+            statistics_.coalesced++;
+            ret = true;
+        }
+
+        return ret;
+    }
+
+
+    // Get the slot for the next notification
+    // =============================================================================================
+    NotificationQueue::Entry& NotificationQueue::append()
+    {
+        Entry& entry = ring_[tail_ % ring_.size()];
+        tail_++;
+
+        statistics_.enqueued++;
+        if (tail_ - head_ > statistics_.maxQueueDepth)
+            statistics_.maxQueueDepth = uint32_t(tail_ - head_);
+
+        return entry;
+    }
+
+
+    // Remove the oldest notification from the bookkeeping
+    // =============================================================================================
+    NotificationQueue::Entry& NotificationQueue::removeOldest()
+    {
+        Entry& entry = ring_[head_ % ring_.size()];
+
+        if (!entry.isEvent && policy_ == overflowpolicies::Coalesce)
+        {
+            map<ClientHandle, uint64_t>::iterator it
+                = lastDataChange_.find(entry.dataChange.clientHandle);
+            if (it != lastDataChange_.end() && it->second == head_)
+                lastDataChange_.erase(it);
+        }
+
+        head_++;
+
+        return entry;
+    }
+
+
+    // Deliver notifications (executed by the delivery threads)
+    // =============================================================================================
+    void NotificationQueue::work()
+    {
+        bool finished = false;
+
+        while (!finished)
+        {
+            availableSemaphore_.wait();
+
+            mutex_.lock();
+
+            while (tail_ > head_)
+            {
+                // take a batch of consecutive notifications of the same kind
+                bool isEvent = ring_[head_ % ring_.size()].isEvent;
+                vector<DataChangeNotification> dataChanges;
+                vector<EventNotification> events;
+
+                while (   tail_ > head_
+                       && ring_[head_ % ring_.size()].isEvent == isEvent
+                       && dataChanges.size() + events.size() < MAX_BATCH_SIZE)
+                {
+                    Entry& entry = removeOldest();
+                    if (isEvent)
+                    {
+                        events.push_back(entry.event);
+                        entry.event.fields.clear();
+                    }
+                    else
+                    {
+                        dataChanges.push_back(entry.dataChange);
+                    }
+                }
+
+                // the producers that wait for room may continue now
+                if (waitingProducers_ > 0)
+                {
+                    roomSemaphore_.post(waitingProducers_);
+                    waitingProducers_ = 0;
+                }
+
+                mutex_.unlock();
+
+                // call the callback interface without holding the lock
+                if (isEvent)
+                    clientInterface_->eventsReceived(events);
+                else
+                    clientInterface_->dataChangesReceived(dataChanges);
+
+                mutex_.lock();
+                statistics_.delivered += dataChanges.size() + events.size();
+            }
+
+            // the threads only finish when all queued notifications have been delivered
+            finished = !running_;
+
+            mutex_.unlock();
+        }
+    }
+
+
+    // Get the statistics
+    // =============================================================================================
+    NotificationQueueStatistics NotificationQueue::statistics()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        NotificationQueueStatistics ret(statistics_);
+        ret.queueDepth = uint32_t(tail_ - head_);
+        return ret;
+    }
+
+}
@@ -0,0 +1,255 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_NOTIFICATIONQUEUE_H_
+#define UAF_NOTIFICATIONQUEUE_H_
+
+
+
+// STD
+#include <vector>
+#include <map>
+// SDK
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/handles.h"
+#include "uaf/util/constspan.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/clientinterface.h"
+#include "uaf/client/settings/overflowpolicies.h"
+#include "uaf/client/subscriptions/datachangenotification.h"
+#include "uaf/client/subscriptions/eventnotification.h"
+#include "uaf/client/subscriptions/notificationqueuestatistics.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::NotificationQueue decouples the threads of the SDK that process the publish responses
+    * from the notification callbacks of the uaf::ClientInterface.
+    *
+    * The notifications are stored in a ring buffer with a fixed capacity, and delivered to
+    * dataChangesReceived(std::vector) and eventsReceived(std::vector) by a pool of delivery
+    * threads. Consecutive notifications of the same kind are delivered in batches. When the queue
+    * is full, the uaf::overflowpolicies::OverflowPolicy decides what happens.
+    *
+    * As long as the capacity is 0 (the default), there is no queue and no thread: the
+    * notifications are delivered synchronously by the thread that pushes them.
+    *
+    * @ingroup ClientSubscriptions
+    ***********************************************************************************************/
+    class UAF_EXPORT NotificationQueue
+    {
+    public:
+
+
+        /**
+         * Construct a notification queue without capacity (so without delivery threads).
+         *
+         * @param loggerFactory     Logger factory to log all messages to.
+         * @param clientInterface   Interface to deliver the notifications to.
+         */
+        NotificationQueue(
+                uaf::LoggerFactory*     loggerFactory,
+                uaf::ClientInterface*   clientInterface);
+
+
+        /**
+         * Destruct the queue, after delivering the queued notifications.
+         */
+        ~NotificationQueue();
+
+
+        /**
+         * Change the configuration of the queue.
+         *
+         * If the configuration is different from the current one, the delivery threads are
+         * stopped (after delivering the queued notifications) and restarted.
+         *
+         * @param capacity      The number of notifications that can be queued (0 for no queue).
+         * @param policy        What to do with a new notification when the queue is full.
+         * @param noOfThreads   The number of delivery threads (at least one is started).
+         */
+        void configure(
+                uint32_t                                capacity,
+                uaf::overflowpolicies::OverflowPolicy   policy,
+                uint32_t                                noOfThreads);
+
+
+        /**
+         * Queue data change notifications (or deliver them immediately if there is no queue).
+         *
+         * @param notifications The notifications (which are copied).
+         */
+        void push(const uaf::ConstSpan<uaf::DataChangeNotification>& notifications);
+
+
+        /**
+         * Queue event notifications (or deliver them immediately if there is no queue).
+         *
+         * @param notifications The notifications (which are copied).
+         */
+        void push(const uaf::ConstSpan<uaf::EventNotification>& notifications);
+
+
+        /**
+         * Get the statistics of the queue.
+         *
+         * @return  The current depth, the drop counts, etc.
+         */
+        uaf::NotificationQueueStatistics statistics();
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(NotificationQueue);
+
+
+        // the workers may call work()
+        class Worker;
+        friend class Worker;
+
+
+        /**
+         * A slot of the ring buffer.
+         */
+        struct Entry
+        {
+            Entry() : isEvent(false) {}
+            /** True if the slot holds an event notification, false for a data change. */
+            bool isEvent;
+            /** The data change notification (if isEvent is false). */
+            uaf::DataChangeNotification dataChange;
+            /** The event notification (if isEvent is true). */
+            uaf::EventNotification event;
+        };
+
+
+        /**
+         * A delivery thread, delivering notifications until the queue is stopped.
+         */
+        class Worker : private UaThread
+        {
+        public:
+            Worker(uaf::NotificationQueue* queue) : queue_(queue) {}
+            void startWorking() { start(); }
+            void waitUntilFinished() { wait(); }
+        private:
+            DISALLOW_COPY_AND_ASSIGN(Worker);
+            void run() { queue_->work(); }
+            uaf::NotificationQueue* queue_;
+        };
+
+
+        /**
+         * The loop of the delivery threads.
+         */
+        void work();
+
+
+        /**
+         * Stop the delivery threads, after they delivered the queued notifications.
+         * The configMutex_ must be locked.
+         */
+        void stop();
+
+
+        /**
+         * Make room for a new notification, by dropping the oldest one or by waiting.
+         * The mutex_ must be locked (it's unlocked while waiting).
+         *
+         * @param unsignalled   True if the caller queued notifications without waking up a
+         *                      delivery thread yet. Before waiting, a delivery thread is woken
+         *                      up and the flag is reset.
+         * @return              False if the queue was stopped while waiting.
+         */
+        bool makeRoom(bool& unsignalled);
+
+
+        /**
+         * Replace the queued data change notification with the same ClientHandle.
+         * The mutex_ must be locked.
+         *
+         * @return  False if there is no queued data change notification with the same handle.
+         */
+        bool coalesce(const uaf::DataChangeNotification& notification);
+
+
+        /**
+         * Get the slot for the next notification, and update the bookkeeping.
+         * The mutex_ must be locked, and the queue must not be full.
+         */
+        Entry& append();
+
+
+        /**
+         * Remove the oldest notification from the bookkeeping (not from its slot).
+         * The mutex_ must be locked, and the queue must not be empty.
+         */
+        Entry& removeOldest();
+
+
+        // the logger
+        uaf::Logger*                            logger_;
+        // the interface to deliver the notifications to
+        uaf::ClientInterface*                   clientInterface_;
+        // the delivery threads (protected by configMutex_)
+        std::vector<Worker*>                    workers_;
+        // the ring buffer (protected by mutex_)
+        std::vector<Entry>                      ring_;
+        // the sequence number of the oldest and the next notification (protected by mutex_),
+        // the slot of a notification is its sequence number modulo the capacity
+        uint64_t                                head_;
+        uint64_t                                tail_;
+        // the sequence number of the last queued data change per ClientHandle, only kept for the
+        // Coalesce policy (protected by mutex_)
+        std::map<uaf::ClientHandle, uint64_t>   lastDataChange_;
+        // the current configuration (protected by mutex_)
+        uaf::overflowpolicies::OverflowPolicy   policy_;
+        uint32_t                                noOfThreads_;
+        // true if the delivery threads are running (protected by mutex_)
+        bool                                    running_;
+        // the number of producers that are waiting for room (protected by mutex_)
+        uint32_t                                waitingProducers_;
+        // the statistics (protected by mutex_)
+        uaf::NotificationQueueStatistics        statistics_;
+        // the mutex to protect the queue
+        UaMutex                                 mutex_;
+        // the mutex to serialize configure() and the destructor
+        UaMutex                                 configMutex_;
+        // posted whenever notifications are queued (or when the workers should stop)
+        UaSemaphore                             availableSemaphore_;
+        // posted whenever room is made for waiting producers
+        UaSemaphore                             roomSemaphore_;
+    };
+
+}
+
+
+
+#endif /* UAF_NOTIFICATIONQUEUE_H_ */
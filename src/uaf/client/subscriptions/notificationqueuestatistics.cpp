@@ -0,0 +1,87 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/subscriptions/notificationqueuestatistics.h"
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+
+
+    // Constructor
+    // =============================================================================================
+    NotificationQueueStatistics::NotificationQueueStatistics()
+    : capacity(0),
+      queueDepth(0),
+      maxQueueDepth(0),
+      enqueued(0),
+      delivered(0),
+      dropped(0),
+      coalesced(0),
+      blocked(0)
+    {}
+
+
+    // Get a string representation
+    // =============================================================================================
+    string NotificationQueueStatistics::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - capacity";
+        ss << fillToPos(ss, colon);
+        ss << ": " << capacity << "\n";
+
+        ss << indent << " - queueDepth";
+        ss << fillToPos(ss, colon);
+        ss << ": " << queueDepth << "\n";
+
+        ss << indent << " - maxQueueDepth";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxQueueDepth << "\n";
+
+        ss << indent << " - enqueued";
+        ss << fillToPos(ss, colon);
+        ss << ": " << enqueued << "\n";
+
+        ss << indent << " - delivered";
+        ss << fillToPos(ss, colon);
+        ss << ": " << delivered << "\n";
+
+        ss << indent << " - dropped";
+        ss << fillToPos(ss, colon);
+        ss << ": " << dropped << "\n";
+
+        ss << indent << " - coalesced";
+        ss << fillToPos(ss, colon);
+        ss << ": " << coalesced << "\n";
+
+        ss << indent << " - blocked";
+        ss << fillToPos(ss, colon);
+        ss << ": " << blocked;
+
+        return ss.str();
+    }
+
+}
@@ -0,0 +1,100 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_NOTIFICATIONQUEUESTATISTICS_H_
+#define UAF_NOTIFICATIONQUEUESTATISTICS_H_
+
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::NotificationQueueStatistics object reports the state of the notification queue of the
+    * client (see uaf::Client::notificationQueueStatistics and
+    * uaf::ClientSettings::notificationQueueCapacity).
+    *
+    * The counters are counted since the client was created.
+    *
+    * @ingroup ClientSubscriptions
+    ***********************************************************************************************/
+    class UAF_EXPORT NotificationQueueStatistics
+    {
+    public:
+
+
+        /**
+         * Create empty statistics.
+         */
+        NotificationQueueStatistics();
+
+
+        /** The capacity of the queue (0 if there is no queue). */
+        uint32_t capacity;
+
+        /** The number of notifications that are currently queued. */
+        uint32_t queueDepth;
+
+        /** The highest number of notifications that were queued at the same time. */
+        uint32_t maxQueueDepth;
+
+        /** The number of notifications that were added to the queue. */
+        uint64_t enqueued;
+
+        /** The number of notifications that were delivered to the callbacks. */
+        uint64_t delivered;
+
+        /** The number of queued notifications that were dropped because the queue was full. */
+        uint64_t dropped;
+
+        /** The number of queued data change notifications that were replaced by a newer one of
+         *  the same ClientHandle, because the queue was full. */
+        uint64_t coalesced;
+
+        /** The number of times a new notification had to wait because the queue was full. */
+        uint64_t blocked;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=20) const;
+
+    };
+
+}
+
+
+
+#endif /* UAF_NOTIFICATIONQUEUESTATISTICS_H_ */
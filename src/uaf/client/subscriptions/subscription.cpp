@@ -28,6 +28,21 @@ namespace uaf
     using std::vector;
     using std::map;
     using std::size_t;
+    using std::pair;
+
+
+    namespace
+    {
+        // Advance a publish sequence number (they wrap around from 0xFFFFFFFF to 1, since 0 is
+        // never used as a sequence number)
+        uint32_t advanceSequenceNumber(uint32_t sequenceNumber, uint32_t steps)
+        {
+            uint64_t advanced = uint64_t(sequenceNumber) + steps;
+            if (advanced > OpcUa_UInt32_Max)
+                advanced -= OpcUa_UInt32_Max;
+            return uint32_t(advanced);
+        }
+    }
 
 
     // Constructor
@@ -37,7 +52,7 @@ namespace uaf
             const SubscriptionSettings&             subscriptionSettings,
             ClientSubscriptionHandle                clientSubscriptionHandle,
             ClientConnectionId                      clientConnectionId,
-            UaClientSdk::UaSession*                 uaSession,
+            uaf::SessionTransport*                  uaSession,
             UaClientSdk::UaSubscriptionCallback*    uaSubscriptionCallback,
             uaf::ClientInterface*                  clientInterface,
             Database*                               database)
@@ -48,7 +63,8 @@ namespace uaf
       clientConnectionId_(clientConnectionId),
       database_(database),
       clientInterface_(clientInterface),
-      clientHandle_(0)
+      clientHandle_(0),
+      holding_(false)
     {
         // build the logger name:
         stringstream loggerName;
@@ -155,6 +171,8 @@ namespace uaf
             ret = SessionNotConnectedError();
         }
 
+        UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+
         // now update the persistent requests
         MonitoredItemsMap::iterator it = monitoredItemsMap_.begin();
         while (it != monitoredItemsMap_.end())
@@ -163,8 +181,9 @@ namespace uaf
             if (it->second.settings.kind() == MonitoredItemSettings::Data)
             {
                 if (deletePersistentRequest)
-                    database_->createMonitoredDataRequestStore.remove(
-                            it->second.requestHandle);
+                    database_->createMonitoredDataRequestStore.removeTarget(
+                            it->second.requestHandle,
+                            it->second.targetRank);
                 else
                     database_->createMonitoredDataRequestStore.updateTargetStatus(
                             it->second.requestHandle,
@@ -174,8 +193,9 @@ namespace uaf
             else
             {
                 if (deletePersistentRequest)
-                    database_->createMonitoredEventsRequestStore.remove(
-                            it->second.requestHandle);
+                    database_->createMonitoredEventsRequestStore.removeTarget(
+                            it->second.requestHandle,
+                            it->second.targetRank);
                 else
                     database_->createMonitoredEventsRequestStore.updateTargetStatus(
                             it->second.requestHandle,
@@ -183,10 +203,16 @@ namespace uaf
                             SubscriptionHasBeenDeletedError());
             }
 
+            // the monitored item won't be re-created anymore, so its handle may be reused
+            if (deletePersistentRequest)
+                database_->releaseClientHandle(it->first);
+
             // remove the monitoredItemsMap_ entry
             monitoredItemsMap_.erase(it++);
         }
 
+        updateHandleTable();
+
         // log the result
         if (ret.isGood())
         {
@@ -322,6 +348,337 @@ namespace uaf
 
 
 
+    // Delete the monitored items with the given client handles.
+    // =============================================================================================
+    Status Subscription::deleteMonitoredItemsIfNeeded(
+            const vector<ClientHandle>& clientHandles,
+            const ServiceSettings&      serviceSettings,
+            vector<Status>&             results)
+    {
+        logger_->debug("Deleting monitored items");
+
+        Status ret;
+
+        UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+
+        // Create an array of affected MonitoredItemIds, and their rank number (in the same way
+        // as setMonitoringModeIfNeeded does). A ClientHandle that is given more than once is only
+        // deleted once, the result of its first rank is copied to the others afterwards.
+        uint32_t maxSize = clientHandles.size();
+        uint32_t realSize = 0; // to be updated
+        UaUInt32Array ranks;
+        UaUInt32Array ids;
+        ranks.resize(maxSize);
+        ids.resize(maxSize);
+        MonitoredItemsMap::const_iterator it;
+        vector<ClientHandle> handlesToDelete;
+        map<ClientHandle, uint32_t> firstRanks;
+        vector< pair<uint32_t, uint32_t> > duplicateRanks; // (rank, first rank) pairs
+        for (uint32_t i = 0; i < maxSize; i++)
+        {
+            it = monitoredItemsMap_.find(clientHandles[i]);
+
+            if (it != monitoredItemsMap_.end())
+            {
+                map<ClientHandle, uint32_t>::const_iterator first
+                    = firstRanks.find(clientHandles[i]);
+
+                if (first != firstRanks.end())
+                {
+                    duplicateRanks.push_back(pair<uint32_t, uint32_t>(i, first->second));
+                    continue;
+                }
+
+                firstRanks[clientHandles[i]] = i;
+
+                realSize++;
+
+                ranks[realSize-1] = i;
+                ids[realSize-1]   = it->second.monitoredItemId;
+
+                handlesToDelete.push_back(clientHandles[i]);
+            }
+        }
+
+        if (realSize > 0)
+        {
+            logger_->debug("The following client handles were found: [%s]",
+                           uaf::uint32ArrayToString(handlesToDelete).c_str());
+
+            // don't forget to resize the ranks and ids now to their real size:
+            ranks.resize(realSize);
+            ids.resize(realSize);
+
+            // now invoke the service
+            UaClientSdk::ServiceSettings uaServiceSettings;
+            serviceSettings.toSdk(uaServiceSettings);
+            UaStatusCodeArray uaStatusCodes;
+
+            SdkStatus sdkStatus = uaSubscription_->deleteMonitoredItems(
+                    uaServiceSettings,
+                    ids,
+                    uaStatusCodes);
+
+            if (sdkStatus.isNotGood())
+                ret = DeleteMonitoredItemsInvocationError(sdkStatus);
+            else if (uaStatusCodes.length() != realSize)
+                ret = UnexpectedError("Mismatch between number of results and number of "
+                                      "monitored items to delete");
+            else
+                ret = statuscodes::Good;
+
+            logger_->debug("Result of OPC UA service call: %s", ret.toString().c_str());
+
+            if (ret.isGood())
+            {
+                for (uint32_t i = 0; i < realSize; i++)
+                {
+                    ClientHandle clientHandle = clientHandles[ranks[i]];
+
+                    // if the server doesn't know the monitored item (anymore), it's deleted too
+                    if (OpcUa_IsGood(uaStatusCodes[i])
+                            || uaStatusCodes[i] == OpcUa_BadMonitoredItemIdInvalid)
+                    {
+                        MonitoredItemsMap::iterator deleted = monitoredItemsMap_.find(clientHandle);
+
+                        // make sure the monitored item won't be re-created anymore
+                        if (deleted->second.settings.kind() == MonitoredItemSettings::Data)
+                            database_->createMonitoredDataRequestStore.removeTarget(
+                                    deleted->second.requestHandle,
+                                    deleted->second.targetRank);
+                        else
+                            database_->createMonitoredEventsRequestStore.removeTarget(
+                                    deleted->second.requestHandle,
+                                    deleted->second.targetRank);
+
+                        database_->releaseClientHandle(clientHandle);
+
+                        monitoredItemsMap_.erase(deleted);
+
+                        results[ranks[i]] = statuscodes::Good;
+                    }
+                    else
+                    {
+                        results[ranks[i]] = ServerCouldNotDeleteMonitoredItemError(
+                                clientHandle,
+                                SdkStatus(uaStatusCodes[i]));
+                    }
+                }
+
+                // the duplicate ClientHandles get the result of their first occurrence
+                for (vector< pair<uint32_t, uint32_t> >::const_iterator dup
+                        = duplicateRanks.begin(); dup != duplicateRanks.end(); ++dup)
+                    results[dup->first] = results[dup->second];
+
+                // notifications of the deleted monitored items are ignored from now on
+                updateHandleTable();
+            }
+        }
+        else
+        {
+            logger_->debug("The client handles do not belong to this subscription, skipping");
+            // ret remains Uncertain
+        }
+
+        return ret;
+    }
+
+
+    // Modify the monitored items with the given client handles.
+    // =============================================================================================
+    Status Subscription::modifyMonitoredItemsIfNeeded(
+            const vector<ClientHandle>&     clientHandles,
+            const MonitoredItemSettings&    settings,
+            const ServiceSettings&          serviceSettings,
+            const NamespaceArray&           nameSpaceArray,
+            vector<Status>&                 results)
+    {
+        logger_->debug("Modifying monitored items");
+
+        Status ret;
+
+        UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+
+        // find the affected monitored items (and their rank number), and check if the settings
+        // are of the right kind
+        vector<uint32_t> ranks;
+        vector<MonitoredItemsMap::iterator> items;
+        vector<ClientHandle> handlesToModify;
+        for (uint32_t i = 0; i < clientHandles.size(); i++)
+        {
+            MonitoredItemsMap::iterator it = monitoredItemsMap_.find(clientHandles[i]);
+
+            if (it == monitoredItemsMap_.end())
+            {
+                // the client handle doesn't belong to this subscription
+            }
+            else if (it->second.settings.kind() != settings.kind())
+            {
+                results[i] = WrongTypeError(uaf::format(
+                        "Monitored item %d cannot be modified by settings of another kind "
+                        "(data versus event)", clientHandles[i]));
+            }
+            else
+            {
+                ranks.push_back(i);
+                items.push_back(it);
+                handlesToModify.push_back(clientHandles[i]);
+            }
+        }
+
+        uint32_t realSize = items.size();
+
+        if (realSize > 0)
+        {
+            logger_->debug("The following client handles were found: [%s]",
+                           uaf::uint32ArrayToString(handlesToModify).c_str());
+
+            ret = statuscodes::Good;
+
+            // create the modify requests
+            UaMonitoredItemModifyRequests uaModifyRequests;
+            uaModifyRequests.create(realSize);
+
+            for (uint32_t i = 0; i < realSize && ret.isGood(); i++)
+            {
+                uaModifyRequests[i].MonitoredItemId = items[i]->second.monitoredItemId;
+                uaModifyRequests[i].RequestedParameters.ClientHandle = items[i]->first;
+                uaModifyRequests[i].RequestedParameters.SamplingInterval \
+                    = settings.samplingIntervalSec * 1000;
+                uaModifyRequests[i].RequestedParameters.QueueSize = settings.queueSize;
+                uaModifyRequests[i].RequestedParameters.DiscardOldest \
+                    = settings.discardOldest ? OpcUa_True : OpcUa_False;
+
+                // the filter is replaced by the filter of the settings, or else kept
+                const MonitoredItemSettings& current = items[i]->second.settings;
+                if (settings.kind() == MonitoredItemSettings::Data)
+                {
+                    const DataChangeFilter* filter = settings.dataChangeFilter != NULL ?
+                            settings.dataChangeFilter : current.dataChangeFilter;
+
+                    OpcUa_DataChangeFilter* pDataChangeFilter = (OpcUa_DataChangeFilter*)OpcUa_Null;
+
+                    OpcUa_EncodeableObject_CreateExtension(
+                            &OpcUa_DataChangeFilter_EncodeableType,
+                            &uaModifyRequests[i].RequestedParameters.Filter,
+                            (OpcUa_Void**)&pDataChangeFilter);
+
+                    OpcUa_DataChangeFilter_Initialize(pDataChangeFilter);
+
+                    filter->toSdk(pDataChangeFilter);
+                }
+                else
+                {
+                    const EventFilter* filter = settings.eventFilter != NULL ?
+                            settings.eventFilter : current.eventFilter;
+
+                    ret = nameSpaceArray.fillOpcUaEventFilter(
+                            *filter,
+                            uaModifyRequests[i].RequestedParameters.Filter);
+                }
+            }
+
+            // now invoke the service
+            UaMonitoredItemModifyResults uaModifyResults;
+
+            if (ret.isGood())
+            {
+                UaClientSdk::ServiceSettings uaServiceSettings;
+                serviceSettings.toSdk(uaServiceSettings);
+
+                SdkStatus sdkStatus = uaSubscription_->modifyMonitoredItems(
+                        uaServiceSettings,
+                        OpcUa_TimestampsToReturn_Both,
+                        uaModifyRequests,
+                        uaModifyResults);
+
+                if (sdkStatus.isNotGood())
+                    ret = ModifyMonitoredItemsInvocationError(sdkStatus);
+                else if (uaModifyResults.length() != realSize)
+                    ret = UnexpectedError("Mismatch between number of results and number of "
+                                          "monitored items to modify");
+                else
+                    ret = statuscodes::Good;
+
+                logger_->debug("Result of OPC UA service call: %s", ret.toString().c_str());
+            }
+
+            if (ret.isGood())
+            {
+                // the ranks of the persistent request targets to be modified, per request
+                map< RequestHandle, vector<size_t> > dataTargetRanks;
+                map< RequestHandle, vector<size_t> > eventsTargetRanks;
+
+                for (uint32_t i = 0; i < realSize; i++)
+                {
+                    MonitoredItem& item = items[i]->second;
+
+                    if (OpcUa_IsGood(uaModifyResults[i].StatusCode))
+                    {
+                        // keep the filter of the item if the settings don't specify one
+                        if (settings.kind() == MonitoredItemSettings::Data)
+                        {
+                            item.settings = MonitoredItemSettings(
+                                    settings.samplingIntervalSec,
+                                    settings.queueSize,
+                                    settings.discardOldest,
+                                    settings.dataChangeFilter != NULL ?
+                                            *settings.dataChangeFilter :
+                                            *item.settings.dataChangeFilter);
+                            dataTargetRanks[item.requestHandle].push_back(item.targetRank);
+                        }
+                        else
+                        {
+                            item.settings = MonitoredItemSettings(
+                                    settings.samplingIntervalSec,
+                                    settings.queueSize,
+                                    settings.discardOldest,
+                                    settings.eventFilter != NULL ?
+                                            *settings.eventFilter :
+                                            *item.settings.eventFilter);
+                            eventsTargetRanks[item.requestHandle].push_back(item.targetRank);
+                        }
+
+                        item.revisedSamplingIntervalSec \
+                            = uaModifyResults[i].RevisedSamplingInterval / 1000.0;
+                        item.revisedQueueSize = uaModifyResults[i].RevisedQueueSize;
+
+                        results[ranks[i]] = statuscodes::Good;
+                    }
+                    else
+                    {
+                        results[ranks[i]] = ServerCouldNotModifyMonitoredItemError(
+                                items[i]->first,
+                                SdkStatus(uaModifyResults[i].StatusCode));
+                    }
+                }
+
+                // update the persistent requests (once per request), so that the monitored items
+                // will be re-created with the modified settings
+                MonitoredItemSettingsApplier applier(settings);
+                map< RequestHandle, vector<size_t> >::const_iterator iter;
+
+                for (iter = dataTargetRanks.begin(); iter != dataTargetRanks.end(); ++iter)
+                    database_->createMonitoredDataRequestStore.modifyTargets(
+                            iter->first, iter->second, applier);
+
+                for (iter = eventsTargetRanks.begin(); iter != eventsTargetRanks.end(); ++iter)
+                    database_->createMonitoredEventsRequestStore.modifyTargets(
+                            iter->first, iter->second, applier);
+            }
+        }
+        else
+        {
+            logger_->debug("The client handles do not belong to this subscription (or are of "
+                           "another kind), skipping");
+            // ret remains Uncertain
+        }
+
+        return ret;
+    }
+
+
+
     // Change the subscription status
     // =============================================================================================
     void Subscription::setSubscriptionState(
@@ -374,6 +731,31 @@ namespace uaf
     }
 
 
+    // Update the table of monitored item handles
+    // =============================================================================================
+    void Subscription::updateHandleTable()
+    {
+        vector<ClientHandle> clientHandles;
+        clientHandles.reserve(monitoredItemsMap_.size());
+
+        for (MonitoredItemsMap::const_iterator it = monitoredItemsMap_.begin();
+             it != monitoredItemsMap_.end();
+             ++it)
+            clientHandles.push_back(it->first);
+
+        handleTable_.assign(clientHandles);
+    }
+
+
+    // Get the number of monitored items
+    // =============================================================================================
+    size_t Subscription::monitoredItemCount()
+    {
+        // no need to lock the monitoredItemsMapMutex_ (which may be locked during a service call)
+        return handleTable_.size();
+    }
+
+
     // keep the subscription alive
     // =============================================================================================
     void Subscription::keepAlive()
@@ -387,15 +769,16 @@ namespace uaf
         notification.clientSubscriptionHandle   = clientSubscriptionHandle_;
         notification.subscriptionState          = subscriptionState_;
 
-        UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
-
         // now add the monitored item handles
+        {
+            UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when out of scope
 
-        for (MonitoredItemsMap::iterator it = monitoredItemsMap_.begin();
-                it != monitoredItemsMap_.end(); ++it)
-            notification.clientHandles.push_back(it->first);
+            for (MonitoredItemsMap::iterator it = monitoredItemsMap_.begin();
+                    it != monitoredItemsMap_.end(); ++it)
+                notification.clientHandles.push_back(it->first);
+        }
 
-        // call the callback interface
+        // call the callback interface (without holding the mutex)
         clientInterface_->keepAliveReceived(notification);
     }
 
@@ -405,26 +788,48 @@ namespace uaf
     void Subscription::dataChange(
             const UaDataNotifications&  dataNotifications,
             const UaDiagnosticInfos &   diagnosticInfos)
+    {
+        processDataChange(dataNotifications, diagnosticInfos, false);
+    }
+
+
+    // implemented from callback interface
+    // =============================================================================================
+    void Subscription::newEvents(UaEventFieldLists& uaEventFieldList)
+    {
+        processEvents(uaEventFieldList, false);
+    }
+
+
+    // Convert the data change notifications and deliver them
+    // =============================================================================================
+    void Subscription::processDataChange(
+            const UaDataNotifications&  dataNotifications,
+            const UaDiagnosticInfos&    diagnosticInfos,
+            bool                        republished)
     {
         // get the number of notifications
         uint32_t noOfNotifications = dataNotifications.length();
 
         // create the notifications
         vector<DataChangeNotification> notifications;
+        notifications.reserve(noOfNotifications);
 
         logger_->debug("A total of %d data notifications were received", noOfNotifications);
 
+        bool debugEnabled = logger_->isDebugEnabled();
+
         // fill the notifications
         for (uint32_t i=0; i < noOfNotifications; i++)
         {
             ClientHandle clientHandle = dataNotifications[i].ClientHandle;
 
-            MonitoredItemsMap::const_iterator it = monitoredItemsMap_.find(clientHandle);
-
             // update the contents of the notification
-            if (it != monitoredItemsMap_.end())
+            if (handleTable_.contains(clientHandle))
             {
-                DataChangeNotification notification;
+                // construct the notification in place, so it doesn't need to be copied
+                notifications.push_back(DataChangeNotification());
+                DataChangeNotification& notification = notifications.back();
 
                 notification.clientHandle       = clientHandle;
                 notification.data               = dataNotifications[i].Value.Value;
@@ -434,23 +839,39 @@ namespace uaf
                 else
                     notification.status = BadDataReceivedError(SdkStatus(dataNotifications[i].Value.StatusCode));
 
-                // add it to the vector of notifications for the callback
-                notifications.push_back(notification);
+                // log the notification (only if needed, since this is done for every sample)
+                if (debugEnabled)
+                {
+                    logger_->debug(" - Notification %d:", int(i));
+                    logger_->debug(notification.toString("   ", 25));
+                }
+            }
+        }
+
+        // count the notifications in the metrics
+        database_->metrics.notificationsReceived(clientSubscriptionHandle_, noOfNotifications, 0);
+
+        // hold the notifications back if notifications before them are still being recovered
+        if (!republished)
+        {
+            UaMutexLocker locker(&heldNotificationsMutex_); // unlocks when locker goes out of scope
 
-                // log the notification
-                logger_->debug(" - Notification %d:", int(i));
-                logger_->debug(notification.toString("   ", 25));
+            if (holding_)
+            {
+                heldNotifications_.push_back(HeldNotifications());
+                heldNotifications_.back().dataChanges.swap(notifications);
+                return;
             }
         }
 
-        // call the callback interface
-        clientInterface_->dataChangesReceived(notifications);
+        // call the callback interface (without copying the notifications)
+        clientInterface_->dataChangesReceived(ConstSpan<DataChangeNotification>(notifications));
     }
 
 
-    // implemented from callback interface
+    // Convert the event notifications and deliver them
     // =============================================================================================
-    void Subscription::newEvents(UaEventFieldLists& uaEventFieldList)
+    void Subscription::processEvents(UaEventFieldLists& uaEventFieldList, bool republished)
     {
         // get the number of notifications
         uint32_t noOfNotifications = uaEventFieldList.length();
@@ -459,37 +880,267 @@ namespace uaf
 
         // create the notifications
         vector<EventNotification> notifications;
+        notifications.reserve(noOfNotifications);
+
+        bool debugEnabled = logger_->isDebugEnabled();
 
         // fill the notifications
         for (uint32_t i=0; i < noOfNotifications; i++)
         {
             ClientHandle clientHandle = uaEventFieldList[i].ClientHandle;
 
-            MonitoredItemsMap::const_iterator it = monitoredItemsMap_.find(clientHandle);
-
             // update the contents of the notification
-            if (it != monitoredItemsMap_.end())
+            if (handleTable_.contains(clientHandle))
             {
-                EventNotification notification;
+                // construct the notification in place, so it doesn't need to be copied
+                notifications.push_back(EventNotification());
+                EventNotification& notification = notifications.back();
 
                 notification.clientHandle       = clientHandle;
 
                 // update the event fields
+                notification.fields.reserve(uaEventFieldList[i].NoOfEventFields);
                 for (int32_t j=0; j < uaEventFieldList[i].NoOfEventFields; j++)
                     notification.fields.push_back(Variant(uaEventFieldList[i].EventFields[j]));
 
-                // add it to the vector of notifications for the callback
-                notifications.push_back(notification);
+                // log the notification (only if needed, since this is done for every sample)
+                if (debugEnabled)
+                {
+                    logger_->debug(" - Notification %d:", int(i));
+                    logger_->debug(notification.toString("   ", 25));
+                }
+            }
+        }
+
+        // count the notifications in the metrics
+        database_->metrics.notificationsReceived(clientSubscriptionHandle_, 0, noOfNotifications);
 
-                // log the notification
-                logger_->debug(" - Notification %d:", int(i));
-                logger_->debug(notification.toString("   ", 25));
+        // hold the notifications back if notifications before them are still being recovered
+        if (!republished)
+        {
+            UaMutexLocker locker(&heldNotificationsMutex_); // unlocks when locker goes out of scope
+
+            if (holding_)
+            {
+                heldNotifications_.push_back(HeldNotifications());
+                heldNotifications_.back().isEvent = true;
+                heldNotifications_.back().events.swap(notifications);
+                return;
             }
         }
 
-        // call the callback interface
-        clientInterface_->eventsReceived(notifications);
+        // call the callback interface (without copying the notifications)
+        clientInterface_->eventsReceived(ConstSpan<EventNotification>(notifications));
+    }
+
+
+    // Hold back the notifications until the missing ones are recovered
+    // =============================================================================================
+    void Subscription::holdNotifications()
+    {
+        UaMutexLocker locker(&heldNotificationsMutex_); // unlocks when locker goes out of scope
+
+        // if a previous gap is still being recovered, mark the position of this gap, so that the
+        // notifications after it are only released when this gap is recovered too
+        if (holding_)
+        {
+            heldNotifications_.push_back(HeldNotifications());
+            heldNotifications_.back().isGap = true;
+        }
+
+        holding_ = true;
     }
 
-}
 
+    // Deliver the held back notifications up to the next gap
+    // =============================================================================================
+    void Subscription::releaseNotifications()
+    {
+        // the notifications are delivered one batch at a time without locking the mutex, so the
+        // callback interface can't block the notification callbacks of the SDK (which will add
+        // the new notifications to the back of the deque as long as holding_ is true)
+        while (true)
+        {
+            HeldNotifications held;
+
+            {
+                UaMutexLocker locker(&heldNotificationsMutex_); // unlocks when out of scope
+
+                if (heldNotifications_.empty())
+                {
+                    holding_ = false;
+                    return;
+                }
+
+                if (heldNotifications_.front().isGap)
+                {
+                    heldNotifications_.pop_front();
+                    return;
+                }
+
+                held.isEvent = heldNotifications_.front().isEvent;
+                held.dataChanges.swap(heldNotifications_.front().dataChanges);
+                held.events.swap(heldNotifications_.front().events);
+                heldNotifications_.pop_front();
+            }
+
+            logger_->debug("Delivering %d notifications that were held back",
+                           held.dataChanges.size() + held.events.size());
+
+            if (held.isEvent)
+                clientInterface_->eventsReceived(ConstSpan<EventNotification>(held.events));
+            else
+                clientInterface_->dataChangesReceived(
+                        ConstSpan<DataChangeNotification>(held.dataChanges));
+        }
+    }
+
+
+    // Republish the missing notifications
+    // =============================================================================================
+    Status Subscription::republishMissingNotifications(
+            uint32_t                            previousSequenceNumber,
+            uint32_t                            newSequenceNumber,
+            uint32_t                            maxRepublishedMessages,
+            const ServiceSettings&              serviceSettings,
+            vector< pair<uint32_t, uint32_t> >& gaps)
+    {
+        Status ret = statuscodes::Good;
+
+        // the number of missing sequence numbers (taking into account that 0 is skipped when
+        // the sequence numbers wrap around)
+        uint32_t noOfMissing = newSequenceNumber - previousSequenceNumber - 1;
+        if (newSequenceNumber < previousSequenceNumber)
+            noOfMissing--;
+
+        // only republish the most recent ones, the older ones are skipped (i.e. lost)
+        uint32_t noOfSkipped = 0;
+        if (noOfMissing > maxRepublishedMessages)
+            noOfSkipped = noOfMissing - maxRepublishedMessages;
+
+        logger_->debug("Republishing %d of the %d missing messages (%d + 1 != %d)",
+                       noOfMissing - noOfSkipped, noOfMissing,
+                       previousSequenceNumber, newSequenceNumber);
+
+        UaClientSdk::ServiceSettings uaServiceSettings;
+        serviceSettings.toSdk(uaServiceSettings);
+
+        // the last sequence number that was received or recovered
+        uint32_t lastSequenceNumber = previousSequenceNumber;
+        // true as long as the notifications after lastSequenceNumber are lost
+        bool losing = (noOfSkipped > 0);
+        // true if republishing doesn't work at all
+        bool aborted = !isCreated();
+        uint32_t noOfRecovered = 0;
+
+        uint32_t sequenceNumber = advanceSequenceNumber(previousSequenceNumber, noOfSkipped + 1);
+
+        for (uint32_t i = noOfSkipped; i < noOfMissing; i++)
+        {
+            bool recovered = false;
+
+            if (!aborted)
+            {
+                UaExtensionObjectArray  uaNotificationData;
+                UaDateTime              uaPublishTime;
+
+                SdkStatus sdkStatus = uaSubscription_->republish(uaServiceSettings,
+                                                                 sequenceNumber,
+                                                                 uaNotificationData,
+                                                                 uaPublishTime);
+
+                if (sdkStatus.isGood())
+                {
+                    deliverRepublishedNotifications(uaNotificationData);
+                    recovered = true;
+                    noOfRecovered++;
+                }
+                else
+                {
+                    ret = RepublishInvocationError(sdkStatus);
+
+                    // if the message is not in the retransmission queue anymore, the next one may
+                    // still be, but any other error means that republishing doesn't work (e.g.
+                    // because the connection is down)
+                    aborted = (sdkStatus.statusCode != OpcUa_BadMessageNotAvailable);
+                }
+            }
+
+            if (recovered)
+            {
+                if (losing)
+                    gaps.push_back(pair<uint32_t, uint32_t>(lastSequenceNumber, sequenceNumber));
+                losing = false;
+                lastSequenceNumber = sequenceNumber;
+            }
+            else
+            {
+                losing = true;
+            }
+
+            sequenceNumber = advanceSequenceNumber(sequenceNumber, 1);
+        }
+
+        if (losing)
+            gaps.push_back(pair<uint32_t, uint32_t>(lastSequenceNumber, newSequenceNumber));
+
+        logger_->debug("%d of the %d missing messages were recovered", noOfRecovered, noOfMissing);
+
+        // now the notifications that came after the gap can be delivered
+        releaseNotifications();
+
+        return ret;
+    }
+
+
+    // Deliver the notifications of a republished NotificationMessage
+    // =============================================================================================
+    void Subscription::deliverRepublishedNotifications(
+            const UaExtensionObjectArray& notificationData)
+    {
+        for (OpcUa_UInt32 i = 0; i < notificationData.length(); i++)
+        {
+            const OpcUa_ExtensionObject& extensionObject = notificationData[i];
+
+            if (   extensionObject.Encoding == OpcUa_ExtensionObjectEncoding_EncodeableObject
+                && extensionObject.Body.EncodeableObject.Type != OpcUa_Null)
+            {
+                OpcUa_UInt32 typeId = extensionObject.Body.EncodeableObject.Type->TypeId;
+                OpcUa_Void*  object = extensionObject.Body.EncodeableObject.Object;
+
+                if (typeId == OpcUaId_DataChangeNotification)
+                {
+                    OpcUa_DataChangeNotification* uaDataChange
+                        = (OpcUa_DataChangeNotification*) object;
+
+                    // attach the arrays of the message temporarily (without copying them), so they
+                    // can be processed like the notifications that are received normally
+                    UaDataNotifications uaDataNotifications;
+                    UaDiagnosticInfos   uaDiagnosticInfos;
+                    uaDataNotifications.attach(uaDataChange->NoOfMonitoredItems,
+                                               uaDataChange->MonitoredItems);
+                    uaDiagnosticInfos.attach(uaDataChange->NoOfDiagnosticInfos,
+                                             uaDataChange->DiagnosticInfos);
+
+                    processDataChange(uaDataNotifications, uaDiagnosticInfos, true);
+
+                    uaDataNotifications.detach();
+                    uaDiagnosticInfos.detach();
+                }
+                else if (typeId == OpcUaId_EventNotificationList)
+                {
+                    OpcUa_EventNotificationList* uaEvents = (OpcUa_EventNotificationList*) object;
+
+                    UaEventFieldLists uaEventFieldLists;
+                    uaEventFieldLists.attach(uaEvents->NoOfEvents, uaEvents->Events);
+
+                    processEvents(uaEventFieldLists, true);
+
+                    uaEventFieldLists.detach();
+                }
+                // StatusChangeNotifications are not republished to the client interface
+            }
+        }
+    }
+
+}
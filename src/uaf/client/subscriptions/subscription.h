@@ -25,6 +25,8 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <deque>
+#include <utility>
 // SDK
 #include "uaclient/uaclientsdk.h"
 #include "uaclient/uasession.h"
@@ -37,8 +39,10 @@
 #include "uaf/util/constants.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/clientinterface.h"
+#include "uaf/client/transport/sessiontransport.h"
 #include "uaf/client/settings/subscriptionsettings.h"
 #include "uaf/client/subscriptions/monitoreditem.h"
+#include "uaf/client/subscriptions/clienthandletable.h"
 #include "uaf/client/subscriptions/subscriptionstates.h"
 #include "uaf/client/subscriptions/subscriptioninformation.h"
 #include "uaf/client/subscriptions/monitorediteminformation.h"
@@ -71,7 +75,7 @@ namespace uaf
          *                                  UaSubscriptionCallback instance, so in the case of UAF,
          *                                  also unique per session).
          * @param clientConnectionId        The id of the session hosting the subscription.
-         * @param uaSession                 SDK Session object hosting the subscription.
+         * @param uaSession                 Transport of the session hosting the subscription.
          * @param uaSubscriptionCallback    SDK Subscription callback to call.
          * @param clientInterface           The client interface to pass the callbacks to.
          * @param database                  Client database.
@@ -81,7 +85,7 @@ namespace uaf
                 const uaf::SubscriptionSettings&       subscriptionSettings,
                 uaf::ClientSubscriptionHandle           clientSubscriptionHandle,
                 uaf::ClientConnectionId                 clientConnectionId,
-                UaClientSdk::UaSession*                 uaSession,
+                uaf::SessionTransport*                  uaSession,
                 UaClientSdk::UaSubscriptionCallback*    uaSubscriptionCallback,
                 uaf::ClientInterface*                  clientInterface,
                 uaf::Database*                         database);
@@ -146,6 +150,14 @@ namespace uaf
                 uaf::MonitoredItemInformation& monitoredItemInformation);
 
 
+        /**
+         * Get the number of monitored items that are owned by the subscription.
+         *
+         * @return  The number of monitored items.
+         */
+        std::size_t monitoredItemCount();
+
+
         /**
          * Called every time a monitored item has changed,
          * overridden from UaSubscriptionCallback.
@@ -161,6 +173,44 @@ namespace uaf
         virtual void newEvents(UaEventFieldLists &eventFieldList);
 
 
+        /**
+         * Hold back the notifications that are received from now on, until the notifications
+         * that are missing before them have been recovered by republishMissingNotifications().
+         *
+         * If notifications are already being held back (because a previous gap isn't recovered
+         * yet), the ones received from now on are only released after the next call of
+         * republishMissingNotifications().
+         */
+        void holdNotifications();
+
+
+        /**
+         * Try to recover the notifications that are missing between two sequence numbers, by
+         * calling the Republish service for each missing sequence number.
+         *
+         * The recovered notifications are delivered in the order of their sequence numbers, in
+         * the same way as the notifications that are received normally. Afterwards, the
+         * notifications that were held back since the gap (see holdNotifications()) are
+         * delivered.
+         *
+         * @param previousSequenceNumber    The sequence number before the missing ones.
+         * @param newSequenceNumber         The sequence number after the missing ones.
+         * @param maxRepublishedMessages    The maximum number of messages to republish (only the
+         *                                  most recent missing ones are republished).
+         * @param serviceSettings           The service settings to be used.
+         * @param gaps                      Output parameter: the sequence numbers that could not
+         *                                  be recovered, as (previous, new) pairs that have the
+         *                                  same meaning as the first two parameters.
+         * @return                          Good if the Republish service calls succeeded.
+         */
+        uaf::Status republishMissingNotifications(
+                uint32_t                                        previousSequenceNumber,
+                uint32_t                                        newSequenceNumber,
+                uint32_t                                        maxRepublishedMessages,
+                const uaf::ServiceSettings&                     serviceSettings,
+                std::vector< std::pair<uint32_t, uint32_t> >&   gaps);
+
+
         /**
          * Set the publishing mode of the subscription.
          *
@@ -190,6 +240,47 @@ namespace uaf
                std::vector<uaf::Status>&               results);
 
 
+       /**
+        * Delete the monitored items with the given ClientHandles, if they are owned by the
+        * subscription.
+        *
+        * The deleted monitored items are also removed from the persistent requests (so they
+        * won't be re-created anymore), and their ClientHandles are released.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be deleted.
+        * @param serviceSettings   The service settings to be used.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status deleteMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&   clientHandles,
+               const uaf::ServiceSettings&             serviceSettings,
+               std::vector<uaf::Status>&               results);
+
+
+       /**
+        * Modify the monitored items with the given ClientHandles, if they are owned by the
+        * subscription.
+        *
+        * The persistent requests are updated too, so that the monitored items will be re-created
+        * with the modified settings (e.g. after a reconnection).
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be modified.
+        * @param settings          The new settings of the monitored items. If the filter of
+        *                          these settings is NULL, the current filter is kept.
+        * @param serviceSettings   The service settings to be used.
+        * @param nameSpaceArray    The namespace array of the server (to convert event filters).
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status modifyMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&   clientHandles,
+               const uaf::MonitoredItemSettings&       settings,
+               const uaf::ServiceSettings&             serviceSettings,
+               const uaf::NamespaceArray&              nameSpaceArray,
+               std::vector<uaf::Status>&               results);
+
+
         /**
          * Execute a CreateMonitoredData service invocation.
          *
@@ -207,6 +298,11 @@ namespace uaf
 
             // create a vector to store the ClientHandles
             std::vector<uaf::ClientHandle> clientHandles;
+            clientHandles.reserve(invocation.requestTargets().size());
+
+            // the mutex is not locked during the service call, so that the notification callbacks
+            // (e.g. keepAlive) don't have to wait for the server
+            monitoredItemsMapMutex_.lock();
 
             for (std::size_t i = 0; i < invocation.requestTargets().size(); i++)
             {
@@ -229,23 +325,35 @@ namespace uaf
                 clientHandles.push_back(clientHandle);
             }
 
+            // the notifications of the new monitored items may arrive as soon as they are created
+            updateHandleTable();
+
+            monitoredItemsMapMutex_.unlock();
+
             // provide the clientHandles to the invocation
             invocation.setHandles(clientHandles);
 
             // create the monitored items on the server side, by invoking the service
             ret = invocation.invoke(uaSubscription_, nameSpaceArray, serverArray, logger_);
 
-            // store the MonitoredItemId, revised sampling interval etc.
+            UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+
+            // store the MonitoredItemId, revised sampling interval etc. (unless the monitored
+            // item has been deleted in the meantime)
             for (std::size_t i = 0; i < invocation.resultTargets().size(); i++)
             {
-                uaf::ClientHandle clientHandle = invocation.resultTargets()[i].clientHandle;
-
-                monitoredItemsMap_[clientHandle].revisedQueueSize \
-                    = invocation.resultTargets()[i].revisedQueueSize;
-                monitoredItemsMap_[clientHandle].revisedSamplingIntervalSec \
-                    = invocation.resultTargets()[i].revisedSamplingIntervalSec;
-                monitoredItemsMap_[clientHandle].monitoredItemId \
-                    = invocation.resultTargets()[i].monitoredItemId;
+                MonitoredItemsMap::iterator it
+                    = monitoredItemsMap_.find(invocation.resultTargets()[i].clientHandle);
+
+                if (it != monitoredItemsMap_.end())
+                {
+                    it->second.revisedQueueSize
+                        = invocation.resultTargets()[i].revisedQueueSize;
+                    it->second.revisedSamplingIntervalSec
+                        = invocation.resultTargets()[i].revisedSamplingIntervalSec;
+                    it->second.monitoredItemId
+                        = invocation.resultTargets()[i].monitoredItemId;
+                }
             }
 
 
@@ -270,6 +378,11 @@ namespace uaf
 
             // create a vector to store the ClientHandles
             std::vector<uaf::ClientHandle> clientHandles;
+            clientHandles.reserve(invocation.requestTargets().size());
+
+            // the mutex is not locked during the service call, so that the notification callbacks
+            // (e.g. keepAlive) don't have to wait for the server
+            monitoredItemsMapMutex_.lock();
 
             for (std::size_t i = 0; i < invocation.requestTargets().size(); i++)
             {
@@ -292,23 +405,35 @@ namespace uaf
                 clientHandles.push_back(clientHandle);
             }
 
+            // the notifications of the new monitored items may arrive as soon as they are created
+            updateHandleTable();
+
+            monitoredItemsMapMutex_.unlock();
+
             // provide the clientHandles to the invocation
             invocation.setHandles(clientHandles);
 
             // create the monitored items on the server side, by invoking the service
             ret = invocation.invoke(uaSubscription_, nameSpaceArray, serverArray, logger_);
 
-            // store the MonitoredItemId, revised sampling interval etc.
+            UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+
+            // store the MonitoredItemId, revised sampling interval etc. (unless the monitored
+            // item has been deleted in the meantime)
             for (std::size_t i = 0; i < invocation.resultTargets().size(); i++)
             {
-                uaf::ClientHandle clientHandle = invocation.resultTargets()[i].clientHandle;
-
-                monitoredItemsMap_[clientHandle].revisedQueueSize \
-                    = invocation.resultTargets()[i].revisedQueueSize;
-                monitoredItemsMap_[clientHandle].revisedSamplingIntervalSec \
-                    = invocation.resultTargets()[i].revisedSamplingIntervalSec;
-                monitoredItemsMap_[clientHandle].monitoredItemId \
-                    = invocation.resultTargets()[i].monitoredItemId;
+                MonitoredItemsMap::iterator it
+                    = monitoredItemsMap_.find(invocation.resultTargets()[i].clientHandle);
+
+                if (it != monitoredItemsMap_.end())
+                {
+                    it->second.revisedQueueSize
+                        = invocation.resultTargets()[i].revisedQueueSize;
+                    it->second.revisedSamplingIntervalSec
+                        = invocation.resultTargets()[i].revisedSamplingIntervalSec;
+                    it->second.monitoredItemId
+                        = invocation.resultTargets()[i].monitoredItemId;
+                }
             }
 
             return ret;
@@ -361,12 +486,51 @@ namespace uaf
         typedef std::map<uaf::ClientHandle, uaf::MonitoredItem> MonitoredItemsMap;
 
 
+        // update the handleTable_ after monitored items were added to or removed from the
+        // monitoredItemsMap_ (the monitoredItemsMapMutex_ must be locked)
+        void updateHandleTable();
+
+
+        // a batch of notifications that is held back while missing notifications are recovered
+        struct HeldNotifications
+        {
+            HeldNotifications() : isGap(false), isEvent(false) {}
+            // true if this is not a batch, but the position of the next gap
+            bool isGap;
+            // true if the batch holds event notifications, false for data changes
+            bool isEvent;
+            std::vector<uaf::DataChangeNotification>    dataChanges;
+            std::vector<uaf::EventNotification>         events;
+        };
+
+
+        // convert the data change notifications and deliver them (or hold them back, unless they
+        // were republished)
+        void processDataChange(
+                const UaDataNotifications&  dataNotifications,
+                const UaDiagnosticInfos&    diagnosticInfos,
+                bool                        republished);
+
+
+        // convert the event notifications and deliver them (or hold them back, unless they were
+        // republished)
+        void processEvents(UaEventFieldLists& uaEventFieldList, bool republished);
+
+
+        // deliver the notifications of a republished NotificationMessage
+        void deliverRepublishedNotifications(const UaExtensionObjectArray& notificationData);
+
+
+        // deliver the held back notifications, up to the next gap
+        void releaseNotifications();
+
+
         // logger of the subscription
         uaf::Logger*                                logger_;
-        // SDK session instance
-        UaClientSdk::UaSession*                     uaSession_;
-        // SDK subscription instance
-        UaClientSdk::UaSubscription*                uaSubscription_;
+        // transport of the session
+        uaf::SessionTransport*                      uaSession_;
+        // transport of the subscription
+        uaf::SubscriptionTransport*                 uaSubscription_;
         // SDK subscription callback
         UaClientSdk::UaSubscriptionCallback*        uaSubscriptionCallback_;
         // the settings of the subscription
@@ -390,6 +554,14 @@ namespace uaf
         // the container that will hold the monitored items, and its mutex.
         MonitoredItemsMap                           monitoredItemsMap_;
         UaMutex                                     monitoredItemsMapMutex_;
+        // the handles of the monitored items, for lock-free lookups by the notification callbacks
+        uaf::ClientHandleTable                      handleTable_;
+
+        // the notifications that are held back while missing notifications are recovered, the
+        // flag that tells if they are being held back, and their mutex
+        std::deque<HeldNotifications>               heldNotifications_;
+        bool                                        holding_;
+        UaMutex                                     heldNotificationsMutex_;
 
 
 
@@ -26,6 +26,8 @@ namespace uaf
     using std::string;
     using std::stringstream;
     using std::vector;
+    using std::size_t;
+    using std::pair;
 
 
     // Constructor
@@ -33,14 +35,16 @@ namespace uaf
     SubscriptionFactory::SubscriptionFactory(
             LoggerFactory*              loggerFactory,
             uaf::ClientConnectionId    clientConnectionId,
-            UaClientSdk::UaSession*     uaSession,
+            uaf::SessionTransport*      uaSession,
             ClientInterface*            clientInterface,
             Database*                   database)
     : uaSession_(uaSession),
       clientConnectionId_(clientConnectionId),
       database_(database),
       clientInterface_(clientInterface),
-      transactionId_(0)
+      transactionId_(0),
+      recoveryWorker_(0),
+      recoveryStopped_(false)
     {
         // build the logger name:
         stringstream loggerName;
@@ -58,6 +62,23 @@ namespace uaf
     {
         logger_->debug("Destructing the subscription factory");
 
+        // stop the recovery thread (the notifications it didn't recover yet are of no use
+        // anymore, since the subscriptions are deleted with the session)
+        RecoveryWorker* recoveryWorker = 0;
+        {
+            UaMutexLocker locker(&recoveryMutex_); // unlocks when locker goes out of scope
+            recoveryStopped_ = true;
+            recoveryWorker = recoveryWorker_;
+            recoveryWorker_ = 0;
+        }
+
+        if (recoveryWorker != 0)
+        {
+            recoverySemaphore_.post(1);
+            recoveryWorker->waitUntilFinished();
+            delete recoveryWorker;
+        }
+
         // delete the logger
         delete logger_;
         logger_ = 0;
@@ -289,6 +310,76 @@ namespace uaf
     }
 
 
+    // Delete the monitored items with the given client handles.
+    // =============================================================================================
+    Status SubscriptionFactory::deleteMonitoredItemsIfNeeded(
+            const vector<ClientHandle>& clientHandles,
+            const ServiceSettings*      serviceSettingsPtr,
+            vector<Status>&             results)
+    {
+        Status ret;
+
+        ServiceSettings serviceSettings;
+        if (serviceSettingsPtr == NULL)
+            serviceSettings = database_->clientSettings.defaultDeleteMonitoredItemsSettings;
+        else
+            serviceSettings = *serviceSettingsPtr;
+
+        // lock the mutex to make sure the subscriptionMap_ is not being manipulated
+        UaMutexLocker locker(&subscriptionMapMutex_);
+
+        // loop trough the subscriptions
+        for (SubscriptionMap::iterator it = subscriptionMap_.begin();
+                it != subscriptionMap_.end() && ret.isNotBad();
+                ++it)
+        {
+            ret = it->second->deleteMonitoredItemsIfNeeded(
+                    clientHandles,
+                    serviceSettings,
+                    results);
+        }
+
+        return ret;
+    }
+
+
+    // Modify the monitored items with the given client handles.
+    // =============================================================================================
+    Status SubscriptionFactory::modifyMonitoredItemsIfNeeded(
+            const vector<ClientHandle>&     clientHandles,
+            const MonitoredItemSettings&    settings,
+            const ServiceSettings*          serviceSettingsPtr,
+            const NamespaceArray&           nameSpaceArray,
+            vector<Status>&                 results)
+    {
+        Status ret;
+
+        ServiceSettings serviceSettings;
+        if (serviceSettingsPtr == NULL)
+            serviceSettings = database_->clientSettings.defaultModifyMonitoredItemsSettings;
+        else
+            serviceSettings = *serviceSettingsPtr;
+
+        // lock the mutex to make sure the subscriptionMap_ is not being manipulated
+        UaMutexLocker locker(&subscriptionMapMutex_);
+
+        // loop trough the subscriptions
+        for (SubscriptionMap::iterator it = subscriptionMap_.begin();
+                it != subscriptionMap_.end() && ret.isNotBad();
+                ++it)
+        {
+            ret = it->second->modifyMonitoredItemsIfNeeded(
+                    clientHandles,
+                    settings,
+                    serviceSettings,
+                    nameSpaceArray,
+                    results);
+        }
+
+        return ret;
+    }
+
+
     // Construct a subscription if needed
     // =============================================================================================
     Status SubscriptionFactory::acquireSubscription(
@@ -343,37 +434,7 @@ namespace uaf
 
         // if no subscription exists yet, we create one
         if (subscription == 0)
-        {
-            ClientSubscriptionHandle clientSubscriptionHandle;
-            clientSubscriptionHandle = database_->createUniqueClientSubscriptionHandle();
-
-            logger_->debug("We create a new subscription with clientSubscriptionHandle %d",
-                           clientSubscriptionHandle);
-
-            // create a new subscription instance
-            subscription = new Subscription(
-                    logger_->loggerFactory(),
-                    subscriptionSettings,
-                    clientSubscriptionHandle,
-                    clientConnectionId_,
-                    uaSession_,
-                    this,
-                    clientInterface_,
-                    database_);
-
-            // store the new subscription instance in the subscriptionMap
-            subscriptionMap_[clientSubscriptionHandle] = subscription;
-
-            logger_->debug("The new subscription has been created");
-
-            // create an activity count for the subscription
-            activityMapMutex_.lock();
-            activityMap_[clientSubscriptionHandle] = 1;
-            activityMapMutex_.unlock();
-
-            // create the subscription on the server
-            ret = subscription->createSubscription();
-        }
+            ret = createNewSubscription(subscriptionSettings, subscription);
 
         // 'subscription' now points to an existing Subscription instance
         // (i.e. a valid memory location)
@@ -396,6 +457,128 @@ namespace uaf
 
 
 
+    // Get the settings of the shard for a monitored item
+    // =============================================================================================
+    SubscriptionSettings SubscriptionFactory::shardSettings(
+            const SubscriptionSettings& subscriptionSettings,
+            double                      samplingIntervalSec) const
+    {
+        SubscriptionSettings ret(subscriptionSettings);
+
+        // items that are sampled slower than the requested publishing interval, are grouped in
+        // shards that publish at their sampling interval
+        if (   database_->clientSettings.shardBySamplingInterval
+            && samplingIntervalSec > subscriptionSettings.publishingIntervalSec)
+            ret.publishingIntervalSec = samplingIntervalSec;
+
+        return ret;
+    }
+
+
+    // Acquire the least loaded shard with the given settings
+    // =============================================================================================
+    Status SubscriptionFactory::acquireShard(
+            const SubscriptionSettings& subscriptionSettings,
+            Subscription*&              subscription,
+            size_t&                     monitoredItemCount)
+    {
+        logger_->debug("Acquiring a shard with the following settings:");
+        logger_->debug(subscriptionSettings.toString());
+
+        Status ret;
+
+        subscription = 0;
+        monitoredItemCount = 0;
+
+        uint32_t maxItems = database_->clientSettings.maxMonitoredItemsPerSubscription;
+
+        // lock the mutex to make sure the subscriptionMap_ is not being manipulated
+        UaMutexLocker locker(&subscriptionMapMutex_);
+
+        // find the subscription with these settings that owns the least monitored items,
+        // but still has room for more
+        for (SubscriptionMap::const_iterator it = subscriptionMap_.begin();
+             it != subscriptionMap_.end();
+             ++it)
+        {
+            if (it->second->subscriptionSettings() == subscriptionSettings)
+            {
+                size_t count = it->second->monitoredItemCount();
+
+                if (   (maxItems == 0 || count < maxItems)
+                    && (subscription == 0 || count < monitoredItemCount))
+                {
+                    subscription = it->second;
+                    monitoredItemCount = count;
+                }
+            }
+        }
+
+        if (subscription != 0)
+        {
+            ClientSubscriptionHandle handle = subscription->clientSubscriptionHandle();
+
+            logger_->debug("Shard %d has room for more monitored items (#items: %d)",
+                           handle, monitoredItemCount);
+
+            // now increment the activity count of the subscription
+            activityMapMutex_.lock();
+            activityMap_[handle] = activityMap_[handle] + 1;
+            activityMapMutex_.unlock();
+
+            ret = statuscodes::Good;
+        }
+        else
+        {
+            logger_->debug("All shards are full (or none exist yet), so we create a new one");
+            ret = createNewSubscription(subscriptionSettings, subscription);
+        }
+
+        if (ret.isNotGood())
+            logger_->error("The requested shard could not be acquired");
+
+        return ret;
+    }
+
+
+    // Create a new subscription
+    // =============================================================================================
+    Status SubscriptionFactory::createNewSubscription(
+            const SubscriptionSettings& subscriptionSettings,
+            Subscription*&              subscription)
+    {
+        ClientSubscriptionHandle clientSubscriptionHandle;
+        clientSubscriptionHandle = database_->createUniqueClientSubscriptionHandle();
+
+        logger_->debug("We create a new subscription with clientSubscriptionHandle %d",
+                       clientSubscriptionHandle);
+
+        // create a new subscription instance
+        subscription = new Subscription(
+                logger_->loggerFactory(),
+                subscriptionSettings,
+                clientSubscriptionHandle,
+                clientConnectionId_,
+                uaSession_,
+                this,
+                clientInterface_,
+                database_);
+
+        // store the new subscription instance in the subscriptionMap
+        subscriptionMap_[clientSubscriptionHandle] = subscription;
+
+        logger_->debug("The new subscription has been created");
+
+        // create an activity count for the subscription
+        activityMapMutex_.lock();
+        activityMap_[clientSubscriptionHandle] = 1;
+        activityMapMutex_.unlock();
+
+        // create the subscription on the server
+        return subscription->createSubscription();
+    }
+
+
     // Acquire an existing session, if one is available.
     // =============================================================================================
     Status SubscriptionFactory::acquireExistingSubscription(
@@ -491,6 +674,9 @@ namespace uaf
                     activityMap_.erase(handle);
                     subscriptionMap_.erase(handle);
 
+                    // the handle is no longer assigned (but it's never reused)
+                    database_->releaseClientSubscriptionHandle(handle);
+
                     logger_->debug("The subscription has been deleted");
                 }
             }
@@ -564,6 +750,114 @@ namespace uaf
         // acquire the subscription:
         Subscription* subscription = 0;
         Status acquireStatus = acquireExistingSubscription(clientSubscriptionHandle, subscription);
+
+        if (acquireStatus.isGood() && database_->clientSettings.republishMissingNotifications)
+        {
+            // the SDK calls this method on its publish thread, before it processes the
+            // notifications after the gap: hold those back, and let the recovery thread
+            // republish the missing ones while the server still has them in its retransmission
+            // queue (the held back notifications are delivered after the recovered ones)
+            subscription->holdNotifications();
+
+            // release the acquired subscription
+            releaseSubscription(subscription);
+
+            MissingNotifications missing;
+            missing.clientSubscriptionHandle = clientSubscriptionHandle;
+            missing.previousSequenceNumber   = previousSequenceNumber;
+            missing.newSequenceNumber        = newSequenceNumber;
+            scheduleRecovery(missing);
+        }
+        else
+        {
+            SubscriptionInformation info;
+
+            if (acquireStatus.isGood())
+            {
+                // get the updated subscription info
+                info = subscription->subscriptionInformation();
+
+                // release the acquired subscription
+                releaseSubscription(subscription);
+            }
+            else
+            {
+                logger_->warning("Unknown ClientSubscriptionHandle, discarding notification!");
+            }
+
+            // call the callback interface
+            clientInterface_->notificationsMissing(info, previousSequenceNumber, newSequenceNumber);
+        }
+    }
+
+
+    // Schedule the recovery of missing notifications
+    // =============================================================================================
+    void SubscriptionFactory::scheduleRecovery(const MissingNotifications& missing)
+    {
+        {
+            UaMutexLocker locker(&recoveryMutex_); // unlocks when locker goes out of scope
+
+            if (recoveryStopped_)
+                return;
+
+            if (recoveryWorker_ == 0)
+            {
+                logger_->debug("Starting the recovery thread");
+                recoveryWorker_ = new RecoveryWorker(this);
+                recoveryWorker_->startWorking();
+            }
+
+            missingNotifications_.push_back(missing);
+        }
+
+        recoverySemaphore_.post(1);
+    }
+
+
+    // Recover missing notifications (executed by the recovery thread)
+    // =============================================================================================
+    void SubscriptionFactory::recover()
+    {
+        bool finished = false;
+
+        while (!finished)
+        {
+            recoverySemaphore_.wait();
+
+            MissingNotifications missing;
+
+            {
+                UaMutexLocker locker(&recoveryMutex_); // unlocks when locker goes out of scope
+
+                if (recoveryStopped_ || missingNotifications_.empty())
+                {
+                    finished = recoveryStopped_;
+                    continue;
+                }
+
+                missing = missingNotifications_.front();
+                missingNotifications_.pop_front();
+            }
+
+            recoverMissingNotifications(missing);
+        }
+
+        logger_->debug("The recovery thread has stopped");
+    }
+
+
+    // Republish the missing notifications of a subscription
+    // =============================================================================================
+    void SubscriptionFactory::recoverMissingNotifications(const MissingNotifications& missing)
+    {
+        // the missing sequence numbers that could not be recovered, as (previous, new) pairs
+        vector< pair<uint32_t, uint32_t> > gaps;
+
+        // acquire the subscription:
+        Subscription* subscription = 0;
+        Status acquireStatus = acquireExistingSubscription(missing.clientSubscriptionHandle,
+                                                           subscription);
         SubscriptionInformation info;
 
         if (acquireStatus.isGood())
@@ -571,16 +865,36 @@ namespace uaf
             // get the updated subscription info
             info = subscription->subscriptionInformation();
 
-            // release the acquired session
+            // this also delivers the notifications that were held back since the gap
+            Status republishStatus = subscription->republishMissingNotifications(
+                    missing.previousSequenceNumber,
+                    missing.newSequenceNumber,
+                    database_->clientSettings.maxRepublishedMessages,
+                    database_->clientSettings.defaultRepublishSettings,
+                    gaps);
+
+            if (republishStatus.isNotGood())
+                logger_->warning("Not all missing notifications could be republished: %s",
+                                 republishStatus.toString().c_str());
+
+            // release the acquired subscription
             releaseSubscription(subscription);
         }
         else
         {
-            logger_->warning("Unknown ClientSubscriptionHandle, discarding notification!");
+            logger_->warning("Subscription %d is gone, its missing notifications are lost",
+                             missing.clientSubscriptionHandle);
+            gaps.push_back(pair<uint32_t, uint32_t>(missing.previousSequenceNumber,
+                                                    missing.newSequenceNumber));
         }
 
-        // call the callback interface
-        clientInterface_->notificationsMissing(info, previousSequenceNumber, newSequenceNumber);
+        // call the callback interface for the notifications that are really lost
+        for (vector< pair<uint32_t, uint32_t> >::const_iterator it = gaps.begin();
+             it != gaps.end();
+             ++it)
+        {
+            clientInterface_->notificationsMissing(info, it->first, it->second);
+        }
     }
 
 
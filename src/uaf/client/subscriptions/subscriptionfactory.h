@@ -26,14 +26,20 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <vector>
+#include <deque>
 // SDK
 #include "uaclient/uaclientsdk.h"
 #include "uaclient/uasession.h"
 #include "uabase/uastring.h"
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
 // UAF
 #include "uaf/util/status.h"
 #include "uaf/util/logger.h"
 #include "uaf/util/handles.h"
+#include "uaf/util/constants.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/subscriptions/subscription.h"
 #include "uaf/client/clientinterface.h"
@@ -62,7 +68,7 @@ namespace uaf
          *
          * @param loggerFactory      Logger factory to log all messages to.
          * @param clientConnectionId Id of the session that owns this subscription factory.
-         * @param uaSession          SDK session instance of the uaf::Session instance that owns
+         * @param uaSession          Session transport of the uaf::Session instance that owns
          *                           this subscription factory.
          * @param clientInterface    Client interface to call when asynchronous
          *                           communication is received.
@@ -71,7 +77,7 @@ namespace uaf
         SubscriptionFactory(
                 uaf::LoggerFactory*             loggerFactory,
                 uaf::ClientConnectionId         clientConnectionId,
-                UaClientSdk::UaSession*         uaSession,
+                uaf::SessionTransport*          uaSession,
                 uaf::ClientInterface*          clientInterface,
                 uaf::Database*                 database);
 
@@ -175,6 +181,40 @@ namespace uaf
                std::vector<uaf::Status>&               results);
 
 
+       /**
+        * Delete the monitored items with the given ClientHandles, if they are owned by one of the
+        * subscriptions.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be deleted.
+        * @param serviceSettings   The service settings to be used.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status deleteMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&   clientHandles,
+               const uaf::ServiceSettings*             serviceSettings,
+               std::vector<uaf::Status>&               results);
+
+
+       /**
+        * Modify the monitored items with the given ClientHandles, if they are owned by one of the
+        * subscriptions.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be modified.
+        * @param settings          The new settings of the monitored items.
+        * @param serviceSettings   The service settings to be used.
+        * @param nameSpaceArray    The namespace array of the server.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status modifyMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&   clientHandles,
+               const uaf::MonitoredItemSettings&       settings,
+               const uaf::ServiceSettings*             serviceSettings,
+               const uaf::NamespaceArray&              nameSpaceArray,
+               std::vector<uaf::Status>&               results);
+
+
         /**
          * Execute a service invocation in a generic way.
          *
@@ -203,43 +243,55 @@ namespace uaf
             if (invocation.asynchronous())
                 storeRequestHandle(invocation.requestHandle());
 
-            // try to acquire a subscription for the given subscription settings
-            uaf::Subscription* subscription = 0;
+            // get the settings of the subscription(s) to be used
+            const uaf::SubscriptionSettings& subscriptionSettings = request.subscriptionSettingsGiven
+                    ? request.subscriptionSettings
+                    : database_->clientSettings.defaultSubscriptionSettings;
 
-            if (request.clientSubscriptionHandleGiven)
-            {
-                ret = acquireExistingSubscription(request.clientSubscriptionHandle, subscription);
-            }
-            else if (request.subscriptionSettingsGiven)
+            // check if the targets may be spread over multiple subscriptions
+            bool sharded =    database_->clientSettings.shardSubscriptions
+                           && !request.clientSubscriptionHandleGiven
+                           && !subscriptionSettings.unique
+                           && !invocation.asynchronous();
+
+            if (sharded)
             {
-                ret = acquireSubscription(request.subscriptionSettings, subscription);
+                ret = invokeShardedService<_Service>(
+                        invocation,
+                        subscriptionSettings,
+                        nameSpaceArray,
+                        serverArray);
             }
             else
             {
-                ret = acquireSubscription(
-                        database_->clientSettings.defaultSubscriptionSettings,
-                        subscription);
-            }
-
-             // check if the subscription was acquired
-            if (ret.isGood())
-            {
-                // copy the subscription information to the invocation
-                logger_->debug("Copying the subscription information to the invocation");
-                invocation.setSubscriptionInformation(subscription->subscriptionInformation());
+                // try to acquire a subscription for the given subscription settings
+                uaf::Subscription* subscription = 0;
 
-                if (subscription->isCreated())
-                {
-                    logger_->debug("Forwarding the invocation to subscription %d",
-                                   subscription->clientSubscriptionHandle());
-                    ret = subscription->invokeService(invocation, nameSpaceArray, serverArray);
-                }
+                if (request.clientSubscriptionHandleGiven)
+                    ret = acquireExistingSubscription(request.clientSubscriptionHandle, subscription);
                 else
+                    ret = acquireSubscription(subscriptionSettings, subscription);
+
+                 // check if the subscription was acquired
+                if (ret.isGood())
                 {
-                    ret = uaf::SubscriptionNotCreatedError();
+                    // copy the subscription information to the invocation
+                    logger_->debug("Copying the subscription information to the invocation");
+                    invocation.setSubscriptionInformation(subscription->subscriptionInformation());
+
+                    if (subscription->isCreated())
+                    {
+                        logger_->debug("Forwarding the invocation to subscription %d",
+                                       subscription->clientSubscriptionHandle());
+                        ret = subscription->invokeService(invocation, nameSpaceArray, serverArray);
+                    }
+                    else
+                    {
+                        ret = uaf::SubscriptionNotCreatedError();
+                    }
+
+                    releaseSubscription(subscription);
                 }
-
-                releaseSubscription(subscription);
             }
 
             return ret;
@@ -265,6 +317,238 @@ namespace uaf
         typedef std::map<uaf::TransactionId, uaf::RequestHandle> TransactionMap;
 
 
+        // the recovery thread may call recover()
+        class RecoveryWorker;
+        friend class RecoveryWorker;
+
+
+        /**
+         * The notifications that are missing for a subscription, and must still be recovered.
+         */
+        struct MissingNotifications
+        {
+            MissingNotifications()
+            : clientSubscriptionHandle(0), previousSequenceNumber(0), newSequenceNumber(0) {}
+            /** The handle of the subscription with the missing notifications. */
+            uaf::ClientSubscriptionHandle   clientSubscriptionHandle;
+            /** The sequence number before the missing ones. */
+            uint32_t                        previousSequenceNumber;
+            /** The sequence number after the missing ones. */
+            uint32_t                        newSequenceNumber;
+        };
+
+
+        /**
+         * The thread that republishes the missing notifications, so that the SDK doesn't have to
+         * wait for the server in its notificationsMissing callback.
+         */
+        class RecoveryWorker : private UaThread
+        {
+        public:
+            RecoveryWorker(uaf::SubscriptionFactory* factory) : factory_(factory) {}
+            void startWorking() { start(); }
+            void waitUntilFinished() { wait(); }
+        private:
+            DISALLOW_COPY_AND_ASSIGN(RecoveryWorker);
+            void run() { factory_->recover(); }
+            uaf::SubscriptionFactory* factory_;
+        };
+
+
+        /**
+         * The loop of the recovery thread.
+         */
+        void recover();
+
+
+        /**
+         * Schedule the recovery of missing notifications (and start the recovery thread if it
+         * isn't running yet).
+         */
+        void scheduleRecovery(const MissingNotifications& missing);
+
+
+        /**
+         * Republish the missing notifications of a subscription, and report the ones that
+         * could not be recovered to the client interface.
+         */
+        void recoverMissingNotifications(const MissingNotifications& missing);
+
+
+        /**
+         * Execute a service invocation by spreading its targets over multiple subscriptions
+         * ("shards").
+         *
+         * The targets are grouped by the settings of the shard that should host them (see
+         * shardSettings()), and each group is added to the least loaded shard(s) with these
+         * settings, without exceeding the maxMonitoredItemsPerSubscription of the client settings.
+         * Each shard is invoked separately, and the results are copied back to the original
+         * invocation, together with the ClientSubscriptionHandle of the shard.
+         *
+         * The returned status is only bad in case of a client-side error that affects all
+         * targets: if a shard could not be acquired or invoked, the status of the affected
+         * targets is set instead.
+         *
+         * @tparam _Service      The service to be invoked (uaf::CreateMonitoredDataService or
+         *                       uaf::CreateMonitoredEventsService).
+         * @param invocation     The invocation to be executed.
+         * @param subscriptionSettings  The settings of the subscription, as requested.
+         * @param nameSpaceArray The name space array as fetched by the client.
+         * @param serverArray    The server array as fetched by the client.
+         */
+        template<typename _Service>
+        uaf::Status invokeShardedService(
+                typename _Service::Invocation&      invocation,
+                const uaf::SubscriptionSettings&    subscriptionSettings,
+                const uaf::NamespaceArray&          nameSpaceArray,
+                const uaf::ServerArray&             serverArray)
+        {
+            typedef typename _Service::Invocation Invocation;
+            typedef std::map<uaf::SubscriptionSettings, std::vector<std::size_t> > ShardGroups;
+
+            uaf::Status ret(uaf::statuscodes::Good);
+
+            // group the targets by the settings of the shard that should host them
+            ShardGroups groups;
+            for (std::size_t i = 0; i < invocation.requestTargets().size(); i++)
+                groups[shardSettings(subscriptionSettings,
+                                     invocation.requestTargets()[i].samplingIntervalSec)].push_back(i);
+
+            logger_->debug("Sharding %d targets over %d group(s) of subscriptions",
+                           invocation.requestTargets().size(), groups.size());
+
+            // the targets may end up in different subscriptions, so the result targets
+            // will hold the handle of their own subscription
+            uaf::SubscriptionInformation shardedInformation;
+            shardedInformation.clientSubscriptionHandle
+                = uaf::constants::CLIENTSUBSCRIPTIONHANDLE_NOT_ASSIGNED;
+            invocation.setSubscriptionInformation(shardedInformation);
+
+            uint32_t maxItems = database_->clientSettings.maxMonitoredItemsPerSubscription;
+
+            for (typename ShardGroups::const_iterator it = groups.begin(); it != groups.end(); ++it)
+            {
+                const std::vector<std::size_t>& indexes = it->second;
+                std::size_t next = 0;
+
+                while (next < indexes.size())
+                {
+                    uaf::Subscription* subscription = 0;
+                    std::size_t itemCount = 0;
+                    std::size_t noOfTargets = indexes.size() - next;
+
+                    uaf::Status shardStatus = acquireShard(it->first, subscription, itemCount);
+
+                    if (shardStatus.isGood())
+                    {
+                        uaf::ClientSubscriptionHandle handle = subscription->clientSubscriptionHandle();
+
+                        if (maxItems > 0 && maxItems - itemCount < noOfTargets)
+                            noOfTargets = maxItems - itemCount;
+
+                        logger_->debug("Adding %d targets to shard %d (which has %d items)",
+                                       noOfTargets, handle, itemCount);
+
+                        // build an invocation for this shard only
+                        Invocation shardInvocation;
+                        shardInvocation.setRequestHandle(invocation.requestHandle());
+                        shardInvocation.setTrace(invocation.trace());
+                        shardInvocation.setServiceSettings(invocation.serviceSettings());
+                        shardInvocation.setSubscriptionInformation(
+                                subscription->subscriptionInformation());
+                        shardInvocation.reserveTargets(noOfTargets);
+
+                        for (std::size_t j = 0; j < noOfTargets; j++)
+                        {
+                            std::size_t i = indexes[next + j];
+                            shardInvocation.addTarget(invocation.ranks()[i],
+                                                      invocation.requestTargets()[i],
+                                                      invocation.resultTargets()[i]);
+                        }
+
+                        if (subscription->isCreated())
+                            shardStatus = subscription->invokeService(
+                                    shardInvocation, nameSpaceArray, serverArray);
+                        else
+                            shardStatus = uaf::SubscriptionNotCreatedError();
+
+                        releaseSubscription(subscription);
+
+                        // copy the results of the shard back to the original invocation
+                        for (std::size_t j = 0; j < noOfTargets; j++)
+                        {
+                            std::size_t i = indexes[next + j];
+                            invocation.resultTargets()[i] = shardInvocation.resultTargets()[j];
+                            invocation.resultTargets()[i].clientSubscriptionHandle = handle;
+                            if (shardStatus.isNotGood())
+                                invocation.resultTargets()[i].status = shardStatus;
+                        }
+                    }
+                    else
+                    {
+                        for (std::size_t j = 0; j < noOfTargets; j++)
+                            invocation.resultTargets()[indexes[next + j]].status = shardStatus;
+                    }
+
+                    next += noOfTargets;
+                }
+            }
+
+            return ret;
+        }
+
+
+        /**
+         * Get the settings of the shard that should host a monitored item with the given
+         * sampling interval.
+         *
+         * @param subscriptionSettings  The settings of the subscription, as requested.
+         * @param samplingIntervalSec   The sampling interval of the monitored item.
+         * @return                      The requested settings, but publishing at the sampling
+         *                              interval if the monitored item is sampled slower (and if
+         *                              the client settings say to group items by sampling interval).
+         */
+        uaf::SubscriptionSettings shardSettings(
+                const uaf::SubscriptionSettings&    subscriptionSettings,
+                double                              samplingIntervalSec) const;
+
+
+        /**
+         * Acquire the least loaded shard with the given settings that still has room for more
+         * monitored items (or create a new one if all of them are full).
+         *
+         * The 'subscription' pointer can be used safely as long as releaseSubscription() is not
+         * called by the same thread.
+         *
+         * @param subscriptionSettings  Settings of the shard to be acquired.
+         * @param subscription          Pointer to the acquired shard.
+         * @param monitoredItemCount    Output parameter: the number of monitored items that are
+         *                              already owned by the shard.
+         * @return                      Status object, will be erroneous in case no shard could be
+         *                              provided via the 'subscription' argument.
+         */
+        uaf::Status acquireShard(
+                const uaf::SubscriptionSettings&    subscriptionSettings,
+                uaf::Subscription*&                 subscription,
+                std::size_t&                        monitoredItemCount);
+
+
+        /**
+         * Create a new subscription with the given settings, and create it on the server.
+         *
+         * The subscriptionMapMutex_ must be locked by the caller. The new subscription is stored
+         * with an activity count of 1, so it must be released by the caller.
+         *
+         * @param subscriptionSettings  Settings of the subscription to be created.
+         * @param subscription          Pointer to the new subscription.
+         * @return                      The result of the creation of the subscription on the
+         *                              server.
+         */
+        uaf::Status createNewSubscription(
+                const uaf::SubscriptionSettings&    subscriptionSettings,
+                uaf::Subscription*&                 subscription);
+
+
         /**
          * Acquire a subscription with the given properties (by getting an existing one, or creating
          * a new one if a suitable one doesn't exist already).
@@ -318,9 +602,9 @@ namespace uaf
                 bool                    allowGarbageCollection=true);
 
 
-        // pointer to the SDK session instance of the uaf::Session instance that owns
+        // pointer to the session transport of the uaf::Session instance that owns
         // this subscription factory.
-        UaClientSdk::UaSession* uaSession_;
+        uaf::SessionTransport*  uaSession_;
         // the connection ID of the uaf::Session instance that owns this subscription factory.
         uaf::ClientConnectionId clientConnectionId_;
         // logger of the subscription factory
@@ -343,6 +627,14 @@ namespace uaf
         // the container that stores the transactions, and its mutex
         TransactionMap transactionMap_;
         UaMutex        transactionMapMutex_;
+        // the thread that recovers missing notifications (only started when needed), the
+        // notifications that it must still recover, the flag to stop it, and their mutex
+        RecoveryWorker*                     recoveryWorker_;
+        std::deque<MissingNotifications>    missingNotifications_;
+        bool                                recoveryStopped_;
+        UaMutex                             recoveryMutex_;
+        // the semaphore that is posted for every scheduled recovery (and to stop the thread)
+        UaSemaphore                         recoverySemaphore_;
 
 
         /**
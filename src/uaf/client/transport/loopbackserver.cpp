@@ -0,0 +1,576 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/transport/loopbackserver.h"
+#include "uaf/client/transport/loopbacksessiontransport.h"
+#include "uaf/client/metrics/metricsregistry.h"
+#include "uaf/util/datetime.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::map;
+
+
+    namespace
+    {
+        // the prefix of the BrowseNames of the variables
+        const char* const VARIABLE_NAME_PREFIX = "Variable";
+        // the string identifier of the echo method
+        const char* const ECHO_METHOD_NAME = "Echo";
+        // the namespace index of the variables and the method
+        const OpcUa_UInt16 NAMESPACE_INDEX = 1;
+        // the (very long) identifier of the MaxNodesPerTranslateBrowsePathsToNodeIds node
+        const OpcUa_UInt32 MAX_NODES_PER_TRANSLATE_ID =
+        OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerTranslateBrowsePathsToNodeIds;
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    LoopbackServer::LoopbackServer(const LoopbackServerSettings& settings)
+    : settings_(settings),
+      nextContinuationPointId_(1),
+      noOfRequests_(0),
+      noOfOperations_(0)
+    {
+        values_.resize(settings_.numberOfVariables);
+        versions_.resize(settings_.numberOfVariables, 0);
+
+        for (uint32_t i = 0; i < settings_.numberOfVariables; i++)
+            values_[i].setDouble(OpcUa_Double(i));
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    LoopbackServer::~LoopbackServer()
+    {}
+
+
+    // Get the NodeId of a variable
+    // =============================================================================================
+    NodeId LoopbackServer::variableNodeId(uint32_t index) const
+    {
+        return NodeId(index, settings_.namespaceUri, NAMESPACE_INDEX);
+    }
+
+
+    // Get the BrowseName of a variable
+    // =============================================================================================
+    QualifiedName LoopbackServer::variableBrowseName(uint32_t index) const
+    {
+        stringstream ss;
+        ss << VARIABLE_NAME_PREFIX << index;
+        return QualifiedName(ss.str(), settings_.namespaceUri, NAMESPACE_INDEX);
+    }
+
+
+    // Get the NodeId of the echo method
+    // =============================================================================================
+    NodeId LoopbackServer::echoMethodId() const
+    {
+        return NodeId(ECHO_METHOD_NAME, settings_.namespaceUri, NAMESPACE_INDEX);
+    }
+
+
+    // Get the number of requests
+    // =============================================================================================
+    uint64_t LoopbackServer::numberOfRequests() const
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return noOfRequests_;
+    }
+
+
+    // Get the number of operations
+    // =============================================================================================
+    uint64_t LoopbackServer::numberOfOperations() const
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return noOfOperations_;
+    }
+
+
+    // Create a session transport
+    // =============================================================================================
+    SessionTransport* LoopbackServer::createSessionTransport()
+    {
+        return new LoopbackSessionTransport(this);
+    }
+
+
+    // Get the discovery URLs of the server
+    // =============================================================================================
+    bool LoopbackServer::discoveryUrls(const string& serverUri, vector<string>& discoveryUrls)
+    {
+        if (serverUri != settings_.serverUri)
+            return false;
+
+        discoveryUrls.push_back(settings_.endpointUrl);
+        return true;
+    }
+
+
+    // Get the endpoints of the server
+    // =============================================================================================
+    bool LoopbackServer::endpoints(
+            const string&                   discoveryUrl,
+            vector<EndpointDescription>&    endpointDescriptions)
+    {
+        if (discoveryUrl != settings_.endpointUrl)
+            return false;
+
+        UserTokenPolicy anonymous;
+        anonymous.policyId  = "Anonymous";
+        anonymous.tokenType = usertokentypes::Anonymous;
+
+        EndpointDescription endpoint;
+        endpoint.endpointUrl                = settings_.endpointUrl;
+        endpoint.server.applicationUri      = settings_.serverUri;
+        endpoint.server.applicationName     = LocalizedText("", "LoopbackServer");
+        endpoint.server.applicationType     = applicationtypes::Server;
+        endpoint.server.discoveryUrls.push_back(settings_.endpointUrl);
+        endpoint.securityMode               = messagesecuritymodes::Mode_None;
+        endpoint.securityPolicyUri          = securitypolicies::UA_None;
+        endpoint.userIdentityTokens.push_back(anonymous);
+
+        endpointDescriptions.push_back(endpoint);
+        return true;
+    }
+
+
+    // Start to handle a request
+    // =============================================================================================
+    UaStatus LoopbackServer::beginRequest(
+            OpcUa_UInt32    noOfOperations,
+            OpcUa_UInt32    maxOperations,
+            uint64_t&       latencyNs)
+    {
+        latencyNs = uint64_t(settings_.latencySec * 1.0e9)
+                  + uint64_t(settings_.latencyPerOperationSec * 1.0e9) * noOfOperations;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        noOfRequests_++;
+
+        if (settings_.failEveryNthRequest != 0
+                && noOfRequests_ % settings_.failEveryNthRequest == 0)
+            return UaStatus(settings_.failedRequestStatusCode);
+        else if (noOfOperations == 0)
+            return UaStatus(OpcUa_BadNothingToDo);
+        else if (maxOperations != 0 && noOfOperations > maxOperations)
+            return UaStatus(OpcUa_BadTooManyOperations);
+        else
+            return UaStatus(OpcUa_Good);
+    }
+
+
+    // Simulate the latency of a synchronous request
+    // =============================================================================================
+    void LoopbackServer::simulateLatency(uint64_t latencyNs)
+    {
+        if (latencyNs == 0)
+            return;
+
+        uint64_t end = MetricsRegistry::now() + latencyNs;
+
+        // sleep for the whole milliseconds, and spin for the rest
+        if (latencyNs >= 1000000)
+            DateTime::msleep(uint32_t(latencyNs / 1000000));
+
+        while (MetricsRegistry::now() < end) {}
+    }
+
+
+    // Get the index of a variable
+    // =============================================================================================
+    bool LoopbackServer::variableIndex(const UaNodeId& nodeId, uint32_t& index) const
+    {
+        if (   nodeId.namespaceIndex() != NAMESPACE_INDEX
+            || nodeId.identifierType() != OpcUa_IdentifierType_Numeric
+            || nodeId.identifierNumeric() >= settings_.numberOfVariables)
+            return false;
+
+        index = nodeId.identifierNumeric();
+        return true;
+    }
+
+
+    // Get the version of a variable
+    // =============================================================================================
+    uint64_t LoopbackServer::variableVersion(uint32_t index)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return versions_[index];
+    }
+
+
+    // Get the value of a variable
+    // =============================================================================================
+    void LoopbackServer::readVariable(uint32_t index, OpcUa_DataValue& dataValue)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        values_[index].copyTo(&dataValue.Value);
+        dataValue.StatusCode      = OpcUa_Good;
+        dataValue.SourceTimestamp = UaDateTime::now();
+        dataValue.ServerTimestamp = dataValue.SourceTimestamp;
+    }
+
+
+    // Get the status of the next operation
+    // =============================================================================================
+    OpcUa_StatusCode LoopbackServer::nextOperationStatus()
+    {
+        noOfOperations_++;
+
+        if (settings_.failEveryNthOperation != 0
+                && noOfOperations_ % settings_.failEveryNthOperation == 0)
+            return settings_.failedOperationStatusCode;
+        else
+            return OpcUa_Good;
+    }
+
+
+    // Read an attribute
+    // =============================================================================================
+    void LoopbackServer::read(
+            const OpcUa_ReadValueId&    nodeToRead,
+            OpcUa_TimestampsToReturn    timestampsToReturn,
+            OpcUa_DataValue&            result)
+    {
+        result.StatusCode = nextOperationStatus();
+        if (OpcUa_IsBad(result.StatusCode))
+            return;
+
+        UaNodeId    nodeId(nodeToRead.NodeId);
+        UaVariant   value;
+        uint32_t    index;
+
+        if (variableIndex(nodeId, index))
+        {
+            stringstream name;
+            name << VARIABLE_NAME_PREFIX << index;
+
+            switch (nodeToRead.AttributeId)
+            {
+                case OpcUa_Attributes_Value:
+                    value = values_[index];
+                    break;
+                case OpcUa_Attributes_NodeId:
+                    value.setNodeId(nodeId);
+                    break;
+                case OpcUa_Attributes_NodeClass:
+                    value.setInt32(OpcUa_NodeClass_Variable);
+                    break;
+                case OpcUa_Attributes_BrowseName:
+                    value.setQualifiedName(UaQualifiedName(name.str().c_str(), NAMESPACE_INDEX));
+                    break;
+                case OpcUa_Attributes_DisplayName:
+                    value.setLocalizedText(UaLocalizedText("", name.str().c_str()));
+                    break;
+                default:
+                    result.StatusCode = OpcUa_BadAttributeIdInvalid;
+            }
+        }
+        else if (nodeId.namespaceIndex() == 0
+                 && nodeId.identifierType() == OpcUa_IdentifierType_Numeric
+                 && nodeToRead.AttributeId == OpcUa_Attributes_Value)
+        {
+            UaStringArray uris;
+
+            switch (nodeId.identifierNumeric())
+            {
+                case OpcUaId_Server_ServerArray:
+                    uris.create(1);
+                    UaString(settings_.serverUri.c_str()).copyTo(&uris[0]);
+                    value.setStringArray(uris);
+                    break;
+                case OpcUaId_Server_NamespaceArray:
+                    uris.create(2);
+                    UaString("http://opcfoundation.org/UA/").copyTo(&uris[0]);
+                    UaString(settings_.namespaceUri.c_str()).copyTo(&uris[1]);
+                    value.setStringArray(uris);
+                    break;
+                case OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerRead:
+                    value.setUInt32(settings_.maxNodesPerRead);
+                    break;
+                case OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerWrite:
+                    value.setUInt32(settings_.maxNodesPerWrite);
+                    break;
+                case OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerMethodCall:
+                    value.setUInt32(settings_.maxNodesPerMethodCall);
+                    break;
+                case OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerBrowse:
+                    value.setUInt32(settings_.maxNodesPerBrowse);
+                    break;
+                case OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerRegisterNodes:
+                    value.setUInt32(settings_.maxNodesPerRegisterNodes);
+                    break;
+                case MAX_NODES_PER_TRANSLATE_ID:
+                    value.setUInt32(settings_.maxNodesPerTranslateBrowsePathsToNodeIds);
+                    break;
+                case OpcUaId_Server_ServerCapabilities_OperationLimits_MaxMonitoredItemsPerCall:
+                    value.setUInt32(settings_.maxMonitoredItemsPerCall);
+                    break;
+                default:
+                    result.StatusCode = OpcUa_BadNodeIdUnknown;
+            }
+        }
+        else
+        {
+            result.StatusCode = OpcUa_BadNodeIdUnknown;
+        }
+
+        if (OpcUa_IsBad(result.StatusCode))
+            return;
+
+        value.copyTo(&result.Value);
+
+        if (   timestampsToReturn == OpcUa_TimestampsToReturn_Source
+            || timestampsToReturn == OpcUa_TimestampsToReturn_Both)
+            result.SourceTimestamp = UaDateTime::now();
+
+        if (   timestampsToReturn == OpcUa_TimestampsToReturn_Server
+            || timestampsToReturn == OpcUa_TimestampsToReturn_Both)
+            result.ServerTimestamp = UaDateTime::now();
+    }
+
+
+    // Write an attribute
+    // =============================================================================================
+    OpcUa_StatusCode LoopbackServer::write(const OpcUa_WriteValue& nodeToWrite)
+    {
+        OpcUa_StatusCode ret = nextOperationStatus();
+        if (OpcUa_IsBad(ret))
+            return ret;
+
+        uint32_t index;
+
+        if (!variableIndex(UaNodeId(nodeToWrite.NodeId), index))
+            return OpcUa_BadNodeIdUnknown;
+        else if (nodeToWrite.AttributeId != OpcUa_Attributes_Value)
+            return OpcUa_BadNotWritable;
+
+        values_[index] = UaVariant(nodeToWrite.Value.Value);
+        versions_[index]++;
+        return OpcUa_Good;
+    }
+
+
+    // Browse a node
+    // =============================================================================================
+    void LoopbackServer::browse(
+            const OpcUa_BrowseDescription&  nodeToBrowse,
+            OpcUa_UInt32                    maxReferencesToReturn,
+            OpcUa_BrowseResult&             result)
+    {
+        result.StatusCode = nextOperationStatus();
+        if (OpcUa_IsBad(result.StatusCode))
+            return;
+
+        UaNodeId nodeId(nodeToBrowse.NodeId);
+        uint32_t index;
+
+        // the server may return less references than requested, but not more
+        OpcUa_UInt32 maxReferences = settings_.maxReferencesPerNode;
+        if (   maxReferencesToReturn != 0
+            && (maxReferences == 0 || maxReferencesToReturn < maxReferences))
+            maxReferences = maxReferencesToReturn;
+
+        if (nodeId == UaNodeId(OpcUaId_ObjectsFolder))
+        {
+            // only the Objects folder has (forward) references
+            if (nodeToBrowse.BrowseDirection != OpcUa_BrowseDirection_Inverse)
+                addReferences(0, maxReferences, result);
+        }
+        else if (!variableIndex(nodeId, index))
+        {
+            result.StatusCode = OpcUa_BadNodeIdUnknown;
+        }
+    }
+
+
+    // Continue browsing a node
+    // =============================================================================================
+    void LoopbackServer::browseNext(
+            OpcUa_Boolean                   releaseContinuationPoint,
+            const OpcUa_ByteString&         continuationPoint,
+            OpcUa_BrowseResult&             result)
+    {
+        result.StatusCode = nextOperationStatus();
+        if (OpcUa_IsBad(result.StatusCode))
+            return;
+
+        OpcUa_UInt32 id = 0;
+        if (continuationPoint.Length == sizeof(id))
+            memcpy(&id, continuationPoint.Data, sizeof(id));
+
+        map<OpcUa_UInt32, ContinuationPoint>::iterator it = continuationPoints_.find(id);
+
+        if (it == continuationPoints_.end())
+        {
+            result.StatusCode = OpcUa_BadContinuationPointInvalid;
+            return;
+        }
+
+        ContinuationPoint point = it->second;
+        continuationPoints_.erase(it);
+
+        if (!releaseContinuationPoint)
+            addReferences(point.offset, point.maxReferences, result);
+    }
+
+
+    // Add the references of the Objects folder
+    // =============================================================================================
+    void LoopbackServer::addReferences(
+            OpcUa_UInt32        offset,
+            OpcUa_UInt32        maxReferences,
+            OpcUa_BrowseResult& result)
+    {
+        OpcUa_UInt32 noOfReferences = settings_.numberOfVariables - offset;
+        if (maxReferences != 0 && noOfReferences > maxReferences)
+            noOfReferences = maxReferences;
+
+        // store a continuation point if not all references fit in the result
+        if (offset + noOfReferences < settings_.numberOfVariables)
+        {
+            if (continuationPoints_.size() >= settings_.maxBrowseContinuationPoints)
+            {
+                result.StatusCode = OpcUa_BadNoContinuationPoints;
+                return;
+            }
+
+            OpcUa_UInt32 id = nextContinuationPointId_++;
+            ContinuationPoint& point = continuationPoints_[id];
+            point.offset        = offset + noOfReferences;
+            point.maxReferences = maxReferences;
+
+            UaByteString(sizeof(id), (OpcUa_Byte*)&id).copyTo(&result.ContinuationPoint);
+        }
+
+        UaReferenceDescriptions references;
+        references.create(noOfReferences);
+
+        for (OpcUa_UInt32 i = 0; i < noOfReferences; i++)
+        {
+            OpcUa_UInt32 index = offset + i;
+            stringstream name;
+            name << VARIABLE_NAME_PREFIX << index;
+
+            references[i].IsForward = OpcUa_True;
+            references[i].NodeClass = OpcUa_NodeClass_Variable;
+            UaNodeId(OpcUaId_Organizes).copyTo(&references[i].ReferenceTypeId);
+            UaNodeId(index, NAMESPACE_INDEX).copyTo(&references[i].NodeId.NodeId);
+            UaQualifiedName(name.str().c_str(), NAMESPACE_INDEX).copyTo(
+                    &references[i].BrowseName);
+            UaLocalizedText("", name.str().c_str()).copyTo(&references[i].DisplayName);
+            UaNodeId(OpcUaId_BaseDataVariableType).copyTo(&references[i].TypeDefinition.NodeId);
+        }
+
+        result.NoOfReferences = references.length();
+        result.References     = references.detach();
+    }
+
+
+    // Translate a browse path
+    // =============================================================================================
+    void LoopbackServer::translate(
+            const OpcUa_BrowsePath&     browsePath,
+            OpcUa_BrowsePathResult&     result)
+    {
+        result.StatusCode = nextOperationStatus();
+        if (OpcUa_IsBad(result.StatusCode))
+            return;
+
+        result.StatusCode = OpcUa_BadNoMatch;
+
+        // only the variables can be found, by their BrowseName relative to the Objects folder
+        if (   UaNodeId(browsePath.StartingNode) != UaNodeId(OpcUaId_ObjectsFolder)
+            || browsePath.RelativePath.NoOfElements != 1)
+            return;
+
+        const OpcUa_QualifiedName& targetName = browsePath.RelativePath.Elements[0].TargetName;
+        string name(UaString(&targetName.Name).toUtf8());
+        string prefix(VARIABLE_NAME_PREFIX);
+
+        if (   targetName.NamespaceIndex != NAMESPACE_INDEX
+            || name.size() <= prefix.size()
+            || name.compare(0, prefix.size(), prefix) != 0)
+            return;
+
+        uint32_t index = 0;
+        for (std::size_t i = prefix.size(); i < name.size(); i++)
+        {
+            if (name[i] < '0' || name[i] > '9')
+                return;
+            index = index * 10 + uint32_t(name[i] - '0');
+        }
+
+        if (index >= settings_.numberOfVariables)
+            return;
+
+        UaBrowsePathTargets targets;
+        targets.create(1);
+        UaNodeId(index, NAMESPACE_INDEX).copyTo(&targets[0].TargetId.NodeId);
+        targets[0].RemainingPathIndex = OpcUa_UInt32_Max;
+
+        result.StatusCode = OpcUa_Good;
+        result.NoOfTargets = targets.length();
+        result.Targets     = targets.detach();
+    }
+
+
+    // Call a method
+    // =============================================================================================
+    OpcUa_StatusCode LoopbackServer::call(
+            const UaNodeId&         methodId,
+            OpcUa_Int32             noOfInputArguments,
+            const OpcUa_Variant*    inputArguments,
+            UaVariantArray&         outputArguments,
+            UaStatusCodeArray&      inputArgumentResults)
+    {
+        OpcUa_StatusCode ret = nextOperationStatus();
+        if (OpcUa_IsBad(ret))
+            return ret;
+
+        if (methodId != UaNodeId(UaString(ECHO_METHOD_NAME), NAMESPACE_INDEX))
+            return OpcUa_BadMethodInvalid;
+
+        OpcUa_UInt32 n = noOfInputArguments > 0 ? OpcUa_UInt32(noOfInputArguments) : 0;
+
+        outputArguments.create(n);
+        inputArgumentResults.create(n);
+
+        for (OpcUa_UInt32 i = 0; i < n; i++)
+        {
+            UaVariant(inputArguments[i]).copyTo(&outputArguments[i]);
+            inputArgumentResults[i] = OpcUa_Good;
+        }
+
+        return OpcUa_Good;
+    }
+
+}
@@ -0,0 +1,263 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_LOOPBACKSERVER_H_
+#define UAF_LOOPBACKSERVER_H_
+
+
+
+// STD
+#include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <cstring>
+#include <stdint.h>
+// SDK
+#include "uabase/uamutex.h"
+#include "uabase/uavariant.h"
+#include "uabase/uanodeid.h"
+#include "uabase/statuscode.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/nodeid.h"
+#include "uaf/util/qualifiedname.h"
+#include "uaf/util/endpointdescription.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/transport/sessiontransportfactory.h"
+#include "uaf/client/transport/loopbackserversettings.h"
+
+
+
+namespace uaf
+{
+
+    class LoopbackSessionTransport;
+    class LoopbackSubscriptionTransport;
+
+
+    /*******************************************************************************************//**
+    * A uaf::LoopbackServer is a simulated OPC UA server in the same process as the client.
+    *
+    * When it is set as the session transport factory of a client (see
+    * uaf::Client::setSessionTransportFactory()), all sessions of the client are connected to
+    * this server instead of a real one, and every service is handled in memory: there is no
+    * network, no encoding and no security involved. The whole client stack (resolution,
+    * invocations, sessions, subscriptions, ...) can therefore be tested and benchmarked
+    * deterministically, on a single machine.
+    *
+    * The server has a flat address space: the Objects folder organizes
+    * uaf::LoopbackServerSettings::numberOfVariables writable variables (see variableNodeId() and
+    * variableBrowseName()), and a method "Echo" that returns its input arguments. It also
+    * exposes the ServerArray, the NamespaceArray and the OperationLimits. The latency, the
+    * failed requests and operations, the OperationLimits, the browse continuation points and
+    * the publish stream of the subscriptions are configured by the uaf::LoopbackServerSettings.
+    *
+    * The server must outlive the clients that use it. Event monitored items can be created, but
+    * no events are ever notified.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT LoopbackServer : public uaf::SessionTransportFactory
+    {
+    public:
+
+
+        /**
+         * Create a loopback server.
+         *
+         * @param settings  The settings of the server.
+         */
+        LoopbackServer(const uaf::LoopbackServerSettings& settings = uaf::LoopbackServerSettings());
+
+
+        /**
+         * Destruct the loopback server.
+         */
+        virtual ~LoopbackServer();
+
+
+        /**
+         * Get the settings of the server.
+         */
+        const uaf::LoopbackServerSettings& settings() const { return settings_; }
+
+
+        /**
+         * Get the NodeId of a variable.
+         *
+         * @param index The index of the variable (0 to numberOfVariables - 1).
+         */
+        uaf::NodeId variableNodeId(uint32_t index) const;
+
+
+        /**
+         * Get the BrowseName of a variable (relative to the Objects folder).
+         *
+         * @param index The index of the variable (0 to numberOfVariables - 1).
+         */
+        uaf::QualifiedName variableBrowseName(uint32_t index) const;
+
+
+        /**
+         * Get the NodeId of the method that returns its input arguments.
+         */
+        uaf::NodeId echoMethodId() const;
+
+
+        /**
+         * Get the number of service requests that were received by the server.
+         */
+        uint64_t numberOfRequests() const;
+
+
+        /**
+         * Get the number of operations (e.g. nodes to read) that were received by the server.
+         */
+        uint64_t numberOfOperations() const;
+
+
+        // overridden from uaf::SessionTransportFactory
+        virtual uaf::SessionTransport* createSessionTransport();
+        virtual bool discoveryUrls(
+                const std::string&          serverUri,
+                std::vector<std::string>&   discoveryUrls);
+        virtual bool endpoints(
+                const std::string&                      discoveryUrl,
+                std::vector<uaf::EndpointDescription>&  endpointDescriptions);
+
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(LoopbackServer);
+
+        // the transports handle the services by calling the private methods below
+        friend class LoopbackSessionTransport;
+        friend class LoopbackSubscriptionTransport;
+
+
+        /**
+         * Start to handle a service request: count it, check the OperationLimit, and compute
+         * the latency.
+         *
+         * @param noOfOperations    The number of operations of the request.
+         * @param maxOperations     The OperationLimit of the service (0 = no limit).
+         * @param latencyNs         Output parameter: the latency to simulate, in nanoseconds.
+         * @return                  Good, or the status code of the failed request.
+         */
+        UaStatus beginRequest(
+                OpcUa_UInt32    noOfOperations,
+                OpcUa_UInt32    maxOperations,
+                uint64_t&       latencyNs);
+
+
+        /**
+         * Simulate the latency of a synchronous request, by blocking the calling thread.
+         */
+        static void simulateLatency(uint64_t latencyNs);
+
+
+        /**
+         * Get the index of the variable with the given NodeId.
+         *
+         * @return  False if the node is not a variable of the server.
+         */
+        bool variableIndex(const UaNodeId& nodeId, uint32_t& index) const;
+
+
+        /**
+         * Get the number of times a variable has been written (to notify only changed values).
+         */
+        uint64_t variableVersion(uint32_t index);
+
+
+        /**
+         * Get the value of a variable.
+         */
+        void readVariable(uint32_t index, OpcUa_DataValue& dataValue);
+
+
+        /**
+         * Handle the operations of the services. The mutex_ must be locked.
+         */
+        void read(
+                const OpcUa_ReadValueId&    nodeToRead,
+                OpcUa_TimestampsToReturn    timestampsToReturn,
+                OpcUa_DataValue&            result);
+        OpcUa_StatusCode write(const OpcUa_WriteValue& nodeToWrite);
+        void browse(
+                const OpcUa_BrowseDescription&  nodeToBrowse,
+                OpcUa_UInt32                    maxReferencesToReturn,
+                OpcUa_BrowseResult&             result);
+        void browseNext(
+                OpcUa_Boolean                   releaseContinuationPoint,
+                const OpcUa_ByteString&         continuationPoint,
+                OpcUa_BrowseResult&             result);
+        void translate(const OpcUa_BrowsePath& browsePath, OpcUa_BrowsePathResult& result);
+        OpcUa_StatusCode call(
+                const UaNodeId&     methodId,
+                OpcUa_Int32         noOfInputArguments,
+                const OpcUa_Variant* inputArguments,
+                UaVariantArray&     outputArguments,
+                UaStatusCodeArray&  inputArgumentResults);
+
+
+        /**
+         * Get the status code of the next operation (bad if the operation must fail).
+         * The mutex_ must be locked.
+         */
+        OpcUa_StatusCode nextOperationStatus();
+
+
+        /**
+         * Add the references of the Objects folder, starting from the given offset, to a
+         * browse result (with a continuation point if there are more references than the
+         * given maximum). The mutex_ must be locked.
+         */
+        void addReferences(
+                OpcUa_UInt32        offset,
+                OpcUa_UInt32        maxReferences,
+                OpcUa_BrowseResult& result);
+
+
+        // the settings
+        uaf::LoopbackServerSettings settings_;
+        // the values of the variables, and the number of times they were written
+        std::vector<UaVariant>      values_;
+        std::vector<uint64_t>       versions_;
+        // a browse continuation point: the next reference to return, and the max. number
+        struct ContinuationPoint
+        {
+            ContinuationPoint() : offset(0), maxReferences(0) {}
+            OpcUa_UInt32 offset;
+            OpcUa_UInt32 maxReferences;
+        };
+        // the browse continuation points, by id, and the id of the next one
+        std::map<OpcUa_UInt32, ContinuationPoint> continuationPoints_;
+        OpcUa_UInt32                              nextContinuationPointId_;
+        // the number of requests and operations that were received
+        uint64_t                    noOfRequests_;
+        uint64_t                    noOfOperations_;
+        // mutex to protect all of the above
+        mutable UaMutex             mutex_;
+    };
+}
+
+
+#endif /* UAF_LOOPBACKSERVER_H_ */
@@ -0,0 +1,158 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/transport/loopbackserversettings.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    LoopbackServerSettings::LoopbackServerSettings()
+    {
+        serverUri                                = "urn:uaf:loopback";
+        namespaceUri                             = "urn:uaf:loopback:demo";
+        endpointUrl                              = "opc.tcp://loopback:4840";
+        numberOfVariables                        = 1000;
+        latencySec                               = 0.0;
+        latencyPerOperationSec                   = 0.0;
+        failEveryNthRequest                      = 0;
+        failedRequestStatusCode                  = OpcUa_BadTimeout;
+        failEveryNthOperation                    = 0;
+        failedOperationStatusCode                = OpcUa_BadInternalError;
+        maxNodesPerRead                          = 0;
+        maxNodesPerWrite                         = 0;
+        maxNodesPerBrowse                        = 0;
+        maxNodesPerMethodCall                    = 0;
+        maxNodesPerTranslateBrowsePathsToNodeIds = 0;
+        maxNodesPerRegisterNodes                 = 0;
+        maxMonitoredItemsPerCall                 = 0;
+        maxReferencesPerNode                     = 100;
+        maxBrowseContinuationPoints              = 100;
+        minimumPublishingIntervalSec             = 0.001;
+        notifyUnchangedValues                    = true;
+        dropEveryNthPublish                      = 0;
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string LoopbackServerSettings::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - serverUri";
+        ss << fillToPos(ss, colon);
+        ss << ": " << serverUri << "\n";
+
+        ss << indent << " - namespaceUri";
+        ss << fillToPos(ss, colon);
+        ss << ": " << namespaceUri << "\n";
+
+        ss << indent << " - endpointUrl";
+        ss << fillToPos(ss, colon);
+        ss << ": " << endpointUrl << "\n";
+
+        ss << indent << " - numberOfVariables";
+        ss << fillToPos(ss, colon);
+        ss << ": " << numberOfVariables << "\n";
+
+        ss << indent << " - latencySec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << latencySec << "\n";
+
+        ss << indent << " - latencyPerOperationSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << latencyPerOperationSec << "\n";
+
+        ss << indent << " - failEveryNthRequest";
+        ss << fillToPos(ss, colon);
+        ss << ": " << failEveryNthRequest << "\n";
+
+        ss << indent << " - failedRequestStatusCode";
+        ss << fillToPos(ss, colon);
+        ss << ": " << failedRequestStatusCode << "\n";
+
+        ss << indent << " - failEveryNthOperation";
+        ss << fillToPos(ss, colon);
+        ss << ": " << failEveryNthOperation << "\n";
+
+        ss << indent << " - failedOperationStatusCode";
+        ss << fillToPos(ss, colon);
+        ss << ": " << failedOperationStatusCode << "\n";
+
+        ss << indent << " - maxNodesPerRead";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxNodesPerRead << "\n";
+
+        ss << indent << " - maxNodesPerWrite";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxNodesPerWrite << "\n";
+
+        ss << indent << " - maxNodesPerBrowse";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxNodesPerBrowse << "\n";
+
+        ss << indent << " - maxNodesPerMethodCall";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxNodesPerMethodCall << "\n";
+
+        ss << indent << " - maxNodesPerTranslateBrowsePathsToNodeIds";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxNodesPerTranslateBrowsePathsToNodeIds << "\n";
+
+        ss << indent << " - maxNodesPerRegisterNodes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxNodesPerRegisterNodes << "\n";
+
+        ss << indent << " - maxMonitoredItemsPerCall";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxMonitoredItemsPerCall << "\n";
+
+        ss << indent << " - maxReferencesPerNode";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxReferencesPerNode << "\n";
+
+        ss << indent << " - maxBrowseContinuationPoints";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxBrowseContinuationPoints << "\n";
+
+        ss << indent << " - minimumPublishingIntervalSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << minimumPublishingIntervalSec << "\n";
+
+        ss << indent << " - notifyUnchangedValues";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (notifyUnchangedValues ? string("true") : string("false")) << "\n";
+
+        ss << indent << " - dropEveryNthPublish";
+        ss << fillToPos(ss, colon);
+        ss << ": " << dropEveryNthPublish;
+
+        return ss.str();
+    }
+
+}
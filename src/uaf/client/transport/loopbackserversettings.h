@@ -0,0 +1,153 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_LOOPBACKSERVERSETTINGS_H_
+#define UAF_LOOPBACKSERVERSETTINGS_H_
+
+
+// STD
+#include <string>
+#include <stdint.h>
+#include <sstream>
+// SDK
+#include "uabase/statuscode.h"
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::LoopbackServerSettings instance stores the settings of a uaf::LoopbackServer: its
+    * address space, and the latency, errors and limits that it simulates.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT LoopbackServerSettings
+    {
+    public:
+
+
+        /**
+         * Construct default settings.
+         *
+         * Default values are:
+         *   - serverUri                                = "urn:uaf:loopback"
+         *   - namespaceUri                             = "urn:uaf:loopback:demo"
+         *   - endpointUrl                              = "opc.tcp://loopback:4840"
+         *   - numberOfVariables                        = 1000
+         *   - latencySec                               = 0.0
+         *   - latencyPerOperationSec                   = 0.0
+         *   - failEveryNthRequest                      = 0
+         *   - failedRequestStatusCode                  = OpcUa_BadTimeout
+         *   - failEveryNthOperation                    = 0
+         *   - failedOperationStatusCode                = OpcUa_BadInternalError
+         *   - maxNodesPerRead                          = 0
+         *   - maxNodesPerWrite                         = 0
+         *   - maxNodesPerBrowse                        = 0
+         *   - maxNodesPerMethodCall                    = 0
+         *   - maxNodesPerTranslateBrowsePathsToNodeIds = 0
+         *   - maxNodesPerRegisterNodes                 = 0
+         *   - maxMonitoredItemsPerCall                 = 0
+         *   - maxReferencesPerNode                     = 100
+         *   - maxBrowseContinuationPoints              = 100
+         *   - minimumPublishingIntervalSec             = 0.001
+         *   - notifyUnchangedValues                    = true
+         *   - dropEveryNthPublish                      = 0
+         */
+        LoopbackServerSettings();
+
+
+        /** The URI of the server (ServerArray[0]). */
+        std::string serverUri;
+
+        /** The URI of the namespace of the variables (NamespaceArray[1]). */
+        std::string namespaceUri;
+
+        /** The URL of the only endpoint of the server. */
+        std::string endpointUrl;
+
+        /** The number of variables. Variable i has NodeId ns=1;i=i and BrowseName
+            1:Variable<i>, and is organized by the Objects folder. */
+        uint32_t numberOfVariables;
+
+        /** The simulated latency of every service request, in seconds. */
+        double latencySec;
+
+        /** The additional simulated latency per operation of a service request (e.g. per node
+            to read), in seconds. */
+        double latencyPerOperationSec;
+
+        /** Fail every n-th service request with failedRequestStatusCode (0 = never). */
+        uint32_t failEveryNthRequest;
+
+        /** The status code of the failed service requests. */
+        uint32_t failedRequestStatusCode;
+
+        /** Fail every n-th operation (e.g. every n-th node to read) with
+            failedOperationStatusCode (0 = never). */
+        uint32_t failEveryNthOperation;
+
+        /** The status code of the failed operations. */
+        uint32_t failedOperationStatusCode;
+
+        /** The OperationLimits of the server (0 = no limit). Requests with more operations fail
+            with BadTooManyOperations, like the requests to a real server. */
+        uint32_t maxNodesPerRead;
+        uint32_t maxNodesPerWrite;
+        uint32_t maxNodesPerBrowse;
+        uint32_t maxNodesPerMethodCall;
+        uint32_t maxNodesPerTranslateBrowsePathsToNodeIds;
+        uint32_t maxNodesPerRegisterNodes;
+        uint32_t maxMonitoredItemsPerCall;
+
+        /** The max. number of references that the server returns per browsed node before it
+            returns a continuation point (0 = no limit). */
+        uint32_t maxReferencesPerNode;
+
+        /** The max. number of browse continuation points that the server keeps. */
+        uint32_t maxBrowseContinuationPoints;
+
+        /** The smallest publishing interval that the server accepts, in seconds. */
+        double minimumPublishingIntervalSec;
+
+        /** True to notify every monitored variable at every publishing interval (a stream of
+            notifications), false to notify only the variables that have been written. */
+        bool notifyUnchangedValues;
+
+        /** Lose every n-th NotificationMessage (0 = never), so that the client is told that
+            notifications are missing. */
+        uint32_t dropEveryNthPublish;
+
+
+        /**
+         * Get a string representation of the settings.
+         *
+         * @return  String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=44) const;
+
+    };
+}
+
+#endif /* UAF_LOOPBACKSERVERSETTINGS_H_ */
@@ -0,0 +1,790 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/transport/loopbacksessiontransport.h"
+#include "uaf/client/transport/loopbackserver.h"
+#include "uaf/client/metrics/metricsregistry.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::multimap;
+    using std::size_t;
+
+
+    namespace
+    {
+        // the maximum time that the worker thread sleeps when there's nothing to do
+        const uint64_t MAX_IDLE_TIME_NS = 1000000000ULL;
+
+
+        // job to pass the result of beginRead() to the callback
+        class ReadJob : public LoopbackSessionTransport::Job
+        {
+        public:
+            ReadJob(
+                    UaClientSdk::UaSessionCallback* callback,
+                    OpcUa_UInt32                    transactionId,
+                    const UaStatus&                 status,
+                    const UaDataValues&             values)
+            : callback_(callback), transactionId_(transactionId), status_(status), values_(values)
+            {}
+            void complete()
+            {
+                callback_->readComplete(transactionId_, status_, values_, diagnosticInfos_);
+            }
+        private:
+            UaClientSdk::UaSessionCallback* callback_;
+            OpcUa_UInt32                    transactionId_;
+            UaStatus                        status_;
+            UaDataValues                    values_;
+            UaDiagnosticInfos               diagnosticInfos_;
+        };
+
+
+        // job to pass the result of beginWrite() to the callback
+        class WriteJob : public LoopbackSessionTransport::Job
+        {
+        public:
+            WriteJob(
+                    UaClientSdk::UaSessionCallback* callback,
+                    OpcUa_UInt32                    transactionId,
+                    const UaStatus&                 status,
+                    const UaStatusCodeArray&        results)
+            : callback_(callback), transactionId_(transactionId), status_(status), results_(results)
+            {}
+            void complete()
+            {
+                callback_->writeComplete(transactionId_, status_, results_, diagnosticInfos_);
+            }
+        private:
+            UaClientSdk::UaSessionCallback* callback_;
+            OpcUa_UInt32                    transactionId_;
+            UaStatus                        status_;
+            UaStatusCodeArray               results_;
+            UaDiagnosticInfos               diagnosticInfos_;
+        };
+
+
+        // job to pass the result of beginCall() to the callback
+        class CallJob : public LoopbackSessionTransport::Job
+        {
+        public:
+            CallJob(
+                    UaClientSdk::UaSessionCallback* callback,
+                    OpcUa_UInt32                    transactionId,
+                    const UaStatus&                 status,
+                    const UaClientSdk::CallOut&     result)
+            : callback_(callback), transactionId_(transactionId), status_(status), result_(result)
+            {}
+            void complete()
+            {
+                callback_->callComplete(transactionId_, status_, result_);
+            }
+        private:
+            UaClientSdk::UaSessionCallback* callback_;
+            OpcUa_UInt32                    transactionId_;
+            UaStatus                        status_;
+            UaClientSdk::CallOut            result_;
+        };
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    LoopbackSessionTransport::LoopbackSessionTransport(LoopbackServer* server)
+    : server_(server),
+      callback_(0),
+      clientConnectionId_(0),
+      connected_(false),
+      worker_(0)
+    {}
+
+
+    // Destructor
+    // =============================================================================================
+    LoopbackSessionTransport::~LoopbackSessionTransport()
+    {
+        stopWorking();
+
+        for (size_t i = 0; i < subscriptions_.size(); i++)
+            delete subscriptions_[i];
+        subscriptions_.clear();
+    }
+
+
+    // Connect
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::connect(
+            const UaString&                     endpointUrl,
+            UaClientSdk::SessionConnectInfo&    sessionConnectInfo,
+            UaClientSdk::SessionSecurityInfo&   sessionSecurityInfo,
+            UaClientSdk::UaSessionCallback*     sessionCallback)
+    {
+        if (string(endpointUrl.toUtf8()) != server_->settings().endpointUrl)
+            return UaStatus(OpcUa_BadTcpEndpointUrlInvalid);
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (connected_)
+                return UaStatus(OpcUa_Good);
+
+            connected_          = true;
+            callback_           = sessionCallback;
+            clientConnectionId_ = sessionConnectInfo.clientConnectionId;
+            endpointUrl_        = endpointUrl;
+
+            worker_ = new Worker(this);
+            worker_->startWorking();
+        }
+
+        // like the SDK, report the new state before returning
+        sessionCallback->connectionStatusChanged(sessionConnectInfo.clientConnectionId,
+                                                 UaClientSdk::UaClient::Connected);
+
+        return UaStatus(OpcUa_Good);
+    }
+
+
+    // Disconnect
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::disconnect(
+            UaClientSdk::ServiceSettings&       serviceSettings,
+            OpcUa_Boolean                       deleteSubscriptions)
+    {
+        UaClientSdk::UaSessionCallback* callback;
+        OpcUa_UInt32 clientConnectionId;
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (!connected_)
+                return UaStatus(OpcUa_Good);
+
+            callback           = callback_;
+            clientConnectionId = clientConnectionId_;
+        }
+
+        // the subscriptions are always deleted, since they can't outlive the session
+        stopWorking();
+
+        callback->connectionStatusChanged(clientConnectionId, UaClientSdk::UaClient::Disconnected);
+
+        return UaStatus(OpcUa_Good);
+    }
+
+
+    // Is the session connected?
+    // =============================================================================================
+    OpcUa_Boolean LoopbackSessionTransport::isConnected() const
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return connected_ ? OpcUa_True : OpcUa_False;
+    }
+
+
+    // Get the server state
+    // =============================================================================================
+    UaClientSdk::UaClient::ServerStatus LoopbackSessionTransport::serverState() const
+    {
+        if (isConnected())
+            return UaClientSdk::UaClient::Connected;
+        else
+            return UaClientSdk::UaClient::Disconnected;
+    }
+
+
+    // Get the URL of the endpoint that is currently used
+    // =============================================================================================
+    UaString LoopbackSessionTransport::currentlyUsedEndpointUrl() const
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return endpointUrl_;
+    }
+
+
+    // Read the nodes
+    // =============================================================================================
+    void LoopbackSessionTransport::readNodes(
+            OpcUa_TimestampsToReturn    timestampsToReturn,
+            const UaReadValueIds&       nodesToRead,
+            UaDataValues&               values)
+    {
+        values.create(nodesToRead.length());
+
+        UaMutexLocker locker(&server_->mutex_); // unlocks when locker goes out of scope
+
+        for (OpcUa_UInt32 i = 0; i < nodesToRead.length(); i++)
+            server_->read(nodesToRead[i], timestampsToReturn, values[i]);
+    }
+
+
+    // Write the nodes
+    // =============================================================================================
+    void LoopbackSessionTransport::writeNodes(
+            const UaWriteValues&    nodesToWrite,
+            UaStatusCodeArray&      results)
+    {
+        results.create(nodesToWrite.length());
+
+        UaMutexLocker locker(&server_->mutex_); // unlocks when locker goes out of scope
+
+        for (OpcUa_UInt32 i = 0; i < nodesToWrite.length(); i++)
+            results[i] = server_->write(nodesToWrite[i]);
+    }
+
+
+    // Call a method
+    // =============================================================================================
+    void LoopbackSessionTransport::callMethod(
+            const UaClientSdk::CallIn&  callRequest,
+            UaClientSdk::CallOut&       result)
+    {
+        const OpcUa_Variant* inputArguments = 0;
+        if (callRequest.inputArguments.length() > 0)
+            inputArguments = &callRequest.inputArguments[0];
+
+        UaMutexLocker locker(&server_->mutex_); // unlocks when locker goes out of scope
+
+        result.callResult = server_->call(callRequest.methodId,
+                                          OpcUa_Int32(callRequest.inputArguments.length()),
+                                          inputArguments,
+                                          result.outputArguments,
+                                          result.inputArgumentResults);
+    }
+
+
+    // Read synchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::read(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_Double                    maxAge,
+            OpcUa_TimestampsToReturn        timestampsToReturn,
+            const UaReadValueIds&           nodesToRead,
+            UaDataValues&                   values,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(nodesToRead.length(),
+                                             server_->settings().maxNodesPerRead,
+                                             latencyNs);
+        if (ret.isGood())
+            readNodes(timestampsToReturn, nodesToRead, values);
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Read asynchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::beginRead(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_Double                    maxAge,
+            OpcUa_TimestampsToReturn        timestampsToReturn,
+            const UaReadValueIds&           nodesToRead,
+            OpcUa_UInt32                    transactionId)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus status = server_->beginRequest(nodesToRead.length(),
+                                                server_->settings().maxNodesPerRead,
+                                                latencyNs);
+        UaDataValues values;
+        if (status.isGood())
+            readNodes(timestampsToReturn, nodesToRead, values);
+
+        post(new ReadJob(callback_, transactionId, status, values),
+             MetricsRegistry::now() + latencyNs);
+        return UaStatus(OpcUa_Good);
+    }
+
+
+    // Write synchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::write(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaWriteValues&            nodesToWrite,
+            UaStatusCodeArray&              results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(nodesToWrite.length(),
+                                             server_->settings().maxNodesPerWrite,
+                                             latencyNs);
+        if (ret.isGood())
+            writeNodes(nodesToWrite, results);
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Write asynchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::beginWrite(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaWriteValues&            nodesToWrite,
+            OpcUa_UInt32                    transactionId)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus status = server_->beginRequest(nodesToWrite.length(),
+                                                server_->settings().maxNodesPerWrite,
+                                                latencyNs);
+        UaStatusCodeArray results;
+        if (status.isGood())
+            writeNodes(nodesToWrite, results);
+
+        post(new WriteJob(callback_, transactionId, status, results),
+             MetricsRegistry::now() + latencyNs);
+        return UaStatus(OpcUa_Good);
+    }
+
+
+    // Browse synchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::browseList(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const OpcUa_ViewDescription&    view,
+            OpcUa_UInt32                    maxReferencesToReturn,
+            const UaBrowseDescriptions&     nodesToBrowse,
+            UaBrowseResults&                results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(nodesToBrowse.length(),
+                                             server_->settings().maxNodesPerBrowse,
+                                             latencyNs);
+        if (ret.isGood())
+        {
+            results.create(nodesToBrowse.length());
+
+            UaMutexLocker locker(&server_->mutex_); // unlocks when locker goes out of scope
+
+            for (OpcUa_UInt32 i = 0; i < nodesToBrowse.length(); i++)
+                server_->browse(nodesToBrowse[i], maxReferencesToReturn, results[i]);
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Continue browsing synchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::browseListNext(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_Boolean                   releaseContinuationPoints,
+            const UaByteStringArray&        continuationPoints,
+            UaBrowseResults&                results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(continuationPoints.length(),
+                                             server_->settings().maxNodesPerBrowse,
+                                             latencyNs);
+        if (ret.isGood())
+        {
+            results.create(continuationPoints.length());
+
+            UaMutexLocker locker(&server_->mutex_); // unlocks when locker goes out of scope
+
+            for (OpcUa_UInt32 i = 0; i < continuationPoints.length(); i++)
+                server_->browseNext(releaseContinuationPoints, continuationPoints[i], results[i]);
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Translate browse paths synchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::translateBrowsePathsToNodeIds(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaBrowsePaths&            browsePaths,
+            UaBrowsePathResults&            results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(
+                browsePaths.length(),
+                server_->settings().maxNodesPerTranslateBrowsePathsToNodeIds,
+                latencyNs);
+        if (ret.isGood())
+        {
+            results.create(browsePaths.length());
+
+            UaMutexLocker locker(&server_->mutex_); // unlocks when locker goes out of scope
+
+            for (OpcUa_UInt32 i = 0; i < browsePaths.length(); i++)
+                server_->translate(browsePaths[i], results[i]);
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Call methods synchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::callList(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaCallMethodRequests&     callMethodRequests,
+            UaCallMethodResults&            results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(callMethodRequests.length(),
+                                             server_->settings().maxNodesPerMethodCall,
+                                             latencyNs);
+        if (ret.isGood())
+        {
+            results.create(callMethodRequests.length());
+
+            UaMutexLocker locker(&server_->mutex_); // unlocks when locker goes out of scope
+
+            for (OpcUa_UInt32 i = 0; i < callMethodRequests.length(); i++)
+            {
+                UaVariantArray      outputArguments;
+                UaStatusCodeArray   inputArgumentResults;
+
+                results[i].StatusCode = server_->call(UaNodeId(callMethodRequests[i].MethodId),
+                                                      callMethodRequests[i].NoOfInputArguments,
+                                                      callMethodRequests[i].InputArguments,
+                                                      outputArguments,
+                                                      inputArgumentResults);
+
+                results[i].NoOfOutputArguments      = outputArguments.length();
+                results[i].OutputArguments          = outputArguments.detach();
+                results[i].NoOfInputArgumentResults = inputArgumentResults.length();
+                results[i].InputArgumentResults     = inputArgumentResults.detach();
+            }
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Call a method asynchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::beginCall(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaClientSdk::CallIn&      callRequest,
+            OpcUa_UInt32                    transactionId)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus status = server_->beginRequest(1,
+                                                server_->settings().maxNodesPerMethodCall,
+                                                latencyNs);
+        UaClientSdk::CallOut result;
+        if (status.isGood())
+            callMethod(callRequest, result);
+
+        post(new CallJob(callback_, transactionId, status, result),
+             MetricsRegistry::now() + latencyNs);
+        return UaStatus(OpcUa_Good);
+    }
+
+
+    // Read the history (not supported)
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::historyReadRawModified(
+            UaClientSdk::ServiceSettings&               serviceSettings,
+            UaClientSdk::HistoryReadRawModifiedContext& context,
+            const UaHistoryReadValueIds&                nodesToRead,
+            UaClientSdk::HistoryReadDataResults&        results,
+            UaDiagnosticInfos&                          diagnosticInfos)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+        else
+            return UaStatus(OpcUa_BadServiceUnsupported);
+    }
+
+
+    // Register nodes synchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::registerNodes(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaNodeIdArray&            nodesToRegister,
+            UaNodeIdArray&                  registeredNodeIds)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(nodesToRegister.length(),
+                                             server_->settings().maxNodesPerRegisterNodes,
+                                             latencyNs);
+
+        // the server has no faster aliases than the NodeIds themselves
+        if (ret.isGood())
+            registeredNodeIds = nodesToRegister;
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Unregister nodes synchronously
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::unregisterNodes(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaNodeIdArray&            nodesToUnregister)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(nodesToUnregister.length(),
+                                             server_->settings().maxNodesPerRegisterNodes,
+                                             latencyNs);
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Get the definition of a structured data type (the server has none)
+    // =============================================================================================
+    UaStructureDefinition LoopbackSessionTransport::structureDefinition(const UaNodeId& dataTypeId)
+    {
+        return UaStructureDefinition();
+    }
+
+
+    // Create a subscription
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::createSubscription(
+            UaClientSdk::ServiceSettings&           serviceSettings,
+            UaClientSdk::UaSubscriptionCallback*    subscriptionCallback,
+            OpcUa_UInt32                            clientSubscriptionHandle,
+            UaClientSdk::SubscriptionSettings&      subscriptionSettings,
+            OpcUa_Boolean                           publishingEnabled,
+            SubscriptionTransport**                 subscription)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(1, 0, latencyNs);
+
+        if (ret.isGood())
+        {
+            // revise the settings, like a real server would
+            OpcUa_Double minimumPublishingInterval =
+                    server_->settings().minimumPublishingIntervalSec * 1000.0;
+            if (subscriptionSettings.publishingInterval < minimumPublishingInterval)
+                subscriptionSettings.publishingInterval = minimumPublishingInterval;
+            if (subscriptionSettings.maxKeepAliveCount == 0)
+                subscriptionSettings.maxKeepAliveCount = 1;
+            if (subscriptionSettings.lifetimeCount < 3 * subscriptionSettings.maxKeepAliveCount)
+                subscriptionSettings.lifetimeCount = 3 * subscriptionSettings.maxKeepAliveCount;
+
+            LoopbackSubscriptionTransport* newSubscription = new LoopbackSubscriptionTransport(
+                    server_,
+                    this,
+                    subscriptionCallback,
+                    clientSubscriptionHandle,
+                    subscriptionSettings,
+                    publishingEnabled);
+
+            {
+                UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+                subscriptions_.push_back(newSubscription);
+            }
+
+            *subscription = newSubscription;
+
+            // wake up the worker thread, so it takes the new subscription into account
+            wakeUpSemaphore_.post(1);
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Delete a subscription
+    // =============================================================================================
+    UaStatus LoopbackSessionTransport::deleteSubscription(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            SubscriptionTransport**         subscription)
+    {
+        if (!isConnected())
+            return UaStatus(OpcUa_BadServerNotConnected);
+        else if (subscription == 0 || *subscription == 0)
+            return UaStatus(OpcUa_BadSubscriptionIdInvalid);
+
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(1, 0, latencyNs);
+
+        // the subscription itself is only deleted together with the session
+        if (ret.isGood())
+        {
+            static_cast<LoopbackSubscriptionTransport*>(*subscription)->markDeleted();
+            *subscription = 0;
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Post a job
+    // =============================================================================================
+    void LoopbackSessionTransport::post(Job* job, uint64_t dueTime)
+    {
+        bool wakeUp = false;
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (connected_)
+            {
+                // only wake up the worker thread if the job is due before the ones it knows
+                wakeUp = jobs_.empty() || dueTime < jobs_.begin()->first;
+                jobs_.insert(std::make_pair(dueTime, job));
+                job = 0;
+            }
+        }
+
+        delete job;
+
+        if (wakeUp)
+            wakeUpSemaphore_.post(1);
+    }
+
+
+    // The loop of the worker thread
+    // =============================================================================================
+    void LoopbackSessionTransport::work()
+    {
+        while (true)
+        {
+            uint64_t now = MetricsRegistry::now();
+            vector<Job*> dueJobs;
+            vector<LoopbackSubscriptionTransport*> subscriptions;
+
+            // take the jobs that are due, and a copy of the subscriptions
+            {
+                UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+                if (!connected_)
+                    break;
+
+                while (!jobs_.empty() && jobs_.begin()->first <= now)
+                {
+                    dueJobs.push_back(jobs_.begin()->second);
+                    jobs_.erase(jobs_.begin());
+                }
+
+                subscriptions = subscriptions_;
+            }
+
+            // complete them without holding the lock, since the callbacks may invoke services
+            for (size_t i = 0; i < dueJobs.size(); i++)
+            {
+                dueJobs[i]->complete();
+                delete dueJobs[i];
+            }
+
+            uint64_t wakeUpTime = now + MAX_IDLE_TIME_NS;
+
+            for (size_t i = 0; i < subscriptions.size(); i++)
+                wakeUpTime = std::min(wakeUpTime, subscriptions[i]->publishIfDue(now));
+
+            {
+                UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+                if (!jobs_.empty())
+                    wakeUpTime = std::min(wakeUpTime, jobs_.begin()->first);
+            }
+
+            // sleep until something is due (rounded up to whole milliseconds), or until woken up
+            now = MetricsRegistry::now();
+            if (wakeUpTime > now)
+                wakeUpSemaphore_.timedWait(OpcUa_UInt32((wakeUpTime - now + 999999) / 1000000));
+        }
+    }
+
+
+    // Stop the worker thread
+    // =============================================================================================
+    void LoopbackSessionTransport::stopWorking()
+    {
+        Worker* worker;
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            connected_ = false;
+            worker     = worker_;
+            worker_    = 0;
+        }
+
+        if (worker != 0)
+        {
+            wakeUpSemaphore_.post(1);
+            worker->waitUntilFinished();
+            delete worker;
+        }
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        for (multimap<uint64_t, Job*>::iterator it = jobs_.begin(); it != jobs_.end(); ++it)
+            delete it->second;
+        jobs_.clear();
+
+        for (size_t i = 0; i < subscriptions_.size(); i++)
+            subscriptions_[i]->markDeleted();
+    }
+
+}
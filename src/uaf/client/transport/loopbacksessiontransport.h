@@ -0,0 +1,258 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_LOOPBACKSESSIONTRANSPORT_H_
+#define UAF_LOOPBACKSESSIONTRANSPORT_H_
+
+
+
+// STD
+#include <map>
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+// SDK
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/transport/sessiontransport.h"
+#include "uaf/client/transport/loopbacksubscriptiontransport.h"
+
+
+
+namespace uaf
+{
+
+    class LoopbackServer;
+
+
+    /*******************************************************************************************//**
+    * A uaf::LoopbackSessionTransport is a session of a uaf::LoopbackServer.
+    *
+    * The synchronous services are handled by the calling thread (which is blocked for the
+    * simulated latency). The asynchronous services are handled immediately as well, but their
+    * results are passed to the UaClientSdk::UaSessionCallback by the worker thread of the
+    * session, once the simulated latency has elapsed. The same worker thread simulates the
+    * publish stream of the subscriptions.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT LoopbackSessionTransport : public uaf::SessionTransport
+    {
+    public:
+
+
+        /**
+         * A job to be completed by the worker thread, e.g. to pass the result of an asynchronous
+         * service to a callback.
+         */
+        class Job
+        {
+        public:
+            virtual ~Job() {}
+            virtual void complete() = 0;
+        };
+
+
+        /**
+         * Create a session of the given server.
+         */
+        LoopbackSessionTransport(uaf::LoopbackServer* server);
+
+
+        /**
+         * Destruct the session (after stopping the worker thread), and its subscriptions.
+         */
+        virtual ~LoopbackSessionTransport();
+
+
+        // overridden from uaf::SessionTransport
+        virtual bool isInProcess() const { return true; }
+        virtual UaStatus connect(
+                const UaString&                     endpointUrl,
+                UaClientSdk::SessionConnectInfo&    sessionConnectInfo,
+                UaClientSdk::SessionSecurityInfo&   sessionSecurityInfo,
+                UaClientSdk::UaSessionCallback*     sessionCallback);
+        virtual UaStatus disconnect(
+                UaClientSdk::ServiceSettings&       serviceSettings,
+                OpcUa_Boolean                       deleteSubscriptions);
+        virtual OpcUa_Boolean isConnected() const;
+        virtual UaClientSdk::UaClient::ServerStatus serverState() const;
+        virtual UaString currentlyUsedEndpointUrl() const;
+        virtual UaStatus read(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Double                    maxAge,
+                OpcUa_TimestampsToReturn        timestampsToReturn,
+                const UaReadValueIds&           nodesToRead,
+                UaDataValues&                   values,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus beginRead(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Double                    maxAge,
+                OpcUa_TimestampsToReturn        timestampsToReturn,
+                const UaReadValueIds&           nodesToRead,
+                OpcUa_UInt32                    transactionId);
+        virtual UaStatus write(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaWriteValues&            nodesToWrite,
+                UaStatusCodeArray&              results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus beginWrite(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaWriteValues&            nodesToWrite,
+                OpcUa_UInt32                    transactionId);
+        virtual UaStatus browseList(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const OpcUa_ViewDescription&    view,
+                OpcUa_UInt32                    maxReferencesToReturn,
+                const UaBrowseDescriptions&     nodesToBrowse,
+                UaBrowseResults&                results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus browseListNext(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Boolean                   releaseContinuationPoints,
+                const UaByteStringArray&        continuationPoints,
+                UaBrowseResults&                results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus translateBrowsePathsToNodeIds(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaBrowsePaths&            browsePaths,
+                UaBrowsePathResults&            results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus callList(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaCallMethodRequests&     callMethodRequests,
+                UaCallMethodResults&            results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus beginCall(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaClientSdk::CallIn&      callRequest,
+                OpcUa_UInt32                    transactionId);
+        virtual UaStatus historyReadRawModified(
+                UaClientSdk::ServiceSettings&               serviceSettings,
+                UaClientSdk::HistoryReadRawModifiedContext& context,
+                const UaHistoryReadValueIds&                nodesToRead,
+                UaClientSdk::HistoryReadDataResults&        results,
+                UaDiagnosticInfos&                          diagnosticInfos);
+        virtual UaStatus registerNodes(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaNodeIdArray&            nodesToRegister,
+                UaNodeIdArray&                  registeredNodeIds);
+        virtual UaStatus unregisterNodes(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaNodeIdArray&            nodesToUnregister);
+        virtual UaStructureDefinition structureDefinition(const UaNodeId& dataTypeId);
+        virtual UaStatus createSubscription(
+                UaClientSdk::ServiceSettings&           serviceSettings,
+                UaClientSdk::UaSubscriptionCallback*    subscriptionCallback,
+                OpcUa_UInt32                            clientSubscriptionHandle,
+                UaClientSdk::SubscriptionSettings&      subscriptionSettings,
+                OpcUa_Boolean                           publishingEnabled,
+                uaf::SubscriptionTransport**            subscription);
+        virtual UaStatus deleteSubscription(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                uaf::SubscriptionTransport**    subscription);
+
+
+        /**
+         * Post a job, to be completed (and deleted) by the worker thread at the given time.
+         * If the session is not connected, the job is deleted without being completed.
+         *
+         * @param job       The job, owned by the session from now on.
+         * @param dueTime   The time to complete the job, as given by uaf::MetricsRegistry::now().
+         */
+        void post(Job* job, uint64_t dueTime);
+
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(LoopbackSessionTransport);
+
+
+        // the worker may call work()
+        class Worker;
+        friend class Worker;
+
+
+        /**
+         * The worker thread, completing jobs and publishing until the session is disconnected.
+         */
+        class Worker : private UaThread
+        {
+        public:
+            Worker(uaf::LoopbackSessionTransport* session) : session_(session) {}
+            void startWorking() { start(); }
+            void waitUntilFinished() { wait(); }
+        private:
+            DISALLOW_COPY_AND_ASSIGN(Worker);
+            void run() { session_->work(); }
+            uaf::LoopbackSessionTransport* session_;
+        };
+
+
+        /**
+         * The loop of the worker thread.
+         */
+        void work();
+
+
+        /**
+         * Stop the worker thread, delete the pending jobs and mark the subscriptions as deleted.
+         */
+        void stopWorking();
+
+
+        /**
+         * Handle the operations of the services (without any lock).
+         */
+        void readNodes(
+                OpcUa_TimestampsToReturn    timestampsToReturn,
+                const UaReadValueIds&       nodesToRead,
+                UaDataValues&               values);
+        void writeNodes(const UaWriteValues& nodesToWrite, UaStatusCodeArray& results);
+        void callMethod(const UaClientSdk::CallIn& callRequest, UaClientSdk::CallOut& result);
+
+
+        // the server
+        uaf::LoopbackServer*                            server_;
+        // the callback, the id and the endpoint URL of the connection
+        UaClientSdk::UaSessionCallback*                 callback_;
+        OpcUa_UInt32                                    clientConnectionId_;
+        UaString                                        endpointUrl_;
+        // true if the session is connected
+        bool                                            connected_;
+        // the pending jobs, by due time
+        std::multimap<uint64_t, Job*>                   jobs_;
+        // the subscriptions (only deleted when the session is deleted, since the worker thread
+        // or the owner of the subscription may still be using them)
+        std::vector<uaf::LoopbackSubscriptionTransport*> subscriptions_;
+        // the worker thread (if the session is connected)
+        Worker*                                         worker_;
+        // mutex to protect all of the above
+        mutable UaMutex                                 mutex_;
+        // posted to wake up the worker thread (when a job is posted, or when it should stop)
+        UaSemaphore                                     wakeUpSemaphore_;
+    };
+}
+
+
+#endif /* UAF_LOOPBACKSESSIONTRANSPORT_H_ */
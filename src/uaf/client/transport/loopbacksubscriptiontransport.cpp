@@ -0,0 +1,507 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/transport/loopbacksubscriptiontransport.h"
+#include "uaf/client/transport/loopbacksessiontransport.h"
+#include "uaf/client/transport/loopbackserver.h"
+#include "uaf/client/metrics/metricsregistry.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::vector;
+    using std::map;
+
+
+    namespace
+    {
+        // job to pass the result of beginCreateMonitoredItems() to the callback
+        class CreateMonitoredItemsJob : public LoopbackSessionTransport::Job
+        {
+        public:
+            CreateMonitoredItemsJob(
+                    UaClientSdk::UaSubscriptionCallback*    callback,
+                    OpcUa_UInt32                            transactionId,
+                    const UaStatus&                         status,
+                    const UaMonitoredItemCreateResults&     results)
+            : callback_(callback), transactionId_(transactionId), status_(status), results_(results)
+            {}
+            void complete()
+            {
+                callback_->createMonitoredItemsComplete(transactionId_, status_, results_,
+                                                        diagnosticInfos_);
+            }
+        private:
+            UaClientSdk::UaSubscriptionCallback*    callback_;
+            OpcUa_UInt32                            transactionId_;
+            UaStatus                                status_;
+            UaMonitoredItemCreateResults            results_;
+            UaDiagnosticInfos                       diagnosticInfos_;
+        };
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    LoopbackSubscriptionTransport::LoopbackSubscriptionTransport(
+            LoopbackServer*                             server,
+            LoopbackSessionTransport*                   session,
+            UaClientSdk::UaSubscriptionCallback*        subscriptionCallback,
+            OpcUa_UInt32                                clientSubscriptionHandle,
+            const UaClientSdk::SubscriptionSettings&    subscriptionSettings,
+            OpcUa_Boolean                               publishingEnabled)
+    : server_(server),
+      session_(session),
+      callback_(subscriptionCallback),
+      clientSubscriptionHandle_(clientSubscriptionHandle),
+      publishingIntervalNs_(uint64_t(subscriptionSettings.publishingInterval * 1.0e6)),
+      publishingIntervalMs_(subscriptionSettings.publishingInterval),
+      maxKeepAliveCount_(subscriptionSettings.maxKeepAliveCount),
+      publishingEnabled_(publishingEnabled != OpcUa_False),
+      deleted_(false),
+      nextMonitoredItemId_(1),
+      noOfIdleIntervals_(0),
+      sequenceNumber_(0),
+      deliveredSequenceNumber_(0)
+    {
+        if (publishingIntervalNs_ == 0)
+            publishingIntervalNs_ = 1;
+
+        nextPublishTime_ = MetricsRegistry::now() + publishingIntervalNs_;
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    LoopbackSubscriptionTransport::~LoopbackSubscriptionTransport()
+    {}
+
+
+    // Revise a sampling interval
+    // =============================================================================================
+    OpcUa_Double LoopbackSubscriptionTransport::reviseSamplingInterval(
+            OpcUa_Double samplingInterval) const
+    {
+        // the variables are sampled when the notifications are published, so a negative (i.e.
+        // "use the publishing interval") or smaller interval is revised to the publishing one
+        if (samplingInterval < publishingIntervalMs_)
+            return publishingIntervalMs_;
+        else
+            return samplingInterval;
+    }
+
+
+    // Create the monitored items
+    // =============================================================================================
+    UaStatus LoopbackSubscriptionTransport::doCreateMonitoredItems(
+            const UaMonitoredItemCreateRequests&    createRequests,
+            UaMonitoredItemCreateResults&           createResults,
+            uint64_t&                               latencyNs)
+    {
+        UaStatus ret = server_->beginRequest(createRequests.length(),
+                                             server_->settings().maxMonitoredItemsPerCall,
+                                             latencyNs);
+        if (ret.isBad())
+            return ret;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        if (deleted_)
+            return UaStatus(OpcUa_BadSubscriptionIdInvalid);
+
+        createResults.create(createRequests.length());
+
+        UaMutexLocker serverLocker(&server_->mutex_); // unlocks when locker goes out of scope
+
+        for (OpcUa_UInt32 i = 0; i < createRequests.length(); i++)
+        {
+            const OpcUa_MonitoredItemCreateRequest& request = createRequests[i];
+            OpcUa_MonitoredItemCreateResult&        result  = createResults[i];
+
+            result.StatusCode = server_->nextOperationStatus();
+            if (OpcUa_IsBad(result.StatusCode))
+                continue;
+
+            Item item;
+            item.clientHandle   = request.RequestedParameters.ClientHandle;
+            item.monitoringMode = request.MonitoringMode;
+            item.isEvent        = request.ItemToMonitor.AttributeId
+                                  == OpcUa_Attributes_EventNotifier;
+
+            if (!item.isEvent)
+            {
+                if (request.ItemToMonitor.AttributeId != OpcUa_Attributes_Value)
+                {
+                    result.StatusCode = OpcUa_BadAttributeIdInvalid;
+                    continue;
+                }
+                else if (!server_->variableIndex(UaNodeId(request.ItemToMonitor.NodeId),
+                                                 item.variableIndex))
+                {
+                    result.StatusCode = OpcUa_BadNodeIdUnknown;
+                    continue;
+                }
+            }
+
+            result.MonitoredItemId          = nextMonitoredItemId_++;
+            result.RevisedSamplingInterval  = reviseSamplingInterval(
+                    request.RequestedParameters.SamplingInterval);
+            result.RevisedQueueSize         = request.RequestedParameters.QueueSize > 0
+                                              ? request.RequestedParameters.QueueSize : 1;
+
+            items_[result.MonitoredItemId] = item;
+        }
+
+        return ret;
+    }
+
+
+    // Create monitored items synchronously
+    // =============================================================================================
+    UaStatus LoopbackSubscriptionTransport::createMonitoredItems(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_TimestampsToReturn        timeStamps,
+            UaMonitoredItemCreateRequests&  createRequests,
+            UaMonitoredItemCreateResults&   createResults)
+    {
+        uint64_t latencyNs;
+        UaStatus ret = doCreateMonitoredItems(createRequests, createResults, latencyNs);
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Create monitored items asynchronously
+    // =============================================================================================
+    UaStatus LoopbackSubscriptionTransport::beginCreateMonitoredItems(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_TimestampsToReturn        timeStamps,
+            UaMonitoredItemCreateRequests&  createRequests,
+            OpcUa_UInt32                    transactionId)
+    {
+        uint64_t latencyNs;
+        UaMonitoredItemCreateResults createResults;
+        UaStatus status = doCreateMonitoredItems(createRequests, createResults, latencyNs);
+
+        session_->post(new CreateMonitoredItemsJob(callback_, transactionId, status, createResults),
+                       MetricsRegistry::now() + latencyNs);
+        return UaStatus(OpcUa_Good);
+    }
+
+
+    // Modify monitored items synchronously
+    // =============================================================================================
+    UaStatus LoopbackSubscriptionTransport::modifyMonitoredItems(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_TimestampsToReturn        timeStamps,
+            UaMonitoredItemModifyRequests&  modifyRequests,
+            UaMonitoredItemModifyResults&   modifyResults)
+    {
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(modifyRequests.length(),
+                                             server_->settings().maxMonitoredItemsPerCall,
+                                             latencyNs);
+        if (ret.isGood())
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (deleted_)
+            {
+                ret = UaStatus(OpcUa_BadSubscriptionIdInvalid);
+            }
+            else
+            {
+                modifyResults.create(modifyRequests.length());
+
+                UaMutexLocker serverLocker(&server_->mutex_); // unlocks when out of scope
+
+                for (OpcUa_UInt32 i = 0; i < modifyRequests.length(); i++)
+                {
+                    const OpcUa_MonitoredItemModifyRequest& request = modifyRequests[i];
+                    OpcUa_MonitoredItemModifyResult&        result  = modifyResults[i];
+                    map<OpcUa_UInt32, Item>::iterator it = items_.find(request.MonitoredItemId);
+
+                    result.StatusCode = server_->nextOperationStatus();
+
+                    if (OpcUa_IsBad(result.StatusCode))
+                        continue;
+                    else if (it == items_.end())
+                    {
+                        result.StatusCode = OpcUa_BadMonitoredItemIdInvalid;
+                        continue;
+                    }
+
+                    it->second.clientHandle         = request.RequestedParameters.ClientHandle;
+                    result.RevisedSamplingInterval  = reviseSamplingInterval(
+                            request.RequestedParameters.SamplingInterval);
+                    result.RevisedQueueSize         = request.RequestedParameters.QueueSize > 0
+                                                      ? request.RequestedParameters.QueueSize : 1;
+                }
+            }
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Set the monitoring mode synchronously
+    // =============================================================================================
+    UaStatus LoopbackSubscriptionTransport::setMonitoringMode(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_MonitoringMode            monitoringMode,
+            const UaUInt32Array&            monitoredItemIds,
+            UaStatusCodeArray&              results)
+    {
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(monitoredItemIds.length(),
+                                             server_->settings().maxMonitoredItemsPerCall,
+                                             latencyNs);
+        if (ret.isGood())
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (deleted_)
+            {
+                ret = UaStatus(OpcUa_BadSubscriptionIdInvalid);
+            }
+            else
+            {
+                results.create(monitoredItemIds.length());
+
+                UaMutexLocker serverLocker(&server_->mutex_); // unlocks when out of scope
+
+                for (OpcUa_UInt32 i = 0; i < monitoredItemIds.length(); i++)
+                {
+                    map<OpcUa_UInt32, Item>::iterator it = items_.find(monitoredItemIds[i]);
+
+                    results[i] = server_->nextOperationStatus();
+
+                    if (OpcUa_IsBad(results[i]))
+                        continue;
+                    else if (it == items_.end())
+                        results[i] = OpcUa_BadMonitoredItemIdInvalid;
+                    else
+                        it->second.monitoringMode = monitoringMode;
+                }
+            }
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Delete monitored items synchronously
+    // =============================================================================================
+    UaStatus LoopbackSubscriptionTransport::deleteMonitoredItems(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaUInt32Array&            monitoredItemIds,
+            UaStatusCodeArray&              results)
+    {
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(monitoredItemIds.length(),
+                                             server_->settings().maxMonitoredItemsPerCall,
+                                             latencyNs);
+        if (ret.isGood())
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (deleted_)
+            {
+                ret = UaStatus(OpcUa_BadSubscriptionIdInvalid);
+            }
+            else
+            {
+                results.create(monitoredItemIds.length());
+
+                UaMutexLocker serverLocker(&server_->mutex_); // unlocks when out of scope
+
+                for (OpcUa_UInt32 i = 0; i < monitoredItemIds.length(); i++)
+                {
+                    results[i] = server_->nextOperationStatus();
+
+                    if (OpcUa_IsBad(results[i]))
+                        continue;
+                    else if (items_.erase(monitoredItemIds[i]) == 0)
+                        results[i] = OpcUa_BadMonitoredItemIdInvalid;
+                }
+            }
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Set the publishing mode synchronously
+    // =============================================================================================
+    UaStatus LoopbackSubscriptionTransport::setPublishingMode(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_Boolean                   publishingEnabled)
+    {
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(1, 0, latencyNs);
+
+        if (ret.isGood())
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (deleted_)
+                ret = UaStatus(OpcUa_BadSubscriptionIdInvalid);
+            else
+                publishingEnabled_ = (publishingEnabled != OpcUa_False);
+        }
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Republish (not possible, since no notification messages are retained)
+    // =============================================================================================
+    UaStatus LoopbackSubscriptionTransport::republish(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_UInt32                    retransmitSequenceNumber,
+            UaExtensionObjectArray&         dataNotifications,
+            UaDateTime&                     publishTime)
+    {
+        uint64_t latencyNs;
+        UaStatus ret = server_->beginRequest(1, 0, latencyNs);
+
+        if (ret.isGood())
+            ret = UaStatus(OpcUa_BadMessageNotAvailable);
+
+        LoopbackServer::simulateLatency(latencyNs);
+        return ret;
+    }
+
+
+    // Mark the subscription as deleted
+    // =============================================================================================
+    void LoopbackSubscriptionTransport::markDeleted()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        deleted_ = true;
+        items_.clear();
+    }
+
+
+    // Publish the notifications if the publishing interval has elapsed
+    // =============================================================================================
+    uint64_t LoopbackSubscriptionTransport::publishIfDue(uint64_t now)
+    {
+        UaDataNotifications dataNotifications;
+        UaDiagnosticInfos   diagnosticInfos;
+        bool                sendDataChange  = false;
+        bool                sendKeepAlive   = false;
+        bool                reportMissing   = false;
+        OpcUa_UInt32        previousSequenceNumber = 0;
+        OpcUa_UInt32        newSequenceNumber = 0;
+        uint64_t            nextPublishTime;
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (deleted_)
+                return now + publishingIntervalNs_;
+            else if (now < nextPublishTime_)
+                return nextPublishTime_;
+
+            // don't try to catch up with the intervals that were missed
+            nextPublishTime_ += publishingIntervalNs_;
+            if (nextPublishTime_ <= now)
+                nextPublishTime_ = now + publishingIntervalNs_;
+            nextPublishTime = nextPublishTime_;
+
+            // sample the variables of the reporting items
+            vector<Item*> changedItems;
+
+            if (publishingEnabled_)
+            {
+                bool notifyUnchangedValues = server_->settings().notifyUnchangedValues;
+
+                for (map<OpcUa_UInt32, Item>::iterator it = items_.begin();
+                     it != items_.end();
+                     ++it)
+                {
+                    Item& item = it->second;
+
+                    if (item.isEvent || item.monitoringMode != OpcUa_MonitoringMode_Reporting)
+                        continue;
+
+                    uint64_t version = server_->variableVersion(item.variableIndex);
+
+                    if (!item.isNotified || version != item.lastVersion || notifyUnchangedValues)
+                    {
+                        item.isNotified  = true;
+                        item.lastVersion = version;
+                        changedItems.push_back(&item);
+                    }
+                }
+            }
+
+            if (!changedItems.empty())
+            {
+                noOfIdleIntervals_ = 0;
+
+                dataNotifications.create(changedItems.size());
+                for (OpcUa_UInt32 i = 0; i < changedItems.size(); i++)
+                {
+                    dataNotifications[i].ClientHandle = changedItems[i]->clientHandle;
+                    server_->readVariable(changedItems[i]->variableIndex,
+                                          dataNotifications[i].Value);
+                }
+
+                // number the notification message, and drop it if requested
+                sequenceNumber_++;
+                OpcUa_UInt32 dropEveryNthPublish = server_->settings().dropEveryNthPublish;
+
+                if (dropEveryNthPublish == 0 || sequenceNumber_ % dropEveryNthPublish != 0)
+                {
+                    sendDataChange = true;
+                    reportMissing  = (sequenceNumber_ != deliveredSequenceNumber_ + 1);
+                    previousSequenceNumber   = deliveredSequenceNumber_;
+                    newSequenceNumber        = sequenceNumber_;
+                    deliveredSequenceNumber_ = sequenceNumber_;
+                }
+            }
+            else if (++noOfIdleIntervals_ >= maxKeepAliveCount_)
+            {
+                noOfIdleIntervals_ = 0;
+                sendKeepAlive = true;
+            }
+        }
+
+        // call the callback without holding the lock, since it may invoke services
+        if (reportMissing)
+            callback_->notificationsMissing(clientSubscriptionHandle_,
+                                            previousSequenceNumber,
+                                            newSequenceNumber);
+        if (sendDataChange)
+            callback_->dataChange(clientSubscriptionHandle_, dataNotifications, diagnosticInfos);
+        if (sendKeepAlive)
+            callback_->keepAlive(clientSubscriptionHandle_);
+
+        return nextPublishTime;
+    }
+
+}
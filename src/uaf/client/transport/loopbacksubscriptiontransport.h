@@ -0,0 +1,219 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_LOOPBACKSUBSCRIPTIONTRANSPORT_H_
+#define UAF_LOOPBACKSUBSCRIPTIONTRANSPORT_H_
+
+
+
+// STD
+#include <map>
+#include <stdint.h>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/transport/subscriptiontransport.h"
+
+
+
+namespace uaf
+{
+
+    class LoopbackServer;
+    class LoopbackSessionTransport;
+
+
+    /*******************************************************************************************//**
+    * A uaf::LoopbackSubscriptionTransport is a subscription of a uaf::LoopbackServer.
+    *
+    * The monitored items of the subscription are handled in memory, and the publish stream is
+    * simulated by the worker thread of the session (see publishIfDue()): each publishing
+    * interval, the values of the variables that changed since they were last notified (or all
+    * values, see uaf::LoopbackServerSettings::notifyUnchangedValues) are passed to the
+    * UaClientSdk::UaSubscriptionCallback, or a keep-alive is sent if there's nothing to notify
+    * for maxKeepAliveCount intervals. Notification messages can be dropped on purpose (see
+    * uaf::LoopbackServerSettings::dropEveryNthPublish), in which case the callback is told that
+    * notifications are missing. Since no messages are retained, they can't be republished.
+    *
+    * The subscription is owned by the session transport that created it.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT LoopbackSubscriptionTransport : public uaf::SubscriptionTransport
+    {
+    public:
+
+
+        /**
+         * Create a subscription.
+         *
+         * @param server                    The server that handles the services.
+         * @param session                   The session transport that created the subscription.
+         * @param subscriptionCallback      The callback for the notifications and results.
+         * @param clientSubscriptionHandle  The handle of the subscription.
+         * @param subscriptionSettings      The revised settings of the subscription.
+         * @param publishingEnabled         True if publishing is enabled.
+         */
+        LoopbackSubscriptionTransport(
+                uaf::LoopbackServer*                        server,
+                uaf::LoopbackSessionTransport*              session,
+                UaClientSdk::UaSubscriptionCallback*        subscriptionCallback,
+                OpcUa_UInt32                                clientSubscriptionHandle,
+                const UaClientSdk::SubscriptionSettings&    subscriptionSettings,
+                OpcUa_Boolean                               publishingEnabled);
+
+
+        /**
+         * Destruct the subscription.
+         */
+        virtual ~LoopbackSubscriptionTransport();
+
+
+        // overridden from uaf::SubscriptionTransport
+        virtual UaStatus createMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemCreateRequests&  createRequests,
+                UaMonitoredItemCreateResults&   createResults);
+        virtual UaStatus beginCreateMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemCreateRequests&  createRequests,
+                OpcUa_UInt32                    transactionId);
+        virtual UaStatus modifyMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemModifyRequests&  modifyRequests,
+                UaMonitoredItemModifyResults&   modifyResults);
+        virtual UaStatus setMonitoringMode(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_MonitoringMode            monitoringMode,
+                const UaUInt32Array&            monitoredItemIds,
+                UaStatusCodeArray&              results);
+        virtual UaStatus deleteMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaUInt32Array&            monitoredItemIds,
+                UaStatusCodeArray&              results);
+        virtual UaStatus setPublishingMode(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Boolean                   publishingEnabled);
+        virtual UaStatus republish(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_UInt32                    retransmitSequenceNumber,
+                UaExtensionObjectArray&         dataNotifications,
+                UaDateTime&                     publishTime);
+
+
+        /**
+         * Publish the notifications (or a keep-alive) if the publishing interval has elapsed.
+         * This method is called by the worker thread of the session, without any lock.
+         *
+         * @param now   The current time, as given by uaf::MetricsRegistry::now().
+         * @return      The time when the next publishing interval elapses.
+         */
+        uint64_t publishIfDue(uint64_t now);
+
+
+        /**
+         * Mark the subscription as deleted: it won't publish anymore, and its services fail.
+         */
+        void markDeleted();
+
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(LoopbackSubscriptionTransport);
+
+
+        /**
+         * A monitored item.
+         */
+        struct Item
+        {
+            Item()
+            : clientHandle(0),
+              variableIndex(0),
+              isEvent(false),
+              monitoringMode(OpcUa_MonitoringMode_Reporting),
+              isNotified(false),
+              lastVersion(0)
+            {}
+            /** The client handle. */
+            OpcUa_UInt32         clientHandle;
+            /** The index of the monitored variable (if isEvent is false). */
+            uint32_t             variableIndex;
+            /** True for an event monitored item (which is never notified). */
+            bool                 isEvent;
+            /** The monitoring mode. */
+            OpcUa_MonitoringMode monitoringMode;
+            /** True if the value has been notified at least once. */
+            bool                 isNotified;
+            /** The version of the variable when it was last notified. */
+            uint64_t             lastVersion;
+        };
+
+
+        /**
+         * Create the monitored items (for both the synchronous and asynchronous service).
+         *
+         * @param latencyNs Output parameter: the latency to simulate, in nanoseconds.
+         */
+        UaStatus doCreateMonitoredItems(
+                const UaMonitoredItemCreateRequests&    createRequests,
+                UaMonitoredItemCreateResults&           createResults,
+                uint64_t&                               latencyNs);
+
+
+        /**
+         * Get the revised sampling interval for a requested one. The mutex_ must be locked.
+         */
+        OpcUa_Double reviseSamplingInterval(OpcUa_Double samplingInterval) const;
+
+
+        // the server, the session and the callback
+        uaf::LoopbackServer*                    server_;
+        uaf::LoopbackSessionTransport*          session_;
+        UaClientSdk::UaSubscriptionCallback*    callback_;
+        OpcUa_UInt32                            clientSubscriptionHandle_;
+        // the publishing interval (in nanoseconds and milliseconds) and max. keep-alive count
+        uint64_t                                publishingIntervalNs_;
+        OpcUa_Double                            publishingIntervalMs_;
+        OpcUa_UInt32                            maxKeepAliveCount_;
+        // true if publishing is enabled, false if the subscription was deleted
+        bool                                    publishingEnabled_;
+        bool                                    deleted_;
+        // the monitored items, by MonitoredItemId, and the id of the next one
+        std::map<OpcUa_UInt32, Item>            items_;
+        OpcUa_UInt32                            nextMonitoredItemId_;
+        // the time when the next publishing interval elapses
+        uint64_t                                nextPublishTime_;
+        // the number of publishing intervals without notifications since the last message
+        OpcUa_UInt32                            noOfIdleIntervals_;
+        // the sequence number of the last sent and the last delivered notification message
+        OpcUa_UInt32                            sequenceNumber_;
+        OpcUa_UInt32                            deliveredSequenceNumber_;
+        // mutex to protect all of the above (to be locked before the mutex of the server)
+        UaMutex                                 mutex_;
+    };
+}
+
+
+#endif /* UAF_LOOPBACKSUBSCRIPTIONTRANSPORT_H_ */
@@ -0,0 +1,302 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/transport/sdksessiontransport.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+
+
+    // Constructor
+    // =============================================================================================
+    SdkSessionTransport::SdkSessionTransport()
+    {
+        uaSession_ = new UaClientSdk::UaSession();
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    SdkSessionTransport::~SdkSessionTransport()
+    {
+        delete uaSession_;
+        uaSession_ = 0;
+    }
+
+
+    // Connect
+    // =============================================================================================
+    UaStatus SdkSessionTransport::connect(
+            const UaString&                     endpointUrl,
+            UaClientSdk::SessionConnectInfo&    sessionConnectInfo,
+            UaClientSdk::SessionSecurityInfo&   sessionSecurityInfo,
+            UaClientSdk::UaSessionCallback*     sessionCallback)
+    {
+        return uaSession_->connect(endpointUrl, sessionConnectInfo, sessionSecurityInfo,
+                                   sessionCallback);
+    }
+
+
+    // Disconnect
+    // =============================================================================================
+    UaStatus SdkSessionTransport::disconnect(
+            UaClientSdk::ServiceSettings&       serviceSettings,
+            OpcUa_Boolean                       deleteSubscriptions)
+    {
+        return uaSession_->disconnect(serviceSettings, deleteSubscriptions);
+    }
+
+
+    // Is the session connected?
+    // =============================================================================================
+    OpcUa_Boolean SdkSessionTransport::isConnected() const
+    {
+        return uaSession_->isConnected();
+    }
+
+
+    // Get the server state
+    // =============================================================================================
+    UaClientSdk::UaClient::ServerStatus SdkSessionTransport::serverState() const
+    {
+        return uaSession_->serverState();
+    }
+
+
+    // Get the URL of the endpoint
+    // =============================================================================================
+    UaString SdkSessionTransport::currentlyUsedEndpointUrl() const
+    {
+        return uaSession_->currentlyUsedEndpointUrl();
+    }
+
+
+    // Read
+    // =============================================================================================
+    UaStatus SdkSessionTransport::read(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_Double                    maxAge,
+            OpcUa_TimestampsToReturn        timestampsToReturn,
+            const UaReadValueIds&           nodesToRead,
+            UaDataValues&                   values,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        return uaSession_->read(serviceSettings, maxAge, timestampsToReturn, nodesToRead, values,
+                                diagnosticInfos);
+    }
+
+
+    // Begin to read
+    // =============================================================================================
+    UaStatus SdkSessionTransport::beginRead(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_Double                    maxAge,
+            OpcUa_TimestampsToReturn        timestampsToReturn,
+            const UaReadValueIds&           nodesToRead,
+            OpcUa_UInt32                    transactionId)
+    {
+        return uaSession_->beginRead(serviceSettings, maxAge, timestampsToReturn, nodesToRead,
+                                     transactionId);
+    }
+
+
+    // Write
+    // =============================================================================================
+    UaStatus SdkSessionTransport::write(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaWriteValues&            nodesToWrite,
+            UaStatusCodeArray&              results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        return uaSession_->write(serviceSettings, nodesToWrite, results, diagnosticInfos);
+    }
+
+
+    // Begin to write
+    // =============================================================================================
+    UaStatus SdkSessionTransport::beginWrite(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaWriteValues&            nodesToWrite,
+            OpcUa_UInt32                    transactionId)
+    {
+        return uaSession_->beginWrite(serviceSettings, nodesToWrite, transactionId);
+    }
+
+
+    // Browse
+    // =============================================================================================
+    UaStatus SdkSessionTransport::browseList(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const OpcUa_ViewDescription&    view,
+            OpcUa_UInt32                    maxReferencesToReturn,
+            const UaBrowseDescriptions&     nodesToBrowse,
+            UaBrowseResults&                results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        return uaSession_->browseList(serviceSettings, view, maxReferencesToReturn, nodesToBrowse,
+                                      results, diagnosticInfos);
+    }
+
+
+    // Continue browsing
+    // =============================================================================================
+    UaStatus SdkSessionTransport::browseListNext(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_Boolean                   releaseContinuationPoints,
+            const UaByteStringArray&        continuationPoints,
+            UaBrowseResults&                results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        return uaSession_->browseListNext(serviceSettings, releaseContinuationPoints,
+                                          continuationPoints, results, diagnosticInfos);
+    }
+
+
+    // Translate browse paths to node ids
+    // =============================================================================================
+    UaStatus SdkSessionTransport::translateBrowsePathsToNodeIds(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaBrowsePaths&            browsePaths,
+            UaBrowsePathResults&            results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        return uaSession_->translateBrowsePathsToNodeIds(serviceSettings, browsePaths, results,
+                                                         diagnosticInfos);
+    }
+
+
+    // Call methods
+    // =============================================================================================
+    UaStatus SdkSessionTransport::callList(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaCallMethodRequests&     callMethodRequests,
+            UaCallMethodResults&            results,
+            UaDiagnosticInfos&              diagnosticInfos)
+    {
+        return uaSession_->callList(serviceSettings, callMethodRequests, results,
+                                    diagnosticInfos);
+    }
+
+
+    // Begin to call a method
+    // =============================================================================================
+    UaStatus SdkSessionTransport::beginCall(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaClientSdk::CallIn&      callRequest,
+            OpcUa_UInt32                    transactionId)
+    {
+        return uaSession_->beginCall(serviceSettings, callRequest, transactionId);
+    }
+
+
+    // Read the raw or modified history
+    // =============================================================================================
+    UaStatus SdkSessionTransport::historyReadRawModified(
+            UaClientSdk::ServiceSettings&               serviceSettings,
+            UaClientSdk::HistoryReadRawModifiedContext& context,
+            const UaHistoryReadValueIds&                nodesToRead,
+            UaClientSdk::HistoryReadDataResults&        results,
+            UaDiagnosticInfos&                          diagnosticInfos)
+    {
+        return uaSession_->historyReadRawModified(serviceSettings, context, nodesToRead, results,
+                                                  diagnosticInfos);
+    }
+
+
+    // Register nodes
+    // =============================================================================================
+    UaStatus SdkSessionTransport::registerNodes(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaNodeIdArray&            nodesToRegister,
+            UaNodeIdArray&                  registeredNodeIds)
+    {
+        return uaSession_->registerNodes(serviceSettings, nodesToRegister, registeredNodeIds);
+    }
+
+
+    // Unregister nodes
+    // =============================================================================================
+    UaStatus SdkSessionTransport::unregisterNodes(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaNodeIdArray&            nodesToUnregister)
+    {
+        return uaSession_->unregisterNodes(serviceSettings, nodesToUnregister);
+    }
+
+
+    // Get a structure definition
+    // =============================================================================================
+    UaStructureDefinition SdkSessionTransport::structureDefinition(const UaNodeId& dataTypeId)
+    {
+        return uaSession_->structureDefinition(dataTypeId);
+    }
+
+
+    // Create a subscription
+    // =============================================================================================
+    UaStatus SdkSessionTransport::createSubscription(
+            UaClientSdk::ServiceSettings&           serviceSettings,
+            UaClientSdk::UaSubscriptionCallback*    subscriptionCallback,
+            OpcUa_UInt32                            clientSubscriptionHandle,
+            UaClientSdk::SubscriptionSettings&      subscriptionSettings,
+            OpcUa_Boolean                           publishingEnabled,
+            SubscriptionTransport**                 subscription)
+    {
+        UaClientSdk::UaSubscription* uaSubscription = 0;
+
+        UaStatus ret = uaSession_->createSubscription(
+                serviceSettings,
+                subscriptionCallback,
+                clientSubscriptionHandle,
+                subscriptionSettings,
+                publishingEnabled,
+                &uaSubscription);
+
+        if (ret.isGood())
+            *subscription = new SdkSubscriptionTransport(uaSubscription);
+
+        return ret;
+    }
+
+
+    // Delete a subscription
+    // =============================================================================================
+    UaStatus SdkSessionTransport::deleteSubscription(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            SubscriptionTransport**         subscription)
+    {
+        SdkSubscriptionTransport* sdkSubscription
+                = static_cast<SdkSubscriptionTransport*>(*subscription);
+
+        UaStatus ret = uaSession_->deleteSubscription(serviceSettings,
+                                                      &sdkSubscription->uaSubscription());
+
+        if (ret.isGood())
+        {
+            delete sdkSubscription;
+            *subscription = 0;
+        }
+
+        return ret;
+    }
+
+}
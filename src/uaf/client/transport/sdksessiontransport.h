@@ -0,0 +1,163 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SDKSESSIONTRANSPORT_H_
+#define UAF_SDKSESSIONTRANSPORT_H_
+
+
+
+// STD
+// SDK
+#include "uaclient/uaclientsdk.h"
+#include "uaclient/uasession.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/transport/sessiontransport.h"
+#include "uaf/client/transport/sdksubscriptiontransport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::SdkSessionTransport invokes the services of a session of the SDK (i.e. of a real
+    * OPC UA server). This is the transport that is used by default.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT SdkSessionTransport : public uaf::SessionTransport
+    {
+    public:
+
+
+        /**
+         * Create a new SDK session.
+         */
+        SdkSessionTransport();
+
+
+        /**
+         * Delete the SDK session.
+         */
+        virtual ~SdkSessionTransport();
+
+
+        // overridden from uaf::SessionTransport
+        virtual bool isInProcess() const { return false; }
+        virtual UaStatus connect(
+                const UaString&                     endpointUrl,
+                UaClientSdk::SessionConnectInfo&    sessionConnectInfo,
+                UaClientSdk::SessionSecurityInfo&   sessionSecurityInfo,
+                UaClientSdk::UaSessionCallback*     sessionCallback);
+        virtual UaStatus disconnect(
+                UaClientSdk::ServiceSettings&       serviceSettings,
+                OpcUa_Boolean                       deleteSubscriptions);
+        virtual OpcUa_Boolean isConnected() const;
+        virtual UaClientSdk::UaClient::ServerStatus serverState() const;
+        virtual UaString currentlyUsedEndpointUrl() const;
+        virtual UaStatus read(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Double                    maxAge,
+                OpcUa_TimestampsToReturn        timestampsToReturn,
+                const UaReadValueIds&           nodesToRead,
+                UaDataValues&                   values,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus beginRead(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Double                    maxAge,
+                OpcUa_TimestampsToReturn        timestampsToReturn,
+                const UaReadValueIds&           nodesToRead,
+                OpcUa_UInt32                    transactionId);
+        virtual UaStatus write(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaWriteValues&            nodesToWrite,
+                UaStatusCodeArray&              results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus beginWrite(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaWriteValues&            nodesToWrite,
+                OpcUa_UInt32                    transactionId);
+        virtual UaStatus browseList(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const OpcUa_ViewDescription&    view,
+                OpcUa_UInt32                    maxReferencesToReturn,
+                const UaBrowseDescriptions&     nodesToBrowse,
+                UaBrowseResults&                results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus browseListNext(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Boolean                   releaseContinuationPoints,
+                const UaByteStringArray&        continuationPoints,
+                UaBrowseResults&                results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus translateBrowsePathsToNodeIds(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaBrowsePaths&            browsePaths,
+                UaBrowsePathResults&            results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus callList(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaCallMethodRequests&     callMethodRequests,
+                UaCallMethodResults&            results,
+                UaDiagnosticInfos&              diagnosticInfos);
+        virtual UaStatus beginCall(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaClientSdk::CallIn&      callRequest,
+                OpcUa_UInt32                    transactionId);
+        virtual UaStatus historyReadRawModified(
+                UaClientSdk::ServiceSettings&               serviceSettings,
+                UaClientSdk::HistoryReadRawModifiedContext& context,
+                const UaHistoryReadValueIds&                nodesToRead,
+                UaClientSdk::HistoryReadDataResults&        results,
+                UaDiagnosticInfos&                          diagnosticInfos);
+        virtual UaStatus registerNodes(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaNodeIdArray&            nodesToRegister,
+                UaNodeIdArray&                  registeredNodeIds);
+        virtual UaStatus unregisterNodes(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaNodeIdArray&            nodesToUnregister);
+        virtual UaStructureDefinition structureDefinition(const UaNodeId& dataTypeId);
+        virtual UaStatus createSubscription(
+                UaClientSdk::ServiceSettings&           serviceSettings,
+                UaClientSdk::UaSubscriptionCallback*    subscriptionCallback,
+                OpcUa_UInt32                            clientSubscriptionHandle,
+                UaClientSdk::SubscriptionSettings&      subscriptionSettings,
+                OpcUa_Boolean                           publishingEnabled,
+                uaf::SubscriptionTransport**            subscription);
+        virtual UaStatus deleteSubscription(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                uaf::SubscriptionTransport**    subscription);
+
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(SdkSessionTransport);
+
+        // the wrapped SDK session
+        UaClientSdk::UaSession* uaSession_;
+
+    };
+}
+
+
+#endif /* UAF_SDKSESSIONTRANSPORT_H_ */
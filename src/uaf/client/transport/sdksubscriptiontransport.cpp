@@ -0,0 +1,121 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/transport/sdksubscriptiontransport.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+
+
+    // Constructor
+    // =============================================================================================
+    SdkSubscriptionTransport::SdkSubscriptionTransport(UaClientSdk::UaSubscription* uaSubscription)
+    : uaSubscription_(uaSubscription)
+    {}
+
+
+    // Create monitored items
+    // =============================================================================================
+    UaStatus SdkSubscriptionTransport::createMonitoredItems(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_TimestampsToReturn        timeStamps,
+            UaMonitoredItemCreateRequests&  createRequests,
+            UaMonitoredItemCreateResults&   createResults)
+    {
+        return uaSubscription_->createMonitoredItems(
+                serviceSettings, timeStamps, createRequests, createResults);
+    }
+
+
+    // Begin to create monitored items
+    // =============================================================================================
+    UaStatus SdkSubscriptionTransport::beginCreateMonitoredItems(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_TimestampsToReturn        timeStamps,
+            UaMonitoredItemCreateRequests&  createRequests,
+            OpcUa_UInt32                    transactionId)
+    {
+        return uaSubscription_->beginCreateMonitoredItems(
+                serviceSettings, timeStamps, createRequests, transactionId);
+    }
+
+
+    // Modify monitored items
+    // =============================================================================================
+    UaStatus SdkSubscriptionTransport::modifyMonitoredItems(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_TimestampsToReturn        timeStamps,
+            UaMonitoredItemModifyRequests&  modifyRequests,
+            UaMonitoredItemModifyResults&   modifyResults)
+    {
+        return uaSubscription_->modifyMonitoredItems(
+                serviceSettings, timeStamps, modifyRequests, modifyResults);
+    }
+
+
+    // Set the monitoring mode
+    // =============================================================================================
+    UaStatus SdkSubscriptionTransport::setMonitoringMode(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_MonitoringMode            monitoringMode,
+            const UaUInt32Array&            monitoredItemIds,
+            UaStatusCodeArray&              results)
+    {
+        return uaSubscription_->setMonitoringMode(
+                serviceSettings, monitoringMode, monitoredItemIds, results);
+    }
+
+
+    // Delete monitored items
+    // =============================================================================================
+    UaStatus SdkSubscriptionTransport::deleteMonitoredItems(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            const UaUInt32Array&            monitoredItemIds,
+            UaStatusCodeArray&              results)
+    {
+        return uaSubscription_->deleteMonitoredItems(serviceSettings, monitoredItemIds, results);
+    }
+
+
+    // Set the publishing mode
+    // =============================================================================================
+    UaStatus SdkSubscriptionTransport::setPublishingMode(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_Boolean                   publishingEnabled)
+    {
+        return uaSubscription_->setPublishingMode(serviceSettings, publishingEnabled);
+    }
+
+
+    // Republish
+    // =============================================================================================
+    UaStatus SdkSubscriptionTransport::republish(
+            UaClientSdk::ServiceSettings&   serviceSettings,
+            OpcUa_UInt32                    retransmitSequenceNumber,
+            UaExtensionObjectArray&         notificationData,
+            UaDateTime&                     publishTime)
+    {
+        return uaSubscription_->republish(
+                serviceSettings, retransmitSequenceNumber, notificationData, publishTime);
+    }
+
+}
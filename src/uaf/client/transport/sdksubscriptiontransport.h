@@ -0,0 +1,110 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SDKSUBSCRIPTIONTRANSPORT_H_
+#define UAF_SDKSUBSCRIPTIONTRANSPORT_H_
+
+
+
+// STD
+// SDK
+#include "uaclient/uaclientsdk.h"
+#include "uaclient/uasubscription.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/transport/subscriptiontransport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::SdkSubscriptionTransport invokes the services of a subscription of the SDK.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT SdkSubscriptionTransport : public uaf::SubscriptionTransport
+    {
+    public:
+
+
+        /**
+         * Wrap an SDK subscription.
+         *
+         * @param uaSubscription    The SDK subscription, owned by the SDK session that created it.
+         */
+        SdkSubscriptionTransport(UaClientSdk::UaSubscription* uaSubscription);
+
+
+        /**
+         * Get (a reference to) the pointer to the wrapped SDK subscription.
+         */
+        UaClientSdk::UaSubscription*& uaSubscription() { return uaSubscription_; }
+
+
+        // overridden from uaf::SubscriptionTransport
+        virtual UaStatus createMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemCreateRequests&  createRequests,
+                UaMonitoredItemCreateResults&   createResults);
+        virtual UaStatus beginCreateMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemCreateRequests&  createRequests,
+                OpcUa_UInt32                    transactionId);
+        virtual UaStatus modifyMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemModifyRequests&  modifyRequests,
+                UaMonitoredItemModifyResults&   modifyResults);
+        virtual UaStatus setMonitoringMode(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_MonitoringMode            monitoringMode,
+                const UaUInt32Array&            monitoredItemIds,
+                UaStatusCodeArray&              results);
+        virtual UaStatus deleteMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaUInt32Array&            monitoredItemIds,
+                UaStatusCodeArray&              results);
+        virtual UaStatus setPublishingMode(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Boolean                   publishingEnabled);
+        virtual UaStatus republish(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_UInt32                    retransmitSequenceNumber,
+                UaExtensionObjectArray&         notificationData,
+                UaDateTime&                     publishTime);
+
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(SdkSubscriptionTransport);
+
+        // the wrapped SDK subscription
+        UaClientSdk::UaSubscription* uaSubscription_;
+
+    };
+}
+
+
+#endif /* UAF_SDKSUBSCRIPTIONTRANSPORT_H_ */
@@ -0,0 +1,302 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SESSIONTRANSPORT_H_
+#define UAF_SESSIONTRANSPORT_H_
+
+
+
+// STD
+// SDK
+#include "uaclient/uaclientsdk.h"
+#include "uaclient/uasession.h"
+#include "uabase/uastring.h"
+#include "uabase/uanodeid.h"
+#include "uabase/uaarraytemplates.h"
+#include "uabase/uastructuredefinition.h"
+#include "uabase/statuscode.h"
+// UAF
+#include "uaf/client/clientexport.h"
+#include "uaf/client/transport/subscriptiontransport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::SessionTransport invokes the services of a uaf::Session.
+    *
+    * The methods have the same signatures as the corresponding methods of the SDK session
+    * (UaClientSdk::UaSession), so that the uaf::Session, the uaf::Subscription and the
+    * invocations can use either an SDK session (see uaf::SdkSessionTransport, the default) or a
+    * session of an in-process server (see uaf::LoopbackServer), without knowing which one.
+    * The asynchronous results and the connection status changes are passed to the
+    * UaClientSdk::UaSessionCallback that was given when the transport was connected.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT SessionTransport
+    {
+    public:
+        /**
+         * Virtual destructor.
+         */
+        virtual ~SessionTransport() {}
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name Connection
+         *  Connect and disconnect the session.
+         */
+        ///@{
+
+
+        /**
+         * Is the server in the same process (i.e. is there no need for security, and no server
+         * certificate to verify)?
+         */
+        virtual bool isInProcess() const = 0;
+
+
+        /**
+         * Connect the session to the given endpoint.
+         */
+        virtual UaStatus connect(
+                const UaString&                     endpointUrl,
+                UaClientSdk::SessionConnectInfo&    sessionConnectInfo,
+                UaClientSdk::SessionSecurityInfo&   sessionSecurityInfo,
+                UaClientSdk::UaSessionCallback*     sessionCallback) = 0;
+
+
+        /**
+         * Disconnect the session.
+         */
+        virtual UaStatus disconnect(
+                UaClientSdk::ServiceSettings&       serviceSettings,
+                OpcUa_Boolean                       deleteSubscriptions) = 0;
+
+
+        /**
+         * Is the session connected?
+         */
+        virtual OpcUa_Boolean isConnected() const = 0;
+
+
+        /**
+         * Get the state of the connection to the server.
+         */
+        virtual UaClientSdk::UaClient::ServerStatus serverState() const = 0;
+
+
+        /**
+         * Get the URL of the endpoint that is currently used.
+         */
+        virtual UaString currentlyUsedEndpointUrl() const = 0;
+
+
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name Services
+         *  Invoke the services of the session.
+         */
+        ///@{
+
+
+        /**
+         * Read attributes synchronously.
+         */
+        virtual UaStatus read(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Double                    maxAge,
+                OpcUa_TimestampsToReturn        timestampsToReturn,
+                const UaReadValueIds&           nodesToRead,
+                UaDataValues&                   values,
+                UaDiagnosticInfos&              diagnosticInfos) = 0;
+
+
+        /**
+         * Read attributes asynchronously (the results are passed to
+         * UaSessionCallback::readComplete()).
+         */
+        virtual UaStatus beginRead(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Double                    maxAge,
+                OpcUa_TimestampsToReturn        timestampsToReturn,
+                const UaReadValueIds&           nodesToRead,
+                OpcUa_UInt32                    transactionId) = 0;
+
+
+        /**
+         * Write attributes synchronously.
+         */
+        virtual UaStatus write(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaWriteValues&            nodesToWrite,
+                UaStatusCodeArray&              results,
+                UaDiagnosticInfos&              diagnosticInfos) = 0;
+
+
+        /**
+         * Write attributes asynchronously (the results are passed to
+         * UaSessionCallback::writeComplete()).
+         */
+        virtual UaStatus beginWrite(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaWriteValues&            nodesToWrite,
+                OpcUa_UInt32                    transactionId) = 0;
+
+
+        /**
+         * Browse nodes synchronously.
+         */
+        virtual UaStatus browseList(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const OpcUa_ViewDescription&    view,
+                OpcUa_UInt32                    maxReferencesToReturn,
+                const UaBrowseDescriptions&     nodesToBrowse,
+                UaBrowseResults&                results,
+                UaDiagnosticInfos&              diagnosticInfos) = 0;
+
+
+        /**
+         * Continue browsing nodes synchronously.
+         */
+        virtual UaStatus browseListNext(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Boolean                   releaseContinuationPoints,
+                const UaByteStringArray&        continuationPoints,
+                UaBrowseResults&                results,
+                UaDiagnosticInfos&              diagnosticInfos) = 0;
+
+
+        /**
+         * Translate browse paths to node ids synchronously.
+         */
+        virtual UaStatus translateBrowsePathsToNodeIds(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaBrowsePaths&            browsePaths,
+                UaBrowsePathResults&            results,
+                UaDiagnosticInfos&              diagnosticInfos) = 0;
+
+
+        /**
+         * Call methods synchronously.
+         */
+        virtual UaStatus callList(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaCallMethodRequests&     callMethodRequests,
+                UaCallMethodResults&            results,
+                UaDiagnosticInfos&              diagnosticInfos) = 0;
+
+
+        /**
+         * Call a method asynchronously (the results are passed to
+         * UaSessionCallback::callComplete()).
+         */
+        virtual UaStatus beginCall(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaClientSdk::CallIn&      callRequest,
+                OpcUa_UInt32                    transactionId) = 0;
+
+
+        /**
+         * Read the raw or modified history synchronously.
+         */
+        virtual UaStatus historyReadRawModified(
+                UaClientSdk::ServiceSettings&               serviceSettings,
+                UaClientSdk::HistoryReadRawModifiedContext& context,
+                const UaHistoryReadValueIds&                nodesToRead,
+                UaClientSdk::HistoryReadDataResults&        results,
+                UaDiagnosticInfos&                          diagnosticInfos) = 0;
+
+
+        /**
+         * Register nodes synchronously.
+         */
+        virtual UaStatus registerNodes(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaNodeIdArray&            nodesToRegister,
+                UaNodeIdArray&                  registeredNodeIds) = 0;
+
+
+        /**
+         * Unregister nodes synchronously.
+         */
+        virtual UaStatus unregisterNodes(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaNodeIdArray&            nodesToUnregister) = 0;
+
+
+        /**
+         * Get the definition of a structured data type (an empty definition if it's unknown).
+         */
+        virtual UaStructureDefinition structureDefinition(const UaNodeId& dataTypeId) = 0;
+
+
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name Subscriptions
+         *  Create and delete subscriptions.
+         */
+        ///@{
+
+
+        /**
+         * Create a subscription.
+         *
+         * @param serviceSettings           Settings of the service.
+         * @param subscriptionCallback      Callback to pass the notifications and the asynchronous
+         *                                  results of the subscription to.
+         * @param clientSubscriptionHandle  Handle of the subscription, passed to the callback.
+         * @param subscriptionSettings      Requested settings, updated with the revised settings.
+         * @param publishingEnabled         True to enable the publishing.
+         * @param subscription              Output parameter: the created subscription, owned by
+         *                                  the session transport.
+         */
+        virtual UaStatus createSubscription(
+                UaClientSdk::ServiceSettings&           serviceSettings,
+                UaClientSdk::UaSubscriptionCallback*    subscriptionCallback,
+                OpcUa_UInt32                            clientSubscriptionHandle,
+                UaClientSdk::SubscriptionSettings&      subscriptionSettings,
+                OpcUa_Boolean                           publishingEnabled,
+                uaf::SubscriptionTransport**            subscription) = 0;
+
+
+        /**
+         * Delete a subscription that was created by createSubscription().
+         *
+         * @param serviceSettings   Settings of the service.
+         * @param subscription      The subscription to delete (the pointer is set to NULL).
+         */
+        virtual UaStatus deleteSubscription(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                uaf::SubscriptionTransport**    subscription) = 0;
+
+
+        ///@}
+
+    };
+}
+
+
+#endif /* UAF_SESSIONTRANSPORT_H_ */
@@ -0,0 +1,99 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SESSIONTRANSPORTFACTORY_H_
+#define UAF_SESSIONTRANSPORTFACTORY_H_
+
+
+
+// STD
+#include <string>
+#include <vector>
+// SDK
+// UAF
+#include "uaf/util/endpointdescription.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/transport/sessiontransport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::SessionTransportFactory creates the transports of the sessions of a client (see
+    * uaf::Client::setSessionTransportFactory()).
+    *
+    * If no factory is set, every session uses a uaf::SdkSessionTransport. A factory that serves
+    * in-process servers (such as uaf::LoopbackServer) may also answer the discovery of its
+    * servers, so that no FindServers and GetEndpoints services need to be invoked for them.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT SessionTransportFactory
+    {
+    public:
+        /**
+         * Virtual destructor.
+         */
+        virtual ~SessionTransportFactory() {}
+
+
+        /**
+         * Create the transport of a new session.
+         *
+         * @return  A new transport, which will be deleted by the session.
+         */
+        virtual uaf::SessionTransport* createSessionTransport() = 0;
+
+
+        /**
+         * Get the discovery URLs of a server that is served by this factory.
+         *
+         * @param serverUri     The URI of the server.
+         * @param discoveryUrls Output parameter: the discovery URLs of the server.
+         * @return              False if the server is not served by this factory (the discovery
+         *                      of the client is then used instead).
+         */
+        virtual bool discoveryUrls(
+                const std::string&          serverUri,
+                std::vector<std::string>&   discoveryUrls)
+        { return false; }
+
+
+        /**
+         * Get the endpoints of a discovery URL that is served by this factory.
+         *
+         * @param discoveryUrl          The discovery URL.
+         * @param endpointDescriptions  Output parameter: the endpoints.
+         * @return                      False if the URL is not served by this factory (the
+         *                              GetEndpoints service is then invoked instead).
+         */
+        virtual bool endpoints(
+                const std::string&                      discoveryUrl,
+                std::vector<uaf::EndpointDescription>&  endpointDescriptions)
+        { return false; }
+
+    };
+}
+
+
+#endif /* UAF_SESSIONTRANSPORTFACTORY_H_ */
@@ -0,0 +1,134 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SUBSCRIPTIONTRANSPORT_H_
+#define UAF_SUBSCRIPTIONTRANSPORT_H_
+
+
+
+// STD
+// SDK
+#include "uaclient/uaclientsdk.h"
+#include "uabase/uaarraytemplates.h"
+#include "uabase/uadatetime.h"
+#include "uabase/statuscode.h"
+// UAF
+#include "uaf/client/clientexport.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::SubscriptionTransport invokes the services of a subscription that has been created by
+    * a uaf::SessionTransport.
+    *
+    * The methods have the same signatures as the corresponding methods of the SDK subscription
+    * (UaClientSdk::UaSubscription), so the invocations can call either an SDK subscription (see
+    * uaf::SdkSubscriptionTransport) or a subscription of an in-process server (see
+    * uaf::LoopbackSubscriptionTransport). The asynchronous results and the notifications are
+    * passed to the UaClientSdk::UaSubscriptionCallback that was given when the subscription was
+    * created.
+    *
+    * @ingroup ClientTransport
+    ***********************************************************************************************/
+    class UAF_EXPORT SubscriptionTransport
+    {
+    public:
+        /**
+         * Virtual destructor.
+         */
+        virtual ~SubscriptionTransport() {}
+
+
+        /**
+         * Create monitored items synchronously.
+         */
+        virtual UaStatus createMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemCreateRequests&  createRequests,
+                UaMonitoredItemCreateResults&   createResults) = 0;
+
+
+        /**
+         * Create monitored items asynchronously (the results are passed to
+         * UaSubscriptionCallback::createMonitoredItemsComplete()).
+         */
+        virtual UaStatus beginCreateMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemCreateRequests&  createRequests,
+                OpcUa_UInt32                    transactionId) = 0;
+
+
+        /**
+         * Modify monitored items synchronously.
+         */
+        virtual UaStatus modifyMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_TimestampsToReturn        timeStamps,
+                UaMonitoredItemModifyRequests&  modifyRequests,
+                UaMonitoredItemModifyResults&   modifyResults) = 0;
+
+
+        /**
+         * Set the monitoring mode of monitored items synchronously.
+         */
+        virtual UaStatus setMonitoringMode(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_MonitoringMode            monitoringMode,
+                const UaUInt32Array&            monitoredItemIds,
+                UaStatusCodeArray&              results) = 0;
+
+
+        /**
+         * Delete monitored items synchronously.
+         */
+        virtual UaStatus deleteMonitoredItems(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                const UaUInt32Array&            monitoredItemIds,
+                UaStatusCodeArray&              results) = 0;
+
+
+        /**
+         * Enable or disable the publishing of the subscription.
+         */
+        virtual UaStatus setPublishingMode(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_Boolean                   publishingEnabled) = 0;
+
+
+        /**
+         * Ask the server to send a NotificationMessage again.
+         */
+        virtual UaStatus republish(
+                UaClientSdk::ServiceSettings&   serviceSettings,
+                OpcUa_UInt32                    retransmitSequenceNumber,
+                UaExtensionObjectArray&         notificationData,
+                UaDateTime&                     publishTime) = 0;
+
+    };
+}
+
+
+#endif /* UAF_SUBSCRIPTIONTRANSPORT_H_ */
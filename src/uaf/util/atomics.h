@@ -0,0 +1,143 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_ATOMICS_H_
+#define UAF_ATOMICS_H_
+
+
+// STD
+#if defined(_MSC_VER)
+#include <intrin.h>
+#pragma intrinsic(_InterlockedIncrement)
+#pragma intrinsic(_InterlockedDecrement)
+#pragma intrinsic(_InterlockedExchangeAdd)
+#pragma intrinsic(_InterlockedExchange)
+#pragma intrinsic(_InterlockedCompareExchange)
+#endif
+// SDK
+// UAF
+
+
+
+namespace uaf
+{
+
+    /**
+     * A counter that can be updated atomically (i.e. without needing a mutex) by different
+     * threads, e.g. a reference count of a shared object.
+     *
+     * @ingroup Util
+     */
+    typedef volatile long AtomicCount;
+
+
+    /**
+     * Atomically increment a counter.
+     *
+     * @param count The counter to increment.
+     * @return      The new value of the counter.
+     */
+    inline long atomicIncrement(AtomicCount* count)
+    {
+#if defined(_MSC_VER)
+        return _InterlockedIncrement(count);
+#else
+        return __sync_add_and_fetch(count, 1L);
+#endif
+    }
+
+
+    /**
+     * Atomically decrement a counter.
+     *
+     * @param count The counter to decrement.
+     * @return      The new value of the counter.
+     */
+    inline long atomicDecrement(AtomicCount* count)
+    {
+#if defined(_MSC_VER)
+        return _InterlockedDecrement(count);
+#else
+        return __sync_sub_and_fetch(count, 1L);
+#endif
+    }
+
+
+    /**
+     * Atomically read a counter.
+     *
+     * @param count The counter to read.
+     * @return      The current value of the counter.
+     */
+    inline long atomicGet(AtomicCount* count)
+    {
+#if defined(_MSC_VER)
+        return _InterlockedExchangeAdd(count, 0L);
+#else
+        return __sync_add_and_fetch(count, 0L);
+#endif
+    }
+
+
+    /**
+     * Atomically replace a pointer (e.g. to publish a new version of a shared object).
+     *
+     * @param target    The pointer to replace.
+     * @param value     The new value of the pointer.
+     * @return          The previous value of the pointer.
+     */
+    inline void* atomicExchangePointer(void* volatile* target, void* value)
+    {
+#if defined(_MSC_VER) && defined(_WIN64)
+        return _InterlockedExchangePointer(target, value);
+#elif defined(_MSC_VER)
+        return reinterpret_cast<void*>(
+                _InterlockedExchange(reinterpret_cast<volatile long*>(target),
+                                     reinterpret_cast<long>(value)));
+#else
+        // __sync_lock_test_and_set is only an acquire barrier, so add a full one first
+        __sync_synchronize();
+        return __sync_lock_test_and_set(target, value);
+#endif
+    }
+
+
+    /**
+     * Atomically read a pointer.
+     *
+     * @param target    The pointer to read.
+     * @return          The current value of the pointer.
+     */
+    inline void* atomicGetPointer(void* volatile* target)
+    {
+#if defined(_MSC_VER) && defined(_WIN64)
+        return _InterlockedCompareExchangePointer(target, 0, 0);
+#elif defined(_MSC_VER)
+        return reinterpret_cast<void*>(
+                _InterlockedCompareExchange(reinterpret_cast<volatile long*>(target), 0L, 0L));
+#else
+        return __sync_val_compare_and_swap(target, static_cast<void*>(0), static_cast<void*>(0));
+#endif
+    }
+
+}
+
+
+#endif /* UAF_ATOMICS_H_ */
@@ -65,6 +65,18 @@ namespace uaf
     }
 
 
+    // Take over the contents of an OpcUa_ByteString instance
+    // =============================================================================================
+    void ByteString::fromSdkWithDetach(OpcUa_ByteString& opcUaByteString)
+    {
+        uaByteString_.clear();
+        uaByteString_.attach(&opcUaByteString);
+
+        // the contents are owned by the UaByteString now
+        OpcUa_ByteString_Initialize(&opcUaByteString);
+    }
+
+
     // Convert a UaByteArray
     // =============================================================================================
     void ByteString::toSdk(UaByteArray& uaByteArray) const
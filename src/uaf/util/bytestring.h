@@ -109,6 +109,16 @@ namespace uaf
         void fromSdk(const UaByteArray& uaByteArray);
 
 
+        /**
+         * Take over the contents of a stack OpcUa_ByteString instance, without copying them.
+         *
+         * The stack instance is left empty (but it still needs to be cleared as usual).
+         *
+         * @param opcUaByteString  Stack OpcUa_ByteString instance to take the contents from.
+         */
+        void fromSdkWithDetach(OpcUa_ByteString& opcUaByteString);
+
+
         /**
          * Copy the contents to an SDK instance.
          *
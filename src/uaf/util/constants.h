@@ -49,6 +49,9 @@ namespace uaf
         /** Maximum client handle value. */
         static const uint32_t CLIENTHANDLE_MAX = OpcUa_UInt32_Max - 1;
 
+        /** ClientSubscriptionHandle value when it was not assigned. */
+        static const uint32_t CLIENTSUBSCRIPTIONHANDLE_NOT_ASSIGNED = OpcUa_UInt32_Max;
+
         /** RequestHandle value when it was not assigned. */
         static const uaf::RequestHandle REQUESTHANDLE_NOT_ASSIGNED = OpcUa_UInt64_Max;
 
@@ -0,0 +1,108 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CONSTSPAN_H_
+#define UAF_CONSTSPAN_H_
+
+
+// STD
+#include <vector>
+#include <cstddef>
+// SDK
+// UAF
+
+
+
+namespace uaf
+{
+
+    /*******************************************************************************************//**
+    * A ConstSpan is a read-only view on a contiguous sequence of objects (e.g. the elements of a
+    * std::vector) that is owned by someone else.
+    *
+    * It is used to pass large sequences (such as the notifications of a publish response) to
+    * callbacks without copying them. The span is only valid as long as the viewed sequence
+    * exists and is not modified, so a callback must copy the elements it wants to keep.
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    template<typename T>
+    class ConstSpan
+    {
+    public:
+
+        typedef const T* const_iterator;
+
+
+        /**
+         * Construct an empty span.
+         */
+        ConstSpan()
+        : data_(NULL), size_(0)
+        {}
+
+
+        /**
+         * Construct a span of the given number of objects.
+         */
+        ConstSpan(const T* data, std::size_t size)
+        : data_(data), size_(size)
+        {}
+
+
+        /**
+         * Construct a span of all elements of a vector.
+         */
+        explicit ConstSpan(const std::vector<T>& vector)
+        : data_(vector.empty() ? NULL : &vector[0]), size_(vector.size())
+        {}
+
+
+        /** Get the number of objects. */
+        std::size_t size() const { return size_; }
+
+        /** Check if the span is empty. */
+        bool empty() const { return size_ == 0; }
+
+        /** Get the object at the given index. */
+        const T& operator[](std::size_t i) const { return data_[i]; }
+
+        /** Get an iterator to the first object. */
+        const_iterator begin() const { return data_; }
+
+        /** Get an iterator beyond the last object. */
+        const_iterator end() const { return data_ + size_; }
+
+        /** Copy the objects to a new vector. */
+        std::vector<T> toVector() const { return std::vector<T>(begin(), end()); }
+
+
+    private:
+
+        // the first object
+        const T*    data_;
+        // the number of objects
+        std::size_t size_;
+    };
+
+}
+
+
+#endif /* UAF_CONSTSPAN_H_ */
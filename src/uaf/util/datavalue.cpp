@@ -132,6 +132,19 @@ namespace uaf
     }
 
 
+    // Take over the contents of an OpcUa_DataValue instance
+    // =============================================================================================
+    void DataValue::fromSdkWithDetach(OpcUa_DataValue& opcUaDataValue)
+    {
+        opcUaStatusCode = opcUaDataValue.StatusCode;
+        data.fromSdkWithDetach(opcUaDataValue.Value);
+        sourceTimestamp.fromSdk(UaDateTime(opcUaDataValue.SourceTimestamp));
+        serverTimestamp.fromSdk(UaDateTime(opcUaDataValue.ServerTimestamp));
+        sourcePicoseconds = opcUaDataValue.SourcePicoseconds;
+        serverPicoseconds = opcUaDataValue.ServerPicoseconds;
+    }
+
+
     // Copy the contents to a UaDataValue instance
     // =============================================================================================
     void DataValue::toSdk(UaDataValue& uaDataValue) const
@@ -167,9 +180,25 @@ namespace uaf
     // =============================================================================================
     void DataValue::toSdk(OpcUa_DataValue* dest) const
     {
-        UaDataValue v;
-        toSdk(v);
-        v.copyTo(dest);
+        // fill the stack instance directly, instead of copying it from a UaDataValue
+        OpcUa_DataValue_Initialize(dest);
+
+        if (!data.isNull())
+            data.toSdk(&dest->Value);
+
+        dest->StatusCode = opcUaStatusCode;
+
+        if (!sourceTimestamp.isNull())
+        {
+            sourceTimestamp.toSdk(&dest->SourceTimestamp);
+            dest->SourcePicoseconds = sourcePicoseconds;
+        }
+
+        if (!serverTimestamp.isNull())
+        {
+            serverTimestamp.toSdk(&dest->ServerTimestamp);
+            dest->ServerPicoseconds = serverPicoseconds;
+        }
     }
 
 
@@ -115,6 +115,17 @@ namespace uaf
         void fromSdk(const UaDataValue& uaDataValue);
 
 
+        /**
+         * Take over the contents of a stack OpcUa_DataValue instance, without copying the data.
+         *
+         * The data of the stack instance is left empty (but it still needs to be cleared as
+         * usual).
+         *
+         * @param opcUaDataValue  Stack OpcUa_DataValue instance to take the contents from.
+         */
+        void fromSdkWithDetach(OpcUa_DataValue& opcUaDataValue);
+
+
         /**
          * Copy the contents to an SDK instance.
          *
@@ -226,6 +226,24 @@ namespace uaf
     };
 
 
+    class UAF_EXPORT UnknownRegisteredNodesHandleError : public uaf::InvalidRequestError
+    {
+    public:
+        UnknownRegisteredNodesHandleError()
+        : uaf::InvalidRequestError("Unknown registered nodes handle"),
+          unknownRegisteredNodesHandle(0)
+        {}
+
+        UnknownRegisteredNodesHandleError(uaf::RegisteredNodesHandle unknownRegisteredNodesHandle)
+        : uaf::InvalidRequestError(uaf::format("Unknown registered nodes handle (%d)",
+                                               unknownRegisteredNodesHandle)),
+          unknownRegisteredNodesHandle(unknownRegisteredNodesHandle)
+        {}
+
+        uaf::RegisteredNodesHandle unknownRegisteredNodesHandle;
+    };
+
+
     class UAF_EXPORT DefinitionNotFoundError : public uaf::InvalidRequestError
     {
     public:
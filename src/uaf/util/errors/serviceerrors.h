@@ -555,6 +555,133 @@ namespace uaf
     };
 
 
+    class UAF_EXPORT DeleteMonitoredItemsInvocationError : public uaf::ServiceError
+    {
+    public:
+        DeleteMonitoredItemsInvocationError()
+        : uaf::ServiceError("Could not invoke the DeleteMonitoredItems service")
+        {}
+
+        DeleteMonitoredItemsInvocationError(const uaf::SdkStatus& sdkStatus)
+        : uaf::ServiceError(uaf::format("Could not invoke the DeleteMonitoredItems service: %s",
+                            sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
+
+    class UAF_EXPORT ServerCouldNotDeleteMonitoredItemError : public uaf::ServiceError
+    {
+    public:
+        ServerCouldNotDeleteMonitoredItemError()
+        : uaf::ServiceError("The server could not delete the monitored item successfully"),
+          clientHandle(uaf::constants::CLIENTHANDLE_NOT_ASSIGNED)
+        {}
+
+        ServerCouldNotDeleteMonitoredItemError(uaf::ClientHandle clientHandle, uaf::SdkStatus sdkStatus)
+        : uaf::ServiceError(uaf::format("The server could not delete the monitored item successfully for clientHandle %d: %s",
+                                        clientHandle,
+                                        sdkStatus.toString().c_str())),
+          clientHandle(clientHandle),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::ClientHandle clientHandle;
+        uaf::SdkStatus sdkStatus;
+    };
+
+
+    class UAF_EXPORT ModifyMonitoredItemsInvocationError : public uaf::ServiceError
+    {
+    public:
+        ModifyMonitoredItemsInvocationError()
+        : uaf::ServiceError("Could not invoke the ModifyMonitoredItems service")
+        {}
+
+        ModifyMonitoredItemsInvocationError(const uaf::SdkStatus& sdkStatus)
+        : uaf::ServiceError(uaf::format("Could not invoke the ModifyMonitoredItems service: %s",
+                            sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
+
+    class UAF_EXPORT ServerCouldNotModifyMonitoredItemError : public uaf::ServiceError
+    {
+    public:
+        ServerCouldNotModifyMonitoredItemError()
+        : uaf::ServiceError("The server could not modify the monitored item successfully"),
+          clientHandle(uaf::constants::CLIENTHANDLE_NOT_ASSIGNED)
+        {}
+
+        ServerCouldNotModifyMonitoredItemError(uaf::ClientHandle clientHandle, uaf::SdkStatus sdkStatus)
+        : uaf::ServiceError(uaf::format("The server could not modify the monitored item successfully for clientHandle %d: %s",
+                                        clientHandle,
+                                        sdkStatus.toString().c_str())),
+          clientHandle(clientHandle),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::ClientHandle clientHandle;
+        uaf::SdkStatus sdkStatus;
+    };
+
+
+    class UAF_EXPORT RepublishInvocationError : public uaf::ServiceError
+    {
+    public:
+        RepublishInvocationError()
+        : uaf::ServiceError("Could not invoke the Republish service")
+        {}
+
+        RepublishInvocationError(const uaf::SdkStatus& sdkStatus)
+        : uaf::ServiceError(uaf::format("Could not invoke the Republish service: %s",
+                            sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
+
+    class UAF_EXPORT RegisterNodesInvocationError : public uaf::ServiceError
+    {
+    public:
+        RegisterNodesInvocationError()
+        : uaf::ServiceError("Could not invoke the RegisterNodes service")
+        {}
+
+        RegisterNodesInvocationError(const uaf::SdkStatus& sdkStatus)
+        : uaf::ServiceError(uaf::format("Could not invoke the RegisterNodes service: %s",
+                            sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
+
+    class UAF_EXPORT UnregisterNodesInvocationError : public uaf::ServiceError
+    {
+    public:
+        UnregisterNodesInvocationError()
+        : uaf::ServiceError("Could not invoke the UnregisterNodes service")
+        {}
+
+        UnregisterNodesInvocationError(const uaf::SdkStatus& sdkStatus)
+        : uaf::ServiceError(uaf::format("Could not invoke the UnregisterNodes service: %s",
+                            sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
+
     class UAF_EXPORT BadDataReceivedError : public uaf::ServiceError
     {
     public:
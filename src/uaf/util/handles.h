@@ -92,6 +92,15 @@ namespace uaf
      */
     typedef uint32_t ClientHandle;
 
+    /**
+     * A RegisteredNodesHandle is a 32-bit number assigned by the UAF to a set of nodes that
+     * was registered by the client (by invoking the RegisterNodes service). The number will be
+     * incremented on each new registration.
+     *
+     * @ingroup Util
+     */
+    typedef uint32_t RegisteredNodesHandle;
+
     /**
      * A ServerIndex is an unsigned 32-bit integer, identifying a server in a ServerArray.
      *
@@ -112,6 +112,18 @@ namespace uaf
     }
 
 
+    // Take over the contents of a stack object
+    // =============================================================================================
+    void LocalizedText::fromSdkWithDetach(OpcUa_LocalizedText& opcUaLocalizedText)
+    {
+        uaLocalizedText_.clear();
+        uaLocalizedText_.attach(&opcUaLocalizedText);
+
+        // the contents are owned by the UaLocalizedText now
+        OpcUa_LocalizedText_Initialize(&opcUaLocalizedText);
+    }
+
+
     // Fill the SDK object
     // =============================================================================================
     void LocalizedText::toSdk(UaLocalizedText& uaLocalizedText) const
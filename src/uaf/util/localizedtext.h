@@ -115,6 +115,14 @@ namespace uaf
         void fromSdk(const UaLocalizedText& uaLocalizedText);
 
 
+        /**
+         * Take over the contents of a stack object, without copying them.
+         *
+         * The stack object is left empty (but it still needs to be cleared as usual).
+         */
+        void fromSdkWithDetach(OpcUa_LocalizedText& opcUaLocalizedText);
+
+
         /**
          * Fill the SDK object.
          */
@@ -346,6 +346,15 @@ namespace uaf
         void debug(const std::string& msg);
 
 
+        /**
+         * Check if debug messages are logged, so that callers can skip building expensive
+         * messages (such as the string representation of a large request) when they are not.
+         *
+         * @return  True if debug messages will be logged.
+         */
+        bool isDebugEnabled() const { return loggerFactory_->checkLevel(uaf::loglevels::Debug); }
+
+
     private:
         DISALLOW_COPY_AND_ASSIGN(Logger);
 
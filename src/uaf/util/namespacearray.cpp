@@ -29,6 +29,10 @@ namespace uaf
     using std::vector;
 
 
+    // the value of indexOfAtom_ for atoms that are not in the namespace array
+    static const uint32_t NO_INDEX = 0xFFFFFFFF;
+
+
     // Constructor
     // =============================================================================================
     NamespaceArray::NamespaceArray() {}
@@ -53,13 +57,28 @@ namespace uaf
             // convert the value to a StringArray
             uaConversionStatusCode = UaVariant(value.Value).toStringArray(namespaceArray_);
 
-            // if the conversion succeeded, fill the map with simplified URIs
+            // if the conversion succeeded, fill the map with simplified URIs, and the
+            // translation tables with the atoms of these simplified URIs
             if (OpcUa_IsGood(uaConversionStatusCode))
             {
+                nameSpaceMap_.clear();
+                atomOfIndex_.assign(namespaceArray_.length(), EMPTY_NAMESPACE_ATOM);
+                indexOfAtom_.clear();
+
                 for (uint16_t i=0; i<namespaceArray_.length(); i++)
                 {
-                    nameSpaceMap_[i] = NamespaceArray::getSimplifiedUri(
-                            string(UaString(&namespaceArray_[i]).toUtf8()));
+                    NamespaceAtom atom = NamespaceUris::simplified(NamespaceUris::intern(
+                            string(UaString(&namespaceArray_[i]).toUtf8())));
+
+                    nameSpaceMap_[i] = NamespaceUris::uri(atom);
+                    atomOfIndex_[i]  = atom;
+
+                    if (atom >= indexOfAtom_.size())
+                        indexOfAtom_.resize(atom + 1, NO_INDEX);
+
+                    // if the same URI appears twice, the lowest index is used
+                    if (indexOfAtom_[atom] == NO_INDEX)
+                        indexOfAtom_[atom] = i;
                 }
             }
             else
@@ -101,29 +120,33 @@ namespace uaf
             const string&   namespaceUri,
             NameSpaceIndex& namespaceIndex) const
     {
-        // We need to do a "reverse" lookup, by iterating over the key:value pairs until we have
-        // found the correct value.
+        // if the URI (or its simplified version) was never interned, it can't be in the array
+        NamespaceAtom atom;
+        if (NamespaceUris::find(namespaceUri, atom)
+                || NamespaceUris::find(NamespaceUris::simplify(namespaceUri), atom))
+            return findNamespaceIndex(atom, namespaceIndex);
+        else
+            return false;
+    }
 
-        // get a simplified URI
-        string simplifiedUri = NamespaceArray::getSimplifiedUri(namespaceUri);
 
-        // iterate over the key:value pairs
-        NameSpaceMap::const_iterator iter;
-        for (iter = nameSpaceMap_.begin(); iter != nameSpaceMap_.end(); ++iter)
-        {
-            // if the NamespaceURI was found, assign the NamespaceIndex, update the status,
-            // and return
-            if (iter->second == simplifiedUri)
-            {
-                namespaceIndex = iter->first;
+    // Look up the NamespaceIndex for a given interned NamespaceURI
+    // =============================================================================================
+    bool NamespaceArray::findNamespaceIndex(
+            NamespaceAtom   namespaceUriAtom,
+            NameSpaceIndex& namespaceIndex) const
+    {
+        NamespaceAtom simplifiedAtom = NamespaceUris::simplified(namespaceUriAtom);
 
-                // we found the URI, so we can return!
-                return true;
-            }
+        if (simplifiedAtom < indexOfAtom_.size() && indexOfAtom_[simplifiedAtom] != NO_INDEX)
+        {
+            namespaceIndex = NameSpaceIndex(indexOfAtom_[simplifiedAtom]);
+            return true;
+        }
+        else
+        {
+            return false;
         }
-
-        // we haven't returned yet, so the URI was not found...
-        return false;
     }
 
 
@@ -144,27 +167,6 @@ namespace uaf
     }
 
 
-    // static function!
-    // Create a simplified (plain) URI
-    // =============================================================================================
-    string NamespaceArray::getSimplifiedUri(const string& uri)
-    {
-        string ret(uri);
-
-        if (ret.size() > 0)
-        {
-            // transform to lower case
-            transform(ret.begin(), ret.end(), ret.begin(), std::ptr_fun<int, int>(tolower));
-            // remove a trailing '/' character
-            if (ret.substr(ret.length()-1, 1) == string("/"))
-            {
-                ret = ret.substr(0, ret.length()-1);
-            }
-        }
-        return ret;
-    }
-
-
     // Convert a uaf::Address to a OpcUa_NodeId
     // =============================================================================================
     Status NamespaceArray::fillOpcUaNodeId(
@@ -193,7 +195,7 @@ namespace uaf
         if (nodeId.hasNameSpaceUri())
         {
 
-            if (findNamespaceIndex(nodeId.nameSpaceUri(), nameSpaceIndex))
+            if (findNamespaceIndex(nodeId.nameSpaceUriAtom(), nameSpaceIndex))
                 ret = statuscodes::Good;
             else
                 ret = UnknownNamespaceUriError(
@@ -294,11 +296,12 @@ namespace uaf
             // we need to get a valid namespace index
             NameSpaceIndex nameSpaceIndex;
 
-            if (findNamespaceIndex(qualifiedName.nameSpaceUri(), nameSpaceIndex))
+            if (findNamespaceIndex(qualifiedName.nameSpaceUriAtom(), nameSpaceIndex))
             {
                 // copy the contents from the qualified name to the SDK object
                 // (except the namespaceUri because that's not relevant for the SDK object anyway)
-                QualifiedName(qualifiedName.name(), nameSpaceIndex).toSdk(&opcUaQualifiedName);
+                UaQualifiedName(qualifiedName.name().c_str(), nameSpaceIndex).copyTo(
+                        &opcUaQualifiedName);
                 ret = statuscodes::Good;
             }
             else
@@ -355,16 +358,68 @@ namespace uaf
     }
 
 
+    // Convert a uaf::EventFilter to an OpcUa_EventFilter extension object
+    // =============================================================================================
+    Status NamespaceArray::fillOpcUaEventFilter(
+            const EventFilter&      eventFilter,
+            OpcUa_ExtensionObject&  opcUaFilter) const
+    {
+        Status ret = statuscodes::Good;
+
+        UaEventFilter uaEventFilter;
+
+        size_t noOfSelectClauses = eventFilter.selectClauses.size();
+
+        for (size_t clauseIndex = 0;
+             clauseIndex < noOfSelectClauses && ret.isGood();
+             clauseIndex++)
+        {
+            // create an operand
+            UaSimpleAttributeOperand operand;
+
+            const SimpleAttributeOperand& selectClause = eventFilter.selectClauses[clauseIndex];
+
+            // set the attribute ID
+            operand.setAttributeId(selectClause.attributeId);
+
+            // set the type definition ID
+            OpcUa_NodeId typeId;
+            ret = fillOpcUaNodeId(selectClause.typeId, typeId);
+            if (ret.isGood())
+                operand.setTypeId(typeId);
+
+            // set the browse path
+            size_t noOfBrowseNames = selectClause.browsePath.size();
+            for (size_t nameIndex = 0;
+                 nameIndex < noOfBrowseNames && ret.isGood();
+                 nameIndex++)
+            {
+                OpcUa_QualifiedName qualifiedName;
+                ret = fillOpcUaQualifiedName(selectClause.browsePath[nameIndex], qualifiedName);
+
+                if (ret.isGood())
+                    operand.setBrowsePathElement(nameIndex, qualifiedName, noOfBrowseNames);
+            }
+
+            if (ret.isGood())
+                uaEventFilter.setSelectClauseElement(clauseIndex, operand, noOfSelectClauses);
+        }
+
+        if (ret.isGood())
+            uaEventFilter.detachFilter(opcUaFilter);
+
+        return ret;
+    }
+
+
     // Fill out a NodeId
     // =============================================================================================
     Status NamespaceArray::fillNodeId(const OpcUa_NodeId& opcUaNodeId, NodeId& nodeId) const
     {
         Status ret;
 
-        string namespaceUri;
-
-        if (findNamespaceUri(opcUaNodeId.NamespaceIndex, namespaceUri))
-            ret = nodeId.fromSdk(opcUaNodeId, namespaceUri);
+        if (opcUaNodeId.NamespaceIndex < atomOfIndex_.size())
+            ret = nodeId.fromSdk(opcUaNodeId, atomOfIndex_[opcUaNodeId.NamespaceIndex]);
         else
             ret = UnknownNamespaceIndexError(opcUaNodeId.NamespaceIndex);
 
@@ -419,11 +474,9 @@ namespace uaf
     {
         Status ret;
 
-        string namespaceUri;
-
-        if (findNamespaceUri(opcUaQualfiedName.NamespaceIndex, namespaceUri))
+        if (opcUaQualfiedName.NamespaceIndex < atomOfIndex_.size())
         {
-            qualifiedName.fromSdk(opcUaQualfiedName, namespaceUri);
+            qualifiedName.fromSdk(opcUaQualfiedName, atomOfIndex_[opcUaQualfiedName.NamespaceIndex]);
             ret = statuscodes::Good;
         }
         else
@@ -26,17 +26,21 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <vector>
 #include <algorithm>
 #include <stdint.h>
 // SDK
 #include "uabase/uaarraytemplates.h"
 #include "uabase/uastring.h"
 #include "uabase/uavariant.h"
+#include "uabase/uaeventfilter.h"
 // UAF
 #include "uaf/util/util.h"
 #include "uaf/util/status.h"
 #include "uaf/util/variant.h"
 #include "uaf/util/address.h"
+#include "uaf/util/eventfilter.h"
+#include "uaf/util/namespaceuris.h"
 
 
 namespace uaf
@@ -81,6 +85,14 @@ namespace uaf
         uaf::Status fromSdk(const OpcUa_DataValue& value);
 
 
+        /**
+         * Get the map of namespace indexes to namespace URIs.
+         *
+         * @return  The map of the NamespaceArray.
+         */
+        const uaf::NameSpaceMap& nameSpaceMap() const { return nameSpaceMap_; }
+
+
         /**
          * Get a string representation of the NamespaceArray.
          *
@@ -113,6 +125,22 @@ namespace uaf
                 NameSpaceIndex&     namespaceIndex) const;
 
 
+#ifndef SWIG
+        /**
+         * Find the NamespaceIndex for a given interned NamespaceURI.
+         *
+         * This is a simple array lookup, so it's the fastest way to resolve a namespace URI.
+         *
+         * @param namespaceUriAtom  The atom of the NamespaceURI that needs to be looked up.
+         * @param namespaceIndex    The NamespaceIndex that will be overwritten.
+         * @return                  True if the URI could be found.
+         */
+        bool findNamespaceIndex(
+                uaf::NamespaceAtom  namespaceUriAtom,
+                NameSpaceIndex&     namespaceIndex) const;
+#endif
+
+
 
         /**
          * Fill an OpcUa_NodeId (which is fully resolved!) from a uaf::NodeId (which may not
@@ -180,6 +208,20 @@ namespace uaf
                 OpcUa_RelativePathElement&      opcUaElement) const;
 
 
+        /**
+         * Fill an OpcUa_ExtensionObject with an OpcUa_EventFilter (which is fully resolved!)
+         * from a uaf::EventFilter (which may not be resolved!).
+         *
+         * @param eventFilter       The uaf::EventFilter to extract the select clauses from.
+         * @param opcUaFilter       The OpcUa_ExtensionObject to be updated (e.g. the Filter of
+         *                          some OpcUa_MonitoringParameters).
+         * @return                  Good if the OpcUa_ExtensionObject could be updated.
+         */
+        uaf::Status fillOpcUaEventFilter(
+                const uaf::EventFilter& eventFilter,
+                OpcUa_ExtensionObject&  opcUaFilter) const;
+
+
         /**
          * Fill a NodeId from an OpcUa_NodeId (which includes filling out the namespace URI).
          *
@@ -261,20 +303,18 @@ namespace uaf
 
     private:
 
-        // the internal NameSpaceIndex:NameSpaceURI map
+        // the internal NameSpaceIndex:NameSpaceURI map (with simplified URIs)
         NameSpaceMap nameSpaceMap_;
 
         // the original array
         UaStringArray namespaceArray_;
 
-        /**
-         * A static function to convert the URI to a "plain" one (no trailing forward slash,
-         * no capitals) in order to simplify comparison.
-         *
-         * @param uri   URI that may contain capitals, a trailing forward slash, ...
-         * @return      A simplified "plain" string.
-         */
-        static std::string getSimplifiedUri(const std::string& uri);
+        // the atoms of the simplified URIs, indexed by namespace index
+        std::vector<uaf::NamespaceAtom> atomOfIndex_;
+
+        // the namespace indexes (or 0xFFFFFFFF if unknown), indexed by the atoms of the
+        // simplified URIs
+        std::vector<uint32_t> indexOfAtom_;
     };
 }
 
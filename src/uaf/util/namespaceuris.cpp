@@ -0,0 +1,291 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/namespaceuris.h"
+
+// STD
+#include <vector>
+#include <cctype>
+// SDK
+#include "uabase/uamutex.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+
+
+    namespace
+    {
+
+        // One interned namespace URI.
+        struct Entry
+        {
+            string          uri;
+            uint32_t        hash;
+            NamespaceAtom   simplified;
+        };
+
+
+        // The entries are stored in chunks that are never moved or freed, so that an entry can be
+        // read without locking while other threads are adding entries.
+        const uint32_t CHUNK_BITS = 10;
+        const uint32_t CHUNK_SIZE = 1 << CHUNK_BITS;
+        const uint32_t MAX_CHUNKS = MAX_NAMESPACE_ATOMS / CHUNK_SIZE;
+
+
+        // FNV-1a hash of a string
+        uint32_t hashOf(const string& s)
+        {
+            uint32_t h = 2166136261u;
+            for (string::const_iterator it = s.begin(); it != s.end(); ++it)
+            {
+                h ^= uint32_t(static_cast<unsigned char>(*it));
+                h *= 16777619u;
+            }
+            return h;
+        }
+
+
+        // The table itself: the chunks of entries, and an open addressing hash table that maps
+        // the URIs to their atoms (0 meaning "empty slot", since the empty URI is never hashed).
+        class Table
+        {
+        public:
+            Table()
+            : count_(0)
+            {
+                for (uint32_t i = 0; i < MAX_CHUNKS; i++)
+                    chunks_[i] = NULL;
+
+                slots_.resize(64, EMPTY_NAMESPACE_ATOM);
+
+                // atom 0 = the empty URI
+                Entry& empty = add(string(), 0);
+                empty.simplified = EMPTY_NAMESPACE_ATOM;
+            }
+
+            const Entry& entry(NamespaceAtom atom) const
+            {
+                return chunks_[atom >> CHUNK_BITS][atom & (CHUNK_SIZE - 1)];
+            }
+
+            uint32_t count() const { return count_; }
+
+            // find the atom of a URI (locked by the caller)
+            bool find(const string& uri, uint32_t hash, NamespaceAtom& atom) const
+            {
+                std::size_t mask = slots_.size() - 1;
+                std::size_t i    = hash & mask;
+                for (; slots_[i] != EMPTY_NAMESPACE_ATOM; i = (i + 1) & mask)
+                {
+                    const Entry& e = entry(slots_[i]);
+                    if (e.hash == hash && e.uri == uri)
+                    {
+                        atom = slots_[i];
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // intern a (non-empty) URI (locked by the caller), returns false if the table is full
+            bool intern(const string& uri, uint32_t hash, NamespaceAtom& atom)
+            {
+                if (find(uri, hash, atom))
+                    return true;
+
+                // the simplified URI must be interned as well, so make sure there's room for both
+                string simplifiedUri = NamespaceUris::simplify(uri);
+                uint32_t simplifiedHash = hashOf(simplifiedUri);
+                NamespaceAtom simplifiedAtom = EMPTY_NAMESPACE_ATOM;
+                bool simplifiedNeeded =    simplifiedUri != uri
+                                        && !simplifiedUri.empty()
+                                        && !find(simplifiedUri, simplifiedHash, simplifiedAtom);
+
+                if (count_ + (simplifiedNeeded ? 2 : 1) > MAX_NAMESPACE_ATOMS)
+                    return false;
+
+                atom = count_;
+                Entry& e = add(uri, hash);
+
+                // rehash if the hash table is more than half full
+                if (2 * count_ > slots_.size())
+                {
+                    vector<NamespaceAtom> slots(slots_.size() * 2, EMPTY_NAMESPACE_ATOM);
+                    slots_.swap(slots);
+                    for (NamespaceAtom a = 1; a < count_; a++)
+                        insertSlot(a);
+                }
+                else
+                {
+                    insertSlot(atom);
+                }
+
+                // the simplified URI is interned as well (its simplified version is itself)
+                if (simplifiedUri == uri)
+                    e.simplified = atom;
+                else if (simplifiedNeeded)
+                    intern(simplifiedUri, simplifiedHash, e.simplified);
+                else
+                    e.simplified = simplifiedAtom;
+
+                return true;
+            }
+
+            UaMutex mutex;
+
+        private:
+            DISALLOW_COPY_AND_ASSIGN(Table);
+
+            // add an entry (the caller made sure that the table isn't full)
+            Entry& add(const string& uri, uint32_t hash)
+            {
+                uint32_t chunk = count_ >> CHUNK_BITS;
+                if (chunks_[chunk] == NULL)
+                    chunks_[chunk] = new Entry[CHUNK_SIZE];
+
+                Entry& e = chunks_[chunk][count_ & (CHUNK_SIZE - 1)];
+                e.uri  = uri;
+                e.hash = hash;
+                e.simplified = count_;
+                count_++;
+                return e;
+            }
+
+            void insertSlot(NamespaceAtom atom)
+            {
+                std::size_t mask = slots_.size() - 1;
+                std::size_t i = entry(atom).hash & mask;
+                while (slots_[i] != EMPTY_NAMESPACE_ATOM)
+                    i = (i + 1) & mask;
+                slots_[i] = atom;
+            }
+
+            Entry*                  chunks_[MAX_CHUNKS];
+            volatile uint32_t       count_;
+            vector<NamespaceAtom>   slots_;
+        };
+
+
+        // The table is created on first use (and never destroyed, since NodeIds may be destroyed
+        // during static destruction) ...
+        Table& table()
+        {
+            static Table* theTable = new Table();
+            return *theTable;
+        }
+
+        // ... and that first use is forced during static initialization, before any threads exist.
+        Table& forceTableInitialization = table();
+
+    }
+
+
+    // Intern a namespace URI
+    // =============================================================================================
+    NamespaceAtom NamespaceUris::intern(const string& uri)
+    {
+        NamespaceAtom atom;
+        if (tryIntern(uri, atom))
+            return atom;
+        else
+            return EMPTY_NAMESPACE_ATOM;
+    }
+
+
+    // Intern a namespace URI, unless the table is full
+    // =============================================================================================
+    bool NamespaceUris::tryIntern(const string& uri, NamespaceAtom& atom)
+    {
+        if (uri.empty())
+        {
+            atom = EMPTY_NAMESPACE_ATOM;
+            return true;
+        }
+
+        uint32_t hash = hashOf(uri);
+        Table& t = table();
+        UaMutexLocker locker(&t.mutex); // unlocks when locker goes out of scope
+        return t.intern(uri, hash, atom);
+    }
+
+
+    // Find the atom of a namespace URI
+    // =============================================================================================
+    bool NamespaceUris::find(const string& uri, NamespaceAtom& atom)
+    {
+        if (uri.empty())
+        {
+            atom = EMPTY_NAMESPACE_ATOM;
+            return true;
+        }
+
+        uint32_t hash = hashOf(uri);
+        Table& t = table();
+        UaMutexLocker locker(&t.mutex); // unlocks when locker goes out of scope
+        return t.find(uri, hash, atom);
+    }
+
+
+    // Get the URI of an atom
+    // =============================================================================================
+    const string& NamespaceUris::uri(NamespaceAtom atom)
+    {
+        return table().entry(atom).uri;
+    }
+
+
+    // Get the simplified atom of an atom
+    // =============================================================================================
+    NamespaceAtom NamespaceUris::simplified(NamespaceAtom atom)
+    {
+        return table().entry(atom).simplified;
+    }
+
+
+    // Simplify a URI
+    // =============================================================================================
+    string NamespaceUris::simplify(const string& uri)
+    {
+        string ret(uri);
+
+        // transform to lower case
+        for (string::iterator it = ret.begin(); it != ret.end(); ++it)
+            *it = char(tolower(static_cast<unsigned char>(*it)));
+
+        // remove a trailing '/' character
+        if (!ret.empty() && ret[ret.size() - 1] == '/')
+            ret.erase(ret.size() - 1);
+
+        return ret;
+    }
+
+
+    // Get the number of interned URIs
+    // =============================================================================================
+    uint32_t NamespaceUris::count()
+    {
+        return table().count();
+    }
+
+}
@@ -0,0 +1,159 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_NAMESPACEURIS_H_
+#define UAF_NAMESPACEURIS_H_
+
+
+// STD
+#include <string>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+
+
+
+namespace uaf
+{
+
+    /**
+     * A NamespaceAtom is a small integer that represents an interned namespace URI.
+     *
+     * Two namespace URIs have the same atom if and only if they are exactly the same string.
+     * The atom 0 represents the empty string.
+     *
+     * @ingroup Util
+     */
+    typedef uint32_t NamespaceAtom;
+
+
+    /**
+     * The atom of the empty namespace URI.
+     *
+     * @ingroup Util
+     */
+    const NamespaceAtom EMPTY_NAMESPACE_ATOM = 0;
+
+
+    /**
+     * The maximum number of namespace URIs that can be interned (including the empty one).
+     *
+     * @ingroup Util
+     */
+    const uint32_t MAX_NAMESPACE_ATOMS = 1024 * 1024;
+
+
+    /*******************************************************************************************//**
+    * The process-wide table of interned namespace URIs.
+    *
+    * Each distinct namespace URI is stored only once, and is represented by a NamespaceAtom.
+    * NodeIds and QualifiedNames store these atoms instead of the URIs themselves, so copying them
+    * doesn't copy any strings, and the sessions can translate a namespace URI into a namespace
+    * index by a simple array lookup (see NamespaceArray).
+    *
+    * Next to the URI itself, the table also stores the atom of the "simplified" URI (i.e. the
+    * URI in lower case and without trailing slash), since two URIs that only differ in case or
+    * in a trailing slash are considered to be the same namespace.
+    *
+    * The table only grows: URIs are never removed from it, since any NodeId or QualifiedName
+    * may still refer to them. The number of interned URIs is therefore limited to
+    * MAX_NAMESPACE_ATOMS (which is far more than the namespaces of any realistic set of servers,
+    * but may be reached if URIs are generated on the fly). Once the table is full, new URIs can't
+    * be interned anymore: tryIntern() returns false, and intern() falls back to the atom of the
+    * empty URI (so the namespace of such a NodeId can't be resolved).
+    *
+    * Interning a URI requires a lock, but getting the URI or the simplified atom of an atom
+    * doesn't.
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    class UAF_EXPORT NamespaceUris
+    {
+    public:
+
+        /**
+         * Get the atom of a namespace URI, and add the URI to the table if needed.
+         *
+         * @param uri   The namespace URI.
+         * @return      The atom that represents this URI, or EMPTY_NAMESPACE_ATOM if the URI
+         *              is new and the table is full.
+         */
+        static NamespaceAtom intern(const std::string& uri);
+
+
+        /**
+         * Get the atom of a namespace URI, and add the URI to the table if needed and possible.
+         *
+         * @param uri   The namespace URI.
+         * @param atom  The atom that represents this URI, if the result is true.
+         * @return      False if the URI is new and the table is full.
+         */
+        static bool tryIntern(const std::string& uri, NamespaceAtom& atom);
+
+
+        /**
+         * Get the atom of a namespace URI, without adding the URI to the table.
+         *
+         * @param uri   The namespace URI.
+         * @param atom  The atom of the URI, if found.
+         * @return      True if the URI was found in the table.
+         */
+        static bool find(const std::string& uri, NamespaceAtom& atom);
+
+
+        /**
+         * Get the namespace URI that is represented by an atom.
+         *
+         * @param atom  An atom returned by intern() or find().
+         * @return      The URI (which remains valid for the lifetime of the process).
+         */
+        static const std::string& uri(NamespaceAtom atom);
+
+
+        /**
+         * Get the atom of the simplified version of a namespace URI (lower case, without
+         * trailing slash).
+         *
+         * @param atom  An atom returned by intern() or find().
+         * @return      The atom of the simplified URI (which may be the same atom).
+         */
+        static NamespaceAtom simplified(NamespaceAtom atom);
+
+
+        /**
+         * Get the simplified version of a namespace URI (lower case, without trailing slash).
+         *
+         * @param uri   The namespace URI.
+         * @return      The simplified URI.
+         */
+        static std::string simplify(const std::string& uri);
+
+
+        /**
+         * Get the number of interned namespace URIs (including the empty one).
+         */
+        static uint32_t count();
+    };
+
+}
+
+
+#endif /* UAF_NAMESPACEURIS_H_ */
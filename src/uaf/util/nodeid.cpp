@@ -32,6 +32,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId()
     : nameSpaceIndex_(0),
+      nameSpaceUriAtom_(EMPTY_NAMESPACE_ATOM),
       nameSpaceIndexGiven_(false),
       nameSpaceUriGiven_(false)
     {}
@@ -41,7 +42,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(const string& idString, const string& nameSpaceUri)
     : nameSpaceIndex_(0),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       identifier_(idString),
       nameSpaceIndexGiven_(false),
       nameSpaceUriGiven_(true)
@@ -55,7 +56,7 @@ namespace uaf
             const string& nameSpaceUri,
             NameSpaceIndex nameSpaceIndex)
     : nameSpaceIndex_(nameSpaceIndex),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       identifier_(idString),
       nameSpaceIndexGiven_(true),
       nameSpaceUriGiven_(true)
@@ -66,6 +67,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(const string& idString, NameSpaceIndex nameSpaceIndex)
     : nameSpaceIndex_(nameSpaceIndex),
+      nameSpaceUriAtom_(EMPTY_NAMESPACE_ATOM),
       identifier_(idString),
       nameSpaceIndexGiven_(true),
       nameSpaceUriGiven_(false)
@@ -76,7 +78,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(uint32_t idNumeric, const string& nameSpaceUri)
     : nameSpaceIndex_(0),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       identifier_(idNumeric),
       nameSpaceIndexGiven_(false),
       nameSpaceUriGiven_(true)
@@ -87,7 +89,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(uint32_t idNumeric, const string& nameSpaceUri, NameSpaceIndex nameSpaceIndex)
     : nameSpaceIndex_(nameSpaceIndex),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       identifier_(idNumeric),
       nameSpaceIndexGiven_(true),
       nameSpaceUriGiven_(true)
@@ -98,6 +100,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(uint32_t idNumeric, NameSpaceIndex nameSpaceIndex)
     : nameSpaceIndex_(nameSpaceIndex),
+      nameSpaceUriAtom_(EMPTY_NAMESPACE_ATOM),
       identifier_(idNumeric),
       nameSpaceIndexGiven_(true),
       nameSpaceUriGiven_(false)
@@ -108,7 +111,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(const Guid& idGuid, const string& nameSpaceUri)
     : nameSpaceIndex_(0),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       identifier_(idGuid),
       nameSpaceIndexGiven_(false),
       nameSpaceUriGiven_(true)
@@ -119,7 +122,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(const Guid& idGuid, const string& nameSpaceUri, NameSpaceIndex nameSpaceIndex)
     : nameSpaceIndex_(nameSpaceIndex),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       identifier_(idGuid),
       nameSpaceIndexGiven_(true),
       nameSpaceUriGiven_(true)
@@ -130,6 +133,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(const Guid& idGuid, NameSpaceIndex nameSpaceIndex)
     : nameSpaceIndex_(nameSpaceIndex),
+      nameSpaceUriAtom_(EMPTY_NAMESPACE_ATOM),
       identifier_(idGuid),
       nameSpaceIndexGiven_(true),
       nameSpaceUriGiven_(false)
@@ -140,7 +144,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(const NodeIdIdentifier& identifier, const string& nameSpaceUri)
     : nameSpaceIndex_(0),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       identifier_(identifier),
       nameSpaceIndexGiven_(false),
       nameSpaceUriGiven_(true)
@@ -151,7 +155,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(const NodeIdIdentifier& identifier, const string& nameSpaceUri, NameSpaceIndex nameSpaceIndex)
     : nameSpaceIndex_(nameSpaceIndex),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       identifier_(identifier),
       nameSpaceIndexGiven_(true),
       nameSpaceUriGiven_(true)
@@ -162,6 +166,7 @@ namespace uaf
     // =============================================================================================
     NodeId::NodeId(const NodeIdIdentifier& identifier, NameSpaceIndex nameSpaceIndex)
     : nameSpaceIndex_(nameSpaceIndex),
+      nameSpaceUriAtom_(EMPTY_NAMESPACE_ATOM),
       identifier_(identifier),
       nameSpaceIndexGiven_(true),
       nameSpaceUriGiven_(false)
@@ -191,7 +196,7 @@ namespace uaf
             ss << "=" << nameSpaceIndex_;
 
         if (nameSpaceUriGiven_)
-            ss << "='" << nameSpaceUri_ << "'";
+            ss << "='" << NamespaceUris::uri(nameSpaceUriAtom_) << "'";
 
         if ( (!nameSpaceIndexGiven_) && (!nameSpaceUriGiven_) )
             ss << "=???";
@@ -208,7 +213,8 @@ namespace uaf
     {
         Status ret;
 
-        if (hasNameSpaceIndex() || nameSpaceUri() == uaf::constants::OPCUA_NAMESPACE_URI)
+        if (hasNameSpaceIndex()
+                || NamespaceUris::uri(nameSpaceUriAtom_) == uaf::constants::OPCUA_NAMESPACE_URI)
         {
             // fill the just created UaNodeId
             if (identifier_.type == nodeididentifiertypes::Identifier_String)
@@ -268,11 +274,24 @@ namespace uaf
     // Fill out the NodeId with information from an OpcUa_NodeId instance
     // =============================================================================================
     Status NodeId::fromSdk(const OpcUa_NodeId& opcUaNodeId, const string& nameSpaceUri)
+    {
+        NamespaceAtom nameSpaceUriAtom;
+        if (!NamespaceUris::tryIntern(nameSpaceUri, nameSpaceUriAtom))
+            return UnexpectedError("The table of namespace URIs is full, could not add "
+                                   + nameSpaceUri);
+
+        return fromSdk(opcUaNodeId, nameSpaceUriAtom);
+    }
+
+
+    // Fill out the NodeId with information from an OpcUa_NodeId instance
+    // =============================================================================================
+    Status NodeId::fromSdk(const OpcUa_NodeId& opcUaNodeId, NamespaceAtom nameSpaceUriAtom)
     {
         nameSpaceIndexGiven_ = true;
         nameSpaceUriGiven_ = true;
         nameSpaceIndex_ = opcUaNodeId.NamespaceIndex;
-        nameSpaceUri_ = nameSpaceUri;
+        nameSpaceUriAtom_ = nameSpaceUriAtom;
         return identifier_.fromSdk(opcUaNodeId);
     }
 
@@ -314,7 +333,7 @@ namespace uaf
     {
         return    object1.identifier_ == object2.identifier_
                && object1.nameSpaceIndex_ == object2.nameSpaceIndex_
-               && object1.nameSpaceUri_ == object2.nameSpaceUri_;
+               && object1.nameSpaceUriAtom_ == object2.nameSpaceUriAtom_;
     }
 
 
@@ -340,7 +359,10 @@ namespace uaf
         }
         else
         {
-            return object1.nameSpaceUri_ < object2.nameSpaceUri_;
+            // (compare the URIs themselves, so that the order doesn't depend on the interning)
+            return    object1.nameSpaceUriAtom_ != object2.nameSpaceUriAtom_
+                   && NamespaceUris::uri(object1.nameSpaceUriAtom_)
+                          < NamespaceUris::uri(object2.nameSpaceUriAtom_);
         }
     }
 
@@ -27,6 +27,7 @@
 // UAF
 #include "uaf/util/util.h"
 #include "uaf/util/constants.h"
+#include "uaf/util/namespaceuris.h"
 #include "uaf/util/nodeididentifier.h"
 #include "uaf/util/status.h"
 // SDK
@@ -197,7 +198,8 @@ namespace uaf
          *
          * @return  True if the NodeId has a namespace URI.
          */
-        bool hasNameSpaceUri() const { return nameSpaceUriGiven_ && (!nameSpaceUri_.empty()); }
+        bool hasNameSpaceUri() const
+        { return nameSpaceUriGiven_ && (nameSpaceUriAtom_ != uaf::EMPTY_NAMESPACE_ATOM); }
 
 
         /**
@@ -213,7 +215,17 @@ namespace uaf
          *
          * @return  The namespace URI of the NodeId.
          */
-        std::string nameSpaceUri()   const { return nameSpaceUri_; }
+        std::string nameSpaceUri()   const { return uaf::NamespaceUris::uri(nameSpaceUriAtom_); }
+
+
+#ifndef SWIG
+        /**
+         * Get the interned namespace URI (in case hasNameSpaceUri is True).
+         *
+         * @return  The atom of the namespace URI of the NodeId.
+         */
+        uaf::NamespaceAtom nameSpaceUriAtom() const { return nameSpaceUriAtom_; }
+#endif
 
 
         /**
@@ -231,7 +243,7 @@ namespace uaf
          * @param uri   The namespace URI of the NodeId.
          */
         void setNameSpaceUri(const std::string& uri)
-        { nameSpaceUri_ = uri; nameSpaceUriGiven_ = true; }
+        { nameSpaceUriAtom_ = uaf::NamespaceUris::intern(uri); nameSpaceUriGiven_ = true; }
 
 
         /**
@@ -284,6 +296,18 @@ namespace uaf
         uaf::Status fromSdk(const OpcUa_NodeId& opcUaNodeId,const std::string& nameSpaceUri);
 
 
+#ifndef SWIG
+        /**
+         * Construct a NodeId based on a stack OpcUa_NodeId instance and an interned namespace URI.
+         *
+         * @param opcUaNodeId       OPC UA stack OpcUa_NodeId instance.
+         * @param nameSpaceUriAtom  Atom of the namespace URI of the NodeId.
+         * @return                  Good in case the NodeId was successfully updated.
+         */
+        uaf::Status fromSdk(const OpcUa_NodeId& opcUaNodeId, uaf::NamespaceAtom nameSpaceUriAtom);
+#endif
+
+
         /**
          * Construct a NodeId based on a stack OpcUa_NodeId instance.
          *
@@ -321,8 +345,8 @@ namespace uaf
     private:
         // namespace index
         uaf::NameSpaceIndex     nameSpaceIndex_;
-        // namespace URI
-        std::string             nameSpaceUri_;
+        // namespace URI (interned)
+        uaf::NamespaceAtom      nameSpaceUriAtom_;
         // identifier part of the NodeId
         uaf::NodeIdIdentifier   identifier_;
         // true if a namespace index was provided
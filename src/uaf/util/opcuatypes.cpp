@@ -138,5 +138,23 @@ namespace uaf
         }
 
 
+
+
+        // Does a value of the given type need namespace resolution?
+        // =========================================================================================
+        bool needsNamespaceResolution(OpcUaType type)
+        {
+            switch (type)
+            {
+                case NodeId:
+                case ExpandedNodeId:
+                case QualifiedName:
+                case ExtensionObject:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
     }
 }
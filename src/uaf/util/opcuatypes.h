@@ -100,6 +100,22 @@ namespace uaf
          */
         OpcUa_BuiltInType UAF_EXPORT fromUafToSdk(OpcUaType type);
 
+
+        /**
+         * Does a value of the given type carry namespace (or server) indexes that must be
+         * resolved into namespace (or server) URIs when it's received from a server?
+         *
+         * This is only the case for NodeIds, ExpandedNodeIds, QualifiedNames and
+         * ExtensionObjects (because of their datatype id), so all other values (numbers, strings,
+         * ...) can skip the resolution altogether.
+         *
+         * @param type  The OPC UA type.
+         * @return      True if the type needs namespace resolution.
+         *
+         * @ingroup Util
+         */
+        bool UAF_EXPORT needsNamespaceResolution(OpcUaType type);
+
     }
 
 
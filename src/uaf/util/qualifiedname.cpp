@@ -30,7 +30,8 @@ namespace uaf
     // Constructor
     // =============================================================================================
     QualifiedName::QualifiedName()
-    : nameSpaceIndex_(0),
+    : nameSpaceUriAtom_(EMPTY_NAMESPACE_ATOM),
+      nameSpaceIndex_(0),
       nameSpaceUriGiven_(false),
       nameSpaceIndexGiven_(false)
     {}
@@ -40,6 +41,7 @@ namespace uaf
     // =============================================================================================
     QualifiedName::QualifiedName(const string& name)
     : name_(name),
+      nameSpaceUriAtom_(EMPTY_NAMESPACE_ATOM),
       nameSpaceIndex_(0),
       nameSpaceUriGiven_(false),
       nameSpaceIndexGiven_(false)
@@ -50,6 +52,7 @@ namespace uaf
     // =============================================================================================
     QualifiedName::QualifiedName(const string& name, uint16_t nameSpaceIndex)
     : name_(name),
+      nameSpaceUriAtom_(EMPTY_NAMESPACE_ATOM),
       nameSpaceIndex_(nameSpaceIndex),
       nameSpaceUriGiven_(false),
       nameSpaceIndexGiven_(true)
@@ -60,7 +63,7 @@ namespace uaf
     // =============================================================================================
     QualifiedName::QualifiedName(const string& name, const string& nameSpaceUri)
     : name_(name),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       nameSpaceIndex_(0),
       nameSpaceUriGiven_(true),
       nameSpaceIndexGiven_(false)
@@ -74,7 +77,7 @@ namespace uaf
             const string&   nameSpaceUri,
             uint16_t        nameSpaceIndex)
     : name_(name),
-      nameSpaceUri_(nameSpaceUri),
+      nameSpaceUriAtom_(NamespaceUris::intern(nameSpaceUri)),
       nameSpaceIndex_(nameSpaceIndex),
       nameSpaceUriGiven_(true),
       nameSpaceIndexGiven_(true)
@@ -85,7 +88,9 @@ namespace uaf
     // =============================================================================================
     bool QualifiedName::isNull() const
     {
-        return (!nameSpaceIndexGiven_) && (!nameSpaceUriGiven_) && nameSpaceUri_.empty();
+        return    (!nameSpaceIndexGiven_)
+               && (!nameSpaceUriGiven_)
+               && (nameSpaceUriAtom_ == EMPTY_NAMESPACE_ATOM);
     }
 
 
@@ -137,6 +142,14 @@ namespace uaf
     // Fill the qualified name
     // =============================================================================================
     void QualifiedName::fromSdk(const UaQualifiedName& destination, const string& nameSpaceUri)
+    {
+        fromSdk(destination, NamespaceUris::intern(nameSpaceUri));
+    }
+
+
+    // Fill the qualified name
+    // =============================================================================================
+    void QualifiedName::fromSdk(const UaQualifiedName& destination, NamespaceAtom nameSpaceUriAtom)
     {
 
         if (destination.isNull())
@@ -156,7 +169,7 @@ namespace uaf
 
             nameSpaceIndex_ = destination.namespaceIndex();
             nameSpaceIndexGiven_ = true;
-            nameSpaceUri_ = nameSpaceUri;
+            nameSpaceUriAtom_ = nameSpaceUriAtom;
             nameSpaceUriGiven_ = true;
         }
     }
@@ -175,7 +188,7 @@ namespace uaf
     // =============================================================================================
     void QualifiedName::setNameSpaceUri(const std::string& nameSpaceUri)
     {
-        nameSpaceUri_      = nameSpaceUri;
+        nameSpaceUriAtom_  = NamespaceUris::intern(nameSpaceUri);
         nameSpaceUriGiven_ = true;
     }
 
@@ -198,7 +211,7 @@ namespace uaf
                 ss << "=" << nameSpaceIndex_;
 
             if (nameSpaceUriGiven_)
-                ss << "='" << nameSpaceUri_ << "'";
+                ss << "='" << NamespaceUris::uri(nameSpaceUriAtom_) << "'";
 
             if ( (!nameSpaceIndexGiven_) && (!nameSpaceUriGiven_) )
                 ss << "=???";
@@ -216,7 +229,7 @@ namespace uaf
     {
         return    object1.name_ == object2.name_
                && object1.nameSpaceIndex_ == object2.nameSpaceIndex_
-               && object1.nameSpaceUri_ == object2.nameSpaceUri_;
+               && object1.nameSpaceUriAtom_ == object2.nameSpaceUriAtom_;
     }
 
 
@@ -237,7 +250,9 @@ namespace uaf
         else if (object1.nameSpaceIndex_ != object2.nameSpaceIndex_)
             return object1.nameSpaceIndex_ < object2.nameSpaceIndex_;
         else
-            return object1.nameSpaceUri_ < object2.nameSpaceUri_;
+            return    object1.nameSpaceUriAtom_ != object2.nameSpaceUriAtom_
+                   && NamespaceUris::uri(object1.nameSpaceUriAtom_)
+                          < NamespaceUris::uri(object2.nameSpaceUriAtom_);
     }
 
 }
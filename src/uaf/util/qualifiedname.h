@@ -30,6 +30,7 @@
 #include "uabase/uaqualifiedname.h"
 // UAF
 #include "uaf/util/util.h"
+#include "uaf/util/namespaceuris.h"
 
 
 namespace uaf
@@ -138,7 +139,8 @@ namespace uaf
          *
          * @return True if a non-empty namespace URI has been provided.
          */
-        bool hasNameSpaceUri()   const { return nameSpaceUriGiven_ && (!nameSpaceUri_.empty()); }
+        bool hasNameSpaceUri()   const
+        { return nameSpaceUriGiven_ && (nameSpaceUriAtom_ != uaf::EMPTY_NAMESPACE_ATOM); }
 
 
         /**
@@ -162,7 +164,18 @@ namespace uaf
          *
          * @return  the namespace URI.
          */
-        const std::string& nameSpaceUri() const { return nameSpaceUri_; };
+        const std::string& nameSpaceUri() const
+        { return uaf::NamespaceUris::uri(nameSpaceUriAtom_); };
+
+
+#ifndef SWIG
+        /**
+         * Get the interned namespace URI (only do this in case hasNameSpaceUri equals True).
+         *
+         * @return  the atom of the namespace URI.
+         */
+        uaf::NamespaceAtom nameSpaceUriAtom() const { return nameSpaceUriAtom_; };
+#endif
 
 
         /**
@@ -210,6 +223,20 @@ namespace uaf
         void fromSdk(const UaQualifiedName& source, const std::string& nameSpaceUri);
 
 
+#ifndef SWIG
+        /**
+         * Update the qualified name with the contents of an SDK UaQualifiedName instance and
+         * a corresponding interned namespace URI.
+         *
+         * @param source            UaQualifiedName instance (as defined by the SDK) to fetch the
+         *                          contents.
+         * @param nameSpaceUriAtom  The atom of the namespace URI that corresponds to the namespace
+         *                          index from the source argument.
+         */
+        void fromSdk(const UaQualifiedName& source, uaf::NamespaceAtom nameSpaceUriAtom);
+#endif
+
+
         // comparison operators
         friend UAF_EXPORT bool operator==(const QualifiedName& object1, const QualifiedName& object2);
         friend UAF_EXPORT bool operator!=(const QualifiedName& object1, const QualifiedName& object2);
@@ -218,8 +245,8 @@ namespace uaf
     private:
         // name part of the qualified name
         std::string  name_;
-        // namespace URI
-        std::string  nameSpaceUri_;
+        // namespace URI (interned)
+        uaf::NamespaceAtom nameSpaceUriAtom_;
         // namespace index
         uint16_t     nameSpaceIndex_;
         // true if a namespace URI is given
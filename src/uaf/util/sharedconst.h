@@ -0,0 +1,174 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SHAREDCONST_H_
+#define UAF_SHAREDCONST_H_
+
+
+// STD
+#include <cstddef>
+// SDK
+// UAF
+#include "uaf/util/atomics.h"
+
+
+
+namespace uaf
+{
+
+    /*******************************************************************************************//**
+    * A SharedConst holds a reference-counted pointer to an immutable object.
+    *
+    * Copying a SharedConst only increments the (atomic) reference count, so the same object can
+    * be shared safely by different threads, as long as nobody modifies it. The object is deleted
+    * when the last SharedConst that refers to it is destructed.
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    template<typename T>
+    class SharedConst
+    {
+    public:
+
+
+        /**
+         * Construct a null SharedConst.
+         */
+        SharedConst()
+        : shared_(NULL)
+        {}
+
+
+        /**
+         * Construct a SharedConst that takes ownership of the given object.
+         *
+         * The object must have been allocated with new, and must not be modified anymore
+         * afterwards.
+         *
+         * @param object    The object to share (may be NULL).
+         */
+        explicit SharedConst(T* object)
+        : shared_(object == NULL ? NULL : new Shared(object))
+        {}
+
+
+        /**
+         * Copy constructor: share the object of the other SharedConst.
+         */
+        SharedConst(const SharedConst<T>& other)
+        : shared_(other.shared_)
+        {
+            if (shared_ != NULL)
+                atomicIncrement(&shared_->refCount);
+        }
+
+
+        /**
+         * Copy assignment: share the object of the other SharedConst.
+         */
+        SharedConst<T>& operator=(const SharedConst<T>& other)
+        {
+            if (other.shared_ != NULL)
+                atomicIncrement(&other.shared_->refCount);
+            release();
+            shared_ = other.shared_;
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+
+        /**
+         * Move constructor: take over the reference of the other SharedConst.
+         */
+        SharedConst(SharedConst<T>&& other)
+        : shared_(other.shared_)
+        {
+            other.shared_ = NULL;
+        }
+
+
+        /**
+         * Move assignment: take over the reference of the other SharedConst.
+         */
+        SharedConst<T>& operator=(SharedConst<T>&& other)
+        {
+            if (this != &other)
+            {
+                release();
+                shared_ = other.shared_;
+                other.shared_ = NULL;
+            }
+            return *this;
+        }
+
+#endif
+
+        /**
+         * Destruct the SharedConst (and the object, if this was the last reference to it).
+         */
+        ~SharedConst()
+        {
+            release();
+        }
+
+
+        /** Is the SharedConst null? */
+        bool isNull() const { return shared_ == NULL; }
+
+        /** Get a pointer to the shared object (or NULL). */
+        const T* get() const { return shared_ == NULL ? NULL : shared_->object; }
+
+        /** Access the shared object. */
+        const T& operator*() const { return *shared_->object; }
+
+        /** Access the shared object. */
+        const T* operator->() const { return shared_->object; }
+
+
+    private:
+
+        // the shared object, together with its reference count
+        struct Shared
+        {
+            explicit Shared(T* object) : object(object), refCount(1) {}
+            ~Shared() { delete object; }
+
+            T*                  object;
+            AtomicCount         refCount;
+        };
+
+
+        // drop the reference to the shared object
+        void release()
+        {
+            if (shared_ != NULL && atomicDecrement(&shared_->refCount) == 0)
+                delete shared_;
+            shared_ = NULL;
+        }
+
+
+        // the shared object (NULL if the SharedConst is null)
+        Shared* shared_;
+    };
+
+}
+
+
+#endif /* UAF_SHAREDCONST_H_ */
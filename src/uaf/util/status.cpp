@@ -31,18 +31,14 @@ namespace uaf
     // Constructor
     // =============================================================================================
     Status::Status(const Status& other)
+    : statusCode(other.statusCode),
+      raisedBy_(NULL),
+      error_(NULL)
     {
-        copyErrors(other);
-        statusCode = other.statusCode;
+        setError(other.error_);
 
         if (other.isRaisedBy())
-        {
             raisedBy_ = new Status(*other.raisedBy_);
-        }
-        else
-        {
-            raisedBy_ = NULL;
-        }
     }
 
 
@@ -54,16 +50,10 @@ namespace uaf
         if (&other != this)
         {
             clearRaisedBy();
-            copyErrors(other);
+            setError(other.error_);
             statusCode = other.statusCode;
             if (other.isRaisedBy())
-            {
                 raisedBy_ = new Status(*other.raisedBy_);
-            }
-            else
-            {
-                raisedBy_ = NULL;
-            }
         }
         return *this;
     }
@@ -74,6 +64,24 @@ namespace uaf
     Status::~Status()
     {
         clearRaisedBy();
+        setError(NULL);
+    }
+
+
+    // Replace the error
+    // =============================================================================================
+    void Status::setError(const StatusErrorBase* error)
+    {
+        if (error == error_)
+            return;
+
+        if (error != NULL)
+            atomicIncrement(&error->refCount);
+
+        if (error_ != NULL && atomicDecrement(&error_->refCount) == 0)
+            delete error_;
+
+        error_ = error;
     }
 
 
@@ -105,16 +113,24 @@ namespace uaf
         if (statuses.size() == 0)
         {
             statusCode = uaf::statuscodes::NoStatusesGivenError;
-            raisedBy_NoStatusesGivenError = NoStatusesGivenError();
+            setError(new StatusError<NoStatusesGivenError>(statusCode, NoStatusesGivenError()));
         }
         else if (noOfGood == statuses.size())
+        {
             statusCode = uaf::statuscodes::Good;
+            setError(NULL);
+        }
         else if (noOfUncertain > 0 && noOfBad == 0)
+        {
             statusCode = uaf::statuscodes::Uncertain;
+            setError(NULL);
+        }
         else
         {
             statusCode = uaf::statuscodes::BadStatusesPresentError;
-            raisedBy_BadStatusesPresentError = BadStatusesPresentError(noOfGood, noOfUncertain, noOfBad);
+            setError(new StatusError<BadStatusesPresentError>(
+                    statusCode,
+                    BadStatusesPresentError(noOfGood, noOfUncertain, noOfBad)));
         }
     }
 
@@ -124,6 +140,7 @@ namespace uaf
     void Status::setGood()
     {
         clearRaisedBy();
+        setError(NULL);
         statusCode = uaf::statuscodes::Good;
     }
 
@@ -132,6 +149,7 @@ namespace uaf
     void Status::setUncertain()
     {
         clearRaisedBy();
+        setError(NULL);
         statusCode = uaf::statuscodes::Uncertain;
     }
 
@@ -169,125 +187,8 @@ namespace uaf
 
 
 
-#define UAF_STATUS_COPY_ERROR(ERROR)       \
-        raisedBy_##ERROR = from.raisedBy_##ERROR;
-
-    void Status::copyErrors(const Status& from)
-    {
-        UAF_STATUS_COPY_ERROR(FindServersError)
-        UAF_STATUS_COPY_ERROR(UnknownServerError)
-        UAF_STATUS_COPY_ERROR(EmptyUrlError)
-        UAF_STATUS_COPY_ERROR(NoParallelFindServersAllowedError)
-        UAF_STATUS_COPY_ERROR(NoDiscoveryUrlsFoundError)
-        UAF_STATUS_COPY_ERROR(ServerCertificateRejectedByUserError)
-        UAF_STATUS_COPY_ERROR(ServerCertificateSavingError)
-        UAF_STATUS_COPY_ERROR(OpenSSLStoreInitializationError)
-        UAF_STATUS_COPY_ERROR(ClientCertificateLoadingError)
-        UAF_STATUS_COPY_ERROR(ServerDidNotProvideCertificateError)
-        UAF_STATUS_COPY_ERROR(PathNotExistsError)
-        UAF_STATUS_COPY_ERROR(NoSecuritySettingsGivenError)
-        UAF_STATUS_COPY_ERROR(PathCreationError)
-        UAF_STATUS_COPY_ERROR(SecuritySettingsMatchError)
-        UAF_STATUS_COPY_ERROR(WrongTypeError)
-        UAF_STATUS_COPY_ERROR(UnexpectedError)
-        UAF_STATUS_COPY_ERROR(ServerArrayConversionError)
-        UAF_STATUS_COPY_ERROR(NamespaceArrayConversionError)
-        UAF_STATUS_COPY_ERROR(BadNamespaceArrayError)
-        UAF_STATUS_COPY_ERROR(BadServerArrayError)
-        UAF_STATUS_COPY_ERROR(UnknownServerIndexError)
-        UAF_STATUS_COPY_ERROR(InvalidAddressError)
-        UAF_STATUS_COPY_ERROR(UnknownNamespaceUriError)
-        UAF_STATUS_COPY_ERROR(NoNamespaceIndexOrUriGivenError)
-        UAF_STATUS_COPY_ERROR(UnknownNamespaceIndexError)
-        UAF_STATUS_COPY_ERROR(EmptyServerUriAndUnknownNamespaceIndexError)
-        UAF_STATUS_COPY_ERROR(ExpandedNodeIdAddressExpectedError)
-        UAF_STATUS_COPY_ERROR(EmptyServerUriError)
-        UAF_STATUS_COPY_ERROR(UnsupportedError)
-        UAF_STATUS_COPY_ERROR(UnsupportedNodeIdIdentifierTypeError)
-        UAF_STATUS_COPY_ERROR(SyncInvocationNotSupportedError)
-        UAF_STATUS_COPY_ERROR(AsyncInvocationNotSupportedError)
-        UAF_STATUS_COPY_ERROR(NoStatusesGivenError)
-        UAF_STATUS_COPY_ERROR(BadStatusesPresentError)
-        UAF_STATUS_COPY_ERROR(NotAllTargetsCouldBeResolvedError)
-        UAF_STATUS_COPY_ERROR(InvalidServerUriError)
-        UAF_STATUS_COPY_ERROR(SubscriptionNotCreatedError)
-        UAF_STATUS_COPY_ERROR(NoTargetsGivenError)
-        UAF_STATUS_COPY_ERROR(DataDontMatchAddressesError)
-        UAF_STATUS_COPY_ERROR(ItemNotFoundForTheGivenHandleError)
-        UAF_STATUS_COPY_ERROR(TargetRankOutOfBoundsError)
-        UAF_STATUS_COPY_ERROR(NoItemFoundForTheGivenRequestHandleError)
-        UAF_STATUS_COPY_ERROR(ContinuationPointsDontMatchAddressesError)
-        UAF_STATUS_COPY_ERROR(UnknownNamespaceIndexAndServerIndexError)
-        UAF_STATUS_COPY_ERROR(AsyncMultiMethodCallNotSupportedError)
-        UAF_STATUS_COPY_ERROR(EmptyAddressError)
-        UAF_STATUS_COPY_ERROR(MultipleTranslationResultsError)
-        UAF_STATUS_COPY_ERROR(UnknownClientSubscriptionHandleError)
-        UAF_STATUS_COPY_ERROR(UnknownClientHandleError)
-        UAF_STATUS_COPY_ERROR(UnknownClientConnectionIdError)
-        UAF_STATUS_COPY_ERROR(AsyncConnectionFailedError)
-        UAF_STATUS_COPY_ERROR(ConnectionFailedError)
-        UAF_STATUS_COPY_ERROR(SessionSecuritySettingsDontMatchEndpointError)
-        UAF_STATUS_COPY_ERROR(CouldNotManuallyUnsubscribeError)
-        UAF_STATUS_COPY_ERROR(CouldNotManuallySubscribeError)
-        UAF_STATUS_COPY_ERROR(SessionNotConnectedError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotSetMonitoringModeError)
-        UAF_STATUS_COPY_ERROR(CreateSubscriptionError)
-        UAF_STATUS_COPY_ERROR(DeleteSubscriptionError)
-        UAF_STATUS_COPY_ERROR(SubscriptionHasBeenDeletedError)
-        UAF_STATUS_COPY_ERROR(SetMonitoringModeInvocationError)
-        UAF_STATUS_COPY_ERROR(NoDiscoveryUrlsExposedByServerError)
-        UAF_STATUS_COPY_ERROR(GetEndpointsError)
-        UAF_STATUS_COPY_ERROR(NoEndpointsProvidedByServerError)
-        UAF_STATUS_COPY_ERROR(DisconnectionFailedError)
-        UAF_STATUS_COPY_ERROR(NoConnectedSessionToUpdateArraysError)
-        UAF_STATUS_COPY_ERROR(BadDataReceivedError)
-
-
-        // service errors
-        UAF_STATUS_COPY_ERROR(CouldNotReadArraysError)
-        UAF_STATUS_COPY_ERROR(CreateMonitoredItemsError)
-        UAF_STATUS_COPY_ERROR(CreateMonitoredItemsInvocationError)
-        UAF_STATUS_COPY_ERROR(BeginCreateMonitoredItemsInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotCreateMonitoredItemsError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotBrowseNextError)
-        UAF_STATUS_COPY_ERROR(BrowseNextInvocationError)
-        UAF_STATUS_COPY_ERROR(ReadInvocationError)
-        UAF_STATUS_COPY_ERROR(BeginReadInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotReadError)
-        UAF_STATUS_COPY_ERROR(TranslateBrowsePathsToNodeIdsInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
-        UAF_STATUS_COPY_ERROR(HistoryReadInvocationError)
-        UAF_STATUS_COPY_ERROR(HistoryReadRawModifiedInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotHistoryReadError)
-        UAF_STATUS_COPY_ERROR(MethodCallInvocationError)
-        UAF_STATUS_COPY_ERROR(AsyncMethodCallInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotCallMethodError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotBrowseError)
-        UAF_STATUS_COPY_ERROR(BrowseInvocationError)
-        UAF_STATUS_COPY_ERROR(WriteInvocationError)
-        UAF_STATUS_COPY_ERROR(AsyncWriteInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotWriteError)
-        UAF_STATUS_COPY_ERROR(CallCompleteError)
-        UAF_STATUS_COPY_ERROR(InputArgumentError)
-        UAF_STATUS_COPY_ERROR(ReadCompleteError)
-        UAF_STATUS_COPY_ERROR(WriteCompleteError)
-        UAF_STATUS_COPY_ERROR(EmptyUserCertificateError)
-        UAF_STATUS_COPY_ERROR(InvalidPrivateKeyError)
-        UAF_STATUS_COPY_ERROR(SetPublishingModeInvocationError)
-        UAF_STATUS_COPY_ERROR(DefinitionNotFoundError)
-
-        // configuration errors
-        UAF_STATUS_COPY_ERROR(ConfigurationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateCertificateTrustListLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateCertificateRevocationListLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateIssuersCertificateLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateIssuersRevocationListLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateClientPrivateKeyLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateClientCertificateLocationError)
-    }
-
 #define UAF_STATUS_TOSTRING_IF(ERROR)       \
-        if (statusCode == uaf::statuscodes::ERROR) return raisedBy_##ERROR.message;
+        if (statusCode == uaf::statuscodes::ERROR) return get_raisedBy_##ERROR().message;
 #define UAF_STATUS_TOSTRING_ELSE_IF(ERROR)       \
         else UAF_STATUS_TOSTRING_IF(ERROR)
 
@@ -295,6 +196,9 @@ namespace uaf
     // =============================================================================================
     string Status::toString() const
     {
+        if (error_ != NULL && error_->statusCode == statusCode)
+            return error_->uafError().message;
+
         UAF_STATUS_TOSTRING_IF(FindServersError)
         UAF_STATUS_TOSTRING_ELSE_IF(UnknownServerError)
         UAF_STATUS_TOSTRING_ELSE_IF(EmptyUrlError)
@@ -397,6 +301,14 @@ namespace uaf
         UAF_STATUS_TOSTRING_ELSE_IF(InvalidPrivateKeyError)
         UAF_STATUS_TOSTRING_ELSE_IF(SetPublishingModeInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(DefinitionNotFoundError)
+        UAF_STATUS_TOSTRING_ELSE_IF(DeleteMonitoredItemsInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(ServerCouldNotDeleteMonitoredItemError)
+        UAF_STATUS_TOSTRING_ELSE_IF(ModifyMonitoredItemsInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(ServerCouldNotModifyMonitoredItemError)
+        UAF_STATUS_TOSTRING_ELSE_IF(RepublishInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(RegisterNodesInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(UnregisterNodesInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(UnknownRegisteredNodesHandleError)
 
         // configuration errors
         UAF_STATUS_TOSTRING_ELSE_IF(ConfigurationError)
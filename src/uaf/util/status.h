@@ -28,6 +28,7 @@
 // SDK
 // UAF
 #include "uaf/util/util.h"
+#include "uaf/util/atomics.h"
 #include "uaf/util/statuscodes.h"
 #include "uaf/util/errors/generalerrors.h"
 #include "uaf/util/errors/discoveryerrors.h"
@@ -42,31 +43,95 @@
 #include "uaf/util/errors/backwardscompatibilityerrors.h"
 
 
-#define UAF_STATUS_CONSTRUCTOR(ERROR)           \
-        Status(const uaf::ERROR& error)         \
-        : raisedBy_##ERROR(error),              \
-          statusCode(uaf::statuscodes::ERROR),  \
-          raisedBy_(NULL)                       \
-        {}                                      \
-                                                \
-        uaf::ERROR raisedBy_##ERROR;
+/**
+ * Declare the constructor of a Status that is raised by the given error, and the getter of this
+ * error.
+ */
+#define UAF_STATUS_CONSTRUCTOR(ERROR)                                                              \
+        Status(const uaf::ERROR& error)                                                            \
+        : statusCode(uaf::statuscodes::ERROR),                                                     \
+          raisedBy_(NULL),                                                                         \
+          error_(NULL)                                                                             \
+        { setError(new uaf::StatusError<uaf::ERROR>(uaf::statuscodes::ERROR, error)); }            \
+                                                                                                   \
+        uaf::ERROR get_raisedBy_##ERROR() const                                                    \
+        { return raisedByError<uaf::ERROR>(uaf::statuscodes::ERROR); }
 
 
 namespace uaf
 {
 
+#ifndef SWIG
+
+    /**
+     * The error that raised a Status.
+     *
+     * A Status only holds a pointer to this error (NULL for Good and Uncertain statuses), and
+     * the error is never changed after construction, so all copies of a Status simply share it.
+     *
+     * @ingroup Util
+     */
+    class UAF_EXPORT StatusErrorBase
+    {
+    public:
+        StatusErrorBase(uaf::statuscodes::StatusCode statusCode)
+        : statusCode(statusCode),
+          refCount(0)
+        {}
+
+        virtual ~StatusErrorBase() {}
+
+        /** The error, as a UafError. */
+        virtual const uaf::UafError& uafError() const = 0;
+
+        /** The status code that corresponds with the type of the error. */
+        const uaf::statuscodes::StatusCode statusCode;
+
+        /** The number of statuses that share the error. */
+        mutable uaf::AtomicCount refCount;
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(StatusErrorBase);
+    };
+
+
+    /**
+     * The error of a specific type that raised a Status.
+     *
+     * @ingroup Util
+     */
+    template <typename ErrorType>
+    class StatusError : public uaf::StatusErrorBase
+    {
+    public:
+        StatusError(uaf::statuscodes::StatusCode statusCode, const ErrorType& error)
+        : uaf::StatusErrorBase(statusCode),
+          error(error)
+        {}
+
+        const uaf::UafError& uafError() const { return error; }
+
+        /** The error. */
+        const ErrorType error;
+    };
+
+#endif
+
+
     class UAF_EXPORT Status
     {
     public:
 
         Status()
         : statusCode(uaf::statuscodes::Uncertain),
-          raisedBy_(NULL)
+          raisedBy_(NULL),
+          error_(NULL)
         {}
 
         Status(uaf::statuscodes::StatusCode statusCode)
         : statusCode(statusCode),
-          raisedBy_(NULL)
+          raisedBy_(NULL),
+          error_(NULL)
         {}
 
 
@@ -84,6 +149,36 @@ namespace uaf
          */
         Status& operator=(const Status& other);
 
+#if !defined(SWIG) && __cplusplus >= 201103L
+
+        /** Move constructor: takes over the error and raisedBy status of the other status. */
+        Status(Status&& other)
+        : statusCode(other.statusCode),
+          raisedBy_(other.raisedBy_),
+          error_(other.error_)
+        {
+            other.raisedBy_ = NULL;
+            other.error_    = NULL;
+        }
+
+        /** Move assignment operator. */
+        Status& operator=(Status&& other)
+        {
+            if (&other != this)
+            {
+                clearRaisedBy();
+                setError(NULL);
+                statusCode      = other.statusCode;
+                raisedBy_       = other.raisedBy_;
+                error_          = other.error_;
+                other.raisedBy_ = NULL;
+                other.error_    = NULL;
+            }
+            return *this;
+        }
+
+#endif
+
 
         UAF_STATUS_CONSTRUCTOR(FindServersError)
         UAF_STATUS_CONSTRUCTOR(UnknownServerError)
@@ -185,6 +280,14 @@ namespace uaf
         UAF_STATUS_CONSTRUCTOR(DeleteSubscriptionError)
         UAF_STATUS_CONSTRUCTOR(SetMonitoringModeInvocationError)
         UAF_STATUS_CONSTRUCTOR(DefinitionNotFoundError)
+        UAF_STATUS_CONSTRUCTOR(DeleteMonitoredItemsInvocationError)
+        UAF_STATUS_CONSTRUCTOR(ServerCouldNotDeleteMonitoredItemError)
+        UAF_STATUS_CONSTRUCTOR(ModifyMonitoredItemsInvocationError)
+        UAF_STATUS_CONSTRUCTOR(ServerCouldNotModifyMonitoredItemError)
+        UAF_STATUS_CONSTRUCTOR(RepublishInvocationError)
+        UAF_STATUS_CONSTRUCTOR(RegisterNodesInvocationError)
+        UAF_STATUS_CONSTRUCTOR(UnregisterNodesInvocationError)
+        UAF_STATUS_CONSTRUCTOR(UnknownRegisteredNodesHandleError)
 
         // configuration errors
         UAF_STATUS_CONSTRUCTOR(ConfigurationError)
@@ -255,7 +358,23 @@ namespace uaf
     private:
         Status* raisedBy_;
 
-        void copyErrors(const Status& from);
+#ifndef SWIG
+        // the error that raised this status (NULL if none), shared by all copies of the status
+        const uaf::StatusErrorBase* error_;
+
+        // get the error of the given type, or a default error if the status isn't raised by it
+        template <typename ErrorType>
+        ErrorType raisedByError(uaf::statuscodes::StatusCode code) const
+        {
+            if (error_ != NULL && error_->statusCode == code)
+                return static_cast<const uaf::StatusError<ErrorType>*>(error_)->error;
+            else
+                return ErrorType();
+        }
+
+        // replace the error (which may be NULL) that raised this status
+        void setError(const uaf::StatusErrorBase* error);
+#endif
     };
 }
 
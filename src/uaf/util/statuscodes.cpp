@@ -149,6 +149,14 @@ namespace uaf
                 UAF_STATUSCODES_TOSTRING(CouldNotCreateClientPrivateKeyLocationError)
                 UAF_STATUSCODES_TOSTRING(CouldNotCreateClientCertificateLocationError)
                 UAF_STATUSCODES_TOSTRING(DefinitionNotFoundError)
+                UAF_STATUSCODES_TOSTRING(DeleteMonitoredItemsInvocationError)
+                UAF_STATUSCODES_TOSTRING(ServerCouldNotDeleteMonitoredItemError)
+                UAF_STATUSCODES_TOSTRING(ModifyMonitoredItemsInvocationError)
+                UAF_STATUSCODES_TOSTRING(ServerCouldNotModifyMonitoredItemError)
+                UAF_STATUSCODES_TOSTRING(RepublishInvocationError)
+                UAF_STATUSCODES_TOSTRING(RegisterNodesInvocationError)
+                UAF_STATUSCODES_TOSTRING(UnregisterNodesInvocationError)
+                UAF_STATUSCODES_TOSTRING(UnknownRegisteredNodesHandleError)
                 // status codes kept for backwards compatibility:
                 UAF_STATUSCODES_TOSTRING(DataFormatError)
                 UAF_STATUSCODES_TOSTRING(DataSizeError)
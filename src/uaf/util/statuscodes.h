@@ -160,6 +160,14 @@ namespace uaf
             CouldNotCreateClientPrivateKeyLocationError,
             CouldNotCreateClientCertificateLocationError,
             DefinitionNotFoundError,
+            DeleteMonitoredItemsInvocationError,
+            ServerCouldNotDeleteMonitoredItemError,
+            ModifyMonitoredItemsInvocationError,
+            ServerCouldNotModifyMonitoredItemError,
+            RepublishInvocationError,
+            RegisterNodesInvocationError,
+            UnregisterNodesInvocationError,
+            UnknownRegisteredNodesHandleError,
             // status codes kept for backwards compatibility:
             DataFormatError,
             DataSizeError,
@@ -0,0 +1,438 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/structurecodec.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::map;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    StructureCodec::StructureCodec()
+    {}
+
+
+    // Constructor
+    // =============================================================================================
+    StructureCodec::StructureCodec(const StructureDefinition& definition)
+    {
+        compile(definition);
+    }
+
+
+    // Compile the codec
+    // =============================================================================================
+    void StructureCodec::compile(const StructureDefinition& definition)
+    {
+        uaFieldDefinitions_.clear();
+        fieldNames_.clear();
+        fieldIndexes_.clear();
+        fieldKinds_.clear();
+
+        definition.toSdk(uaDefinition_);
+
+        if (uaDefinition_.isNull())
+            return;
+
+        int count = uaDefinition_.childrenCount();
+
+        uaFieldDefinitions_.reserve(count);
+        fieldNames_.reserve(count);
+        fieldKinds_.reserve(count);
+
+        for (int i = 0; i < count; i++)
+        {
+            UaStructureField uaField = uaDefinition_.child(i);
+            UaStructureDefinition uaFieldDefinition = uaField.structureDefinition();
+            bool isArray = uaField.arrayType() == UaStructureField::ArrayType_Array;
+
+            FieldKind kind;
+            if (uaFieldDefinition.isNull())
+                kind = FieldKind_Variant;
+            else if (uaFieldDefinition.isUnion())
+                kind = isArray ? FieldKind_GenericUnionArray : FieldKind_GenericUnion;
+            else
+                kind = isArray ? FieldKind_GenericStructureArray : FieldKind_GenericStructure;
+
+            string name(uaField.name().toUtf8());
+
+            uaFieldDefinitions_.push_back(uaFieldDefinition);
+            fieldNames_.push_back(name);
+            fieldIndexes_[name] = i;
+            fieldKinds_.push_back(kind);
+        }
+    }
+
+
+    // Get the definition
+    // =============================================================================================
+    StructureDefinition StructureCodec::definition() const
+    {
+        StructureDefinition ret;
+        ret.fromSdk(uaDefinition_);
+        return ret;
+    }
+
+
+    // Get the index of a field
+    // =============================================================================================
+    int StructureCodec::fieldIndex(const string& fieldName) const
+    {
+        map<string, int>::const_iterator it = fieldIndexes_.find(fieldName);
+        if (it == fieldIndexes_.end())
+            return -1;
+        else
+            return it->second;
+    }
+
+
+    // Get the kind of a field
+    // =============================================================================================
+    StructureCodec::FieldKind StructureCodec::fieldKind(size_t index) const
+    {
+        return fieldKinds_[index];
+    }
+
+
+    // Decode the fields of an SDK structure value
+    // =============================================================================================
+    void StructureCodec::decodeFields(
+            const UaGenericStructureValue&  uaValue,
+            vector<Variant>&                record) const
+    {
+        OpcUa_StatusCode uaCode;
+
+        record.resize(fieldKinds_.size());
+
+        for (size_t i = 0; i < fieldKinds_.size(); i++)
+        {
+            Variant& value = record[i];
+            int index = static_cast<int>(i);
+
+            value.clear();
+
+            if (!uaValue.isFieldSet(index))
+                continue;
+
+            if (fieldKinds_[i] == FieldKind_Variant)
+            {
+                value.fromSdk(uaValue.value(index, &uaCode));
+            }
+            else if (fieldKinds_[i] == FieldKind_GenericStructure)
+            {
+                UaExtensionObject uaExt;
+                ExtensionObject ext;
+                uaValue.genericStructure(index, &uaCode).toExtensionObject(uaExt);
+                ext.fromSdk(uaExt);
+                value.setExtensionObject(ext);
+            }
+            else if (fieldKinds_[i] == FieldKind_GenericStructureArray)
+            {
+                UaGenericStructureArray uaArr = uaValue.genericStructureArray(index, &uaCode);
+                vector<ExtensionObject> exts(uaArr.length());
+                for (OpcUa_UInt32 j = 0; j < uaArr.length(); j++)
+                {
+                    UaExtensionObject uaExt;
+                    uaArr[j].toExtensionObject(uaExt);
+                    exts[j].fromSdk(uaExt);
+                }
+                value.setExtensionObjectArray(exts);
+            }
+            else if (fieldKinds_[i] == FieldKind_GenericUnion)
+            {
+                UaExtensionObject uaExt;
+                ExtensionObject ext;
+                uaValue.genericUnion(index, &uaCode).toExtensionObject(uaExt);
+                ext.fromSdk(uaExt);
+                value.setExtensionObject(ext);
+            }
+            else if (fieldKinds_[i] == FieldKind_GenericUnionArray)
+            {
+                UaGenericUnionArray uaArr = uaValue.genericUnionArray(index, &uaCode);
+                vector<ExtensionObject> exts(uaArr.length());
+                for (OpcUa_UInt32 j = 0; j < uaArr.length(); j++)
+                {
+                    UaExtensionObject uaExt;
+                    uaArr[j].toExtensionObject(uaExt);
+                    exts[j].fromSdk(uaExt);
+                }
+                value.setExtensionObjectArray(exts);
+            }
+        }
+    }
+
+
+    // Decode a single ExtensionObject
+    // =============================================================================================
+    SdkStatus StructureCodec::decode(
+            const ExtensionObject&  extensionObject,
+            vector<Variant>&        record) const
+    {
+        if (isNull())
+            return SdkStatus(OpcUa_BadDataTypeIdUnknown);
+
+        UaExtensionObject uaExt;
+        extensionObject.toSdk(uaExt);
+
+        OpcUa_StatusCode uaCode = OpcUa_Good;
+        UaGenericStructureValue uaValue;
+        uaCode = uaValue.setGenericValue(uaExt, uaDefinition_);
+
+        if (OpcUa_IsGood(uaCode))
+            decodeFields(uaValue, record);
+        else
+            record.assign(fieldKinds_.size(), Variant());
+
+        return SdkStatus(uaCode);
+    }
+
+
+    // Decode a number of ExtensionObjects
+    // =============================================================================================
+    SdkStatus StructureCodec::decode(
+            const vector<ExtensionObject>&  extensionObjects,
+            StructureRecords&               records) const
+    {
+        if (isNull())
+            return SdkStatus(OpcUa_BadDataTypeIdUnknown);
+
+        size_t fieldCount = fieldKinds_.size();
+
+        records.fieldNames = fieldNames_;
+        records.values.resize(extensionObjects.size() * fieldCount);
+        records.opcUaStatusCodes.resize(extensionObjects.size());
+
+        // reuse the same SDK objects and the same record for all ExtensionObjects
+        UaExtensionObject uaExt;
+        UaGenericStructureValue uaValue;
+        vector<Variant> record(fieldCount);
+
+        for (size_t i = 0; i < extensionObjects.size(); i++)
+        {
+            extensionObjects[i].toSdk(uaExt);
+
+            OpcUa_StatusCode uaCode = uaValue.setGenericValue(uaExt, uaDefinition_);
+            records.opcUaStatusCodes[i] = static_cast<uint32_t>(uaCode);
+
+            vector<Variant>::iterator begin = records.values.begin() + i * fieldCount;
+
+            if (OpcUa_IsGood(uaCode))
+            {
+                decodeFields(uaValue, record);
+                std::copy(record.begin(), record.end(), begin);
+            }
+            else
+            {
+                std::fill(begin, begin + fieldCount, Variant());
+            }
+        }
+
+        return SdkStatus(OpcUa_Good);
+    }
+
+
+    // Encode a single field
+    // =============================================================================================
+    OpcUa_StatusCode StructureCodec::encodeField(
+            size_t                      i,
+            const Variant&              value,
+            UaGenericStructureValue&    uaValue) const
+    {
+        int index = static_cast<int>(i);
+
+        if (value.isNull())
+            return OpcUa_Good;
+
+        if (fieldKinds_[i] == FieldKind_Variant)
+        {
+            UaVariant uaVariant;
+            value.toSdk(uaVariant);
+            return uaValue.setField(index, uaVariant);
+        }
+
+        // nested structures and unions must be given as ExtensionObject (arrays)
+        if (value.type() != uaf::opcuatypes::ExtensionObject)
+            return OpcUa_BadTypeMismatch;
+
+        const UaStructureDefinition& uaFieldDefinition = uaFieldDefinitions_[i];
+
+        if (fieldKinds_[i] == FieldKind_GenericStructure
+                || fieldKinds_[i] == FieldKind_GenericUnion)
+        {
+            ExtensionObject ext;
+            Status status = value.toExtensionObject(ext);
+            if (status.isNotGood())
+                return OpcUa_BadTypeMismatch;
+
+            UaExtensionObject uaExt;
+            ext.toSdk(uaExt);
+
+            if (fieldKinds_[i] == FieldKind_GenericStructure)
+                return uaValue.setField(index, UaGenericStructureValue(uaExt, uaFieldDefinition));
+            else
+                return uaValue.setField(index, UaGenericUnionValue(uaExt, uaFieldDefinition));
+        }
+        else
+        {
+            vector<ExtensionObject> exts;
+            Status status = value.toExtensionObjectArray(exts);
+            if (status.isNotGood())
+                return OpcUa_BadTypeMismatch;
+
+            UaExtensionObject uaExt;
+
+            if (fieldKinds_[i] == FieldKind_GenericStructureArray)
+            {
+                UaGenericStructureArray uaArr(uaFieldDefinition);
+                uaArr.create(static_cast<OpcUa_UInt32>(exts.size()));
+                for (size_t j = 0; j < exts.size(); j++)
+                {
+                    exts[j].toSdk(uaExt);
+                    uaArr[static_cast<OpcUa_UInt32>(j)].setGenericValue(uaExt, uaFieldDefinition);
+                }
+                return uaValue.setField(index, uaArr);
+            }
+            else
+            {
+                UaGenericUnionArray uaArr(uaFieldDefinition);
+                uaArr.create(static_cast<OpcUa_UInt32>(exts.size()));
+                for (size_t j = 0; j < exts.size(); j++)
+                {
+                    exts[j].toSdk(uaExt);
+                    uaArr[static_cast<OpcUa_UInt32>(j)].setGenericUnion(uaExt, uaFieldDefinition);
+                }
+                return uaValue.setField(index, uaArr);
+            }
+        }
+    }
+
+
+    // Encode a single record
+    // =============================================================================================
+    SdkStatus StructureCodec::encode(
+            const vector<Variant>&          record,
+            ExtensionObject&                extensionObject,
+            GenericStructureValue::Encoding encoding) const
+    {
+        if (isNull())
+            return SdkStatus(OpcUa_BadDataTypeIdUnknown);
+
+        if (record.size() != fieldKinds_.size())
+            return SdkStatus(OpcUa_BadInvalidArgument);
+
+        UaGenericStructureValue uaValue(uaDefinition_);
+
+        for (size_t i = 0; i < record.size(); i++)
+        {
+            OpcUa_StatusCode uaCode = encodeField(i, record[i], uaValue);
+            if (OpcUa_IsNotGood(uaCode))
+                return SdkStatus(uaCode);
+        }
+
+        UaExtensionObject uaExt;
+        uaValue.toExtensionObject(uaExt, static_cast<UaAbstractGenericValue::Encoding>(encoding));
+        extensionObject.fromSdk(uaExt);
+
+        return SdkStatus(OpcUa_Good);
+    }
+
+
+    // Encode a number of records
+    // =============================================================================================
+    SdkStatus StructureCodec::encode(
+            const StructureRecords&         records,
+            vector<ExtensionObject>&        extensionObjects,
+            GenericStructureValue::Encoding encoding) const
+    {
+        if (isNull())
+            return SdkStatus(OpcUa_BadDataTypeIdUnknown);
+
+        if (records.fieldNames != fieldNames_
+                || records.values.size() != records.recordCount() * fieldNames_.size())
+            return SdkStatus(OpcUa_BadInvalidArgument);
+
+        size_t fieldCount = fieldNames_.size();
+
+        extensionObjects.resize(records.recordCount());
+
+        vector<Variant> record(fieldCount);
+
+        for (size_t i = 0; i < records.recordCount(); i++)
+        {
+            vector<Variant>::const_iterator begin = records.values.begin() + i * fieldCount;
+            record.assign(begin, begin + fieldCount);
+
+            SdkStatus status = encode(record, extensionObjects[i], encoding);
+            if (status.isNotGood())
+                return status;
+        }
+
+        return SdkStatus(OpcUa_Good);
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string StructureCodec::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        if (isNull())
+            return indent + string("NULL");
+
+        ss << indent << " - name";
+        ss << fillToPos(ss, colon);
+        ss << ": " << UaString(uaDefinition_.name()).toUtf8() << "\n";
+
+        ss << indent << " - fields[]";
+        if (fieldNames_.empty())
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []";
+        }
+
+        for (size_t i = 0; i < fieldNames_.size(); i++)
+        {
+            ss << "\n";
+            ss << indent << "    - fields[" << i << "]";
+            ss << fillToPos(ss, colon);
+            ss << ": " << fieldNames_[i];
+
+            switch (fieldKinds_[i])
+            {
+                case FieldKind_Variant:               ss << " (Variant)";               break;
+                case FieldKind_GenericStructure:      ss << " (GenericStructure)";      break;
+                case FieldKind_GenericStructureArray: ss << " (GenericStructureArray)"; break;
+                case FieldKind_GenericUnion:          ss << " (GenericUnion)";          break;
+                case FieldKind_GenericUnionArray:     ss << " (GenericUnionArray)";     break;
+            }
+        }
+
+        return ss.str();
+    }
+
+}
@@ -0,0 +1,252 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_STRUCTURECODEC_H_
+#define UAF_STRUCTURECODEC_H_
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <stdint.h>
+// SDK
+#include "uabase/uagenericstructurevalue.h"
+#include "uabase/uagenericunionvalue.h"
+#include "uabase/uastructuredefinition.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/sdkstatus.h"
+#include "uaf/util/variant.h"
+#include "uaf/util/extensionobject.h"
+#include "uaf/util/structuredefinition.h"
+#include "uaf/util/structurerecords.h"
+#include "uaf/util/genericstructurevalue.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+     * A StructureCodec is a "compiled" StructureDefinition, which can decode ExtensionObjects
+     * into flat records (and encode them again) without resolving the fields by name.
+     *
+     * The definition is converted to the SDK representation only once (when the codec is
+     * compiled), the field names are mapped to their indexes only once, and the kind of each
+     * field (a plain value, a nested structure or union, or an array of them) is determined
+     * only once. A codec is therefore cheap to use for many values of the same datatype.
+     *
+     * Fields that are plain values are decoded as a Variant. Fields that are nested structures
+     * or unions are decoded as a Variant holding an ExtensionObject (or an array of
+     * ExtensionObjects), which can be decoded further with the codec of the nested datatype.
+     * Fields that are not set (e.g. optional fields) are decoded as a null Variant.
+     *
+     * @ingroup Util
+     **********************************************************************************************/
+    class UAF_EXPORT StructureCodec
+    {
+    public:
+
+
+        /**
+         * This enum defines the kind of a field, as determined when the codec is compiled.
+         *
+         * @ingroup Util
+         */
+        enum FieldKind
+        {
+            FieldKind_Variant               = 0,
+            FieldKind_GenericStructure      = 1,
+            FieldKind_GenericStructureArray = 2,
+            FieldKind_GenericUnion          = 3,
+            FieldKind_GenericUnionArray     = 4
+        };
+
+
+        /**
+         * Construct an empty (null) codec.
+         */
+        StructureCodec();
+
+
+        /**
+         * Construct a codec and compile it for the given definition.
+         *
+         * @param definition    The structure definition.
+         */
+        StructureCodec(const uaf::StructureDefinition& definition);
+
+
+        /**
+         * Compile the codec for the given definition.
+         *
+         * @param definition    The structure definition.
+         */
+        void compile(const uaf::StructureDefinition& definition);
+
+
+        /**
+         * Is the codec null (i.e. not compiled for a valid definition)?
+         *
+         * @return True if the codec cannot be used.
+         */
+        bool isNull() const { return uaDefinition_.isNull(); }
+
+
+        /**
+         * Get the definition of the codec.
+         *
+         * @return The structure definition.
+         */
+        uaf::StructureDefinition definition() const;
+
+
+        /**
+         * Get the number of fields.
+         *
+         * @return The number of fields of the structure.
+         */
+        std::size_t fieldCount() const { return fieldNames_.size(); }
+
+
+        /**
+         * Get the names of the fields.
+         *
+         * @return The names of the fields, in the order of the definition.
+         */
+        std::vector<std::string> fieldNames() const { return fieldNames_; }
+
+
+        /**
+         * Get the index of a field.
+         *
+         * @param fieldName The name of the field.
+         * @return          The index of the field, or -1 if there is no such field.
+         */
+        int fieldIndex(const std::string& fieldName) const;
+
+
+        /**
+         * Get the kind of a field.
+         *
+         * @param index     The index of the field (must be smaller than fieldCount()).
+         * @return          The kind of the field.
+         */
+        uaf::StructureCodec::FieldKind fieldKind(std::size_t index) const;
+
+
+        /**
+         * Decode a single ExtensionObject into a record.
+         *
+         * @param extensionObject   The ExtensionObject to decode.
+         * @param record            The decoded fields (one Variant per field).
+         * @return                  Good if the structure could be decoded.
+         */
+        uaf::SdkStatus decode(
+                const uaf::ExtensionObject&     extensionObject,
+                std::vector<uaf::Variant>&      record) const;
+
+
+        /**
+         * Decode a number of ExtensionObjects into flat records.
+         *
+         * The ExtensionObjects that cannot be decoded result in a record of null Variants, and
+         * a bad status code in the opcUaStatusCodes of the records.
+         *
+         * @param extensionObjects  The ExtensionObjects to decode.
+         * @param records           The decoded records.
+         * @return                  Good if the codec is not null. The individual results are
+         *                          stored in records.opcUaStatusCodes.
+         */
+        uaf::SdkStatus decode(
+                const std::vector<uaf::ExtensionObject>&    extensionObjects,
+                uaf::StructureRecords&                      records) const;
+
+
+        /**
+         * Encode a record into an ExtensionObject.
+         *
+         * @param record            The fields of the structure (one Variant per field, null
+         *                          Variants are left unset).
+         * @param extensionObject   The encoded ExtensionObject.
+         * @param encoding          The encoding of the ExtensionObject.
+         * @return                  Good if the record could be encoded.
+         */
+        uaf::SdkStatus encode(
+                const std::vector<uaf::Variant>&        record,
+                uaf::ExtensionObject&                   extensionObject,
+                uaf::GenericStructureValue::Encoding    encoding
+                    = uaf::GenericStructureValue::Encoding_Binary) const;
+
+
+        /**
+         * Encode a number of flat records into ExtensionObjects.
+         *
+         * @param records           The records to encode (the field names must match the
+         *                          field names of the codec).
+         * @param extensionObjects  The encoded ExtensionObjects.
+         * @param encoding          The encoding of the ExtensionObjects.
+         * @return                  Good if all records could be encoded.
+         */
+        uaf::SdkStatus encode(
+                const uaf::StructureRecords&            records,
+                std::vector<uaf::ExtensionObject>&      extensionObjects,
+                uaf::GenericStructureValue::Encoding    encoding
+                    = uaf::GenericStructureValue::Encoding_Binary) const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return The string representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=20) const;
+
+
+    private:
+
+        // decode the fields of an SDK structure value
+        void decodeFields(
+                const UaGenericStructureValue&  uaValue,
+                std::vector<uaf::Variant>&      record) const;
+
+        // encode a single field into an SDK structure value
+        OpcUa_StatusCode encodeField(
+                std::size_t                 index,
+                const uaf::Variant&         value,
+                UaGenericStructureValue&    uaValue) const;
+
+        // the definition, converted to the SDK representation only once
+        UaStructureDefinition uaDefinition_;
+        // the definitions of the nested structures and unions (null for plain values)
+        std::vector<UaStructureDefinition> uaFieldDefinitions_;
+        // the names, the indexes and the kinds of the fields
+        std::vector<std::string> fieldNames_;
+        std::map<std::string, int> fieldIndexes_;
+        std::vector<FieldKind> fieldKinds_;
+    };
+
+}
+
+
+#endif /* UAF_STRUCTURECODEC_H_ */
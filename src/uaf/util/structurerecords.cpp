@@ -0,0 +1,128 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/structurerecords.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    StructureRecords::StructureRecords()
+    {}
+
+
+    // Clear the records
+    // =============================================================================================
+    void StructureRecords::clear()
+    {
+        fieldNames.clear();
+        values.clear();
+        opcUaStatusCodes.clear();
+    }
+
+
+    // Get a single value
+    // =============================================================================================
+    Variant StructureRecords::value(size_t record, size_t field) const
+    {
+        size_t i = record * fieldCount() + field;
+
+        if (field < fieldCount() && i < values.size())
+            return values[i];
+        else
+            return Variant();
+    }
+
+
+    // Get a single record
+    // =============================================================================================
+    vector<Variant> StructureRecords::record(size_t record) const
+    {
+        vector<Variant> ret;
+
+        size_t begin = record * fieldCount();
+        size_t end   = begin + fieldCount();
+
+        if (record < recordCount() && end <= values.size())
+            ret.assign(values.begin() + begin, values.begin() + end);
+
+        return ret;
+    }
+
+
+    // Get a single column
+    // =============================================================================================
+    vector<Variant> StructureRecords::column(const string& fieldName) const
+    {
+        vector<Variant> ret;
+
+        for (size_t field = 0; field < fieldCount(); field++)
+        {
+            if (fieldNames[field] == fieldName)
+            {
+                ret.reserve(recordCount());
+                for (size_t record = 0; record < recordCount(); record++)
+                    ret.push_back(value(record, field));
+                break;
+            }
+        }
+
+        return ret;
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string StructureRecords::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - fieldNames[]";
+        if (fieldNames.empty())
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []\n";
+        }
+        else
+        {
+            ss << "\n";
+            for (size_t i = 0; i < fieldNames.size(); i++)
+            {
+                ss << indent << "    - fieldNames[" << i << "]";
+                ss << fillToPos(ss, colon);
+                ss << ": " << fieldNames[i] << "\n";
+            }
+        }
+
+        ss << indent << " - records";
+        ss << fillToPos(ss, colon);
+        ss << ": " << recordCount();
+
+        return ss.str();
+    }
+
+}
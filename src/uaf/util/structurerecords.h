@@ -0,0 +1,134 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_STRUCTURERECORDS_H_
+#define UAF_STRUCTURERECORDS_H_
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/variant.h"
+#include "uaf/util/stringifiable.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+     * A StructureRecords instance holds a number of decoded structures of the same datatype as
+     * "flat" records: one Variant per field per structure.
+     *
+     * The values are stored in row-major order: the value of field f of record r is stored at
+     * index r * fieldCount() + f. Fields that were not set (e.g. optional fields) hold a null
+     * Variant. Fields that are structures or unions themselves hold an ExtensionObject (or an
+     * array of ExtensionObjects).
+     *
+     * Instances are normally filled by uaf::StructureCodec::decode.
+     *
+     * @ingroup Util
+     **********************************************************************************************/
+    class UAF_EXPORT StructureRecords
+    {
+    public:
+
+
+        /**
+         * Construct an empty set of records.
+         */
+        StructureRecords();
+
+
+        /** The names of the fields, in the order of the structure definition. */
+        std::vector<std::string> fieldNames;
+
+        /** The values of all fields of all records, in row-major order. */
+        std::vector<uaf::Variant> values;
+
+        /** The OPC UA status code of the decoding of each record. */
+        std::vector<uint32_t> opcUaStatusCodes;
+
+
+        /**
+         * Get the number of fields of each record.
+         */
+        std::size_t fieldCount() const { return fieldNames.size(); }
+
+
+        /**
+         * Get the number of records.
+         */
+        std::size_t recordCount() const { return opcUaStatusCodes.size(); }
+
+
+        /**
+         * Clear all records (and the field names).
+         */
+        void clear();
+
+
+        /**
+         * Get the value of a single field of a single record.
+         *
+         * @param record    The index of the record.
+         * @param field     The index of the field.
+         * @return          The value (a null Variant if the indexes are out of bounds).
+         */
+        uaf::Variant value(std::size_t record, std::size_t field) const;
+
+
+        /**
+         * Get all fields of a single record.
+         *
+         * @param record    The index of the record.
+         * @return          The values of the fields (empty if the index is out of bounds).
+         */
+        std::vector<uaf::Variant> record(std::size_t record) const;
+
+
+        /**
+         * Get the values of a single field of all records.
+         *
+         * @param fieldName The name of the field.
+         * @return          The values of the field, one for each record (empty if there's no
+         *                  field with the given name).
+         */
+        std::vector<uaf::Variant> column(const std::string& fieldName) const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return The string representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=20) const;
+
+    };
+
+}
+
+
+#endif /* UAF_STRUCTURERECORDS_H_ */
@@ -19,6 +19,7 @@
  */
 
 #include "uaf/util/variant.h"
+#include "uaf/util/atomics.h"
 
 namespace uaf
 {
@@ -27,33 +28,260 @@ namespace uaf
     using std::stringstream;
 
 
+    // The reference counted buffer shared by all copies of a variant.
+    // It is never modified once it's filled, so it can be shared by different threads.
+    // =============================================================================================
+    struct Variant::SharedData
+    {
+        SharedData()
+        : refCount(1),
+          isNativeUaf(false),
+          dataTypeIfNativeUaf(opcuatypes::Null),
+          arrayTypeIfNativeUaf(OpcUa_VariantArrayType_Scalar)
+        {}
+
+        AtomicCount refCount;
+
+        // SDK array (if isNativeUaf is false)
+        UaVariant uaVariant;
+
+        // native UAF value (if isNativeUaf is true)
+        // We store them as vectors, so that they can also represent array types if necessary.
+        bool isNativeUaf;
+        uaf::opcuatypes::OpcUaType dataTypeIfNativeUaf;
+        OpcUa_Byte arrayTypeIfNativeUaf;
+        std::vector<uaf::NodeId> nodeId;
+        std::vector<uaf::Guid> guid;
+        std::vector<uaf::ExpandedNodeId> expandedNodeId;
+        std::vector<uaf::QualifiedName> qualifiedName;
+        std::vector<uaf::ExtensionObject> extensionObject;
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(SharedData);
+    };
+
+
+    // Helper function: get the elements of an SDK array of exactly the given type
+    // =============================================================================================
+    static bool viewSdkArray(
+            const UaVariant&    uaVariant,
+            OpcUa_BuiltInType   type,
+            const void*&        data,
+            uint32_t&           length)
+    {
+        const OpcUa_Variant* opcUaVariant = static_cast<const OpcUa_Variant*>(uaVariant);
+
+        if (   opcUaVariant->ArrayType != OpcUa_VariantArrayType_Array
+            || opcUaVariant->Datatype  != type)
+            return false;
+
+        if (opcUaVariant->Value.Array.Length > 0)
+        {
+            data   = opcUaVariant->Value.Array.Value.Array;
+            length = uint32_t(opcUaVariant->Value.Array.Length);
+        }
+        else
+        {
+            data   = 0;
+            length = 0;
+        }
+        return true;
+    }
+
+
+    // Helper function: swap the contents of two SDK variants without copying them
+    // =============================================================================================
+    static void swapSdkVariants(UaVariant& uaVariant1, UaVariant& uaVariant2)
+    {
+        // the UaVariants own whatever their OpcUa_Variant structs point to, so swapping the
+        // structs themselves also swaps the ownership
+        OpcUa_Variant* opcUaVariant1 = const_cast<OpcUa_Variant*>(
+                static_cast<const OpcUa_Variant*>(uaVariant1));
+        OpcUa_Variant* opcUaVariant2 = const_cast<OpcUa_Variant*>(
+                static_cast<const OpcUa_Variant*>(uaVariant2));
+        OpcUa_Variant temp = *opcUaVariant1;
+        *opcUaVariant1     = *opcUaVariant2;
+        *opcUaVariant2     = temp;
+    }
+
+
     // Constructor
     // =============================================================================================
     Variant::Variant()
-    : isNativeUaf_(false),
-      dataTypeIfNativeUaf_(opcuatypes::Null),
-      arrayTypeIfNativeUaf_(OpcUa_VariantArrayType_Scalar)
+    : shared_(0)
     {}
 
 
     // Constructor
     // =============================================================================================
     Variant::Variant(const OpcUa_Variant& variant)
-    : uaVariant_(variant),
-      isNativeUaf_(false),
-      dataTypeIfNativeUaf_(opcuatypes::Null),
-      arrayTypeIfNativeUaf_(OpcUa_VariantArrayType_Scalar)
-    {}
+    : shared_(0)
+    {
+        assignSdk(variant);
+    }
+
+
+    // Copy constructor
+    // =============================================================================================
+    Variant::Variant(const Variant& other)
+    : uaVariant_(other.uaVariant_),
+      shared_(other.shared_)
+    {
+        if (shared_ != 0)
+            atomicIncrement(&shared_->refCount);
+    }
+
+
+    // Copy assignment
+    // =============================================================================================
+    Variant& Variant::operator=(const Variant& other)
+    {
+        if (this != &other)
+        {
+            // increment first, in case both variants share the same buffer
+            if (other.shared_ != 0)
+                atomicIncrement(&other.shared_->refCount);
+            releaseShared();
+            shared_    = other.shared_;
+            uaVariant_ = other.uaVariant_;
+        }
+        return *this;
+    }
+
+
+#if __cplusplus >= 201103L
+    // Move constructor
+    // =============================================================================================
+    Variant::Variant(Variant&& other)
+    : shared_(0)
+    {
+        swap(other);
+    }
+
+
+    // Move assignment
+    // =============================================================================================
+    Variant& Variant::operator=(Variant&& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+#endif
+
+
+    // Destructor
+    // =============================================================================================
+    Variant::~Variant()
+    {
+        releaseShared();
+    }
+
+
+    // Swap two variants
+    // =============================================================================================
+    void Variant::swap(Variant& other)
+    {
+        swapSdkVariants(uaVariant_, other.uaVariant_);
+        SharedData* temp = shared_;
+        shared_          = other.shared_;
+        other.shared_    = temp;
+    }
+
+
+    // Get the SDK object that holds the value
+    // =============================================================================================
+    const UaVariant& Variant::sdkVariant() const
+    {
+        if (shared_ != 0)
+            return shared_->uaVariant;
+        else
+            return uaVariant_;
+    }
+
+
+    // Does the variant hold a native UAF value?
+    // =============================================================================================
+    bool Variant::isNativeUaf() const
+    {
+        return (shared_ != 0) && shared_->isNativeUaf;
+    }
+
+
+    // Release the shared buffer
+    // =============================================================================================
+    void Variant::releaseShared()
+    {
+        if (shared_ != 0)
+        {
+            if (atomicDecrement(&shared_->refCount) == 0)
+                delete shared_;
+            shared_ = 0;
+        }
+    }
+
+
+    // Allocate a new shared buffer for an SDK array
+    // =============================================================================================
+    UaVariant& Variant::newSharedSdkVariant()
+    {
+        clear();
+        shared_ = new SharedData;
+        return shared_->uaVariant;
+    }
+
+
+    // Allocate a new shared buffer for a native UAF value
+    // =============================================================================================
+    Variant::SharedData& Variant::newSharedNativeUaf(
+            opcuatypes::OpcUaType type,
+            OpcUa_Byte            arrayType)
+    {
+        clear();
+        shared_ = new SharedData;
+        shared_->isNativeUaf          = true;
+        shared_->dataTypeIfNativeUaf  = type;
+        shared_->arrayTypeIfNativeUaf = arrayType;
+        return *shared_;
+    }
+
+
+    // Copy an SDK variant
+    // =============================================================================================
+    void Variant::assignSdk(const OpcUa_Variant& opcUaVariant)
+    {
+        if (opcUaVariant.ArrayType == OpcUa_VariantArrayType_Scalar)
+        {
+            clear();
+            uaVariant_ = opcUaVariant;
+        }
+        else
+        {
+            newSharedSdkVariant() = opcUaVariant;
+        }
+    }
 
 
     // Convert the variant to a native C++ uint8_t.
     // =============================================================================================
     Status Variant::toByteArray(std::vector<uint8_t>& vec) const
     {
+        const void* data;
+        uint32_t length;
+        if (viewSdkArray(sdkVariant(), OpcUaType_Byte, data, length))
+        {
+            const uint8_t* elements = static_cast<const uint8_t*>(data);
+            vec.assign(elements, elements + length);
+            return uaf::statuscodes::Good;
+        }
+
         UaByteArray arr;
         uaf::Status ret = evaluate(
-                uaVariant_.toByteArray(arr),
-                uaVariant_.type(),
+                sdkVariant().toByteArray(arr),
+                sdkVariant().type(),
                 OpcUaType_Byte);
         vec.resize(arr.size());
         for (int i = 0; i < arr.size(); i++)
@@ -67,8 +295,8 @@ namespace uaf
     Status Variant::to##XXX(CPPTYPE &val) const                                                    \
     {                                                                                              \
         return evaluate(                                                                           \
-                uaVariant_.to##XXX( (OpcUa_##XXX &) val ),                                         \
-                uaVariant_.type(),                                                                 \
+                sdkVariant().to##XXX( (OpcUa_##XXX &) val ),                                       \
+                sdkVariant().type(),                                                               \
                 OpcUaType_##XXX);                                                                  \
     }
 
@@ -90,10 +318,19 @@ namespace uaf
     =========================================================================================== */ \
     Status Variant::to##XXX##Array(std::vector<CPPTYPE>& vec) const                                \
     {                                                                                              \
+        const void* data;                                                                          \
+        uint32_t length;                                                                           \
+        if (viewSdkArray(sdkVariant(), OpcUaType_##XXX, data, length))                             \
+        {                                                                                          \
+            const CPPTYPE* elements = static_cast<const CPPTYPE*>(data);                           \
+            vec.assign(elements, elements + length);                                               \
+            return uaf::statuscodes::Good;                                                         \
+        }                                                                                          \
+                                                                                                   \
         Ua##XXX##Array arr;                                                                        \
         uaf::Status ret = evaluate(                                                                \
-                uaVariant_.to##XXX##Array(arr),                                                    \
-                uaVariant_.type(),                                                                 \
+                sdkVariant().to##XXX##Array(arr),                                                  \
+                sdkVariant().type(),                                                               \
                 OpcUaType_##XXX);                                                                  \
         vec.resize(arr.length());                                                                  \
         for (std::size_t i = 0; i < arr.length(); i++)                                             \
@@ -119,34 +356,34 @@ namespace uaf
     Status Variant::to##XXX(uaf::XXX& val) const                                                   \
     {                                                                                              \
         uaf::Status ret;                                                                           \
-        if (isNativeUaf_)                                                                          \
+        if (isNativeUaf())                                                                         \
         {                                                                                          \
-            if (dataTypeIfNativeUaf_ != uaf::opcuatypes::XXX)                                      \
+            if (shared_->dataTypeIfNativeUaf != uaf::opcuatypes::XXX)                              \
                 ret = uaf::WrongTypeError();                                                       \
-            else if (arrayTypeIfNativeUaf_ != OpcUa_VariantArrayType_Scalar)                       \
+            else if (shared_->arrayTypeIfNativeUaf != OpcUa_VariantArrayType_Scalar)               \
                 ret = uaf::WrongTypeError();                                                       \
-            else if (INTERNAL.size() != 1)                                                         \
+            else if (shared_->INTERNAL.size() != 1)                                                \
                 ret = uaf::UnexpectedError("Bug: wrong size of internal vector");                  \
             else                                                                                   \
             {                                                                                      \
                 ret = uaf::statuscodes::Good;                                                      \
-                val = INTERNAL[0];                                                                 \
+                val = shared_->INTERNAL[0];                                                        \
             }                                                                                      \
         }                                                                                          \
         else                                                                                       \
         {                                                                                          \
             Ua##XXX uaObject;                                                                      \
-            ret = evaluate(uaVariant_.to##XXX(uaObject), uaVariant_.type(), OpcUaType_##XXX);      \
+            ret = evaluate(sdkVariant().to##XXX(uaObject), sdkVariant().type(), OpcUaType_##XXX);  \
             val.fromSdk(uaObject);                                                                 \
         }                                                                                          \
         return ret;                                                                                \
     }
 
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(NodeId          , nodeId_)
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(Guid            , guid_)
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(ExpandedNodeId  , expandedNodeId_)
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(QualifiedName   , qualifiedName_)
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(ExtensionObject , extensionObject_)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(NodeId          , nodeId)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(Guid            , guid)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(ExpandedNodeId  , expandedNodeId)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(QualifiedName   , qualifiedName)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(ExtensionObject , extensionObject)
 
 
 
@@ -156,24 +393,24 @@ namespace uaf
     uaf::Status Variant::to##XXX##Array(std::vector<uaf::XXX>& vec) const                          \
     {                                                                                              \
         uaf::Status ret;                                                                           \
-        if (isNativeUaf_)                                                                          \
+        if (isNativeUaf())                                                                         \
         {                                                                                          \
-            if (dataTypeIfNativeUaf_ != uaf::opcuatypes::XXX)                                      \
+            if (shared_->dataTypeIfNativeUaf != uaf::opcuatypes::XXX)                              \
                 ret = uaf::WrongTypeError();                                                       \
-            else if (arrayTypeIfNativeUaf_ != OpcUa_VariantArrayType_Array)                        \
+            else if (shared_->arrayTypeIfNativeUaf != OpcUa_VariantArrayType_Array)                \
                 ret = uaf::WrongTypeError();                                                       \
             else                                                                                   \
             {                                                                                      \
                 ret = uaf::statuscodes::Good;                                                      \
-                vec = INTERNAL;                                                                    \
+                vec = shared_->INTERNAL;                                                           \
             }                                                                                      \
         }                                                                                          \
         else                                                                                       \
         {                                                                                          \
             Ua##XXX##Array arr;                                                                    \
             ret = evaluate(                                                                        \
-                    uaVariant_.to##XXX##Array(arr),                                                \
-                    uaVariant_.type(),                                                             \
+                    sdkVariant().to##XXX##Array(arr),                                              \
+                    sdkVariant().type(),                                                           \
                     OpcUaType_##XXX);                                                              \
             vec.resize(arr.length());                                                              \
             for (std::size_t i = 0; i < arr.length(); i++)                                         \
@@ -182,11 +419,11 @@ namespace uaf
         return ret;                                                                                \
     }
 
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(NodeId          , nodeId_)
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(Guid            , guid_)
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(ExpandedNodeId  , expandedNodeId_)
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(QualifiedName   , qualifiedName_)
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(ExtensionObject , extensionObject_)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(NodeId          , nodeId)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(Guid            , guid)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(ExpandedNodeId  , expandedNodeId)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(QualifiedName   , qualifiedName)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(ExtensionObject , extensionObject)
 
 
 
@@ -216,11 +453,10 @@ namespace uaf
     // ===========================================================================================
     void Variant::setByteArray(const std::vector<uint8_t>& vec)
     {
-        clear();
         UaByteArray arr;
         arr.resize(vec.size());
         for (std::size_t i = 0; i < vec.size(); i++) { arr[int(i)] = vec[i]; }
-        uaVariant_.setByteArray(arr);
+        newSharedSdkVariant().setByteArray(arr);
     }
 
 
@@ -229,11 +465,10 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX##Array(const std::vector<CPPTYPE>& vec)                                 \
     {                                                                                              \
-        clear();                                                                                   \
-        Ua##XXX##Array arr;                                                                        \
-        arr.create(vec.size());                                                                    \
-        for (std::size_t i = 0; i < vec.size(); i++) { arr[i] = vec[i]; }                          \
-        uaVariant_.set##XXX##Array(arr);                                                           \
+        /* the C++ type has the same size as the OPC UA type, so the data is copied in one go */   \
+        setNumericArray(uaf::opcuatypes::XXX,                                                      \
+                        vec.empty() ? 0 : &vec[0],                                                 \
+                        static_cast<uint32_t>(vec.size()));                                        \
     }
 
     IMPLEMENT_VARIANT_SETXXXARRAY_METHOD(SByte  , int8_t)
@@ -252,7 +487,7 @@ namespace uaf
     Status Variant::toBoolean(bool &val) const
     {
         OpcUa_Boolean opcUaVal;
-        Status ret = evaluate(uaVariant_.toBool(opcUaVal), uaVariant_.type(), OpcUaType_Boolean);
+        Status ret = evaluate(sdkVariant().toBool(opcUaVal), sdkVariant().type(), OpcUaType_Boolean);
         val = (bool)(opcUaVal);
         return ret;
     }
@@ -262,7 +497,7 @@ namespace uaf
     Status Variant::toBooleanArray(std::vector<bool>& vec) const
     {
         UaBoolArray arr;
-        uaf::Status ret = evaluate(uaVariant_.toBoolArray(arr), uaVariant_.type(), OpcUaType_Boolean);
+        uaf::Status ret = evaluate(sdkVariant().toBoolArray(arr), sdkVariant().type(), OpcUaType_Boolean);
         vec.resize(arr.length());
         for (std::size_t i = 0; i < arr.length(); i++)
             vec[i] = arr[i];
@@ -281,28 +516,142 @@ namespace uaf
     // =============================================================================================
     void Variant::setBooleanArray(const std::vector<bool>& vec)
     {
-        clear();
         UaBoolArray arr;
         arr.create(vec.size());
         for (std::size_t i = 0; i < vec.size(); i++) { arr[i] = vec[i]; }
-        uaVariant_.setBoolArray(arr);
+        newSharedSdkVariant().setBoolArray(arr);
     }
 
 
 
+    // Get the size of a single element of a numeric type
+    // =============================================================================================
+    std::size_t Variant::numericTypeSize(opcuatypes::OpcUaType type)
+    {
+        switch (type)
+        {
+            case opcuatypes::Boolean:   return sizeof(OpcUa_Boolean);
+            case opcuatypes::SByte:     return sizeof(OpcUa_SByte);
+            case opcuatypes::Byte:      return sizeof(OpcUa_Byte);
+            case opcuatypes::Int16:     return sizeof(OpcUa_Int16);
+            case opcuatypes::UInt16:    return sizeof(OpcUa_UInt16);
+            case opcuatypes::Int32:     return sizeof(OpcUa_Int32);
+            case opcuatypes::UInt32:    return sizeof(OpcUa_UInt32);
+            case opcuatypes::Int64:     return sizeof(OpcUa_Int64);
+            case opcuatypes::UInt64:    return sizeof(OpcUa_UInt64);
+            case opcuatypes::Float:     return sizeof(OpcUa_Float);
+            case opcuatypes::Double:    return sizeof(OpcUa_Double);
+            default:                    return 0;
+        }
+    }
+
+
+    // Set the variant to a numeric array
+    // =============================================================================================
+    Status Variant::setNumericArray(opcuatypes::OpcUaType type, const void* data, uint32_t length)
+    {
+        Status ret;
+
+        std::size_t elementSize = numericTypeSize(type);
+
+        if (elementSize == 0)
+        {
+            ret = uaf::WrongTypeError(uaf::format("Cannot set a numeric array of type %s",
+                                                  opcuatypes::toString(type).c_str()));
+            return ret;
+        }
+
+        // create the stack variant ourselves, so the data can be copied in one go
+        OpcUa_Variant opcUaVariant;
+        OpcUa_Variant_Initialize(&opcUaVariant);
+        opcUaVariant.Datatype           = static_cast<OpcUa_Byte>(opcuatypes::fromUafToSdk(type));
+        opcUaVariant.ArrayType          = OpcUa_VariantArrayType_Array;
+        opcUaVariant.Value.Array.Length = static_cast<OpcUa_Int32>(length);
+
+        if (length > 0)
+        {
+            std::size_t byteSize = length * elementSize;
+            opcUaVariant.Value.Array.Value.Array = OpcUa_Alloc(byteSize);
+
+            if (opcUaVariant.Value.Array.Value.Array == OpcUa_Null)
+            {
+                ret = uaf::UnexpectedError("Could not allocate the numeric array");
+                return ret;
+            }
+
+            memcpy(opcUaVariant.Value.Array.Value.Array, data, byteSize);
+        }
+
+        // the shared UaVariant takes ownership of the allocated data
+        newSharedSdkVariant().attach(&opcUaVariant);
+
+        ret = uaf::statuscodes::Good;
+        return ret;
+    }
+
+
+    // Get the data of a numeric array
+    // =============================================================================================
+    const void* Variant::numericArrayData() const
+    {
+        if (isNativeUaf() || !sdkVariant().isArray() || numericTypeSize(type()) == 0)
+            return 0;
+
+        const OpcUa_Variant* opcUaVariant = static_cast<const OpcUa_Variant*>(sdkVariant());
+        return opcUaVariant->Value.Array.Value.Array;
+    }
+
+
+#define IMPLEMENT_VARIANT_VIEW_METHOD(XXX, CPPTYPE)                                                \
+    /** Get a read-only view on the elements of a numeric array.                                   \
+    =========================================================================================== */ \
+    Status Variant::view##XXX##Array(const CPPTYPE*& data, uint32_t& length) const                 \
+    {                                                                                              \
+        Status ret;                                                                                \
+        const void* elements;                                                                      \
+        if (viewSdkArray(sdkVariant(), OpcUaType_##XXX, elements, length))                         \
+        {                                                                                          \
+            data = static_cast<const CPPTYPE*>(elements);                                          \
+            ret = uaf::statuscodes::Good;                                                          \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            data   = 0;                                                                            \
+            length = 0;                                                                            \
+            ret = uaf::WrongTypeError(uaf::format(                                                 \
+                    "Cannot view a %s%s as a %s array",                                            \
+                    opcuatypes::toString(type()).c_str(),                                          \
+                    isArray() ? " array" : "",                                                     \
+                    #XXX));                                                                        \
+        }                                                                                          \
+        return ret;                                                                                \
+    }
+
+    IMPLEMENT_VARIANT_VIEW_METHOD(SByte  , int8_t)
+    IMPLEMENT_VARIANT_VIEW_METHOD(Byte   , uint8_t)
+    IMPLEMENT_VARIANT_VIEW_METHOD(Int16  , int16_t)
+    IMPLEMENT_VARIANT_VIEW_METHOD(UInt16 , uint16_t)
+    IMPLEMENT_VARIANT_VIEW_METHOD(Int32  , int32_t)
+    IMPLEMENT_VARIANT_VIEW_METHOD(UInt32 , uint32_t)
+    IMPLEMENT_VARIANT_VIEW_METHOD(Int64  , int64_t)
+    IMPLEMENT_VARIANT_VIEW_METHOD(UInt64 , uint64_t)
+    IMPLEMENT_VARIANT_VIEW_METHOD(Float  , float)
+    IMPLEMENT_VARIANT_VIEW_METHOD(Double , double)
+
+
     // Convert the variant to a string.
     // =============================================================================================
     Status Variant::toString(string &val) const
     {
-        if (uaVariant_.isEmpty())
+        if (sdkVariant().isEmpty())
             val = string();
         else
         {
-            UaString uaString(uaVariant_.toString());
+            UaString uaString(sdkVariant().toString());
             if (uaString.isEmpty() || uaString.isNull())
                 val = string();
             else
-                val = uaVariant_.toString().toUtf8();
+                val = sdkVariant().toString().toUtf8();
         }
 
 
@@ -315,7 +664,7 @@ namespace uaf
     Status Variant::toStringArray(std::vector<std::string>& vec) const
     {
         UaStringArray arr;
-        Status ret = evaluate(uaVariant_.toStringArray(arr), uaVariant_.type(), OpcUaType_String);
+        Status ret = evaluate(sdkVariant().toStringArray(arr), sdkVariant().type(), OpcUaType_String);
         vec.resize(arr.length());
         for (std::size_t i = 0; i < arr.length(); i++)
         {
@@ -343,11 +692,10 @@ namespace uaf
     // =============================================================================================
     void Variant::setStringArray(const std::vector<std::string>& vec)
     {
-        clear();
         UaStringArray arr;
         arr.create(vec.size());
         for (std::size_t i = 0; i < vec.size(); i++) { UaString(vec[i].c_str()).copyTo(&arr[i]); }
-        uaVariant_.setStringArray(arr);
+        newSharedSdkVariant().setStringArray(arr);
     }
 
 
@@ -357,7 +705,9 @@ namespace uaf
     Status Variant::to##XXX(uaf::XXX& val) const                                                   \
     {                                                                                              \
         Ua##XXX ua##XXX;                                                                           \
-        Status ret = evaluate(uaVariant_.to##XXX(ua##XXX), uaVariant_.type(), OpcUaType_##XXX);    \
+        Status ret = evaluate(sdkVariant().to##XXX(ua##XXX),                                       \
+                              sdkVariant().type(),                                                 \
+                              OpcUaType_##XXX);                                                    \
         val.fromSdk(ua##XXX);                                                                      \
         return ret;                                                                                \
     }
@@ -374,7 +724,9 @@ namespace uaf
     Status Variant::to##XXX##Array(std::vector<uaf::XXX>& vec) const                               \
     {                                                                                              \
         Ua##XXX##Array arr;                                                                        \
-        Status ret = evaluate(uaVariant_.to##XXX##Array(arr), uaVariant_.type(), OpcUaType_##XXX); \
+        Status ret = evaluate(sdkVariant().to##XXX##Array(arr),                                    \
+                              sdkVariant().type(),                                                 \
+                              OpcUaType_##XXX);                                                    \
         vec.resize(arr.length());                                                                  \
         for (std::size_t i = 0; i < arr.length(); i++)                                             \
             vec[i].fromSdk(Ua##XXX(arr[i]));                                                       \
@@ -416,13 +768,12 @@ namespace uaf
 #define IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_COMPLEX(XXX)                                          \
     /** Convert the variant to a complex native C++ type.                                          \
     =========================================================================================== */ \
-    void Variant::set##XXX##Array(const std::vector<uaf::XXX>& vec)                                         \
+    void Variant::set##XXX##Array(const std::vector<uaf::XXX>& vec)                                \
     {                                                                                              \
-        clear();                                                                                   \
         Ua##XXX##Array arr;                                                                        \
         arr.create(vec.size());                                                                    \
         for (std::size_t i = 0; i < vec.size(); i++) { vec[i].toSdk(&arr[i]); }                    \
-        uaVariant_.set##XXX##Array(arr);                                                           \
+        newSharedSdkVariant().set##XXX##Array(arr);                                                \
     }
     IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_COMPLEX(ByteString)
     IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_COMPLEX(LocalizedText)
@@ -434,16 +785,14 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX(const uaf::XXX& val)                                                    \
     {                                                                                              \
-        clear();                                                                                   \
-        isNativeUaf_ = true;                                                                       \
-        dataTypeIfNativeUaf_  = uaf::opcuatypes::XXX;                                              \
-        INTERNAL.push_back(val);                                                                   \
+        newSharedNativeUaf(uaf::opcuatypes::XXX, OpcUa_VariantArrayType_Scalar)                    \
+            .INTERNAL.push_back(val);                                                              \
     }
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(QualifiedName, qualifiedName_)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(NodeId, nodeId_)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(Guid, guid_)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(ExpandedNodeId, expandedNodeId_)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(ExtensionObject, extensionObject_)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(QualifiedName, qualifiedName)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(NodeId, nodeId)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(Guid, guid)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(ExpandedNodeId, expandedNodeId)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(ExtensionObject, extensionObject)
 
 
 #define IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(XXX, INTERNAL)                             \
@@ -451,17 +800,14 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX##Array(const std::vector<uaf::XXX>& vec)                                \
     {                                                                                              \
-        clear();                                                                                   \
-        isNativeUaf_ = true;                                                                       \
-        dataTypeIfNativeUaf_  = uaf::opcuatypes::XXX;                                              \
-        arrayTypeIfNativeUaf_ = OpcUa_VariantArrayType_Array;                                      \
-        INTERNAL = vec;                                                                            \
+        newSharedNativeUaf(uaf::opcuatypes::XXX, OpcUa_VariantArrayType_Array)                     \
+            .INTERNAL = vec;                                                                       \
     }
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(QualifiedName, qualifiedName_)
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(NodeId, nodeId_)
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(Guid, guid_)
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(ExpandedNodeId, expandedNodeId_)
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(ExtensionObject, extensionObject_)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(QualifiedName, qualifiedName)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(NodeId, nodeId)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(Guid, guid)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(ExpandedNodeId, expandedNodeId)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(ExtensionObject, extensionObject)
 
 
     // Get a string representation
@@ -485,8 +831,10 @@ namespace uaf
         }
         else
         {
-            if (isNativeUaf_)
+            if (isNativeUaf())
             {
+                const SharedData& data = *shared_;
+
                 if (isArray())
                 {
                     ss << "{";
@@ -498,19 +846,19 @@ namespace uaf
                         switch (t)
                         {
                             case uaf::opcuatypes::NodeId:
-                                ss << nodeId_[i].toString();
+                                ss << data.nodeId[i].toString();
                                 break;
                             case uaf::opcuatypes::Guid:
-                                ss << guid_[i].toString();
+                                ss << data.guid[i].toString();
                                 break;
                             case uaf::opcuatypes::ExpandedNodeId:
-                                ss << expandedNodeId_[i].toString();
+                                ss << data.expandedNodeId[i].toString();
                                 break;
                             case uaf::opcuatypes::QualifiedName:
-                                ss << qualifiedName_[i].toString();
+                                ss << data.qualifiedName[i].toString();
                                 break;
                             case uaf::opcuatypes::ExtensionObject:
-                                ss << '\n' << extensionObject_[i].toString(indent, colon);
+                                ss << '\n' << data.extensionObject[i].toString(indent, colon);
                                 break;
                             default:
                                 ss << "INVALID";
@@ -525,19 +873,19 @@ namespace uaf
                     switch (t)
                     {
                         case uaf::opcuatypes::NodeId:
-                            ss << nodeId_[0].toString();
+                            ss << data.nodeId[0].toString();
                             break;
                         case uaf::opcuatypes::Guid:
-                            ss << guid_[0].toString();
+                            ss << data.guid[0].toString();
                             break;
                         case uaf::opcuatypes::ExpandedNodeId:
-                            ss << expandedNodeId_[0].toString();
+                            ss << data.expandedNodeId[0].toString();
                             break;
                         case uaf::opcuatypes::QualifiedName:
-                            ss << qualifiedName_[0].toString();
+                            ss << data.qualifiedName[0].toString();
                             break;
                         case uaf::opcuatypes::ExtensionObject:
-                            ss << '\n' << extensionObject_[0].toString(indent, colon);
+                            ss << '\n' << data.extensionObject[0].toString(indent, colon);
                             break;
                         default:
                             ss << "INVALID";
@@ -547,13 +895,13 @@ namespace uaf
             }
             else
             {
-                if (uaVariant_.isEmpty())
+                if (sdkVariant().isEmpty())
                 {
                     ss << "";
                 }
                 else
                 {
-                    UaString uaString(uaVariant_.toString());
+                    UaString uaString(sdkVariant().toString());
                     if (uaString.isNull())
                         ss << "NULL";
                     else if (uaString.isEmpty())
@@ -608,34 +956,34 @@ namespace uaf
     // =============================================================================================
     void Variant::toSdk(OpcUa_Variant* destination) const
     {
-        if (isNativeUaf_)
+        if (isNativeUaf())
         {
             UaVariant uaVariant;
             if (type() == uaf::opcuatypes::NodeId)
             {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(NodeId, nodeId_)
+                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(NodeId, shared_->nodeId)
             }
             else if (type() == uaf::opcuatypes::Guid)
             {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(Guid, guid_)
+                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(Guid, shared_->guid)
             }
             else if (type() == uaf::opcuatypes::ExpandedNodeId)
             {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(ExpandedNodeId, expandedNodeId_)
+                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(ExpandedNodeId, shared_->expandedNodeId)
             }
             else if (type() == uaf::opcuatypes::QualifiedName)
             {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(QualifiedName, qualifiedName_)
+                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(QualifiedName, shared_->qualifiedName)
             }
             else if (type() == uaf::opcuatypes::ExtensionObject)
             {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF_WITH_DETACH(ExtensionObject, extensionObject_)
+                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF_WITH_DETACH(ExtensionObject, shared_->extensionObject)
             }
             uaVariant.copyTo(destination);
         }
         else
         {
-            uaVariant_.copyTo(destination);
+            sdkVariant().copyTo(destination);
         }
     }
 
@@ -644,7 +992,17 @@ namespace uaf
     // =============================================================================================
     void Variant::toSdk(UaVariant& uaVariant) const
     {
-    	uaVariant = uaVariant_;
+        if (isNativeUaf())
+        {
+            OpcUa_Variant opcUaVariant;
+            OpcUa_Variant_Initialize(&opcUaVariant);
+            toSdk(&opcUaVariant);
+            uaVariant.attach(&opcUaVariant);
+        }
+        else
+        {
+            uaVariant = sdkVariant();
+        }
     }
 
 
@@ -652,7 +1010,26 @@ namespace uaf
     // =============================================================================================
     void Variant::fromSdk(const UaVariant& uaVariant)
     {
-    	uaVariant_ = uaVariant;
+        assignSdk(*static_cast<const OpcUa_Variant*>(uaVariant));
+    }
+
+
+    // fromSdkWithDetach
+    // =============================================================================================
+    void Variant::fromSdkWithDetach(OpcUa_Variant& opcUaVariant)
+    {
+        if (opcUaVariant.ArrayType == OpcUa_VariantArrayType_Scalar)
+        {
+            clear();
+            uaVariant_.attach(&opcUaVariant);
+        }
+        else
+        {
+            newSharedSdkVariant().attach(&opcUaVariant);
+        }
+
+        // the contents are owned by the UaVariant now
+        OpcUa_Variant_Initialize(&opcUaVariant);
     }
 
 
@@ -731,14 +1108,7 @@ namespace uaf
     void Variant::clear()
     {
         uaVariant_.clear();
-        nodeId_.clear();
-        guid_.clear();
-        expandedNodeId_.clear();
-        qualifiedName_.clear();
-        extensionObject_.clear();
-        isNativeUaf_ = false;
-        dataTypeIfNativeUaf_ = opcuatypes::Null;
-        arrayTypeIfNativeUaf_ = OpcUa_VariantArrayType_Scalar;
+        releaseShared();
     }
 
 
@@ -746,10 +1116,10 @@ namespace uaf
     // =============================================================================================
     opcuatypes::OpcUaType Variant::type() const
     {
-        if (isNativeUaf_)
-            return dataTypeIfNativeUaf_;
+        if (isNativeUaf())
+            return shared_->dataTypeIfNativeUaf;
         else
-            return uaf::opcuatypes::fromSdkToUaf(uaVariant_.type());
+            return uaf::opcuatypes::fromSdkToUaf(sdkVariant().type());
     }
 
 
@@ -757,10 +1127,10 @@ namespace uaf
     // =============================================================================================
     bool Variant::isArray() const
     {
-        if (isNativeUaf_)
-            return arrayTypeIfNativeUaf_ == OpcUa_VariantArrayType_Array;
+        if (isNativeUaf())
+            return shared_->arrayTypeIfNativeUaf == OpcUa_VariantArrayType_Array;
         else
-            return (bool)(uaVariant_.isArray());
+            return (bool)(sdkVariant().isArray());
     }
 
 
@@ -768,26 +1138,26 @@ namespace uaf
     // =============================================================================================
     uint32_t Variant::arraySize() const
     {
-        if (isNativeUaf_)
+        if (isNativeUaf())
         {
             switch (type())
             {
                 case uaf::opcuatypes::NodeId:
-                    return nodeId_.size();
+                    return shared_->nodeId.size();
                 case uaf::opcuatypes::Guid:
-                    return guid_.size();
+                    return shared_->guid.size();
                 case uaf::opcuatypes::ExpandedNodeId:
-                    return expandedNodeId_.size();
+                    return shared_->expandedNodeId.size();
                 case uaf::opcuatypes::QualifiedName:
-                    return qualifiedName_.size();
+                    return shared_->qualifiedName.size();
                 case uaf::opcuatypes::ExtensionObject:
-                    return extensionObject_.size();
+                    return shared_->extensionObject.size();
                 default:
                     return -1;
             }
         }
         else
-            return uaVariant_.arraySize();
+            return sdkVariant().arraySize();
     }
 
 
@@ -795,22 +1165,30 @@ namespace uaf
     // =============================================================================================
     bool operator==(const Variant& object1, const Variant& object2)
     {
-        // first we test the most likely situation
-        if ( (!object1.isNativeUaf_) && (!object2.isNativeUaf_) )
+        // first we test the most likely situations: scalars, or copies sharing the same buffer
+        if (object1.shared_ == object2.shared_)
         {
             return object1.uaVariant_ == object2.uaVariant_;
         }
+        else if ( (!object1.isNativeUaf()) && (!object2.isNativeUaf()) )
+        {
+            return object1.sdkVariant() == object2.sdkVariant();
+        }
+        else if (object1.isNativeUaf() != object2.isNativeUaf())
+        {
+            return false;
+        }
         // else, test the whole lot
         else
         {
-            return    object1.uaVariant_ == object2.uaVariant_
-                   && object1.isNativeUaf_ == object2.isNativeUaf_
-                   && object1.arrayTypeIfNativeUaf_ == object2.arrayTypeIfNativeUaf_
-                   && object1.dataTypeIfNativeUaf_ == object2.dataTypeIfNativeUaf_
-                   && object1.expandedNodeId_ == object2.expandedNodeId_
-                   && object1.nodeId_ == object2.nodeId_
-                   && object1.guid_ == object2.guid_
-                   && object1.qualifiedName_ == object2.qualifiedName_;
+            const Variant::SharedData& data1 = *object1.shared_;
+            const Variant::SharedData& data2 = *object2.shared_;
+            return    data1.arrayTypeIfNativeUaf == data2.arrayTypeIfNativeUaf
+                   && data1.dataTypeIfNativeUaf == data2.dataTypeIfNativeUaf
+                   && data1.expandedNodeId == data2.expandedNodeId
+                   && data1.nodeId == data2.nodeId
+                   && data1.guid == data2.guid
+                   && data1.qualifiedName == data2.qualifiedName;
         }
     }
 
@@ -822,26 +1200,32 @@ namespace uaf
         return !(object1 == object2);
     }
 
-    // operator==
+    // operator<
     // =============================================================================================
     bool operator<(const Variant& object1, const Variant& object2)
     {
-        if (object1.uaVariant_ != object2.uaVariant_)
-            return object1.uaVariant_ < object2.uaVariant_;
-        else if (object1.isNativeUaf_ != object2.isNativeUaf_)
-            return object1.isNativeUaf_ < object2.isNativeUaf_;
-        else if (object1.arrayTypeIfNativeUaf_ != object2.arrayTypeIfNativeUaf_)
-            return object1.arrayTypeIfNativeUaf_ < object2.arrayTypeIfNativeUaf_;
-        else if (object1.dataTypeIfNativeUaf_ != object2.dataTypeIfNativeUaf_)
-            return object1.dataTypeIfNativeUaf_ < object2.dataTypeIfNativeUaf_;
-        else if (object1.expandedNodeId_ != object2.expandedNodeId_)
-            return object1.expandedNodeId_ < object2.expandedNodeId_;
-        else if (object1.nodeId_ != object2.nodeId_)
-            return object1.nodeId_ < object2.nodeId_;
-        else if (object1.guid_ != object2.guid_)
-            return object1.guid_ < object2.guid_;
+        if (object1.sdkVariant() != object2.sdkVariant())
+            return object1.sdkVariant() < object2.sdkVariant();
+        else if (object1.isNativeUaf() != object2.isNativeUaf())
+            return object1.isNativeUaf() < object2.isNativeUaf();
+        else if (!object1.isNativeUaf() || object1.shared_ == object2.shared_)
+            return false;
+
+        const Variant::SharedData& data1 = *object1.shared_;
+        const Variant::SharedData& data2 = *object2.shared_;
+
+        if (data1.arrayTypeIfNativeUaf != data2.arrayTypeIfNativeUaf)
+            return data1.arrayTypeIfNativeUaf < data2.arrayTypeIfNativeUaf;
+        else if (data1.dataTypeIfNativeUaf != data2.dataTypeIfNativeUaf)
+            return data1.dataTypeIfNativeUaf < data2.dataTypeIfNativeUaf;
+        else if (data1.expandedNodeId != data2.expandedNodeId)
+            return data1.expandedNodeId < data2.expandedNodeId;
+        else if (data1.nodeId != data2.nodeId)
+            return data1.nodeId < data2.nodeId;
+        else if (data1.guid != data2.guid)
+            return data1.guid < data2.guid;
         else
-            return object1.qualifiedName_ < object2.qualifiedName_;
+            return data1.qualifiedName < data2.qualifiedName;
     }
 
 
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <vector>
 #include <cctype>
+#include <cstring>
 #include <stdint.h>
 #include <stdio.h>
 #include <iostream>
@@ -61,6 +62,11 @@ namespace uaf
     * A variant can hold primitive types and some OPC UA related non-primitive types (such as a
     * NodeId).
     *
+    * Scalar values are stored inline. Arrays and native UAF values (NodeIds, QualifiedNames, ...)
+    * are stored in a reference counted buffer which is shared (and never modified) by all copies
+    * of the variant, so copying a variant does not copy its array. Setting a new value always
+    * allocates a new buffer, so the other copies are never affected.
+    *
     * @ingroup Util
     ***********************************************************************************************/
     class UAF_EXPORT Variant
@@ -80,6 +86,50 @@ namespace uaf
         Variant(const OpcUa_Variant &variant);
 
 
+        /**
+         * Construct a copy of another variant.
+         *
+         * Arrays and native UAF values are shared with the other variant, not copied.
+         */
+        Variant(const Variant& other);
+
+
+        /**
+         * Copy another variant.
+         *
+         * Arrays and native UAF values are shared with the other variant, not copied.
+         */
+        Variant& operator=(const Variant& other);
+
+
+#if !defined(SWIG) && __cplusplus >= 201103L
+        /**
+         * Move another variant into a new variant, leaving the other variant empty.
+         */
+        Variant(Variant&& other);
+
+
+        /**
+         * Move another variant into this variant, leaving the other variant empty.
+         */
+        Variant& operator=(Variant&& other);
+#endif
+
+
+        /**
+         * Destruct the variant.
+         */
+        ~Variant();
+
+
+        /**
+         * Swap the contents of two variants, without copying any array or native UAF value.
+         *
+         * @param other The variant to swap the contents with.
+         */
+        void swap(Variant& other);
+
+
         /**
          * Clear the variant.
          */
@@ -91,7 +141,7 @@ namespace uaf
          *
          * @return  True if empty.
          */
-        bool isNull() const { return (!isNativeUaf_) && ((bool)(uaVariant_.isEmpty())); }
+        bool isNull() const { return (shared_ == 0) && ((bool)(uaVariant_.isEmpty())); }
 
 
         /**
@@ -184,6 +234,68 @@ namespace uaf
         }
 
 
+        /**
+         * Set the variant to an array of a numeric type (Boolean, SByte, Byte, Int16, UInt16,
+         * Int32, UInt32, Int64, UInt64, Float or Double).
+         *
+         * The elements are copied in one go, instead of element by element.
+         *
+         * @param type      The numeric type of the elements.
+         * @param data      Pointer to the contiguous elements (in native byte order).
+         * @param length    The number of elements.
+         * @return          Good, or a WrongTypeError if the type is not numeric.
+         */
+        uaf::Status setNumericArray(uaf::opcuatypes::OpcUaType type, const void* data, uint32_t length);
+
+
+        /**
+         * Get a pointer to the contiguous elements of a numeric array (see setNumericArray()),
+         * without copying them.
+         *
+         * The pointer remains valid as long as the variant is not modified or destructed.
+         *
+         * @return  Pointer to the elements, or NULL if the variant is not a numeric array
+         *          (or an empty one).
+         */
+        const void* numericArrayData() const;
+
+
+        /**
+         * Get the size (in bytes) of a single element of a numeric type.
+         *
+         * @param type  The type.
+         * @return      The size of a single element, or 0 if the type is not numeric.
+         */
+        static std::size_t numericTypeSize(uaf::opcuatypes::OpcUaType type);
+
+
+#ifndef SWIG
+#define DECLARE_VARIANT_VIEW_METHOD(XXX, TYPE)                                                     \
+        /** Get a read-only view on the elements of a numeric array, without copying them.         \
+         *                                                                                         \
+         * The elements remain valid as long as the variant (or a copy of it) is not modified      \
+         * or destructed.                                                                          \
+         *                                                                                         \
+         * @param data      Pointer to the first element (NULL if the array is empty).             \
+         * @param length    Number of elements.                                                    \
+         * @return          Good, or a WrongTypeError if the variant is not an array of exactly    \
+         *                  this type (no conversions are done).                                   \
+         */                                                                                        \
+        uaf::Status view##XXX##Array(const TYPE*& data, uint32_t& length) const;
+
+        DECLARE_VARIANT_VIEW_METHOD(SByte   , int8_t)
+        DECLARE_VARIANT_VIEW_METHOD(Byte    , uint8_t)
+        DECLARE_VARIANT_VIEW_METHOD(Int16   , int16_t)
+        DECLARE_VARIANT_VIEW_METHOD(UInt16  , uint16_t)
+        DECLARE_VARIANT_VIEW_METHOD(Int32   , int32_t)
+        DECLARE_VARIANT_VIEW_METHOD(UInt32  , uint32_t)
+        DECLARE_VARIANT_VIEW_METHOD(Int64   , int64_t)
+        DECLARE_VARIANT_VIEW_METHOD(UInt64  , uint64_t)
+        DECLARE_VARIANT_VIEW_METHOD(Float   , float)
+        DECLARE_VARIANT_VIEW_METHOD(Double  , double)
+#endif
+
+
         /**
          * Update an OpcUa_Variant stack object.
          *
@@ -208,6 +320,16 @@ namespace uaf
         void fromSdk(const UaVariant& uaVariant);
 
 
+        /**
+         * Take over the contents of an OpcUa_Variant stack object, without copying them.
+         *
+         * The stack object is left empty (but it still needs to be cleared as usual).
+         *
+         * @param opcUaVariant  Stack object to take the contents from.
+         */
+        void fromSdkWithDetach(OpcUa_Variant& opcUaVariant);
+
+
         /**
          * Get a UTF-8 encoded string representation of the variant.
          *
@@ -251,22 +373,35 @@ namespace uaf
 
     private:
 
-        // internal SDK object - used for everything but the ones hereafter
+        // the reference counted buffer, shared by all copies of a variant (defined in variant.cpp)
+        struct SharedData;
+
+        // internal SDK object - used for scalars of all types except the native UAF ones
         UaVariant uaVariant_;
 
-        // variant types that must be stored as a native UAF instance
-        // (because these support namespace URIs and/or server URIs instead of only
-        //  namespace IDs and/or server IDs)
-        // We store them as vectors, so that they can also represent array types if necessary.
-        std::vector<uaf::NodeId> nodeId_;
-        std::vector<uaf::Guid> guid_;
-        std::vector<uaf::ExpandedNodeId> expandedNodeId_;
-        std::vector<uaf::QualifiedName> qualifiedName_;
-        std::vector<uaf::ExtensionObject> extensionObject_;
-
-        bool isNativeUaf_;
-        uaf::opcuatypes::OpcUaType dataTypeIfNativeUaf_;
-        OpcUa_Byte arrayTypeIfNativeUaf_;
+        // shared buffer - used for arrays of all types, and for the types that must be stored
+        // as a native UAF instance (because these support namespace URIs and/or server URIs
+        // instead of only namespace IDs and/or server IDs). NULL for scalars and empty variants.
+        SharedData* shared_;
+
+
+        // get the SDK object that holds the value (either the inline or the shared one)
+        const UaVariant& sdkVariant() const;
+
+        // does the variant hold a native UAF value?
+        bool isNativeUaf() const;
+
+        // release the shared buffer (if any)
+        void releaseShared();
+
+        // clear the variant and allocate a new shared buffer for an SDK array
+        UaVariant& newSharedSdkVariant();
+
+        // clear the variant and allocate a new shared buffer for a native UAF value
+        SharedData& newSharedNativeUaf(uaf::opcuatypes::OpcUaType type, OpcUa_Byte arrayType);
+
+        // clear the variant and copy an SDK variant (inline if scalar, shared if array)
+        void assignSdk(const OpcUa_Variant& opcUaVariant);
 
 
         /**
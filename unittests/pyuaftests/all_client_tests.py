@@ -22,11 +22,20 @@ ALL_MODULES = [ "client_client",
                 "client_setpublishingmode",
                 "client_browse",
                 "client_browsenext",
+                "client_crawl",
                 "client_historyreadrawmodified",
                 "client_connectionstatus",
                 "client_subscriptionstatus",
                 "client_keepalive",
                 "client_setmonitoringmode",
+                "client_deleteandmodifymonitoreditems",
+                "client_subscriptionsharding",
+                "client_notificationqueue",
+                "client_resolution",
+                "client_registernodes",
+                "client_snapshot",
+                "client_metrics",
+                "client_tracing",
                 "client_kwargs",
                 "client_structures",
                 "subscriptioninformation",
@@ -32,6 +32,18 @@ class ClientConstructorTest(unittest.TestCase):
         del c0
         del c1
         del c2
+    
+    
+    def test_client_Client_databaseFootprint(self):
+        c = pyuaf.client.Client("c")
+        footprint = c.databaseFootprint()
+        self.assertEqual( footprint.monitoredDataRequests , 0 )
+        self.assertEqual( footprint.monitoredEventsRequests , 0 )
+        self.assertEqual( footprint.clientHandles , 0 )
+        self.assertEqual( footprint.releasedClientHandles , 0 )
+        self.assertEqual( footprint.clientSubscriptionHandles , 0 )
+        self.assertTrue( footprint.totalBytes() > 0 )
+        del c
 
 
 if __name__ == '__main__':
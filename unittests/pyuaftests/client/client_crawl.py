@@ -0,0 +1,96 @@
+import pyuaf
+import time
+import thread
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+from pyuaf.util import Address, ExpandedNodeId
+from pyuaf.client.settings import CrawlSettings
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(CrawlTest)
+
+
+
+
+class CrawlTest(unittest.TestCase):
+    
+    
+    def setUp(self):
+        
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+    
+        self.client = pyuaf.client.Client(settings)
+        
+        serverUri    = ARGS.demo_server_uri
+        demoNsUri    = ARGS.demo_ns_uri
+        
+        self.address_Demo          = Address(ExpandedNodeId("Demo"               , demoNsUri, serverUri))
+        self.address_StaticScalar  = Address(ExpandedNodeId("Demo.Static.Scalar" , demoNsUri, serverUri))
+    
+    
+    def test_client_Client_crawl_with_callback(self):
+        
+        crawled = []
+        
+        def callback(sourceAddress, depth, references):
+            crawled.append((sourceAddress, depth, len(references)))
+        
+        settings = CrawlSettings()
+        settings.maxDepth = 1
+        settings.maxTargetsPerRequest = 3 # low, to force multiple batches
+        settings.maxRequestsInFlight = 2
+        
+        statistics = self.client.crawl(self.address_Demo, callback, settings)
+        
+        self.assertGreater( statistics.nodesBrowsed , 1 )
+        self.assertEqual( statistics.nodesBrowsed , len(crawled) )
+        self.assertLessEqual( statistics.maxDepthReached , 1 )
+        self.assertEqual( crawled[0][0] , self.address_Demo )
+        self.assertEqual( crawled[0][1] , 0 )
+        self.assertEqual( statistics.referencesReceived , sum([n for (_,_,n) in crawled]) )
+    
+    
+    def test_client_Client_crawl_does_not_visit_nodes_twice(self):
+        
+        # Demo.Static.Scalar is a child of Demo, so it should be browsed only once
+        statistics = self.client.crawl([self.address_Demo, self.address_StaticScalar, self.address_Demo])
+        
+        self.assertGreaterEqual( statistics.duplicatesSkipped , 2 )
+        self.assertEqual( statistics.nodesFailed , 0 )
+    
+    
+    def test_client_Client_crawl_maxNodes(self):
+        
+        settings = CrawlSettings()
+        settings.maxNodes = 5
+        
+        statistics = self.client.crawl(self.address_Demo, None, settings)
+        
+        self.assertEqual( statistics.nodesBrowsed , 5 )
+        self.assertTrue( statistics.truncated )
+    
+    
+    def tearDown(self):
+        # delete the client instances manually (now!) instead of letting them be garbage collected 
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
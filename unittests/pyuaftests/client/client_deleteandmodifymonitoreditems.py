@@ -0,0 +1,200 @@
+import pyuaf
+import time
+import threading
+import sys
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+
+from pyuaf.util import NodeId, Address, ExpandedNodeId, BrowsePath, \
+                       RelativePathElement, QualifiedName, opcuaidentifiers
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(ClientDeleteAndModifyMonitoredItemsTest)
+
+
+
+# define a TestClass with a callback
+class TestClass:
+    def __init__(self):
+        self.noOfSuccessFullyReceivedNotifications = 0
+        self.lock = threading.Lock() 
+    
+    def myCallback(self, notification):
+        self.lock.acquire()
+        self.noOfSuccessFullyReceivedNotifications += 1
+        self.lock.release()
+
+
+
+
+class ClientDeleteAndModifyMonitoredItemsTest(unittest.TestCase):
+    
+    
+    def setUp(self):
+        
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+    
+        self.client = pyuaf.client.Client(settings)
+
+        
+        serverUri    = ARGS.demo_server_uri
+        demoNsUri    = ARGS.demo_ns_uri
+        plcOpenNsUri = "http://PLCopen.org/OpcUa/IEC61131-3/"
+        
+        
+        self.address_Demo            = Address(ExpandedNodeId("Demo", demoNsUri, serverUri))
+        self.address_StartSimulation = Address(self.address_Demo, [RelativePathElement(QualifiedName("StartSimulation", demoNsUri))])
+        self.address_StopSimulation  = Address(self.address_Demo, [RelativePathElement(QualifiedName("StopSimulation", demoNsUri))])
+        self.address_Scalar          = Address(self.address_Demo, [RelativePathElement(QualifiedName("Dynamic", demoNsUri)),
+                                                                   RelativePathElement(QualifiedName("Scalar", demoNsUri))] )
+        self.address_Byte            = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Byte", demoNsUri))] )
+        self.address_Int32           = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Int32", demoNsUri))] )
+        self.address_Int64           = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Int64", demoNsUri))] )
+        self.address_Float           = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Float", demoNsUri))] )
+        self.address_Double          = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Double", demoNsUri))] )
+        
+        # start the simulation (otherwise the dynamic variables won't change)
+        self.client.call(self.address_Demo, self.address_StartSimulation)
+    
+    
+    def test_client_Client_deleteMonitoredItems(self):
+        
+        t0 = TestClass()
+        t1 = TestClass()
+        res = self.client.createMonitoredData([self.address_Double, self.address_Int64], 
+                                              notificationCallbacks=[t0.myCallback, t1.myCallback])
+        
+        # make sure there was no error
+        self.assertTrue( res.overallStatus.isGood() )
+        
+        clientHandles = [ target.clientHandle for target in res.targets ]
+        
+        # after a few seconds we should AT LEAST have received some notifications of both items
+        t_timeout = time.time() + 5.0
+        while time.time() < t_timeout \
+           and (t0.noOfSuccessFullyReceivedNotifications < 2 \
+                or t1.noOfSuccessFullyReceivedNotifications < 2):
+            time.sleep(0.01)
+        
+        self.assertGreaterEqual( t0.noOfSuccessFullyReceivedNotifications , 2 )
+        self.assertGreaterEqual( t1.noOfSuccessFullyReceivedNotifications , 2 )
+        
+        # now delete the second monitored item, and an unknown one
+        statuses = self.client.deleteMonitoredItems([clientHandles[1], 123456789])
+        
+        self.assertTrue( statuses[0].isGood() )
+        self.assertTrue( statuses[1].isNotGood() )
+        
+        # the deleted monitored item should be unknown now
+        self.assertRaises(pyuaf.util.errors.UnknownClientHandleError, 
+                          self.client.monitoredItemInformation, 
+                          clientHandles[1])
+        
+        # the first monitored item should continue to publish notifications, the second one not
+        time.sleep(0.5) # wait for notifications that were already on their way
+        noOfNotifications0 = t0.noOfSuccessFullyReceivedNotifications
+        noOfNotifications1 = t1.noOfSuccessFullyReceivedNotifications
+        
+        time.sleep(2)
+        
+        self.assertGreater( t0.noOfSuccessFullyReceivedNotifications, noOfNotifications0 )
+        self.assertEqual( t1.noOfSuccessFullyReceivedNotifications, noOfNotifications1 )
+    
+    
+    def test_client_Client_deleteMonitoredItems_duplicateClientHandles(self):
+        
+        res = self.client.createMonitoredData([self.address_Double, self.address_Int64])
+        
+        # make sure there was no error
+        self.assertTrue( res.overallStatus.isGood() )
+        
+        clientHandles = [ target.clientHandle for target in res.targets ]
+        
+        # delete the first monitored item twice in the same request
+        statuses = self.client.deleteMonitoredItems([clientHandles[0], clientHandles[0]])
+        
+        self.assertEqual( len(statuses), 2 )
+        self.assertTrue( statuses[0].isGood() )
+        self.assertTrue( statuses[1].isGood() )
+        
+        # the deleted monitored item should be unknown now, the other one not
+        self.assertRaises(pyuaf.util.errors.UnknownClientHandleError, 
+                          self.client.monitoredItemInformation, 
+                          clientHandles[0])
+        self.client.monitoredItemInformation(clientHandles[1])
+    
+    
+    def test_client_Client_modifyMonitoredItems(self):
+        
+        t0 = TestClass()
+        res = self.client.createMonitoredData([self.address_Double, self.address_Int64], 
+                                              notificationCallbacks=[t0.myCallback, t0.myCallback])
+        
+        # make sure there was no error
+        self.assertTrue( res.overallStatus.isGood() )
+        
+        clientHandles = [ target.clientHandle for target in res.targets ]
+        
+        # now modify the sampling interval and queue size of both monitored items
+        settings = pyuaf.client.settings.MonitoredItemSettings()
+        settings.samplingIntervalSec = 0.5
+        settings.queueSize = 3
+        
+        statuses = self.client.modifyMonitoredItems(clientHandles, settings)
+        
+        for status in statuses:
+            self.assertTrue( status.isGood() )
+        
+        # the monitored items should have the new settings
+        for clientHandle in clientHandles:
+            info = self.client.monitoredItemInformation(clientHandle)
+            self.assertEqual(info.monitoredItemState, pyuaf.client.monitoreditemstates.Created)
+            self.assertAlmostEqual(info.settings.samplingIntervalSec, 0.5)
+            self.assertEqual(info.settings.queueSize, 3)
+        
+        # event settings cannot be applied to monitored data items
+        eventSettings = pyuaf.client.settings.MonitoredItemSettings(
+                                pyuaf.client.settings.MonitoredItemSettings.Event)
+        statuses = self.client.modifyMonitoredItems(clientHandles, eventSettings)
+        
+        for status in statuses:
+            self.assertTrue( status.isNotGood() )
+        
+        # notifications should still be received
+        noOfNotifications0 = t0.noOfSuccessFullyReceivedNotifications
+        
+        t_timeout = time.time() + 5.0
+        while time.time() < t_timeout \
+           and t0.noOfSuccessFullyReceivedNotifications <= noOfNotifications0:
+            time.sleep(0.01)
+        
+        self.assertGreater( t0.noOfSuccessFullyReceivedNotifications , noOfNotifications0 )
+        
+        
+    def tearDown(self):
+        # stop the simulation
+        self.client.call(self.address_Demo, self.address_StopSimulation)
+        
+        # delete the client instances manually (now!) instead of letting them be garbage collected 
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -0,0 +1,99 @@
+import pyuaf
+import os
+import time
+import unittest
+from pyuaf.util.unittesting import parseArgs, tempFileName, demoClientSettings, demoScalarAddresses
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+
+    return unittest.TestLoader().loadTestsFromTestCase(ClientMetricsTest)
+
+
+
+
+class ClientMetricsTest(unittest.TestCase):
+
+
+    def setUp(self):
+
+        self.fileName  = tempFileName("pyuaf_client_metrics.prom")
+        self.settings  = demoClientSettings(ARGS)
+        self.addresses = demoScalarAddresses(ARGS)
+        self.serverUri = ARGS.demo_server_uri
+
+
+    def test_client_Client_metrics_services(self):
+
+        client = pyuaf.client.Client(self.settings)
+
+        for i in xrange(5):
+            res = client.read(self.addresses)
+            self.assertTrue( res.overallStatus.isGood() )
+
+        metrics = client.metrics()
+
+        reads = [ s for s in metrics.services if s.serverUri == self.serverUri and s.service == "Read" ]
+        self.assertEqual( len(reads), 1 )
+        self.assertEqual( reads[0].invocations, 5 )
+        self.assertEqual( reads[0].failures, 0 )
+        self.assertEqual( reads[0].inFlight, 0 )
+        self.assertEqual( reads[0].targets, 5 * len(self.addresses) )
+        self.assertEqual( sum(reads[0].latencyBucketCounts), 5 )
+        self.assertTrue( reads[0].meanLatencySec() > 0.0 )
+
+        servers = [ s for s in metrics.servers if s.serverUri == self.serverUri ]
+        self.assertEqual( len(servers), 1 )
+        self.assertTrue( servers[0].connectionAttempts >= 1 )
+
+        # the addresses are resolved only once, so the next reads hit the address cache
+        self.assertTrue( metrics.addressCacheHits > 0 )
+
+        text = metrics.toPrometheus()
+        self.assertTrue( 'uaf_service_latency_seconds_count{server_uri="%s",service="Read"} 5'
+                         %self.serverUri in text )
+        del client
+
+
+    def test_client_Client_metrics_periodic_export(self):
+
+        self.settings.metricsFileName = self.fileName
+        self.settings.metricsIntervalSec = 1.0
+
+        client = pyuaf.client.Client(self.settings)
+
+        received = []
+        client.registerMetricsCallback(received.append)
+
+        res = client.read(self.addresses)
+        self.assertTrue( res.overallStatus.isGood() )
+
+        t_timeout = time.time() + 5.0
+        while len(received) == 0 and time.time() < t_timeout:
+            time.sleep(0.1)
+
+        self.assertTrue( len(received) > 0 )
+        self.assertTrue( os.path.exists(self.fileName) )
+
+        f = open(self.fileName, "r")
+        text = f.read()
+        f.close()
+        self.assertTrue( "uaf_service_latency_seconds_bucket" in text )
+        del client
+
+
+    def tearDown(self):
+        if os.path.exists(self.fileName):
+            os.remove(self.fileName)
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -0,0 +1,164 @@
+import pyuaf
+import time
+import threading
+import sys
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+
+from pyuaf.util import NodeId, Address, ExpandedNodeId, BrowsePath, \
+                       RelativePathElement, QualifiedName, opcuaidentifiers
+from pyuaf.client import overflowpolicies
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(ClientNotificationQueueTest)
+
+
+
+class SlowClient(pyuaf.client.Client):
+
+    def __init__(self, settings):
+        pyuaf.client.Client.__init__(self, settings)
+        self.noOfReceivedNotifications = 0
+        self.threadNames = set()
+        self.lock = threading.Lock()
+            
+    def dataChangesReceived(self, notifications):
+        # a slow callback, so that the queue fills up
+        time.sleep(0.2)
+        self.lock.acquire()
+        self.noOfReceivedNotifications += len(notifications)
+        self.threadNames.add(threading.current_thread().name)
+        self.lock.release()
+
+
+
+
+class ClientNotificationQueueTest(unittest.TestCase):
+    
+    
+    def setUp(self):
+        
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+        
+        # a tiny queue
+        settings.notificationQueueCapacity = 2
+        settings.notificationQueueOverflowPolicy = overflowpolicies.Coalesce
+        
+        self.client = SlowClient(settings)
+        
+        serverUri    = ARGS.demo_server_uri
+        demoNsUri    = ARGS.demo_ns_uri
+        
+        self.address_Demo            = Address(ExpandedNodeId("Demo", demoNsUri, serverUri))
+        self.address_StartSimulation = Address(self.address_Demo, [RelativePathElement(QualifiedName("StartSimulation", demoNsUri))])
+        self.address_StopSimulation  = Address(self.address_Demo, [RelativePathElement(QualifiedName("StopSimulation", demoNsUri))])
+        self.address_Scalar          = Address(self.address_Demo, [RelativePathElement(QualifiedName("Dynamic", demoNsUri)),
+                                                          RelativePathElement(QualifiedName("Scalar", demoNsUri))] )
+        self.addresses = [ Address(self.address_Scalar, [RelativePathElement(QualifiedName(name, demoNsUri))] )
+                           for name in ["Byte", "Int32", "Int64", "Float", "Double"] ]
+        
+        # start the simulation (otherwise the dynamic variables won't change)
+        self.client.call(self.address_Demo, self.address_StartSimulation)
+    
+    
+    def waitForNotifications(self, n):
+        t_timeout = time.time() + 5.0
+        while time.time() < t_timeout and self.client.noOfReceivedNotifications < n:
+            time.sleep(0.01)
+    
+    
+    def test_client_Client_notificationQueueStatistics_without_queue(self):
+        settings = self.client.clientSettings()
+        settings.notificationQueueCapacity = 0
+        self.client.setClientSettings(settings)
+        
+        self.client.createMonitoredData(self.addresses)
+        self.waitForNotifications(2)
+        
+        self.assertGreaterEqual( self.client.noOfReceivedNotifications, 2 )
+        
+        # the notifications were not queued
+        stats = self.client.notificationQueueStatistics()
+        self.assertEqual( stats.capacity, 0 )
+        self.assertEqual( stats.enqueued, 0 )
+    
+    
+    def test_client_Client_notificationQueueStatistics_coalesce(self):
+        self.client.createMonitoredData(self.addresses)
+        self.waitForNotifications(10)
+        
+        self.assertGreaterEqual( self.client.noOfReceivedNotifications, 10 )
+        
+        stats = self.client.notificationQueueStatistics()
+        self.assertEqual( stats.capacity, 2 )
+        self.assertLessEqual( stats.queueDepth, 2 )
+        self.assertLessEqual( stats.maxQueueDepth, 2 )
+        self.assertGreaterEqual( stats.delivered, 10 )
+        self.assertEqual( stats.blocked, 0 )
+        
+        # the callback is slower than the server, so the queue overflowed
+        self.assertGreater( stats.coalesced + stats.dropped, 0 )
+        
+        # the callbacks are not called by the main thread
+        self.assertFalse( threading.current_thread().name in self.client.threadNames )
+    
+    
+    def test_client_Client_notificationQueueStatistics_block(self):
+        settings = self.client.clientSettings()
+        settings.notificationQueueOverflowPolicy = overflowpolicies.Block
+        self.client.setClientSettings(settings)
+        
+        self.client.createMonitoredData(self.addresses)
+        self.waitForNotifications(10)
+        
+        stats = self.client.notificationQueueStatistics()
+        self.assertGreaterEqual( stats.delivered, 10 )
+        self.assertEqual( stats.dropped, 0 )
+        self.assertEqual( stats.coalesced, 0 )
+    
+    
+    def test_client_Client_notificationQueueStatistics_block_batchLargerThanCapacity(self):
+        settings = self.client.clientSettings()
+        settings.notificationQueueOverflowPolicy = overflowpolicies.Block
+        self.client.setClientSettings(settings)
+        
+        # the initial values of 20 monitored items arrive in a single publish response, which
+        # holds 10 times more notifications than the queue can hold
+        self.client.createMonitoredData(self.addresses * 4)
+        self.waitForNotifications(20)
+        
+        self.assertGreaterEqual( self.client.noOfReceivedNotifications, 20 )
+        
+        stats = self.client.notificationQueueStatistics()
+        self.assertGreater( stats.blocked, 0 )
+        self.assertGreaterEqual( stats.delivered, 20 )
+        self.assertEqual( stats.dropped, 0 )
+    
+    
+    def tearDown(self):
+        # stop the simulation
+        self.client.call(self.address_Demo, self.address_StopSimulation)
+        
+        # delete the client instances manually (now!) instead of letting them be garbage collected 
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
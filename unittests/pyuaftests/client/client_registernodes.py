@@ -0,0 +1,132 @@
+import pyuaf
+import time
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+
+from pyuaf.util import NodeId, Address, ExpandedNodeId, \
+                       RelativePathElement, QualifiedName
+from pyuaf.util import primitives
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+
+    return unittest.TestLoader().loadTestsFromTestCase(ClientRegisterNodesTest)
+
+
+
+
+class ClientRegisterNodesTest(unittest.TestCase):
+
+
+    def setUp(self):
+
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+
+        self.client = pyuaf.client.Client(settings)
+
+        serverUri    = ARGS.demo_server_uri
+        demoNsUri    = ARGS.demo_ns_uri
+
+        self.address_Demo   = Address(ExpandedNodeId("Demo", demoNsUri, serverUri))
+        self.address_Scalar = Address(self.address_Demo, [RelativePathElement(QualifiedName("Dynamic", demoNsUri)),
+                                                          RelativePathElement(QualifiedName("Scalar", demoNsUri))] )
+        self.address_Static = Address(self.address_Demo, [RelativePathElement(QualifiedName("Static", demoNsUri)),
+                                                          RelativePathElement(QualifiedName("Scalar", demoNsUri))] )
+        self.address_Int32  = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Int32", demoNsUri))] )
+        self.address_Double = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Double", demoNsUri))] )
+        self.address_UInt32 = Address(self.address_Static, [RelativePathElement(QualifiedName("UInt32", demoNsUri))] )
+
+
+    def test_client_Client_registerNodes_read(self):
+
+        handle = self.client.registerNodes([self.address_Int32, self.address_Double])
+
+        res = self.client.read(handle)
+
+        self.assertTrue( res.overallStatus.isGood() )
+        self.assertEqual( len(res.targets), 2 )
+        self.assertTrue( isinstance(res.targets[0].data, primitives.Int32) )
+        self.assertTrue( isinstance(res.targets[1].data, primitives.Double) )
+
+        self.client.unregisterNodes(handle)
+
+
+    def test_client_Client_registerNodes_write(self):
+
+        handle = self.client.registerNodes([self.address_UInt32])
+
+        res = self.client.write(handle, [primitives.UInt32(12345)])
+        self.assertTrue( res.overallStatus.isGood() )
+
+        res = self.client.read(handle)
+        self.assertEqual( res.targets[0].data.value, 12345 )
+
+        self.client.unregisterNodes(handle)
+
+
+    def test_client_Client_registerNodes_twice(self):
+
+        # the same node may be registered by several handles
+        handle1 = self.client.registerNodes([self.address_Int32])
+        handle2 = self.client.registerNodes([self.address_Int32])
+        self.assertNotEqual( handle1, handle2 )
+
+        # releasing one handle doesn't affect the other one
+        self.client.unregisterNodes(handle1)
+
+        res = self.client.read(handle2)
+        self.assertTrue( res.overallStatus.isGood() )
+
+        self.client.unregisterNodes(handle2)
+
+
+    def test_client_Client_unregisterNodes_unknown_handle(self):
+
+        handle = self.client.registerNodes([self.address_Int32])
+        self.client.unregisterNodes(handle)
+
+        self.assertRaises(pyuaf.util.errors.UnknownRegisteredNodesHandleError,
+                          self.client.unregisterNodes, handle)
+        self.assertRaises(pyuaf.util.errors.UnknownRegisteredNodesHandleError,
+                          self.client.read, handle)
+
+
+    def test_client_Client_registerNodes_after_disconnection(self):
+
+        handle = self.client.registerNodes([self.address_Int32])
+
+        res = self.client.read(handle)
+        self.assertTrue( res.overallStatus.isGood() )
+
+        # disconnect the session: the nodes can still be read (by their original NodeIds)
+        clientConnectionId = res.targets[0].clientConnectionId
+        self.client.manuallyDisconnect(clientConnectionId)
+
+        res = self.client.read(handle)
+        self.assertTrue( res.overallStatus.isGood() )
+
+        self.client.unregisterNodes(handle)
+
+
+    def tearDown(self):
+        # delete the client instances manually (now!) instead of letting them be garbage collected
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -0,0 +1,124 @@
+import pyuaf
+import time
+import threading
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+
+from pyuaf.util import NodeId, Address, ExpandedNodeId, \
+                       RelativePathElement, QualifiedName
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+
+    return unittest.TestLoader().loadTestsFromTestCase(ClientResolutionTest)
+
+
+
+
+class ClientResolutionTest(unittest.TestCase):
+
+
+    def setUp(self):
+
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+
+        self.client = pyuaf.client.Client(settings)
+
+        serverUri    = ARGS.demo_server_uri
+        self.demoNsUri = ARGS.demo_ns_uri
+
+        self.address_Demo   = Address(ExpandedNodeId("Demo", self.demoNsUri, serverUri))
+        self.address_Scalar = Address(self.address_Demo, [RelativePathElement(QualifiedName("Dynamic", self.demoNsUri)),
+                                                          RelativePathElement(QualifiedName("Scalar", self.demoNsUri))] )
+
+
+    def scalar(self, name):
+        return Address(self.address_Scalar, [RelativePathElement(QualifiedName(name, self.demoNsUri))] )
+
+
+    def test_client_Client_resolve_duplicate_relative_paths(self):
+
+        # many targets with the same starting address and the same relative paths
+        addresses = [ self.scalar("Int32") for i in xrange(100) ] \
+                  + [ self.scalar("Double") for i in xrange(100) ]
+
+        res = self.client.read(addresses)
+
+        self.assertTrue( res.overallStatus.isGood() )
+        for target in res.targets:
+            self.assertTrue( target.status.isGood() )
+
+        self.assertTrue( isinstance(res.targets[0].data, pyuaf.util.primitives.Int32) )
+        self.assertTrue( isinstance(res.targets[-1].data, pyuaf.util.primitives.Double) )
+
+
+    def test_client_Client_resolve_concurrently(self):
+
+        addresses = [ self.scalar(name) for name in ["Byte", "Int32", "Int64", "Float", "Double"] ]
+        statuses = []
+        lock = threading.Lock()
+
+        def readAddresses():
+            res = self.client.read(addresses)
+            with lock:
+                statuses.extend([ target.status.isGood() for target in res.targets ])
+
+        threads = [ threading.Thread(target=readAddresses) for i in xrange(10) ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual( len(statuses), 10 * len(addresses) )
+        self.assertTrue( all(statuses) )
+
+
+    def test_client_Client_resolve_remembers_failures(self):
+
+        broken = self.scalar("ThisNodeDoesNotExist")
+
+        res1 = self.client.read([broken, self.scalar("Int32")])
+        self.assertTrue( res1.targets[0].status.isBad() )
+        self.assertTrue( res1.targets[1].status.isGood() )
+
+        # the failure is remembered, so the same status is reported (without asking the server)
+        res2 = self.client.read([broken, self.scalar("Int32")])
+        self.assertEqual( res2.targets[0].status.statusCode, res1.targets[0].status.statusCode )
+        self.assertTrue( res2.targets[1].status.isGood() )
+
+
+    def test_client_Client_resolve_without_remembering_failures(self):
+
+        settings = self.client.clientSettings()
+        settings.failedResolutionCacheTimeSec = 0.0
+        self.client.setClientSettings(settings)
+
+        broken = self.scalar("ThisNodeDoesNotExist")
+
+        for i in xrange(2):
+            res = self.client.read([broken])
+            self.assertTrue( res.targets[0].status.isBad() )
+
+
+    def tearDown(self):
+        # delete the client instances manually (now!) instead of letting them be garbage collected
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
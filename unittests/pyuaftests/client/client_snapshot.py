@@ -0,0 +1,73 @@
+import pyuaf
+import os
+import unittest
+from pyuaf.util.unittesting import parseArgs, tempFileName, demoClientSettings, demoScalarAddresses
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+
+    return unittest.TestLoader().loadTestsFromTestCase(ClientSnapshotTest)
+
+
+
+
+class ClientSnapshotTest(unittest.TestCase):
+
+
+    def setUp(self):
+
+        self.fileName  = tempFileName("pyuaf_client_snapshot.bin")
+        self.settings  = demoClientSettings(ARGS)
+        self.addresses = demoScalarAddresses(ARGS)
+        self.settings.snapshotFileName = self.fileName
+
+
+    def test_client_Client_snapshot_warm_start(self):
+
+        client = pyuaf.client.Client(self.settings)
+        res = client.read(self.addresses)
+        self.assertTrue( res.overallStatus.isGood() )
+
+        # the snapshot is written when the client is destroyed
+        del client
+        self.assertTrue( os.path.exists(self.fileName) )
+
+        # a new client starts with the resolved addresses of the snapshot
+        client = pyuaf.client.Client(self.settings)
+        self.assertTrue( client.databaseFootprint().cachedAddresses >= len(self.addresses) )
+
+        res = client.read(self.addresses)
+        self.assertTrue( res.overallStatus.isGood() )
+        del client
+
+
+    def test_client_Client_snapshot_corrupt_file(self):
+
+        f = open(self.fileName, "wb")
+        f.write("this is not a snapshot")
+        f.close()
+
+        # a corrupt snapshot is ignored, so the client starts cold
+        client = pyuaf.client.Client(self.settings)
+        self.assertEqual( client.databaseFootprint().cachedAddresses, 0 )
+
+        res = client.read(self.addresses)
+        self.assertTrue( res.overallStatus.isGood() )
+        del client
+
+
+    def tearDown(self):
+        if os.path.exists(self.fileName):
+            os.remove(self.fileName)
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -10,6 +10,7 @@ from pyuaf.client           import Client
 from pyuaf.client.settings  import ClientSettings, SessionSettings
 from pyuaf.util             import Address, NodeId, ExtensionObject, SdkStatus, RelativePathElement, BrowsePath, ExpandedNodeId
 from pyuaf.util             import GenericStructureValue, GenericStructureVector, GenericUnionValue
+from pyuaf.util             import StructureCodec, StructureRecords, ExtensionObjectVector
 from pyuaf.util             import primitives
 from pyuaf.util             import opcuaidentifiers, attributeids, opcuatypes, structurefielddatatypes
 from pyuaf.util.errors      import UafError
@@ -100,6 +101,55 @@ class ClientStructuresTest(unittest.TestCase):
         self.assertEqual( statuscode, 0 )
         
         
+    def test_client_Client_structureCodec(self):
+        
+        # read the structure and its datatype
+        result = self.client.read( [self.address_vector] )
+        extensionObject = result.targets[0].data
+        
+        result = self.client.read( [self.address_vector] , attributeId = attributeids.DataType)
+        dataTypeId = result.targets[0].data
+        
+        # get the compiled definition (twice: the second time it comes from the cache)
+        codec = self.client.structureCodec(dataTypeId)
+        self.assertFalse( codec.isNull() )
+        self.assertEqual( codec.fieldIndex('X'), 0 )
+        self.assertEqual( codec.fieldIndex('DoesNotExist'), -1 )
+        self.assertEqual( codec.fieldCount(), self.client.structureCodec(dataTypeId, ARGS.demo_server_uri).fieldCount() )
+        
+        # decode a number of ExtensionObjects into flat records
+        extensionObjects = ExtensionObjectVector()
+        extensionObjects.append(extensionObject)
+        extensionObjects.append(extensionObject)
+        
+        records = StructureRecords()
+        status = codec.decode(extensionObjects, records)
+        self.assertTrue( status.isGood() )
+        self.assertEqual( records.recordCount(), 2 )
+        self.assertEqual( records.fieldCount(), codec.fieldCount() )
+        self.assertEqual( records.fieldNames[0], 'X' )
+        self.assertEqual( records.opcUaStatusCodes[1], 0 )
+        
+        structureValue = GenericStructureValue(extensionObject, codec.definition())
+        value, statuscode = structureValue.value(0)
+        self.assertEqual( records.value(1, 0), value )
+        self.assertEqual( len(records.column('X')), 2 )
+        
+        # change a field and encode the records again
+        records.values[0] = primitives.Double(0.2)
+        newExtensionObjects = ExtensionObjectVector()
+        status = codec.encode(records, newExtensionObjects)
+        self.assertTrue( status.isGood() )
+        
+        result = self.client.write( [self.address_vector], [newExtensionObjects[0]] )
+        self.assertTrue( result.overallStatus.isGood() )
+        
+        result = self.client.read( [self.address_vector] )
+        structureValue = GenericStructureValue(result.targets[0].data, codec.definition())
+        value, statuscode = structureValue.value(0)
+        self.assertEqual( value, primitives.Double(0.2) )
+        
+        
     def test_client_Client_unions(self):
         # read the structure
         result = self.client.read( [self.address_union] )
@@ -0,0 +1,111 @@
+import pyuaf
+import time
+import sys
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+
+from pyuaf.util import NodeId, Address, ExpandedNodeId, BrowsePath, \
+                       RelativePathElement, QualifiedName, opcuaidentifiers
+from pyuaf.client.requests import CreateMonitoredDataRequest, CreateMonitoredDataRequestTarget
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+
+    return unittest.TestLoader().loadTestsFromTestCase(ClientSubscriptionShardingTest)
+
+
+
+
+class ClientSubscriptionShardingTest(unittest.TestCase):
+
+
+    def setUp(self):
+
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+
+        # spread the monitored items over subscriptions of max. 2 items
+        settings.shardSubscriptions = True
+        settings.maxMonitoredItemsPerSubscription = 2
+
+        self.client = pyuaf.client.Client(settings)
+
+        serverUri    = ARGS.demo_server_uri
+        demoNsUri    = ARGS.demo_ns_uri
+
+        self.address_Demo   = Address(ExpandedNodeId("Demo", demoNsUri, serverUri))
+        self.address_Scalar = Address(self.address_Demo, [RelativePathElement(QualifiedName("Dynamic", demoNsUri)),
+                                                          RelativePathElement(QualifiedName("Scalar", demoNsUri))] )
+        self.addresses = [ Address(self.address_Scalar, [RelativePathElement(QualifiedName(name, demoNsUri))] )
+                           for name in ["Byte", "Int32", "Int64", "Float", "Double"] ]
+
+
+    def createRequest(self, samplingIntervalSec):
+        targets = []
+        for address in self.addresses:
+            target = CreateMonitoredDataRequestTarget()
+            target.address = address
+            target.samplingIntervalSec = samplingIntervalSec
+            targets.append(target)
+        return CreateMonitoredDataRequest(targets)
+
+
+    def test_client_Client_shardSubscriptions_maxMonitoredItemsPerSubscription(self):
+
+        res = self.client.processRequest(self.createRequest(0.0))
+
+        self.assertTrue( res.overallStatus.isGood() )
+
+        # 5 items with max. 2 items per subscription should result in 3 subscriptions
+        clientSubscriptionHandles = set([ target.clientSubscriptionHandle for target in res.targets ])
+        self.assertEqual( len(clientSubscriptionHandles), 3 )
+
+        # the monitored item information should point to the same subscriptions
+        for target in res.targets:
+            info = self.client.monitoredItemInformation(target.clientHandle)
+            self.assertEqual( info.clientSubscriptionHandle, target.clientSubscriptionHandle )
+
+        # the last subscription still has room for a new item, so no subscription is added
+        res2 = self.client.createMonitoredData([self.addresses[0]])
+        self.assertTrue( res2.overallStatus.isGood() )
+        self.assertTrue( res2.targets[0].clientSubscriptionHandle in clientSubscriptionHandles )
+
+        # now all subscriptions are full, so a new one is added
+        res3 = self.client.createMonitoredData([self.addresses[1]])
+        self.assertTrue( res3.overallStatus.isGood() )
+        self.assertFalse( res3.targets[0].clientSubscriptionHandle in clientSubscriptionHandles )
+
+
+    def test_client_Client_shardSubscriptions_shardBySamplingInterval(self):
+
+        res = self.client.processRequest(self.createRequest(5.0))
+
+        self.assertTrue( res.overallStatus.isGood() )
+
+        # the slow items should be hosted by subscriptions that publish at the sampling interval
+        for target in res.targets:
+            info = self.client.subscriptionInformation(target.clientSubscriptionHandle)
+            self.assertAlmostEqual( info.subscriptionSettings.publishingIntervalSec, 5.0 )
+
+
+    def tearDown(self):
+        # delete the client instances manually (now!) instead of letting them be garbage collected
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
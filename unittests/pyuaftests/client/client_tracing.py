@@ -0,0 +1,94 @@
+import pyuaf
+import os
+import json
+import unittest
+from pyuaf.util.unittesting import parseArgs, tempFileName, demoClientSettings, demoScalarAddresses
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+
+    return unittest.TestLoader().loadTestsFromTestCase(ClientTracingTest)
+
+
+
+
+class ClientTracingTest(unittest.TestCase):
+
+
+    def setUp(self):
+
+        self.fileName  = tempFileName("pyuaf_client_trace.json")
+        self.settings  = demoClientSettings(ARGS)
+        self.addresses = demoScalarAddresses(ARGS)
+
+
+    def test_client_Client_tracing_disabled(self):
+
+        client = pyuaf.client.Client(self.settings)
+
+        res = client.read(self.addresses)
+        self.assertTrue( res.overallStatus.isGood() )
+        self.assertFalse( res.trace.isEnabled() )
+        self.assertEqual( len(res.trace.spans), 0 )
+        del client
+
+
+    def test_client_Client_tracing_stages(self):
+
+        self.settings.traceRequests = True
+        client = pyuaf.client.Client(self.settings)
+
+        res = client.read(self.addresses)
+        self.assertTrue( res.overallStatus.isGood() )
+        self.assertTrue( res.trace.isEnabled() )
+        self.assertEqual( res.trace.service, "Read" )
+        self.assertEqual( res.trace.requestHandle, res.requestHandle )
+
+        stages = set([ span.stage for span in res.trace.spans ])
+        for stage in ["processRequest", "resolve", "invokeRequest", "acquireSession",
+                      "invokeService", "toSdk", "sdkCall", "fromSdk", "copyToResult"]:
+            self.assertTrue( stage in stages, stage )
+
+        # the stages are part of the whole processing of the request
+        self.assertTrue( res.trace.durationSec("sdkCall") <= res.trace.durationSec("processRequest") )
+        self.assertTrue( "sdkCall=" in res.trace.toCompactString() )
+        del client
+
+
+    def test_client_Client_tracing_file(self):
+
+        self.settings.traceRequests = True
+        self.settings.traceFileName = self.fileName
+        client = pyuaf.client.Client(self.settings)
+
+        res = client.read(self.addresses)
+        self.assertTrue( res.overallStatus.isGood() )
+
+        # the file is completed when the client is destroyed
+        del client
+
+        f = open(self.fileName, "r")
+        events = json.load(f)
+        f.close()
+
+        self.assertTrue( len(events) >= len(res.trace.spans) )
+        for event in events:
+            self.assertEqual( event["ph"], "X" )
+            self.assertEqual( event["args"]["service"], "Read" )
+
+
+    def tearDown(self):
+        if os.path.exists(self.fileName):
+            os.remove(self.fileName)
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -76,6 +76,21 @@ class StatusTest(unittest.TestCase):
         self.assertTrue( self.s4 > self.s3 )
         self.assertTrue( self.s3 > self.s5 )
     
+    def test_util_Status_raisedBy(self):
+        self.assertEqual( self.s3.raisedBy_UnexpectedError.message , "Some connection error" )
+        # a copy shares the error of the original
+        copy = pyuaf.util.Status(self.s3)
+        self.assertEqual( copy.raisedBy_UnexpectedError.message , "Some connection error" )
+        # errors that didn't raise the status are default errors
+        self.assertEqual( self.s3.raisedBy_FindServersError.message , 
+                          pyuaf.util.errors.FindServersError().message )
+    
+    def test_util_Status_test(self):
+        self.s1.test()
+        self.assertRaises(pyuaf.util.errors.UnexpectedError, self.s3.test)
+        self.s3.setGood()
+        self.s3.test()
+    
     def test_util_StatusVector(self):
         testVector(self, pyuaf.util.StatusVector, [self.s0, self.s1, self.s2, self.s3, self.s4, self.s5])
         
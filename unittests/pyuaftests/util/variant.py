@@ -2,6 +2,11 @@ import pyuaf
 import unittest
 from pyuaf.util.unittesting import parseArgs, testVector
 
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 
 ARGS = parseArgs()
 
@@ -11,7 +16,10 @@ def suite(args=None):
         global ARGS
         ARGS = args
     
-    return unittest.TestLoader().loadTestsFromTestCase(VariantTest)
+    suite = unittest.TestSuite()
+    suite.addTests(unittest.TestLoader().loadTestsFromTestCase(VariantTest))
+    suite.addTests(unittest.TestLoader().loadTestsFromTestCase(VariantNumpyTest))
+    return suite
 
 
 
@@ -519,5 +527,72 @@ class VariantTest(unittest.TestCase):
                                                      pyuaf.util.LocalizedText("en", "text") ])
 
 
+
+class VariantNumpyTest(unittest.TestCase):
+    
+    def setUp(self):
+        
+        self.tester = pyuaf.util.__unittesthelper__.UnitTestHelper()
+        
+        # numeric arrays are only converted into NumPy arrays if the user asks for it
+        pyuaf.util.NUMPY_ARRAYS = True
+    
+    
+    def tearDown(self):
+        pyuaf.util.NUMPY_ARRAYS = False
+    
+    
+    @unittest.skipIf(numpy is None, "NumPy is not installed")
+    def test_util_primitives_Double_array_numpy_outputtypemap(self):
+        v = self.tester.testVariantTypemap_out(pyuaf.util.opcuatypes.Double, True)
+        self.assertTrue( isinstance(v, numpy.ndarray) )
+        self.assertEqual( v.dtype, numpy.float64 )
+        self.assertEqual( len(v), 3 )
+        self.assertTrue( 3.13999 < v[1] < 3.14001 )
+    
+    @unittest.skipIf(numpy is None, "NumPy is not installed")
+    def test_util_primitives_Boolean_array_numpy_outputtypemap(self):
+        v = self.tester.testVariantTypemap_out(pyuaf.util.opcuatypes.Boolean, True)
+        self.assertEqual( v.dtype, numpy.bool_ )
+        self.assertEqual( list(v), [True, False, True] )
+    
+    @unittest.skipIf(numpy is None, "NumPy is not installed")
+    def test_util_String_array_numpy_outputtypemap(self):
+        # non-numeric arrays are still converted into lists
+        v = self.tester.testVariantTypemap_out(pyuaf.util.opcuatypes.String, True)
+        self.assertTrue( isinstance(v, list) )
+    
+    @unittest.skipIf(numpy is None, "NumPy is not installed")
+    def test_util_primitives_array_numpy_inputtypemap(self):
+        for dtype in [numpy.int8, numpy.uint8, numpy.int16, numpy.uint16, numpy.int32, 
+                      numpy.uint32, numpy.int64, numpy.uint64, numpy.float32, numpy.float64]:
+            a = numpy.arange(100, dtype=dtype)
+            v = self.tester.testVariantTypemap_in(a)
+            self.assertEqual( v.dtype, a.dtype )
+            self.assertTrue( numpy.array_equal(v, a) )
+    
+    @unittest.skipIf(numpy is None, "NumPy is not installed")
+    def test_util_primitives_array_numpy_noncontiguous_inputtypemap(self):
+        a = numpy.arange(20, dtype=numpy.float64).reshape(4, 5)[:, 1]
+        v = self.tester.testVariantTypemap_in(a)
+        self.assertTrue( numpy.array_equal(v, a) )
+    
+    @unittest.skipIf(numpy is None, "NumPy is not installed")
+    def test_util_primitives_array_numpy_to_primitives_inputtypemap(self):
+        pyuaf.util.NUMPY_ARRAYS = False
+        v = self.tester.testVariantTypemap_in(numpy.array([1.5, -2.5], dtype=numpy.float64))
+        self.assertEqual( v , [pyuaf.util.primitives.Double(1.5),
+                               pyuaf.util.primitives.Double(-2.5) ] )
+
+    @unittest.skipIf(numpy is None, "NumPy is not installed")
+    def test_util_primitives_array_numpy_dimensions_inputtypemap(self):
+        # only one-dimensional arrays are converted in one go: a Variant has no dimensions, and
+        # zero-dimensional arrays are no arrays
+        self.assertRaises(TypeError, self.tester.testVariantTypemap_in, 
+                          numpy.arange(6, dtype=numpy.float64).reshape(2, 3))
+        self.assertRaises(TypeError, self.tester.testVariantTypemap_in, 
+                          numpy.array(1.5, dtype=numpy.float64))
+
+
 if __name__ == '__main__':
     unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())